@@ -1,7 +1,8 @@
 import * as fs from 'fs';
 import * as path from 'path';
+import { performance } from 'perf_hooks';
 
-import { deprecate, Menu } from 'electron';
+import { BrowserWindow, deprecate, Menu, webContents } from 'electron';
 import { EventEmitter } from 'events';
 
 const bindings = process.electronBinding('app');
@@ -93,6 +94,10 @@ if (process.platform === 'darwin') {
 if (process.platform === 'linux') {
   const patternVmRSS = /^VmRSS:\s*(\d+) kB$/m;
   const patternVmHWM = /^VmHWM:\s*(\d+) kB$/m;
+  const patternRssAnon = /^RssAnon:\s*(\d+) kB$/m;
+  const patternRssFile = /^RssFile:\s*(\d+) kB$/m;
+  const patternRssShmem = /^RssShmem:\s*(\d+) kB$/m;
+  const patternVmSwap = /^VmSwap:\s*(\d+) kB$/m;
 
   const getStatus = (pid: number) => {
     try {
@@ -112,7 +117,10 @@ if (process.platform === 'linux') {
 
     return {
       workingSetSize: getEntry(file, patternVmRSS),
-      peakWorkingSetSize: getEntry(file, patternVmHWM)
+      peakWorkingSetSize: getEntry(file, patternVmHWM),
+      privateBytes: getEntry(file, patternRssAnon),
+      sharedBytes: getEntry(file, patternRssFile) + getEntry(file, patternRssShmem),
+      swapBytes: getEntry(file, patternVmSwap)
     };
   };
 
@@ -127,6 +135,167 @@ if (process.platform === 'linux') {
   };
 }
 
+// Samples the metrics of the processes periodically, and reports what changed
+// since the previous sample.
+let metricsSamplingInterval = 0;
+let metricsSamplingTimer: NodeJS.Timeout | null = null;
+let lastMetrics = new Map<string, Electron.ProcessMetric>();
+
+const getMetricKey = (metric: Electron.ProcessMetric) => `${metric.pid}:${metric.creationTime}`;
+
+const sampleAppMetrics = () => {
+  const metrics = app.getAppMetrics();
+  const currentMetrics = new Map<string, Electron.ProcessMetric>();
+  const added: number[] = [];
+  const memoryChanges: Electron.ProcessMemoryChange[] = [];
+  for (const metric of metrics) {
+    const key = getMetricKey(metric);
+    currentMetrics.set(key, metric);
+    const previous = lastMetrics.get(key);
+    if (!previous) {
+      added.push(metric.pid);
+    } else if (metric.memory && previous.memory) {
+      const workingSetSizeDelta = metric.memory.workingSetSize - previous.memory.workingSetSize;
+      if (workingSetSizeDelta !== 0) {
+        memoryChanges.push({ pid: metric.pid, workingSetSizeDelta });
+      }
+    }
+  }
+  const removed: number[] = [];
+  for (const [key, metric] of lastMetrics) {
+    if (!currentMetrics.has(key)) removed.push(metric.pid);
+  }
+  lastMetrics = currentMetrics;
+
+  const event = process.electronBinding('event').createEmpty();
+  app.emit('app-metrics-updated', event, { metrics, added, removed, memoryChanges });
+};
+
+app.setAppMetricsSamplingInterval = (interval: number) => {
+  if (!Number.isInteger(interval) || interval < 0) {
+    throw new RangeError('interval must be a non-negative integer');
+  }
+  metricsSamplingInterval = interval;
+  if (metricsSamplingTimer) {
+    clearInterval(metricsSamplingTimer);
+    metricsSamplingTimer = null;
+  }
+  lastMetrics = new Map();
+  if (interval > 0) {
+    metricsSamplingTimer = setInterval(sampleAppMetrics, interval);
+  }
+};
+
+app.getAppMetricsSamplingInterval = () => metricsSamplingInterval;
+
+// Trims the renderers when the system is under memory pressure. Windows with
+// a high memory priority are never trimmed, visible windows only on critical
+// pressure and the focused one is always spared.
+let trimRenderersOnMemoryPressure = false;
+
+app.setMemoryPressurePolicy = (policy: Electron.MemoryPressurePolicy) => {
+  if (typeof policy !== 'object' || policy === null) {
+    throw new TypeError('policy must be an object');
+  }
+  trimRenderersOnMemoryPressure = !!policy.trimRenderers;
+};
+
+const shouldTrimOnMemoryPressure = (contents: Electron.WebContents, critical: boolean, focusedWindow: Electron.BrowserWindow | null) => {
+  const priority = contents.getMemoryPriority();
+  if (priority === 'high' || contents.isDestroyed() || contents.isCrashed()) return false;
+  if (priority === 'low') return true;
+
+  const window = contents.getOwnerBrowserWindow();
+  if (!window || window.isDestroyed()) return true;
+  if (window === focusedWindow) return false;
+  const visible = window.isVisible() && !window.isMinimized();
+  return critical || !visible;
+};
+
+app.on('memory-pressure', (event, level) => {
+  if (!trimRenderersOnMemoryPressure) return;
+  const critical = level === 'critical';
+  const focusedWindow = BrowserWindow.getFocusedWindow();
+  for (const contents of webContents.getAllWebContents()) {
+    if (shouldTrimOnMemoryPressure(contents, critical, focusedWindow)) {
+      contents.trimMemory(level).catch(() => {});
+    }
+  }
+});
+
+// Idle callbacks run in best effort tasks of the main thread, which only run
+// when no other task is waiting, each one for at most an idle period like the
+// longest of Blink, so that the input that comes meanwhile waits little.
+const kIdlePeriod = 50;
+
+type IdleCallbackEntry = {
+  callback: (deadline: Electron.IdleDeadline) => void,
+  timer: NodeJS.Timeout | null
+};
+
+let nextIdleCallbackId = 1;
+const idleCallbacks = new Map<number, IdleCallbackEntry>();
+let idleTaskPosted = false;
+
+const runIdleCallbacks = () => {
+  idleTaskPosted = false;
+  const end = performance.now() + kIdlePeriod;
+  const deadline = {
+    didTimeout: false,
+    timeRemaining: () => Math.max(0, end - performance.now())
+  };
+  // The callbacks requested meanwhile wait for the next idle period.
+  const ids = Array.from(idleCallbacks.keys());
+  try {
+    for (const id of ids) {
+      if (deadline.timeRemaining() === 0) break;
+      const entry = idleCallbacks.get(id);
+      if (!entry) continue;
+      idleCallbacks.delete(id);
+      if (entry.timer) clearTimeout(entry.timer);
+      entry.callback(deadline);
+    }
+  } finally {
+    postIdleTask();
+  }
+};
+
+const postIdleTask = () => {
+  if (idleTaskPosted || idleCallbacks.size === 0) return;
+  idleTaskPosted = true;
+  app._postIdleTask(runIdleCallbacks);
+};
+
+app.requestIdleCallback = (callback: (deadline: Electron.IdleDeadline) => void, options: { timeout?: number } = {}) => {
+  if (typeof callback !== 'function') {
+    throw new TypeError('callback must be a function');
+  }
+  const { timeout = 0 } = options;
+  if (typeof timeout !== 'number' || !(timeout >= 0)) {
+    throw new RangeError('timeout must be a non-negative number');
+  }
+
+  const id = nextIdleCallbackId++;
+  const entry: IdleCallbackEntry = { callback, timer: null };
+  if (timeout > 0) {
+    // Runs in a task of normal priority if the app stays busy for too long.
+    entry.timer = setTimeout(() => {
+      idleCallbacks.delete(id);
+      callback({ didTimeout: true, timeRemaining: () => 0 });
+    }, timeout);
+  }
+  idleCallbacks.set(id, entry);
+  postIdleTask();
+  return id;
+};
+
+app.cancelIdleCallback = (id: number) => {
+  const entry = idleCallbacks.get(id);
+  if (!entry) return;
+  idleCallbacks.delete(id);
+  if (entry.timer) clearTimeout(entry.timer);
+};
+
 // Routes the events to webContents.
 const events = ['certificate-error', 'select-client-certificate'];
 for (const name of events) {
@@ -19,9 +19,11 @@ class AutoUpdater extends EventEmitter {
 
   setFeedURL (options) {
     let updateURL;
+    let background = false;
     if (typeof options === 'object') {
       if (typeof options.url === 'string') {
         updateURL = options.url;
+        background = !!options.background;
       } else {
         throw new Error('Expected options object to contain a \'url\' string property in setFeedUrl call');
       }
@@ -31,6 +33,7 @@ class AutoUpdater extends EventEmitter {
       throw new Error('Expected an options object with a \'url\' property to be provided');
     }
     this.updateURL = updateURL;
+    squirrelUpdate.setLowPriority(background);
   }
 
   checkForUpdates () {
@@ -50,6 +53,7 @@ class AutoUpdater extends EventEmitter {
       }
       this.updateAvailable = true;
       this.emit('update-available');
+      let lastPercent = -1;
       squirrelUpdate.update(this.updateURL, (error) => {
         if (error != null) {
           return this.emitError(error);
@@ -60,6 +64,11 @@ class AutoUpdater extends EventEmitter {
         this.emit('update-downloaded', {}, releaseNotes, version, date, this.updateURL, () => {
           this.quitAndInstall();
         });
+      }, (percent) => {
+        if (percent !== lastPercent) {
+          lastPercent = percent;
+          this.emit('update-progress', { percent });
+        }
       });
     });
   }
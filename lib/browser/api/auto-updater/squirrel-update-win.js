@@ -1,6 +1,7 @@
 'use strict';
 
 const fs = require('fs');
+const os = require('os');
 const path = require('path');
 const spawn = require('child_process').spawn;
 
@@ -12,12 +13,14 @@ const updateExe = path.resolve(appFolder, '..', 'Update.exe');
 const exeName = path.basename(process.execPath);
 let spawnedArgs = [];
 let spawnedProcess;
+let lowPriority = false;
 
 const isSameArgs = (args) => args.length === spawnedArgs.length && args.every((e, i) => e === spawnedArgs[i]);
 
 // Spawn a command and invoke the callback when it completes with an error
-// and the output from standard out.
-const spawnUpdate = function (args, detached, callback) {
+// and the output from standard out. |onLine| is called with each complete
+// line of standard out as it is written.
+const spawnUpdate = function (args, detached, callback, onLine) {
   let error, errorEmitted, stderr, stdout;
 
   try {
@@ -35,6 +38,15 @@ const spawnUpdate = function (args, detached, callback) {
         windowsHide: true
       });
       spawnedArgs = args || [];
+      // Only the checks and downloads run in the background, the app started
+      // by processStart keeps its normal priority.
+      if (lowPriority && !detached && spawnedProcess.pid) {
+        try {
+          os.setPriority(spawnedProcess.pid, os.constants.priority.PRIORITY_LOW);
+        } catch {
+          // The update still works at normal priority.
+        }
+      }
     }
   } catch (error1) {
     error = error1;
@@ -47,8 +59,16 @@ const spawnUpdate = function (args, detached, callback) {
   }
   stdout = '';
   stderr = '';
-
-  spawnedProcess.stdout.on('data', (data) => { stdout += data; });
+  let pendingLine = '';
+
+  spawnedProcess.stdout.on('data', (data) => {
+    stdout += data;
+    if (onLine) {
+      const lines = (pendingLine + data).split(/\r?\n/);
+      pendingLine = lines.pop();
+      lines.forEach(onLine);
+    }
+  });
   spawnedProcess.stderr.on('data', (data) => { stderr += data; });
 
   errorEmitted = false;
@@ -78,6 +98,12 @@ const spawnUpdate = function (args, detached, callback) {
   });
 };
 
+// Whether Update.exe checks for, downloads and applies updates with the
+// lowest scheduling priority.
+exports.setLowPriority = function (enabled) {
+  lowPriority = enabled;
+};
+
 // Start an instance of the installed app.
 exports.processStart = function () {
   return spawnUpdate(['--processStartAndWait', exeName], true, function () {});
@@ -104,8 +130,15 @@ exports.checkForUpdate = function (updateURL, callback) {
 };
 
 // Update the application to the latest remote version specified by URL.
-exports.update = function (updateURL, callback) {
-  return spawnUpdate(['--update', updateURL], false, callback);
+// Update.exe downloads the delta packages of the feed when there is a chain of
+// them from the installed version, and the full package otherwise. It prints
+// the progress as whole percents, which are passed to |onProgress|.
+exports.update = function (updateURL, callback, onProgress) {
+  return spawnUpdate(['--update', updateURL], false, callback, (line) => {
+    if (onProgress && /^\d+$/.test(line.trim())) {
+      onProgress(Math.min(100, Number(line.trim())));
+    }
+  });
 };
 
 // Is the Update.exe installed with the current application?
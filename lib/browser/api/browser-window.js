@@ -6,10 +6,16 @@ const { BrowserWindow } = process.electronBinding('window');
 
 Object.setPrototypeOf(BrowserWindow.prototype, TopLevelWindow.prototype);
 
+// Number of BrowserWindows that are not closed yet.
+let windowCount = 0;
+
 BrowserWindow.prototype._init = function () {
   // Call parent class's _init.
   TopLevelWindow.prototype._init.call(this);
 
+  windowCount++;
+  this.once('closed', () => { windowCount--; });
+
   // Avoid recursive require.
   const { app } = electron;
 
@@ -124,7 +130,13 @@ BrowserWindow.getAllWindows = () => {
   return TopLevelWindow.getAllWindows().filter(isBrowserWindow);
 };
 
+BrowserWindow.getWindowCount = () => windowCount;
+
 BrowserWindow.getFocusedWindow = () => {
+  // The focused window is looked up natively, only the detached DevTools
+  // windows, which are not part of the window list, need the slow path.
+  const focused = TopLevelWindow._getFocusedWindow();
+  if (isBrowserWindow(focused)) return focused;
   for (const window of BrowserWindow.getAllWindows()) {
     if (window.isFocused() || window.isDevToolsFocused()) return window;
   }
@@ -194,11 +206,17 @@ Object.assign(BrowserWindow.prototype, {
   capturePage (...args) {
     return this.webContents.capturePage(...args);
   },
+  capturePageToBuffer (...args) {
+    return this.webContents.capturePageToBuffer(...args);
+  },
   setTouchBar (touchBar) {
     electron.TouchBar._setOnWindow(touchBar, this);
   },
   setBackgroundThrottling (allowed) {
     this.webContents.setBackgroundThrottling(allowed);
+  },
+  setRendererPriority (priority) {
+    this.webContents.setRendererPriority(priority);
   }
 });
 
@@ -1,8 +1,11 @@
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
+import { createWorkerPool } from '@electron/internal/browser/ipc-worker-pool';
 
 const ipcMain = new IpcMainImpl();
 
 // Do not throw exception when channel name is "error".
 ipcMain.on('error', () => {});
 
+Object.assign(ipcMain, { createWorkerPool });
+
 export default ipcMain;
@@ -15,6 +15,9 @@ const MenuItem = function (options) {
     this.role = this.role.toLowerCase();
   }
   this.submenu = this.submenu || roles.getDefaultSubmenu(this.role);
+  if (this.submenu == null && typeof this.populateSubmenu === 'function') {
+    this.submenu = new Menu();
+  }
   if (this.submenu != null && this.submenu.constructor !== Menu) {
     this.submenu = Menu.buildFromTemplate(this.submenu);
   }
@@ -40,12 +43,25 @@ const MenuItem = function (options) {
   this.overrideProperty('acceleratorWorksWhenHidden', true);
   this.overrideProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
 
+  this.overrideUpdatableProperty('label');
+  this.overrideUpdatableProperty('sublabel');
+  this.overrideUpdatableProperty('toolTip');
+
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`);
   }
 
   this.overrideReadOnlyProperty('commandId', ++nextCommandId);
 
+  if (this.type === 'submenu' && typeof this.populateSubmenu === 'function') {
+    const { submenu, populateSubmenu } = this;
+    submenu._setLazy(true);
+    submenu.on('menu-will-show', () => {
+      submenu._clearItems();
+      populateSubmenu(submenu);
+    });
+  }
+
   const click = options.click;
   this.click = (event, focusedWindow, focusedWebContents) => {
     // Manually flip the checked flags when clicked.
@@ -75,6 +91,21 @@ MenuItem.prototype.overrideProperty = function (name, defaultValue = null) {
   }
 };
 
+// Changes to the property are applied in place to the menu of the item, so
+// that the menu does not have to be built again.
+MenuItem.prototype.overrideUpdatableProperty = function (name) {
+  let value = this[name];
+  Object.defineProperty(this, name, {
+    enumerable: true,
+    get: () => value,
+    set: (newValue) => {
+      if (newValue === value) return;
+      value = newValue;
+      if (this.menu) this.menu._updateItem(this);
+    }
+  });
+};
+
 MenuItem.prototype.overrideReadOnlyProperty = function (name, defaultValue) {
   this.overrideProperty(name, defaultValue);
   Object.defineProperty(this, name, {
@@ -133,6 +133,19 @@ Menu.prototype.insert = function (pos, item) {
   this.commandsMap[item.commandId] = item;
 };
 
+Menu.prototype._clearItems = function () {
+  this.clear();
+  this.commandsMap = {};
+  this.groupsMap = {};
+  this.items = [];
+};
+
+Menu.prototype._updateItem = function (item) {
+  const index = this.items.indexOf(item);
+  if (index === -1) return;
+  this._updateItemAt(index, item.label || '', item.sublabel || '', item.toolTip || '');
+};
+
 Menu.prototype._callMenuWillShow = function () {
   if (this.delegate) this.delegate.menuWillShow(this);
   this.items.forEach(item => {
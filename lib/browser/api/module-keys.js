@@ -35,6 +35,7 @@ module.exports = [
   { name: 'TopLevelWindow' },
   { name: 'TouchBar' },
   { name: 'Tray' },
+  { name: 'utilityProcess' },
   { name: 'View' },
   { name: 'webContents' },
   { name: 'WebContentsView' }
@@ -30,6 +30,7 @@ export const browserModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'TopLevelWindow', loader: () => require('./top-level-window') },
   { name: 'TouchBar', loader: () => require('./touch-bar') },
   { name: 'Tray', loader: () => require('./tray') },
+  { name: 'utilityProcess', loader: () => require('./utility-process') },
   { name: 'View', loader: () => require('./view') },
   { name: 'webContents', loader: () => require('./web-contents') },
   { name: 'WebContentsView', loader: () => require('./web-contents-view') }
@@ -5,10 +5,12 @@ const { EventEmitter } = require('events');
 const { Readable, Writable } = require('stream');
 const { app } = require('electron');
 const { Session } = process.electronBinding('session');
-const { net, Net, isValidHeaderName, isValidHeaderValue, createURLLoader } = process.electronBinding('net');
+const { net, Net, isValidHeaderName, isValidHeaderValue, createURLLoader, createURLLoaderPool } = process.electronBinding('net');
 
 const kSupportedProtocols = new Set(['http:', 'https:']);
 
+const kRequestPriorities = new Set(['throttled', 'idle', 'lowest', 'low', 'medium', 'highest']);
+
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
 const discardableDuplicateHeaders = new Set([
@@ -89,6 +91,14 @@ class IncomingMessage extends Readable {
     return this._responseHead.httpVersion.minor;
   }
 
+  get protocol () {
+    return this._responseHead.protocol;
+  }
+
+  get socketReused () {
+    return this._responseHead.socketReused;
+  }
+
   get rawTrailers () {
     throw new Error('HTTP trailers are not supported');
   }
@@ -228,12 +238,27 @@ function parseOptions (options) {
     throw new TypeError('headers must be an object');
   }
 
+  if (options.priority != null && !kRequestPriorities.has(options.priority)) {
+    throw new TypeError(`Invalid request priority '${options.priority}'`);
+  }
+
+  if (options.chunkSize != null && (!Number.isInteger(options.chunkSize) || options.chunkSize < 1)) {
+    throw new TypeError('chunkSize must be a positive integer');
+  }
+
+  if (options.savePath != null && typeof options.savePath !== 'string') {
+    throw new TypeError('savePath must be a string');
+  }
+
   const urlLoaderOptions = {
     method: method,
     url: urlStr,
     redirectPolicy,
     extraHeaders: options.headers || {},
-    useSessionCookies: options.useSessionCookies || false
+    useSessionCookies: options.useSessionCookies || false,
+    priority: options.priority,
+    chunkSize: options.chunkSize,
+    savePath: options.savePath
   };
   for (const [name, value] of Object.entries(urlLoaderOptions.extraHeaders)) {
     if (!isValidHeaderName(name)) {
@@ -466,10 +491,53 @@ class ClientRequest extends Writable {
   }
 }
 
+class RequestPool {
+  constructor (options = {}) {
+    const { maxConcurrentRequests = 6, ...requestOptions } = options;
+    this._pool = createURLLoaderPool();
+    this.maxConcurrentRequests = maxConcurrentRequests;
+    // Validate the defaults up front rather than on the first request.
+    parseOptions({ url: 'http://localhost/', ...requestOptions });
+    this._requestOptions = requestOptions;
+  }
+
+  get maxConcurrentRequests () {
+    return this._pool.maxConcurrentRequests;
+  }
+
+  set maxConcurrentRequests (value) {
+    if (!Number.isInteger(value) || value < 1) {
+      throw new RangeError('maxConcurrentRequests must be a positive integer');
+    }
+    this._pool.maxConcurrentRequests = value;
+  }
+
+  get activeRequestCount () {
+    return this._pool.activeRequestCount;
+  }
+
+  get pendingRequestCount () {
+    return this._pool.pendingRequestCount;
+  }
+
+  request (options, callback) {
+    if (typeof options === 'string') {
+      options = { url: options };
+    }
+    const request = new ClientRequest({ ...this._requestOptions, ...options }, callback);
+    request._urlLoaderOptions.pool = this._pool;
+    return request;
+  }
+}
+
 Net.prototype.request = function (options, callback) {
   return new ClientRequest(options, callback);
 };
 
+Net.prototype.createRequestPool = function (options) {
+  return new RequestPool(options);
+};
+
 net.ClientRequest = ClientRequest;
 
 module.exports = net;
@@ -7,4 +7,9 @@ Object.setPrototypeOf(Notification.prototype, EventEmitter.prototype);
 
 Notification.isSupported = isSupported;
 
+Notification.createGroup = (groupId, options) => {
+  const { NotificationGroup } = require('@electron/internal/browser/notification-group');
+  return new NotificationGroup(Notification, groupId, options);
+};
+
 module.exports = Notification;
@@ -1,9 +1,29 @@
 import { EventEmitter } from 'events';
-import { app } from 'electron';
+import { app, webContents } from 'electron';
 
-const { createPowerMonitor, getSystemIdleState, getSystemIdleTime } = process.electronBinding('power_monitor');
+const {
+  createPowerMonitor, getSystemIdleState, getSystemIdleTime, isOnBatteryPower, getCurrentThermalState,
+  setPreconnectDeferred
+} = process.electronBinding('power_monitor');
+
+// From the coolest to the hottest.
+const kThermalStates = ['unknown', 'nominal', 'fair', 'serious', 'critical'];
+
+// The values the policy replaced, and those it set.
+type Override<T> = { previous: T, applied: T };
+type WebContentsOverrides = { frameRate?: Override<number>, backgroundThrottling?: Override<boolean> };
 
 class PowerMonitor extends EventEmitter {
+  private _policy: Required<Electron.PowerPolicy> | null = null;
+  private _listeningForPolicy = false;
+  private _lowPowerMode = false;
+  private _thermalState = 'unknown';
+  // What the policy changed in each WebContents, restored when leaving low
+  // power mode.
+  private _overrides = new WeakMap<Electron.WebContents, WebContentsOverrides>();
+  private _workClasses = new Map<string, { deferInLowPowerMode: boolean }>();
+  private _deferredWork: Array<() => void> = [];
+
   constructor () {
     super();
     // Don't start the event source until both a) the app is ready and b)
@@ -41,6 +61,159 @@ class PowerMonitor extends EventEmitter {
   getSystemIdleTime () {
     return getSystemIdleTime();
   }
+
+  isOnBatteryPower () {
+    return isOnBatteryPower();
+  }
+
+  isLowPowerMode () {
+    return this._lowPowerMode;
+  }
+
+  setPowerPolicy (policy: Electron.PowerPolicy | null) {
+    if (typeof policy !== 'object') {
+      throw new TypeError('policy must be an object or null');
+    }
+    if (policy === null) {
+      this._setLowPowerMode(false);
+      this._policy = null;
+      return;
+    }
+
+    const {
+      onBattery = true, thermalState = 'serious', offscreenFrameRate = 30,
+      backgroundThrottling = true, deferPreconnect = true
+    } = policy;
+    if (!['fair', 'serious', 'critical'].includes(thermalState)) {
+      throw new TypeError(`Invalid thermal state '${thermalState}'`);
+    }
+    if (!Number.isInteger(offscreenFrameRate) || offscreenFrameRate < 0) {
+      throw new RangeError('offscreenFrameRate must be a non-negative integer');
+    }
+
+    // The new policy applies from scratch, but without leaving low power mode
+    // when it still applies.
+    const wasLowPowerMode = this._lowPowerMode;
+    if (wasLowPowerMode) this._restoreAll();
+    this._policy = { onBattery, thermalState, offscreenFrameRate, backgroundThrottling, deferPreconnect };
+    if (!this._listeningForPolicy) {
+      this._listeningForPolicy = true;
+      // The system is only asked once, the events keep the state current.
+      if (app.isReady()) this._thermalState = getCurrentThermalState();
+      const update = () => this._updateLowPowerMode();
+      this.on('on-battery', update);
+      this.on('on-ac', update);
+      this.on('resume', update);
+      this.on('thermal-state-change', (event: Electron.Event, state: string) => {
+        this._thermalState = state;
+        update();
+      });
+      app.on('web-contents-created', (event, contents) => {
+        if (this._lowPowerMode) this._applyToWebContents(contents);
+      });
+    }
+    if (app.isReady()) {
+      this._updateLowPowerMode();
+      if (wasLowPowerMode && this._lowPowerMode) this._applyAll();
+    } else {
+      app.whenReady().then(() => {
+        this._thermalState = getCurrentThermalState();
+        this._updateLowPowerMode();
+      });
+    }
+  }
+
+  registerWorkClass (name: string, options: { deferInLowPowerMode?: boolean } = {}) {
+    if (typeof name !== 'string' || name.length === 0) {
+      throw new TypeError('name must be a non-empty string');
+    }
+    this._workClasses.set(name, { deferInLowPowerMode: options.deferInLowPowerMode !== false });
+  }
+
+  runWork (name: string, callback: () => any): Promise<any> {
+    const workClass = this._workClasses.get(name);
+    if (!workClass) {
+      return Promise.reject(new Error(`Unknown work class '${name}'`));
+    }
+    if (typeof callback !== 'function') {
+      return Promise.reject(new TypeError('callback must be a function'));
+    }
+    if (this._lowPowerMode && workClass.deferInLowPowerMode) {
+      return new Promise<void>(resolve => this._deferredWork.push(resolve)).then(callback);
+    }
+    return Promise.resolve().then(callback);
+  }
+
+  _updateLowPowerMode () {
+    const policy = this._policy;
+    if (!policy) return;
+    const hot = kThermalStates.indexOf(this._thermalState) >= kThermalStates.indexOf(policy.thermalState);
+    this._setLowPowerMode((policy.onBattery && isOnBatteryPower()) || hot);
+  }
+
+  _setLowPowerMode (lowPowerMode: boolean) {
+    if (lowPowerMode === this._lowPowerMode) return;
+    this._lowPowerMode = lowPowerMode;
+
+    if (lowPowerMode) {
+      this._applyAll();
+    } else {
+      this._restoreAll();
+      for (const resolve of this._deferredWork.splice(0)) {
+        resolve();
+      }
+    }
+    this.emit('low-power-mode-change', lowPowerMode);
+  }
+
+  _applyAll () {
+    for (const contents of webContents.getAllWebContents()) {
+      this._applyToWebContents(contents);
+    }
+    setPreconnectDeferred(this._policy!.deferPreconnect);
+  }
+
+  _restoreAll () {
+    for (const contents of webContents.getAllWebContents()) {
+      this._restoreWebContents(contents);
+    }
+    setPreconnectDeferred(false);
+  }
+
+  _applyToWebContents (contents: Electron.WebContents) {
+    const policy = this._policy!;
+    if (contents.isDestroyed() || this._overrides.has(contents)) return;
+
+    const overrides: WebContentsOverrides = {};
+    if (policy.offscreenFrameRate > 0 && contents.isOffscreen()) {
+      const frameRate = contents.getFrameRate();
+      if (frameRate > policy.offscreenFrameRate) {
+        overrides.frameRate = { previous: frameRate, applied: policy.offscreenFrameRate };
+        contents.setFrameRate(policy.offscreenFrameRate);
+      }
+    }
+    // Hidden pages that are throttled also get the lower process priority of
+    // background renderers.
+    if (policy.backgroundThrottling && !contents.getBackgroundThrottling()) {
+      overrides.backgroundThrottling = { previous: false, applied: true };
+      contents.setBackgroundThrottling(true);
+    }
+    this._overrides.set(contents, overrides);
+  }
+
+  _restoreWebContents (contents: Electron.WebContents) {
+    const overrides = this._overrides.get(contents);
+    this._overrides.delete(contents);
+    if (!overrides || contents.isDestroyed()) return;
+    // What the app changed in low power mode is kept.
+    const { frameRate, backgroundThrottling } = overrides;
+    if (frameRate && contents.getFrameRate() === frameRate.applied) {
+      contents.setFrameRate(frameRate.previous);
+    }
+    if (backgroundThrottling && contents.getBackgroundThrottling() === backgroundThrottling.applied) {
+      contents.setBackgroundThrottling(backgroundThrottling.previous);
+    }
+  }
 }
 
 module.exports = new PowerMonitor();
@@ -2,7 +2,7 @@
 
 const { EventEmitter } = require('events');
 const { app, deprecate } = require('electron');
-const { fromPartition, Session } = process.electronBinding('session');
+const { fromPartition, clone, Session } = process.electronBinding('session');
 
 // Public API.
 Object.defineProperties(exports, {
@@ -13,6 +13,10 @@ Object.defineProperties(exports, {
   fromPartition: {
     enumerable: true,
     value: fromPartition
+  },
+  clone: {
+    enumerable: true,
+    value: clone
   }
 });
 
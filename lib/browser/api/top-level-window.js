@@ -2,14 +2,20 @@
 
 const electron = require('electron');
 const { EventEmitter } = require('events');
+const { trackListeners } = require('@electron/internal/browser/utils');
 const { TopLevelWindow } = process.electronBinding('top_level_window');
 
+// Emitted many times a second while the window is dragged or resized.
+const kFrequentEvents = ['move', 'moved', 'resize', 'will-move', 'will-resize'];
+
 Object.setPrototypeOf(TopLevelWindow.prototype, EventEmitter.prototype);
 
 TopLevelWindow.prototype._init = function () {
   // Avoid recursive require.
   const { app } = electron;
 
+  trackListeners(this, kFrequentEvents);
+
   // Simulate the application menu on platforms other than macOS.
   if (process.platform !== 'darwin') {
     const menu = app.applicationMenu;
@@ -18,7 +24,7 @@ TopLevelWindow.prototype._init = function () {
 };
 
 TopLevelWindow.getFocusedWindow = () => {
-  return TopLevelWindow.getAllWindows().find((win) => win.isFocused());
+  return TopLevelWindow._getFocusedWindow() || undefined;
 };
 
 module.exports = TopLevelWindow;
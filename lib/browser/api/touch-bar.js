@@ -107,8 +107,20 @@ class TouchBar extends EventEmitter {
 
     window._touchBar = this;
 
+    // Setting several properties of an item, or the same one many times,
+    // refreshes the native item once at the end of the current tick.
+    const pendingItemIDs = new Set();
+    const refreshPendingItems = () => {
+      const itemIDs = Array.from(pendingItemIDs);
+      pendingItemIDs.clear();
+      if (window.isDestroyed() || window._touchBar !== this) return;
+      for (const itemID of itemIDs) {
+        window._refreshTouchBarItem(itemID);
+      }
+    };
     const changeListener = (itemID) => {
-      window._refreshTouchBarItem(itemID);
+      if (pendingItemIDs.size === 0) process.nextTick(refreshPendingItems);
+      pendingItemIDs.add(itemID);
     };
     this.on('change', changeListener);
 
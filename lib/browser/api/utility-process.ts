@@ -0,0 +1,90 @@
+import { EventEmitter } from 'events';
+import * as fs from 'fs';
+import * as path from 'path';
+import { app } from 'electron';
+import MessageChannelMain from '@electron/internal/browser/api/message-channel';
+import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+
+const { createUtilityProcess } = process.electronBinding('utility_process');
+
+type ForkOptions = { serviceName?: string, sandbox?: boolean };
+
+class UtilityProcess extends EventEmitter {
+  private _handle: any = null;
+  private _port: MessagePortMain;
+  private _exited = false;
+
+  constructor (modulePath: string, args: string[], options: ForkOptions) {
+    super();
+    const { port1, port2 } = new MessageChannelMain();
+    this._port = port1;
+    this._port.on('message', (event: any) => { this.emit('message', event.data); });
+    this._port.start();
+
+    this._spawn(modulePath, args, options, port2).catch((error) => {
+      this._exit();
+      // Not thrown from here, where it would only be an unhandled rejection.
+      if (this.listenerCount('error') > 0) {
+        this.emit('error', error);
+      } else {
+        console.error('Failed to start the utility process:', error);
+      }
+    });
+  }
+
+  get pid (): number | undefined {
+    return this._handle && this._handle.pid ? this._handle.pid : undefined;
+  }
+
+  postMessage (message: any, transfer?: MessagePortMain[]) {
+    if (this._exited) throw new Error('The utility process has exited');
+    this._port.postMessage(message, transfer);
+  }
+
+  kill () {
+    if (this._exited) return false;
+    if (this._handle) {
+      // The handle emits "exit" once the process is gone.
+      this._handle.kill();
+    } else {
+      this._exit();
+    }
+    return true;
+  }
+
+  private async _spawn (modulePath: string, args: string[], options: ForkOptions, port: MessagePortMain) {
+    const { serviceName = `${app.name} Utility`, sandbox = false } = options;
+    // A sandboxed process can not open the script itself.
+    const source = sandbox ? await fs.promises.readFile(modulePath, 'utf8') : undefined;
+    await app.whenReady();
+    if (this._exited) return;
+
+    this._handle = createUtilityProcess({
+      modulePath, args, source, serviceName, sandbox, port: port._internalPort
+    });
+    this._handle.on('spawn', () => { this.emit('spawn'); });
+    this._handle.on('exit', (event: any, code: number) => {
+      this._handle = null;
+      this._exit(code);
+    });
+  }
+
+  private _exit (code?: number) {
+    if (this._exited) return;
+    this._exited = true;
+    this._port.close();
+    this.emit('exit', code);
+  }
+}
+
+const fork = function (modulePath: string, args: string[] = [], options: ForkOptions = {}) {
+  if (typeof modulePath !== 'string') {
+    throw new TypeError('modulePath must be a string');
+  }
+  if (!Array.isArray(args) || !args.every(arg => typeof arg === 'string')) {
+    throw new TypeError('args must be an Array of strings');
+  }
+  return new UtilityProcess(path.resolve(modulePath), args, options);
+};
+
+export default { fork };
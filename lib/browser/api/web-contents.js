@@ -13,6 +13,7 @@ const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-interna
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils');
 const { convertFeaturesString } = require('@electron/internal/common/parse-features-string');
 const { MessagePortMain } = require('@electron/internal/browser/message-port-main');
+const { trackListeners } = require('@electron/internal/browser/utils');
 
 // session is not used here, the purpose is to make sure session is initalized
 // before the webContents module.
@@ -24,6 +25,17 @@ const getNextId = function () {
   return ++nextId;
 };
 
+// Emitted often enough that they are only worth emitting when listened to.
+const kFrequentEvents = [
+  'console-message',
+  'cursor-changed',
+  'did-frame-finish-load',
+  'did-frame-navigate',
+  'did-redirect-navigation',
+  'did-start-navigation',
+  'update-target-url'
+];
+
 // Stock page sizes
 const PDFPageSizes = {
   A5: {
@@ -124,6 +136,24 @@ WebContents.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+WebContents.prototype.createSharedBuffer = function (channel, byteLength, options = {}) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument');
+  }
+  if (!Number.isInteger(byteLength) || byteLength < 1) {
+    throw new RangeError('byteLength must be a positive integer');
+  }
+
+  // The doorbell lets each side wake the other up after writing to the
+  // buffer, instead of polling it.
+  if (options.doorbell) {
+    const { port1, port2 } = new electron.MessageChannelMain();
+    const buffer = this._createSharedBuffer(channel, byteLength, [port2._internalPort]);
+    return { buffer, port: port1 };
+  }
+  return { buffer: this._createSharedBuffer(channel, byteLength) };
+};
+
 WebContents.prototype.sendToAll = function (channel, ...args) {
   if (typeof channel !== 'string') {
     throw new Error('Missing required channel argument');
@@ -155,6 +185,15 @@ WebContents.prototype._sendInternalToAll = function (channel, ...args) {
 
   return this._send(internal, sendToAll, channel, args);
 };
+WebContents.prototype._sendInternalToProcesses = function (channel, ...args) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument');
+  }
+
+  const internal = true;
+
+  return this._sendToProcesses(internal, channel, args);
+};
 WebContents.prototype.sendToFrame = function (frameId, channel, ...args) {
   if (typeof channel !== 'string') {
     throw new Error('Missing required channel argument');
@@ -215,6 +254,25 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (code, h
   return ipcMainUtils.invokeInWebContents(this, false, 'ELECTRON_INTERNAL_RENDERER_WEB_FRAME_METHOD', 'executeJavaScriptInIsolatedWorld', code, hasUserGesture);
 };
 
+WebContents.prototype.executeJavaScriptInAllFrames = async function (code, options = {}) {
+  if (typeof code !== 'string') {
+    throw new TypeError('code must be a string');
+  }
+  const { world = 0, userGesture = false } = options;
+  if (!Number.isInteger(world) || world < 0) {
+    throw new TypeError('world must be a non-negative integer');
+  }
+  await waitTillCanExecuteJavaScript(this);
+  const replies = await ipcMainUtils.invokeInWebContentsProcesses(this, 'ELECTRON_INTERNAL_RENDERER_EXECUTE_JAVASCRIPT_IN_ALL_FRAMES', code, world, userGesture);
+  const results = [];
+  for (const { processId, result } of replies) {
+    for (const frameResult of result) {
+      results.push({ processId, ...frameResult });
+    }
+  }
+  return results;
+};
+
 // Translate the options of printToPDF.
 WebContents.prototype.printToPDF = function (options) {
   const printSettings = {
@@ -411,6 +469,149 @@ WebContents.prototype.loadFile = function (filePath, options = {}) {
   }));
 };
 
+// How much the memory pressure policy of the app protects the renderer of
+// each WebContents, see app.setMemoryPressurePolicy().
+const memoryPriorities = ['low', 'normal', 'high'];
+const memoryPriorityMap = new WeakMap();
+
+WebContents.prototype.setMemoryPriority = function (priority) {
+  if (!memoryPriorities.includes(priority)) {
+    throw new TypeError(`Invalid memory priority '${priority}'`);
+  }
+  memoryPriorityMap.set(this, priority);
+};
+
+WebContents.prototype.getMemoryPriority = function () {
+  return memoryPriorityMap.get(this) || 'normal';
+};
+
+// Saves past the limit of webContents.setMaxConcurrentSavePages() wait for a
+// running one to finish, 0 for no limit.
+let maxConcurrentSavePages = 0;
+let activeSavePageCount = 0;
+const pendingSavePages = [];
+
+const canStartSavePage = () => maxConcurrentSavePages === 0 || activeSavePageCount < maxConcurrentSavePages;
+
+const startSavePage = function (contents, args) {
+  const promise = contents._savePage(...args);
+  activeSavePageCount++;
+  const done = () => {
+    activeSavePageCount--;
+    runPendingSavePages();
+  };
+  promise.then(done, done);
+  return promise;
+};
+
+const runPendingSavePages = function () {
+  while (pendingSavePages.length > 0 && canStartSavePage()) {
+    const { contents, args, resolve, reject } = pendingSavePages.shift();
+    if (contents.isDestroyed()) {
+      reject(new Error('The WebContents was destroyed before saving its page'));
+      continue;
+    }
+    try {
+      startSavePage(contents, args).then(resolve, reject);
+    } catch (error) {
+      reject(error);
+    }
+  }
+};
+
+WebContents.prototype.savePage = function (...args) {
+  if (canStartSavePage()) return startSavePage(this, args);
+  return new Promise((resolve, reject) => {
+    pendingSavePages.push({ contents: this, args, resolve, reject });
+  });
+};
+
+// The page prerendered for each WebContents, see prerender().
+const prerenderMap = new WeakMap();
+
+// The hidden WebContents of prerendered pages, they are internal: they do
+// not emit "web-contents-created", do not run the preloads of the session
+// and can not open windows.
+const prerenderContents = new WeakSet();
+let isCreatingPrerender = false;
+
+// A prerendered page that is not navigated to is dropped after this long.
+const kPrerenderTimeout = 30 * 1000;
+
+const cancelPrerender = (webContents) => {
+  const prerender = prerenderMap.get(webContents);
+  if (!prerender) return;
+  prerenderMap.delete(webContents);
+  clearTimeout(prerender.timeout);
+  webContents.removeListener('did-start-navigation', prerender.onNavigation);
+  webContents.removeListener('destroyed', prerender.cancel);
+  if (!prerender.contents.isDestroyed()) prerender.contents.destroy();
+};
+
+// The URL as navigations report it, without its fragment.
+const normalizePrerenderURL = (url) => {
+  try {
+    const parsed = new URL(url);
+    parsed.hash = '';
+    return parsed.href;
+  } catch {
+    return url;
+  }
+};
+
+// Loads |url| in a hidden WebContents of the same session, so that the
+// documents, scripts and code caches of the page are in the caches of the
+// session when this WebContents navigates to it. Only one page is prerendered
+// at a time.
+WebContents.prototype.prerender = function (url) {
+  cancelPrerender(this);
+
+  isCreatingPrerender = true;
+  let contents;
+  try {
+    contents = binding.create({
+      session: this.session,
+      sandbox: true,
+      nativeWindowOpen: true,
+      disablePopups: true,
+      enableRemoteModule: false
+    });
+  } finally {
+    isCreatingPrerender = false;
+  }
+  prerenderContents.add(contents);
+  contents.setAudioMuted(true);
+
+  const cancel = () => {
+    const prerender = prerenderMap.get(this);
+    if (prerender && prerender.contents === contents) cancelPrerender(this);
+  };
+  const prerenderedUrl = normalizePrerenderURL(url);
+  const onNavigation = (event, navigationUrl, isInPlace, isMainFrame) => {
+    // The page is in the caches by now.
+    if (isMainFrame && normalizePrerenderURL(navigationUrl) === prerenderedUrl) {
+      cancel();
+    }
+  };
+  prerenderMap.set(this, {
+    contents,
+    cancel,
+    onNavigation,
+    timeout: setTimeout(cancel, kPrerenderTimeout)
+  });
+  this.on('did-start-navigation', onNavigation);
+  this.once('destroyed', cancel);
+
+  return contents.loadURL(url).catch((error) => {
+    cancel();
+    throw error;
+  });
+};
+
+WebContents.prototype._isPrerender = function () {
+  return prerenderContents.has(this);
+};
+
 const addReplyToEvent = (event) => {
   event.reply = (...args) => {
     event.sender.sendToFrame(event.frameId, ...args);
@@ -443,6 +644,8 @@ WebContents.prototype._init = function () {
   // render-view-deleted event, so ignore the listeners warning.
   this.setMaxListeners(0);
 
+  trackListeners(this, kFrequentEvents);
+
   // Dispatch IPC messages to the ipc module.
   this.on('-ipc-message', function (event, internal, channel, args) {
     if (internal) {
@@ -507,7 +710,10 @@ WebContents.prototype._init = function () {
     this.reload();
   });
 
-  if (this.getType() !== 'remote') {
+  if (isCreatingPrerender) {
+    this.on('-new-window', (event) => { event.preventDefault(); });
+    this.on('-add-new-contents', (event) => { event.preventDefault(); });
+  } else if (this.getType() !== 'remote') {
     // Make new windows requested by links behave like "window.open".
     this.on('-new-window', (event, url, frameName, disposition,
       rawFeatures, referrer, postData) => {
@@ -550,8 +756,10 @@ WebContents.prototype._init = function () {
     app.emit('login', event, this, ...args);
   });
 
-  const event = process.electronBinding('event').createEmpty();
-  app.emit('web-contents-created', event, this);
+  if (!isCreatingPrerender) {
+    const event = process.electronBinding('event').createEmpty();
+    app.emit('web-contents-created', event, this);
+  }
 
   // Properties
 
@@ -605,5 +813,18 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents();
+  },
+
+  createPDFQueue (options) {
+    const { PDFQueue } = require('@electron/internal/browser/pdf-queue');
+    return new PDFQueue(options);
+  },
+
+  setMaxConcurrentSavePages (limit) {
+    if (!Number.isInteger(limit) || limit < 0) {
+      throw new RangeError('limit must be a non-negative integer');
+    }
+    maxConcurrentSavePages = limit;
+    runPendingSavePages();
   }
 };
@@ -8,6 +8,7 @@ const { app, webContents, BrowserWindow } = require('electron');
 const { getAllWebContents } = process.electronBinding('web_contents');
 const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-internal');
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils');
+const { hashScript } = require('@electron/internal/browser/preload-code-cache');
 
 const { Buffer } = require('buffer');
 const fs = require('fs');
@@ -341,10 +342,17 @@ const injectContentScripts = function (manifest) {
     };
   };
 
+  // Scripts also get the hash of their source, which renderers use to look up
+  // their code cache.
+  const readScriptFile = function (relativePath) {
+    const file = readArrayOfFiles(relativePath);
+    return { ...file, hash: hashScript(file.code) };
+  };
+
   const contentScriptToEntry = function (script) {
     return {
       matches: script.matches,
-      js: script.js ? script.js.map(readArrayOfFiles) : [],
+      js: script.js ? script.js.map(readScriptFile) : [],
       css: script.css ? script.css.map(readArrayOfFiles) : [],
       runAt: script.run_at || 'document_idle',
       allFrames: script.all_frames || false
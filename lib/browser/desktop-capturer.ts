@@ -7,8 +7,20 @@ let currentlyRunning: {
   getSources: Promise<ElectronInternal.GetSourcesResult[]>;
 }[] = [];
 
+const serialize = (source: Electron.DesktopCapturerSource, fetchWindowIcons: boolean): ElectronInternal.GetSourcesResult => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: source.thumbnail.toDataURL(),
+  display_id: source.display_id,
+  appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
+});
+
 export const getSources = (event: Electron.IpcMainEvent, options: ElectronInternal.GetSourcesOptions) => {
-  for (const running of currentlyRunning) {
+  // The updates of a running request went to another renderer, so incremental
+  // requests always start their own capture.
+  const { updateChannel } = options;
+
+  for (const running of updateChannel ? [] : currentlyRunning) {
     if (deepEqual(running.options, options)) {
       // If a request is currently running for the same options
       // return that promise
@@ -23,6 +35,7 @@ export const getSources = (event: Electron.IpcMainEvent, options: ElectronIntern
       if (capturer) {
         delete capturer._onerror;
         delete capturer._onfinished;
+        delete capturer._onsource;
         capturer = null;
       }
       // Remove from currentlyRunning once we resolve or reject
@@ -36,16 +49,16 @@ export const getSources = (event: Electron.IpcMainEvent, options: ElectronIntern
 
     capturer._onfinished = (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => {
       stopRunning();
-      resolve(sources.map(source => ({
-        id: source.id,
-        name: source.name,
-        thumbnail: source.thumbnail.toDataURL(),
-        display_id: source.display_id,
-        appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
-      })));
+      resolve(sources.map(source => serialize(source, fetchWindowIcons)));
     };
 
-    capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons);
+    if (updateChannel) {
+      capturer._onsource = (source: Electron.DesktopCapturerSource) => {
+        event.sender._sendInternal(updateChannel, serialize(source, false));
+      };
+    }
+
+    capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons, !!updateChannel);
 
     // If the WebContents is destroyed before receiving result, just remove the
     // reference to emit and the capturer itself so that it never dispatches
@@ -53,10 +66,56 @@ export const getSources = (event: Electron.IpcMainEvent, options: ElectronIntern
     event.sender.once('destroyed', () => stopRunning());
   });
 
-  currentlyRunning.push({
-    options,
-    getSources
-  });
+  if (!updateChannel) {
+    currentlyRunning.push({
+      options,
+      getSources
+    });
+  }
 
   return getSources;
 };
+
+// webContents id => channel => watcher.
+const watchers = new Map<number, Map<string, () => void>>();
+
+export const stopWatching = (event: Electron.IpcMainEvent, channel: string) => {
+  const senderWatchers = watchers.get(event.sender.id);
+  const stop = senderWatchers && senderWatchers.get(channel);
+  if (stop) stop();
+};
+
+export const startWatching = (event: Electron.IpcMainEvent, options: ElectronInternal.WatchSourcesOptions) => {
+  const { sender } = event;
+  const { channel, fetchWindowIcons } = options;
+  const senderWatchers = watchers.get(sender.id) || new Map<string, () => void>();
+  if (senderWatchers.has(channel)) return;
+  watchers.set(sender.id, senderWatchers);
+
+  const capturer = createDesktopCapturer();
+  const send = (...change: ElectronInternal.DesktopSourceChange) => {
+    sender._sendInternal(channel, ...change);
+  };
+
+  capturer._onsourceadded = (type, index, source) => send('added', type, index, serialize(source, fetchWindowIcons));
+  capturer._onsourceremoved = (type, index) => send('removed', type, index);
+  capturer._onsourcemoved = (type, oldIndex, newIndex) => send('moved', type, oldIndex, newIndex);
+  capturer._onsourcenamechanged = (type, index, source) => send('name-changed', type, index, serialize(source, false));
+  capturer._onsourcethumbnailchanged = (type, index, source) => send('thumbnail-changed', type, index, serialize(source, false));
+
+  const stop = () => {
+    capturer.stopWatching();
+    delete capturer._onsourceadded;
+    delete capturer._onsourceremoved;
+    delete capturer._onsourcemoved;
+    delete capturer._onsourcenamechanged;
+    delete capturer._onsourcethumbnailchanged;
+    sender.removeListener('destroyed', stop);
+    senderWatchers.delete(channel);
+    if (senderWatchers.size === 0) watchers.delete(sender.id);
+  };
+  senderWatchers.set(channel, stop);
+  sender.once('destroyed', stop);
+
+  capturer.startWatching(options.captureWindow, options.captureScreen, options.thumbnailSize, fetchWindowIcons);
+};
@@ -45,6 +45,15 @@ const supportedWebViewEvents = [
   'update-target-url'
 ];
 
+// Events the <webview> element handles itself, the others are only forwarded
+// once the embedder listens to them.
+const internalWebViewEvents = new Set([
+  'load-commit',
+  'did-attach',
+  'focus-change',
+  'destroyed'
+]);
+
 const guestInstances = {};
 const embedderElementsMap = {};
 
@@ -111,14 +120,27 @@ const createGuest = function (embedder, params) {
     }
   };
 
-  // Dispatch events to embedder.
-  const fn = function (event) {
+  // Dispatch events to embedder. Listening to an event of a WebContents can
+  // make it do more work, like reporting the console messages or the target
+  // URL, so each event is only listened to once a <webview> needs it.
+  const forwardedEvents = new Set();
+  const forwardEvent = function (event) {
+    if (forwardedEvents.has(event) || !supportedWebViewEvents.includes(event)) {
+      return;
+    }
+    forwardedEvents.add(event);
     guest.on(event, function (_, ...args) {
       sendToEmbedder('ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT', event, ...args);
     });
   };
-  for (const event of supportedWebViewEvents) {
-    fn(event);
+  guestInstances[guestInstanceId].forwardEvent = forwardEvent;
+  for (const event of internalWebViewEvents) {
+    forwardEvent(event);
+  }
+  if (Array.isArray(params.events)) {
+    for (const event of params.events) {
+      forwardEvent(event);
+    }
   }
 
   guest.on('new-window', function (event, url, frameName, disposition, options, additionalFeatures, referrer) {
@@ -239,6 +261,12 @@ const attachGuest = function (event, embedderFrameId, elementInstanceId, guestIn
     return;
   }
 
+  if (Array.isArray(params.events)) {
+    for (const eventName of params.events) {
+      guestInstance.forwardEvent(eventName);
+    }
+  }
+
   guest.attachParams = params;
   embedderElementsMap[key] = guestInstanceId;
 
@@ -275,16 +303,31 @@ const watchEmbedder = function (embedder) {
   }
   watchedEmbedders.add(embedder);
 
-  // Forward embedder window visiblity change events to guest
-  const onVisibilityChange = function (visibilityState) {
+  // Forward embedder window visiblity change events to guest. A window often
+  // goes through several states at once, like when it is restored and shown,
+  // so the changes are sent once per task with the state they settled on.
+  let pendingVisibilityState = null;
+  const sendVisibilityState = function () {
+    const visibilityState = pendingVisibilityState;
+    pendingVisibilityState = null;
     for (const guestInstanceId of Object.keys(guestInstances)) {
       const guestInstance = guestInstances[guestInstanceId];
+      if (guestInstance.embedder !== embedder ||
+          guestInstance.visibilityState === visibilityState) {
+        continue;
+      }
       guestInstance.visibilityState = visibilityState;
-      if (guestInstance.embedder === embedder) {
+      if (!guestInstance.guest.isDestroyed()) {
         guestInstance.guest._sendInternal('ELECTRON_GUEST_INSTANCE_VISIBILITY_CHANGE', visibilityState);
       }
     }
   };
+  const onVisibilityChange = function (visibilityState) {
+    if (pendingVisibilityState == null) {
+      setImmediate(sendVisibilityState);
+    }
+    pendingVisibilityState = visibilityState;
+  };
   embedder.on('-window-visibility-change', onVisibilityChange);
 
   embedder.once('will-destroy', () => {
@@ -345,6 +388,11 @@ handleMessage('ELECTRON_GUEST_VIEW_MANAGER_ATTACH_GUEST', function (event, embed
   }
 });
 
+handleMessage('ELECTRON_GUEST_VIEW_MANAGER_FORWARD_EVENT', function (event, guestInstanceId, eventName) {
+  getGuestForWebContents(guestInstanceId, event.sender);
+  guestInstances[guestInstanceId].forwardEvent(eventName);
+});
+
 // this message is sent by the actual <webview>
 ipcMainInternal.on('ELECTRON_GUEST_VIEW_MANAGER_FOCUS_CHANGE', function (event, focus, guestInstanceId) {
   const guest = getGuest(guestInstanceId);
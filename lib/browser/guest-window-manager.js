@@ -9,6 +9,9 @@ const { convertFeaturesString } = require('@electron/internal/common/parse-featu
 
 const hasProp = {}.hasOwnProperty;
 const frameToGuest = new Map();
+// Embedder => Map of its guests to their 'closed' listeners, so that pages
+// opening many windows do not add a listener to the embedder for each one.
+const embedderToGuests = new WeakMap();
 
 // Security options that child windows will always inherit from parent windows
 const inheritedWebPreferences = new Map([
@@ -51,28 +54,19 @@ const mergeBrowserWindowOptions = function (embedder, options) {
   if (options.webPreferences == null) {
     options.webPreferences = {};
   }
+  // Converting the preferences is not free, do it once per window.open.
+  const webPreferences = embedder.getLastWebPreferences();
   if (embedder.browserWindowOptions != null) {
-    let parentOptions = embedder.browserWindowOptions;
-
-    // if parent's visibility is available, that overrides 'show' flag (#12125)
-    const win = BrowserWindow.fromWebContents(embedder.webContents);
-    if (win != null) {
-      parentOptions = {
-        ...win.getBounds(),
-        ...embedder.browserWindowOptions,
-        show: win.isVisible()
-      };
-    }
-
-    // Inherit the original options if it is a BrowserWindow.
-    mergeOptions(options, parentOptions);
+    // Inherit the original options if it is a BrowserWindow. The current
+    // bounds and visibility of the window are not inherited: child windows
+    // are placed by the system, and shown unless the options say otherwise.
+    mergeOptions(options, embedder.browserWindowOptions);
   } else {
     // Or only inherit webPreferences if it is a webview.
-    mergeOptions(options.webPreferences, embedder.getLastWebPreferences());
+    mergeOptions(options.webPreferences, webPreferences);
   }
 
   // Inherit certain option values from parent window
-  const webPreferences = embedder.getLastWebPreferences();
   for (const [name, value] of inheritedWebPreferences) {
     if (webPreferences[name] === value) {
       options.webPreferences[name] = value;
@@ -127,15 +121,23 @@ const setupGuest = function (embedder, frameName, guest, options) {
   // guest is closed by user then we should prevent |embedder| from double
   // closing guest.
   const guestId = guest.webContents.id;
-  const closedByEmbedder = function () {
-    guest.removeListener('closed', closedByUser);
-    guest.destroy();
-  };
+  let guests = embedderToGuests.get(embedder);
+  if (!guests) {
+    guests = new Map();
+    embedderToGuests.set(embedder, guests);
+    embedder.once('current-render-view-deleted', () => {
+      embedderToGuests.delete(embedder);
+      for (const [openedGuest, closedByUser] of guests) {
+        openedGuest.removeListener('closed', closedByUser);
+        openedGuest.destroy();
+      }
+    });
+  }
   const closedByUser = function () {
     embedder._sendInternal('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_CLOSED_' + guestId);
-    embedder.removeListener('current-render-view-deleted', closedByEmbedder);
+    guests.delete(guest);
   };
-  embedder.once('current-render-view-deleted', closedByEmbedder);
+  guests.set(guest, closedByUser);
   guest.once('closed', closedByUser);
   if (frameName) {
     frameToGuest.set(frameName, guest);
@@ -232,12 +234,17 @@ ipcMainInternal.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_OPEN', (event, url, fra
 // Routed window.open messages with fully parsed options
 function internalWindowOpen (event, url, referrer, frameName, disposition, options, additionalFeatures, postData) {
   options = mergeBrowserWindowOptions(event.sender, options);
-  const postBody = postData ? {
-    data: postData,
-    ...parseContentTypeFormat(postData)
-  } : null;
 
-  event.sender.emit('new-window', event, url, frameName, disposition, options, additionalFeatures, referrer, postBody);
+  // Without listeners the event is only there to be emitted, skip building
+  // its arguments.
+  if (event.sender.listenerCount('new-window') > 0) {
+    const postBody = postData ? {
+      data: postData,
+      ...parseContentTypeFormat(postData)
+    } : null;
+
+    event.sender.emit('new-window', event, url, frameName, disposition, options, additionalFeatures, referrer, postBody);
+  }
   const { newGuest } = event;
   if ((event.sender.getType() === 'webview' && event.sender.getLastWebPreferences().disablePopups) || event.defaultPrevented) {
     if (newGuest != null) {
@@ -18,6 +18,7 @@ require('../common/reset-search-paths');
 require('@electron/internal/common/init');
 
 process.electronBinding('event_emitter').setEventEmitterPrototype(EventEmitter.prototype);
+process.electronBinding('protocol').setFileReadStreamPrototype(fs.ReadStream.prototype);
 
 if (process.platform === 'win32') {
   // Redirect node's console to use our own implementations, since node can not
@@ -154,6 +155,12 @@ if (packageJson.v8Flags != null) {
 
 app._setDefaultAppPaths(packagePath);
 
+// Keep the code caches of the app's modules, deliberately lazy load so that
+// apps that do not use this feature do not pay the price
+if (packageJson.v8CodeCache === true && packagePath) {
+  require('@electron/internal/browser/main-code-cache').enableMainCodeCache(packagePath);
+}
+
 // Load the chrome devtools support.
 require('@electron/internal/browser/devtools');
 
@@ -42,3 +42,62 @@ export function invokeInWebContents<T> (sender: Electron.WebContentsInternal, se
     }
   });
 }
+
+// Like invokeInWebContents(), but sends the command once to each renderer
+// process of |sender| with frames that can handle it, and resolves with the
+// replies of all of them. Rejects when one of those frames goes away before
+// replying.
+export function invokeInWebContentsProcesses<T> (sender: Electron.WebContentsInternal, command: string, ...args: any[]) {
+  return new Promise<Array<{ processId: number, result: T }>>((resolve, reject) => {
+    const requestId = ++nextId;
+    const channel = `${command}_RESPONSE_${requestId}`;
+    const replies: Array<{ processId: number, result: T }> = [];
+    const pendingFrames = new Set<string>();
+
+    const handler = function (event: Electron.IpcMainEvent, error: Electron.SerializedError, result: T) {
+      if (event.sender !== sender) {
+        console.error(`Reply to ${command} sent by unexpected WebContents (${event.sender.id})`);
+        return;
+      }
+      if (!pendingFrames.delete(`${event.processId}:${event.frameId}`)) return;
+
+      if (error) {
+        cleanup();
+        reject(error);
+        return;
+      }
+
+      replies.push({ processId: event.processId, result });
+      if (pendingFrames.size === 0) {
+        cleanup();
+        resolve(replies);
+      }
+    };
+    const onFrameDeleted = function (event: Electron.Event, processId: number, frameId: number) {
+      if (!pendingFrames.has(`${processId}:${frameId}`)) return;
+      cleanup();
+      reject(new Error(`The frame ${frameId} of process ${processId} went away before replying to ${command}`));
+    };
+    const onDestroyed = function () {
+      cleanup();
+      reject(new Error(`The WebContents was destroyed before replying to ${command}`));
+    };
+    const cleanup = function () {
+      ipcMainInternal.removeListener(channel, handler);
+      sender.removeListener('-render-frame-deleted' as any, onFrameDeleted);
+      sender.removeListener('destroyed', onDestroyed);
+    };
+
+    ipcMainInternal.on(channel, handler);
+    sender.on('-render-frame-deleted' as any, onFrameDeleted);
+    sender.once('destroyed', onDestroyed);
+
+    for (const { processId, frameId } of sender._sendInternalToProcesses(command, requestId, ...args)) {
+      pendingFrames.add(`${processId}:${frameId}`);
+    }
+    if (pendingFrames.size === 0) {
+      cleanup();
+      resolve(replies);
+    }
+  });
+}
@@ -0,0 +1,109 @@
+import * as os from 'os';
+import * as path from 'path';
+import { Worker } from 'worker_threads';
+
+const binding = process.electronBinding('worker_ipc');
+
+// Runs in each worker of a pool, the handlers are the exports of the script of
+// the pool keyed by channel.
+const workerSource = `
+const { parentPort, workerData } = require('worker_threads');
+const binding = process._linkedBinding('electron_browser_worker_ipc');
+const handlers = require(workerData.script);
+const sendError = (replyId, channel, error) => {
+  console.error(\`Error occurred in handler for '\${channel}':\`, error);
+  binding.reply(replyId, { error: String(error) });
+};
+const dispatch = (event, channel, args, replyId) => {
+  const handler = handlers[channel];
+  if (typeof handler !== 'function') {
+    sendError(replyId, channel, \`No handler exported for '\${channel}'\`);
+    return;
+  }
+  Promise.resolve().then(() => handler(event, ...args)).then(result => {
+    if (!binding.reply(replyId, { result })) {
+      sendError(replyId, channel, new Error('An object could not be cloned.'));
+    }
+  }, error => sendError(replyId, channel, error));
+};
+if (binding.attach(workerData.poolId, dispatch)) {
+  parentPort.postMessage('ready');
+}
+`;
+
+export class IpcWorkerPool {
+  private _poolId: number = binding.createPool();
+  private _workers = new Set<Worker>();
+  private _channels = new Set<string>();
+  private _closed = false;
+
+  constructor (private _script: string, private _size: number) {
+    for (let i = 0; i < this._size; i++) {
+      this._startWorker();
+    }
+  }
+
+  get size () {
+    return this._size;
+  }
+
+  handle (channel: string) {
+    if (typeof channel !== 'string') {
+      throw new Error('Missing required channel argument');
+    }
+    if (this._closed) {
+      throw new Error('The worker pool is closed');
+    }
+    const { ipcMain } = require('electron');
+    if (ipcMain._invokeHandlers.has(channel) || !binding.bind(channel, this._poolId)) {
+      throw new Error(`Attempted to register a second handler for '${channel}'`);
+    }
+    this._channels.add(channel);
+  }
+
+  removeHandler (channel: string) {
+    if (this._channels.delete(channel)) {
+      binding.unbind(channel);
+    }
+  }
+
+  close () {
+    if (this._closed) return;
+    this._closed = true;
+    this._channels.clear();
+    binding.destroyPool(this._poolId);
+    for (const worker of this._workers) {
+      worker.terminate();
+    }
+  }
+
+  private _startWorker () {
+    const worker = new Worker(workerSource, {
+      eval: true,
+      workerData: { script: this._script, poolId: this._poolId }
+    });
+    let ready = false;
+    worker.once('message', () => { ready = true; });
+    worker.on('error', (error) => {
+      console.error(`Error in the IPC worker running '${this._script}':`, error);
+    });
+    worker.once('exit', () => {
+      this._workers.delete(worker);
+      // Workers that could not load the script are not started again, they
+      // would keep failing the same way.
+      if (!this._closed && ready) this._startWorker();
+    });
+    this._workers.add(worker);
+  }
+}
+
+export const createWorkerPool = function (script: string, options: { size?: number } = {}) {
+  if (typeof script !== 'string' || !path.isAbsolute(script)) {
+    throw new TypeError('script must be an absolute path');
+  }
+  const { size = Math.max(1, Math.min(4, os.cpus().length - 1)) } = options;
+  if (!Number.isInteger(size) || size < 1) {
+    throw new RangeError('size must be a positive integer');
+  }
+  return new IpcWorkerPool(script, size);
+};
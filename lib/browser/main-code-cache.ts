@@ -0,0 +1,120 @@
+import { app } from 'electron';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as inspector from 'inspector';
+import * as path from 'path';
+import * as vm from 'vm';
+
+const Module = require('module');
+
+// V8 code caches of the modules of the app that are loaded in the main
+// process, so that they are not compiled again on each launch. The caches of
+// each version of the app are kept in their own directory, and the ones of
+// other versions are removed.
+
+// Code caches are a few times the size of the source, anything larger than
+// this is not worth keeping.
+const kMaxCacheSize = 16 * 1024 * 1024;
+
+// The caches are created a moment after the app is ready, once the functions
+// run while starting have been compiled and can be included.
+const kWriteDelay = 1000;
+
+const isInside = function (directory: string, filename: string) {
+  const relative = path.relative(directory, filename);
+  return !!relative && !relative.startsWith('..') && !path.isAbsolute(relative);
+};
+
+const makeRequireFunction = function (mod: any) {
+  const require: any = function (id: string) {
+    return mod.require(id);
+  };
+  require.resolve = function (request: string, options?: { paths?: string[] }) {
+    return Module._resolveFilename(request, mod, false, options);
+  };
+  require.resolve.paths = function (request: string) {
+    return Module._resolveLookupPaths(request, mod);
+  };
+  require.main = process.mainModule;
+  require.extensions = Module._extensions;
+  require.cache = Module._cache;
+  return require;
+};
+
+const removeOtherVersions = async function (root: string, directory: string) {
+  const names = await fs.promises.readdir(root);
+  for (const name of names) {
+    const versionDirectory = path.join(root, name);
+    if (versionDirectory !== directory) {
+      await fs.promises.rmdir(versionDirectory, { recursive: true });
+    }
+  }
+};
+
+export const enableMainCodeCache = function (appPath: string) {
+  // Node's own compile is the one that knows to break on the first line of
+  // the app for --inspect-brk, and compiled code is not cached while the app
+  // is being debugged anyway.
+  if (inspector.url()) return;
+
+  const root = path.join(app.getPath('userData'), 'Main Code Cache');
+  const directory = path.join(root, app.getVersion());
+
+  // Path of the cache file => script compiled without a usable cache.
+  const pendingScripts = new Map<string, vm.Script>();
+  let writeScheduled = false;
+  let cleanedUp = false;
+
+  const writeCaches = async function () {
+    writeScheduled = false;
+    const scripts = Array.from(pendingScripts);
+    pendingScripts.clear();
+    await fs.promises.mkdir(directory, { recursive: true });
+    if (!cleanedUp) {
+      cleanedUp = true;
+      await removeOtherVersions(root, directory).catch(() => {});
+    }
+    for (const [cachePath, script] of scripts) {
+      const data = script.createCachedData();
+      if (data.length <= kMaxCacheSize) {
+        await fs.promises.writeFile(cachePath, data).catch(() => {});
+      }
+    }
+  };
+
+  const scheduleWrite = function () {
+    if (writeScheduled) return;
+    writeScheduled = true;
+    app.whenReady().then(() => {
+      setTimeout(() => { writeCaches().catch(() => {}); }, kWriteDelay);
+    });
+  };
+
+  const compile = Module.prototype._compile;
+  Module.prototype._compile = function (content: string, filename: string) {
+    // The modules using import() need the ESM loader as the dynamic import
+    // callback of their script, which only Node's own compile can give them.
+    if (!isInside(appPath, filename) || content.includes('import(')) {
+      return compile.call(this, content, filename);
+    }
+
+    const hash = crypto.createHash('sha256').update(filename).update('\0').update(content).digest('hex');
+    const cachePath = path.join(directory, hash);
+    let cachedData: Buffer | undefined;
+    try {
+      cachedData = fs.readFileSync(cachePath);
+    } catch {
+      cachedData = undefined;
+    }
+
+    const script = new vm.Script(Module.wrap(content), { filename, cachedData });
+    if (!cachedData || script.cachedDataRejected) {
+      pendingScripts.set(cachePath, script);
+      scheduleWrite();
+    }
+
+    const compiledWrapper = script.runInThisContext({ displayErrors: true });
+    const dirname = path.dirname(filename);
+    return compiledWrapper.call(this.exports, this.exports, makeRequireFunction(this), this, filename, dirname);
+  };
+};
@@ -0,0 +1,102 @@
+'use strict';
+
+const { EventEmitter } = require('events');
+
+const kForwardedEvents = ['click', 'close', 'reply', 'action'];
+
+const defaultSummary = (notifications) => {
+  const last = notifications[notifications.length - 1];
+  return { ...last, body: `${notifications.length} new notifications` };
+};
+
+class NotificationGroup extends EventEmitter {
+  constructor (Notification, groupId, options = {}) {
+    super();
+    if (typeof groupId !== 'string' || groupId.length === 0) {
+      throw new TypeError('groupId must be a non-empty string');
+    }
+    const { coalesceDelay = 1000, summary = defaultSummary, ...defaults } = options;
+    if (typeof coalesceDelay !== 'number' || !(coalesceDelay >= 0)) {
+      throw new RangeError('coalesceDelay must be a non-negative number');
+    }
+    if (typeof summary !== 'function') {
+      throw new TypeError('summary must be a function');
+    }
+    this._Notification = Notification;
+    this._groupId = groupId;
+    this._coalesceDelay = coalesceDelay;
+    this._summary = summary;
+    this._defaults = defaults;
+    // Added while the previous notification of the group was shown less than
+    // coalesceDelay ago, shown together once it has passed.
+    this._pending = [];
+    this._timer = null;
+    this._notification = null;
+    this._closed = false;
+  }
+
+  get groupId () {
+    return this._groupId;
+  }
+
+  get pendingCount () {
+    return this._pending.length;
+  }
+
+  get notification () {
+    return this._notification;
+  }
+
+  add (options = {}) {
+    if (this._closed) {
+      throw new Error('The notification group is closed');
+    }
+    this._pending.push(options);
+    // The first notification of a burst is shown right away, the rest are
+    // summarized at the end of each coalesceDelay.
+    if (!this._timer) this._flush();
+  }
+
+  close () {
+    this._closed = true;
+    clearTimeout(this._timer);
+    this._timer = null;
+    this._pending = [];
+    if (this._notification) {
+      this._notification.removeAllListeners();
+      this._notification.close();
+      this._notification = null;
+    }
+  }
+
+  _flush () {
+    this._timer = null;
+    const notifications = this._pending.splice(0);
+    if (notifications.length === 0) return;
+
+    const options = notifications.length === 1 ? notifications[0] : this._summary(notifications);
+    this._show(options, notifications);
+    this._timer = setTimeout(() => this._flush(), this._coalesceDelay);
+  }
+
+  _show (options, notifications) {
+    // The new notification replaces the previous one of the group, which does
+    // not report anything about the notifications it stood for anymore.
+    if (this._notification) this._notification.removeAllListeners();
+
+    const notification = new this._Notification({ ...this._defaults, ...options, groupId: this._groupId });
+    for (const name of kForwardedEvents) {
+      notification.on(name, (event, ...args) => {
+        this.emit(name, event, notifications, ...args);
+      });
+    }
+    notification.on('close', () => {
+      if (this._notification === notification) this._notification = null;
+    });
+    this._notification = notification;
+    notification.show();
+    this.emit('show', notifications);
+  }
+}
+
+module.exports = { NotificationGroup };
@@ -0,0 +1,235 @@
+'use strict';
+
+const { EventEmitter } = require('events');
+const fs = require('fs');
+
+const kPriorities = ['low', 'medium', 'high'];
+
+// URLs longer than this are dropped by Chromium, see url::kMaxURLChars.
+const kMaxURLLength = 2 * 1024 * 1024;
+
+const validatePositiveInteger = (name, value) => {
+  if (!Number.isInteger(value) || value < 1) {
+    throw new RangeError(`${name} must be a positive integer`);
+  }
+};
+
+const getSourceURL = (source) => {
+  if (typeof source === 'string') return source;
+  if (source && typeof source.url === 'string') return source.url;
+  if (source && typeof source.html === 'string') {
+    const url = `data:text/html;charset=utf-8;base64,${Buffer.from(source.html).toString('base64')}`;
+    if (url.length > kMaxURLLength) {
+      throw new RangeError('The html of the source is too large, load it from a file with the url property instead');
+    }
+    return url;
+  }
+  throw new TypeError('source must be a URL or an Object with a url or html property');
+};
+
+const writeToStream = (stream, data) => new Promise((resolve, reject) => {
+  stream.once('error', reject);
+  stream.end(data, () => {
+    stream.removeListener('error', reject);
+    resolve();
+  });
+});
+
+// Rejects when the renderer of |webContents| goes away, otherwise the pending
+// load or print would never settle.
+const whenGone = (webContents) => {
+  let cleanup;
+  const promise = new Promise((resolve, reject) => {
+    const onCrashed = () => reject(new Error('The renderer of the PDF job crashed'));
+    const onDestroyed = () => reject(new Error('The WebContents of the PDF job was destroyed'));
+    webContents.once('crashed', onCrashed);
+    webContents.once('destroyed', onDestroyed);
+    cleanup = () => {
+      webContents.removeListener('crashed', onCrashed);
+      webContents.removeListener('destroyed', onDestroyed);
+    };
+  });
+  return { promise, cleanup };
+};
+
+class PDFQueue extends EventEmitter {
+  constructor (options = {}) {
+    super();
+    const { maxConcurrentJobs = 2, maxJobsPerWebContents = 100, webPreferences = {} } = options;
+    validatePositiveInteger('maxConcurrentJobs', maxConcurrentJobs);
+    validatePositiveInteger('maxJobsPerWebContents', maxJobsPerWebContents);
+    this._maxConcurrentJobs = maxConcurrentJobs;
+    this._maxJobsPerWebContents = maxJobsPerWebContents;
+    this._webPreferences = webPreferences;
+    // Sorted by priority, then in the order the jobs were added.
+    this._pendingJobs = [];
+    this._activeJobCount = 0;
+    this._nextJobId = 1;
+    // Hidden windows that finished their job, reused by the next ones.
+    this._idleWindows = [];
+    this._closed = false;
+  }
+
+  get maxConcurrentJobs () {
+    return this._maxConcurrentJobs;
+  }
+
+  set maxConcurrentJobs (value) {
+    validatePositiveInteger('maxConcurrentJobs', value);
+    this._maxConcurrentJobs = value;
+    this._trimIdleWindows();
+    this._schedule();
+  }
+
+  get activeJobCount () {
+    return this._activeJobCount;
+  }
+
+  get pendingJobCount () {
+    return this._pendingJobs.length;
+  }
+
+  render (source, options = {}) {
+    if (this._closed) {
+      return Promise.reject(new Error('The PDF queue is closed'));
+    }
+
+    const { priority = 'medium', path, stream, ...pdfOptions } = options;
+    let url;
+    try {
+      url = getSourceURL(source);
+    } catch (error) {
+      return Promise.reject(error);
+    }
+    if (!kPriorities.includes(priority)) {
+      return Promise.reject(new TypeError(`Invalid job priority '${priority}'`));
+    }
+    if (path != null && stream != null) {
+      return Promise.reject(new TypeError('path and stream can not be both set'));
+    }
+
+    return new Promise((resolve, reject) => {
+      const job = {
+        id: this._nextJobId++,
+        url,
+        rank: kPriorities.indexOf(priority),
+        path,
+        stream,
+        pdfOptions,
+        queuedAt: Date.now(),
+        resolve,
+        reject
+      };
+      const index = this._pendingJobs.findIndex(pending => pending.rank < job.rank);
+      if (index === -1) {
+        this._pendingJobs.push(job);
+      } else {
+        this._pendingJobs.splice(index, 0, job);
+      }
+      this._schedule();
+    });
+  }
+
+  close () {
+    this._closed = true;
+    for (const job of this._pendingJobs.splice(0)) {
+      job.reject(new Error('The PDF queue is closed'));
+    }
+    for (const { window } of this._idleWindows.splice(0)) {
+      window.destroy();
+    }
+  }
+
+  _schedule () {
+    while (this._activeJobCount < this._maxConcurrentJobs && this._pendingJobs.length > 0) {
+      const job = this._pendingJobs.shift();
+      this._activeJobCount++;
+      this._run(job).then(job.resolve, job.reject);
+    }
+  }
+
+  _acquireWindow () {
+    const idle = this._idleWindows.pop();
+    if (idle) return { ...idle, reused: true };
+
+    const { BrowserWindow } = require('electron');
+    const window = new BrowserWindow({ show: false, webPreferences: this._webPreferences });
+    return { window, jobCount: 0, reused: false };
+  }
+
+  _releaseWindow (entry, healthy) {
+    const { window } = entry;
+    const jobCount = entry.jobCount + 1;
+    // A window is only kept while the queue needs it, and is recycled after a
+    // number of jobs so that what leaks in its renderer stays bounded.
+    if (!healthy || this._closed || window.isDestroyed() ||
+        jobCount >= this._maxJobsPerWebContents) {
+      if (!window.isDestroyed()) window.destroy();
+      return;
+    }
+    this._idleWindows.push({ window, jobCount });
+    this._trimIdleWindows();
+  }
+
+  _trimIdleWindows () {
+    const excess = this._activeJobCount + this._idleWindows.length - this._maxConcurrentJobs;
+    if (excess > 0) {
+      for (const { window } of this._idleWindows.splice(0, excess)) {
+        window.destroy();
+      }
+    }
+  }
+
+  async _run (job) {
+    const startedAt = Date.now();
+    const entry = this._acquireWindow();
+    const { webContents } = entry.window;
+    const gone = whenGone(webContents);
+    let healthy = false;
+    this.emit('job-started', { id: job.id, url: job.url });
+    try {
+      await Promise.race([webContents.loadURL(job.url), gone.promise]);
+      const loadedAt = Date.now();
+      const data = await Promise.race([webContents.printToPDF(job.pdfOptions), gone.promise]);
+      const printedAt = Date.now();
+      healthy = true;
+
+      if (job.path != null) {
+        await fs.promises.writeFile(job.path, data);
+      } else if (job.stream != null) {
+        await writeToStream(job.stream, data);
+      }
+      const finishedAt = Date.now();
+
+      const stats = {
+        id: job.id,
+        queueTime: startedAt - job.queuedAt,
+        loadTime: loadedAt - startedAt,
+        printTime: printedAt - loadedAt,
+        writeTime: finishedAt - printedAt,
+        totalTime: finishedAt - job.queuedAt,
+        size: data.length,
+        reusedWebContents: entry.reused
+      };
+      this.emit('job-finished', stats);
+
+      const result = { stats };
+      if (job.path != null) {
+        result.path = job.path;
+      } else if (job.stream == null) {
+        result.data = data;
+      }
+      return result;
+    } catch (error) {
+      this.emit('job-failed', { id: job.id, error });
+      throw error;
+    } finally {
+      gone.cleanup();
+      this._activeJobCount--;
+      this._releaseWindow(entry, healthy);
+      this._schedule();
+    }
+  }
+}
+
+module.exports = { PDFQueue };
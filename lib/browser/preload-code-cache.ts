@@ -0,0 +1,190 @@
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+
+// V8 code caches of the scripts run by renderers, by session, by origin and
+// by the hash of the script source. Persistent sessions also keep them on
+// disk, so the scripts are not compiled again after a restart.
+//
+// The caches are produced by renderers, so the cache a renderer stores for
+// an origin is only served to the renderers of that origin, and only when
+// its process is allowed to hold the data of that origin. A compromised
+// renderer can't have its code run by the renderers of other sites.
+
+// Code caches are a few times the size of the source, anything larger than
+// this is not worth keeping.
+const kMaxCacheSize = 16 * 1024 * 1024;
+
+// The caches of a session past these are removed, least recently used first.
+const kMaxMemoryBytes = 32 * 1024 * 1024;
+const kMaxDiskBytes = 64 * 1024 * 1024;
+
+// Caches on disk which were not used for that long are removed.
+const kMaxUnusedAge = 30 * 24 * 60 * 60 * 1000;
+
+export const hashScript = function (source: string) {
+  return crypto.createHash('sha256').update(source).digest('hex');
+};
+
+interface CodeCacheSender {
+  sender: Electron.WebContents;
+  processId: number;
+}
+
+interface ServedScript {
+  origin: string;
+  key: string;
+}
+
+class ScriptCodeCache {
+  // Ordered from the least to the most recently used.
+  private memoryCaches = new WeakMap<Electron.Session, Map<string, Buffer>>();
+  private memoryBytes = new WeakMap<Electron.Session, number>();
+
+  // The scripts served to each renderer, by process and hash. Renderers can
+  // only store caches for those, under the origin they were served for.
+  private servedScripts = new WeakMap<Electron.WebContents, Map<string, ServedScript>>();
+
+  private prunedDirectories = new Set<string>();
+
+  constructor (private directoryName: string) {}
+
+  private getMemoryCache (session: Electron.Session) {
+    let cache = this.memoryCaches.get(session);
+    if (!cache) {
+      cache = new Map();
+      this.memoryCaches.set(session, cache);
+    }
+    return cache;
+  }
+
+  private addToMemoryCache (session: Electron.Session, key: string, data: Buffer) {
+    const cache = this.getMemoryCache(session);
+    let bytes = this.memoryBytes.get(session) || 0;
+    const previous = cache.get(key);
+    if (previous) {
+      bytes -= previous.length;
+      cache.delete(key);
+    }
+    cache.set(key, data);
+    bytes += data.length;
+    for (const [oldestKey, oldest] of cache) {
+      if (bytes <= kMaxMemoryBytes) break;
+      cache.delete(oldestKey);
+      bytes -= oldest.length;
+    }
+    this.memoryBytes.set(session, bytes);
+  }
+
+  private getCacheDirectory (session: Electron.Session) {
+    const storagePath = session._getStoragePath();
+    if (!storagePath) return null;
+    const directory = path.join(storagePath, this.directoryName);
+    if (!this.prunedDirectories.has(directory)) {
+      this.prunedDirectories.add(directory);
+      pruneDirectory(directory).catch(() => {});
+    }
+    return directory;
+  }
+
+  // The origin whose caches the renderer of |event| can use, if any.
+  private getOrigin ({ sender, processId }: CodeCacheSender) {
+    const url = sender.getURL();
+    if (!url || !sender._canProcessAccessURL(processId, url)) return null;
+    // Not URL.origin, which is opaque for file: URLs.
+    const { protocol, host } = new URL(url);
+    return `${protocol}//${host}`;
+  }
+
+  async get (event: CodeCacheSender, hash: string) {
+    const origin = this.getOrigin(event);
+    if (!origin) return null;
+
+    const key = hashScript(`${origin}\n${hash}`);
+    let scripts = this.servedScripts.get(event.sender);
+    if (!scripts) {
+      scripts = new Map();
+      this.servedScripts.set(event.sender, scripts);
+    }
+    scripts.set(`${event.processId}:${hash}`, { origin, key });
+
+    const { session } = event.sender;
+    const cached = this.getMemoryCache(session).get(key);
+    if (cached) {
+      this.addToMemoryCache(session, key, cached);
+      return cached;
+    }
+
+    const directory = this.getCacheDirectory(session);
+    if (!directory) return null;
+    try {
+      const file = path.join(directory, key);
+      const data = await fs.promises.readFile(file);
+      this.addToMemoryCache(session, key, data);
+      const now = new Date();
+      fs.promises.utimes(file, now, now).catch(() => {});
+      return data;
+    } catch (error) {
+      return null;
+    }
+  }
+
+  set (event: CodeCacheSender, hash: string, data: Uint8Array) {
+    const scripts = this.servedScripts.get(event.sender);
+    const script = scripts && scripts.get(`${event.processId}:${hash}`);
+    if (!script || !(data instanceof Uint8Array) || data.length > kMaxCacheSize) return;
+    // The renderer may have been swapped out since the script was served.
+    if (!event.sender._canProcessAccessURL(event.processId, script.origin)) return;
+
+    const buffer = Buffer.from(data);
+    const { session } = event.sender;
+    this.addToMemoryCache(session, script.key, buffer);
+
+    const directory = this.getCacheDirectory(session);
+    if (!directory) return;
+    fs.promises.mkdir(directory, { recursive: true })
+      .then(() => fs.promises.writeFile(path.join(directory, script.key), buffer))
+      .catch(() => {});
+  }
+}
+
+// Removes the caches of |directory| which were not used for a while, then
+// the least recently used ones past kMaxDiskBytes.
+const pruneDirectory = async function (directory: string) {
+  const names = await fs.promises.readdir(directory);
+  const files = await Promise.all(names.map(async name => {
+    const file = path.join(directory, name);
+    return { file, stats: await fs.promises.stat(file) };
+  }));
+  files.sort((a, b) => b.stats.mtimeMs - a.stats.mtimeMs);
+
+  const now = Date.now();
+  let bytes = 0;
+  for (const { file, stats } of files) {
+    bytes += stats.size;
+    if (bytes > kMaxDiskBytes || now - stats.mtimeMs > kMaxUnusedAge) {
+      await fs.promises.unlink(file).catch(() => {});
+    }
+  }
+};
+
+const preloadCodeCache = new ScriptCodeCache('Preload Code Cache');
+const contentScriptCodeCache = new ScriptCodeCache('Content Script Code Cache');
+
+export const hashPreloadScript = hashScript;
+
+export const getPreloadCodeCache = function (event: CodeCacheSender, hash: string) {
+  return preloadCodeCache.get(event, hash);
+};
+
+export const setPreloadCodeCache = function (event: CodeCacheSender, hash: string, data: Uint8Array) {
+  preloadCodeCache.set(event, hash, data);
+};
+
+export const getContentScriptCodeCache = function (event: CodeCacheSender, hash: string) {
+  return contentScriptCodeCache.get(event, hash);
+};
+
+export const setContentScriptCodeCache = function (event: CodeCacheSender, hash: string, data: Uint8Array) {
+  contentScriptCodeCache.set(event, hash, data);
+};
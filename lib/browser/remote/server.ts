@@ -30,11 +30,19 @@ type ObjectMember = {
   value?: any,
   enumerable?: boolean,
   writable?: boolean,
-  type?: 'method' | 'get'
+  type?: 'method' | 'get' | 'value'
 }
 
+// Whether a property can never change, so its value can be sent along with
+// the description of the object.
+const isImmutablePrimitive = function (descriptor: PropertyDescriptor) {
+  if (!('value' in descriptor) || descriptor.writable || descriptor.configurable) return false;
+  const { value } = descriptor;
+  return value === null || (typeof value !== 'object' && typeof value !== 'function' && typeof value !== 'symbol');
+};
+
 // Return the description of object's members:
-const getObjectMembers = function (object: any): ObjectMember[] {
+const getObjectMembers = function (object: any, snapshot: boolean): ObjectMember[] {
   let names = Object.getOwnPropertyNames(object);
   // For Function, we should not override following properties even though they
   // are "own" properties.
@@ -46,6 +54,9 @@ const getObjectMembers = function (object: any): ObjectMember[] {
   // Map properties to descriptors.
   return names.map((name) => {
     const descriptor = Object.getOwnPropertyDescriptor(object, name)!;
+    if (snapshot && isImmutablePrimitive(descriptor)) {
+      return { name, enumerable: descriptor.enumerable, type: 'value', value: descriptor.value };
+    }
     let type: ObjectMember['type'];
     let writable = false;
     if (descriptor.get === undefined && typeof object[name] === 'function') {
@@ -64,12 +75,12 @@ type ObjProtoDescriptor = {
 } | null
 
 // Return the description of object's prototype.
-const getObjectPrototype = function (object: any): ObjProtoDescriptor {
+const getObjectPrototype = function (object: any, snapshot: boolean): ObjProtoDescriptor {
   const proto = Object.getPrototypeOf(object);
   if (proto === null || proto === Object.prototype) return null;
   return {
-    members: getObjectMembers(proto),
-    proto: getObjectPrototype(proto)
+    members: getObjectMembers(proto, snapshot),
+    proto: getObjectPrototype(proto, snapshot)
   };
 };
 
@@ -147,6 +158,7 @@ const valueToMeta = function (sender: electron.WebContents, contextId: string, v
       members: value.map((el: any) => valueToMeta(sender, contextId, el, optimizeSimpleObject))
     };
   } else if (type === 'object' || type === 'function') {
+    const snapshot = isRemotePropertySnapshotEnabled(sender);
     return {
       type,
       name: value.constructor ? value.constructor.name : '',
@@ -154,8 +166,8 @@ const valueToMeta = function (sender: electron.WebContents, contextId: string, v
       // passed to renderer we would assume the renderer keeps a reference of
       // it.
       id: objectsRegistry.add(sender, contextId, value),
-      members: getObjectMembers(value),
-      proto: getObjectPrototype(value)
+      members: getObjectMembers(value, snapshot),
+      proto: getObjectPrototype(value, snapshot)
     };
   } else if (type === 'buffer') {
     return { type, value };
@@ -327,6 +339,17 @@ const isRemoteModuleEnabledImpl = function (contents: electron.WebContents) {
 
 const isRemoteModuleEnabledCache = new WeakMap();
 
+const isRemotePropertySnapshotEnabledCache = new WeakMap<electron.WebContents, boolean>();
+
+const isRemotePropertySnapshotEnabled = function (contents: electron.WebContents) {
+  if (!isRemotePropertySnapshotEnabledCache.has(contents)) {
+    const webPreferences = (contents as any).getLastWebPreferences() || {};
+    isRemotePropertySnapshotEnabledCache.set(contents, !!webPreferences.enableRemotePropertySnapshots);
+  }
+
+  return isRemotePropertySnapshotEnabledCache.get(contents)!;
+};
+
 const isRemoteModuleEnabled = function (contents: electron.WebContents) {
   if (!isRemoteModuleEnabledCache.has(contents)) {
     isRemoteModuleEnabledCache.set(contents, isRemoteModuleEnabledImpl(contents));
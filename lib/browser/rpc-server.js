@@ -4,7 +4,6 @@ const electron = require('electron');
 const fs = require('fs');
 
 const eventBinding = process.electronBinding('event');
-const clipboard = process.electronBinding('clipboard');
 const features = process.electronBinding('features');
 
 const { crashReporterInit } = require('@electron/internal/browser/crash-reporter-init');
@@ -12,6 +11,13 @@ const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-interna
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils');
 const guestViewManager = require('@electron/internal/browser/guest-view-manager');
 const typeUtils = require('@electron/internal/common/type-utils');
+const {
+  hashPreloadScript,
+  getPreloadCodeCache,
+  setPreloadCodeCache,
+  getContentScriptCodeCache,
+  setContentScriptCodeCache
+} = require('@electron/internal/browser/preload-code-cache');
 
 const emitCustomEvent = function (contents, eventName, ...args) {
   const event = eventBinding.createWithSender(contents);
@@ -46,27 +52,44 @@ ipcMainInternal.handle('ELECTRON_BROWSER_GET_LAST_WEB_PREFERENCES', function (ev
 });
 
 // Methods not listed in this set are called directly in the renderer process.
-const allowedClipboardMethods = (() => {
-  switch (process.platform) {
-    case 'darwin':
-      return new Set(['readFindText', 'writeFindText']);
-    case 'linux':
-      return new Set(Object.keys(clipboard));
-    default:
-      return new Set();
+// Computed on first use so the clipboard binding is not loaded at startup.
+let allowedClipboardMethods = null;
+const isAllowedClipboardMethod = function (method) {
+  if (!allowedClipboardMethods) {
+    switch (process.platform) {
+      case 'darwin':
+        allowedClipboardMethods = new Set(['readFindText', 'writeFindText']);
+        break;
+      case 'linux':
+        allowedClipboardMethods = new Set(Object.keys(process.electronBinding('clipboard')));
+        break;
+      default:
+        allowedClipboardMethods = new Set();
+    }
   }
-})();
+  return allowedClipboardMethods.has(method);
+};
 
 ipcMainUtils.handleSync('ELECTRON_BROWSER_CLIPBOARD', function (event, method, ...args) {
-  if (!allowedClipboardMethods.has(method)) {
+  if (!isAllowedClipboardMethod(method)) {
     throw new Error(`Invalid method: ${method}`);
   }
 
   return typeUtils.serialize(electron.clipboard[method](...typeUtils.deserialize(args)));
 });
 
+ipcMainInternal.handle('ELECTRON_BROWSER_CLIPBOARD_ASYNC', async function (event, method, ...args) {
+  if (!isAllowedClipboardMethod(method) || !method.endsWith('Async')) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  return typeUtils.serialize(await electron.clipboard[method](...typeUtils.deserialize(args)));
+});
+
 if (features.isDesktopCapturerEnabled()) {
-  const desktopCapturer = require('@electron/internal/browser/desktop-capturer');
+  // Loading the module initializes the native desktop capturer, which is only
+  // needed once a renderer asks for sources.
+  const getDesktopCapturer = () => require('@electron/internal/browser/desktop-capturer');
 
   ipcMainInternal.handle('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', function (event, options, stack) {
     logStack(event.sender, 'desktopCapturer.getSources()', stack);
@@ -77,7 +100,23 @@ if (features.isDesktopCapturerEnabled()) {
       return [];
     }
 
-    return desktopCapturer.getSources(event, options);
+    return getDesktopCapturer().getSources(event, options);
+  });
+
+  ipcMainInternal.handle('ELECTRON_BROWSER_DESKTOP_CAPTURER_START_WATCHING', function (event, options, stack) {
+    logStack(event.sender, 'desktopCapturer.watchSources()', stack);
+    const customEvent = emitCustomEvent(event.sender, 'desktop-capturer-get-sources');
+
+    if (customEvent.defaultPrevented) {
+      console.error('Blocked desktopCapturer.watchSources()');
+      return;
+    }
+
+    getDesktopCapturer().startWatching(event, options);
+  });
+
+  ipcMainInternal.on('ELECTRON_BROWSER_DESKTOP_CAPTURER_STOP_WATCHING', function (event, channel) {
+    getDesktopCapturer().stopWatching(event, channel);
   });
 }
 
@@ -85,38 +124,53 @@ const isRemoteModuleEnabled = features.isRemoteModuleEnabled()
   ? require('@electron/internal/browser/remote/server').isRemoteModuleEnabled
   : () => false;
 
-const getPreloadScript = async function (preloadPath) {
+const getPreloadScript = async function (event, preloadPath) {
   let preloadSrc = null;
   let preloadError = null;
+  let preloadHash = null;
+  let preloadCodeCache = null;
   try {
     preloadSrc = (await fs.promises.readFile(preloadPath)).toString();
+    preloadHash = hashPreloadScript(preloadSrc);
+    preloadCodeCache = await getPreloadCodeCache(event, preloadHash);
   } catch (error) {
     preloadError = error;
   }
-  return { preloadPath, preloadSrc, preloadError };
+  return { preloadPath, preloadSrc, preloadError, preloadHash, preloadCodeCache };
 };
 
-if (features.isExtensionsEnabled()) {
-  ipcMainUtils.handleSync('ELECTRON_GET_CONTENT_SCRIPTS', () => []);
-} else {
+// The content scripts of the loaded extensions, with the code cache of their
+// scripts for the renderer of |event|, so that the frames after the first one
+// to run a script do not compile it again.
+const getContentScripts = async function (event) {
+  if (features.isExtensionsEnabled()) return [];
+
   const { getContentScripts } = require('@electron/internal/browser/chrome-extension');
-  ipcMainUtils.handleSync('ELECTRON_GET_CONTENT_SCRIPTS', () => getContentScripts());
-}
+  const withCodeCache = async function (script) {
+    return { ...script, codeCache: await getContentScriptCodeCache(event, script.hash) };
+  };
+  return Promise.all(getContentScripts().map(async entry => ({
+    ...entry,
+    contentScripts: await Promise.all(entry.contentScripts.map(async contentScript => ({
+      ...contentScript,
+      js: await Promise.all(contentScript.js.map(withCodeCache))
+    })))
+  })));
+};
 
-ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event) {
-  const preloadPaths = event.sender._getPreloadPaths();
+ipcMainUtils.handleSync('ELECTRON_GET_CONTENT_SCRIPTS', function (event) {
+  return getContentScripts(event);
+});
 
-  let contentScripts = [];
-  if (!features.isExtensionsEnabled()) {
-    const { getContentScripts } = require('@electron/internal/browser/chrome-extension');
-    contentScripts = getContentScripts();
-  }
+ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event) {
+  // Prerendered pages only warm the caches of the session.
+  const preloadPaths = event.sender._isPrerender() ? [] : event.sender._getPreloadPaths();
 
   const webPreferences = event.sender.getLastWebPreferences() || {};
 
   return {
-    contentScripts,
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
+    contentScripts: await getContentScripts(event),
+    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(event, path))),
     isRemoteModuleEnabled: isRemoteModuleEnabled(event.sender),
     isWebViewTagEnabled: guestViewManager.isWebViewTagEnabled(event.sender),
     guestInstanceId: webPreferences.guestInstanceId,
@@ -135,3 +189,11 @@ ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event)
 ipcMainInternal.on('ELECTRON_BROWSER_PRELOAD_ERROR', function (event, preloadPath, error) {
   event.sender.emit('preload-error', event, preloadPath, error);
 });
+
+ipcMainInternal.on('ELECTRON_BROWSER_PRELOAD_CODE_CACHE', function (event, preloadHash, codeCache) {
+  setPreloadCodeCache(event, preloadHash, codeCache);
+});
+
+ipcMainInternal.on('ELECTRON_BROWSER_CONTENT_SCRIPT_CODE_CACHE', function (event, hash, codeCache) {
+  setContentScriptCodeCache(event, hash, codeCache);
+});
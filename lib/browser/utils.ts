@@ -36,3 +36,36 @@ export function createLazyInstance (
   }
   return module;
 }
+
+/**
+ * Keeps the native side of an EventEmitter informed of whether there are
+ * listeners for the given events, so that it skips emitting them when there
+ * are none.
+ *
+ * @param {Object} emitter - the EventEmitter with a native _setListenerCount()
+ * @param {String[]} events - the names of the events to count listeners of
+ */
+export function trackListeners (emitter: any, events: string[]) {
+  const tracked = new Set(events);
+  for (const event of tracked) {
+    emitter._setListenerCount(event, emitter.listenerCount(event));
+  }
+  // Emitted before the listener is added.
+  emitter.on('newListener', (event: string) => {
+    if (tracked.has(event)) {
+      emitter._setListenerCount(event, emitter.listenerCount(event) + 1);
+    }
+  });
+  emitter.on('removeListener', (event: string) => {
+    if (tracked.has(event)) {
+      emitter._setListenerCount(event, emitter.listenerCount(event));
+    } else if (event === 'newListener') {
+      // Added listeners are no longer counted, e.g. after
+      // removeAllListeners(), so the events are always emitted again.
+      for (const trackedEvent of tracked) {
+        emitter._setListenerCount(trackedEvent, -1);
+      }
+      tracked.clear();
+    }
+  });
+}
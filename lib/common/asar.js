@@ -42,19 +42,70 @@
     return newArchive;
   };
 
+  // Module resolution probes the same paths over and over, so path splitting
+  // and lookups are memoized. Archives are immutable and whether a path is an
+  // archive is already cached forever by the native side, so the caches only
+  // need to be bounded.
+  const kMaxCachedLookups = 4096;
+
+  const setBounded = (cache, key, value) => {
+    if (cache.size >= kMaxCachedLookups) {
+      // Maps iterate in insertion order, evict the oldest entry.
+      cache.delete(cache.keys().next().value);
+    }
+    cache.set(key, value);
+    return value;
+  };
+
+  // Per-archive caches of stat and readdir results, including negative ones.
+  const archiveLookupCaches = new WeakMap();
+
+  const getLookupCache = archive => {
+    let cache = archiveLookupCaches.get(archive);
+    if (!cache) {
+      cache = { stats: new Map(), dirs: new Map() };
+      archiveLookupCaches.set(archive, cache);
+    }
+    return cache;
+  };
+
+  const statArchive = (archive, filePath) => {
+    const { stats } = getLookupCache(archive);
+    const cached = stats.get(filePath);
+    if (cached !== undefined) return cached;
+    return setBounded(stats, filePath, archive.stat(filePath));
+  };
+
+  const readdirArchive = (archive, filePath) => {
+    const { dirs } = getLookupCache(archive);
+    let files = dirs.get(filePath);
+    if (files === undefined) files = setBounded(dirs, filePath, archive.readdir(filePath));
+    // Callers own the returned array.
+    return files && files.slice();
+  };
+
+  const notAsar = Object.freeze({ isAsar: false });
+  const splitPathCache = new Map();
+
   // Separate asar package's path from full path.
   const splitPath = archivePathOrBuffer => {
     // Shortcut for disabled asar.
-    if (isAsarDisabled()) return { isAsar: false };
+    if (isAsarDisabled()) return notAsar;
 
     // Check for a bad argument type.
     let archivePath = archivePathOrBuffer;
     if (Buffer.isBuffer(archivePathOrBuffer)) {
       archivePath = archivePathOrBuffer.toString();
     }
-    if (typeof archivePath !== 'string') return { isAsar: false };
+    if (typeof archivePath !== 'string') return notAsar;
+
+    // Paths without an archive in them do not need to go native.
+    if (!/\.asar/i.test(archivePath)) return notAsar;
 
-    return asar.splitPath(path.normalize(archivePath));
+    const cached = splitPathCache.get(archivePath);
+    if (cached !== undefined) return cached;
+    const result = Object.freeze(asar.splitPath(path.normalize(archivePath)));
+    return setBounded(splitPathCache, archivePath, result);
   };
 
   // Convert asar archive's Stats object to fs's Stats object.
@@ -217,16 +268,11 @@
 
   // Override fs APIs.
   exports.wrapFsWithAsar = fs => {
-    const logFDs = {};
+    // The log is shared with the native readers, so that it records the order
+    // in which files are first read by any part of the process.
     const logASARAccess = (asarPath, filePath, offset) => {
       if (!process.env.ELECTRON_LOG_ASAR_READS) return;
-      if (!logFDs[asarPath]) {
-        const path = require('path');
-        const logFilename = `${path.basename(asarPath, '.asar')}-access-log.txt`;
-        const logPath = path.join(require('os').tmpdir(), logFilename);
-        logFDs[asarPath] = fs.openSync(logPath, 'a');
-      }
-      fs.writeSync(logFDs[asarPath], `${offset}: ${filePath}\n`);
+      asar.logArchiveRead(asarPath, filePath, offset);
     };
 
     const { lstatSync } = fs;
@@ -237,7 +283,7 @@
       const archive = getOrCreateArchive(asarPath);
       if (!archive) throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
 
-      const stats = archive.stat(filePath);
+      const stats = statArchive(archive, filePath);
       if (!stats) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
 
       return asarStatsToFsStats(stats);
@@ -259,7 +305,7 @@
         return;
       }
 
-      const stats = archive.stat(filePath);
+      const stats = statArchive(archive, filePath);
       if (!stats) {
         const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
         nextTick(callback, [error]);
@@ -372,7 +418,7 @@
         return;
       }
 
-      const pathExists = (archive.stat(filePath) !== false);
+      const pathExists = (statArchive(archive, filePath) !== false);
       nextTick(callback, [pathExists]);
     };
 
@@ -386,7 +432,7 @@
         return Promise.reject(error);
       }
 
-      return Promise.resolve(archive.stat(filePath) !== false);
+      return Promise.resolve(statArchive(archive, filePath) !== false);
     };
 
     const { existsSync } = fs;
@@ -397,7 +443,7 @@
       const archive = getOrCreateArchive(asarPath);
       if (!archive) return false;
 
-      return archive.stat(filePath) !== false;
+      return statArchive(archive, filePath) !== false;
     };
 
     const { access } = fs;
@@ -429,7 +475,7 @@
         return fs.access(realPath, mode, callback);
       }
 
-      const stats = archive.stat(filePath);
+      const stats = statArchive(archive, filePath);
       if (!stats) {
         const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
         nextTick(callback, [error]);
@@ -469,7 +515,7 @@
         return fs.accessSync(realPath, mode);
       }
 
-      const stats = archive.stat(filePath);
+      const stats = statArchive(archive, filePath);
       if (!stats) {
         throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
       }
@@ -520,6 +566,21 @@
         return fs.readFile(realPath, options, callback);
       }
 
+      // Compressed files are decompressed by the archive, there is no range of
+      // the fd that holds their contents. Files with integrity information are
+      // verified by the archive.
+      if (info.compressed || info.integrity) {
+        const contents = archive.readFile(filePath, false);
+        if (contents === false) {
+          const error = createError(AsarError.INVALID_ARCHIVE, { asarPath });
+          nextTick(callback, [error]);
+          return;
+        }
+        logASARAccess(asarPath, filePath, info.offset);
+        nextTick(callback, [null, encoding ? contents.toString(encoding) : contents]);
+        return;
+      }
+
       const buffer = Buffer.alloc(info.size);
       const fd = archive.getFd();
       if (!(fd >= 0)) {
@@ -562,6 +623,16 @@
       }
 
       const { encoding } = options;
+      const isUtf8 = encoding === 'utf8' || encoding === 'utf-8';
+
+      // Serve the contents from the memory-mapped archive when possible.
+      const contents = archive.readFile(filePath, isUtf8);
+      if (contents !== false) {
+        logASARAccess(asarPath, filePath, info.offset);
+        return (encoding && !isUtf8) ? contents.toString(encoding) : contents;
+      }
+      if (info.compressed || info.integrity) throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
+
       const buffer = Buffer.alloc(info.size);
       const fd = archive.getFd();
       if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
@@ -587,7 +658,7 @@
         return;
       }
 
-      const files = archive.readdir(filePath);
+      const files = readdirArchive(archive, filePath);
       if (!files) {
         const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
         nextTick(callback, [error]);
@@ -609,7 +680,7 @@
         throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
       }
 
-      const files = archive.readdir(filePath);
+      const files = readdirArchive(archive, filePath);
       if (!files) {
         throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
       }
@@ -633,6 +704,13 @@
         return fs.readFileSync(realPath, { encoding: 'utf8' });
       }
 
+      const contents = archive.readFile(filePath, true);
+      if (contents !== false) {
+        logASARAccess(asarPath, filePath, info.offset);
+        return contents;
+      }
+      if (info.compressed || info.integrity) return;
+
       const buffer = Buffer.alloc(info.size);
       const fd = archive.getFd();
       if (!(fd >= 0)) return;
@@ -652,7 +730,7 @@
       if (!archive) return -34;
 
       // -ENOENT
-      const stats = archive.stat(filePath);
+      const stats = statArchive(archive, filePath);
       if (!stats) return -34;
 
       return (stats.isDirectory) ? 1 : 0;
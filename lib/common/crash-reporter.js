@@ -21,11 +21,16 @@ class CrashReporter {
       extra = {},
       ignoreSystemCrashHandler = false,
       submitURL,
-      uploadToServer = true
+      uploadToServer = true,
+      hangTimeout,
+      breadcrumbs = true
     } = options;
 
     if (companyName == null) throw new Error('companyName is a required option to crashReporter.start');
     if (submitURL == null) throw new Error('submitURL is a required option to crashReporter.start');
+    if (hangTimeout != null && !(typeof hangTimeout === 'number' && hangTimeout > 0)) {
+      throw new TypeError('hangTimeout must be a positive number');
+    }
 
     const ret = this.init({
       submitURL,
@@ -39,7 +44,10 @@ class CrashReporter {
     if (extra._companyName == null) extra._companyName = companyName;
     if (extra._version == null) extra._version = ret.appVersion;
 
+    binding.setBreadcrumbsEnabled(!!breadcrumbs);
     binding.start(ret.productName, companyName, submitURL, ret.crashesDirectory, uploadToServer, ignoreSystemCrashHandler, extra);
+
+    if (hangTimeout != null) binding.startHangWatchdog(hangTimeout);
   }
 
   getLastCrashReport () {
@@ -1,7 +1,16 @@
-const handleESModule = (loader: ElectronInternal.ModuleLoader) => () => {
-  const value = loader();
-  if (value.__esModule && value.default) return value.default;
-  return value;
+// Loads the module on first access and keeps it for the next ones, so that
+// only the modules an app uses are evaluated.
+const handleESModule = (loader: ElectronInternal.ModuleLoader) => {
+  let loaded = false;
+  let value: any;
+  return () => {
+    if (!loaded) {
+      value = loader();
+      if (value.__esModule && value.default) value = value.default;
+      loaded = true;
+    }
+    return value;
+  };
 };
 
 // Attaches properties to |targetExports|.
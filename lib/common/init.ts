@@ -49,8 +49,9 @@ global.clearImmediate = timers.clearImmediate;
 timers.setTimeout = wrapWithActivateUvLoop(timers.setTimeout);
 timers.setInterval = wrapWithActivateUvLoop(timers.setInterval);
 
-// Only override the global setTimeout/setInterval impls in the browser process
-if (process.type === 'browser') {
+// Only override the global setTimeout/setInterval impls in the processes that
+// run node's event loop under Chromium's on the main thread.
+if (process.type === 'browser' || process.type === 'utility') {
   global.setTimeout = timers.setTimeout;
   global.setInterval = timers.setInterval;
 }
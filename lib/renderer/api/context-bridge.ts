@@ -8,9 +8,9 @@ const checkContextIsolationEnabled = () => {
 };
 
 const contextBridge = {
-  exposeInMainWorld: (key: string, api: Record<string, any>) => {
+  exposeInMainWorld: (key: string, api: Record<string, any>, options?: Electron.ExposeInMainWorldOptions) => {
     checkContextIsolationEnabled();
-    return binding.exposeAPIInMainWorld(key, api);
+    return binding.exposeAPIInMainWorld(key, api, options);
   },
   debugGC: () => binding._debugGCMaps({})
 };
@@ -1,3 +1,4 @@
+import { EventEmitter } from 'events';
 import { nativeImage } from 'electron';
 import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 
@@ -19,6 +20,16 @@ function getCurrentStack () {
   return (target as any).stack;
 }
 
+let nextUpdateId = 0;
+
+const deserialize = (source: ElectronInternal.GetSourcesResult) => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: nativeImage.createFromDataURL(source.thumbnail),
+  display_id: source.display_id,
+  appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
+} as Electron.DesktopCapturerSource);
+
 export async function getSources (options: Electron.SourcesOptions) {
   if (!isValid(options)) throw new Error('Invalid options');
 
@@ -26,20 +37,111 @@ export async function getSources (options: Electron.SourcesOptions) {
   const captureScreen = options.types.includes('screen');
 
   const { thumbnailSize = { width: 150, height: 150 } } = options;
-  const { fetchWindowIcons = false } = options;
-
-  const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
-    captureWindow,
-    captureScreen,
-    thumbnailSize,
-    fetchWindowIcons
-  } as ElectronInternal.GetSourcesOptions, getCurrentStack());
-
-  return sources.map(source => ({
-    id: source.id,
-    name: source.name,
-    thumbnail: nativeImage.createFromDataURL(source.thumbnail),
-    display_id: source.display_id,
-    appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
-  }));
+  const { fetchWindowIcons = false, onSourceUpdated } = options;
+
+  let updateChannel: string | undefined;
+  const onUpdate = (_event: Electron.IpcRendererEvent, source: ElectronInternal.GetSourcesResult) => {
+    onSourceUpdated!(deserialize(source));
+  };
+  if (typeof onSourceUpdated === 'function') {
+    updateChannel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_SOURCE_UPDATED_${nextUpdateId++}`;
+    ipcRendererInternal.on(updateChannel, onUpdate);
+  }
+
+  try {
+    const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
+      captureWindow,
+      captureScreen,
+      thumbnailSize,
+      fetchWindowIcons,
+      updateChannel
+    } as ElectronInternal.GetSourcesOptions, getCurrentStack());
+
+    return sources.map(deserialize);
+  } finally {
+    if (updateChannel) ipcRendererInternal.removeListener(updateChannel, onUpdate);
+  }
+}
+
+let nextWatcherId = 0;
+
+class DesktopSourceWatcher extends EventEmitter {
+  private channel: string;
+  private sources: Record<ElectronInternal.DesktopSourceType, Electron.DesktopCapturerSource[]> = { window: [], screen: [] };
+
+  constructor (options: Electron.SourcesOptions) {
+    super();
+
+    const captureWindow = options.types.includes('window');
+    const captureScreen = options.types.includes('screen');
+
+    const { thumbnailSize = { width: 150, height: 150 } } = options;
+    const { fetchWindowIcons = false } = options;
+
+    this.channel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_WATCHER_${nextWatcherId++}`;
+    ipcRendererInternal.on(this.channel, this.onChange);
+
+    ipcRendererInternal.invoke('ELECTRON_BROWSER_DESKTOP_CAPTURER_START_WATCHING', {
+      captureWindow,
+      captureScreen,
+      thumbnailSize,
+      fetchWindowIcons,
+      channel: this.channel
+    } as ElectronInternal.WatchSourcesOptions, getCurrentStack()).catch(error => {
+      ipcRendererInternal.removeListener(this.channel, this.onChange);
+      if (this.listenerCount('error') > 0) {
+        this.emit('error', error);
+      } else {
+        console.error(`desktopCapturer.watchSources() failed: ${error}`);
+      }
+    });
+  }
+
+  getSources () {
+    return [...this.sources.window, ...this.sources.screen];
+  }
+
+  stop () {
+    ipcRendererInternal.removeListener(this.channel, this.onChange);
+    ipcRendererInternal.send('ELECTRON_BROWSER_DESKTOP_CAPTURER_STOP_WATCHING', this.channel);
+  }
+
+  private onChange = (_event: Electron.IpcRendererEvent, ...change: ElectronInternal.DesktopSourceChange) => {
+    const sources = this.sources[change[1]];
+    switch (change[0]) {
+      case 'added': {
+        const source = deserialize(change[3]);
+        sources.splice(change[2], 0, source);
+        this.emit('source-added', source);
+        break;
+      }
+      case 'removed': {
+        const [source] = sources.splice(change[2], 1);
+        if (source) this.emit('source-removed', source);
+        break;
+      }
+      case 'moved': {
+        const [source] = sources.splice(change[2], 1);
+        if (source) sources.splice(change[3], 0, source);
+        break;
+      }
+      case 'name-changed':
+      case 'thumbnail-changed': {
+        const previous = sources[change[2]];
+        if (!previous) break;
+        const source = deserialize(change[3]);
+        // The icon is only sent when the source is added.
+        source.appIcon = previous.appIcon;
+        sources[change[2]] = source;
+        this.emit(`source-${change[0]}`, source);
+        break;
+      }
+    }
+  }
+}
+
+export function watchSources (options: Electron.SourcesOptions) {
+  if (!isValid(options)) throw new Error('Invalid options');
+
+  return new DesktopSourceWatcher(options);
 }
@@ -9,6 +9,10 @@ ipcRenderer.send = function (channel, ...args) {
   return ipc.send(internal, channel, args);
 };
 
+ipcRenderer.sendBatched = function (channel, ...args) {
+  return ipc.sendBatched(internal, channel, args);
+};
+
 ipcRenderer.sendSync = function (channel, ...args) {
   return ipc.sendSync(internal, channel, args)[0];
 };
@@ -33,4 +37,16 @@ ipcRenderer.postMessage = function (channel: string, message: any, transferables
   return ipc.postMessage(channel, message, transferables);
 };
 
+ipcRenderer.setHighWaterMark = function (bytes: number) {
+  return ipc.setHighWaterMark(bytes);
+};
+
+ipcRenderer.getQueueStats = function () {
+  return ipc.getQueueStats();
+};
+
+ipcRenderer.whenDrained = function () {
+  return ipc.whenDrained();
+};
+
 export default ipcRenderer;
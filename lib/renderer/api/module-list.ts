@@ -8,6 +8,8 @@ export const rendererModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'contextBridge', loader: () => require('./context-bridge') },
   { name: 'crashReporter', loader: () => require('./crash-reporter') },
   { name: 'ipcRenderer', loader: () => require('./ipc-renderer') },
+  { name: 'nativeTheme', loader: () => require('./native-theme') },
+  { name: 'systemPreferences', loader: () => require('./system-preferences') },
   { name: 'webFrame', loader: () => require('./web-frame') }
 ];
 
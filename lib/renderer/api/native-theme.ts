@@ -0,0 +1,31 @@
+const { getSystemSnapshot } = process.electronBinding('system_snapshot');
+
+// The values used when the snapshot can't be mapped, those of a native theme
+// that was never changed.
+const defaultSnapshot = {
+  shouldUseDarkColors: false,
+  shouldUseHighContrastColors: false,
+  shouldUseInvertedColorScheme: false,
+  themeSource: 'system'
+};
+
+const getSnapshot = () => getSystemSnapshot() || defaultSnapshot;
+
+// A read-only view of the nativeTheme of the main process, read from the
+// snapshot the main process keeps in shared memory instead of over IPC.
+const nativeTheme = {
+  get shouldUseDarkColors (): boolean {
+    return getSnapshot().shouldUseDarkColors;
+  },
+  get shouldUseHighContrastColors (): boolean {
+    return getSnapshot().shouldUseHighContrastColors;
+  },
+  get shouldUseInvertedColorScheme (): boolean {
+    return getSnapshot().shouldUseInvertedColorScheme;
+  },
+  get themeSource (): string {
+    return getSnapshot().themeSource;
+  }
+};
+
+export default nativeTheme;
@@ -114,7 +114,11 @@ function setObjectMembers (ref, object, metaId, members) {
     if (Object.prototype.hasOwnProperty.call(object, member.name)) continue;
 
     const descriptor = { enumerable: member.enumerable };
-    if (member.type === 'method') {
+    if (member.type === 'value') {
+      // The property can not change in the main process, so it is served
+      // from the value sent with the object.
+      descriptor.value = member.value;
+    } else if (member.type === 'method') {
       const remoteMemberFunction = function (...args) {
         let command;
         if (this && this.constructor === remoteMemberFunction) {
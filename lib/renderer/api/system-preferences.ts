@@ -0,0 +1,16 @@
+const { getSystemSnapshot } = process.electronBinding('system_snapshot');
+
+// The values of systemPreferences that the main process keeps in shared
+// memory, so that reading them does not need IPC.
+const systemPreferences: Record<string, Function> = {};
+
+if (process.platform === 'darwin' || process.platform === 'win32') {
+  systemPreferences.getAccentColor = function (): string {
+    // An empty string, like when there is no accent color, when the snapshot
+    // can't be mapped.
+    const snapshot = getSystemSnapshot();
+    return snapshot ? snapshot.accentColor : '';
+  };
+}
+
+export default systemPreferences;
@@ -1,8 +1,10 @@
 import { webFrame } from 'electron';
 
+import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils';
 
 const v8Util = process.electronBinding('v8_util');
+const webFrameBinding = process.electronBinding('web_frame');
 
 const IsolatedWorldIDs = {
   /**
@@ -34,8 +36,7 @@ const matchesPattern = function (pattern: string) {
   return url.match(regexp);
 };
 
-// Run the code with chrome API integrated.
-const runContentScript = function (this: any, extensionId: string, url: string, code: string) {
+const getWorldId = function (extensionId: string) {
   // Assign unique world ID to each extension
   const worldId = extensionWorldId[extensionId] ||
     (extensionWorldId[extensionId] = getIsolatedWorldIdForInstance());
@@ -49,13 +50,26 @@ const runContentScript = function (this: any, extensionId: string, url: string,
     // csp: manifest.content_security_policy,
   });
 
+  return worldId;
+};
+
+// Run the code with chrome API integrated.
+const runContentScript = function (this: any, extensionId: string, url: string, code: string) {
   const sources = [{ code, url }];
-  return webFrame.executeJavaScriptInIsolatedWorld(worldId, sources);
+  return webFrame.executeJavaScriptInIsolatedWorld(getWorldId(extensionId), sources);
 };
 
-const runAllContentScript = function (scripts: Array<Electron.InjectionBase>, extensionId: string) {
-  for (const { url, code } of scripts) {
-    runContentScript.call(window, extensionId, url, code);
+// The hashes of the scripts whose code cache was sent to the browser.
+const sentCodeCaches = new Set<string>();
+
+const runAllContentScript = function (scripts: Array<Electron.ContentScriptSource>, extensionId: string) {
+  const worldId = getWorldId(extensionId);
+  for (const { url, code, hash, codeCache } of scripts) {
+    const newCodeCache = webFrameBinding._runScriptInIsolatedWorld(window, worldId, code, url, codeCache);
+    if (newCodeCache && !sentCodeCaches.has(hash)) {
+      sentCodeCaches.add(hash);
+      ipcRendererInternal.send('ELECTRON_BROWSER_CONTENT_SCRIPT_CODE_CACHE', hash, newCodeCache);
+    }
   }
 };
 
@@ -1,6 +1,8 @@
 import { webFrame, WebFrame } from 'electron';
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils';
 
+const binding = process.electronBinding('web_frame');
+
 // All keys of WebFrame that extend Function
 type WebFrameMethod = {
   [K in keyof WebFrame]:
@@ -17,4 +19,19 @@ export const webFrameInit = () => {
     // will be caught by "keyof WebFrameMethod" though.
     return (webFrame[method] as any)(...args);
   });
+
+  // Run a script in all the frames of the page in this process.
+  ipcRendererUtils.handle('ELECTRON_INTERNAL_RENDERER_EXECUTE_JAVASCRIPT_IN_ALL_FRAMES', async (
+    event, code: string, worldId: number, hasUserGesture: boolean
+  ) => {
+    const results = await binding._executeJavaScriptInAllFrames(window, code, worldId, hasUserGesture);
+    return Promise.all(results.map(async ({ frameId, result, error }: any) => {
+      if (error) return { frameId, error };
+      try {
+        return { frameId, result: await result };
+      } catch (error) {
+        return { frameId, error };
+      }
+    }));
+  });
 };
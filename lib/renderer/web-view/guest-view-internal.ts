@@ -91,6 +91,21 @@ export function deregisterEvents (viewInstanceId: number) {
   ipcRendererInternal.removeAllListeners(`ELECTRON_GUEST_VIEW_INTERNAL_IPC_MESSAGE-${viewInstanceId}`);
 }
 
+// Returns the event of the guest that |eventName| of the element is dispatched
+// for, if any.
+export function getGuestEventName (eventName: string): string | undefined {
+  for (const [guestEventName, deprecatedName] of Object.entries(DEPRECATED_EVENTS)) {
+    if (deprecatedName === eventName) return guestEventName;
+  }
+  if (Object.prototype.hasOwnProperty.call(WEB_VIEW_EVENTS, eventName)) {
+    return eventName;
+  }
+}
+
+export function forwardEvent (guestInstanceId: number, eventName: string) {
+  ipcRendererInternal.invoke('ELECTRON_GUEST_VIEW_MANAGER_FORWARD_EVENT', guestInstanceId, eventName);
+}
+
 export function createGuest (params: Record<string, any>): Promise<number> {
   return ipcRendererInternal.invoke('ELECTRON_GUEST_VIEW_MANAGER_CREATE_GUEST', params);
 }
@@ -60,6 +60,15 @@ const defineWebViewElement = (v8Util: NodeJS.V8UtilBinding, webViewImpl: typeof
       }
     }
 
+    // The browser only sends the events of the guest that have listeners.
+    addEventListener (type: string, listener: any, options?: boolean | AddEventListenerOptions) {
+      const internal = v8Util.getHiddenValue<IWebViewImpl>(this, 'internal');
+      if (internal) {
+        internal.subscribeEvent(type);
+      }
+      super.addEventListener(type, listener, options);
+    }
+
     disconnectedCallback () {
       const internal = v8Util.getHiddenValue<IWebViewImpl>(this, 'internal');
       if (!internal) {
@@ -25,6 +25,9 @@ export class WebViewImpl {
   public hasFocus = false
   public internalInstanceId?: number;
   public resizeObserver?: ResizeObserver;
+  // Events of the guest the element has listened to, only those are sent by
+  // the browser.
+  public subscribedEvents = new Set<string>();
   public userAgentOverride?: string;
   public viewInstanceId: number
 
@@ -116,6 +119,38 @@ export class WebViewImpl {
     });
   }
 
+  // Called when a listener is added to the element for |eventName|.
+  subscribeEvent (eventName: string) {
+    if (eventName === 'resize') {
+      this.subscribedEvents.add(eventName);
+      if (this.guestInstanceId && !this.resizeObserver) {
+        this.observeResize();
+      }
+      return;
+    }
+
+    const guestEventName = guestViewInternal.getGuestEventName(eventName);
+    if (!guestEventName || this.subscribedEvents.has(guestEventName)) {
+      return;
+    }
+    this.subscribedEvents.add(guestEventName);
+    if (this.guestInstanceId) {
+      guestViewInternal.forwardEvent(this.guestInstanceId, guestEventName);
+    }
+  }
+
+  observeResize () {
+    // ResizeObserver is a browser global not recognized by "standard".
+    /* globals ResizeObserver */
+    // TODO(zcbenz): Should we deprecate the "resize" event? Wait, it is not
+    // even documented.
+    if (this.resizeObserver) {
+      this.resizeObserver.disconnect();
+    }
+    this.resizeObserver = new ResizeObserver(this.onElementResize.bind(this));
+    this.resizeObserver.observe(this.internalElement);
+  }
+
   dispatchEvent (webViewEvent: Electron.Event) {
     this.webviewNode.dispatchEvent(webViewEvent);
   }
@@ -169,7 +204,8 @@ export class WebViewImpl {
   buildParams () {
     const params: Record<string, any> = {
       instanceId: this.viewInstanceId,
-      userAgentOverride: this.userAgentOverride
+      userAgentOverride: this.userAgentOverride,
+      events: Array.from(this.subscribedEvents)
     };
 
     for (const attributeName in this.attributes) {
@@ -196,12 +232,11 @@ export class WebViewImpl {
       this.internalElement.contentWindow!
     );
 
-    // ResizeObserver is a browser global not recognized by "standard".
-    /* globals ResizeObserver */
-    // TODO(zcbenz): Should we deprecate the "resize" event? Wait, it is not
-    // even documented.
-    this.resizeObserver = new ResizeObserver(this.onElementResize.bind(this));
-    this.resizeObserver.observe(this.internalElement);
+    // Watching the size of the element costs a layout observation per frame,
+    // only do it when someone listens to the "resize" event.
+    if (this.subscribedEvents.has('resize')) {
+      this.observeResize();
+    }
   }
 }
 
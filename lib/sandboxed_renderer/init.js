@@ -46,9 +46,14 @@ const electron = require('electron');
 
 const loadedModules = new Map([
   ['electron', electron],
-  ['events', events],
-  ['timers', require('timers')],
-  ['url', require('url')]
+  ['events', events]
+]);
+
+// Modules of the bundle that preload scripts may require, only evaluated when
+// they are, most pages never ask for the url polyfill.
+const loadableModules = new Map([
+  ['timers', () => require('timers')],
+  ['url', () => require('url')]
 ]);
 
 // ElectronApiServiceImpl will look for the "ipcNative" hidden object when
@@ -108,6 +113,11 @@ function preloadRequire (module) {
   if (loadedModules.has(module)) {
     return loadedModules.get(module);
   }
+  if (loadableModules.has(module)) {
+    const loaded = loadableModules.get(module)();
+    loadedModules.set(module, loaded);
+    return loaded;
+  }
   throw new Error(`module not found: ${module}`);
 }
 
@@ -168,22 +178,26 @@ if (contextIsolation) {
 // - `process`: The `preloadProcess` object
 // - `Buffer`: Shim of `Buffer` implementation
 // - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc) {
+function runPreloadScript (preloadSrc, preloadHash, preloadCodeCache) {
   const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports) {
   ${preloadSrc}
   })`;
 
   // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc);
-  const { setImmediate, clearImmediate } = require('timers');
+  const { fn: preloadFn, codeCache } = binding.createPreloadScript(preloadWrapperSrc, preloadCodeCache);
+  if (codeCache) {
+    // Keep the code cache for the next loads of the same script.
+    ipcRendererInternal.send('ELECTRON_BROWSER_PRELOAD_CODE_CACHE', preloadHash, codeCache);
+  }
+  const { setImmediate, clearImmediate } = preloadRequire('timers');
 
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, {});
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+for (const { preloadPath, preloadSrc, preloadError, preloadHash, preloadCodeCache } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc);
+      runPreloadScript(preloadSrc, preloadHash, preloadCodeCache);
     } else if (preloadError) {
       throw preloadError;
     }
@@ -0,0 +1,3 @@
+// The modules of Electron need a browser or a renderer process, there are none
+// in a utility process.
+module.exports = {};
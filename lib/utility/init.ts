@@ -0,0 +1,39 @@
+import * as path from 'path';
+import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+
+const Module = require('module');
+
+// We modified the original process.argv to let node.js load the init.js,
+// we need to restore it here.
+process.argv.splice(1, 1);
+
+// Clear search paths.
+require('../common/reset-search-paths');
+
+// Import common settings.
+require('@electron/internal/common/init');
+
+const { takeParentPort, takeScriptSource } = process.electronBinding('parent_port');
+
+// The port connected to the utility process object in the main process.
+const parentPort = new MessagePortMain(takeParentPort());
+Object.defineProperty(process, 'parentPort', {
+  enumerable: true,
+  value: parentPort
+});
+parentPort.start();
+
+const script = process.argv[1];
+const source = takeScriptSource();
+if (source === null) {
+  Module._load(script, Module, true);
+} else {
+  // Sandboxed processes can not read the script, the main process sends it.
+  const main = new Module(script, null);
+  main.filename = script;
+  main.paths = Module._nodeModulePaths(path.dirname(script));
+  main.id = '.';
+  process.mainModule = main;
+  main._compile(source, script);
+  main.loaded = true;
+}
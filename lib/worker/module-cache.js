@@ -0,0 +1,63 @@
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+const vm = require('vm');
+const Module = require('module');
+
+// The code caches and resolved paths of the modules required by web workers
+// are kept by the renderer process, so that the workers of a page do not all
+// resolve and compile the same modules again.
+const moduleCache = process._linkedBinding('electron_renderer_worker_module_cache');
+
+const { makeRequireFunction } = __non_webpack_require__('internal/modules/cjs/helpers') // eslint-disable-line
+
+// The resolved paths that were checked to still exist in this worker.
+const checkedPaths = new Set();
+
+const resolveFilename = Module._resolveFilename;
+Module._resolveFilename = function (request, parent, isMain, options) {
+  // Lookups with custom paths, or from modules without a filename, can not
+  // be shared.
+  if (options || !parent || !parent.filename) {
+    return resolveFilename.apply(this, arguments);
+  }
+  const key = `${path.dirname(parent.filename)}\0${request}`;
+  const cached = moduleCache.getResolvedPath(key);
+  // The module may have been moved or removed since it was resolved, which is
+  // only checked the first time the worker uses the resolution.
+  if (cached !== undefined) {
+    if (checkedPaths.has(cached)) return cached;
+    if (fs.existsSync(cached)) {
+      checkedPaths.add(cached);
+      return cached;
+    }
+    moduleCache.deleteResolvedPath(key);
+  }
+  const filename = resolveFilename.apply(this, arguments);
+  if (path.isAbsolute(filename)) {
+    moduleCache.setResolvedPath(key, filename);
+    checkedPaths.add(filename);
+  }
+  return filename;
+};
+
+const compile = Module.prototype._compile;
+Module.prototype._compile = function (content, filename) {
+  // The modules using import() need the ESM loader as the dynamic import
+  // callback of their script, which only Node's own compile can give them.
+  if (content.includes('import(')) {
+    return compile.call(this, content, filename);
+  }
+  const cachedData = moduleCache.getCodeCache(filename, content);
+  const script = new vm.Script(Module.wrap(content), { filename, cachedData });
+  const compiledWrapper = script.runInThisContext({ displayErrors: true });
+  const dirname = path.dirname(filename);
+  const result = compiledWrapper.call(this.exports, this.exports, makeRequireFunction(this), this, filename, dirname);
+  // The cache is created once the module has run, so that it includes the
+  // functions compiled while loading it.
+  if (!cachedData || script.cachedDataRejected) {
+    moduleCache.setCodeCache(filename, content, script.createCachedData());
+  }
+  return result;
+};
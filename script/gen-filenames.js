@@ -38,6 +38,10 @@ const main = async () => {
     {
       name: 'worker_bundle_deps',
       config: 'webpack.config.worker.js'
+    },
+    {
+      name: 'utility_bundle_deps',
+      config: 'webpack.config.utility.js'
     }
   ];
 
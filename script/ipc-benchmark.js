@@ -0,0 +1,25 @@
+#!/usr/bin/env node
+
+const childProcess = require('child_process');
+const path = require('path');
+
+const utils = require('./lib/utils');
+
+const args = require('minimist')(process.argv.slice(2), {
+  string: ['transports', 'types', 'sizes', 'json']
+});
+
+const options = {};
+for (const key of ['transports', 'types']) {
+  if (args[key]) options[key] = args[key].split(',');
+}
+if (args.sizes) options.sizes = args.sizes.split(',').map(Number);
+for (const key of ['iterations', 'batch']) {
+  if (args[key]) options[key] = Number(args[key]);
+}
+if (args.json) options.json = path.resolve(args.json);
+
+const appPath = path.resolve(__dirname, '..', 'spec-main', 'benchmarks', 'ipc');
+const child = childProcess.spawn(utils.getAbsoluteElectronExec(),
+  [appPath, JSON.stringify(options)], { stdio: 'inherit' });
+child.on('close', (code) => process.exit(code));
@@ -0,0 +1,51 @@
+#!/usr/bin/env node
+
+// Runs the electron_perftests target and prints the runs per second of each
+// native hot path, optionally writing them as JSON with --json=PATH.
+
+const childProcess = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+const utils = require('./lib/utils');
+
+const args = require('minimist')(process.argv.slice(2), {
+  string: ['json', 'filter']
+});
+
+const SRC_DIR = path.resolve(__dirname, '..', '..');
+const exe = path.resolve(SRC_DIR, 'out', utils.getOutDir(),
+  process.platform === 'win32' ? 'electron_perftests.exe' : 'electron_perftests');
+
+const testArgs = [];
+if (args.filter) testArgs.push(`--gtest_filter=${args.filter}`);
+
+const { status, stdout } = childProcess.spawnSync(exe, testArgs, {
+  cwd: SRC_DIR,
+  stdio: ['inherit', 'pipe', 'inherit'],
+  encoding: 'utf8',
+  maxBuffer: 64 * 1024 * 1024
+});
+if (stdout) process.stdout.write(stdout);
+if (status !== 0) {
+  console.error(`electron_perftests exited with code ${status}`);
+  process.exit(1);
+}
+
+// The lines printed by perf_test::PerfResultReporter look like
+// "*RESULT asar.runs_per_second: lookup= 123456.7 runs/s".
+const results = [];
+const resultPattern = /^\*?RESULT ([^:]+): (.*)= (\S+) (.*)$/;
+for (const line of (stdout || '').split('\n')) {
+  const match = resultPattern.exec(line.trim());
+  if (!match) continue;
+  const [, metric, story, value, units] = match;
+  results.push({ metric, story, value: Number(value), units });
+}
+
+if (args.json) {
+  fs.writeFileSync(path.resolve(args.json), JSON.stringify({
+    options: { filter: args.filter || null },
+    results
+  }, null, 2));
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env node
+
+// Renders the animated pages of spec-main/benchmarks/osr offscreen, with
+// software and GPU compositing, and prints the frame rate, latency, CPU time
+// and bytes of each page, size and frame rate.
+
+const childProcess = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const utils = require('./lib/utils');
+
+const args = require('minimist')(process.argv.slice(2), {
+  string: ['modes', 'pages', 'sizes', 'frameRates', 'json']
+});
+
+const options = {
+  modes: args.modes ? args.modes.split(',') : ['software', 'gpu'],
+  pages: args.pages ? args.pages.split(',') : ['css', 'canvas'],
+  sizes: (args.sizes || '800x600,1920x1080,3840x2160').split(',')
+    .map(size => size.split('x').map(Number)),
+  frameRates: (args.frameRates || '30,60,120').split(',').map(Number),
+  warmup: Number(args.warmup) || 1000,
+  duration: Number(args.duration) || 3000,
+  json: args.json ? path.resolve(args.json) : null
+};
+
+const appPath = path.resolve(__dirname, '..', 'spec-main', 'benchmarks', 'osr');
+
+function runMode (mode, output) {
+  const appOptions = { ...options, mode, output };
+  delete appOptions.modes;
+  delete appOptions.json;
+  const { status } = childProcess.spawnSync(utils.getAbsoluteElectronExec(),
+    [appPath, JSON.stringify(appOptions)], { stdio: 'inherit' });
+  if (status !== 0) throw new Error(`The ${mode} run exited with code ${status}`);
+  return JSON.parse(fs.readFileSync(output, 'utf8'));
+}
+
+function formatMs (summary) {
+  return summary ? `${summary.p50.toFixed(2)}ms` : '-';
+}
+
+function printResults (results) {
+  const header = ['mode', 'page', 'size', 'target', 'fps', 'latency p50',
+    'capture p50', 'cpu/frame', 'MB/s'];
+  const rows = results.map(r => [
+    r.mode, r.page, `${r.width}x${r.height}`, r.frameRate.toString(),
+    r.fps.toFixed(1), formatMs(r.latency), formatMs(r.captureTime),
+    r.cpuTimePerFrame === null ? '-' : `${r.cpuTimePerFrame.toFixed(2)}ms`,
+    r.megabytesPerSecond.toFixed(1)
+  ]);
+  const widths = header.map((h, i) =>
+    Math.max(h.length, ...rows.map(row => row[i].length)));
+  for (const row of [header, ...rows]) {
+    console.log(row.map((cell, i) => cell.padStart(widths[i])).join('  '));
+  }
+}
+
+function main () {
+  const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-osr-benchmark-'));
+  try {
+    const results = [];
+    for (const mode of options.modes) {
+      results.push(...runMode(mode, path.join(tmpDir, `${mode}.json`)));
+    }
+    printResults(results);
+    if (options.json) {
+      fs.writeFileSync(options.json, JSON.stringify({
+        date: new Date().toISOString(),
+        options,
+        results
+      }, null, 2));
+    }
+  } finally {
+    fs.rmdirSync(tmpDir, { recursive: true });
+  }
+}
+
+try {
+  main();
+} catch (error) {
+  console.error(error);
+  process.exit(1);
+}
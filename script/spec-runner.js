@@ -13,7 +13,7 @@ const fail = '✗'.red;
 
 const args = require('minimist')(process.argv, {
   string: ['runners', 'target'],
-  boolean: ['buildNativeTests'],
+  boolean: ['buildNativeTests', 'benchmark'],
   unknown: arg => unknownFlags.push(arg)
 });
 
@@ -39,6 +39,14 @@ const runners = new Map([
   ['native', { description: 'Native specs', run: runNativeElectronTests }]
 ]);
 
+// Run instead of the specs with --benchmark.
+const benchmarks = new Map([
+  ['ipc', path.resolve(__dirname, 'ipc-benchmark.js')],
+  ['startup', path.resolve(__dirname, 'startup-benchmark.js')],
+  ['osr', path.resolve(__dirname, 'osr-benchmark.js')],
+  ['native', path.resolve(__dirname, 'native-benchmark.js')]
+]);
+
 const specHashPath = path.resolve(__dirname, '../spec/.hash');
 
 let runnersToRun = null;
@@ -54,6 +62,11 @@ if (args.runners) {
 }
 
 async function main () {
+  if (args.benchmark) {
+    runBenchmarks();
+    return;
+  }
+
   const [lastSpecHash, lastSpecInstallHash] = loadLastSpecHash();
   const [currentSpecHash, currentSpecInstallHash] = await getSpecHash();
   const somethingChanged = (currentSpecHash !== lastSpecHash) ||
@@ -124,6 +137,29 @@ async function runElectronTests () {
   }
 }
 
+// Writes the results of each benchmark as JSON to ELECTRON_TEST_RESULTS_DIR,
+// or to the benchmark-results directory of the build.
+function runBenchmarks () {
+  const resultsDir = process.env.ELECTRON_TEST_RESULTS_DIR ||
+    path.resolve(BASE, `out/${utils.getOutDir()}`, 'benchmark-results');
+  fs.mkdirSync(resultsDir, { recursive: true });
+
+  const failures = [];
+  for (const [name, script] of benchmarks) {
+    console.info('\nRunning benchmark:', name);
+    const json = path.join(resultsDir, `benchmark-results-${name}.json`);
+    const { status } = childProcess.spawnSync(process.execPath,
+      [script, '--json', json, ...unknownArgs.slice(2)], { stdio: 'inherit' });
+    if (status !== 0) failures.push(name);
+  }
+
+  if (failures.length > 0) {
+    console.log(`${fail} Electron benchmarks failed: ${failures.join(', ')}`);
+    process.exit(1);
+  }
+  console.log(`${pass} Electron benchmark results written to ${resultsDir}`);
+}
+
 async function runRemoteBasedElectronTests () {
   let exe = path.resolve(BASE, utils.getElectronExec());
   const runnerArgs = ['electron/spec', ...unknownArgs.slice(2)];
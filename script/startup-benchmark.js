@@ -0,0 +1,160 @@
+#!/usr/bin/env node
+
+// Times the startup of Electron: launches of the app until it is ready, with
+// a new and with a reused user data directory, then runs the window, preload,
+// asar and protocol cases of spec-main/benchmarks/startup in one launch.
+
+const asar = require('asar');
+const childProcess = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const { summarize } = require('../spec-main/benchmarks/stats');
+const utils = require('./lib/utils');
+
+const args = require('minimist')(process.argv.slice(2), {
+  string: ['json']
+});
+
+const options = {
+  launches: Number(args.launches) || 10,
+  iterations: Number(args.iterations) || 20,
+  archives: Number(args.archives) || 20,
+  requests: Number(args.requests) || 2000,
+  concurrency: Number(args.concurrency) || 16,
+  json: args.json ? path.resolve(args.json) : null
+};
+
+const appPath = path.resolve(__dirname, '..', 'spec-main', 'benchmarks', 'startup');
+const electron = utils.getAbsoluteElectronExec();
+
+function now () {
+  return Number(process.hrtime.bigint()) / 1e6;
+}
+
+function run (appOptions, onStdout) {
+  return new Promise((resolve, reject) => {
+    const child = childProcess.spawn(electron, [appPath, JSON.stringify(appOptions)], {
+      stdio: ['ignore', 'pipe', 'inherit']
+    });
+    child.stdout.on('data', data => onStdout && onStdout(data.toString()));
+    child.on('error', reject);
+    child.on('close', (code) => {
+      if (code === 0) {
+        resolve();
+      } else {
+        reject(new Error(`Electron exited with code ${code}`));
+      }
+    });
+  });
+}
+
+// Time from the launch of the process to the "ready" event of the app.
+async function measureLaunch (userData) {
+  let elapsed = null;
+  const start = now();
+  await run({ mode: 'ready', userData }, (output) => {
+    if (elapsed === null && output.includes('ready')) elapsed = now() - start;
+  });
+  if (elapsed === null) throw new Error('The app did not get ready');
+  return elapsed;
+}
+
+async function measureLaunches (tmpDir) {
+  // Every cold launch gets a user data directory of its own, as on the first
+  // launch of an app.
+  const cold = [];
+  for (let i = 0; i < options.launches; i++) {
+    cold.push(await measureLaunch(path.join(tmpDir, `cold-${i}`)));
+  }
+
+  const warmUserData = path.join(tmpDir, 'warm');
+  await measureLaunch(warmUserData);
+  const warm = [];
+  for (let i = 0; i < options.launches; i++) {
+    warm.push(await measureLaunch(warmUserData));
+  }
+
+  return { cold: summarize(cold), warm: summarize(warm) };
+}
+
+// An archive of 100 files of 64KB and one of 8MB, copied once per archive
+// opened by the suite.
+async function createArchives (tmpDir) {
+  const source = path.join(tmpDir, 'archive');
+  fs.mkdirSync(source);
+  for (let i = 0; i < 100; i++) {
+    fs.writeFileSync(path.join(source, `file-${i}.txt`), Buffer.alloc(64 * 1024, 'a'));
+  }
+  fs.writeFileSync(path.join(source, 'large.bin'), Buffer.alloc(8 * 1024 * 1024, 'b'));
+
+  const archive = path.join(tmpDir, 'archive.asar');
+  await asar.createPackage(source, archive);
+  const archives = [];
+  for (let i = 0; i < options.archives; i++) {
+    const copy = path.join(tmpDir, `archive-${i}.asar`);
+    fs.copyFileSync(archive, copy);
+    archives.push(copy);
+  }
+  return archives;
+}
+
+async function runSuite (tmpDir) {
+  const output = path.join(tmpDir, 'suite.json');
+  await run({
+    mode: 'suite',
+    userData: path.join(tmpDir, 'suite'),
+    output,
+    iterations: options.iterations,
+    archives: await createArchives(tmpDir),
+    requests: options.requests,
+    concurrency: options.concurrency
+  });
+  return JSON.parse(fs.readFileSync(output, 'utf8'));
+}
+
+function printResults (results) {
+  const rows = [
+    ['cold start to ready', results.launch.cold],
+    ['warm start to ready', results.launch.warm],
+    ['new BrowserWindow to ready-to-show', results.window.readyToShow],
+    ['preload start', results.window.preloadStart],
+    ['preload duration', results.window.preloadDuration],
+    ['asar open', results.asar.open],
+    ['asar read', results.asar.read]
+  ].map(([name, s]) => [name, ...[s.p50, s.p90, s.max].map(ms => `${ms.toFixed(2)}ms`)]);
+  const header = ['case', 'p50', 'p90', 'max'];
+  const widths = header.map((h, i) =>
+    Math.max(h.length, ...rows.map(row => row[i].length)));
+  for (const row of [header, ...rows]) {
+    console.log(row.map((cell, i) => i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i])).join('  '));
+  }
+  console.log(`asar read throughput: ${results.asar.megabytesPerSecond.toFixed(1)} MB/s`);
+  console.log(`protocol handler: ${Math.round(results.protocol.requestsPerSecond)} req/s`);
+}
+
+async function main () {
+  const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-benchmark-'));
+  try {
+    const results = {
+      launch: await measureLaunches(tmpDir),
+      ...await runSuite(tmpDir)
+    };
+    printResults(results);
+    if (options.json) {
+      fs.writeFileSync(options.json, JSON.stringify({
+        date: new Date().toISOString(),
+        options,
+        results
+      }, null, 2));
+    }
+  } finally {
+    fs.rmdirSync(tmpDir, { recursive: true });
+  }
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
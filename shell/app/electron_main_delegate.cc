@@ -32,7 +32,9 @@
 #include "shell/browser/electron_gpu_client.h"
 #include "shell/browser/feature_list.h"
 #include "shell/browser/relauncher.h"
+#include "shell/common/async_log_sink.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 #include "shell/utility/electron_content_utility_client.h"
@@ -86,6 +88,22 @@ bool SubprocessNeedsResourceBundle(const std::string& process_type) {
       process_type == ::switches::kUtilityProcess;
 }
 
+// Routes the logs of this process through the AsyncLogSink when logging is
+// enabled and --log-format is given.
+void InstallAsyncLogSinkIfRequested() {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (!command_line->HasSwitch(switches::kLogFormat))
+    return;
+  auto env = base::Environment::Create();
+  if (!command_line->HasSwitch(::switches::kEnableLogging) &&
+      !env->HasVar("ELECTRON_ENABLE_LOGGING"))
+    return;
+
+  std::string format = command_line->GetSwitchValueASCII(switches::kLogFormat);
+  if (!AsyncLogSink::Install(format))
+    LOG(ERROR) << "Unknown log format: " << format;
+}
+
 #if defined(OS_WIN)
 void InvalidParameterHandler(const wchar_t*,
                              const wchar_t*,
@@ -98,12 +116,15 @@ void InvalidParameterHandler(const wchar_t*,
 
 }  // namespace
 
+// Loads the paks of |locale| and the common ones. The paks are memory-mapped,
+// so only the resources that are used are read from disk.
 void LoadResourceBundle(const std::string& locale) {
-  const bool initialized = ui::ResourceBundle::HasSharedInstance();
-  if (initialized)
-    ui::ResourceBundle::CleanupSharedInstance();
+  if (ui::ResourceBundle::HasSharedInstance()) {
+    // Only the locale can change once the common paks are loaded.
+    ui::ResourceBundle::GetSharedInstance().ReloadLocaleResources(locale);
+    return;
+  }
 
-  // Load other resource files.
   base::FilePath pak_dir;
 #if defined(OS_MACOSX)
   pak_dir =
@@ -115,7 +136,6 @@ void LoadResourceBundle(const std::string& locale) {
   ui::ResourceBundle::InitSharedInstanceWithLocale(
       locale, nullptr, ui::ResourceBundle::LOAD_COMMON_RESOURCES);
   ui::ResourceBundle& bundle = ui::ResourceBundle::GetSharedInstance();
-  bundle.ReloadLocaleResources(locale);
   bundle.AddDataPackFromPath(pak_dir.Append(FILE_PATH_LITERAL("resources.pak")),
                              ui::SCALE_FACTOR_NONE);
 }
@@ -173,6 +193,16 @@ bool ElectronMainDelegate::BasicStartupComplete(int* exit_code) {
   // Logging with pid and timestamp.
   logging::SetLogItems(true, false, true, false);
 
+#if defined(OS_LINUX)
+  // The zygote forks the renderers, which would not get the thread of the
+  // sink, they install it once forked instead.
+  if (command_line->GetSwitchValueASCII(::switches::kProcessType) !=
+      service_manager::switches::kZygoteProcess)
+    InstallAsyncLogSinkIfRequested();
+#else
+  InstallAsyncLogSinkIfRequested();
+#endif
+
   // Enable convient stack printing. This is enabled by default in non-official
   // builds.
   if (env->HasVar("ELECTRON_ENABLE_STACK_DUMPING"))
@@ -233,13 +263,16 @@ bool ElectronMainDelegate::BasicStartupComplete(int* exit_code) {
   content_client_ = std::make_unique<ElectronContentClient>();
   SetContentClient(content_client_.get());
 
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kBasicStartupComplete);
   return false;
 }
 
 void ElectronMainDelegate::PostEarlyInitialization(bool is_running_tests) {
   std::string custom_locale;
-  ui::ResourceBundle::InitSharedInstanceWithLocale(
-      custom_locale, nullptr, ui::ResourceBundle::LOAD_COMMON_RESOURCES);
+  // The bundle is loaded with the default locale first, which is needed to
+  // look up the pak of --lang, and only its locale is reloaded below.
+  LoadResourceBundle(custom_locale);
   auto* cmd_line = base::CommandLine::ForCurrentProcess();
   if (cmd_line->HasSwitch(::switches::kLang)) {
     const std::string locale = cmd_line->GetSwitchValueASCII(::switches::kLang);
@@ -255,12 +288,18 @@ void ElectronMainDelegate::PostEarlyInitialization(bool is_running_tests) {
     }
   }
 
+  bool reload_locale = !custom_locale.empty();
 #if defined(OS_MACOSX)
-  if (custom_locale.empty())
+  if (custom_locale.empty()) {
     l10n_util::OverrideLocaleWithCocoaLocale();
+    reload_locale = true;
+  }
 #endif
 
-  LoadResourceBundle(custom_locale);
+  if (reload_locale)
+    LoadResourceBundle(custom_locale);
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kResourceBundleLoaded);
 
   ElectronBrowserClient::SetApplicationLocale(
       l10n_util::GetApplicationLocale(custom_locale));
@@ -278,6 +317,8 @@ void ElectronMainDelegate::PreSandboxStartup() {
   if (SubprocessNeedsResourceBundle(process_type)) {
     std::string locale = command_line->GetSwitchValueASCII(::switches::kLang);
     LoadResourceBundle(locale);
+    StartupTimings::GetInstance()->Record(
+        StartupTimings::Milestone::kResourceBundleLoaded);
   }
 
   // Only append arguments for browser process.
@@ -342,6 +383,16 @@ int ElectronMainDelegate::RunProcess(
     return -1;
 }
 
+void ElectronMainDelegate::ProcessExiting(const std::string& process_type) {
+  AsyncLogSink::Flush();
+}
+
+#if defined(OS_LINUX)
+void ElectronMainDelegate::ZygoteForked() {
+  InstallAsyncLogSinkIfRequested();
+}
+#endif
+
 bool ElectronMainDelegate::ShouldCreateFeatureList() {
   return false;
 }
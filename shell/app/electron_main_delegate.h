@@ -39,6 +39,10 @@ class ElectronMainDelegate : public content::ContentMainDelegate {
   int RunProcess(
       const std::string& process_type,
       const content::MainFunctionParams& main_function_params) override;
+  void ProcessExiting(const std::string& process_type) override;
+#if defined(OS_LINUX)
+  void ZygoteForked() override;
+#endif
   bool ShouldCreateFeatureList() override;
   bool ShouldLockSchemeRegistry() override;
 
@@ -2,6 +2,8 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "shell/app/uv_task_runner.h"
@@ -10,23 +12,57 @@
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::DelayedTask::DelayedTask(uint64_t run_time,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : run_time(run_time), sequence_num(sequence_num), task(std::move(task)) {}
+
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
+
+bool UvTaskRunner::DelayedTask::operator>(const DelayedTask& other) const {
+  if (run_time != other.run_time)
+    return run_time > other.run_time;
+  return sequence_num > other.sequence_num;
+}
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop)
+    : loop_(loop), idle_(new uv_idle_t), timer_(new uv_timer_t) {
+  idle_->data = this;
+  uv_idle_init(loop_, idle_);
+  timer_->data = this;
+  uv_timer_init(loop_, timer_);
+}
 
 UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+  uv_idle_stop(idle_);
+  uv_close(reinterpret_cast<uv_handle_t*>(idle_), UvTaskRunner::OnClose);
+  uv_timer_stop(timer_);
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_), UvTaskRunner::OnClose);
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  int64_t delay_ms = delay.InMilliseconds();
+  if (delay_ms <= 0) {
+    if (immediate_tasks_.empty())
+      uv_idle_start(idle_, UvTaskRunner::OnIdle);
+    immediate_tasks_.push_back(std::move(task));
+    return true;
+  }
+
+  delayed_tasks_.emplace_back(uv_now(loop_) + delay_ms, next_sequence_num_++,
+                              std::move(task));
+  std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                 std::greater<DelayedTask>());
+  // Only a new earliest task moves the timer.
+  if (delayed_tasks_.front().sequence_num == next_sequence_num_ - 1)
+    ScheduleTimer();
   return true;
 }
 
@@ -40,22 +76,52 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
   return PostDelayedTask(from_here, std::move(task), delay);
 }
 
-// static
-void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
+void UvTaskRunner::ScheduleTimer() {
+  if (delayed_tasks_.empty()) {
+    uv_timer_stop(timer_);
     return;
+  }
+  uint64_t now = uv_now(loop_);
+  uint64_t run_time = delayed_tasks_.front().run_time;
+  uv_timer_start(timer_, UvTaskRunner::OnTimeout,
+                 run_time > now ? run_time - now : 0, 0);
+}
+
+// static
+void UvTaskRunner::OnIdle(uv_idle_t* idle) {
+  auto* self = static_cast<UvTaskRunner*>(idle->data);
+  // The tasks posted by these ones run on the next iteration, after the loop
+  // had a chance to poll for I/O.
+  base::circular_deque<base::OnceClosure> tasks;
+  tasks.swap(self->immediate_tasks_);
+  uv_idle_stop(idle);
+  // Keeps the runner alive if a task drops the last reference to it.
+  scoped_refptr<UvTaskRunner> keep_alive(self);
+  for (auto& task : tasks)
+    std::move(task).Run();
+}
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+// static
+void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
+  auto* self = static_cast<UvTaskRunner*>(timer->data);
+  scoped_refptr<UvTaskRunner> keep_alive(self);
+  auto& tasks = self->delayed_tasks_;
+  uint64_t now = uv_now(self->loop_);
+  while (!tasks.empty() && tasks.front().run_time <= now) {
+    std::pop_heap(tasks.begin(), tasks.end(), std::greater<DelayedTask>());
+    base::OnceClosure task = std::move(tasks.back().task);
+    tasks.pop_back();
+    std::move(task).Run();
+  }
+  self->ScheduleTimer();
 }
 
 // static
 void UvTaskRunner::OnClose(uv_handle_t* handle) {
-  delete reinterpret_cast<uv_timer_t*>(handle);
+  if (handle->type == UV_IDLE)
+    delete reinterpret_cast<uv_idle_t*>(handle);
+  else
+    delete reinterpret_cast<uv_timer_t*>(handle);
 }
 
 }  // namespace electron
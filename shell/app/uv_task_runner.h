@@ -5,9 +5,10 @@
 #ifndef SHELL_APP_UV_TASK_RUNNER_H_
 #define SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "uv.h"  // NOLINT(build/include)
@@ -15,6 +16,10 @@
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// Tasks without a delay are queued and run from an idle handle on the next
+// iteration of the loop, delayed ones are kept in a min-heap served by a single
+// timer, so posting a task allocates no handle.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
@@ -29,13 +34,44 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(uint64_t run_time,
+                uint64_t sequence_num,
+                base::OnceClosure task);
+    DelayedTask(DelayedTask&&);
+    DelayedTask& operator=(DelayedTask&&);
+    ~DelayedTask();
+
+    // Whether |this| runs after |other|, the order of the heap.
+    bool operator>(const DelayedTask& other) const;
+
+    // In the time of the loop, in milliseconds.
+    uint64_t run_time;
+    // Orders the tasks that run at the same time.
+    uint64_t sequence_num;
+    base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+
+  // Starts the timer for the earliest delayed task, stops it when there is
+  // none.
+  void ScheduleTimer();
+
+  static void OnIdle(uv_idle_t* idle);
   static void OnTimeout(uv_timer_t* timer);
   static void OnClose(uv_handle_t* handle);
 
   uv_loop_t* loop_;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  // Only active while there are tasks, so that they keep the loop alive.
+  uv_idle_t* idle_;
+  uv_timer_t* timer_;
+
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  // A min-heap of the run times.
+  std::vector<DelayedTask> delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(UvTaskRunner);
 };
@@ -4,9 +4,11 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <map>
 #include <memory>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/callback_helpers.h"
@@ -16,7 +18,9 @@
 #include "base/files/file_util.h"
 #include "base/optional.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/system/sys_info.h"
+#include "base/task/post_task.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_paths.h"
@@ -24,6 +28,7 @@
 #include "content/browser/gpu/gpu_data_manager_impl.h"  // nogncheck
 #include "content/public/browser/browser_accessibility_state.h"
 #include "content/public/browser/browser_child_process_host.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/child_process_data.h"
 #include "content/public/browser/client_certificate_delegate.h"
 #include "content/public/browser/gpu_data_manager.h"
@@ -32,6 +37,8 @@
 #include "media/audio/audio_manager.h"
 #include "net/ssl/client_cert_identity.h"
 #include "net/ssl/ssl_cert_request_info.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "services/service_manager/sandbox/switches.h"
 #include "shell/browser/api/electron_api_menu.h"
 #include "shell/browser/api/electron_api_session.h"
@@ -43,6 +50,7 @@
 #include "shell/browser/login_handler.h"
 #include "shell/browser/relauncher.h"
 #include "shell/common/application_info.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/electron_command_line.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -52,8 +60,11 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/ipc_metrics.h"
+#include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "ui/gfx/image/image.h"
 
 #if defined(OS_WIN)
@@ -533,6 +544,57 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+// The allocators whose size is reported by getAppMemoryDetails(), by key.
+const char* const kMemoryDetailsAllocators[][2] = {
+    {"v8", "v8"},
+    {"blinkGC", "blink_gc"},
+    {"partitionAlloc", "partition_alloc"},
+    {"gpu", "gpu/gl"},
+};
+
+void OnAppMemoryDump(
+    gin_helper::Promise<base::Value> promise,
+    std::map<base::ProcessId, int> process_types,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> global_dump) {
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to create memory dump");
+    return;
+  }
+
+  base::Value result(base::Value::Type::LIST);
+  for (const auto& dump : global_dump->process_dumps()) {
+    auto iter = process_types.find(dump.pid());
+    if (iter == process_types.end())
+      continue;
+
+    base::Value details(base::Value::Type::DICTIONARY);
+    details.SetIntKey("pid", dump.pid());
+    details.SetStringKey("type",
+                         content::GetProcessTypeNameInEnglish(iter->second));
+    const auto& os_dump = dump.os_dump();
+    details.SetDoubleKey("private", os_dump.private_footprint_kb);
+    details.SetDoubleKey("shared", os_dump.shared_footprint_kb);
+#if defined(OS_LINUX)
+    details.SetDoubleKey("swap", os_dump.private_footprint_swap_kb);
+#endif
+    for (const auto& allocator : kMemoryDetailsAllocators) {
+      auto size = dump.GetMetric(allocator[1], "effective_size");
+      if (size)
+        details.SetDoubleKey(allocator[0], static_cast<double>(*size >> 10));
+    }
+    result.Append(std::move(details));
+  }
+  promise.Resolve(std::move(result));
+}
+
+EventLoopLagMonitor* GetEventLoopLagMonitor() {
+  auto* main_parts = ElectronBrowserMainParts::Get();
+  if (!main_parts || !main_parts->node_bindings())
+    return nullptr;
+  return main_parts->node_bindings()->lag_monitor();
+}
+
 }  // namespace
 
 App::App(v8::Isolate* isolate) {
@@ -546,10 +608,15 @@ App::App(v8::Isolate* isolate) {
       content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
       base::ProcessMetrics::CreateCurrentProcessMetrics());
   app_metrics_[pid] = std::move(process_metric);
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE,
+      base::BindRepeating(&App::OnMemoryPressure, base::Unretained(this)));
   Init(isolate);
 }
 
 App::~App() {
+  if (auto* monitor = GetEventLoopLagMonitor())
+    monitor->Stop();
   static_cast<ElectronBrowserClient*>(ElectronBrowserClient::Get())
       ->set_delegate(nullptr);
   Browser::Get()->RemoveObserver(this);
@@ -990,17 +1057,23 @@ bool App::Relaunch(gin_helper::Arguments* js_args) {
   bool override_argv = false;
   base::FilePath exec_path;
   relauncher::StringVector args;
+  bool prefetch_archives = false;
 
   gin_helper::Dictionary options;
   if (js_args->GetNext(&options)) {
     if (options.Get("execPath", &exec_path) | options.Get("args", &args))
       override_argv = true;
+    options.Get("prefetchArchives", &prefetch_archives);
   }
 
+  std::vector<base::FilePath> prefetch_paths;
+  if (prefetch_archives)
+    prefetch_paths = asar::GetOpenArchivePaths();
+
   if (!override_argv) {
     const relauncher::StringVector& argv =
         electron::ElectronCommandLine::argv();
-    return relauncher::RelaunchApp(argv);
+    return relauncher::RelaunchApp(argv, prefetch_paths);
   }
 
   relauncher::StringVector argv;
@@ -1016,7 +1089,7 @@ bool App::Relaunch(gin_helper::Arguments* js_args) {
 
   argv.insert(argv.end(), args.begin(), args.end());
 
-  return relauncher::RelaunchApp(argv);
+  return relauncher::RelaunchApp(argv, prefetch_paths);
 }
 
 void App::DisableHardwareAcceleration(gin_helper::ErrorThrower thrower) {
@@ -1259,6 +1332,137 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+
+  bool critical =
+      level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  v8::Locker locker(isolate());
+  isolate()->MemoryPressureNotification(
+      critical ? v8::MemoryPressureLevel::kCritical
+               : v8::MemoryPressureLevel::kModerate);
+  // Archives that nothing reads from are opened again when they are needed.
+  if (critical)
+    asar::ClearArchives();
+
+  Emit("memory-pressure", critical ? "critical" : "moderate");
+}
+
+v8::Local<v8::Promise> App::GetAppMemoryDetails(v8::Isolate* isolate) {
+  gin_helper::Promise<base::Value> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!Browser::Get()->is_ready()) {
+    promise.RejectWithErrorMessage(
+        "Memory details are available only after app ready");
+    return handle;
+  }
+
+  // Only the processes of |app_metrics_| are reported, the dump can include
+  // others, like the ones that are still starting.
+  std::map<base::ProcessId, int> process_types;
+  for (const auto& process_metric : app_metrics_)
+    process_types[process_metric.second->process.Pid()] =
+        process_metric.second->type;
+
+  std::vector<std::string> allocator_dump_names;
+  for (const auto& allocator : kMemoryDetailsAllocators)
+    allocator_dump_names.push_back(allocator[1]);
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump(allocator_dump_names,
+                          base::BindOnce(&OnAppMemoryDump, std::move(promise),
+                                         std::move(process_types)));
+  return handle;
+}
+
+base::Value App::GetStartupTimings() {
+  return StartupTimings::GetInstance()->GetTimings();
+}
+
+void App::StartEventLoopMonitor(gin_helper::Arguments* args) {
+  auto* monitor = GetEventLoopLagMonitor();
+  if (!monitor) {
+    args->ThrowError("The event loop monitor is not available");
+    return;
+  }
+
+  EventLoopLagMonitor::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double threshold = options.threshold.InMillisecondsF();
+    double sample_interval = options.sample_interval.InMillisecondsF();
+    dict.Get("threshold", &threshold);
+    dict.Get("sampleInterval", &sample_interval);
+    dict.Get("captureStack", &options.capture_stack);
+    if (threshold <= 0 || sample_interval <= 0) {
+      args->ThrowError("threshold and sampleInterval must be positive");
+      return;
+    }
+    options.threshold = base::TimeDelta::FromMillisecondsD(threshold);
+    options.sample_interval =
+        base::TimeDelta::FromMillisecondsD(sample_interval);
+  }
+  monitor->Start(options, base::BindRepeating(&App::OnMainThreadBlocked,
+                                              base::Unretained(this)));
+}
+
+void App::StopEventLoopMonitor() {
+  if (auto* monitor = GetEventLoopLagMonitor())
+    monitor->Stop();
+}
+
+v8::Local<v8::Value> App::GetEventLoopLag(v8::Isolate* isolate) {
+  auto* monitor = GetEventLoopLagMonitor();
+  if (!monitor)
+    return v8::Null(isolate);
+  return gin::ConvertToV8(isolate, monitor->GetHistograms());
+}
+
+void App::PostIdleTask(base::OnceClosure callback) {
+  // Best effort tasks of the UI thread only run when it has no task of a
+  // higher priority to run, like the ones handling input.
+  base::PostTask(
+      FROM_HERE,
+      {content::BrowserThread::UI, base::TaskPriority::BEST_EFFORT},
+      std::move(callback));
+}
+
+void App::OnMainThreadBlocked(EventLoopLagMonitor::Source source,
+                              base::TimeDelta duration,
+                              const std::string& stack) {
+  base::Value details(base::Value::Type::DICTIONARY);
+  details.SetDoubleKey("duration", duration.InMillisecondsF());
+  details.SetStringKey("source",
+                       source == EventLoopLagMonitor::Source::kUvLoop
+                           ? "uv-loop"
+                           : "task-queue");
+  if (!stack.empty())
+    details.SetStringKey("stack", stack);
+  Emit("main-thread-blocked", details);
+}
+
+std::vector<gin_helper::Dictionary> App::GetIPCMetrics(v8::Isolate* isolate) {
+  std::vector<gin_helper::Dictionary> result;
+  for (const auto& it : IPCMetrics::GetInstance()->GetMetrics()) {
+    const IPCMetrics::ChannelMetrics& metrics = it.second;
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
+    gin_helper::Dictionary(isolate, dict.GetHandle()).SetHidden("simple", true);
+    dict.Set("channel", it.first);
+    dict.Set("messagesReceived",
+             static_cast<double>(metrics.messages_received));
+    dict.Set("bytesReceived", static_cast<double>(metrics.bytes_received));
+    dict.Set("handlerTime", metrics.handler_time.InMillisecondsF());
+    dict.Set("maxHandlerTime", metrics.max_handler_time.InMillisecondsF());
+    dict.Set("messagesSent", static_cast<double>(metrics.messages_sent));
+    dict.Set("bytesSent", static_cast<double>(metrics.bytes_sent));
+    result.push_back(dict);
+  }
+  return result;
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1321,6 +1525,41 @@ void App::EnableSandbox(gin_helper::ErrorThrower thrower) {
   command_line->AppendSwitch(switches::kEnableSandbox);
 }
 
+void App::EnableParallelDownloads(gin_helper::Arguments* args) {
+  if (Browser::Get()->is_ready()) {
+    args->ThrowError(
+        "app.enableParallelDownloads() can only be called "
+        "before app is ready");
+    return;
+  }
+
+  int request_count = 0;
+  double min_slice_size = 0;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    if (options.Get("requestCount", &request_count) && request_count < 2) {
+      args->ThrowError("requestCount must be at least 2");
+      return;
+    }
+    if (options.Get("minSliceSize", &min_slice_size) && min_slice_size < 1) {
+      args->ThrowError("minSliceSize must be positive");
+      return;
+    }
+  }
+
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  command_line->AppendSwitch(switches::kEnableParallelDownloads);
+  if (request_count) {
+    command_line->AppendSwitchASCII(switches::kParallelDownloadRequestCount,
+                                    base::NumberToString(request_count));
+  }
+  if (min_slice_size) {
+    command_line->AppendSwitchASCII(
+        switches::kParallelDownloadMinSliceSize,
+        base::NumberToString(static_cast<int64_t>(min_slice_size)));
+  }
+}
+
 void App::SetUserAgentFallback(const std::string& user_agent) {
   ElectronBrowserClient::Get()->SetUserAgent(user_agent);
 }
@@ -1505,6 +1744,13 @@ void App::BuildPrototype(v8::Isolate* isolate,
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("getAppMemoryDetails", &App::GetAppMemoryDetails)
+      .SetMethod("getStartupTimings", &App::GetStartupTimings)
+      .SetMethod("startEventLoopMonitor", &App::StartEventLoopMonitor)
+      .SetMethod("stopEventLoopMonitor", &App::StopEventLoopMonitor)
+      .SetMethod("getEventLoopLag", &App::GetEventLoopLag)
+      .SetMethod("_postIdleTask", &App::PostIdleTask)
+      .SetMethod("getIPCMetrics", &App::GetIPCMetrics)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
@@ -1517,6 +1763,7 @@ void App::BuildPrototype(v8::Isolate* isolate,
       .SetProperty("userAgentFallback", &App::GetUserAgentFallback,
                    &App::SetUserAgentFallback)
       .SetMethod("enableSandbox", &App::EnableSandbox)
+      .SetMethod("enableParallelDownloads", &App::EnableParallelDownloads)
       .SetProperty("allowRendererProcessReuse",
                    &App::CanBrowserClientUseCustomSiteInstance,
                    &App::SetBrowserClientCanUseCustomSiteInstance);
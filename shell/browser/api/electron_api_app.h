@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/process_singleton.h"
@@ -25,6 +26,7 @@
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
+#include "shell/common/event_loop_lag_monitor.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
@@ -157,6 +159,11 @@ class App : public ElectronBrowserClient::Delegate,
   void SetAppPath(const base::FilePath& app_path);
   void ChildProcessLaunched(int process_type, base::ProcessHandle handle);
   void ChildProcessDisconnected(base::ProcessId pid);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void OnMainThreadBlocked(EventLoopLagMonitor::Source source,
+                           base::TimeDelta duration,
+                           const std::string& stack);
 
   void SetAppLogsPath(gin_helper::ErrorThrower thrower,
                       base::Optional<base::FilePath> custom_path);
@@ -191,10 +198,18 @@ class App : public ElectronBrowserClient::Delegate,
                                      gin_helper::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  v8::Local<v8::Promise> GetAppMemoryDetails(v8::Isolate* isolate);
+  base::Value GetStartupTimings();
+  void StartEventLoopMonitor(gin_helper::Arguments* args);
+  void StopEventLoopMonitor();
+  v8::Local<v8::Value> GetEventLoopLag(v8::Isolate* isolate);
+  void PostIdleTask(base::OnceClosure callback);
+  std::vector<gin_helper::Dictionary> GetIPCMetrics(v8::Isolate* isolate);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
   void EnableSandbox(gin_helper::ErrorThrower thrower);
+  void EnableParallelDownloads(gin_helper::Arguments* args);
   void SetUserAgentFallback(const std::string& user_agent);
   std::string GetUserAgentFallback();
   void SetBrowserClientCanUseCustomSiteInstance(bool should_disable);
@@ -239,6 +254,8 @@ class App : public ElectronBrowserClient::Delegate,
                          std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -23,6 +23,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "ui/gl/gpu_switching_manager.h"
 
 namespace electron {
@@ -146,6 +147,9 @@ void BrowserWindow::RenderViewCreated(
 }
 
 void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kFirstPaint);
+
   if (window()->IsVisible())
     return;
 
@@ -347,8 +351,8 @@ void BrowserWindow::SetBackgroundColor(const std::string& color_name) {
     auto* web_preferences =
         WebContentsPreferences::From(api_web_contents_->web_contents());
     if (web_preferences) {
-      web_preferences->preference()->SetStringKey(options::kBackgroundColor,
-                                                  color_name);
+      web_preferences->SetPreference(options::kBackgroundColor,
+                                     base::Value(color_name));
     }
   }
 }
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "base/files/file_util.h"
+#include "base/no_destructor.h"
 #include "base/optional.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
@@ -57,6 +58,13 @@ namespace {
 
 using CompletionCallback = base::OnceCallback<void(const base::FilePath&)>;
 
+// The config of the recording in progress, kept to resume it after a dump.
+base::Optional<base::trace_event::TraceConfig>& GetCurrentTraceConfig() {
+  static base::NoDestructor<base::Optional<base::trace_event::TraceConfig>>
+      trace_config;
+  return *trace_config;
+}
+
 base::Optional<base::FilePath> CreateTemporaryFileOnIO() {
   base::FilePath temp_file_path;
   if (!base::CreateTemporaryFile(&temp_file_path))
@@ -78,21 +86,68 @@ void StopTracing(gin_helper::Promise<base::FilePath> promise,
   }
 }
 
-v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
-  gin_helper::Promise<base::FilePath> promise(args->isolate());
-  v8::Local<v8::Promise> handle = promise.GetHandle();
+void OnTraceDumped(gin_helper::Promise<base::FilePath> promise,
+                   const base::FilePath& file_path) {
+  // Recording resumes with the same config, into an empty buffer.
+  const auto& trace_config = GetCurrentTraceConfig();
+  if (trace_config)
+    TracingController::GetInstance()->StartTracing(*trace_config, {});
+  promise.Resolve(file_path);
+}
+
+void DumpTracing(gin_helper::Promise<base::FilePath> promise,
+                 base::Optional<base::FilePath> file_path) {
+  if (file_path) {
+    auto endpoint = TracingController::CreateFileEndpoint(
+        *file_path, base::AdaptCallbackForRepeating(base::BindOnce(
+                        &OnTraceDumped, std::move(promise), *file_path)));
+    TracingController::GetInstance()->StopTracing(endpoint);
+  } else {
+    promise.RejectWithErrorMessage(
+        "Failed to create temporary file for trace data");
+  }
+}
 
+void WithResultFilePath(
+    gin_helper::Arguments* args,
+    gin_helper::Promise<base::FilePath> promise,
+    base::OnceCallback<void(gin_helper::Promise<base::FilePath>,
+                            base::Optional<base::FilePath>)> callback) {
   base::FilePath path;
   if (args->GetNext(&path) && !path.empty()) {
-    StopTracing(std::move(promise), base::make_optional(path));
+    std::move(callback).Run(std::move(promise), base::make_optional(path));
   } else {
     // use a temporary file.
     base::ThreadPool::PostTaskAndReplyWithResult(
         FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
         base::BindOnce(CreateTemporaryFileOnIO),
-        base::BindOnce(StopTracing, std::move(promise)));
+        base::BindOnce(std::move(callback), std::move(promise)));
+  }
+}
+
+v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
+  gin_helper::Promise<base::FilePath> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  GetCurrentTraceConfig().reset();
+  WithResultFilePath(args, std::move(promise), base::BindOnce(StopTracing));
+  return handle;
+}
+
+// Writes what the recording in progress has collected, and keeps recording.
+// Meant for recordings in the record-continuously mode, whose buffer only
+// holds the latest events.
+v8::Local<v8::Promise> DumpRingBuffer(gin_helper::Arguments* args) {
+  gin_helper::Promise<base::FilePath> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!GetCurrentTraceConfig() ||
+      !TracingController::GetInstance()->IsTracing()) {
+    promise.RejectWithErrorMessage("There is no recording in progress");
+    return handle;
   }
 
+  WithResultFilePath(args, std::move(promise), base::BindOnce(DumpTracing));
   return handle;
 }
 
@@ -114,6 +169,10 @@ v8::Local<v8::Promise> StartTracing(
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  if (TracingController::GetInstance()->IsTracing())
+    return gin_helper::Promise<void>::ResolvedPromise(isolate);
+
+  GetCurrentTraceConfig() = trace_config;
   if (!TracingController::GetInstance()->StartTracing(
           trace_config,
           base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
@@ -156,6 +215,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getCategories", &GetCategories);
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
+  dict.SetMethod("dumpRingBuffer", &DumpRingBuffer);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
 }
 
@@ -4,9 +4,14 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_closure.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -18,11 +23,13 @@
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_store.h"
 #include "net/cookies/cookie_util.h"
+#include "shell/browser/cookie_cache.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 
 using content::BrowserThread;
@@ -119,24 +126,44 @@ bool MatchesCookie(const base::Value& filter,
   return true;
 }
 
-// Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(const base::Value& filter,
-                   gin_helper::Promise<net::CookieList> promise,
-                   const net::CookieList& cookies) {
+struct CookieFilter {
+  base::DictionaryValue dict;
+  // When set, only the cookies that would be sent to it match.
+  std::string url;
+};
+
+CookieFilter ParseCookieFilter(v8::Isolate* isolate,
+                               const gin_helper::Dictionary& filter) {
+  CookieFilter result;
+  gin::ConvertFromV8(isolate, filter.GetHandle(), &result.dict);
+  filter.Get("url", &result.url);
+  return result;
+}
+
+// Returns the cookies of |cookies| matching |filter|.
+net::CookieList FilterCookies(const CookieFilter& filter,
+                              const net::CookieList& cookies) {
+  GURL url(filter.url);
+  if (!filter.url.empty() && !url.is_valid())
+    return net::CookieList();
+
+  net::CookieOptions options;
+  options.set_include_httponly();
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::SAME_SITE_STRICT);
+
+  base::Time now = base::Time::Now();
   net::CookieList result;
   for (const auto& cookie : cookies) {
-    if (MatchesCookie(filter, cookie))
+    if (cookie.IsExpired(now))
+      continue;
+    if (url.is_valid() &&
+        !cookie.IncludeForRequestURL(url, options).IsInclude())
+      continue;
+    if (MatchesCookie(filter.dict, cookie))
       result.push_back(cookie);
   }
-  promise.Resolve(result);
-}
-
-void FilterCookieWithStatuses(const base::Value& filter,
-                              gin_helper::Promise<net::CookieList> promise,
-                              const net::CookieStatusList& list,
-                              const net::CookieStatusList& excluded_list) {
-  FilterCookies(filter, std::move(promise),
-                net::cookie_util::StripStatuses(list));
+  return result;
 }
 
 // Parse dictionary property to CanonicalCookie time correctly.
@@ -171,6 +198,73 @@ std::string InclusionStatusToString(
   return "Setting cookie failed";
 }
 
+// Sets the cookie described by |details| and runs |callback| with an error
+// message, or an empty string when the cookie was set.
+void SetCookie(ElectronBrowserContext* browser_context,
+               const base::Value& details,
+               base::OnceCallback<void(const std::string& error)> callback) {
+  const std::string* url_string = details.FindStringKey("url");
+  const std::string* name = details.FindStringKey("name");
+  const std::string* value = details.FindStringKey("value");
+  const std::string* domain = details.FindStringKey("domain");
+  const std::string* path = details.FindStringKey("path");
+  bool secure = details.FindBoolKey("secure").value_or(false);
+  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
+
+  GURL url(url_string ? *url_string : "");
+  if (!url.is_valid()) {
+    std::move(callback).Run(
+        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
+            net::CanonicalCookie::CookieInclusionStatus::
+                EXCLUDE_INVALID_DOMAIN)));
+    return;
+  }
+
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "",
+      ParseTimeProperty(details.FindDoubleKey("creationDate")),
+      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
+      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
+      http_only, net::CookieSameSite::NO_RESTRICTION,
+      net::COOKIE_PRIORITY_DEFAULT);
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    std::move(callback).Run(
+        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
+            net::CanonicalCookie::CookieInclusionStatus::
+                EXCLUDE_FAILURE_TO_STORE)));
+    return;
+  }
+  net::CookieOptions options;
+  if (http_only) {
+    options.set_include_httponly();
+  }
+
+  auto* storage_partition =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context);
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  // The cookie manager, and the callback with it, goes away with the browser
+  // context, which owns the cache.
+  CookieCache* cookie_cache =
+      browser_context->GetCookieChangeNotifier()->cookie_cache();
+  manager->SetCanonicalCookie(
+      *canonical_cookie, url.scheme(), options,
+      base::BindOnce(
+          [](CookieCache* cookie_cache,
+             base::OnceCallback<void(const std::string&)> callback,
+             net::CanonicalCookie::CookieInclusionStatus status) {
+            if (!status.IsInclude()) {
+              std::move(callback).Run(InclusionStatusToString(status));
+              return;
+            }
+            // The change is notified later, reading the cookie right after
+            // has to load the cookies again to see it.
+            cookie_cache->Invalidate();
+            std::move(callback).Run(std::string());
+          },
+          cookie_cache, std::move(callback)));
+}
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -178,9 +272,9 @@ gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
 Cookies::Cookies(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
     : browser_context_(browser_context) {
   cookie_change_subscription_ =
-      browser_context_->cookie_change_notifier()->RegisterCookieChangeCallback(
-          base::BindRepeating(&Cookies::OnCookieChanged,
-                              base::Unretained(this)));
+      browser_context_->GetCookieChangeNotifier()
+          ->RegisterCookieChangeCallback(base::BindRepeating(
+              &Cookies::OnCookieChanged, base::Unretained(this)));
 }
 
 Cookies::~Cookies() = default;
@@ -190,29 +284,38 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
   gin_helper::Promise<net::CookieList> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  auto* storage_partition =
-      content::BrowserContext::GetDefaultStoragePartition(browser_context_);
-  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  browser_context_->GetCookieChangeNotifier()->cookie_cache()->GetAllCookies(
+      base::BindOnce(
+          [](CookieFilter filter, gin_helper::Promise<net::CookieList> promise,
+             const net::CookieList& cookies) {
+            promise.Resolve(FilterCookies(filter, cookies));
+          },
+          ParseCookieFilter(isolate, filter), std::move(promise)));
 
-  base::DictionaryValue dict;
-  gin::ConvertFromV8(isolate, filter.GetHandle(), &dict);
+  return handle;
+}
 
-  std::string url;
-  filter.Get("url", &url);
-  if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
-  } else {
-    net::CookieOptions options;
-    options.set_include_httponly();
-    options.set_same_site_cookie_context(
-        net::CookieOptions::SameSiteCookieContext::SAME_SITE_STRICT);
-    options.set_do_not_update_access_time();
+v8::Local<v8::Promise> Cookies::GetMany(
+    v8::Isolate* isolate,
+    const std::vector<gin_helper::Dictionary>& filters) {
+  gin_helper::Promise<std::vector<net::CookieList>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
 
-    manager->GetCookieList(GURL(url), options,
-                           base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
-  }
+  std::vector<CookieFilter> parsed_filters;
+  for (const auto& filter : filters)
+    parsed_filters.push_back(ParseCookieFilter(isolate, filter));
+
+  browser_context_->GetCookieChangeNotifier()->cookie_cache()->GetAllCookies(
+      base::BindOnce(
+          [](std::vector<CookieFilter> filters,
+             gin_helper::Promise<std::vector<net::CookieList>> promise,
+             const net::CookieList& cookies) {
+            std::vector<net::CookieList> result;
+            for (const auto& filter : filters)
+              result.push_back(FilterCookies(filter, cookies));
+            promise.Resolve(result);
+          },
+          std::move(parsed_filters), std::move(promise)));
 
   return handle;
 }
@@ -234,9 +337,13 @@ v8::Local<v8::Promise> Cookies::Remove(v8::Isolate* isolate,
   manager->DeleteCookies(
       std::move(cookie_deletion_filter),
       base::BindOnce(
-          [](gin_helper::Promise<void> promise, uint32_t num_deleted) {
+          [](CookieCache* cookie_cache, gin_helper::Promise<void> promise,
+             uint32_t num_deleted) {
+            if (num_deleted)
+              cookie_cache->Invalidate();
             gin_helper::Promise<void>::ResolvePromise(std::move(promise));
           },
+          browser_context_->GetCookieChangeNotifier()->cookie_cache(),
           std::move(promise)));
 
   return handle;
@@ -247,58 +354,57 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindStringKey("url");
-  const std::string* name = details.FindStringKey("name");
-  const std::string* value = details.FindStringKey("value");
-  const std::string* domain = details.FindStringKey("domain");
-  const std::string* path = details.FindStringKey("path");
-  bool secure = details.FindBoolKey("secure").value_or(false);
-  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
+  SetCookie(
+      browser_context_, details,
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, const std::string& error) {
+            if (error.empty())
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage(error);
+          },
+          std::move(promise)));
 
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
-            net::CanonicalCookie::CookieInclusionStatus::
-                EXCLUDE_INVALID_DOMAIN)));
-    return handle;
-  }
+  return handle;
+}
 
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "",
-      ParseTimeProperty(details.FindDoubleKey("creationDate")),
-      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
-      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
-      http_only, net::CookieSameSite::NO_RESTRICTION,
-      net::COOKIE_PRIORITY_DEFAULT);
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
-            net::CanonicalCookie::CookieInclusionStatus::
-                EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
-  }
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
+v8::Local<v8::Promise> Cookies::SetMany(v8::Isolate* isolate,
+                                        const base::ListValue& details) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  for (const auto& cookie : details.GetList()) {
+    if (!cookie.is_dict()) {
+      promise.RejectWithErrorMessage("Cookie details must be objects");
+      return handle;
+    }
   }
 
-  auto* storage_partition =
-      content::BrowserContext::GetDefaultStoragePartition(browser_context_);
-  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
-  manager->SetCanonicalCookie(
-      *canonical_cookie, url.scheme(), options,
+  // The cookies are all sent at once, the promise settles when they are all
+  // set, with the first error if any failed.
+  auto error = std::make_shared<std::string>();
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      details.GetList().size(),
       base::BindOnce(
-          [](gin_helper::Promise<void> promise,
-             net::CanonicalCookie::CookieInclusionStatus status) {
-            if (status.IsInclude()) {
+          [](std::shared_ptr<std::string> error,
+             gin_helper::Promise<void> promise) {
+            if (error->empty())
               promise.Resolve();
-            } else {
-              promise.RejectWithErrorMessage(InclusionStatusToString(status));
-            }
+            else
+              promise.RejectWithErrorMessage(*error);
           },
-          std::move(promise)));
+          error, std::move(promise)));
+  for (const auto& cookie : details.GetList()) {
+    SetCookie(browser_context_, cookie,
+              base::BindOnce(
+                  [](std::shared_ptr<std::string> first_error,
+                     base::RepeatingClosure barrier, const std::string& error) {
+                    if (first_error->empty())
+                      *first_error = error;
+                    barrier.Run();
+                  },
+                  error, barrier));
+  }
 
   return handle;
 }
@@ -318,12 +424,61 @@ v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
 }
 
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope scope(isolate);
+    Emit("changed", gin::ConvertToV8(isolate, change.cookie),
+         gin::ConvertToV8(isolate, change.cause),
+         gin::ConvertToV8(isolate,
+                          change.cause != net::CookieChangeCause::INSERTED));
+  }
+
+  // The batches are emitted once per task, so that a burst of changes runs
+  // the listeners of 'changed-batch' once.
+  if (pending_changes_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&Cookies::EmitPendingChanges,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  pending_changes_.push_back(change);
+}
+
+void Cookies::EmitPendingChanges() {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
   v8::HandleScope scope(isolate);
-  Emit("changed", gin::ConvertToV8(isolate, change.cookie),
-       gin::ConvertToV8(isolate, change.cause),
-       gin::ConvertToV8(isolate,
-                        change.cause != net::CookieChangeCause::INSERTED));
+  std::vector<net::CookieChangeInfo> changes = std::move(pending_changes_);
+  pending_changes_.clear();
+
+  if (!HasListeners(isolate, "changed-batch"))
+    return;
+  // Only the last change of each cookie is kept, in the order they happened.
+  auto key = [](const net::CanonicalCookie& cookie) {
+    return std::make_tuple(cookie.Name(), cookie.Domain(), cookie.Path());
+  };
+  std::map<std::tuple<std::string, std::string, std::string>, size_t> last;
+  for (size_t i = 0; i < changes.size(); ++i)
+    last[key(changes[i].cookie)] = i;
+  std::vector<v8::Local<v8::Value>> batch;
+  for (size_t i = 0; i < changes.size(); ++i) {
+    if (last[key(changes[i].cookie)] != i)
+      continue;
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("cookie", changes[i].cookie);
+    dict.Set("cause", changes[i].cause);
+    dict.Set("removed", changes[i].cause != net::CookieChangeCause::INSERTED);
+    batch.push_back(gin::ConvertToV8(isolate, dict));
+  }
+  Emit("changed-batch", batch);
+}
+
+bool Cookies::HasListeners(v8::Isolate* isolate, const char* name) {
+  v8::Local<v8::Object> wrapper;
+  if (!GetWrapper(isolate).ToLocal(&wrapper))
+    return false;
+  v8::Local<v8::Value> count =
+      gin_helper::CustomEmit(isolate, wrapper, "listenerCount", name);
+  return count->IsNumber() && count.As<v8::Number>()->Value() > 0;
 }
 
 // static
@@ -337,8 +492,10 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<Cookies>::GetObjectTemplateBuilder(
              isolate)
       .SetMethod("get", &Cookies::Get)
+      .SetMethod("getMany", &Cookies::GetMany)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
+      .SetMethod("setMany", &Cookies::SetMany)
       .SetMethod("flushStore", &Cookies::FlushStore);
 }
 
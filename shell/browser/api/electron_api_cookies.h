@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
+#include "base/memory/weak_ptr.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_change_dispatcher.h"
@@ -18,7 +20,8 @@
 
 namespace base {
 class DictionaryValue;
-}
+class ListValue;
+}  // namespace base
 
 namespace gin_helper {
 class Dictionary;
@@ -52,8 +55,12 @@ class Cookies : public gin::Wrappable<Cookies>,
 
   v8::Local<v8::Promise> Get(v8::Isolate*,
                              const gin_helper::Dictionary& filter);
+  v8::Local<v8::Promise> GetMany(
+      v8::Isolate*,
+      const std::vector<gin_helper::Dictionary>& filters);
   v8::Local<v8::Promise> Set(v8::Isolate*,
                              const base::DictionaryValue& details);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*, const base::ListValue& details);
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
@@ -63,6 +70,9 @@ class Cookies : public gin::Wrappable<Cookies>,
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
+  void EmitPendingChanges();
+  bool HasListeners(v8::Isolate* isolate, const char* name);
+
   std::unique_ptr<base::CallbackList<void(
       const net::CookieChangeInfo& change)>::Subscription>
       cookie_change_subscription_;
@@ -70,6 +80,11 @@ class Cookies : public gin::Wrappable<Cookies>,
   // Weak reference; ElectronBrowserContext is guaranteed to outlive us.
   ElectronBrowserContext* browser_context_;
 
+  // The changes to emit at the next task.
+  std::vector<net::CookieChangeInfo> pending_changes_;
+
+  base::WeakPtrFactory<Cookies> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(Cookies);
 };
 
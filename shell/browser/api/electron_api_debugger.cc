@@ -8,13 +8,17 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
 using content::DevToolsAgentHost;
@@ -23,6 +27,35 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// Chromium writes the method of the protocol events before their params, so
+// it can be read without parsing the whole message. Events that are filtered
+// out or passed as JSON are then never parsed.
+bool GetEventMethod(base::StringPiece message, std::string* method) {
+  constexpr base::StringPiece kPrefix = "{\"method\":\"";
+  if (!base::StartsWith(message, kPrefix, base::CompareCase::SENSITIVE))
+    return false;
+  size_t end = message.find('"', kPrefix.size());
+  if (end == base::StringPiece::npos)
+    return false;
+  base::StringPiece name = message.substr(kPrefix.size(), end - kPrefix.size());
+  if (name.find('\\') != base::StringPiece::npos)
+    return false;
+  name.CopyToString(method);
+  return true;
+}
+
+std::unique_ptr<base::Value> ParseMessage(base::StringPiece message) {
+  std::unique_ptr<base::Value> parsed = base::JSONReader::ReadDeprecated(
+      message, base::JSON_REPLACE_INVALID_CHARACTERS);
+  if (!parsed || !parsed->is_dict())
+    return nullptr;
+  return parsed;
+}
+
+}  // namespace
+
 gin::WrapperInfo Debugger::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
@@ -33,6 +66,7 @@ Debugger::~Debugger() = default;
 void Debugger::AgentHostClosed(DevToolsAgentHost* agent_host) {
   DCHECK(agent_host == agent_host_);
   agent_host_ = nullptr;
+  FlushEvents();
   ClearPendingRequests();
   Emit("detach", "target closed");
 }
@@ -48,24 +82,26 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
 
   base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
                                 message.size());
-  std::unique_ptr<base::Value> parsed_message =
-      base::JSONReader::ReadDeprecated(message_str,
-                                       base::JSON_REPLACE_INVALID_CHARACTERS);
-  if (!parsed_message || !parsed_message->is_dict())
+  std::string method;
+  if (GetEventMethod(message_str, &method)) {
+    HandleEvent(method, message_str, nullptr);
+    return;
+  }
+
+  std::unique_ptr<base::Value> parsed_message = ParseMessage(message_str);
+  if (!parsed_message)
     return;
   base::DictionaryValue* dict =
       static_cast<base::DictionaryValue*>(parsed_message.get());
   int id;
   if (!dict->GetInteger("id", &id)) {
-    std::string method;
     if (!dict->GetString("method", &method))
       return;
-    base::DictionaryValue* params_value = nullptr;
-    base::DictionaryValue params;
-    if (dict->GetDictionary("params", &params_value))
-      params.Swap(params_value);
-    Emit("message", method, params);
+    HandleEvent(method, message_str, dict);
   } else {
+    // The events received before the response are emitted before it.
+    FlushEvents();
+
     auto it = pending_requests_.find(id);
     if (it == pending_requests_.end())
       return;
@@ -89,6 +125,83 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
   }
 }
 
+void Debugger::HandleEvent(const std::string& method,
+                           base::StringPiece message,
+                           const base::Value* parsed) {
+  if (!ShouldEmitEvent(method))
+    return;
+
+  if (!batch_interval_.is_zero()) {
+    pending_events_.emplace_back(method, message.as_string());
+    if (!batch_timer_.IsRunning()) {
+      batch_timer_.Start(FROM_HERE, batch_interval_,
+                         base::BindOnce(&Debugger::FlushEvents,
+                                        base::Unretained(this)));
+    }
+    return;
+  }
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  Emit("message", method, EventToV8(isolate, message, parsed));
+}
+
+bool Debugger::ShouldEmitEvent(const std::string& method) const {
+  if (!filter_events_ || base::Contains(event_filter_, method))
+    return true;
+  size_t dot = method.find('.');
+  return dot != std::string::npos &&
+         base::Contains(event_filter_, method.substr(0, dot) + ".*");
+}
+
+v8::Local<v8::Value> Debugger::EventToV8(v8::Isolate* isolate,
+                                         base::StringPiece message,
+                                         const base::Value* parsed) {
+  switch (event_format_) {
+    case EventFormat::kString:
+      return gin::StringToV8(isolate, message);
+    case EventFormat::kBuffer:
+      return node::Buffer::Copy(isolate, message.data(), message.size())
+          .ToLocalChecked();
+    case EventFormat::kObject:
+      break;
+  }
+
+  std::unique_ptr<base::Value> parsed_message;
+  if (!parsed) {
+    parsed_message = ParseMessage(message);
+    parsed = parsed_message.get();
+  }
+  const base::Value* params = parsed ? parsed->FindDictKey("params") : nullptr;
+  if (!params)
+    return gin::ConvertToV8(isolate, base::DictionaryValue());
+  return gin::ConvertToV8(isolate, *params);
+}
+
+void Debugger::FlushEvents() {
+  batch_timer_.Stop();
+  if (pending_events_.empty())
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  const char* key =
+      event_format_ == EventFormat::kObject ? "params" : "message";
+  std::vector<v8::Local<v8::Value>> events;
+  events.reserve(pending_events_.size());
+  for (const auto& pending_event : pending_events_) {
+    gin_helper::Dictionary event = gin::Dictionary::CreateEmpty(isolate);
+    event.Set("method", pending_event.first);
+    event.Set(key, EventToV8(isolate, pending_event.second, nullptr));
+    events.push_back(event.GetHandle());
+  }
+  pending_events_.clear();
+  Emit("message-batch", events);
+}
+
 void Debugger::RenderFrameHostChanged(content::RenderFrameHost* old_rfh,
                                       content::RenderFrameHost* new_rfh) {
   if (agent_host_) {
@@ -169,6 +282,50 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
   return handle;
 }
 
+void Debugger::SetEventOptions(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Invalid options");
+    return;
+  }
+
+  std::vector<std::string> methods;
+  v8::Local<v8::Value> methods_value;
+  bool filter_events = options.Get("methods", &methods_value) &&
+                       !methods_value->IsNullOrUndefined();
+  if (filter_events &&
+      !gin::ConvertFromV8(args->isolate(), methods_value, &methods)) {
+    args->ThrowTypeError("'methods' must be an array of strings");
+    return;
+  }
+
+  EventFormat event_format = EventFormat::kObject;
+  std::string format;
+  if (options.Get("format", &format)) {
+    if (format == "string") {
+      event_format = EventFormat::kString;
+    } else if (format == "buffer") {
+      event_format = EventFormat::kBuffer;
+    } else if (format != "object") {
+      args->ThrowTypeError("'format' must be 'object', 'string' or 'buffer'");
+      return;
+    }
+  }
+
+  int batch_interval = 0;
+  if (options.Get("batchInterval", &batch_interval) && batch_interval < 0) {
+    args->ThrowTypeError("'batchInterval' must not be negative");
+    return;
+  }
+
+  // The queued events are delivered as they were requested.
+  FlushEvents();
+  filter_events_ = filter_events;
+  event_filter_ = std::set<std::string>(methods.begin(), methods.end());
+  event_format_ = event_format;
+  batch_interval_ = base::TimeDelta::FromMilliseconds(batch_interval);
+}
+
 void Debugger::ClearPendingRequests() {
   for (auto& it : pending_requests_)
     it.second.RejectWithErrorMessage("target closed while handling command");
@@ -187,7 +344,8 @@ gin::ObjectTemplateBuilder Debugger::GetObjectTemplateBuilder(
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("setEventOptions", &Debugger::SetEventOptions);
 }
 
 const char* Debugger::GetTypeName() {
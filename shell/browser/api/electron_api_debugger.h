@@ -6,9 +6,14 @@
 #define SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "content/public/browser/devtools_agent_host_client.h"
 #include "content/public/browser/web_contents_observer.h"
@@ -58,18 +63,49 @@ class Debugger : public gin::Wrappable<Debugger>,
   using PendingRequestMap =
       std::map<int, gin_helper::Promise<base::DictionaryValue>>;
 
+  // How the events are passed to JavaScript.
+  enum class EventFormat {
+    kObject,  // The params parsed into an Object.
+    kString,  // The whole message as a JSON string.
+    kBuffer,  // The whole message as a Buffer of JSON.
+  };
+
   void Attach(gin::Arguments* args);
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin::Arguments* args);
+  void SetEventOptions(gin::Arguments* args);
   void ClearPendingRequests();
 
+  // Emits or queues the event |message|, |parsed| is the message when it has
+  // already been parsed.
+  void HandleEvent(const std::string& method,
+                   base::StringPiece message,
+                   const base::Value* parsed);
+  bool ShouldEmitEvent(const std::string& method) const;
+  v8::Local<v8::Value> EventToV8(v8::Isolate* isolate,
+                                 base::StringPiece message,
+                                 const base::Value* parsed);
+  // Emits the queued events in one "message-batch" event.
+  void FlushEvents();
+
   content::WebContents* web_contents_;  // Weak Reference.
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
 
   PendingRequestMap pending_requests_;
   int previous_request_id_ = 0;
 
+  // Set by setEventOptions.
+  bool filter_events_ = false;
+  // Method names, or domains as "Domain.*".
+  std::set<std::string> event_filter_;
+  EventFormat event_format_ = EventFormat::kObject;
+  base::TimeDelta batch_interval_;
+
+  // Method and message of the events waiting for |batch_timer_|.
+  std::vector<std::pair<std::string, std::string>> pending_events_;
+  base::OneShotTimer batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Debugger);
 };
 
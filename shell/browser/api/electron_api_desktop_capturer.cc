@@ -11,6 +11,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
 #include "chrome/browser/media/webrtc/window_icon_util.h"
 #include "content/public/browser/desktop_capture.h"
@@ -60,6 +61,35 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+const char* GetListType(DesktopMediaList* list) {
+  return list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW
+             ? "window"
+             : "screen";
+}
+
+// The lists can be destroyed from their own notifications.
+void DeleteListSoon(std::unique_ptr<DesktopMediaList> list) {
+  if (list)
+    base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                    std::move(list));
+}
+
+#if defined(OS_WIN)
+bool UsesDirectXCapturer() {
+  if (!content::desktop_capture::CreateDesktopCaptureOptions()
+           .allow_directx_capturer())
+    return false;
+  // DxgiDuplicatorController should be alive in this scope according to
+  // screen_capturer_win.cc.
+  auto duplicator = webrtc::DxgiDuplicatorController::Instance();
+  return webrtc::ScreenCapturerWinDirectx::IsSupported();
+}
+#endif  // defined(OS_WIN)
+
+}  // namespace
+
 gin::WrapperInfo DesktopCapturer::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {}
@@ -69,16 +99,12 @@ DesktopCapturer::~DesktopCapturer() = default;
 void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
                                     const gfx::Size& thumbnail_size,
-                                    bool fetch_window_icons) {
+                                    bool fetch_window_icons,
+                                    bool incremental) {
   fetch_window_icons_ = fetch_window_icons;
+  incremental_ = incremental;
 #if defined(OS_WIN)
-  if (content::desktop_capture::CreateDesktopCaptureOptions()
-          .allow_directx_capturer()) {
-    // DxgiDuplicatorController should be alive in this scope according to
-    // screen_capturer_win.cc.
-    auto duplicator = webrtc::DxgiDuplicatorController::Instance();
-    using_directx_capturer_ = webrtc::ScreenCapturerWinDirectx::IsSupported();
-  }
+  using_directx_capturer_ = UsesDirectXCapturer();
 #endif  // defined(OS_WIN)
 
   // clear any existing captured sources.
@@ -115,8 +141,134 @@ void DesktopCapturer::StartHandling(bool capture_window,
   }
 }
 
+void DesktopCapturer::StartWatching(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons) {
+  fetch_window_icons_ = fetch_window_icons;
+  watching_ = true;
+#if defined(OS_WIN)
+  using_directx_capturer_ = UsesDirectXCapturer();
+#endif  // defined(OS_WIN)
+
+  // Unlike Update(), StartUpdating() refreshes the lists periodically and
+  // only notifies the sources that changed, the thumbnails that did not
+  // change are not sent again.
+  if (capture_window) {
+    window_capturer_ = std::make_unique<NativeDesktopMediaList>(
+        content::DesktopMediaID::TYPE_WINDOW,
+        content::desktop_capture::CreateWindowCapturer());
+    window_capturer_->SetThumbnailSize(thumbnail_size);
+    window_capturer_->StartUpdating(this);
+  }
+
+  if (capture_screen) {
+    screen_capturer_ = std::make_unique<NativeDesktopMediaList>(
+        content::DesktopMediaID::TYPE_SCREEN,
+        content::desktop_capture::CreateScreenCapturer());
+    screen_capturer_->SetThumbnailSize(thumbnail_size);
+    screen_capturer_->StartUpdating(this);
+  }
+}
+
+void DesktopCapturer::StopWatching() {
+  watching_ = false;
+  DeleteListSoon(std::move(window_capturer_));
+  DeleteListSoon(std::move(screen_capturer_));
+}
+
+void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {
+  if (watching_) {
+    gin_helper::CallMethod(
+        this, "_onsourceadded", GetListType(list), index,
+        GetWatchedSource(list, index, fetch_window_icons_));
+    return;
+  }
+  EmitSourceUpdate(list, index);
+}
+
+void DesktopCapturer::OnSourceRemoved(DesktopMediaList* list, int index) {
+  if (watching_)
+    gin_helper::CallMethod(this, "_onsourceremoved", GetListType(list), index);
+}
+
+void DesktopCapturer::OnSourceMoved(DesktopMediaList* list,
+                                    int old_index,
+                                    int new_index) {
+  if (watching_) {
+    gin_helper::CallMethod(this, "_onsourcemoved", GetListType(list),
+                           old_index, new_index);
+  }
+}
+
+void DesktopCapturer::OnSourceNameChanged(DesktopMediaList* list, int index) {
+  if (watching_) {
+    gin_helper::CallMethod(this, "_onsourcenamechanged", GetListType(list),
+                           index, GetWatchedSource(list, index, false));
+    return;
+  }
+  EmitSourceUpdate(list, index);
+}
+
+void DesktopCapturer::OnSourceThumbnailChanged(DesktopMediaList* list,
+                                               int index) {
+  if (watching_) {
+    gin_helper::CallMethod(this, "_onsourcethumbnailchanged",
+                           GetListType(list), index,
+                           GetWatchedSource(list, index, false));
+    return;
+  }
+  EmitSourceUpdate(list, index);
+}
+
 void DesktopCapturer::OnSourceUnchanged(DesktopMediaList* list) {
-  UpdateSourcesList(list);
+  if (!watching_)
+    UpdateSourcesList(list);
+}
+
+void DesktopCapturer::EmitSourceUpdate(DesktopMediaList* list, int index) {
+  // Only the windows are reported early, there are few screens and their
+  // display ids are only known once their list is complete. The icons are
+  // only fetched for the complete list.
+  if (!incremental_ || !capture_window_ ||
+      list->GetMediaListType() != content::DesktopMediaID::TYPE_WINDOW) {
+    return;
+  }
+  gin_helper::CallMethod(
+      this, "_onsource",
+      DesktopCapturer::Source{list->GetSource(index), std::string()});
+}
+
+DesktopCapturer::Source DesktopCapturer::GetWatchedSource(
+    DesktopMediaList* list,
+    int index,
+    bool fetch_icon) {
+  const auto& media_list_source = list->GetSource(index);
+  if (list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW)
+    return DesktopCapturer::Source{media_list_source, std::string(),
+                                   fetch_icon};
+
+  DesktopCapturer::Source source{media_list_source, std::string()};
+#if defined(OS_WIN)
+  // Like in UpdateSourcesList, the device names are in the order of the
+  // screens.
+  std::vector<std::string> device_names;
+  if (using_directx_capturer_ &&
+      webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+          &device_names) &&
+      static_cast<size_t>(index) < device_names.size()) {
+    const auto& device_name = device_names[index];
+    std::wstring wide_device_name;
+    base::UTF8ToWide(device_name.c_str(), device_name.size(),
+                     &wide_device_name);
+    source.display_id = base::NumberToString(
+        display::win::DisplayInfo::DeviceIdFromDeviceName(
+            wide_device_name.c_str()));
+  }
+#elif defined(OS_MACOSX)
+  source.display_id = base::NumberToString(media_list_source.id.id);
+#endif  // defined(OS_WIN)
+  return source;
 }
 
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
@@ -132,6 +284,8 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
     }
     std::move(window_sources.begin(), window_sources.end(),
               std::back_inserter(captured_sources_));
+    // Free the one-time use capturer now that its thumbnails are fetched.
+    DeleteListSoon(std::move(window_capturer_));
   }
 
   if (capture_screen_ &&
@@ -182,6 +336,7 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
     // individual screen support is added.
     std::move(screen_sources.begin(), screen_sources.end(),
               std::back_inserter(captured_sources_));
+    DeleteListSoon(std::move(screen_capturer_));
   }
 
   if (!capture_window_ && !capture_screen_)
@@ -197,7 +352,9 @@ gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
 gin::ObjectTemplateBuilder DesktopCapturer::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<DesktopCapturer>::GetObjectTemplateBuilder(isolate)
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("startWatching", &DesktopCapturer::StartWatching)
+      .SetMethod("stopWatching", &DesktopCapturer::StopWatching);
 }
 
 const char* DesktopCapturer::GetTypeName() {
@@ -33,9 +33,18 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   static gin::Handle<DesktopCapturer> Create(v8::Isolate* isolate);
 
   void StartHandling(bool capture_window,
+                     bool capture_screen,
+                     const gfx::Size& thumbnail_size,
+                     bool fetch_window_icons,
+                     bool incremental);
+
+  // Keeps the lists alive and reports their changes until StopWatching is
+  // called, rather than enumerating them once.
+  void StartWatching(bool capture_window,
                      bool capture_screen,
                      const gfx::Size& thumbnail_size,
                      bool fetch_window_icons);
+  void StopWatching();
 
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
@@ -48,17 +57,22 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   ~DesktopCapturer() override;
 
   // DesktopMediaListObserver:
-  void OnSourceAdded(DesktopMediaList* list, int index) override {}
-  void OnSourceRemoved(DesktopMediaList* list, int index) override {}
+  void OnSourceAdded(DesktopMediaList* list, int index) override;
+  void OnSourceRemoved(DesktopMediaList* list, int index) override;
   void OnSourceMoved(DesktopMediaList* list,
                      int old_index,
-                     int new_index) override {}
-  void OnSourceNameChanged(DesktopMediaList* list, int index) override {}
-  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override {}
+                     int new_index) override;
+  void OnSourceNameChanged(DesktopMediaList* list, int index) override;
+  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override;
   void OnSourceUnchanged(DesktopMediaList* list) override;
 
  private:
   void UpdateSourcesList(DesktopMediaList* list);
+  // Reports a source of |list| before the whole list is ready, in the
+  // incremental mode.
+  void EmitSourceUpdate(DesktopMediaList* list, int index);
+  // Returns the source at |index| of a watched |list|.
+  Source GetWatchedSource(DesktopMediaList* list, int index, bool fetch_icon);
 
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
@@ -66,6 +80,8 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  bool incremental_ = false;
+  bool watching_ = false;
 #if defined(OS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // defined(OS_WIN)
@@ -4,12 +4,17 @@
 
 #include "shell/browser/api/electron_api_download_item.h"
 
+#include <algorithm>
 #include <map>
+#include <utility>
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "content/public/browser/download_item_utils.h"
 #include "net/base/filename_util.h"
+#include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/net/download_throttle.h"
 #include "shell/common/gin_converters/file_dialog_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -61,6 +66,10 @@ DownloadItem::DownloadItem(v8::Isolate* isolate,
                            download::DownloadItem* download_item)
     : download_item_(download_item) {
   download_item_->AddObserver(this);
+  limiter_offset_ = download_item_->GetReceivedBytes();
+  interrupted_ =
+      download_item_->GetState() == download::DownloadItem::INTERRUPTED;
+  TakeLimiter();
   Init(isolate);
   AttachAsUserData(download_item);
 }
@@ -76,7 +85,35 @@ DownloadItem::~DownloadItem() {
   g_download_item_objects.erase(weak_map_id());
 }
 
+void DownloadItem::TakeLimiter() {
+  if (!awaiting_limiter_ || interrupted_)
+    return;
+  auto* browser_context = static_cast<ElectronBrowserContext*>(
+      content::DownloadItemUtils::GetBrowserContext(download_item_));
+  if (!browser_context)
+    return;
+  auto limiter = browser_context->download_throttle()->TakeLimiter(
+      GetURL(), limiter_offset_);
+  if (!limiter)
+    return;
+  limiter->SetLimit(bandwidth_limit_);
+  limiter_ = std::move(limiter);
+  awaiting_limiter_ = false;
+}
+
 void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
+  // Resuming an interrupted download sends a new request from the bytes
+  // received so far, whose body has a limiter of its own.
+  if (item->GetState() == download::DownloadItem::INTERRUPTED) {
+    interrupted_ = true;
+  } else if (interrupted_ &&
+             item->GetState() == download::DownloadItem::IN_PROGRESS) {
+    interrupted_ = false;
+    awaiting_limiter_ = true;
+    limiter_offset_ = item->GetReceivedBytes();
+    limiter_ = nullptr;
+  }
+  TakeLimiter();
   if (download_item_->IsDone()) {
     Emit("done", item->GetState());
     // Destroy the item once item is downloaded.
@@ -186,6 +223,39 @@ double DownloadItem::GetStartTime() const {
   return download_item_->GetStartTime().ToDoubleT();
 }
 
+int64_t DownloadItem::GetCurrentBytesPerSecond() const {
+  return download_item_->CurrentSpeed();
+}
+
+int64_t DownloadItem::GetAverageBytesPerSecond() const {
+  bool complete =
+      download_item_->GetState() == download::DownloadItem::COMPLETE;
+  base::Time end =
+      complete ? download_item_->GetEndTime() : base::Time::Now();
+  base::TimeDelta elapsed = end - download_item_->GetStartTime();
+  if (elapsed <= base::TimeDelta())
+    return 0;
+  return static_cast<int64_t>(download_item_->GetReceivedBytes() /
+                              elapsed.InSecondsF());
+}
+
+double DownloadItem::GetTimeRemaining() const {
+  base::TimeDelta remaining;
+  if (!download_item_->TimeRemaining(&remaining))
+    return -1;
+  return remaining.InSecondsF();
+}
+
+void DownloadItem::SetBandwidthLimit(int64_t bytes_per_second) {
+  bandwidth_limit_ = std::max<int64_t>(bytes_per_second, 0);
+  if (limiter_)
+    limiter_->SetLimit(bandwidth_limit_);
+}
+
+int64_t DownloadItem::GetBandwidthLimit() const {
+  return bandwidth_limit_;
+}
+
 // static
 void DownloadItem::BuildPrototype(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
@@ -215,7 +285,14 @@ void DownloadItem::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getSaveDialogOptions", &DownloadItem::GetSaveDialogOptions)
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
-      .SetMethod("getStartTime", &DownloadItem::GetStartTime);
+      .SetMethod("getStartTime", &DownloadItem::GetStartTime)
+      .SetMethod("getCurrentBytesPerSecond",
+                 &DownloadItem::GetCurrentBytesPerSecond)
+      .SetMethod("getAverageBytesPerSecond",
+                 &DownloadItem::GetAverageBytesPerSecond)
+      .SetMethod("getTimeRemaining", &DownloadItem::GetTimeRemaining)
+      .SetMethod("setBandwidthLimit", &DownloadItem::SetBandwidthLimit)
+      .SetMethod("getBandwidthLimit", &DownloadItem::GetBandwidthLimit);
 }
 
 // static
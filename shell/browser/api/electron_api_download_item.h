@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/handle.h"
 #include "shell/browser/ui/file_dialog.h"
@@ -17,6 +18,8 @@
 
 namespace electron {
 
+class BandwidthLimiter;
+
 namespace api {
 
 class DownloadItem : public gin_helper::TrackableObject<DownloadItem>,
@@ -50,6 +53,11 @@ class DownloadItem : public gin_helper::TrackableObject<DownloadItem>,
   std::string GetLastModifiedTime() const;
   std::string GetETag() const;
   double GetStartTime() const;
+  int64_t GetCurrentBytesPerSecond() const;
+  int64_t GetAverageBytesPerSecond() const;
+  double GetTimeRemaining() const;
+  void SetBandwidthLimit(int64_t bytes_per_second);
+  int64_t GetBandwidthLimit() const;
 
  protected:
   DownloadItem(v8::Isolate* isolate, download::DownloadItem* download_item);
@@ -64,6 +72,20 @@ class DownloadItem : public gin_helper::TrackableObject<DownloadItem>,
   file_dialog::DialogSettings dialog_options_;
   download::DownloadItem* download_item_;
 
+  // 0 for no limit, applied to the response of each resumption.
+  int64_t bandwidth_limit_ = 0;
+  scoped_refptr<BandwidthLimiter> limiter_;
+
+  // Whether the limiter of the current request is still to be taken, and the
+  // offset its response starts at.
+  bool awaiting_limiter_ = true;
+  int64_t limiter_offset_ = 0;
+  bool interrupted_ = false;
+
+  // Takes the limiter of the current request of the download, once its
+  // response arrived.
+  void TakeLimiter();
+
   DISALLOW_COPY_AND_ASSIGN(DownloadItem);
 };
 
@@ -71,6 +71,15 @@ void GlobalShortcut::OnKeyPressed(const ui::Accelerator& accelerator) {
 bool GlobalShortcut::RegisterAll(
     const std::vector<ui::Accelerator>& accelerators,
     const base::Closure& callback) {
+#if defined(OS_MACOSX)
+  // Fail before registering anything rather than undoing the registrations
+  // that came before.
+  for (const auto& accelerator : accelerators) {
+    if (RegisteringMediaKeyForUntrustedClient(accelerator))
+      return false;
+  }
+#endif
+
   std::vector<ui::Accelerator> registered;
 
   for (auto& accelerator : accelerators) {
@@ -158,10 +158,31 @@ void Menu::SetRole(int index, const base::string16& role) {
   model_->SetRole(index, role);
 }
 
+void Menu::UpdateItemAt(int index,
+                        const base::string16& label,
+                        const base::string16& sublabel,
+                        const base::string16& toolTip) {
+  if (index < 0 || index >= model_->GetItemCount())
+    return;
+  model_->SetLabel(index, label);
+  model_->SetSublabel(index, sublabel);
+  model_->SetToolTip(index, toolTip);
+
+  // Only the native menus built from the root know about the change.
+  Menu* root = this;
+  while (root->parent_)
+    root = root->parent_;
+  root->OnItemChanged(model_.get(), index);
+}
+
 void Menu::Clear() {
   model_->Clear();
 }
 
+void Menu::SetLazy(bool lazy) {
+  model_->set_lazy(lazy);
+}
+
 int Menu::GetIndexOfCommandId(int command_id) {
   return model_->GetIndexOfCommandId(command_id);
 }
@@ -244,7 +265,9 @@ void Menu::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
+      .SetMethod("_updateItemAt", &Menu::UpdateItemAt)
       .SetMethod("clear", &Menu::Clear)
+      .SetMethod("_setLazy", &Menu::SetLazy)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
       .SetMethod("getCommandIdAt", &Menu::GetCommandIdAt)
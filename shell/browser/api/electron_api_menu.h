@@ -64,6 +64,10 @@ class Menu : public gin_helper::TrackableObject<Menu>,
                        base::OnceClosure callback) = 0;
   virtual void ClosePopupAt(int32_t window_id) = 0;
 
+  // Called on the root menu when the item at |index| of |model|, its own model
+  // or the one of a submenu, was updated in place.
+  virtual void OnItemChanged(ElectronMenuModel* model, int index) {}
+
   std::unique_ptr<ElectronMenuModel> model_;
   Menu* parent_ = nullptr;
 
@@ -94,7 +98,12 @@ class Menu : public gin_helper::TrackableObject<Menu>,
   void SetSublabel(int index, const base::string16& sublabel);
   void SetToolTip(int index, const base::string16& toolTip);
   void SetRole(int index, const base::string16& role);
+  void UpdateItemAt(int index,
+                    const base::string16& label,
+                    const base::string16& sublabel,
+                    const base::string16& toolTip);
   void Clear();
+  void SetLazy(bool lazy);
   int GetIndexOfCommandId(int command_id);
   int GetItemCount() const;
   int GetCommandIdAt(int index) const;
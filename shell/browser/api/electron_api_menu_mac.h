@@ -8,7 +8,10 @@
 #include "shell/browser/api/electron_api_menu.h"
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #import "shell/browser/ui/cocoa/electron_menu_controller.h"
 
@@ -36,17 +39,27 @@ class MenuMac : public Menu {
                  base::OnceClosure callback);
   void ClosePopupAt(int32_t window_id) override;
   void ClosePopupOnUI(int32_t window_id);
+  void OnItemChanged(ElectronMenuModel* model, int index) override;
 
  private:
   friend class Menu;
 
   void OnClosed(int32_t window_id, base::OnceClosure callback);
 
+  // Applies the item changes of this run loop turn to the native menus.
+  void CommitItemChanges();
+
   scoped_nsobject<ElectronMenuController> menu_controller_;
 
   // window ID -> open context menu
   std::map<int32_t, scoped_nsobject<ElectronMenuController>> popup_controllers_;
 
+  // The items changed since the last commit, so that setting several of the
+  // properties of an item only updates its NSMenuItem once. The models of
+  // submenus can be destroyed before the commit.
+  std::vector<std::pair<base::WeakPtr<ElectronMenuModel>, int>>
+      pending_item_changes_;
+
   base::WeakPtrFactory<MenuMac> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(MenuMac);
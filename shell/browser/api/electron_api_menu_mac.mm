@@ -4,8 +4,10 @@
 
 #import "shell/browser/api/electron_api_menu_mac.h"
 
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/mac/scoped_sending_event.h"
 #include "base/message_loop/message_loop_current.h"
@@ -142,6 +144,33 @@ void MenuMac::ClosePopupOnUI(int32_t window_id) {
   }
 }
 
+void MenuMac::OnItemChanged(ElectronMenuModel* model, int index) {
+  bool commit_scheduled = !pending_item_changes_.empty();
+  pending_item_changes_.emplace_back(model->GetWeakPtr(), index);
+  if (!commit_scheduled) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&MenuMac::CommitItemChanges,
+                                  weak_factory_.GetWeakPtr()));
+  }
+}
+
+void MenuMac::CommitItemChanges() {
+  std::vector<std::pair<base::WeakPtr<ElectronMenuModel>, int>> changes;
+  changes.swap(pending_item_changes_);
+  std::set<std::pair<ElectronMenuModel*, int>> committed;
+  for (const auto& change : changes) {
+    ElectronMenuModel* model = change.first.get();
+    int index = change.second;
+    // The menu could have been destroyed or cleared since.
+    if (!model || index >= model->GetItemCount() ||
+        !committed.emplace(model, index).second)
+      continue;
+    [menu_controller_ refreshItemAtIndex:index ofModel:model];
+    for (auto& it : popup_controllers_)
+      [it.second refreshItemAtIndex:index ofModel:model];
+  }
+}
+
 void MenuMac::OnClosed(int32_t window_id, base::OnceClosure callback) {
   popup_controllers_.erase(window_id);
   std::move(callback).Run();
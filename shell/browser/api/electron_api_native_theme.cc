@@ -10,6 +10,7 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "gin/handle.h"
+#include "shell/browser/system_snapshot_publisher.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -47,6 +48,7 @@ void NativeTheme::SetThemeSource(ui::NativeTheme::ThemeSource override) {
   // Update the macOS appearance setting for this new override value
   UpdateMacOSAppearanceForOverrideValue(override);
 #endif
+  SystemSnapshotPublisher::GetInstance()->Update();
   // TODO(MarshallOfSound): Update all existing browsers windows to use GTK dark
   // theme
 }
@@ -68,8 +70,13 @@ const CFStringRef WhiteOnBlack = CFSTR("whiteOnBlack");
 const CFStringRef UniversalAccessDomain = CFSTR("com.apple.universalaccess");
 #endif
 
-// TODO(MarshallOfSound): Implement for Linux
 bool NativeTheme::ShouldUseInvertedColorScheme() {
+  return IsInvertedColorScheme();
+}
+
+// TODO(MarshallOfSound): Implement for Linux
+// static
+bool NativeTheme::IsInvertedColorScheme() {
 #if defined(OS_MACOSX)
   CFPreferencesAppSynchronize(UniversalAccessDomain);
   Boolean keyExistsAndHasValidFormat = false;
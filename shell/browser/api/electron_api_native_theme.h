@@ -21,6 +21,8 @@ class NativeTheme : public gin_helper::EventEmitter<NativeTheme>,
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
+  static bool IsInvertedColorScheme();
+
  protected:
   NativeTheme(v8::Isolate* isolate, ui::NativeTheme* theme);
   ~NativeTheme() override;
@@ -50,6 +50,7 @@ bool IsValidHeaderValue(std::string header_value) {
 }
 
 using electron::api::Net;
+using electron::api::SimpleURLLoaderPool;
 using electron::api::SimpleURLLoaderWrapper;
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -65,6 +66,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("isValidHeaderName", &IsValidHeaderName);
   dict.SetMethod("isValidHeaderValue", &IsValidHeaderValue);
   dict.SetMethod("createURLLoader", &SimpleURLLoaderWrapper::Create);
+  dict.SetMethod("createURLLoaderPool", &SimpleURLLoaderPool::Create);
 }
 
 }  // namespace
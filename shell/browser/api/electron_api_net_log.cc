@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/files/file_util.h"
 #include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
@@ -63,6 +64,14 @@ base::File OpenFileForWriting(base::FilePath path) {
                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 }
 
+base::Value GetCustomConstants() {
+  auto command_line_string =
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
+  auto channel_string = std::string("Electron " ELECTRON_VERSION);
+  return base::Value::FromUniquePtrValue(net_log::GetPlatformConstantsForNetLog(
+      command_line_string, channel_string));
+}
+
 void ResolvePromiseWithNetError(gin_helper::Promise<void> promise,
                                 int32_t error) {
   if (error == net::OK) {
@@ -120,17 +129,24 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
     return v8::Local<v8::Promise>();
   }
 
+  if (snapshot_pending_) {
+    args->ThrowTypeError("A net log snapshot is in progress");
+    return v8::Local<v8::Promise>();
+  }
+
   pending_start_promise_ =
       base::make_optional<gin_helper::Promise<void>>(args->isolate());
   v8::Local<v8::Promise> handle = pending_start_promise_->GetHandle();
 
-  auto command_line_string =
-      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
-  auto channel_string = std::string("Electron " ELECTRON_VERSION);
-  base::Value custom_constants =
-      base::Value::FromUniquePtrValue(net_log::GetPlatformConstantsForNetLog(
-          command_line_string, channel_string));
+  log_path_ = log_path;
+  capture_mode_ = capture_mode;
+  max_file_size_ = max_file_size;
+  StartNetLog();
 
+  return handle;
+}
+
+void NetLog::StartNetLog() {
   auto* network_context =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_)
           ->GetNetworkContext();
@@ -141,12 +157,10 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(OpenFileForWriting, log_path),
+      base::BindOnce(OpenFileForWriting, log_path_),
       base::BindOnce(&NetLog::StartNetLogAfterCreateFile,
-                     weak_ptr_factory_.GetWeakPtr(), capture_mode,
-                     max_file_size, std::move(custom_constants)));
-
-  return handle;
+                     weak_ptr_factory_.GetWeakPtr(), capture_mode_,
+                     max_file_size_, GetCustomConstants()));
 }
 
 void NetLog::StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
@@ -159,12 +173,15 @@ void NetLog::StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
     // been resolved.
     return;
   }
-  DCHECK(pending_start_promise_);
   if (!output_file.IsValid()) {
-    std::move(*pending_start_promise_)
-        .RejectWithErrorMessage(
-            base::File::ErrorToString(output_file.error_details()));
+    // A log resumed after a snapshot has no promise of its own.
+    if (pending_start_promise_) {
+      std::move(*pending_start_promise_)
+          .RejectWithErrorMessage(
+              base::File::ErrorToString(output_file.error_details()));
+    }
     net_log_exporter_.reset();
+    snapshot_pending_ = false;
     return;
   }
   net_log_exporter_->Start(
@@ -174,15 +191,20 @@ void NetLog::StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
 }
 
 void NetLog::NetLogStarted(int32_t error) {
-  DCHECK(pending_start_promise_);
-  ResolvePromiseWithNetError(std::move(*pending_start_promise_), error);
+  snapshot_pending_ = false;
+  if (pending_start_promise_) {
+    ResolvePromiseWithNetError(std::move(*pending_start_promise_), error);
+    pending_start_promise_.reset();
+  }
 }
 
 void NetLog::OnConnectionError() {
   net_log_exporter_.reset();
+  snapshot_pending_ = false;
   if (pending_start_promise_) {
     std::move(*pending_start_promise_)
         .RejectWithErrorMessage("Failed to start net log exporter");
+    pending_start_promise_.reset();
   }
 }
 
@@ -194,7 +216,9 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   gin_helper::Promise<void> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  if (net_log_exporter_) {
+  if (snapshot_pending_) {
+    promise.RejectWithErrorMessage("A net log snapshot is in progress");
+  } else if (net_log_exporter_) {
     // Move the net_log_exporter_ into the callback to ensure that the mojo
     // pointer lives long enough to resolve the promise. Moving it into the
     // callback will cause the instance variable to become empty.
@@ -213,12 +237,67 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::Snapshot(base::FilePath snapshot_path,
+                                        gin::Arguments* args) {
+  if (snapshot_path.empty()) {
+    args->ThrowTypeError("The first parameter must be a valid string");
+    return v8::Local<v8::Promise>();
+  }
+
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (snapshot_pending_) {
+    promise.RejectWithErrorMessage("A net log snapshot is in progress");
+  } else if (!net_log_exporter_ || pending_start_promise_) {
+    promise.RejectWithErrorMessage("No net log in progress");
+  } else {
+    snapshot_pending_ = true;
+    net_log_exporter_->Stop(
+        base::Value(base::Value::Type::DICTIONARY),
+        base::BindOnce(&NetLog::OnStoppedForSnapshot,
+                       weak_ptr_factory_.GetWeakPtr(),
+                       std::move(net_log_exporter_), std::move(snapshot_path),
+                       std::move(promise)));
+  }
+
+  return handle;
+}
+
+void NetLog::OnStoppedForSnapshot(network::mojom::NetLogExporterPtr,
+                                  base::FilePath snapshot_path,
+                                  gin_helper::Promise<void> promise,
+                                  int32_t error) {
+  if (error != net::OK) {
+    snapshot_pending_ = false;
+    ResolvePromiseWithNetError(std::move(promise), error);
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&base::CopyFile, log_path_, std::move(snapshot_path)),
+      base::BindOnce(&NetLog::OnSnapshotWritten,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(promise)));
+}
+
+void NetLog::OnSnapshotWritten(gin_helper::Promise<void> promise,
+                               bool success) {
+  // The promise settles once the log is resumed, so that it can be stopped.
+  if (success)
+    pending_start_promise_ = std::move(promise);
+  else
+    promise.RejectWithErrorMessage("Failed to write the snapshot");
+  StartNetLog();
+}
+
 gin::ObjectTemplateBuilder NetLog::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<NetLog>::GetObjectTemplateBuilder(isolate)
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetMethod("snapshot", &NetLog::Snapshot);
 }
 
 const char* NetLog::GetTypeName() {
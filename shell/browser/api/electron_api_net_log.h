@@ -35,6 +35,8 @@ class NetLog : public gin::Wrappable<NetLog> {
   v8::Local<v8::Promise> StartLogging(base::FilePath log_path,
                                       gin::Arguments* args);
   v8::Local<v8::Promise> StopLogging(gin::Arguments* args);
+  v8::Local<v8::Promise> Snapshot(base::FilePath snapshot_path,
+                                  gin::Arguments* args);
   bool IsCurrentlyLogging() const;
 
   // gin::Wrappable
@@ -50,11 +52,19 @@ class NetLog : public gin::Wrappable<NetLog> {
 
   void OnConnectionError();
 
+  // Opens |log_path_| and starts logging to it with the options of the last
+  // call to StartLogging.
+  void StartNetLog();
   void StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
                                   uint64_t max_file_size,
                                   base::Value custom_constants,
                                   base::File output_file);
   void NetLogStarted(int32_t error);
+  void OnStoppedForSnapshot(network::mojom::NetLogExporterPtr,
+                            base::FilePath snapshot_path,
+                            gin_helper::Promise<void> promise,
+                            int32_t error);
+  void OnSnapshotWritten(gin_helper::Promise<void> promise, bool success);
 
  private:
   ElectronBrowserContext* browser_context_;
@@ -63,6 +73,13 @@ class NetLog : public gin::Wrappable<NetLog> {
 
   base::Optional<gin_helper::Promise<void>> pending_start_promise_;
 
+  // The options of the log in progress, to resume it after a snapshot.
+  base::FilePath log_path_;
+  net::NetLogCaptureMode capture_mode_ = net::NetLogCaptureMode::kDefault;
+  uint64_t max_file_size_ = network::mojom::NetLogExporter::kUnlimitedFileSize;
+  // Set from a snapshot until the log is resumed.
+  bool snapshot_pending_ = false;
+
   scoped_refptr<base::TaskRunner> file_task_runner_;
 
   base::WeakPtrFactory<NetLog> weak_ptr_factory_;
@@ -71,6 +71,7 @@ Notification::Notification(gin::Arguments* args) {
     opts.Get("actions", &actions_);
     opts.Get("sound", &sound_);
     opts.Get("closeButtonText", &close_button_text_);
+    opts.Get("groupId", &group_id_);
   }
 }
 
@@ -134,6 +135,10 @@ base::string16 Notification::GetCloseButtonText() const {
   return close_button_text_;
 }
 
+std::string Notification::GetGroupId() const {
+  return group_id_;
+}
+
 // Setters
 void Notification::SetTitle(const base::string16& new_title) {
   title_ = new_title;
@@ -180,6 +185,10 @@ void Notification::SetCloseButtonText(const base::string16& text) {
   close_button_text_ = text;
 }
 
+void Notification::SetGroupId(const std::string& group_id) {
+  group_id_ = group_id;
+}
+
 void Notification::NotificationAction(int index) {
   Emit("action", index);
 }
@@ -230,6 +239,9 @@ void Notification::Show() {
       options.sound = sound_;
       options.close_button_text = close_button_text_;
       options.urgency = urgency_;
+      // Notifications of a group replace each other, and the backends reuse
+      // what they created for the previous one.
+      options.tag = group_id_;
       notification_->Show(options);
     }
   }
@@ -265,7 +277,9 @@ void Notification::BuildPrototype(v8::Isolate* isolate,
       .SetProperty("actions", &Notification::GetActions,
                    &Notification::SetActions)
       .SetProperty("closeButtonText", &Notification::GetCloseButtonText,
-                   &Notification::SetCloseButtonText);
+                   &Notification::SetCloseButtonText)
+      .SetProperty("groupId", &Notification::GetGroupId,
+                   &Notification::SetGroupId);
 }
 
 }  // namespace api
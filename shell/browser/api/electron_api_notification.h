@@ -62,6 +62,7 @@ class Notification : public gin_helper::TrackableObject<Notification>,
   base::string16 GetSound() const;
   std::vector<electron::NotificationAction> GetActions() const;
   base::string16 GetCloseButtonText() const;
+  std::string GetGroupId() const;
 
   // Prop Setters
   void SetTitle(const base::string16& new_title);
@@ -75,6 +76,7 @@ class Notification : public gin_helper::TrackableObject<Notification>,
   void SetSound(const base::string16& sound);
   void SetActions(const std::vector<electron::NotificationAction>& actions);
   void SetCloseButtonText(const base::string16& text);
+  void SetGroupId(const std::string& group_id);
 
  private:
   base::string16 title_;
@@ -91,6 +93,7 @@ class Notification : public gin_helper::TrackableObject<Notification>,
   base::string16 urgency_;
   std::vector<electron::NotificationAction> actions_;
   base::string16 close_button_text_;
+  std::string group_id_;
 
   electron::NotificationPresenter* presenter_;
 
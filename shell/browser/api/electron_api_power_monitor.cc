@@ -8,6 +8,7 @@
 #include "base/power_monitor/power_monitor_device_source.h"
 #include "gin/handle.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -39,6 +40,26 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+const char* ThermalStateToString(
+    base::PowerObserver::DeviceThermalState state) {
+  switch (state) {
+    case base::PowerObserver::DeviceThermalState::kNominal:
+      return "nominal";
+    case base::PowerObserver::DeviceThermalState::kFair:
+      return "fair";
+    case base::PowerObserver::DeviceThermalState::kSerious:
+      return "serious";
+    case base::PowerObserver::DeviceThermalState::kCritical:
+      return "critical";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
 gin::WrapperInfo PowerMonitor::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 PowerMonitor::PowerMonitor(v8::Isolate* isolate) {
@@ -77,6 +98,10 @@ void PowerMonitor::OnResume() {
   Emit("resume");
 }
 
+void PowerMonitor::OnThermalStateChange(DeviceThermalState new_state) {
+  Emit("thermal-state-change", ThermalStateToString(new_state));
+}
+
 #if defined(OS_LINUX)
 void PowerMonitor::SetListeningForShutdown(bool is_listening) {
   if (is_listening) {
@@ -136,6 +161,15 @@ int GetSystemIdleTime() {
   return ui::CalculateIdleTime();
 }
 
+bool IsOnBatteryPower() {
+  return base::PowerMonitor::IsOnBatteryPower();
+}
+
+const char* GetCurrentThermalState() {
+  return electron::api::ThermalStateToString(
+      base::PowerMonitor::GetCurrentThermalState());
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -147,6 +181,12 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getSystemIdleState",
                  base::BindRepeating(&GetSystemIdleState));
   dict.SetMethod("getSystemIdleTime", base::BindRepeating(&GetSystemIdleTime));
+  dict.SetMethod("isOnBatteryPower", base::BindRepeating(&IsOnBatteryPower));
+  dict.SetMethod("getCurrentThermalState",
+                 base::BindRepeating(&GetCurrentThermalState));
+  dict.SetMethod(
+      "setPreconnectDeferred",
+      base::BindRepeating(&electron::PreconnectPredictor::SetDeferred));
 }
 
 }  // namespace
@@ -51,6 +51,7 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
   void OnPowerStateChange(bool on_battery_power) override;
   void OnSuspend() override;
   void OnResume() override;
+  void OnThermalStateChange(DeviceThermalState new_state) override;
 
 #if defined(OS_WIN)
   // Static callback invoked when a message comes in to our messaging window.
@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -42,6 +43,12 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+constexpr base::TimeDelta kReleaseDelay = base::TimeDelta::FromSeconds(1);
+
+}  // namespace
+
 gin::WrapperInfo PowerSaveBlocker::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 PowerSaveBlocker::PowerSaveBlocker(v8::Isolate* isolate)
@@ -51,6 +58,34 @@ PowerSaveBlocker::PowerSaveBlocker(v8::Isolate* isolate)
 PowerSaveBlocker::~PowerSaveBlocker() = default;
 
 void PowerSaveBlocker::UpdatePowerSaveBlocker() {
+  // Stronger locks are taken right away, weaker ones after a delay, during
+  // which new requests can still need the current one.
+  bool needs_display =
+      display_sleep_count_ > 0 &&
+      (!is_wake_lock_active_ ||
+       current_lock_type_ != device::mojom::WakeLockType::kPreventDisplaySleep);
+  bool needs_lock = !wake_lock_types_.empty() && !is_wake_lock_active_;
+  if (needs_display || needs_lock) {
+    release_timer_.Stop();
+    ApplyWakeLock();
+    return;
+  }
+
+  bool is_weaker =
+      wake_lock_types_.empty() ||
+      (display_sleep_count_ == 0 &&
+       current_lock_type_ == device::mojom::WakeLockType::kPreventDisplaySleep);
+  if (is_weaker && is_wake_lock_active_) {
+    if (!release_timer_.IsRunning())
+      release_timer_.Start(FROM_HERE, kReleaseDelay,
+                           base::BindOnce(&PowerSaveBlocker::ApplyWakeLock,
+                                          base::Unretained(this)));
+  } else {
+    release_timer_.Stop();
+  }
+}
+
+void PowerSaveBlocker::ApplyWakeLock() {
   if (wake_lock_types_.empty()) {
     if (is_wake_lock_active_) {
       GetWakeLock()->CancelWakeLock();
@@ -66,13 +101,9 @@ void PowerSaveBlocker::UpdatePowerSaveBlocker() {
   //
   // Only the highest-precedence blocker type takes effect.
   device::mojom::WakeLockType new_lock_type =
-      device::mojom::WakeLockType::kPreventAppSuspension;
-  for (const auto& element : wake_lock_types_) {
-    if (element.second == device::mojom::WakeLockType::kPreventDisplaySleep) {
-      new_lock_type = device::mojom::WakeLockType::kPreventDisplaySleep;
-      break;
-    }
-  }
+      display_sleep_count_ > 0
+          ? device::mojom::WakeLockType::kPreventDisplaySleep
+          : device::mojom::WakeLockType::kPreventAppSuspension;
 
   if (current_lock_type_ != new_lock_type) {
     GetWakeLock()->ChangeType(new_lock_type, base::DoNothing());
@@ -101,14 +132,21 @@ device::mojom::WakeLock* PowerSaveBlocker::GetWakeLock() {
 int PowerSaveBlocker::Start(device::mojom::WakeLockType type) {
   static int count = 0;
   wake_lock_types_[count] = type;
+  if (type == device::mojom::WakeLockType::kPreventDisplaySleep)
+    ++display_sleep_count_;
   UpdatePowerSaveBlocker();
   return count++;
 }
 
 bool PowerSaveBlocker::Stop(int id) {
-  bool success = wake_lock_types_.erase(id) > 0;
+  auto it = wake_lock_types_.find(id);
+  if (it == wake_lock_types_.end())
+    return false;
+  if (it->second == device::mojom::WakeLockType::kPreventDisplaySleep)
+    --display_sleep_count_;
+  wake_lock_types_.erase(it);
   UpdatePowerSaveBlocker();
-  return success;
+  return true;
 }
 
 bool PowerSaveBlocker::IsStarted(int id) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
@@ -34,6 +35,7 @@ class PowerSaveBlocker : public gin::Wrappable<PowerSaveBlocker> {
 
  private:
   void UpdatePowerSaveBlocker();
+  void ApplyWakeLock();
   int Start(device::mojom::WakeLockType type);
   bool Stop(int id);
   bool IsStarted(int id);
@@ -50,6 +52,13 @@ class PowerSaveBlocker : public gin::Wrappable<PowerSaveBlocker> {
   using WakeLockTypeMap = std::map<int, device::mojom::WakeLockType>;
   WakeLockTypeMap wake_lock_types_;
 
+  // How many of the requests prevent the display from sleeping.
+  size_t display_sleep_count_ = 0;
+
+  // Releases or downgrades the wake lock a moment after the requests that
+  // needed it stopped, so that short-lived requests do not toggle it.
+  base::OneShotTimer release_timer_;
+
   mojo::Remote<device::mojom::WakeLock> wake_lock_;
 
   DISALLOW_COPY_AND_ASSIGN(PowerSaveBlocker);
@@ -9,14 +9,17 @@
 #include <vector>
 
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "gin/object_template_builder.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/options_switches.h"
@@ -176,6 +179,28 @@ ProtocolError Protocol::RegisterProtocol(ProtocolType type,
   return added ? ProtocolError::OK : ProtocolError::REGISTERED;
 }
 
+bool Protocol::RegisterDirectoryProtocol(gin_helper::ErrorThrower thrower,
+                                         const std::string& scheme,
+                                         const DirectoryRoutes& routes,
+                                         gin::Arguments* args) {
+  DirectoryProtocol protocol;
+  for (const auto& it : routes) {
+    if (!it.second.IsAbsolute()) {
+      thrower.ThrowError("The directory of a route must be an absolute path");
+      return false;
+    }
+    std::string prefix;
+    base::TrimString(it.first, "/", &prefix);
+    protocol.routes[prefix] = it.second;
+  }
+  gin_helper::Dictionary options;
+  int64_t cache_size = 0;
+  if (args->GetNext(&options) && options.Get("cacheSize", &cache_size) &&
+      cache_size > 0)
+    protocol.cache = base::MakeRefCounted<StaticFileCache>(cache_size);
+  return protocol_registry_->RegisterDirectoryProtocol(scheme, protocol);
+}
+
 void Protocol::UnregisterProtocol(const std::string& scheme,
                                   gin::Arguments* args) {
   bool removed = protocol_registry_->UnregisterProtocol(scheme);
@@ -266,6 +291,8 @@ gin::ObjectTemplateBuilder Protocol::GetObjectTemplateBuilder(
                  &Protocol::RegisterProtocolFor<ProtocolType::kStream>)
       .SetMethod("registerProtocol",
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
+      .SetMethod("registerDirectoryProtocol",
+                 &Protocol::RegisterDirectoryProtocol)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
@@ -314,6 +341,9 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("registerSchemesAsPrivileged", &RegisterSchemesAsPrivileged);
   dict.SetMethod("getStandardSchemes", &electron::api::GetStandardSchemes);
+  dict.SetMethod(
+      "setFileReadStreamPrototype",
+      &electron::ElectronURLLoaderFactory::SetFileReadStreamPrototype);
 }
 
 }  // namespace
@@ -58,6 +58,10 @@ class Protocol : public gin::Wrappable<Protocol> {
   ProtocolError RegisterProtocol(ProtocolType type,
                                  const std::string& scheme,
                                  const ProtocolHandler& handler);
+  bool RegisterDirectoryProtocol(gin_helper::ErrorThrower thrower,
+                                 const std::string& scheme,
+                                 const DirectoryRoutes& routes,
+                                 gin::Arguments* args);
   void UnregisterProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolRegistered(const std::string& scheme);
 
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "shell/browser/browser.h"
@@ -17,6 +18,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "ui/display/display.h"
+#include "ui/display/display_finder.h"
 #include "ui/display/screen.h"
 #include "ui/gfx/geometry/point.h"
 
@@ -79,7 +81,17 @@ Screen::~Screen() {
 }
 
 gfx::Point Screen::GetCursorScreenPoint() {
-  return screen_->GetCursorScreenPoint();
+  if (!cursor_screen_point_) {
+    cursor_screen_point_ = screen_->GetCursorScreenPoint();
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&Screen::ClearCursorScreenPoint,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  return *cursor_screen_point_;
+}
+
+void Screen::ClearCursorScreenPoint() {
+  cursor_screen_point_.reset();
 }
 
 display::Display Screen::GetPrimaryDisplay() {
@@ -87,14 +99,35 @@ display::Display Screen::GetPrimaryDisplay() {
 }
 
 std::vector<display::Display> Screen::GetAllDisplays() {
-  return screen_->GetAllDisplays();
+  return GetCachedDisplays();
 }
 
+const std::vector<display::Display>& Screen::GetCachedDisplays() {
+  if (!displays_)
+    displays_ = screen_->GetAllDisplays();
+  return *displays_;
+}
+
+// On Windows the DIP coordinates of displays with different scale factors do
+// not line up, only the screen can tell which one is nearest.
 display::Display Screen::GetDisplayNearestPoint(const gfx::Point& point) {
+#if !defined(OS_WIN)
+  const display::Display* display =
+      display::FindDisplayNearestPoint(GetCachedDisplays(), point);
+  if (display)
+    return *display;
+#endif
   return screen_->GetDisplayNearestPoint(point);
 }
 
 display::Display Screen::GetDisplayMatching(const gfx::Rect& match_rect) {
+#if !defined(OS_WIN)
+  const display::Display* display =
+      display::FindDisplayWithBiggestIntersection(GetCachedDisplays(),
+                                                  match_rect);
+  if (display)
+    return *display;
+#endif
   return screen_->GetDisplayMatching(match_rect);
 }
 
@@ -115,12 +148,14 @@ static gfx::Rect DIPToScreenRect(electron::NativeWindow* window,
 #endif
 
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  displays_.reset();
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
       FROM_HERE, base::Bind(&DelayEmit, base::Unretained(this), "display-added",
                             new_display));
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  displays_.reset();
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
       FROM_HERE, base::Bind(&DelayEmit, base::Unretained(this),
                             "display-removed", old_display));
@@ -128,6 +163,7 @@ void Screen::OnDisplayRemoved(const display::Display& old_display) {
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  displays_.reset();
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
       FROM_HERE, base::Bind(&DelayEmitWithMetrics, base::Unretained(this),
                             "display-metrics-changed", display,
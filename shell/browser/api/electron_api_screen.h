@@ -7,6 +7,8 @@
 
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
 #include "ui/display/display_observer.h"
@@ -47,8 +49,22 @@ class Screen : public gin_helper::EventEmitter<Screen>,
                                uint32_t changed_metrics) override;
 
  private:
+  const std::vector<display::Display>& GetCachedDisplays();
+  void ClearCursorScreenPoint();
+
   display::Screen* screen_;
 
+  // The displays are only queried again once the observer is told they
+  // changed, which on some platforms saves a round trip to the display
+  // server on every call.
+  base::Optional<std::vector<display::Display>> displays_;
+
+  // The cursor position is queried once per task, handlers that ask for it
+  // repeatedly get the same point.
+  base::Optional<gfx::Point> cursor_screen_point_;
+
+  base::WeakPtrFactory<Screen> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(Screen);
 };
 
@@ -4,20 +4,27 @@
 
 #include "shell/browser/api/electron_api_service_worker_context.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "base/guid.h"
+#include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/console_message.h"
+#include "content/public/browser/service_worker_external_request_result.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/blink/public/common/service_worker/service_worker_status_code.h"
 
 namespace electron {
 
@@ -81,6 +88,8 @@ ServiceWorkerContext::ServiceWorkerContext(
 }
 
 ServiceWorkerContext::~ServiceWorkerContext() {
+  for (const auto& it : keep_alives_)
+    service_worker_context_->FinishedExternalRequest(it.second, it.first);
   service_worker_context_->RemoveObserver(this);
 }
 
@@ -133,6 +142,63 @@ v8::Local<v8::Value> ServiceWorkerContext::GetWorkerInfoFromID(
                                         std::move(iter->second));
 }
 
+v8::Local<v8::Promise> ServiceWorkerContext::StartWorkerForScope(
+    v8::Isolate* isolate,
+    const GURL& scope) {
+  gin_helper::Promise<base::DictionaryValue> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Only one of the callbacks is run, they share the promise.
+  auto shared_promise =
+      std::make_shared<gin_helper::Promise<base::DictionaryValue>>(
+          std::move(promise));
+  service_worker_context_->StartWorkerForScope(
+      scope,
+      base::BindOnce(
+          [](std::shared_ptr<gin_helper::Promise<base::DictionaryValue>>
+                 promise,
+             int64_t version_id, int process_id, int thread_id) {
+            base::DictionaryValue dict;
+            dict.SetDoubleKey("versionId", version_id);
+            dict.SetIntKey("renderProcessId", process_id);
+            promise->Resolve(dict);
+          },
+          shared_promise),
+      base::BindOnce(
+          [](std::shared_ptr<gin_helper::Promise<base::DictionaryValue>>
+                 promise,
+             blink::ServiceWorkerStatusCode status) {
+            promise->RejectWithErrorMessage(
+                std::string("Failed to start service worker: ") +
+                blink::ServiceWorkerStatusToString(status));
+          },
+          shared_promise));
+
+  return handle;
+}
+
+std::string ServiceWorkerContext::StartKeepAlive(
+    gin_helper::ErrorThrower thrower,
+    int64_t version_id) {
+  // The worker counts as handling a request until the token is released.
+  std::string token = base::GenerateGUID();
+  if (service_worker_context_->StartingExternalRequest(version_id, token) !=
+      content::ServiceWorkerExternalRequestResult::kOk) {
+    thrower.ThrowError("Could not find service worker with that version_id");
+    return std::string();
+  }
+  keep_alives_[token] = version_id;
+  return token;
+}
+
+void ServiceWorkerContext::StopKeepAlive(const std::string& token) {
+  auto it = keep_alives_.find(token);
+  if (it == keep_alives_.end())
+    return;
+  service_worker_context_->FinishedExternalRequest(it->second, token);
+  keep_alives_.erase(it);
+}
+
 // static
 gin::Handle<ServiceWorkerContext> ServiceWorkerContext::Create(
     v8::Isolate* isolate,
@@ -149,7 +215,11 @@ gin::ObjectTemplateBuilder ServiceWorkerContext::GetObjectTemplateBuilder(
       .SetMethod("getAllRunning",
                  &ServiceWorkerContext::GetAllRunningWorkerInfo)
       .SetMethod("getFromVersionID",
-                 &ServiceWorkerContext::GetWorkerInfoFromID);
+                 &ServiceWorkerContext::GetWorkerInfoFromID)
+      .SetMethod("startWorkerForScope",
+                 &ServiceWorkerContext::StartWorkerForScope)
+      .SetMethod("startKeepAlive", &ServiceWorkerContext::StartKeepAlive)
+      .SetMethod("stopKeepAlive", &ServiceWorkerContext::StopKeepAlive);
 }
 
 const char* ServiceWorkerContext::GetTypeName() {
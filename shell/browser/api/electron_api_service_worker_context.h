@@ -5,11 +5,16 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 #define SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 
+#include <map>
+#include <string>
+
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/service_worker_context_observer.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "url/gurl.h"
 
 namespace electron {
 
@@ -29,6 +34,11 @@ class ServiceWorkerContext
   v8::Local<v8::Value> GetAllRunningWorkerInfo(v8::Isolate* isolate);
   v8::Local<v8::Value> GetWorkerInfoFromID(gin_helper::ErrorThrower thrower,
                                            int64_t version_id);
+  v8::Local<v8::Promise> StartWorkerForScope(v8::Isolate* isolate,
+                                             const GURL& scope);
+  std::string StartKeepAlive(gin_helper::ErrorThrower thrower,
+                             int64_t version_id);
+  void StopKeepAlive(const std::string& token);
 
   // content::ServiceWorkerContextObserver
   void OnReportConsoleMessage(int64_t version_id,
@@ -51,6 +61,9 @@ class ServiceWorkerContext
 
   content::ServiceWorkerContext* service_worker_context_;
 
+  // Keep-alive token => version ID of the worker it keeps running.
+  std::map<std::string, int64_t> keep_alives_;
+
   base::WeakPtrFactory<ServiceWorkerContext> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(ServiceWorkerContext);
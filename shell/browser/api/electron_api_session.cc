@@ -54,7 +54,15 @@
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/download_throttle.h"
+#include "shell/browser/net/network_metrics.h"
+#include "shell/browser/net/preconnect_predictor.h"
+#include "shell/browser/net/shared_asset_cache.h"
+#include "shell/browser/net/url_pattern_matcher.h"
+#include "shell/browser/renderer_process_pool.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
+#include "shell/browser/storage_data_clearer.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -67,6 +75,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
 #include "ui/base/l10n/l10n_util.h"
+#include "url/origin.h"
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 #include "extensions/browser/extension_registry.h"
@@ -109,9 +118,17 @@ PreconnectRequest::PreconnectRequest(
 namespace {
 
 struct ClearStorageDataOptions {
-  GURL origin;
+  std::vector<GURL> origins;
   uint32_t storage_types = StoragePartition::REMOVE_DATA_MASK_ALL;
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
+  base::Time since;
+  bool incremental = false;
+  base::RepeatingCallback<void(int, int)> progress;
+};
+
+struct ClearCacheOptions {
+  std::vector<GURL> origins;
+  base::Time since;
 };
 
 uint32_t GetStorageMask(const std::vector<std::string>& storage_types) {
@@ -166,12 +183,36 @@ struct Converter<ClearStorageDataOptions> {
     gin_helper::Dictionary options;
     if (!ConvertFromV8(isolate, val, &options))
       return false;
-    options.Get("origin", &out->origin);
+    options.Get("origins", &out->origins);
+    GURL origin;
+    if (options.Get("origin", &origin))
+      out->origins.push_back(origin);
     std::vector<std::string> types;
     if (options.Get("storages", &types))
       out->storage_types = GetStorageMask(types);
     if (options.Get("quotas", &types))
       out->quota_types = GetQuotaMask(types);
+    double since;
+    if (options.Get("since", &since))
+      out->since = base::Time::FromDoubleT(since);
+    options.Get("incremental", &out->incremental);
+    options.Get("onProgress", &out->progress);
+    return true;
+  }
+};
+
+template <>
+struct Converter<ClearCacheOptions> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     ClearCacheOptions* out) {
+    gin_helper::Dictionary options;
+    if (!ConvertFromV8(isolate, val, &options))
+      return false;
+    options.Get("origins", &out->origins);
+    double since;
+    if (options.Get("since", &since))
+      out->since = base::Time::FromDoubleT(since);
     return true;
   }
 };
@@ -247,6 +288,15 @@ class DictionaryObserver final : public SpellcheckCustomDictionary::Observer {
 };
 #endif  // BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 
+v8::Local<v8::Value> HistogramToV8(v8::Isolate* isolate,
+                                   const NetworkMetrics::Histogram& histogram) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("count", histogram.count());
+  dict.Set("total", histogram.total().InMillisecondsF());
+  dict.Set("buckets", histogram.buckets());
+  return dict.GetHandle();
+}
+
 }  // namespace
 
 Session::Session(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
@@ -360,20 +410,73 @@ v8::Local<v8::Promise> Session::GetCacheSize() {
   return handle;
 }
 
-v8::Local<v8::Promise> Session::ClearCache() {
-  auto* isolate = v8::Isolate::GetCurrent();
+v8::Local<v8::Promise> Session::ClearCache(gin_helper::Arguments* args) {
+  auto* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
   auto handle = promise.GetHandle();
 
+  ClearCacheOptions options;
+  args->GetNext(&options);
+
+  network::mojom::ClearDataFilterPtr filter;
+  if (!options.origins.empty()) {
+    filter = network::mojom::ClearDataFilter::New();
+    filter->type = network::mojom::ClearDataFilter::Type::DELETE_MATCHES;
+    for (const auto& origin : options.origins)
+      filter->origins.push_back(url::Origin::Create(origin));
+  }
+
   content::BrowserContext::GetDefaultStoragePartition(browser_context_.get())
       ->GetNetworkContext()
-      ->ClearHttpCache(base::Time(), base::Time::Max(), nullptr,
+      ->ClearHttpCache(options.since, base::Time::Max(), std::move(filter),
                        base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
                                       std::move(promise)));
 
   return handle;
 }
 
+v8::Local<v8::Value> Session::GetNetworkMetrics() {
+  gin_helper::Dictionary hosts = gin::Dictionary::CreateEmpty(isolate());
+  for (const auto& it : browser_context()->network_metrics()->hosts()) {
+    const NetworkMetrics::HostMetrics& metrics = it.second;
+    gin_helper::Dictionary host = gin::Dictionary::CreateEmpty(isolate());
+    host.Set("requests", metrics.requests);
+    host.Set("cachedRequests", metrics.cached_requests);
+    host.Set("newSockets", metrics.new_sockets);
+    host.Set("reusedSockets", metrics.reused_sockets);
+    host.Set("dns", HistogramToV8(isolate(), metrics.dns));
+    host.Set("connect", HistogramToV8(isolate(), metrics.connect));
+    host.Set("tls", HistogramToV8(isolate(), metrics.tls));
+    host.Set("ttfb", HistogramToV8(isolate(), metrics.ttfb));
+    hosts.Set(it.first, host);
+  }
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  dict.Set("bucketBoundaries", NetworkMetrics::GetBucketBoundaries());
+  dict.Set("hosts", hosts);
+  return dict.GetHandle();
+}
+
+v8::Local<v8::Value> Session::GetCacheStats() {
+  int requests = 0;
+  int cached_requests = 0;
+  for (const auto& it : browser_context()->network_metrics()->hosts()) {
+    requests += it.second.requests;
+    cached_requests += it.second.cached_requests;
+  }
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  dict.Set("hits", cached_requests);
+  dict.Set("misses", requests - cached_requests);
+  dict.Set("maxSize", browser_context()->GetMaxCacheSize());
+  dict.Set("maxAge", browser_context()->cache_max_age().InSeconds());
+  return dict.GetHandle();
+}
+
+void Session::ClearNetworkMetrics() {
+  browser_context()->network_metrics()->Clear();
+}
+
 v8::Local<v8::Promise> Session::ClearStorageData(gin_helper::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -382,17 +485,26 @@ v8::Local<v8::Promise> Session::ClearStorageData(gin_helper::Arguments* args) {
   ClearStorageDataOptions options;
   args->GetNext(&options);
 
-  auto* storage_partition =
-      content::BrowserContext::GetStoragePartition(browser_context(), nullptr);
   if (options.storage_types & StoragePartition::REMOVE_DATA_MASK_COOKIES) {
     // Reset media device id salt when cookies are cleared.
     // https://w3c.github.io/mediacapture-main/#dom-mediadeviceinfo-deviceid
     MediaDeviceIDSalt::Reset(browser_context()->prefs());
+    // The predictions tell which sites were visited, like cookies do.
+    if (options.origins.empty())
+      browser_context()->preconnect_predictor()->Clear();
+    else
+      browser_context()->preconnect_predictor()->ClearOrigins(options.origins);
   }
 
-  storage_partition->ClearData(
-      options.storage_types, options.quota_types, options.origin, base::Time(),
-      base::Time::Max(),
+  StorageDataClearer::Options clearer_options;
+  clearer_options.origins = std::move(options.origins);
+  clearer_options.storage_types = options.storage_types;
+  clearer_options.quota_types = options.quota_types;
+  clearer_options.since = options.since;
+  clearer_options.incremental = options.incremental;
+  clearer_options.progress = std::move(options.progress);
+  StorageDataClearer::Start(
+      browser_context(), std::move(clearer_options),
       base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
                      std::move(promise)));
   return handle;
@@ -450,6 +562,15 @@ void Session::SetDownloadPath(const base::FilePath& path) {
                                          path);
 }
 
+void Session::SetDownloadBandwidthLimit(int64_t bytes_per_second) {
+  browser_context_->download_throttle()->session_limiter()->SetLimit(
+      bytes_per_second);
+}
+
+int64_t Session::GetDownloadBandwidthLimit() const {
+  return browser_context_->download_throttle()->session_limiter()->GetLimit();
+}
+
 void Session::EnableNetworkEmulation(const gin_helper::Dictionary& options) {
   auto conditions = network::mojom::NetworkConditions::New();
 
@@ -533,9 +654,17 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
     args->ThrowError("Must pass null or function");
     return;
   }
+  int cache_timeout = 0;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Get("cacheTimeout", &cache_timeout) &&
+      cache_timeout < 0) {
+    args->ThrowError("cacheTimeout must not be negative");
+    return;
+  }
   auto* permission_manager = static_cast<ElectronPermissionManager*>(
       browser_context()->GetPermissionControllerDelegate());
-  permission_manager->SetPermissionCheckHandler(handler);
+  permission_manager->SetPermissionCheckHandler(
+      handler, base::TimeDelta::FromMilliseconds(cache_timeout));
 }
 
 v8::Local<v8::Promise> Session::ClearHostResolverCache(
@@ -659,9 +788,52 @@ std::vector<base::FilePath::StringType> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+void Session::SetSpareRendererCount(gin_helper::ErrorThrower thrower,
+                                    int count) {
+  if (count < 0) {
+    thrower.ThrowRangeError("count must not be negative");
+    return;
+  }
+  browser_context()->spare_renderer_pool()->SetSize(count);
+}
+
+int Session::GetSpareRendererCount() const {
+  return static_cast<int>(browser_context()->spare_renderer_pool()->size());
+}
+
+void Session::SetRendererProcessPool(gin_helper::ErrorThrower thrower,
+                                     const gin_helper::Dictionary& options) {
+  auto* pool = browser_context()->renderer_process_pool();
+  int max_processes_per_site = 0;
+  int max_processes = static_cast<int>(pool->max_processes());
+  options.Get("maxProcessesPerSite", &max_processes_per_site);
+  options.Get("maxProcesses", &max_processes);
+  if (max_processes_per_site < 0 || max_processes < 0) {
+    thrower.ThrowRangeError("Process counts must not be negative");
+    return;
+  }
+  pool->SetLimits(max_processes_per_site, max_processes);
+}
+
+v8::Local<v8::Value> Session::GetRendererProcessPool() {
+  auto* pool = browser_context()->renderer_process_pool();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  dict.Set("maxProcessesPerSite",
+           static_cast<int>(pool->max_processes_per_site()));
+  dict.Set("maxProcesses", static_cast<int>(pool->max_processes()));
+  return dict.GetHandle();
+}
+
+v8::Local<v8::Value> Session::GetStoragePath() {
+  if (browser_context()->IsOffTheRecord())
+    return v8::Null(isolate());
+  return gin::ConvertToV8(isolate(), browser_context()->GetPath());
+}
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 v8::Local<v8::Promise> Session::LoadExtension(
-    const base::FilePath& extension_path) {
+    const base::FilePath& extension_path,
+    gin_helper::Arguments* args) {
   gin_helper::Promise<const extensions::Extension*> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
   if (browser_context()->IsOffTheRecord()) {
@@ -670,10 +842,15 @@ v8::Local<v8::Promise> Session::LoadExtension(
     return handle;
   }
 
+  bool lazy_background = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("lazyBackground", &lazy_background);
+
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
   extension_system->LoadExtension(
-      extension_path,
+      extension_path, lazy_background,
       base::BindOnce(
           [](gin_helper::Promise<const extensions::Extension*> promise,
              const extensions::Extension* extension,
@@ -797,6 +974,34 @@ void Session::Preconnect(const gin_helper::Dictionary& options,
                      url, num_sockets_to_preconnect));
 }
 
+void Session::SetSharedCacheURLs(const std::vector<std::string>& urls,
+                                 gin_helper::Arguments* args) {
+  std::set<URLPattern> patterns;
+  for (const std::string& url : urls) {
+    URLPattern pattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS);
+    const URLPattern::ParseResult result = pattern.Parse(url);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      args->ThrowTypeError("Invalid url pattern " + url + ": " +
+                           URLPattern::GetParseResultString(result));
+      return;
+    }
+    patterns.insert(pattern);
+  }
+  browser_context()->set_shared_cache_urls(URLPatternMatcher(patterns));
+}
+
+v8::Local<v8::Promise> Session::ClearSharedCache() {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  SharedAssetCache::Get()->Clear(base::BindOnce(
+      gin_helper::Promise<void>::ResolvePromise, std::move(promise)));
+  return handle;
+}
+
+void Session::ClearPreconnectPredictions() {
+  browser_context()->preconnect_predictor()->Clear();
+}
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 base::Value Session::GetSpellCheckerLanguages() {
   return browser_context_->prefs()
@@ -917,6 +1122,32 @@ gin::Handle<Session> Session::CreateFrom(
   return handle;
 }
 
+// static
+gin::Handle<Session> Session::CloneFrom(v8::Isolate* isolate,
+                                        Session* source,
+                                        const std::string& partition) {
+  scoped_refptr<ElectronBrowserContext> browser_context;
+  bool created = false;
+  if (base::StartsWith(partition, kPersistPrefix,
+                       base::CompareCase::SENSITIVE)) {
+    browser_context = ElectronBrowserContext::Clone(
+        source->browser_context(), partition.substr(8), false, &created);
+  } else {
+    browser_context = ElectronBrowserContext::Clone(
+        source->browser_context(), partition, true, &created);
+  }
+  auto handle = CreateFrom(isolate, browser_context.get());
+  // Only a new session takes the preloads of |source|, an existing one keeps
+  // its own even when it had no wrapper yet.
+  if (created) {
+    SessionPreferences::FromBrowserContext(browser_context.get())
+        ->set_preloads(
+            SessionPreferences::FromBrowserContext(source->browser_context())
+                ->preloads());
+  }
+  return handle;
+}
+
 // static
 gin::Handle<Session> Session::FromPartition(v8::Isolate* isolate,
                                             const std::string& partition,
@@ -946,10 +1177,17 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
+      .SetMethod("getNetworkMetrics", &Session::GetNetworkMetrics)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
+      .SetMethod("clearNetworkMetrics", &Session::ClearNetworkMetrics)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("setDownloadPath", &Session::SetDownloadPath)
+      .SetMethod("setDownloadBandwidthLimit",
+                 &Session::SetDownloadBandwidthLimit)
+      .SetMethod("getDownloadBandwidthLimit",
+                 &Session::GetDownloadBandwidthLimit)
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
       .SetMethod("disableNetworkEmulation", &Session::DisableNetworkEmulation)
       .SetMethod("setCertificateVerifyProc", &Session::SetCertVerifyProc)
@@ -970,6 +1208,11 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::CreateInterruptedDownload)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("setSpareRendererCount", &Session::SetSpareRendererCount)
+      .SetMethod("getSpareRendererCount", &Session::GetSpareRendererCount)
+      .SetMethod("setRendererProcessPool", &Session::SetRendererProcessPool)
+      .SetMethod("getRendererProcessPool", &Session::GetRendererProcessPool)
+      .SetMethod("_getStoragePath", &Session::GetStoragePath)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
       .SetMethod("loadExtension", &Session::LoadExtension)
       .SetMethod("removeExtension", &Session::RemoveExtension)
@@ -991,6 +1234,10 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::RemoveWordFromSpellCheckerDictionary)
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("setSharedCacheURLs", &Session::SetSharedCacheURLs)
+      .SetMethod("clearSharedCache", &Session::ClearSharedCache)
+      .SetMethod("clearPreconnectPredictions",
+                 &Session::ClearPreconnectPredictions)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
@@ -1021,6 +1268,20 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
       .ToV8();
 }
 
+v8::Local<v8::Value> Clone(gin::Handle<Session> source,
+                           const std::string& partition,
+                           gin_helper::Arguments* args) {
+  if (!electron::Browser::Get()->is_ready()) {
+    args->ThrowError("Session can only be received when app is ready");
+    return v8::Null(args->isolate());
+  }
+  if (partition.empty()) {
+    args->ThrowError("The default session can not be a clone");
+    return v8::Null(args->isolate());
+  }
+  return Session::CloneFrom(args->isolate(), source.get(), partition).ToV8();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1031,6 +1292,7 @@ void Initialize(v8::Local<v8::Object> exports,
       "Session",
       Session::GetConstructor(isolate)->GetFunction(context).ToLocalChecked());
   dict.SetMethod("fromPartition", &FromPartition);
+  dict.SetMethod("clone", &Clone);
 }
 
 }  // namespace
@@ -51,6 +51,12 @@ class Session : public gin_helper::TrackableObject<Session>,
       v8::Isolate* isolate,
       ElectronBrowserContext* browser_context);
 
+  // Gets or creates the session of |partition| with the configuration of
+  // |source|.
+  static gin::Handle<Session> CloneFrom(v8::Isolate* isolate,
+                                        Session* source,
+                                        const std::string& partition);
+
   // Gets the Session of |partition|.
   static gin::Handle<Session> FromPartition(
       v8::Isolate* isolate,
@@ -68,11 +74,16 @@ class Session : public gin_helper::TrackableObject<Session>,
   // Methods.
   v8::Local<v8::Promise> ResolveProxy(gin_helper::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
-  v8::Local<v8::Promise> ClearCache();
+  v8::Local<v8::Promise> ClearCache(gin_helper::Arguments* args);
+  v8::Local<v8::Value> GetNetworkMetrics();
+  v8::Local<v8::Value> GetCacheStats();
+  void ClearNetworkMetrics();
   v8::Local<v8::Promise> ClearStorageData(gin_helper::Arguments* args);
   void FlushStorageData();
   v8::Local<v8::Promise> SetProxy(gin_helper::Arguments* args);
   void SetDownloadPath(const base::FilePath& path);
+  void SetDownloadBandwidthLimit(int64_t bytes_per_second);
+  int64_t GetDownloadBandwidthLimit() const;
   void EnableNetworkEmulation(const gin_helper::Dictionary& options);
   void DisableNetworkEmulation();
   void SetCertVerifyProc(v8::Local<v8::Value> proc,
@@ -93,6 +104,12 @@ class Session : public gin_helper::TrackableObject<Session>,
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath::StringType>& preloads);
   std::vector<base::FilePath::StringType> GetPreloads() const;
+  void SetSpareRendererCount(gin_helper::ErrorThrower thrower, int count);
+  int GetSpareRendererCount() const;
+  void SetRendererProcessPool(gin_helper::ErrorThrower thrower,
+                              const gin_helper::Dictionary& options);
+  v8::Local<v8::Value> GetRendererProcessPool();
+  v8::Local<v8::Value> GetStoragePath();
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> ServiceWorkerContext(v8::Isolate* isolate);
@@ -100,6 +117,10 @@ class Session : public gin_helper::TrackableObject<Session>,
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options,
                   gin_helper::Arguments* args);
+  void ClearPreconnectPredictions();
+  void SetSharedCacheURLs(const std::vector<std::string>& urls,
+                          gin_helper::Arguments* args);
+  v8::Local<v8::Promise> ClearSharedCache();
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   base::Value GetSpellCheckerLanguages();
   void SetSpellCheckerLanguages(gin_helper::ErrorThrower thrower,
@@ -110,7 +131,8 @@ class Session : public gin_helper::TrackableObject<Session>,
 #endif
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
-  v8::Local<v8::Promise> LoadExtension(const base::FilePath& extension_path);
+  v8::Local<v8::Promise> LoadExtension(const base::FilePath& extension_path,
+                                       gin_helper::Arguments* args);
   void RemoveExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetAllExtensions();
@@ -46,7 +46,7 @@ class SystemPreferences : public gin_helper::EventEmitter<SystemPreferences>
                              v8::Local<v8::FunctionTemplate> prototype);
 
 #if defined(OS_WIN) || defined(OS_MACOSX)
-  std::string GetAccentColor();
+  static std::string GetAccentColor();
   std::string GetColor(gin_helper::ErrorThrower thrower,
                        const std::string& color);
 #endif
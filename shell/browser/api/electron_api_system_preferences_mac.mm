@@ -393,6 +393,7 @@ void SystemPreferences::SetUserDefault(const std::string& name,
   }
 }
 
+// static
 std::string SystemPreferences::GetAccentColor() {
   NSColor* sysColor = nil;
   if (@available(macOS 10.14, *))
@@ -35,6 +35,7 @@ std::string hexColorDWORDToRGBA(DWORD color) {
   return stream.str();
 }
 
+// static
 std::string SystemPreferences::GetAccentColor() {
   DWORD color = 0;
   BOOL opaque = FALSE;
@@ -14,6 +14,7 @@
 #include "shell/browser/api/electron_api_menu.h"
 #include "shell/browser/api/electron_api_view.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/window_list.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -63,6 +64,10 @@ namespace api {
 
 namespace {
 
+// At 60 frames per second.
+constexpr base::TimeDelta kBoundsEventInterval =
+    base::TimeDelta::FromMicroseconds(16667);
+
 // Converts binary data to Buffer.
 v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate, void* val, int size) {
   auto buffer = node::Buffer::Copy(isolate, static_cast<char*>(val), size);
@@ -82,6 +87,8 @@ TopLevelWindow::TopLevelWindow(v8::Isolate* isolate,
   if (options.Get("parent", &parent) && !parent.IsEmpty())
     parent_window_.Reset(isolate, parent.ToV8());
 
+  options.Get(options::kCoalesceBoundsEvents, &coalesce_bounds_events_);
+
 #if BUILDFLAG(ENABLE_OSR)
   // Offscreen windows are always created frameless.
   gin_helper::Dictionary web_preferences;
@@ -215,7 +222,10 @@ void TopLevelWindow::OnWindowWillResize(const gfx::Rect& new_bounds,
 }
 
 void TopLevelWindow::OnWindowResize() {
-  Emit("resize");
+  if (coalesce_bounds_events_)
+    QueueBoundsEvent(&pending_resize_);
+  else
+    Emit("resize");
 }
 
 void TopLevelWindow::OnWindowWillMove(const gfx::Rect& new_bounds,
@@ -226,7 +236,10 @@ void TopLevelWindow::OnWindowWillMove(const gfx::Rect& new_bounds,
 }
 
 void TopLevelWindow::OnWindowMove() {
-  Emit("move");
+  if (coalesce_bounds_events_)
+    QueueBoundsEvent(&pending_move_);
+  else
+    Emit("move");
 }
 
 void TopLevelWindow::OnWindowMoved() {
@@ -760,6 +773,32 @@ void TopLevelWindow::RemoveBrowserView(v8::Local<v8::Value> value) {
   }
 }
 
+void TopLevelWindow::SetBrowserViewBounds(gin_helper::Arguments* args) {
+  std::vector<gin_helper::Dictionary> layouts;
+  if (!args->GetNext(&layouts)) {
+    args->ThrowError("Expected an array of { view, bounds } objects");
+    return;
+  }
+
+  // Everything is checked first, so that either all the views move or none.
+  std::vector<std::pair<NativeBrowserView*, gfx::Rect>> bounds;
+  for (const gin_helper::Dictionary& layout : layouts) {
+    gin::Handle<BrowserView> browser_view;
+    gfx::Rect rect;
+    if (!layout.Get("view", &browser_view) || !layout.Get("bounds", &rect)) {
+      args->ThrowError("Expected an array of { view, bounds } objects");
+      return;
+    }
+    if (browser_views_.find(browser_view->weak_map_id()) ==
+        browser_views_.end()) {
+      args->ThrowError("The BrowserView is not attached to this window");
+      return;
+    }
+    bounds.emplace_back(browser_view->view(), rect);
+  }
+  window_->SetBrowserViewsBounds(bounds);
+}
+
 std::string TopLevelWindow::GetMediaSourceId() const {
   return window_->GetDesktopMediaID().ToString();
 }
@@ -1056,6 +1095,36 @@ void TopLevelWindow::ResetBrowserViews() {
   browser_views_.clear();
 }
 
+void TopLevelWindow::QueueBoundsEvent(bool* pending) {
+  *pending = true;
+  if (bounds_event_timer_.IsRunning())
+    return;
+
+  // The first event after a quiet frame is emitted right away, the ones that
+  // follow once per frame.
+  base::TimeDelta since_last = base::TimeTicks::Now() - last_bounds_event_;
+  if (since_last >= kBoundsEventInterval) {
+    EmitPendingBoundsEvents();
+    return;
+  }
+  bounds_event_timer_.Start(FROM_HERE, kBoundsEventInterval - since_last,
+                            this, &TopLevelWindow::EmitPendingBoundsEvents);
+}
+
+void TopLevelWindow::EmitPendingBoundsEvents() {
+  last_bounds_event_ = base::TimeTicks::Now();
+  gfx::Rect bounds = window_->GetBounds();
+  bool resized = pending_resize_;
+  bool moved = pending_move_;
+  pending_resize_ = pending_move_ = false;
+  // Emitting can destroy the window.
+  auto weak_this = GetWeakPtr();
+  if (resized)
+    Emit("resize", bounds);
+  if (moved && weak_this)
+    Emit("move", bounds);
+}
+
 void TopLevelWindow::RemoveFromParentChildWindows() {
   if (parent_window_.IsEmpty())
     return;
@@ -1084,6 +1153,7 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(gin::StringToV8(isolate, "TopLevelWindow"));
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("_setListenerCount", &TopLevelWindow::SetListenerCount)
       .SetMethod("setContentView", &TopLevelWindow::SetContentView)
       .SetMethod("close", &TopLevelWindow::Close)
       .SetMethod("focus", &TopLevelWindow::Focus)
@@ -1169,6 +1239,7 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setBrowserView", &TopLevelWindow::SetBrowserView)
       .SetMethod("addBrowserView", &TopLevelWindow::AddBrowserView)
       .SetMethod("removeBrowserView", &TopLevelWindow::RemoveBrowserView)
+      .SetMethod("setBrowserViewBounds", &TopLevelWindow::SetBrowserViewBounds)
       .SetMethod("getMediaSourceId", &TopLevelWindow::GetMediaSourceId)
       .SetMethod("getNativeWindowHandle",
                  &TopLevelWindow::GetNativeWindowHandle)
@@ -1244,6 +1315,16 @@ namespace {
 
 using electron::api::TopLevelWindow;
 
+v8::Local<v8::Value> GetFocusedWindow(v8::Isolate* isolate) {
+  electron::NativeWindow* window = electron::WindowList::GetFocusedWindow();
+  if (window) {
+    auto* focused = TopLevelWindow::FromWrappedClass(isolate, window);
+    if (focused)
+      return focused->GetWrapper();
+  }
+  return v8::Null(isolate);
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1258,6 +1339,7 @@ void Initialize(v8::Local<v8::Object> exports,
                                          .ToLocalChecked());
   constructor.SetMethod("fromId", &TopLevelWindow::FromWeakMapID);
   constructor.SetMethod("getAllWindows", &TopLevelWindow::GetAll);
+  constructor.SetMethod("_getFocusedWindow", &GetFocusedWindow);
 
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("TopLevelWindow", constructor);
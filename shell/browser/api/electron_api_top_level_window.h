@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "base/task/post_task.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "gin/handle.h"
@@ -18,6 +20,7 @@
 #include "shell/browser/native_window_observer.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/trackable_object.h"
+#include "shell/common/key_weak_map.h"
 
 namespace electron {
 
@@ -174,6 +177,7 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
   virtual void SetBrowserView(v8::Local<v8::Value> value);
   virtual void AddBrowserView(v8::Local<v8::Value> value);
   virtual void RemoveBrowserView(v8::Local<v8::Value> value);
+  void SetBrowserViewBounds(gin_helper::Arguments* args);
   virtual std::vector<v8::Local<v8::Value>> GetBrowserViews() const;
   virtual void ResetBrowserViews();
   std::string GetMediaSourceId() const;
@@ -244,6 +248,11 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
   // Remove this window from parent window's |child_windows_|.
   void RemoveFromParentChildWindows();
 
+  // Emits the "move" and "resize" events that happened since the last frame,
+  // with the current bounds.
+  void QueueBoundsEvent(bool* pending);
+  void EmitPendingBoundsEvents();
+
   template <typename... Args>
   void EmitEventSoon(base::StringPiece eventName) {
     base::PostTask(
@@ -265,6 +274,13 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
 
   std::unique_ptr<NativeWindow> window_;
 
+  // Whether "move" and "resize" are coalesced, see QueueBoundsEvent().
+  bool coalesce_bounds_events_ = false;
+  bool pending_move_ = false;
+  bool pending_resize_ = false;
+  base::TimeTicks last_bounds_event_;
+  base::OneShotTimer bounds_event_timer_;
+
   // Reference to JS wrapper to prevent garbage collection.
   v8::Global<v8::Value> self_ref_;
 
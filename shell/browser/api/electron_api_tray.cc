@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "base/bind.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "shell/browser/api/electron_api_menu.h"
 #include "shell/browser/browser.h"
@@ -158,6 +159,7 @@ void Tray::OnDragEnded() {
 }
 
 void Tray::SetImage(v8::Isolate* isolate, gin::Handle<NativeImage> image) {
+  StopAnimation();
 #if defined(OS_WIN)
   tray_icon_->SetImage(image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
 #else
@@ -165,6 +167,61 @@ void Tray::SetImage(v8::Isolate* isolate, gin::Handle<NativeImage> image) {
 #endif
 }
 
+void Tray::StartAnimation(gin_helper::ErrorThrower thrower,
+                          const std::vector<gin::Handle<NativeImage>>& images,
+                          gin_helper::Arguments* args) {
+  if (images.empty()) {
+    thrower.ThrowError("At least one image must be given");
+    return;
+  }
+  int interval = 100;
+  if (args->GetNext(&interval) && interval <= 0) {
+    thrower.ThrowError("'interval' must be a positive number");
+    return;
+  }
+
+  StopAnimation();
+  for (const auto& image : images) {
+#if defined(OS_WIN)
+    animation_images_.emplace_back(args->isolate(), image.ToV8());
+    animation_frames_.push_back(
+        image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
+#else
+    animation_frames_.push_back(image->image());
+#if defined(OS_MACOSX)
+    // The NSImage is cached by the image once created.
+    animation_frames_.back().AsNSImage();
+#endif
+#endif
+  }
+
+  animation_frame_ = 0;
+  ShowNextFrame();
+  if (animation_frames_.size() > 1) {
+    animation_timer_.Start(FROM_HERE,
+                           base::TimeDelta::FromMilliseconds(interval),
+                           base::BindRepeating(&Tray::ShowNextFrame,
+                                               base::Unretained(this)));
+  }
+}
+
+void Tray::StopAnimation() {
+  animation_timer_.Stop();
+  animation_frames_.clear();
+#if defined(OS_WIN)
+  animation_images_.clear();
+#endif
+}
+
+bool Tray::IsAnimating() const {
+  return animation_timer_.IsRunning();
+}
+
+void Tray::ShowNextFrame() {
+  tray_icon_->SetImage(animation_frames_[animation_frame_]);
+  animation_frame_ = (animation_frame_ + 1) % animation_frames_.size();
+}
+
 void Tray::SetPressedImage(v8::Isolate* isolate,
                            gin::Handle<NativeImage> image) {
 #if defined(OS_WIN)
@@ -281,6 +338,9 @@ void Tray::BuildPrototype(v8::Isolate* isolate,
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("setImage", &Tray::SetImage)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
+      .SetMethod("startAnimation", &Tray::StartAnimation)
+      .SetMethod("stopAnimation", &Tray::StopAnimation)
+      .SetMethod("isAnimating", &Tray::IsAnimating)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
       .SetMethod("getTitle", &Tray::GetTitle)
@@ -9,16 +9,14 @@
 #include <string>
 #include <vector>
 
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "shell/browser/ui/tray_icon.h"
 #include "shell/browser/ui/tray_icon_observer.h"
 #include "shell/common/gin_converters/guid_converter.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
-
-namespace gfx {
-class Image;
-}
+#include "ui/gfx/image/image.h"
 
 namespace gin_helper {
 class Dictionary;
@@ -71,6 +69,11 @@ class Tray : public gin_helper::TrackableObject<Tray>, public TrayIconObserver {
   void OnMouseMoved(const gfx::Point& location, int modifiers) override;
 
   void SetImage(v8::Isolate* isolate, gin::Handle<NativeImage> image);
+  void StartAnimation(gin_helper::ErrorThrower thrower,
+                      const std::vector<gin::Handle<NativeImage>>& images,
+                      gin_helper::Arguments* args);
+  void StopAnimation();
+  bool IsAnimating() const;
   void SetPressedImage(v8::Isolate* isolate, gin::Handle<NativeImage> image);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title);
@@ -88,9 +91,23 @@ class Tray : public gin_helper::TrackableObject<Tray>, public TrayIconObserver {
   gfx::Rect GetBounds();
 
  private:
+  void ShowNextFrame();
+
   v8::Global<v8::Value> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
 
+  // The frames of the animation, converted once when it starts so that
+  // showing each frame does not touch the image data again.
+#if defined(OS_WIN)
+  // The HICONs are owned by the images.
+  std::vector<v8::Global<v8::Value>> animation_images_;
+  std::vector<HICON> animation_frames_;
+#else
+  std::vector<gfx::Image> animation_frames_;
+#endif
+  size_t animation_frame_ = 0;
+  base::RepeatingTimer animation_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Tray);
 };
 
@@ -18,13 +18,16 @@
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "net/base/load_flags.h"
+#include "net/http/http_response_info.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -45,6 +48,32 @@ struct Converter<network::mojom::HttpRawHeaderPairPtr> {
   }
 };
 
+template <>
+struct Converter<net::RequestPriority> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     net::RequestPriority* out) {
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "throttled")
+      *out = net::THROTTLED;
+    else if (priority == "idle")
+      *out = net::IDLE;
+    else if (priority == "lowest")
+      *out = net::LOWEST;
+    else if (priority == "low")
+      *out = net::LOW;
+    else if (priority == "medium")
+      *out = net::MEDIUM;
+    else if (priority == "highest")
+      *out = net::HIGHEST;
+    else
+      return false;
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
@@ -247,13 +276,93 @@ base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
 
 }  // namespace
 
+gin::WrapperInfo SimpleURLLoaderPool::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+SimpleURLLoaderPool::SimpleURLLoaderPool(int max_concurrent_requests)
+    : max_concurrent_requests_(max_concurrent_requests) {}
+
+SimpleURLLoaderPool::~SimpleURLLoaderPool() = default;
+
+// static
+gin::Handle<SimpleURLLoaderPool> SimpleURLLoaderPool::Create(
+    gin::Arguments* args) {
+  int max_concurrent_requests = 6;
+  args->GetNext(&max_concurrent_requests);
+  return gin::CreateHandle(
+      args->isolate(),
+      new SimpleURLLoaderPool(std::max(max_concurrent_requests, 1)));
+}
+
+void SimpleURLLoaderPool::Schedule(SimpleURLLoaderWrapper* loader,
+                                   net::RequestPriority priority) {
+  pending_.emplace(priority, loader);
+  StartPending();
+}
+
+void SimpleURLLoaderPool::Remove(SimpleURLLoaderWrapper* loader) {
+  if (!active_.erase(loader)) {
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+      if (it->second == loader) {
+        pending_.erase(it);
+        break;
+      }
+    }
+  }
+  StartPending();
+}
+
+void SimpleURLLoaderPool::StartPending() {
+  while (!pending_.empty() &&
+         static_cast<int>(active_.size()) < max_concurrent_requests_) {
+    SimpleURLLoaderWrapper* loader = pending_.begin()->second;
+    pending_.erase(pending_.begin());
+    active_.insert(loader);
+    loader->Start();
+  }
+}
+
+int SimpleURLLoaderPool::GetMaxConcurrentRequests() const {
+  return max_concurrent_requests_;
+}
+
+// The limit is validated by net.RequestPool.
+void SimpleURLLoaderPool::SetMaxConcurrentRequests(int max) {
+  max_concurrent_requests_ = std::max(max, 1);
+  StartPending();
+}
+
+int SimpleURLLoaderPool::GetActiveRequestCount() const {
+  return static_cast<int>(active_.size());
+}
+
+int SimpleURLLoaderPool::GetPendingRequestCount() const {
+  return static_cast<int>(pending_.size());
+}
+
+gin::ObjectTemplateBuilder SimpleURLLoaderPool::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SimpleURLLoaderPool>::GetObjectTemplateBuilder(isolate)
+      .SetProperty("maxConcurrentRequests",
+                   &SimpleURLLoaderPool::GetMaxConcurrentRequests,
+                   &SimpleURLLoaderPool::SetMaxConcurrentRequests)
+      .SetProperty("activeRequestCount",
+                   &SimpleURLLoaderPool::GetActiveRequestCount)
+      .SetProperty("pendingRequestCount",
+                   &SimpleURLLoaderPool::GetPendingRequestCount);
+}
+
+const char* SimpleURLLoaderPool::GetTypeName() {
+  return "SimpleURLLoaderPool";
+}
+
 gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
-    network::mojom::URLLoaderFactory* url_loader_factory)
-    : id_(GetAllRequests().Add(this)) {
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    : id_(GetAllRequests().Add(this)),
+      url_loader_factory_(std::move(url_loader_factory)) {
   // We slightly abuse the |render_frame_id| field in ResourceRequest so that
   // we can correlate any authentication events that arrive with this request.
   request->render_frame_id = id_;
@@ -277,8 +386,20 @@ SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
       &SimpleURLLoaderWrapper::OnUploadProgress, base::Unretained(this)));
   loader_->SetOnDownloadProgressCallback(base::BindRepeating(
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
+}
 
-  loader_->DownloadAsStream(url_loader_factory, this);
+void SimpleURLLoaderWrapper::Start() {
+  if (!loader_)
+    return;
+  if (save_path_.empty()) {
+    loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  } else {
+    loader_->DownloadToFile(
+        url_loader_factory_.get(),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        save_path_);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -292,7 +413,23 @@ void SimpleURLLoaderWrapper::PinBodyGetter(v8::Local<v8::Value> body_getter) {
   pinned_chunk_pipe_getter_.Reset(v8::Isolate::GetCurrent(), body_getter);
 }
 
+void SimpleURLLoaderWrapper::SetPool(gin::Handle<SimpleURLLoaderPool> pool) {
+  pool_ = pool.get();
+  pinned_pool_.Reset(v8::Isolate::GetCurrent(), pool.ToV8());
+}
+
+void SimpleURLLoaderWrapper::ReleasePool() {
+  if (!pool_)
+    return;
+  // Removing the request can start others, forget the pool first.
+  SimpleURLLoaderPool* pool = pool_;
+  pool_ = nullptr;
+  pool->Remove(this);
+  pinned_pool_.Reset();
+}
+
 SimpleURLLoaderWrapper::~SimpleURLLoaderWrapper() {
+  ReleasePool();
   GetAllRequests().Remove(id_);
 }
 
@@ -334,6 +471,7 @@ void SimpleURLLoaderWrapper::OnAuthRequired(
 
 void SimpleURLLoaderWrapper::Cancel() {
   loader_.reset();
+  ReleasePool();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
   // This ensures that no further callbacks will be called, so there's no need
@@ -352,6 +490,11 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
   request->attach_same_site_cookies = true;
   opts.Get("method", &request->method);
   opts.Get("url", &request->url);
+  opts.Get("priority", &request->priority);
+  base::FilePath save_path;
+  opts.Get("savePath", &save_path);
+  int chunk_size = 0;
+  opts.Get("chunkSize", &chunk_size);
   std::map<std::string, std::string> extra_headers;
   if (opts.Get("extraHeaders", &extra_headers)) {
     for (const auto& it : extra_headers) {
@@ -408,13 +551,24 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 
   auto url_loader_factory = session->browser_context()->GetURLLoaderFactory();
 
+  net::RequestPriority priority = request->priority;
   auto ret = gin::CreateHandle(
       args->isolate(),
-      new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get()));
+      new SimpleURLLoaderWrapper(std::move(request), url_loader_factory));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
   }
+  ret->save_path_ = save_path;
+  ret->chunk_size_ = std::max(chunk_size, 0);
+
+  gin::Handle<SimpleURLLoaderPool> pool;
+  if (opts.Get("pool", &pool)) {
+    ret->SetPool(pool);
+    pool->Schedule(ret.get(), priority);
+  } else {
+    ret->Start();
+  }
   return ret;
 }
 
@@ -423,20 +577,66 @@ void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
-  auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
-  auto backing_store = array_buffer->GetBackingStore();
-  memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
-  Emit("data", array_buffer);
+  if (!chunk_size_) {
+    auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
+    auto backing_store = array_buffer->GetBackingStore();
+    memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
+    Emit("data", array_buffer);
+    std::move(resume).Run();
+    return;
+  }
+
+  // The data is copied straight into the memory of the chunks, which are
+  // handed to JS without another copy once they are full.
+  base::WeakPtr<SimpleURLLoaderWrapper> weak_this = weak_factory_.GetWeakPtr();
+  while (!string_piece.empty()) {
+    if (!chunk_)
+      chunk_ = v8::ArrayBuffer::NewBackingStore(isolate, chunk_size_);
+    size_t length =
+        std::min(string_piece.size(), chunk_size_ - chunk_length_);
+    memcpy(static_cast<char*>(chunk_->Data()) + chunk_length_,
+           string_piece.data(), length);
+    chunk_length_ += length;
+    string_piece.remove_prefix(length);
+    if (chunk_length_ == chunk_size_) {
+      chunk_length_ = 0;
+      Emit("data", v8::ArrayBuffer::New(isolate, std::move(chunk_)));
+      // A data handler can cancel the request.
+      if (!weak_this || !loader_)
+        return;
+    }
+  }
   std::move(resume).Run();
 }
 
+void SimpleURLLoaderWrapper::FlushChunk() {
+  if (!chunk_length_)
+    return;
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  auto array_buffer = v8::ArrayBuffer::New(isolate, chunk_length_);
+  memcpy(array_buffer->GetBackingStore()->Data(), chunk_->Data(),
+         chunk_length_);
+  chunk_.reset();
+  chunk_length_ = 0;
+  Emit("data", array_buffer);
+}
+
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  OnComplete(!path.empty());
+}
+
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
+  FlushChunk();
+  if (!loader_)
+    return;
   if (success) {
     Emit("complete");
   } else {
     Emit("error", net::ErrorToString(loader_->NetError()));
   }
   loader_.reset();
+  ReleasePool();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
 }
@@ -452,6 +652,9 @@ void SimpleURLLoaderWrapper::OnResponseStarted(
   dict.Set("statusCode", response_head.headers->response_code());
   dict.Set("statusMessage", response_head.headers->GetStatusText());
   dict.Set("httpVersion", response_head.headers->GetHttpVersion());
+  dict.Set("protocol", net::HttpResponseInfo::ConnectionInfoToString(
+                           response_head.connection_info));
+  dict.Set("socketReused", response_head.load_timing.socket_reused);
   // Note that |response_head.headers| are filtered by Chromium and should not
   // be used here.
   DCHECK(response_head.raw_request_response_info);
@@ -5,13 +5,20 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_URL_LOADER_H_
 #define SHELL_BROWSER_API_ELECTRON_API_URL_LOADER_H_
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "gin/wrappable.h"
 #include "net/base/auth.h"
+#include "net/base/request_priority.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom-forward.h"
@@ -27,6 +34,7 @@ class Handle;
 }  // namespace gin
 
 namespace network {
+class SharedURLLoaderFactory;
 class SimpleURLLoader;
 struct ResourceRequest;
 }  // namespace network
@@ -35,6 +43,49 @@ namespace electron {
 
 namespace api {
 
+class SimpleURLLoaderWrapper;
+
+/** Limits how many of the requests made through it run at once, the others
+ * wait in priority order. */
+class SimpleURLLoaderPool : public gin::Wrappable<SimpleURLLoaderPool> {
+ public:
+  static gin::Handle<SimpleURLLoaderPool> Create(gin::Arguments* args);
+
+  // Starts |loader| once fewer than the maximum number of requests of the
+  // pool are running.
+  void Schedule(SimpleURLLoaderWrapper* loader, net::RequestPriority priority);
+  // Called when a request of the pool completes or is cancelled.
+  void Remove(SimpleURLLoaderWrapper* loader);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  explicit SimpleURLLoaderPool(int max_concurrent_requests);
+  ~SimpleURLLoaderPool() override;
+
+  void StartPending();
+
+  int GetMaxConcurrentRequests() const;
+  void SetMaxConcurrentRequests(int max);
+  int GetActiveRequestCount() const;
+  int GetPendingRequestCount() const;
+
+  int max_concurrent_requests_;
+  std::set<SimpleURLLoaderWrapper*> active_;
+  // Highest priority first, and in the order they were scheduled for the
+  // same priority.
+  std::multimap<net::RequestPriority,
+                SimpleURLLoaderWrapper*,
+                std::greater<net::RequestPriority>>
+      pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleURLLoaderPool);
+};
+
 /** Wraps a SimpleURLLoader to make it usable from JavaScript */
 class SimpleURLLoaderWrapper
     : public gin::Wrappable<SimpleURLLoaderWrapper>,
@@ -56,6 +107,10 @@ class SimpleURLLoaderWrapper
 
   void Cancel();
 
+  // Starts the request, it is called by the pool of the request when it has
+  // one.
+  void Start();
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -63,8 +118,9 @@ class SimpleURLLoaderWrapper
   const char* GetTypeName() override;
 
  private:
-  SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> loader,
-                         network::mojom::URLLoaderFactory* url_loader_factory);
+  SimpleURLLoaderWrapper(
+      std::unique_ptr<network::ResourceRequest> loader,
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -72,6 +128,10 @@ class SimpleURLLoaderWrapper
   void OnComplete(bool success) override;
   void OnRetry(base::OnceClosure start_retry) override;
 
+  void OnDownloadedToFile(base::FilePath path);
+  // Emits the data received since the last full chunk.
+  void FlushChunk();
+
   // SimpleURLLoader callbacks
   void OnResponseStarted(const GURL& final_url,
                          const network::mojom::URLResponseHead& response_head);
@@ -81,14 +141,26 @@ class SimpleURLLoaderWrapper
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
 
-  void Start();
   void Pin();
   void PinBodyGetter(v8::Local<v8::Value>);
+  void SetPool(gin::Handle<SimpleURLLoaderPool> pool);
+  void ReleasePool();
 
   uint32_t id_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
+  // When set, the body is written to this file instead of being emitted.
+  base::FilePath save_path_;
+  // When set, the body is emitted in chunks of this size, which are filled
+  // in |chunk_| as the data is received.
+  size_t chunk_size_ = 0;
+  std::unique_ptr<v8::BackingStore> chunk_;
+  size_t chunk_length_ = 0;
+  // The pool is kept alive while the request is queued or running in it.
+  SimpleURLLoaderPool* pool_ = nullptr;
+  v8::Global<v8::Value> pinned_pool_;
 
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
 };
@@ -0,0 +1,201 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_utility_process.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/process/process.h"
+#include "content/public/browser/child_process_data.h"
+#include "content/public/browser/child_process_termination_info.h"
+#include "content/public/browser/service_process_host.h"
+#include "content/public/common/result_codes.h"
+#include "gin/handle.h"
+#include "services/service_manager/sandbox/sandbox_type.h"
+#include "shell/browser/api/message_port.h"
+#include "shell/browser/browser.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/node_includes.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#endif
+
+namespace electron {
+
+namespace api {
+
+gin::WrapperInfo UtilityProcess::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+UtilityProcess::UtilityProcess(mojo::Remote<mojom::NodeService> service)
+    : service_(std::move(service)) {
+  service_.set_disconnect_handler(base::BindOnce(
+      &UtilityProcess::OnDisconnect, base::Unretained(this)));
+  content::BrowserChildProcessObserver::Add(this);
+}
+
+UtilityProcess::~UtilityProcess() {
+  content::BrowserChildProcessObserver::Remove(this);
+}
+
+// static
+gin::Handle<UtilityProcess> UtilityProcess::Create(
+    gin_helper::ErrorThrower thrower,
+    gin::Arguments* args) {
+  CHECK(Browser::Get()->is_ready());
+  gin_helper::Dictionary options;
+  base::FilePath script;
+  if (!args->GetNext(&options) || !options.Get("modulePath", &script)) {
+    thrower.ThrowTypeError("Invalid utility process options");
+    return gin::Handle<UtilityProcess>();
+  }
+  gin::Handle<MessagePort> port;
+  if (!options.Get("port", &port) || !port->IsEntangled()) {
+    thrower.ThrowError("The port of the utility process is not usable");
+    return gin::Handle<UtilityProcess>();
+  }
+
+  auto params = mojom::NodeServiceParams::New();
+  params->script = script;
+  options.Get("args", &params->args);
+  std::string source;
+  if (options.Get("source", &source))
+    params->source = std::move(source);
+  params->port = port->Disentangle().ReleaseHandle();
+
+  std::string service_name = "Node Utility Process";
+  options.Get("serviceName", &service_name);
+  bool sandbox = false;
+  options.Get("sandbox", &sandbox);
+
+  // Sandboxed utility processes are forked from the zygote on Linux, so that
+  // they start without loading the binary again.
+  mojo::Remote<mojom::NodeService> service;
+  content::ServiceProcessHost::Launch(
+      service.BindNewPipeAndPassReceiver(),
+      content::ServiceProcessHost::Options()
+          .WithDisplayName(service_name)
+          .WithSandboxType(sandbox ? service_manager::SandboxType::kUtility
+                                   : service_manager::SandboxType::kNoSandbox)
+          .Pass());
+
+  auto* utility_process = new UtilityProcess(std::move(service));
+  utility_process->service_->Initialize(
+      std::move(params), base::BindOnce(&UtilityProcess::OnInitialized,
+                                        base::Unretained(utility_process)));
+
+  v8::Isolate* isolate = args->isolate();
+  auto handle = gin::CreateHandle(isolate, utility_process);
+  utility_process->Pin(isolate);
+  return handle;
+}
+
+void UtilityProcess::OnInitialized(uint32_t pid) {
+  if (exited_)
+    return;
+  pid_ = static_cast<base::ProcessId>(pid);
+  Emit("spawn");
+}
+
+void UtilityProcess::OnDisconnect() {
+  service_.reset();
+  // Once the process is known, "exit" waits for the process itself to be
+  // gone, which is when its exit code is known too.
+  if (pid_ == base::kNullProcessId)
+    OnExit(content::RESULT_CODE_KILLED);
+}
+
+void UtilityProcess::OnExit(int exit_code) {
+  if (exited_)
+    return;
+  exited_ = true;
+  service_.reset();
+  pid_ = base::kNullProcessId;
+  Emit("exit", exit_code);
+  Unpin();
+}
+
+void UtilityProcess::BrowserChildProcessHostDisconnected(
+    const content::ChildProcessData& data) {
+  if (pid_ != base::kNullProcessId &&
+      base::GetProcId(data.GetProcess().Handle()) == pid_)
+    OnExit(0);
+}
+
+void UtilityProcess::BrowserChildProcessCrashed(
+    const content::ChildProcessData& data,
+    const content::ChildProcessTerminationInfo& info) {
+  if (pid_ != base::kNullProcessId &&
+      base::GetProcId(data.GetProcess().Handle()) == pid_)
+    OnExit(info.exit_code);
+}
+
+void UtilityProcess::BrowserChildProcessKilled(
+    const content::ChildProcessData& data,
+    const content::ChildProcessTerminationInfo& info) {
+  if (pid_ != base::kNullProcessId &&
+      base::GetProcId(data.GetProcess().Handle()) == pid_)
+    OnExit(info.exit_code);
+}
+
+bool UtilityProcess::Kill() {
+  if (exited_)
+    return false;
+  // Until the process has answered it may not even be launched, dropping the
+  // connection has it terminated by the ServiceProcessHost.
+  if (pid_ == base::kNullProcessId) {
+    OnExit(content::RESULT_CODE_KILLED);
+    return true;
+  }
+  // The script may be busy and never look at its connection, so terminate
+  // the process itself. "exit" is emitted once it is gone.
+#if defined(OS_WIN)
+  base::Process process = base::Process::OpenWithAccess(
+      pid_, PROCESS_TERMINATE | PROCESS_QUERY_INFORMATION | SYNCHRONIZE);
+#else
+  base::Process process = base::Process::Open(pid_);
+#endif
+  if (!process.IsValid() ||
+      !process.Terminate(content::RESULT_CODE_KILLED, false)) {
+    OnExit(content::RESULT_CODE_KILLED);
+  }
+  return true;
+}
+
+gin::ObjectTemplateBuilder UtilityProcess::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin_helper::EventEmitterMixin<
+             UtilityProcess>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("kill", &UtilityProcess::Kill)
+      .SetProperty("pid", &UtilityProcess::GetPID);
+}
+
+const char* UtilityProcess::GetTypeName() {
+  return "UtilityProcess";
+}
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace {
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("createUtilityProcess",
+                 &electron::api::UtilityProcess::Create);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_browser_utility_process, Initialize)
@@ -0,0 +1,76 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_ELECTRON_API_UTILITY_PROCESS_H_
+#define SHELL_BROWSER_API_ELECTRON_API_UTILITY_PROCESS_H_
+
+#include "base/process/process_handle.h"
+#include "content/public/browser/browser_child_process_observer.h"
+#include "electron/shell/common/api/node_service.mojom.h"
+#include "gin/arguments.h"
+#include "gin/handle.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/pinnable.h"
+
+namespace gin_helper {
+class ErrorThrower;
+}  // namespace gin_helper
+
+namespace electron {
+
+namespace api {
+
+// A utility process running a Node.js script, connected to the main process
+// by a MessagePort. The process is kept alive by the main process until it
+// exits or is killed, and emits "spawn" once it is connected, before its
+// script runs, and "exit" once the process is gone.
+class UtilityProcess : public gin::Wrappable<UtilityProcess>,
+                       public gin_helper::EventEmitterMixin<UtilityProcess>,
+                       public gin_helper::Pinnable<UtilityProcess>,
+                       public content::BrowserChildProcessObserver {
+ public:
+  static gin::Handle<UtilityProcess> Create(gin_helper::ErrorThrower thrower,
+                                            gin::Arguments* args);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  explicit UtilityProcess(mojo::Remote<mojom::NodeService> service);
+  ~UtilityProcess() override;
+
+  void OnInitialized(uint32_t pid);
+  void OnDisconnect();
+  void OnExit(int exit_code);
+
+  // content::BrowserChildProcessObserver:
+  void BrowserChildProcessHostDisconnected(
+      const content::ChildProcessData& data) override;
+  void BrowserChildProcessCrashed(
+      const content::ChildProcessData& data,
+      const content::ChildProcessTerminationInfo& info) override;
+  void BrowserChildProcessKilled(
+      const content::ChildProcessData& data,
+      const content::ChildProcessTerminationInfo& info) override;
+
+  bool Kill();
+  base::ProcessId GetPID() const { return pid_; }
+
+  mojo::Remote<mojom::NodeService> service_;
+  base::ProcessId pid_ = base::kNullProcessId;
+  bool exited_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(UtilityProcess);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_ELECTRON_API_UTILITY_PROCESS_H_
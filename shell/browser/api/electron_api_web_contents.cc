@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <set>
@@ -12,10 +13,17 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback_helpers.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/message_loop/message_loop_current.h"
 #include "base/no_destructor.h"
+#include "base/numerics/ranges.h"
 #include "base/optional.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -52,8 +60,14 @@
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
 #include "ppapi/buildflags/buildflags.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
 #include "shell/browser/api/electron_api_session.h"
@@ -66,9 +80,13 @@
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_javascript_dialog_manager.h"
 #include "shell/browser/electron_navigation_throttle.h"
+#include "shell/browser/foreground_process_pin.h"
 #include "shell/browser/lib/bluetooth_chooser.h"
 #include "shell/browser/native_window.h"
+#include "shell/browser/net/network_metrics.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/system_snapshot_publisher.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/ui/inspectable_web_contents_view.h"
@@ -76,8 +94,11 @@
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/web_contents_zoom_controller.h"
 #include "shell/browser/web_view_guest_delegate.h"
+#include "shell/browser/worker_ipc_router.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/color_util.h"
+#include "shell/common/cpu_profiler.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
@@ -89,9 +110,13 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/heap_snapshot.h"
+#include "shell/common/ipc_metrics.h"
 #include "shell/common/mouse_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/shared_memory_buffer.h"
+#include "shell/common/skia_util.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
@@ -99,15 +124,18 @@
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/mojom/frame/find_in_page.mojom.h"
 #include "third_party/blink/public/mojom/frame/fullscreen.mojom.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
 #include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
 #include "ui/base/cursor/cursor.h"
 #include "ui/base/mojom/cursor_type.mojom-shared.h"
 #include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
+#include "url/origin.h"
 
 #if BUILDFLAG(ENABLE_OSR)
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 #include "shell/browser/osr/osr_web_contents_view.h"
+#include "ui/gfx/skbitmap_operations.h"
 #endif
 
 #if !defined(OS_MACOSX)
@@ -335,6 +363,49 @@ void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
   promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+std::vector<unsigned char> EncodeCapture(const std::string& format,
+                                         int quality,
+                                         const SkBitmap& bitmap) {
+  if (format == "png")
+    return electron::util::EncodePNG(bitmap);
+  if (format == "jpeg")
+    return electron::util::EncodeJPEG(bitmap, quality);
+  if (format == "webp")
+    return electron::util::EncodeWebP(bitmap, quality);
+  // "bitmap", the raw pixels.
+  std::vector<unsigned char> pixels(bitmap.computeByteSize());
+  if (!pixels.empty())
+    bitmap.readPixels(bitmap.info(), pixels.data(), bitmap.rowBytes(), 0, 0);
+  return pixels;
+}
+
+void OnCaptureEncoded(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                      std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (data.empty()) {
+    promise.Resolve(node::Buffer::New(isolate, 0).ToLocalChecked());
+    return;
+  }
+  promise.Resolve(node::Buffer::Copy(isolate,
+                                     reinterpret_cast<const char*>(data.data()),
+                                     data.size())
+                      .ToLocalChecked());
+}
+
+// Called when CapturePageToBuffer is done, the capture is encoded on the
+// thread pool.
+void OnCapturePageEncode(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                         const std::string& format,
+                         int quality,
+                         const SkBitmap& bitmap) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodeCapture, format, quality, bitmap),
+      base::BindOnce(&OnCaptureEncoded, std::move(promise)));
+}
+
 base::Optional<base::TimeDelta> GetCursorBlinkInterval() {
 #if defined(OS_MACOSX)
   base::TimeDelta interval;
@@ -385,6 +456,78 @@ base::string16 GetDefaultPrinterAsync() {
 }
 #endif
 
+// Emits the progress of a heap snapshot taken by the renderer.
+class HeapSnapshotProgressObserver : public mojom::HeapSnapshotObserver {
+ public:
+  explicit HeapSnapshotProgressObserver(base::WeakPtr<WebContents> web_contents)
+      : web_contents_(std::move(web_contents)) {}
+
+  // mojom::HeapSnapshotObserver
+  void OnProgress(uint32_t done, uint32_t total) override {
+    if (web_contents_)
+      web_contents_->Emit("heap-snapshot-progress", done, total);
+  }
+
+ private:
+  base::WeakPtr<WebContents> web_contents_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotProgressObserver);
+};
+
+const net::NetworkTrafficAnnotationTag kPrefetchTrafficAnnotation =
+    net::DefineNetworkTrafficAnnotation("electron_web_contents_prefetch", R"(
+        semantics {
+          sender: "Electron WebContents prefetch"
+          description:
+            "Fetches a resource the page is likely to navigate to into the "
+            "HTTP cache of its session."
+          trigger: "Using webContents.prefetch()"
+          data: "None."
+          destination: OTHER
+        }
+        policy {
+          cookies_allowed: YES
+          cookies_store: "user"
+          setting: "This feature cannot be disabled."
+        })");
+
+// Reads the response of a prefetch so that it is stored in the cache,
+// without keeping it in memory. Deletes itself once done.
+class PrefetchStreamConsumer : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  PrefetchStreamConsumer(std::unique_ptr<network::SimpleURLLoader> loader,
+                         gin_helper::Promise<void> promise)
+      : loader_(std::move(loader)), promise_(std::move(promise)) {}
+
+  void Start(network::mojom::URLLoaderFactory* factory) {
+    loader_->DownloadAsStream(factory, this);
+  }
+
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    std::move(resume).Run();
+  }
+
+  void OnComplete(bool success) override {
+    if (success)
+      promise_.Resolve();
+    else
+      promise_.RejectWithErrorMessage(net::ErrorToString(loader_->NetError()));
+    delete this;
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override {
+    std::move(start_retry).Run();
+  }
+
+ private:
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  gin_helper::Promise<void> promise_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrefetchStreamConsumer);
+};
+
 }  // namespace
 
 WebContents::WebContents(v8::Isolate* isolate,
@@ -475,8 +618,9 @@ WebContents::WebContents(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_OSR)
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
-          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+          false, false,
+          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+          OnTexturePaintCallback());
       params.view = view;
       params.delegate_view = view;
 
@@ -490,11 +634,25 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else if (IsOffScreen()) {
     bool transparent = false;
     options.Get("transparent", &transparent);
+    options.Get(options::kOffscreenOnlyDirty, &paint_only_dirty_);
+    bool external_begin_frames = false;
+    options.Get(options::kOffscreenExternalBeginFrames, &external_begin_frames);
+    bool shared_begin_frames = false;
+    options.Get(options::kOffscreenSharedBeginFrames, &shared_begin_frames);
+
+    OnTexturePaintCallback texture_callback;
+    bool use_shared_texture = false;
+    if (options.Get(options::kOffscreenSharedTexture, &use_shared_texture) &&
+        use_shared_texture) {
+      texture_callback = base::BindRepeating(&WebContents::OnTexturePaint,
+                                             base::Unretained(this));
+    }
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
-        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+        transparent, external_begin_frames, shared_begin_frames,
+        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+        texture_callback);
     params.view = view;
     params.delegate_view = view;
 
@@ -918,6 +1076,10 @@ void WebContents::RenderViewCreated(content::RenderViewHost* render_view_host) {
 
 void WebContents::RenderFrameCreated(
     content::RenderFrameHost* render_frame_host) {
+  // The page got a new renderer since it was discarded.
+  if (!render_frame_host->GetParent())
+    discarded_ = false;
+
   auto* rwhv = render_frame_host->GetView();
   if (!rwhv)
     return;
@@ -926,6 +1088,22 @@ void WebContents::RenderFrameCreated(
       static_cast<content::RenderWidgetHostImpl*>(rwhv->GetRenderWidgetHost());
   if (rwh_impl)
     rwh_impl->disable_hidden_ = !background_throttling_;
+
+  if (network_conditions_)
+    ApplyNetworkConditions(render_frame_host);
+}
+
+void WebContents::FrameDeleted(content::RenderFrameHost* render_frame_host) {
+  // The DevTools token is the one of the frame rather than of its host, the
+  // host a cross-process navigation replaces shares it with the new one. So
+  // the throttling is only dropped along with the frame.
+  if (network_conditions_) {
+    render_frame_host->GetProcess()
+        ->GetStoragePartition()
+        ->GetNetworkContext()
+        ->SetNetworkConditions(render_frame_host->GetDevToolsFrameToken(),
+                               nullptr);
+  }
 }
 
 void WebContents::RenderViewHostChanged(content::RenderViewHost* old_host,
@@ -954,9 +1132,61 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 }
 
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
+  frozen_ = false;
+  // A discarded renderer is shut down on purpose.
+  if (discarded_)
+    return;
   Emit("crashed", status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 }
 
+void WebContents::OnVisibilityChanged(content::Visibility visibility) {
+  // Occluded pages are still shown and can be uncovered at any time, only
+  // hidden ones are frozen and discarded.
+  if (visibility == content::Visibility::HIDDEN) {
+    ScheduleLifecycleChanges();
+    return;
+  }
+
+  freeze_timer_.Stop();
+  discard_timer_.Stop();
+  if (frozen_)
+    SetFrozen(false);
+  if (discarded_) {
+    discarded_ = false;
+    web_contents()->GetController().LoadIfNecessary();
+    Emit("restored");
+  }
+}
+
+void WebContents::ScheduleLifecycleChanges() {
+  if (web_contents()->GetVisibility() != content::Visibility::HIDDEN)
+    return;
+  if (!freeze_delay_.is_zero() && !frozen_ && !discarded_) {
+    freeze_timer_.Start(FROM_HERE, freeze_delay_,
+                        base::BindOnce(&WebContents::SetFrozen,
+                                       base::Unretained(this), true));
+  }
+  if (!discard_delay_.is_zero() && !discarded_) {
+    discard_timer_.Start(FROM_HERE, discard_delay_,
+                         base::BindOnce(&WebContents::OnDiscardTimer,
+                                        base::Unretained(this)));
+  }
+}
+
+void WebContents::SetFrozen(bool frozen) {
+  // Only hidden pages can be frozen.
+  if (frozen &&
+      web_contents()->GetVisibility() != content::Visibility::HIDDEN)
+    return;
+  frozen_ = frozen;
+  web_contents()->SetPageFrozen(frozen);
+  Emit(frozen ? "frozen" : "resumed");
+}
+
+void WebContents::OnDiscardTimer() {
+  Discard();
+}
+
 void WebContents::PluginCrashed(const base::FilePath& plugin_path,
                                 base::ProcessId plugin_pid) {
 #if BUILDFLAG(ENABLE_PLUGINS)
@@ -999,6 +1229,19 @@ void WebContents::DidAcquireFullscreen(content::RenderFrameHost* rfh) {
   set_fullscreen_frame(rfh);
 }
 
+void WebContents::ResourceLoadComplete(
+    content::RenderFrameHost* render_frame_host,
+    const content::GlobalRequestID& request_id,
+    const blink::mojom::ResourceLoadInfo& resource_load_info) {
+  if (resource_load_info.net_error != net::OK)
+    return;
+  GetBrowserContext()->network_metrics()->RecordLoad(
+      resource_load_info.final_url, resource_load_info.load_timing_info,
+      resource_load_info.was_cached);
+  GetBrowserContext()->preconnect_predictor()->OnOriginContacted(
+      web_contents(), resource_load_info.final_url);
+}
+
 void WebContents::DOMContentLoaded(
     content::RenderFrameHost* render_frame_host) {
   if (!render_frame_host->GetParent())
@@ -1042,6 +1285,8 @@ void WebContents::DidStopLoading() {
 bool WebContents::EmitNavigationEvent(
     const std::string& event,
     content::NavigationHandle* navigation_handle) {
+  if (!HasListeners(event))
+    return false;
   bool is_main_frame = navigation_handle->IsInMainFrame();
   int frame_tree_node_id = navigation_handle->GetFrameTreeNodeId();
   content::FrameTreeNode* frame_tree_node =
@@ -1078,33 +1323,99 @@ void WebContents::OnElectronBrowserConnectionError() {
   base::Erase(frame_to_bindings_map_[frame_host], binding_id);
 }
 
-void WebContents::Message(bool internal,
-                          const std::string& channel,
-                          blink::CloneableMessage arguments) {
+void WebContents::Message(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers) {
   TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+  IPCMetrics::ScopedDispatch dispatch(
+      channel, IPCMetrics::GetSize(arguments, array_buffers));
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
-  EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
-                 internal, channel, std::move(arguments));
+  EmitWithSender(
+      "-ipc-message", bindings_.dispatch_context(), InvokeCallback(), internal,
+      channel, SerializedValue(std::move(arguments), std::move(array_buffers)));
+}
+
+void WebContents::MessageWithAck(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
+    MessageWithAckCallback callback) {
+  Message(internal, channel, std::move(arguments), std::move(array_buffers));
+  std::move(callback).Run();
+}
+
+void WebContents::MessageBatch(
+    std::vector<mojom::BatchedMessagePtr> messages) {
+  TRACE_EVENT1("electron", "WebContents::MessageBatch", "count",
+               messages.size());
+  content::RenderFrameHost* frame_host = bindings_.dispatch_context();
+  // A listener may destroy the WebContents while the batch is fanned out.
+  base::WeakPtr<WebContents> weak_this = GetWeakPtr();
+  for (auto& message : messages) {
+    if (!weak_this)
+      return;
+    IPCMetrics::ScopedDispatch dispatch(
+        message->channel,
+        IPCMetrics::GetSize(message->arguments, message->array_buffers));
+    EmitWithSender("-ipc-message", frame_host, InvokeCallback(),
+                   message->internal, message->channel,
+                   SerializedValue(std::move(message->arguments),
+                                   std::move(message->array_buffers)));
+  }
 }
 
-void WebContents::Invoke(bool internal,
-                         const std::string& channel,
-                         blink::CloneableMessage arguments,
-                         InvokeCallback callback) {
+void WebContents::MessageBatchWithAck(
+    std::vector<mojom::BatchedMessagePtr> messages,
+    MessageBatchWithAckCallback callback) {
+  MessageBatch(std::move(messages));
+  std::move(callback).Run();
+}
+
+void WebContents::Invoke(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
+    InvokeCallback callback) {
   TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  IPCMetrics::ScopedDispatch dispatch(
+      channel, IPCMetrics::GetSize(arguments, array_buffers));
+  // Channels bound to a worker pool are handled without running any
+  // JavaScript in this isolate.
+  auto* worker_ipc_router = WorkerIPCRouter::GetInstance();
+  if (!internal && worker_ipc_router->HasChannel(channel)) {
+    content::RenderFrameHost* frame = bindings_.dispatch_context();
+    WorkerInvoke invoke;
+    invoke.sender_id = ID();
+    invoke.process_id = frame->GetProcess()->GetID();
+    invoke.frame_id = frame->GetRoutingID();
+    invoke.channel = channel;
+    invoke.args =
+        SerializedValue(std::move(arguments), std::move(array_buffers));
+    invoke.callback = std::move(callback);
+    invoke.reply_task_runner = base::SequencedTaskRunnerHandle::Get();
+    worker_ipc_router->Dispatch(std::move(invoke));
+    return;
+  }
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
-  EmitWithSender("-ipc-invoke", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+  EmitWithSender(
+      "-ipc-invoke", bindings_.dispatch_context(), std::move(callback),
+      internal, channel,
+      SerializedValue(std::move(arguments), std::move(array_buffers)));
 }
 
 void WebContents::ReceivePostMessage(const std::string& channel,
                                      blink::TransferableMessage message) {
+  IPCMetrics::ScopedDispatch dispatch(channel, IPCMetrics::GetSize(message));
   v8::HandleScope handle_scope(isolate());
   auto wrapped_ports =
       MessagePort::EntanglePorts(isolate(), std::move(message.ports));
   v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate(), message);
+      electron::DeserializeV8Value(isolate(), &message, false);
   EmitWithSender("-ipc-ports", bindings_.dispatch_context(), InvokeCallback(),
                  false, channel, message_value, std::move(wrapped_ports));
 }
@@ -1112,22 +1423,24 @@ void WebContents::ReceivePostMessage(const std::string& channel,
 void WebContents::PostMessage(const std::string& channel,
                               v8::Local<v8::Value> message_value,
                               base::Optional<v8::Local<v8::Value>> transfer) {
-  blink::TransferableMessage transferable_message;
-  if (!electron::SerializeV8Value(isolate(), message_value,
-                                  &transferable_message)) {
-    // SerializeV8Value sets an exception.
-    return;
-  }
-
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
   if (transfer) {
-    if (!gin::ConvertFromV8(isolate(), *transfer, &wrapped_ports)) {
+    if (!MessagePort::ParseTransferList(isolate(), *transfer, &wrapped_ports,
+                                        &array_buffers)) {
       isolate()->ThrowException(v8::Exception::Error(
           gin::StringToV8(isolate(), "Invalid value for transfer")));
       return;
     }
   }
 
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8Value(isolate(), message_value, array_buffers,
+                                  &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return;
+  }
+
   bool threw_exception = false;
   transferable_message.ports =
       MessagePort::DisentanglePorts(isolate(), wrapped_ports, &threw_exception);
@@ -1137,55 +1450,218 @@ void WebContents::PostMessage(const std::string& channel,
   content::RenderFrameHost* frame_host = web_contents()->GetMainFrame();
   mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
   frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  IPCMetrics::GetInstance()->RecordSent(
+      channel, IPCMetrics::GetSize(transferable_message));
   electron_renderer->ReceivePostMessage(channel,
                                         std::move(transferable_message));
 }
 
+v8::Local<v8::Value> WebContents::CreateSharedBuffer(
+    gin_helper::ErrorThrower thrower,
+    const std::string& channel,
+    uint32_t byte_length,
+    base::Optional<v8::Local<v8::Value>> transfer) {
+  if (byte_length == 0 || byte_length > kMaxSharedBufferSize) {
+    thrower.ThrowRangeError("byteLength must be between 1 and 1073741824");
+    return v8::Undefined(isolate());
+  }
+
+  std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (transfer && (!MessagePort::ParseTransferList(
+                       isolate(), *transfer, &wrapped_ports, &array_buffers) ||
+                   !array_buffers.empty())) {
+    thrower.ThrowError("Invalid value for transfer");
+    return v8::Undefined(isolate());
+  }
+
+  // Views of 8 byte elements, like BigInt64Array, can cover the whole buffer.
+  size_t size = (static_cast<size_t>(byte_length) + 7) & ~size_t{7};
+  base::UnsafeSharedMemoryRegion region =
+      base::UnsafeSharedMemoryRegion::Create(size);
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    thrower.ThrowError("Failed to allocate the shared buffer");
+    return v8::Undefined(isolate());
+  }
+
+  blink::TransferableMessage transferable_message;
+  bool threw_exception = false;
+  transferable_message.ports =
+      MessagePort::DisentanglePorts(isolate(), wrapped_ports, &threw_exception);
+  if (threw_exception)
+    return v8::Undefined(isolate());
+
+  content::RenderFrameHost* frame_host = web_contents()->GetMainFrame();
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->ReceiveSharedBuffer(channel, std::move(region),
+                                         std::move(transferable_message));
+
+  return NewSharedArrayBufferForMapping(isolate(), std::move(mapping));
+}
+
+// A sendSync() call the renderer is blocked on.
+struct WebContents::PendingSyncMessage
+    : public base::RefCounted<PendingSyncMessage> {
+  PendingSyncMessage(const std::string& channel, MessageSyncCallback callback)
+      : channel(channel),
+        callback(std::move(callback)),
+        start_time(base::TimeTicks::Now()) {}
+
+  std::string channel;
+  // Reset once the renderer has been replied to.
+  MessageSyncCallback callback;
+  base::TimeTicks start_time;
+  bool deadline_exceeded = false;
+
+ private:
+  friend class base::RefCounted<PendingSyncMessage>;
+  ~PendingSyncMessage() = default;
+};
+
 void WebContents::MessageSync(bool internal,
                               const std::string& channel,
                               blink::CloneableMessage arguments,
                               MessageSyncCallback callback) {
   TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
+  IPCMetrics::ScopedDispatch dispatch(channel, IPCMetrics::GetSize(arguments));
+  auto pending =
+      base::MakeRefCounted<PendingSyncMessage>(channel, std::move(callback));
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron", "SyncMessageBlocked",
+                                    TRACE_ID_LOCAL(pending.get()), "channel",
+                                    channel);
+  // Electron's own sync messages are never failed by the deadline.
+  if (!internal && !sync_message_deadline_.is_zero()) {
+    base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(&WebContents::OnSyncMessageDeadline, GetWeakPtr(),
+                       pending),
+        sync_message_deadline_);
+  }
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
-  EmitWithSender("-ipc-message-sync", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+  EmitWithSender(
+      "-ipc-message-sync", bindings_.dispatch_context(),
+      base::BindOnce(&WebContents::OnSyncMessageReply, GetWeakPtr(), pending),
+      internal, channel, std::move(arguments));
 }
 
-void WebContents::MessageTo(bool internal,
-                            bool send_to_all,
-                            int32_t web_contents_id,
-                            const std::string& channel,
-                            blink::CloneableMessage arguments) {
+void WebContents::OnSyncMessageReply(scoped_refptr<PendingSyncMessage> pending,
+                                     blink::CloneableMessage result) {
+  // The renderer has already been failed at the deadline.
+  if (!pending->callback)
+    return;
+  RecordSyncMessage(*pending);
+  std::move(pending->callback).Run(std::move(result));
+}
+
+void WebContents::OnSyncMessageDeadline(
+    scoped_refptr<PendingSyncMessage> pending) {
+  if (!pending->callback)
+    return;
+  pending->deadline_exceeded = true;
+  LOG(WARNING) << "ipcRenderer.sendSync() on channel '" << pending->channel
+               << "' has blocked the renderer for more than "
+               << sync_message_deadline_.InMilliseconds() << "ms";
+  if (fail_sync_message_at_deadline_) {
+    RecordSyncMessage(*pending);
+    // An empty reply makes sendSync() throw in the renderer.
+    std::move(pending->callback).Run(blink::CloneableMessage());
+  }
+  v8::HandleScope handle_scope(isolate());
+  Emit("sync-message-deadline-exceeded", pending->channel);
+}
+
+void WebContents::RecordSyncMessage(const PendingSyncMessage& pending) {
+  base::TimeDelta elapsed = base::TimeTicks::Now() - pending.start_time;
+  TRACE_EVENT_NESTABLE_ASYNC_END1("electron", "SyncMessageBlocked",
+                                  TRACE_ID_LOCAL(&pending), "deadline_exceeded",
+                                  pending.deadline_exceeded);
+  // The channel names come from the renderer, so do not let it grow the map
+  // without bounds.
+  constexpr size_t kMaxSyncMessageChannels = 1000;
+  auto it = sync_message_metrics_.find(pending.channel);
+  if (it == sync_message_metrics_.end()) {
+    if (sync_message_metrics_.size() >= kMaxSyncMessageChannels)
+      return;
+    it = sync_message_metrics_.emplace(pending.channel, SyncMessageMetrics())
+             .first;
+  }
+  SyncMessageMetrics& metrics = it->second;
+  metrics.count++;
+  if (pending.deadline_exceeded)
+    metrics.deadline_exceeded_count++;
+  metrics.total_time += elapsed;
+  metrics.max_time = std::max(metrics.max_time, elapsed);
+}
+
+void WebContents::MessageTo(
+    bool internal,
+    bool send_to_all,
+    int32_t web_contents_id,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers) {
   TRACE_EVENT1("electron", "WebContents::MessageTo", "channel", channel);
+  IPCMetrics::ScopedDispatch dispatch(
+      channel, IPCMetrics::GetSize(arguments, array_buffers));
   auto* web_contents = gin_helper::TrackableObject<WebContents>::FromWeakMapID(
       isolate(), web_contents_id);
 
   if (web_contents) {
-    web_contents->SendIPCMessageWithSender(internal, send_to_all, channel,
-                                           std::move(arguments), ID());
+    web_contents->SendIPCMessageWithSender(
+        internal, send_to_all, channel,
+        SerializedValue(std::move(arguments), std::move(array_buffers)), ID());
   }
 }
 
-void WebContents::MessageHost(const std::string& channel,
-                              blink::CloneableMessage arguments) {
+void WebContents::ConnectToWebContents(
+    int32_t web_contents_id,
+    mojo::PendingReceiver<mojom::ElectronRendererPeer> receiver) {
+  auto* web_contents = gin_helper::TrackableObject<WebContents>::FromWeakMapID(
+      isolate(), web_contents_id);
+  if (!web_contents)
+    return;
+  content::RenderFrameHost* frame_host =
+      web_contents->web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive())
+    return;
+
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->BindPeer(ID(), std::move(receiver));
+}
+
+void WebContents::MessageHost(
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers) {
   TRACE_EVENT1("electron", "WebContents::MessageHost", "channel", channel);
+  IPCMetrics::ScopedDispatch dispatch(
+      channel, IPCMetrics::GetSize(arguments, array_buffers));
   // webContents.emit('ipc-message-host', new Event(), channel, args);
-  EmitWithSender("ipc-message-host", bindings_.dispatch_context(),
-                 InvokeCallback(), channel, std::move(arguments));
+  EmitWithSender(
+      "ipc-message-host", bindings_.dispatch_context(), InvokeCallback(),
+      channel, SerializedValue(std::move(arguments), std::move(array_buffers)));
 }
 
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-void WebContents::DereferenceRemoteJSObject(const std::string& context_id,
-                                            int object_id,
-                                            int ref_count) {
-  base::ListValue args;
-  args.Append(context_id);
-  args.Append(object_id);
-  args.Append(ref_count);
-  EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
-                 /* internal */ true, "ELECTRON_BROWSER_DEREFERENCE",
-                 std::move(args));
+void WebContents::DereferenceRemoteJSObjects(
+    std::vector<mojom::RemoteObjectDereferencePtr> objects) {
+  content::RenderFrameHost* frame_host = bindings_.dispatch_context();
+  base::WeakPtr<WebContents> weak_this = GetWeakPtr();
+  for (const auto& object : objects) {
+    if (!weak_this)
+      return;
+    base::ListValue args;
+    args.Append(object->context_id);
+    args.Append(object->object_id);
+    args.Append(object->ref_count);
+    EmitWithSender("-ipc-message", frame_host, InvokeCallback(),
+                   /* internal */ true, "ELECTRON_BROWSER_DEREFERENCE",
+                   std::move(args));
+  }
 }
 #endif
 
@@ -1197,6 +1673,11 @@ void WebContents::UpdateDraggableRegions(
 
 void WebContents::RenderFrameDeleted(
     content::RenderFrameHost* render_frame_host) {
+  // Lets pending invokeInWebContentsProcesses() calls know that the frame
+  // will not reply.
+  Emit("-render-frame-deleted", render_frame_host->GetProcess()->GetID(),
+       render_frame_host->GetRoutingID());
+
   // A RenderFrameHost can be destroyed before the related Mojo binding is
   // closed, which can result in Mojo calls being sent for RenderFrameHosts
   // that no longer exist. To prevent this from happening, when a
@@ -1212,6 +1693,14 @@ void WebContents::RenderFrameDeleted(
 
 void WebContents::DidStartNavigation(
     content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    GetBrowserContext()->preconnect_predictor()->OnNavigationStarted(
+        web_contents(), navigation_handle->GetURL());
+    // Only the origin, the rest of the URL can be private.
+    crash_reporter::RecordBreadcrumb(
+        "nav", navigation_handle->GetURL().GetOrigin().spec());
+  }
   EmitNavigationEvent("did-start-navigation", navigation_handle);
 }
 
@@ -1368,6 +1857,8 @@ bool WebContents::OnMessageReceived(const IPC::Message& message) {
 void WebContents::WebContentsDestroyed() {
   // Cleanup relationships with other parts.
   RemoveFromWeakMap();
+  GetBrowserContext()->preconnect_predictor()->OnWebContentsDestroyed(
+      web_contents());
 
   // We can not call Destroy here because we need to call Emit first, but we
   // also do not want any method to be used, so just mark as destroyed here.
@@ -1416,6 +1907,164 @@ void WebContents::SetBackgroundThrottling(bool allowed) {
   }
 }
 
+bool WebContents::GetBackgroundThrottling() const {
+  return background_throttling_;
+}
+
+void WebContents::SetRendererPriority(gin_helper::ErrorThrower thrower,
+                                      const std::string& priority) {
+  if (priority == "foreground") {
+    if (!foreground_process_pin_)
+      foreground_process_pin_ =
+          std::make_unique<ForegroundProcessPin>(web_contents());
+  } else if (priority == "auto") {
+    foreground_process_pin_.reset();
+  } else {
+    thrower.ThrowError("priority must be 'auto' or 'foreground'");
+  }
+}
+
+std::string WebContents::GetRendererPriority() const {
+  return foreground_process_pin_ ? "foreground" : "auto";
+}
+
+void WebContents::SetNetworkConditions(v8::Local<v8::Value> value,
+                                       gin_helper::Arguments* args) {
+  if (value->IsNull()) {
+    network_conditions_.reset();
+  } else {
+    gin_helper::Dictionary options;
+    if (!gin::ConvertFromV8(args->isolate(), value, &options)) {
+      args->ThrowError("Must pass null or an Object");
+      return;
+    }
+    auto conditions = network::mojom::NetworkConditions::New();
+    options.Get("offline", &conditions->offline);
+    options.Get("downloadThroughput", &conditions->download_throughput);
+    options.Get("uploadThroughput", &conditions->upload_throughput);
+    double latency = 0.0;
+    if (options.Get("latency", &latency) && latency)
+      conditions->latency = base::TimeDelta::FromMillisecondsD(latency);
+    network_conditions_ = std::move(conditions);
+  }
+
+  // Requests are throttled by the DevTools token of the frame that sends
+  // them, like with the emulation of the DevTools.
+  for (auto* render_frame_host : web_contents()->GetAllFrames())
+    ApplyNetworkConditions(render_frame_host);
+}
+
+void WebContents::ApplyNetworkConditions(
+    content::RenderFrameHost* render_frame_host) {
+  render_frame_host->GetProcess()
+      ->GetStoragePartition()
+      ->GetNetworkContext()
+      ->SetNetworkConditions(
+          render_frame_host->GetDevToolsFrameToken(),
+          network_conditions_ ? network_conditions_.Clone() : nullptr);
+}
+
+v8::Local<v8::Value> WebContents::GetSyncMessageMetrics(
+    v8::Isolate* isolate) const {
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  for (const auto& it : sync_message_metrics_) {
+    gin_helper::Dictionary metrics = gin::Dictionary::CreateEmpty(isolate);
+    metrics.Set("count", it.second.count);
+    metrics.Set("totalTime", it.second.total_time.InMillisecondsF());
+    metrics.Set("maxTime", it.second.max_time.InMillisecondsF());
+    metrics.Set("deadlineExceededCount", it.second.deadline_exceeded_count);
+    result.Set(it.first, metrics);
+  }
+  return result.GetHandle();
+}
+
+void WebContents::SetLifecyclePolicy(gin_helper::Arguments* args) {
+  gin_helper::Dictionary policy;
+  if (!args->GetNext(&policy)) {
+    args->ThrowError("policy must be an object");
+    return;
+  }
+  int64_t freeze_after = 0;
+  int64_t discard_after = 0;
+  bool valid = (!policy.Has("freezeAfter") ||
+                policy.Get("freezeAfter", &freeze_after)) &&
+               (!policy.Has("discardAfter") ||
+                policy.Get("discardAfter", &discard_after));
+  if (!valid || freeze_after < 0 || discard_after < 0) {
+    args->ThrowError(
+        "freezeAfter and discardAfter must be non-negative numbers");
+    return;
+  }
+
+  freeze_delay_ = base::TimeDelta::FromMilliseconds(freeze_after);
+  discard_delay_ = base::TimeDelta::FromMilliseconds(discard_after);
+  freeze_timer_.Stop();
+  discard_timer_.Stop();
+  ScheduleLifecycleChanges();
+}
+
+v8::Local<v8::Value> WebContents::GetLifecyclePolicy(
+    v8::Isolate* isolate) const {
+  gin_helper::Dictionary policy = gin::Dictionary::CreateEmpty(isolate);
+  policy.Set("freezeAfter", freeze_delay_.InMilliseconds());
+  policy.Set("discardAfter", discard_delay_.InMilliseconds());
+  return policy.GetHandle();
+}
+
+bool WebContents::Discard() {
+  if (discarded_ || type_ == Type::BACKGROUND_PAGE ||
+      web_contents()->GetVisibility() != content::Visibility::HIDDEN)
+    return false;
+  // Gives the app a chance to keep the page, or to save its state first.
+  if (Emit("will-discard"))
+    return false;
+
+  auto* rph = web_contents()->GetMainFrame()->GetProcess();
+  discarded_ = true;
+  // The renderer is only shut down when it hosts nothing but this page.
+  if (!rph->FastShutdownIfPossible(1, false)) {
+    discarded_ = false;
+    return false;
+  }
+
+  freeze_timer_.Stop();
+  discard_timer_.Stop();
+  frozen_ = false;
+  web_contents()->GetController().SetNeedsReload();
+  // Lets the page know it was discarded with document.wasDiscarded once it
+  // is loaded again.
+  web_contents()->SetWasDiscarded(true);
+  Emit("discarded");
+  return true;
+}
+
+bool WebContents::IsFrozen() const {
+  return frozen_;
+}
+
+bool WebContents::IsDiscarded() const {
+  return discarded_;
+}
+
+void WebContents::SetSyncMessageDeadline(gin_helper::Arguments* args) {
+  int64_t deadline_ms = 0;
+  if (!args->GetNext(&deadline_ms) || deadline_ms < 0) {
+    args->ThrowError("deadline must be a non-negative number");
+    return;
+  }
+  std::string action = "log";
+  if (args->Length() > 1 && !args->GetNext(&action)) {
+    args->ThrowError("action must be a string");
+    return;
+  }
+  if (action != "log" && action != "fail") {
+    args->ThrowError("action must be 'log' or 'fail'");
+    return;
+  }
+  sync_message_deadline_ = base::TimeDelta::FromMilliseconds(deadline_ms);
+  fail_sync_message_at_deadline_ = action == "fail";
+}
+
 int WebContents::GetProcessID() const {
   return web_contents()->GetMainFrame()->GetProcess()->GetID();
 }
@@ -1534,6 +2183,35 @@ void WebContents::DownloadURL(const GURL& url) {
   download_manager->DownloadUrl(std::move(download_params));
 }
 
+v8::Local<v8::Promise> WebContents::Prefetch(const GURL& url) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!url.SchemeIsHTTPOrHTTPS()) {
+    promise.RejectWithErrorMessage(
+        "Only http and https URLs can be prefetched");
+    return handle;
+  }
+
+  // Like <link rel=prefetch>, the response is kept in the cache for a while
+  // even when it is not cacheable, so that the next navigation can use it.
+  // The request is made by the current page, so cookies are sent as they
+  // would be for the page, and it goes through the protocol handlers and
+  // the webRequest listeners of the session.
+  const GURL& page_url = web_contents()->GetLastCommittedURL();
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url;
+  request->site_for_cookies = net::SiteForCookies::FromUrl(page_url);
+  request->request_initiator = url::Origin::Create(page_url);
+  request->load_flags = net::LOAD_PREFETCH;
+  request->headers.SetHeader("Purpose", "prefetch");
+  auto loader = network::SimpleURLLoader::Create(std::move(request),
+                                                 kPrefetchTrafficAnnotation);
+  auto* consumer =
+      new PrefetchStreamConsumer(std::move(loader), std::move(promise));
+  consumer->Start(GetBrowserContext()->GetURLLoaderFactory().get());
+  return handle;
+}
+
 GURL WebContents::GetURL() const {
   return web_contents()->GetURL();
 }
@@ -1608,11 +2286,18 @@ std::string WebContents::GetUserAgent() {
 
 v8::Local<v8::Promise> WebContents::SavePage(
     const base::FilePath& full_file_path,
-    const content::SavePageType& save_type) {
+    const content::SavePageType& save_type,
+    gin_helper::Arguments* args) {
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  auto* handler = new SavePageHandler(web_contents(), std::move(promise));
+  base::RepeatingCallback<void(int)> progress;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("onProgress", &progress);
+
+  auto* handler = new SavePageHandler(web_contents(), std::move(promise),
+                                      std::move(progress));
   handler->Handle(full_file_path, save_type);
 
   return handle;
@@ -1648,6 +2333,13 @@ void WebContents::CloseDevTools() {
   managed_web_contents()->CloseDevTools();
 }
 
+void WebContents::SetKeepDevToolsLoaded(bool keep) {
+  if (type_ == Type::REMOTE)
+    return;
+
+  managed_web_contents()->SetKeepDevToolsLoaded(keep);
+}
+
 bool WebContents::IsDevToolsOpened() {
   if (type_ == Type::REMOTE)
     return false;
@@ -1787,8 +2479,7 @@ void WebContents::InspectServiceWorker() {
 void WebContents::SetIgnoreMenuShortcuts(bool ignore) {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   DCHECK(web_preferences);
-  web_preferences->preference()->SetKey("ignoreMenuShortcuts",
-                                        base::Value(ignore));
+  web_preferences->SetPreference("ignoreMenuShortcuts", base::Value(ignore));
 }
 
 void WebContents::SetAudioMuted(bool muted) {
@@ -2166,7 +2857,7 @@ bool WebContents::SendIPCMessage(bool internal,
                                  bool send_to_all,
                                  const std::string& channel,
                                  v8::Local<v8::Value> args) {
-  blink::CloneableMessage message;
+  SerializedValue message;
   if (!gin::ConvertFromV8(isolate(), args, &message)) {
     isolate()->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate(), "Failed to serialize arguments")));
@@ -2179,7 +2870,7 @@ bool WebContents::SendIPCMessage(bool internal,
 bool WebContents::SendIPCMessageWithSender(bool internal,
                                            bool send_to_all,
                                            const std::string& channel,
-                                           blink::CloneableMessage args,
+                                           SerializedValue args,
                                            int32_t sender_id) {
   std::vector<content::RenderFrameHost*> target_hosts;
   if (!send_to_all) {
@@ -2191,22 +2882,76 @@ bool WebContents::SendIPCMessageWithSender(bool internal,
     target_hosts = web_contents()->GetAllFrames();
   }
 
+  const size_t size = IPCMetrics::GetSize(args.message, args.array_buffers);
   for (auto* frame_host : target_hosts) {
     mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
     frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
         &electron_renderer);
-    electron_renderer->Message(internal, false, channel, args.ShallowClone(),
-                               sender_id);
+    IPCMetrics::GetInstance()->RecordSent(channel, size);
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers;
+    for (const auto& region : args.array_buffers)
+      array_buffers.push_back(region.Duplicate());
+    electron_renderer->Message(internal, false, channel,
+                               args.message.ShallowClone(),
+                               std::move(array_buffers), sender_id);
   }
   return true;
 }
 
+v8::Local<v8::Value> WebContents::SendIPCMessageToProcesses(
+    bool internal,
+    const std::string& channel,
+    v8::Local<v8::Value> args) {
+  std::vector<gin_helper::Dictionary> targets;
+  SerializedValue message;
+  if (!gin::ConvertFromV8(isolate(), args, &message)) {
+    isolate()->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate(), "Failed to serialize arguments")));
+    return gin::ConvertToV8(isolate(), targets);
+  }
+
+  // Only the frames where Electron's renderer code runs can handle the
+  // message, which are the main frame unless subframes get Node integration.
+  auto* web_preferences = WebContentsPreferences::From(web_contents());
+  const bool subframes_have_bindings =
+      web_preferences &&
+      web_preferences->IsEnabled(options::kNodeIntegrationInSubFrames);
+
+  // The frames are in tree order, so the message goes to the topmost of
+  // those frames in each process.
+  std::set<int> process_ids;
+  const size_t size =
+      IPCMetrics::GetSize(message.message, message.array_buffers);
+  for (auto* frame_host : web_contents()->GetAllFrames()) {
+    if (!frame_host->IsRenderFrameLive() ||
+        (frame_host->GetParent() && !subframes_have_bindings) ||
+        !process_ids.insert(frame_host->GetProcess()->GetID()).second)
+      continue;
+    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+    frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+        &electron_renderer);
+    IPCMetrics::GetInstance()->RecordSent(channel, size);
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers;
+    for (const auto& region : message.array_buffers)
+      array_buffers.push_back(region.Duplicate());
+    electron_renderer->Message(internal, false, channel,
+                               message.message.ShallowClone(),
+                               std::move(array_buffers), 0 /* sender_id */);
+
+    gin_helper::Dictionary target = gin::Dictionary::CreateEmpty(isolate());
+    target.Set("processId", frame_host->GetProcess()->GetID());
+    target.Set("frameId", frame_host->GetRoutingID());
+    targets.push_back(target);
+  }
+  return gin::ConvertToV8(isolate(), targets);
+}
+
 bool WebContents::SendIPCMessageToFrame(bool internal,
                                         bool send_to_all,
                                         int32_t frame_id,
                                         const std::string& channel,
                                         v8::Local<v8::Value> args) {
-  blink::CloneableMessage message;
+  SerializedValue message;
   if (!gin::ConvertFromV8(isolate(), args, &message)) {
     isolate()->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate(), "Failed to serialize arguments")));
@@ -2223,17 +2968,86 @@ bool WebContents::SendIPCMessageToFrame(bool internal,
 
   mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
   (*iter)->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
-  electron_renderer->Message(internal, send_to_all, channel, std::move(message),
+  IPCMetrics::GetInstance()->RecordSent(
+      channel, IPCMetrics::GetSize(message.message, message.array_buffers));
+  electron_renderer->Message(internal, send_to_all, channel,
+                             std::move(message.message),
+                             std::move(message.array_buffers),
                              0 /* sender_id */);
   return true;
 }
 
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
+  if (!DispatchInputEvent(isolate, input_event)) {
+    isolate->ThrowException(
+        v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+  }
+}
+
+void WebContents::SendInputEvents(
+    v8::Isolate* isolate,
+    const std::vector<v8::Local<v8::Value>>& input_events) {
+  // Consecutive mouse moves are coalesced into the last one with their
+  // movements summed, the way the input router of the renderer does, so a
+  // batch replayed by a remote host does not make the page handle every move.
+  base::Optional<blink::WebMouseEvent> pending_move;
+  for (size_t i = 0; i < input_events.size(); ++i) {
+    v8::Local<v8::Value> input_event = input_events[i];
+    if (gin::GetWebInputEventType(isolate, input_event) ==
+        blink::WebInputEvent::kMouseMove) {
+      blink::WebMouseEvent mouse_event;
+      if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
+        if (pending_move &&
+            pending_move->GetModifiers() == mouse_event.GetModifiers() &&
+            pending_move->button == mouse_event.button &&
+            pending_move->pointer_type == mouse_event.pointer_type &&
+            pending_move->id == mouse_event.id) {
+          mouse_event.movement_x += pending_move->movement_x;
+          mouse_event.movement_y += pending_move->movement_y;
+        } else if (pending_move) {
+          DispatchMouseEvent(*pending_move);
+        }
+        pending_move = mouse_event;
+        continue;
+      }
+    }
+
+    if (pending_move) {
+      DispatchMouseEvent(*pending_move);
+      pending_move.reset();
+    }
+    if (!DispatchInputEvent(isolate, input_event)) {
+      std::string error =
+          "Invalid event object at index " + base::NumberToString(i);
+      isolate->ThrowException(
+          v8::Exception::Error(gin::StringToV8(isolate, error)));
+      return;
+    }
+  }
+  if (pending_move)
+    DispatchMouseEvent(*pending_move);
+}
+
+void WebContents::DispatchMouseEvent(const blink::WebMouseEvent& mouse_event) {
+  if (IsOffScreen()) {
+#if BUILDFLAG(ENABLE_OSR)
+    GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+#endif
+    return;
+  }
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (view)
+    view->GetRenderWidgetHost()->ForwardMouseEvent(mouse_event);
+}
+
+bool WebContents::DispatchInputEvent(v8::Isolate* isolate,
+                                     v8::Local<v8::Value> input_event) {
   content::RenderWidgetHostView* view =
       web_contents()->GetRenderWidgetHostView();
   if (!view)
-    return;
+    return true;
 
   content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
   blink::WebInputEvent::Type type =
@@ -2241,14 +3055,8 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (blink::WebInputEvent::IsMouseEventType(type)) {
     blink::WebMouseEvent mouse_event;
     if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-#if BUILDFLAG(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-#endif
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
-      return;
+      DispatchMouseEvent(mouse_event);
+      return true;
     }
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
     content::NativeWebKeyboardEvent keyboard_event(
@@ -2256,7 +3064,7 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
         blink::WebInputEvent::kNoModifiers, ui::EventTimeForNow());
     if (gin::ConvertFromV8(isolate, input_event, &keyboard_event)) {
       rwh->ForwardKeyboardEvent(keyboard_event);
-      return;
+      return true;
     }
   } else if (type == blink::WebInputEvent::kMouseWheel) {
     blink::WebMouseWheelEvent mouse_wheel_event;
@@ -2282,30 +3090,115 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
             blink::WebInputEvent::kEventNonBlocking;
         rwh->ForwardWheelEvent(mouse_wheel_event);
       }
-      return;
+      return true;
     }
   }
 
-  isolate->ThrowException(
-      v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+  return false;
 }
 
-void WebContents::BeginFrameSubscription(gin_helper::Arguments* args) {
-  bool only_dirty = false;
+int32_t WebContents::BeginFrameSubscription(gin_helper::Arguments* args) {
+  FrameSubscriber::Options options;
   FrameSubscriber::FrameCaptureCallback callback;
 
-  args->GetNext(&only_dirty);
+  gin_helper::Dictionary dict;
+  bool has_options = !args->PeekNext().IsEmpty() &&
+                     !args->PeekNext()->IsFunction() && args->GetNext(&dict);
+  if (has_options) {
+    dict.Get("onlyDirty", &options.only_dirty);
+    dict.Get("size", &options.size);
+    if (dict.Get("frameRate", &options.frame_rate))
+      options.frame_rate = base::ClampToRange(options.frame_rate, 1, 240);
+    std::string format;
+    if (dict.Get("format", &format)) {
+      if (format == "i420") {
+        options.format = media::PIXEL_FORMAT_I420;
+      } else if (format == "nv12") {
+        options.format = media::PIXEL_FORMAT_NV12;
+      } else if (format == "bgra") {
+        options.raw = true;
+      } else if (format != "rgba") {
+        args->ThrowError("Invalid format: " + format);
+        return 0;
+      }
+    }
+    std::string color_space;
+    if (dict.Get("colorSpace", &color_space)) {
+      if (color_space == "rec601") {
+        options.color_space = gfx::ColorSpace::CreateREC601();
+      } else if (color_space == "srgb") {
+        options.color_space = gfx::ColorSpace::CreateSRGB();
+      } else if (color_space != "rec709") {
+        args->ThrowError("Invalid color space: " + color_space);
+        return 0;
+      }
+    }
+  } else {
+    args->GetNext(&options.only_dirty);
+  }
+
+  if (!args->GetNext(&callback)) {
+    args->ThrowError();
+    return 0;
+  }
+
+  int32_t id = has_options ? ++last_frame_subscription_id_ : 0;
+  frame_subscribers_[id] =
+      std::make_unique<FrameSubscriber>(web_contents(), callback, options);
+  return id;
+}
+
+void WebContents::EndFrameSubscription(gin_helper::Arguments* args) {
+  int32_t id;
+  if (args->GetNext(&id))
+    frame_subscribers_.erase(id);
+  else
+    frame_subscribers_.clear();
+}
+
+void WebContents::StartVideoEncode(gin_helper::Arguments* args) {
+  FrameEncoder::Options options;
+  FrameEncoder::ChunkCallback callback;
+
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string codec;
+    if (dict.Get("codec", &codec)) {
+      if (codec == "vp8") {
+        options.profile = media::VP8PROFILE_ANY;
+      } else if (codec == "vp9") {
+        options.profile = media::VP9PROFILE_PROFILE0;
+      } else if (codec != "h264") {
+        args->ThrowError("Invalid codec: " + codec);
+        return;
+      }
+    }
+    dict.Get("size", &options.size);
+    dict.Get("bitrate", &options.bitrate);
+    if (dict.Get("frameRate", &options.frame_rate))
+      options.frame_rate = base::ClampToRange(options.frame_rate, 1, 60);
+  }
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
+  if (!FrameEncoder::IsProfileSupported(options.profile)) {
+    args->ThrowError("No hardware encoder is available for this codec");
+    return;
+  }
+
+  frame_encoder_ = std::make_unique<FrameEncoder>(
+      web_contents(), options, callback,
+      base::BindOnce(&WebContents::OnVideoEncodeError, GetWeakPtr()));
+}
 
-  frame_subscriber_ =
-      std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
+void WebContents::StopVideoEncode() {
+  frame_encoder_.reset();
 }
 
-void WebContents::EndFrameSubscription() {
-  frame_subscriber_.reset();
+void WebContents::OnVideoEncodeError(const std::string& error) {
+  frame_encoder_.reset();
+  Emit("video-encode-error", error);
 }
 
 void WebContents::StartDrag(const gin_helper::Dictionary& item,
@@ -2331,37 +3224,98 @@ void WebContents::StartDrag(const gin_helper::Dictionary& item,
   }
 }
 
-v8::Local<v8::Promise> WebContents::CapturePage(gin_helper::Arguments* args) {
+bool WebContents::GetCaptureArea(gin_helper::Arguments* args,
+                                 gin_helper::Dictionary* options,
+                                 gfx::Rect* source_rect,
+                                 gfx::Size* bitmap_size) {
   gfx::Rect rect;
-  gin_helper::Promise<gfx::Image> promise(isolate());
-  v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  // get rect arguments if they exist
-  args->GetNext(&rect);
+  // get rect and options arguments if they exist, the rect can be omitted.
+  v8::Local<v8::Value> arg;
+  if (args->GetNext(&arg) && !arg->IsNullOrUndefined() &&
+      !gin::ConvertFromV8(isolate(), arg, &rect)) {
+    gin::ConvertFromV8(isolate(), arg, options);
+  } else {
+    args->GetNext(options);
+  }
 
   auto* const view = web_contents()->GetRenderWidgetHostView();
-  if (!view) {
-    promise.Resolve(gfx::Image());
-    return handle;
-  }
+  if (!view)
+    return false;
 
   // Capture full page if user doesn't specify a |rect|.
   const gfx::Size view_size =
       rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
+  *source_rect = gfx::Rect(rect.origin(), view_size);
 
   // By default, the requested bitmap size is the view size in screen
   // coordinates.  However, if there's more pixel detail available on the
   // current system, increase the requested bitmap size to capture it all.
-  gfx::Size bitmap_size = view_size;
+  // An explicit output size is scaled to by the compositor, on the GPU.
+  gfx::Size output_size;
+  if (!options->IsEmpty())
+    options->Get("size", &output_size);
+  *bitmap_size = view_size;
   const gfx::NativeView native_view = view->GetNativeView();
   const float scale = display::Screen::GetScreen()
                           ->GetDisplayNearestView(native_view)
                           .device_scale_factor();
-  if (scale > 1.0f)
-    bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  if (!output_size.IsEmpty())
+    *bitmap_size = output_size;
+  else if (scale > 1.0f)
+    *bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  return true;
+}
+
+v8::Local<v8::Promise> WebContents::CapturePage(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gin_helper::Dictionary options;
+  gfx::Rect source_rect;
+  gfx::Size bitmap_size;
+  if (!GetCaptureArea(args, &options, &source_rect, &bitmap_size)) {
+    promise.Resolve(gfx::Image());
+    return handle;
+  }
+
+  web_contents()->GetRenderWidgetHostView()->CopyFromSurface(
+      source_rect, bitmap_size,
+      base::BindOnce(&OnCapturePageDone, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::CapturePageToBuffer(
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gin_helper::Dictionary options;
+  gfx::Rect source_rect;
+  gfx::Size bitmap_size;
+  bool has_view = GetCaptureArea(args, &options, &source_rect, &bitmap_size);
+
+  std::string format = "png";
+  int quality = 90;
+  if (!options.IsEmpty()) {
+    options.Get("format", &format);
+    options.Get("quality", &quality);
+  }
+  if (format != "png" && format != "jpeg" && format != "webp" &&
+      format != "bitmap") {
+    promise.RejectWithErrorMessage("Unsupported format: " + format);
+    return handle;
+  }
 
-  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
-                        base::BindOnce(&OnCapturePageDone, std::move(promise)));
+  if (!has_view) {
+    OnCaptureEncoded(std::move(promise), std::vector<unsigned char>());
+    return handle;
+  }
+
+  web_contents()->GetRenderWidgetHostView()->CopyFromSurface(
+      source_rect, bitmap_size,
+      base::BindOnce(&OnCapturePageEncode, std::move(promise), format,
+                     quality));
   return handle;
 }
 
@@ -2391,6 +3345,9 @@ bool WebContents::IsBeingCaptured() {
 }
 
 void WebContents::OnCursorChange(const content::WebCursor& webcursor) {
+  if (!HasListeners("cursor-changed"))
+    return;
+
   const ui::Cursor& cursor = webcursor.cursor();
 
   if (cursor.type() == ui::mojom::CursorType::kCustom) {
@@ -2424,8 +3381,67 @@ bool WebContents::IsOffScreen() const {
 }
 
 #if BUILDFLAG(ENABLE_OSR)
+v8::Local<v8::Object> WebContents::CreatePaintEvent() {
+  base::TimeTicks delivered = base::TimeTicks::Now();
+  gin_helper::Dictionary event = gin::Dictionary::CreateEmpty(isolate());
+  auto* view = GetOffScreenRenderWidgetHostView();
+  if (!view)
+    return event.GetHandle();
+
+  // Milliseconds of the monotonic clock, only the differences between them
+  // are meaningful.
+  gin_helper::Dictionary timing = gin::Dictionary::CreateEmpty(isolate());
+  auto set_time = [&timing](base::StringPiece key, base::TimeTicks time) {
+    if (!time.is_null())
+      timing.Set(key, (time - base::TimeTicks()).InMillisecondsF());
+  };
+  const OffScreenFrameTiming& frame_timing = view->frame_timing();
+  set_time("beginFrame", frame_timing.begin_frame);
+  set_time("frameTime", frame_timing.frame_time);
+  set_time("captureBegin", frame_timing.capture_begin);
+  set_time("captureEnd", frame_timing.capture_end);
+  set_time("received", frame_timing.received);
+  set_time("delivered", delivered);
+  event.Set("frameTiming", timing);
+  return event.GetHandle();
+}
+
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  if (paint_only_dirty_ && !dirty_rect.IsEmpty() &&
+      dirty_rect != gfx::Rect(bitmap.width(), bitmap.height())) {
+    // Only the damaged pixels are copied, packed without the stride of the
+    // frame.
+    EmitCustomEvent(
+        "paint", CreatePaintEvent(), dirty_rect,
+        gfx::Image::CreateFrom1xBitmap(SkBitmapOperations::CreateTiledBitmap(
+            bitmap, dirty_rect.x(), dirty_rect.y(), dirty_rect.width(),
+            dirty_rect.height())));
+    return;
+  }
+  EmitCustomEvent("paint", CreatePaintEvent(), dirty_rect,
+                  gfx::Image::CreateFrom1xBitmap(bitmap));
+}
+
+void WebContents::OnTexturePaint(const gfx::Rect& dirty_rect,
+                                 OffScreenSharedTexture texture) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  auto handle = node::Buffer::Copy(isolate(),
+                                   reinterpret_cast<char*>(&texture.handle),
+                                   sizeof(texture.handle));
+  dict.Set("handle", handle.ToLocalChecked());
+  dict.Set("size", texture.pixel_size);
+  // The texture is also released when the function is garbage collected
+  // without being called.
+  auto release =
+      std::make_unique<base::ScopedClosureRunner>(std::move(texture.release));
+  dict.Set("release",
+           base::BindOnce([](std::unique_ptr<base::ScopedClosureRunner>) {},
+                          std::move(release)));
+  EmitCustomEvent("paint", CreatePaintEvent(), dirty_rect, gfx::Image(), dict);
 }
 
 void WebContents::StartPainting() {
@@ -2455,6 +3471,12 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+void WebContents::BeginFrame() {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (osr_rwhv)
+    osr_rwhv->IssueBeginFrame();
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -2515,6 +3537,11 @@ void WebContents::DoGetZoomLevel(DoGetZoomLevelCallback callback) {
   std::move(callback).Run(GetZoomLevel());
 }
 
+void WebContents::GetSystemSnapshot(GetSystemSnapshotCallback callback) {
+  std::move(callback).Run(
+      SystemSnapshotPublisher::GetInstance()->DuplicateRegion());
+}
+
 std::vector<base::FilePath::StringType> WebContents::GetPreloadPaths() const {
   auto result = SessionPreferences::GetValidPreloads(GetBrowserContext());
 
@@ -2528,6 +3555,14 @@ std::vector<base::FilePath::StringType> WebContents::GetPreloadPaths() const {
   return result;
 }
 
+bool WebContents::CanProcessAccessURL(int process_id, const GURL& url) const {
+  const url::Origin origin = url::Origin::Create(url);
+  if (origin.opaque() || !content::RenderProcessHost::FromID(process_id))
+    return false;
+  return content::ChildProcessSecurityPolicy::GetInstance()
+      ->CanAccessDataForOrigin(process_id, origin);
+}
+
 v8::Local<v8::Value> WebContents::GetWebPreferences(
     v8::Isolate* isolate) const {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
@@ -2646,9 +3681,13 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
       std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
   frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
       electron_renderer.get());
+  mojo::PendingRemote<mojom::HeapSnapshotObserver> observer;
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<HeapSnapshotProgressObserver>(GetWeakPtr()),
+      observer.InitWithNewPipeAndPassReceiver());
   auto* raw_ptr = electron_renderer.get();
   (*raw_ptr)->TakeHeapSnapshot(
-      mojo::WrapPlatformFile(file.TakePlatformFile()),
+      mojo::WrapPlatformFile(file.TakePlatformFile()), std::move(observer),
       base::BindOnce(
           [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
              gin_helper::Promise<void> promise, bool success) {
@@ -2662,14 +3701,202 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::StartSamplingHeapProfiler(
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  uint64_t sampling_interval = kDefaultHeapSamplingInterval;
+  int stack_depth = kDefaultHeapSamplingStackDepth;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval == 0 || stack_depth <= 0) {
+    promise.RejectWithErrorMessage(
+        "samplingInterval and stackDepth must be positive");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("startSamplingHeapProfiler failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartSamplingHeapProfiler(
+      sampling_interval, stack_depth,
+      base::BindOnce(
+          [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "startSamplingHeapProfiler failed");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopSamplingHeapProfiler() {
+  gin_helper::Promise<std::string> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("stopSamplingHeapProfiler failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopSamplingHeapProfiler(base::BindOnce(
+      [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<std::string> promise,
+         const std::string& profile) {
+        if (profile.empty()) {
+          promise.RejectWithErrorMessage(
+              "The sampling heap profiler was not started");
+        } else {
+          promise.Resolve(profile);
+        }
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StartCPUProfiler(
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  double sampling_interval = kDefaultCPUSamplingInterval.InMicrosecondsF();
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval < 1) {
+    promise.RejectWithErrorMessage("samplingInterval must be positive");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("startCPUProfiler failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartCPUProfiler(
+      base::TimeDelta::FromMicroseconds(
+          static_cast<int64_t>(sampling_interval)),
+      base::BindOnce(
+          [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage("startCPUProfiler failed");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopCPUProfiler() {
+  gin_helper::Promise<std::string> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("stopCPUProfiler failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopCPUProfiler(base::BindOnce(
+      [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<std::string> promise,
+         const std::string& profile) {
+        if (profile.empty()) {
+          promise.RejectWithErrorMessage("The CPU profiler was not started");
+        } else {
+          promise.Resolve(profile);
+        }
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::TrimMemory(gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string level = "moderate";
+  if (args->Length() > 0 && !args->GetNext(&level)) {
+    promise.RejectWithErrorMessage("level must be a string");
+    return handle;
+  }
+  if (level != "moderate" && level != "critical") {
+    promise.RejectWithErrorMessage("level must be 'moderate' or 'critical'");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("trimMemory failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->TrimMemory(
+      level == "critical",
+      base::BindOnce(
+          [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise) { promise.Resolve(); },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
 // static
 void WebContents::BuildPrototype(v8::Isolate* isolate,
                                  v8::Local<v8::FunctionTemplate> prototype) {
   prototype->SetClassName(gin::StringToV8(isolate, "WebContents"));
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("_setListenerCount", &WebContents::SetListenerCount)
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
+      .SetMethod("getBackgroundThrottling",
+                 &WebContents::GetBackgroundThrottling)
+      .SetMethod("setRendererPriority", &WebContents::SetRendererPriority)
+      .SetMethod("getRendererPriority", &WebContents::GetRendererPriority)
+      .SetMethod("setNetworkConditions", &WebContents::SetNetworkConditions)
+      .SetMethod("getSyncMessageMetrics", &WebContents::GetSyncMessageMetrics)
+      .SetMethod("setSyncMessageDeadline",
+                 &WebContents::SetSyncMessageDeadline)
       .SetMethod("getProcessId", &WebContents::GetProcessID)
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
       .SetMethod("_getOSProcessIdForFrame",
@@ -2677,6 +3904,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("equal", &WebContents::Equal)
       .SetMethod("_loadURL", &WebContents::LoadURL)
       .SetMethod("downloadURL", &WebContents::DownloadURL)
+      .SetMethod("prefetch", &WebContents::Prefetch)
       .SetMethod("_getURL", &WebContents::GetURL)
       .SetMethod("getTitle", &WebContents::GetTitle)
       .SetMethod("isLoading", &WebContents::IsLoading)
@@ -2689,9 +3917,10 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isCrashed", &WebContents::IsCrashed)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
       .SetMethod("getUserAgent", &WebContents::GetUserAgent)
-      .SetMethod("savePage", &WebContents::SavePage)
+      .SetMethod("_savePage", &WebContents::SavePage)
       .SetMethod("openDevTools", &WebContents::OpenDevTools)
       .SetMethod("closeDevTools", &WebContents::CloseDevTools)
+      .SetMethod("setKeepDevToolsLoaded", &WebContents::SetKeepDevToolsLoaded)
       .SetMethod("isDevToolsOpened", &WebContents::IsDevToolsOpened)
       .SetMethod("isDevToolsFocused", &WebContents::IsDevToolsFocused)
       .SetMethod("enableDeviceEmulation", &WebContents::EnableDeviceEmulation)
@@ -2720,10 +3949,15 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("tabTraverse", &WebContents::TabTraverse)
       .SetMethod("_send", &WebContents::SendIPCMessage)
       .SetMethod("_postMessage", &WebContents::PostMessage)
+      .SetMethod("_createSharedBuffer", &WebContents::CreateSharedBuffer)
       .SetMethod("_sendToFrame", &WebContents::SendIPCMessageToFrame)
+      .SetMethod("_sendToProcesses", &WebContents::SendIPCMessageToProcesses)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("startVideoEncode", &WebContents::StartVideoEncode)
+      .SetMethod("stopVideoEncode", &WebContents::StopVideoEncode)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
       .SetMethod("detachFromOuterFrame", &WebContents::DetachFromOuterFrame)
@@ -2734,6 +3968,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("beginFrame", &WebContents::BeginFrame)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
@@ -2742,6 +3977,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getZoomFactor", &WebContents::GetZoomFactor)
       .SetMethod("getType", &WebContents::GetType)
       .SetMethod("_getPreloadPaths", &WebContents::GetPreloadPaths)
+      .SetMethod("_canProcessAccessURL", &WebContents::CanProcessAccessURL)
       .SetMethod("getWebPreferences", &WebContents::GetWebPreferences)
       .SetMethod("getLastWebPreferences", &WebContents::GetLastWebPreferences)
       .SetMethod("getOwnerBrowserWindow", &WebContents::GetOwnerBrowserWindow)
@@ -2761,6 +3997,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("capturePageToBuffer", &WebContents::CapturePageToBuffer)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -2773,6 +4010,18 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("startSamplingHeapProfiler",
+                 &WebContents::StartSamplingHeapProfiler)
+      .SetMethod("stopSamplingHeapProfiler",
+                 &WebContents::StopSamplingHeapProfiler)
+      .SetMethod("startCPUProfiler", &WebContents::StartCPUProfiler)
+      .SetMethod("stopCPUProfiler", &WebContents::StopCPUProfiler)
+      .SetMethod("trimMemory", &WebContents::TrimMemory)
+      .SetMethod("setLifecyclePolicy", &WebContents::SetLifecyclePolicy)
+      .SetMethod("getLifecyclePolicy", &WebContents::GetLifecyclePolicy)
+      .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("isFrozen", &WebContents::IsFrozen)
+      .SetMethod("isDiscarded", &WebContents::IsDiscarded)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -10,13 +10,17 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/common/frame.mojom.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/keyboard_event_processing_result.h"
 #include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/visibility.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "electron/buildflags/buildflags.h"
@@ -24,11 +28,14 @@
 #include "gin/handle.h"
 #include "mojo/public/cpp/bindings/binding_set.h"
 #include "printing/buildflags/buildflags.h"
+#include "services/network/public/mojom/network_context.mojom.h"
 #include "services/service_manager/public/cpp/binder_registry.h"
+#include "shell/browser/api/frame_encoder.h"
 #include "shell/browser/api/frame_subscriber.h"
 #include "shell/browser/api/save_page_handler.h"
 #include "shell/browser/common_web_contents_delegate.h"
 #include "shell/common/gin_helper/trackable_object.h"
+#include "shell/common/v8_value_serializer.h"
 #include "ui/gfx/image/image.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -64,6 +71,7 @@ namespace electron {
 
 class ElectronBrowserContext;
 class ElectronJavaScriptDialogManager;
+class ForegroundProcessPin;
 class InspectableWebContents;
 class WebContentsZoomController;
 class WebViewGuestDelegate;
@@ -71,6 +79,7 @@ class FrameSubscriber;
 
 #if BUILDFLAG(ENABLE_OSR)
 class OffScreenRenderWidgetHostView;
+struct OffScreenSharedTexture;
 #endif
 
 namespace api {
@@ -152,6 +161,15 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   void DestroyWebContents(bool async);
 
   void SetBackgroundThrottling(bool allowed);
+  bool GetBackgroundThrottling() const;
+  void SetRendererPriority(gin_helper::ErrorThrower thrower,
+                           const std::string& priority);
+  std::string GetRendererPriority() const;
+  void SetNetworkConditions(v8::Local<v8::Value> value,
+                            gin_helper::Arguments* args);
+  // Time the renderer spent blocked in ipcRenderer.sendSync(), per channel.
+  v8::Local<v8::Value> GetSyncMessageMetrics(v8::Isolate* isolate) const;
+  void SetSyncMessageDeadline(gin_helper::Arguments* args);
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
   base::ProcessId GetOSProcessIdForFrame(const std::string& name,
@@ -160,6 +178,7 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   bool Equal(const WebContents* web_contents) const;
   void LoadURL(const GURL& url, const gin_helper::Dictionary& options);
   void DownloadURL(const GURL& url);
+  v8::Local<v8::Promise> Prefetch(const GURL& url);
   GURL GetURL() const;
   base::string16 GetTitle() const;
   bool IsLoading() const;
@@ -177,9 +196,11 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   std::string GetUserAgent();
   void InsertCSS(const std::string& css);
   v8::Local<v8::Promise> SavePage(const base::FilePath& full_file_path,
-                                  const content::SavePageType& save_type);
+                                  const content::SavePageType& save_type,
+                                  gin_helper::Arguments* args);
   void OpenDevTools(gin_helper::Arguments* args);
   void CloseDevTools();
+  void SetKeepDevToolsLoaded(bool keep);
   bool IsDevToolsOpened();
   bool IsDevToolsFocused();
   void ToggleDevTools();
@@ -248,7 +269,7 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   bool SendIPCMessageWithSender(bool internal,
                                 bool send_to_all,
                                 const std::string& channel,
-                                blink::CloneableMessage args,
+                                SerializedValue args,
                                 int32_t sender_id = 0);
 
   bool SendIPCMessageToFrame(bool internal,
@@ -257,16 +278,36 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
                              const std::string& channel,
                              v8::Local<v8::Value> args);
 
+  // Sends the message once to each renderer process hosting frames of the
+  // page that have Electron's bindings, and returns the {processId, frameId}
+  // of the frames it was sent to.
+  v8::Local<v8::Value> SendIPCMessageToProcesses(bool internal,
+                                                 const std::string& channel,
+                                                 v8::Local<v8::Value> args);
+
   void PostMessage(const std::string& channel,
                    v8::Local<v8::Value> message,
                    base::Optional<v8::Local<v8::Value>> transfer);
 
+  // Maps |byte_length| bytes of shared memory in this process and in the
+  // renderer of the main frame, emits |channel| there with a SharedArrayBuffer
+  // over it and the ports in |transfer|, and returns the one of this process.
+  v8::Local<v8::Value> CreateSharedBuffer(
+      gin_helper::ErrorThrower thrower,
+      const std::string& channel,
+      uint32_t byte_length,
+      base::Optional<v8::Local<v8::Value>> transfer);
+
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  void SendInputEvents(v8::Isolate* isolate,
+                       const std::vector<v8::Local<v8::Value>>& input_events);
 
   // Subscribe to the frame updates.
-  void BeginFrameSubscription(gin_helper::Arguments* args);
-  void EndFrameSubscription();
+  int32_t BeginFrameSubscription(gin_helper::Arguments* args);
+  void EndFrameSubscription(gin_helper::Arguments* args);
+  void StartVideoEncode(gin_helper::Arguments* args);
+  void StopVideoEncode();
 
   // Dragging native items.
   void StartDrag(const gin_helper::Dictionary& item,
@@ -275,6 +316,8 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // Captures the page with |rect|, |callback| would be called when capturing is
   // done.
   v8::Local<v8::Promise> CapturePage(gin_helper::Arguments* args);
+  // Like CapturePage, but resolves with the capture encoded in a Buffer.
+  v8::Local<v8::Promise> CapturePageToBuffer(gin_helper::Arguments* args);
 
   // Methods for creating <webview>.
   bool IsGuest() const;
@@ -286,11 +329,14 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   bool IsOffScreen() const;
 #if BUILDFLAG(ENABLE_OSR)
   void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnTexturePaint(const gfx::Rect& dirty_rect,
+                      OffScreenSharedTexture texture);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void BeginFrame();
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
@@ -319,6 +365,10 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // Returns the preload script path of current WebContents.
   std::vector<base::FilePath::StringType> GetPreloadPaths() const;
 
+  // Whether the renderer |process_id| may hold the data of the origin of
+  // |url|, used to keep what a renderer produces for an origin to it.
+  bool CanProcessAccessURL(int process_id, const GURL& url) const;
+
   // Returns the web preferences of current WebContents.
   v8::Local<v8::Value> GetWebPreferences(v8::Isolate* isolate) const;
   v8::Local<v8::Value> GetLastWebPreferences(v8::Isolate* isolate) const;
@@ -331,6 +381,21 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   void GrantOriginAccess(const GURL& url);
 
   v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path);
+  v8::Local<v8::Promise> StartSamplingHeapProfiler(gin_helper::Arguments* args);
+  v8::Local<v8::Promise> StopSamplingHeapProfiler();
+  v8::Local<v8::Promise> StartCPUProfiler(gin_helper::Arguments* args);
+  v8::Local<v8::Promise> StopCPUProfiler();
+
+  // Asks the renderer of the main frame to release the memory it can do
+  // without.
+  v8::Local<v8::Promise> TrimMemory(gin_helper::Arguments* args);
+
+  // Freezing and discarding of the page while it is hidden.
+  void SetLifecyclePolicy(gin_helper::Arguments* args);
+  v8::Local<v8::Value> GetLifecyclePolicy(v8::Isolate* isolate) const;
+  bool Discard();
+  bool IsFrozen() const;
+  bool IsDiscarded() const;
 
   // Properties.
   int32_t ID() const;
@@ -461,7 +526,9 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
                              content::RenderViewHost* new_host) override;
   void RenderViewDeleted(content::RenderViewHost*) override;
   void RenderProcessGone(base::TerminationStatus status) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
   void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
+  void FrameDeleted(content::RenderFrameHost* render_frame_host) override;
   void DOMContentLoaded(content::RenderFrameHost* render_frame_host) override;
   void DidFinishLoad(content::RenderFrameHost* render_frame_host,
                      const GURL& validated_url) override;
@@ -497,6 +564,10 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
       const std::string& interface_name,
       mojo::ScopedMessagePipeHandle* interface_pipe) override;
   void DidAcquireFullscreen(content::RenderFrameHost* rfh) override;
+  void ResourceLoadComplete(
+      content::RenderFrameHost* render_frame_host,
+      const content::GlobalRequestID& request_id,
+      const blink::mojom::ResourceLoadInfo& resource_load_info) override;
 
   // InspectableWebContentsDelegate:
   void DevToolsReloadPage() override;
@@ -517,18 +588,41 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
 
   uint32_t GetNextRequestId() { return ++request_id_; }
 
+  // Starts the timers of the lifecycle policy when the page is hidden.
+  void ScheduleLifecycleChanges();
+  void SetFrozen(bool frozen);
+
+  // Throttles the requests of |render_frame_host| by |network_conditions_|,
+  // none when it is null.
+  void ApplyNetworkConditions(content::RenderFrameHost* render_frame_host);
+  void OnDiscardTimer();
+
 #if BUILDFLAG(ENABLE_OSR)
   OffScreenWebContentsView* GetOffScreenWebContentsView() const override;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
+  // The event object of "paint", with the timing of the frame.
+  v8::Local<v8::Object> CreatePaintEvent();
 #endif
 
   // mojom::ElectronBrowser
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments) override;
+               blink::CloneableMessage arguments,
+               std::vector<base::ReadOnlySharedMemoryRegion> array_buffers)
+      override;
+  void MessageWithAck(
+      bool internal,
+      const std::string& channel,
+      blink::CloneableMessage arguments,
+      std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
+      MessageWithAckCallback callback) override;
+  void MessageBatch(std::vector<mojom::BatchedMessagePtr> messages) override;
+  void MessageBatchWithAck(std::vector<mojom::BatchedMessagePtr> messages,
+                           MessageBatchWithAckCallback callback) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
+              std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
               InvokeCallback callback) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
@@ -540,18 +634,53 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
                  bool send_to_all,
                  int32_t web_contents_id,
                  const std::string& channel,
-                 blink::CloneableMessage arguments) override;
+                 blink::CloneableMessage arguments,
+                 std::vector<base::ReadOnlySharedMemoryRegion> array_buffers)
+      override;
+  void ConnectToWebContents(
+      int32_t web_contents_id,
+      mojo::PendingReceiver<mojom::ElectronRendererPeer> receiver) override;
   void MessageHost(const std::string& channel,
-                   blink::CloneableMessage arguments) override;
+                   blink::CloneableMessage arguments,
+                   std::vector<base::ReadOnlySharedMemoryRegion> array_buffers)
+      override;
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-  void DereferenceRemoteJSObject(const std::string& context_id,
-                                 int object_id,
-                                 int ref_count) override;
+  void DereferenceRemoteJSObjects(
+      std::vector<mojom::RemoteObjectDereferencePtr> objects) override;
 #endif
   void UpdateDraggableRegions(
       std::vector<mojom::DraggableRegionPtr> regions) override;
   void SetTemporaryZoomLevel(double level) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
+  void GetSystemSnapshot(GetSystemSnapshotCallback callback) override;
+
+  struct PendingSyncMessage;
+  struct SyncMessageMetrics {
+    uint32_t count = 0;
+    uint32_t deadline_exceeded_count = 0;
+    base::TimeDelta total_time;
+    base::TimeDelta max_time;
+  };
+
+  void OnSyncMessageReply(scoped_refptr<PendingSyncMessage> pending,
+                          blink::CloneableMessage result);
+  void OnSyncMessageDeadline(scoped_refptr<PendingSyncMessage> pending);
+  void RecordSyncMessage(const PendingSyncMessage& pending);
+
+  void OnVideoEncodeError(const std::string& error);
+
+  // Reads the rect and options arguments of CapturePage, and computes the
+  // area to copy and the size to scale it to. Returns false when there is
+  // no view to capture.
+  bool GetCaptureArea(gin_helper::Arguments* args,
+                      gin_helper::Dictionary* options,
+                      gfx::Rect* source_rect,
+                      gfx::Size* bitmap_size);
+
+  // Returns false when |input_event| is not a valid event.
+  bool DispatchInputEvent(v8::Isolate* isolate,
+                          v8::Local<v8::Value> input_event);
+  void DispatchMouseEvent(const blink::WebMouseEvent& mouse_event);
 
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
@@ -570,7 +699,11 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
 
   std::unique_ptr<ElectronJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
-  std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  // Subscriptions started with options by their ID, the one started without
+  // options is kept at 0.
+  std::map<int32_t, std::unique_ptr<FrameSubscriber>> frame_subscribers_;
+  int32_t last_frame_subscription_id_ = 0;
+  std::unique_ptr<FrameEncoder> frame_encoder_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ScriptExecutor> script_executor_;
@@ -591,12 +724,43 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // Whether background throttling is disabled.
   bool background_throttling_ = true;
 
+  // Set while the renderer is kept at the foreground priority when the page
+  // is hidden.
+  std::unique_ptr<ForegroundProcessPin> foreground_process_pin_;
+
+  // The network conditions emulated for the requests of the frames, null for
+  // none.
+  network::mojom::NetworkConditionsPtr network_conditions_;
+
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
+  // How long the page stays hidden before it is frozen and before its
+  // renderer is discarded, zero to never do it.
+  base::TimeDelta freeze_delay_;
+  base::TimeDelta discard_delay_;
+  base::OneShotTimer freeze_timer_;
+  base::OneShotTimer discard_timer_;
+  bool frozen_ = false;
+  // Whether the renderer was shut down by Discard(), the page is loaded again
+  // when it is shown.
+  bool discarded_ = false;
+
+#if BUILDFLAG(ENABLE_OSR)
+  // Whether the paint event only carries the damaged area of frames.
+  bool paint_only_dirty_ = false;
+#endif
+
   // Observers of this WebContents.
   base::ObserverList<ExtendedWebContentsObserver> observers_;
 
+  // How long a sendSync() can block the renderer before it is reported, zero
+  // when there is no deadline.
+  base::TimeDelta sync_message_deadline_;
+  // Whether sendSync() fails in the renderer once the deadline is exceeded.
+  bool fail_sync_message_at_deadline_ = false;
+  std::map<std::string, SyncMessageMetrics> sync_message_metrics_;
+
   // The ID of the process of the currently committed RenderViewHost.
   // -1 means no speculative RVH has been committed yet.
   int currently_committed_process_id_ = -1;
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/stl_util.h"
 #include "base/values.h"
@@ -21,6 +22,7 @@
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 
 namespace gin {
 
@@ -89,12 +91,16 @@ struct UserData : public base::SupportsUserData::Data {
 
 // Test whether the URL of |request| matches |patterns|.
 bool MatchesFilterCondition(extensions::WebRequestInfo* info,
-                            const std::set<URLPattern>& patterns) {
-  if (patterns.empty())
-    return true;
+                            const URLPatternMatcher& patterns) {
+  return patterns.empty() || patterns.MatchesURL(info->url);
+}
 
-  for (const auto& pattern : patterns) {
-    if (pattern.MatchesURL(info->url))
+// Test whether the filter of any of |listeners| matches |url|.
+template <typename Listeners>
+bool AnyListenerMatches(const Listeners& listeners, const GURL& url) {
+  for (const auto& it : listeners) {
+    const URLPatternMatcher& patterns = it.second.url_patterns;
+    if (patterns.empty() || patterns.MatchesURL(url))
       return true;
   }
   return false;
@@ -210,21 +216,41 @@ void ReadFromResponse(v8::Isolate* isolate,
   }
 }
 
+// Reads the header edits of a rule, a null value removes the header.
+bool GetHeaderEdits(const gin_helper::Dictionary& dict,
+                    const char* key,
+                    WebRequestRules::HeaderEdits* edits) {
+  if (!dict.Has(key))
+    return true;
+  base::DictionaryValue headers;
+  if (!dict.Get(key, &headers))
+    return false;
+  for (const auto& it : headers.DictItems()) {
+    if (it.second.is_string())
+      (*edits)[it.first] = it.second.GetString();
+    else if (it.second.is_none())
+      (*edits)[it.first] = base::nullopt;
+    else
+      return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     SimpleListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::SimpleListenerInfo::SimpleListenerInfo() = default;
 WebRequest::SimpleListenerInfo::~SimpleListenerInfo() = default;
 
 WebRequest::ResponseListenerInfo::ResponseListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     ResponseListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
@@ -255,7 +281,8 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
                  &WebRequest::SetSimpleListener<kOnResponseStarted>)
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<kOnErrorOccurred>)
-      .SetMethod("onCompleted", &WebRequest::SetSimpleListener<kOnCompleted>);
+      .SetMethod("onCompleted", &WebRequest::SetSimpleListener<kOnCompleted>)
+      .SetMethod("setRules", &WebRequest::SetRules);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -263,13 +290,23 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
+}
+
+bool WebRequest::HasListenerForURL(const GURL& url) const {
+  return AnyListenerMatches(simple_listeners_, url) ||
+         AnyListenerMatches(response_listeners_, url) || rules_.MatchesURL(url);
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  // Requests blocked or redirected by a rule never reach the listener.
+  int result = rules_.OnBeforeRequest(info->url, new_url);
+  if (result != net::OK || !new_url->is_empty())
+    return result;
   return HandleResponseEvent(kOnBeforeRequest, info, std::move(callback),
                              new_url, request);
 }
@@ -278,6 +315,7 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  rules_.OnBeforeSendHeaders(info->url, headers);
   return HandleResponseEvent(
       kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -292,6 +330,10 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  scoped_refptr<net::HttpResponseHeaders> headers =
+      rules_.OnHeadersReceived(info->url, original_response_headers);
+  if (headers)
+    *override_response_headers = headers;
   return HandleResponseEvent(
       kOnHeadersReceived, info, std::move(callback),
       std::make_pair(override_response_headers,
@@ -393,7 +435,65 @@ void WebRequest::SetListener(Event event,
   if (listener.is_null())
     listeners->erase(event);
   else
-    (*listeners)[event] = {std::move(patterns), std::move(listener)};
+    (*listeners)[event] = {patterns, std::move(listener)};
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  std::vector<gin_helper::Dictionary> dicts;
+  if (!args->GetNext(&dicts)) {
+    args->ThrowTypeError("Must pass an array of rules");
+    return;
+  }
+
+  std::vector<WebRequestRules::Rule> rules;
+  for (const auto& dict : dicts) {
+    WebRequestRules::Rule rule;
+    std::set<std::string> filter_patterns;
+    if (dict.Has("urls") && !dict.Get("urls", &filter_patterns)) {
+      args->ThrowTypeError("Property 'urls' must be an array of strings");
+      return;
+    }
+    for (const std::string& filter_pattern : filter_patterns) {
+      URLPattern pattern(URLPattern::SCHEME_ALL);
+      const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+      if (result != URLPattern::ParseResult::kSuccess) {
+        const char* error_type = URLPattern::GetParseResultString(result);
+        args->ThrowTypeError("Invalid url pattern " + filter_pattern + ": " +
+                             error_type);
+        return;
+      }
+      rule.url_patterns.insert(pattern);
+    }
+
+    std::string action;
+    dict.Get("action", &action);
+    if (action == "allow") {
+      rule.action = WebRequestRules::Action::kAllow;
+    } else if (action == "block") {
+      rule.action = WebRequestRules::Action::kBlock;
+    } else if (action == "redirect") {
+      rule.action = WebRequestRules::Action::kRedirect;
+      if (!dict.Get("redirectURL", &rule.redirect_url) ||
+          !rule.redirect_url.is_valid()) {
+        args->ThrowTypeError("Redirect rules must have a valid 'redirectURL'");
+        return;
+      }
+    } else if (action == "modifyHeaders") {
+      rule.action = WebRequestRules::Action::kModifyHeaders;
+      if (!GetHeaderEdits(dict, "requestHeaders", &rule.request_headers) ||
+          !GetHeaderEdits(dict, "responseHeaders", &rule.response_headers)) {
+        args->ThrowTypeError(
+            "Header values must be strings, or null to remove the header");
+        return;
+      }
+    } else {
+      args->ThrowTypeError("Invalid rule action '" + action + "'");
+      return;
+    }
+    rules.push_back(std::move(rule));
+  }
+
+  rules_ = WebRequestRules(rules);
 }
 
 template <typename... Args>
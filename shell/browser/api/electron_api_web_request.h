@@ -13,7 +13,9 @@
 #include "gin/arguments.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/net/url_pattern_matcher.h"
 #include "shell/browser/net/web_request_api_interface.h"
+#include "shell/browser/net/web_request_rules.h"
 
 namespace content {
 class BrowserContext;
@@ -51,6 +53,7 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
 
   // WebRequestAPI:
   bool HasListener() const override;
+  bool HasListenerForURL(const GURL& url) const override;
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -104,6 +107,8 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   using ResponseListener =
       base::RepeatingCallback<void(v8::Local<v8::Value>, ResponseCallback)>;
 
+  void SetRules(gin::Arguments* args);
+
   template <SimpleEvent event>
   void SetSimpleListener(gin::Arguments* args);
   template <ResponseEvent event>
@@ -126,19 +131,19 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
   struct SimpleListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternMatcher url_patterns;
     SimpleListener listener;
 
-    SimpleListenerInfo(std::set<URLPattern>, SimpleListener);
+    SimpleListenerInfo(const std::set<URLPattern>&, SimpleListener);
     SimpleListenerInfo();
     ~SimpleListenerInfo();
   };
 
   struct ResponseListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternMatcher url_patterns;
     ResponseListener listener;
 
-    ResponseListenerInfo(std::set<URLPattern>, ResponseListener);
+    ResponseListenerInfo(const std::set<URLPattern>&, ResponseListener);
     ResponseListenerInfo();
     ~ResponseListenerInfo();
   };
@@ -147,6 +152,9 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
+  // Applied before the listeners are called.
+  WebRequestRules rules_;
+
   // Weak-ref, it manages us.
   content::BrowserContext* browser_context_;
 };
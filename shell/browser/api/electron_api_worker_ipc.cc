@@ -0,0 +1,74 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "content/public/browser/browser_thread.h"
+#include "shell/browser/worker_ipc_queue.h"
+#include "shell/browser/worker_ipc_router.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/node_includes.h"
+
+namespace {
+
+using electron::WorkerIPCQueue;
+using electron::WorkerIPCRouter;
+
+int CreatePool() {
+  return WorkerIPCRouter::GetInstance()->CreatePool();
+}
+
+void DestroyPool(int pool_id) {
+  WorkerIPCRouter::GetInstance()->DestroyPool(pool_id);
+}
+
+bool Bind(const std::string& channel, int pool_id) {
+  return WorkerIPCRouter::GetInstance()->Bind(channel, pool_id);
+}
+
+void Unbind(const std::string& channel) {
+  WorkerIPCRouter::GetInstance()->Unbind(channel);
+}
+
+// Called by a worker of the pool once it can handle invokes, returns false
+// when the pool is gone.
+bool Attach(gin_helper::ErrorThrower thrower,
+            int pool_id,
+            v8::Local<v8::Function> dispatch) {
+  if (content::BrowserThread::CurrentlyOn(content::BrowserThread::UI) ||
+      WorkerIPCQueue::GetCurrent()) {
+    thrower.ThrowError("Invokes can only be attached once per worker thread");
+    return false;
+  }
+  scoped_refptr<WorkerIPCQueue> queue =
+      WorkerIPCQueue::Create(pool_id, thrower.isolate(), dispatch);
+  if (!WorkerIPCRouter::GetInstance()->AddQueue(queue)) {
+    queue->Close();
+    return false;
+  }
+  return true;
+}
+
+bool Reply(int reply_id, v8::Local<v8::Value> result) {
+  WorkerIPCQueue* queue = WorkerIPCQueue::GetCurrent();
+  return queue && queue->Reply(reply_id, result);
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("createPool", &CreatePool);
+  dict.SetMethod("destroyPool", &DestroyPool);
+  dict.SetMethod("bind", &Bind);
+  dict.SetMethod("unbind", &Unbind);
+  dict.SetMethod("attach", &Attach);
+  dict.SetMethod("reply", &Reply);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_browser_worker_ipc, Initialize)
@@ -0,0 +1,387 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/frame_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "content/browser/gpu/gpu_process_host.h"  // nogncheck
+#include "content/public/browser/gpu_data_manager.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "gpu/config/gpu_info.h"
+#include "media/base/bind_to_current_loop.h"
+#include "media/base/video_frame.h"
+#include "media/mojo/clients/mojo_video_encode_accelerator.h"
+#include "media/mojo/mojom/video_encode_accelerator.mojom.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/viz/privileged/mojom/gl/gpu_service.mojom.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Encoded chunks are copied out as soon as they are ready, a few buffers are
+// enough to keep the encoder busy.
+constexpr int32_t kOutputBufferCount = 4;
+
+}  // namespace
+
+class FrameEncoder::Core : public media::VideoEncodeAccelerator::Client {
+ public:
+  Core(scoped_refptr<base::SequencedTaskRunner> owner_task_runner,
+       base::WeakPtr<FrameEncoder> owner)
+      : owner_task_runner_(std::move(owner_task_runner)), owner_(owner) {}
+  ~Core() override = default;
+
+  void Initialize(
+      mojo::PendingRemote<media::mojom::VideoEncodeAcceleratorProvider>
+          provider,
+      const media::VideoEncodeAccelerator::Config& config) {
+    provider_.Bind(std::move(provider));
+    mojo::PendingRemote<media::mojom::VideoEncodeAccelerator> vea;
+    provider_->CreateVideoEncodeAccelerator(
+        vea.InitWithNewPipeAndPassReceiver());
+    encoder_ = std::make_unique<media::MojoVideoEncodeAccelerator>(
+        std::move(vea), media::VideoEncodeAccelerator::SupportedProfiles());
+    if (!encoder_->Initialize(config, this)) {
+      encoder_.reset();
+      PostError("Failed to initialize the video encoder");
+    }
+  }
+
+  void Encode(scoped_refptr<media::VideoFrame> frame) {
+    if (!encoder_ || failed_)
+      return;
+    encoder_->Encode(std::move(frame), force_key_frame_);
+    force_key_frame_ = false;
+  }
+
+  // media::VideoEncodeAccelerator::Client:
+  void RequireBitstreamBuffers(unsigned int input_count,
+                               const gfx::Size& input_coded_size,
+                               size_t output_buffer_size) override {
+    output_buffers_.clear();
+    for (int32_t id = 0; id < kOutputBufferCount; ++id) {
+      OutputBuffer buffer;
+      buffer.region =
+          base::UnsafeSharedMemoryRegion::Create(output_buffer_size);
+      buffer.mapping = buffer.region.Map();
+      if (!buffer.mapping.IsValid()) {
+        failed_ = true;
+        PostError("Failed to allocate the video encoder output");
+        return;
+      }
+      output_buffers_.push_back(std::move(buffer));
+      UseOutputBuffer(id);
+    }
+    owner_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&FrameEncoder::OnEncoderReady, owner_,
+                                  input_coded_size));
+  }
+
+  void BitstreamBufferReady(
+      int32_t id,
+      const media::BitstreamBufferMetadata& metadata) override {
+    if (id < 0 || static_cast<size_t>(id) >= output_buffers_.size())
+      return;
+    const OutputBuffer& buffer = output_buffers_[id];
+    const uint8_t* data = buffer.mapping.GetMemoryAs<uint8_t>();
+    size_t size = std::min(metadata.payload_size_bytes, buffer.mapping.size());
+    std::vector<uint8_t> chunk(data, data + size);
+    UseOutputBuffer(id);
+    owner_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&FrameEncoder::OnChunk, owner_, std::move(chunk),
+                       metadata.key_frame, metadata.timestamp));
+  }
+
+  void NotifyError(media::VideoEncodeAccelerator::Error error) override {
+    // The encoder can not be destroyed from its own callback, the owner
+    // destroys it with this object.
+    failed_ = true;
+    PostError("Video encoder error " + base::NumberToString(error));
+  }
+
+ private:
+  struct OutputBuffer {
+    base::UnsafeSharedMemoryRegion region;
+    base::WritableSharedMemoryMapping mapping;
+  };
+
+  void UseOutputBuffer(int32_t id) {
+    const OutputBuffer& buffer = output_buffers_[id];
+    encoder_->UseOutputBitstreamBuffer(media::BitstreamBuffer(
+        id, buffer.region.Duplicate(), buffer.region.GetSize()));
+  }
+
+  void PostError(const std::string& error) {
+    owner_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&FrameEncoder::OnEncoderError, owner_, error));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> owner_task_runner_;
+  base::WeakPtr<FrameEncoder> owner_;
+
+  mojo::Remote<media::mojom::VideoEncodeAcceleratorProvider> provider_;
+  std::unique_ptr<media::VideoEncodeAccelerator> encoder_;
+  std::vector<OutputBuffer> output_buffers_;
+  bool force_key_frame_ = true;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+FrameEncoder::FrameEncoder(content::WebContents* web_contents,
+                           const Options& options,
+                           const ChunkCallback& chunk_callback,
+                           ErrorCallback error_callback)
+    : content::WebContentsObserver(web_contents),
+      options_(options),
+      chunk_callback_(chunk_callback),
+      error_callback_(std::move(error_callback)),
+      encoder_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::WithBaseSyncPrimitives(),
+           base::TaskPriority::USER_BLOCKING})),
+      core_(nullptr, base::OnTaskRunnerDeleter(encoder_task_runner_)) {
+  visible_size_ = options_.size;
+  content::RenderWidgetHostView* view = web_contents->GetRenderWidgetHostView();
+  if (visible_size_.IsEmpty() && view) {
+    visible_size_ = gfx::ToRoundedSize(
+        gfx::ScaleSize(gfx::SizeF(view->GetViewBounds().size()),
+                       view->GetDeviceScaleFactor()));
+  }
+  // Encoders only take frames with even sizes.
+  visible_size_.SetSize(visible_size_.width() & ~1,
+                        visible_size_.height() & ~1);
+  if (visible_size_.IsEmpty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&FrameEncoder::OnEncoderError,
+                                  weak_ptr_factory_.GetWeakPtr(),
+                                  "The page has no size to encode"));
+    return;
+  }
+
+  core_.reset(new Core(base::ThreadTaskRunnerHandle::Get(),
+                       weak_ptr_factory_.GetWeakPtr()));
+
+  mojo::PendingRemote<media::mojom::VideoEncodeAcceleratorProvider> provider;
+  content::GpuProcessHost::CallOnIO(
+      content::GPU_PROCESS_KIND_SANDBOXED, false /* force_create */,
+      base::BindOnce(
+          [](mojo::PendingReceiver<media::mojom::VideoEncodeAcceleratorProvider>
+                 receiver,
+             content::GpuProcessHost* host) {
+            if (host) {
+              host->gpu_service()->CreateVideoEncodeAcceleratorProvider(
+                  std::move(receiver));
+            }
+          },
+          provider.InitWithNewPipeAndPassReceiver()));
+
+  media::VideoEncodeAccelerator::Config config(
+      media::PIXEL_FORMAT_I420, visible_size_, options_.profile,
+      options_.bitrate, options_.frame_rate);
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::Initialize, base::Unretained(core_.get()),
+                     std::move(provider), config));
+}
+
+FrameEncoder::~FrameEncoder() = default;
+
+// static
+bool FrameEncoder::IsProfileSupported(media::VideoCodecProfile profile) {
+  const gpu::GPUInfo& info =
+      content::GpuDataManager::GetInstance()->GetGPUInfo();
+  for (const auto& supported :
+       info.video_encode_accelerator_supported_profiles) {
+    if (static_cast<int>(supported.profile) == static_cast<int>(profile))
+      return true;
+  }
+  return false;
+}
+
+void FrameEncoder::AttachToHost(content::RenderWidgetHost* host) {
+  host_ = host;
+
+  // The view can be null if the renderer process has crashed.
+  if (!host_->GetView())
+    return;
+
+  video_capturer_ = host_->GetView()->CreateVideoCapturer();
+  video_capturer_->SetResolutionConstraints(visible_size_, visible_size_, true);
+  video_capturer_->SetAutoThrottlingEnabled(false);
+  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
+  video_capturer_->SetFormat(media::PIXEL_FORMAT_I420,
+                             gfx::ColorSpace::CreateREC709());
+  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
+                                       options_.frame_rate);
+  video_capturer_->Start(this);
+}
+
+void FrameEncoder::DetachFromHost() {
+  if (!host_)
+    return;
+  video_capturer_.reset();
+  host_ = nullptr;
+}
+
+void FrameEncoder::RenderViewCreated(content::RenderViewHost* host) {
+  if (!host_ && !input_coded_size_.IsEmpty())
+    AttachToHost(host->GetWidget());
+}
+
+void FrameEncoder::RenderViewDeleted(content::RenderViewHost* host) {
+  if (host->GetWidget() == host_)
+    DetachFromHost();
+}
+
+void FrameEncoder::RenderViewHostChanged(content::RenderViewHost* old_host,
+                                         content::RenderViewHost* new_host) {
+  if (input_coded_size_.IsEmpty())
+    return;
+  if ((old_host && old_host->GetWidget() == host_) || (!old_host && !host_)) {
+    DetachFromHost();
+    AttachToHost(new_host->GetWidget());
+  }
+}
+
+void FrameEncoder::OnFrameCaptured(
+    base::ReadOnlySharedMemoryRegion data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& content_rect,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      callbacks_remote(std::move(callbacks));
+  if (!data.IsValid() || info->pixel_format != media::PIXEL_FORMAT_I420) {
+    callbacks_remote->Done();
+    return;
+  }
+  base::ReadOnlySharedMemoryMapping mapping = data.Map();
+  if (!mapping.IsValid() ||
+      mapping.size() < media::VideoFrame::AllocationSize(info->pixel_format,
+                                                         info->coded_size)) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  auto source = media::VideoFrame::WrapExternalData(
+      info->pixel_format, info->coded_size, info->visible_rect,
+      info->visible_rect.size(), mapping.GetMemoryAs<uint8_t>(),
+      mapping.size(), info->timestamp);
+  std::unique_ptr<base::MappedReadOnlyRegion> buffer = TakeInputBuffer();
+  if (!source || !buffer) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  // The encoder may need larger coded sizes than the capturer produces, so
+  // the frame is copied into shared memory the encoder can take as is.
+  auto frame = media::VideoFrame::WrapExternalData(
+      media::PIXEL_FORMAT_I420, input_coded_size_, gfx::Rect(visible_size_),
+      visible_size_, buffer->mapping.GetMemoryAs<uint8_t>(),
+      buffer->mapping.size(), info->timestamp);
+  if (!frame) {
+    callbacks_remote->Done();
+    return;
+  }
+  frame->BackWithSharedMemory(&buffer->region);
+
+  int width = std::min(source->visible_rect().width(), visible_size_.width());
+  int height =
+      std::min(source->visible_rect().height(), visible_size_.height());
+  libyuv::I420Copy(
+      source->visible_data(media::VideoFrame::kYPlane),
+      source->stride(media::VideoFrame::kYPlane),
+      source->visible_data(media::VideoFrame::kUPlane),
+      source->stride(media::VideoFrame::kUPlane),
+      source->visible_data(media::VideoFrame::kVPlane),
+      source->stride(media::VideoFrame::kVPlane),
+      frame->visible_data(media::VideoFrame::kYPlane),
+      frame->stride(media::VideoFrame::kYPlane),
+      frame->visible_data(media::VideoFrame::kUPlane),
+      frame->stride(media::VideoFrame::kUPlane),
+      frame->visible_data(media::VideoFrame::kVPlane),
+      frame->stride(media::VideoFrame::kVPlane), width, height);
+  callbacks_remote->Done();
+
+  // The memory goes back to the pool once the encoder releases the frame.
+  frame->AddDestructionObserver(media::BindToCurrentLoop(
+      base::BindOnce(&FrameEncoder::ReturnInputBuffer,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(buffer))));
+  encoder_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Core::Encode, base::Unretained(core_.get()),
+                                std::move(frame)));
+}
+
+void FrameEncoder::OnStopped() {}
+
+void FrameEncoder::OnEncoderReady(const gfx::Size& input_coded_size) {
+  input_coded_size_ = input_coded_size;
+  content::RenderViewHost* rvh = web_contents()->GetRenderViewHost();
+  if (rvh && !host_)
+    AttachToHost(rvh->GetWidget());
+}
+
+void FrameEncoder::OnChunk(std::vector<uint8_t> data,
+                           bool key_frame,
+                           base::TimeDelta timestamp) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary info = gin::Dictionary::CreateEmpty(isolate);
+  info.Set("keyFrame", key_frame);
+  info.Set("timestamp", timestamp.InMillisecondsF());
+  chunk_callback_.Run(
+      node::Buffer::Copy(isolate, reinterpret_cast<const char*>(data.data()),
+                         data.size())
+          .ToLocalChecked(),
+      info);
+}
+
+void FrameEncoder::OnEncoderError(const std::string& error) {
+  DetachFromHost();
+  // Running the callback may destroy this object.
+  if (error_callback_)
+    std::move(error_callback_).Run(error);
+}
+
+std::unique_ptr<base::MappedReadOnlyRegion> FrameEncoder::TakeInputBuffer() {
+  if (!free_buffers_.empty()) {
+    auto buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+    return buffer;
+  }
+  auto buffer = std::make_unique<base::MappedReadOnlyRegion>(
+      base::ReadOnlySharedMemoryRegion::Create(
+          media::VideoFrame::AllocationSize(media::PIXEL_FORMAT_I420,
+                                            input_coded_size_)));
+  if (!buffer->IsValid())
+    return nullptr;
+  return buffer;
+}
+
+void FrameEncoder::ReturnInputBuffer(
+    std::unique_ptr<base::MappedReadOnlyRegion> buffer) {
+  free_buffers_.push_back(std::move(buffer));
+}
+
+}  // namespace api
+
+}  // namespace electron
@@ -0,0 +1,119 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_FRAME_ENCODER_H_
+#define SHELL_BROWSER_API_FRAME_ENCODER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "ui/gfx/geometry/size.h"
+#include "v8/include/v8.h"
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace electron {
+
+namespace api {
+
+// Captures the frames of a WebContents and encodes them with the hardware
+// encoder of the GPU process, the frames never reach JS.
+class FrameEncoder : public content::WebContentsObserver,
+                     public viz::mojom::FrameSinkVideoConsumer {
+ public:
+  // Called with a Buffer holding an encoded chunk, and its info.
+  using ChunkCallback =
+      base::RepeatingCallback<void(v8::Local<v8::Value>,
+                                   const gin_helper::Dictionary&)>;
+  using ErrorCallback = base::OnceCallback<void(const std::string&)>;
+
+  struct Options {
+    media::VideoCodecProfile profile = media::H264PROFILE_BASELINE;
+    // Frames are scaled to fit in |size| keeping the aspect ratio, they have
+    // the size of the view when it is empty.
+    gfx::Size size;
+    int frame_rate = 30;
+    uint32_t bitrate = 5000000;
+  };
+
+  FrameEncoder(content::WebContents* web_contents,
+               const Options& options,
+               const ChunkCallback& chunk_callback,
+               ErrorCallback error_callback);
+  ~FrameEncoder() override;
+
+  // Whether the GPU reported a hardware encoder for |profile|.
+  static bool IsProfileSupported(media::VideoCodecProfile profile);
+
+ private:
+  // Owns the encoder on a sequence that allows the sync calls it makes.
+  class Core;
+
+  void AttachToHost(content::RenderWidgetHost* host);
+  void DetachFromHost();
+
+  // content::WebContentsObserver:
+  void RenderViewCreated(content::RenderViewHost* host) override;
+  void RenderViewDeleted(content::RenderViewHost* host) override;
+  void RenderViewHostChanged(content::RenderViewHost* old_host,
+                             content::RenderViewHost* new_host) override;
+
+  // viz::mojom::FrameSinkVideoConsumer implementation.
+  void OnFrameCaptured(
+      base::ReadOnlySharedMemoryRegion data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& content_rect,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks) override;
+  void OnStopped() override;
+
+  // Called by |core_|.
+  void OnEncoderReady(const gfx::Size& input_coded_size);
+  void OnChunk(std::vector<uint8_t> data,
+               bool key_frame,
+               base::TimeDelta timestamp);
+  void OnEncoderError(const std::string& error);
+
+  std::unique_ptr<base::MappedReadOnlyRegion> TakeInputBuffer();
+  void ReturnInputBuffer(std::unique_ptr<base::MappedReadOnlyRegion> buffer);
+
+  Options options_;
+  // The size of the encoded frames.
+  gfx::Size visible_size_;
+  // The size of the frames the encoder takes, empty until it is ready.
+  gfx::Size input_coded_size_;
+  ChunkCallback chunk_callback_;
+  ErrorCallback error_callback_;
+
+  scoped_refptr<base::SequencedTaskRunner> encoder_task_runner_;
+  std::unique_ptr<Core, base::OnTaskRunnerDeleter> core_;
+
+  // Shared memory for the input frames that the encoder has released.
+  std::vector<std::unique_ptr<base::MappedReadOnlyRegion>> free_buffers_;
+
+  content::RenderWidgetHost* host_ = nullptr;
+  std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
+
+  base::WeakPtrFactory<FrameEncoder> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(FrameEncoder);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_FRAME_ENCODER_H_
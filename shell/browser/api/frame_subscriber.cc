@@ -4,13 +4,20 @@
 
 #include "shell/browser/api/frame_subscriber.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/image_converter.h"
+#include "shell/common/node_includes.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/convert_from.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
@@ -19,14 +26,12 @@ namespace electron {
 
 namespace api {
 
-constexpr static int kMaxFrameRate = 30;
-
 FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const Options& options)
     : content::WebContentsObserver(web_contents),
       callback_(callback),
-      only_dirty_(only_dirty),
+      options_(options),
       weak_ptr_factory_(this) {
   content::RenderViewHost* rvh = web_contents->GetRenderViewHost();
   if (rvh)
@@ -44,15 +49,14 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
     return;
 
   // Create and configure the video capturer.
-  gfx::Size size = GetRenderViewSize();
+  gfx::Size size = GetCaptureSize();
   video_capturer_ = host_->GetView()->CreateVideoCapturer();
   video_capturer_->SetResolutionConstraints(size, size, true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB,
-                             gfx::ColorSpace::CreateREC709());
+  video_capturer_->SetFormat(GetCaptureFormat(), options_.color_space);
   video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
-                                       kMaxFrameRate);
+                                       options_.frame_rate);
   video_capturer_->Start(this);
 }
 
@@ -88,11 +92,15 @@ void FrameSubscriber::OnFrameCaptured(
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
-  gfx::Size size = GetRenderViewSize();
-  if (size != content_rect.size()) {
-    video_capturer_->SetResolutionConstraints(size, size, true);
-    video_capturer_->RequestRefreshFrame();
-    return;
+  // Frames scaled to a fixed size are letterboxed when the aspect ratio of
+  // the view changes, so their content can be smaller than the frame.
+  if (options_.size.IsEmpty()) {
+    gfx::Size size = GetRenderViewSize();
+    if (size != content_rect.size()) {
+      video_capturer_->SetResolutionConstraints(size, size, true);
+      video_capturer_->RequestRefreshFrame();
+      return;
+    }
   }
 
   mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
@@ -112,9 +120,21 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  if (info->pixel_format == media::PIXEL_FORMAT_I420) {
+    DoneYUV(mapping, *info, content_rect);
+    callbacks_remote->Done();
+    return;
+  }
+
+  size_t row_bytes = media::VideoFrame::RowBytes(
+      media::VideoFrame::kARGBPlane, info->pixel_format,
+      info->coded_size.width());
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
-  void* const pixels = const_cast<void*>(mapping.memory());
+  void* const pixels =
+      const_cast<uint8_t*>(static_cast<const uint8_t*>(mapping.memory())) +
+      content_rect.y() * row_bytes + content_rect.x() * 4;
 
   // Call installPixels() with a |releaseProc| that: 1) notifies the capturer
   // that this consumer has finished with the frame, and 2) releases the shared
@@ -131,16 +151,14 @@ void FrameSubscriber::OnFrameCaptured(
   bitmap.installPixels(
       SkImageInfo::MakeN32(content_rect.width(), content_rect.height(),
                            kPremul_SkAlphaType),
-      pixels,
-      media::VideoFrame::RowBytes(media::VideoFrame::kARGBPlane,
-                                  info->pixel_format, info->coded_size.width()),
+      pixels, row_bytes,
       [](void* addr, void* context) {
         delete static_cast<FramePinner*>(context);
       },
       new FramePinner{std::move(mapping), std::move(callbacks_remote)});
   bitmap.setImmutable();
 
-  Done(content_rect, bitmap);
+  Done(gfx::Rect(content_rect.size()), bitmap);
 }
 
 void FrameSubscriber::OnStopped() {}
@@ -149,10 +167,16 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   if (frame.drawsNothing())
     return;
 
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  if (options_.raw) {
+    DoneRaw(damage, frame);
+    return;
+  }
+
+  const SkBitmap& bitmap =
+      options_.only_dirty
+          ? SkBitmapOperations::CreateTiledBitmap(
+                frame, damage.x(), damage.y(), damage.width(), damage.height())
+          : frame;
 
   // Copying SkBitmap does not copy the internal pixels, we have to manually
   // allocate and write pixels otherwise crash may happen when the original
@@ -165,7 +189,96 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   bool success = bitmap.peekPixels(&pixmap) && copy.writePixels(pixmap, 0, 0);
   CHECK(success);
 
-  callback_.Run(gfx::Image::CreateFrom1xBitmap(copy), damage);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  callback_.Run(gin::ConvertToV8(isolate, gfx::Image::CreateFrom1xBitmap(copy)),
+                damage);
+}
+
+void FrameSubscriber::DoneRaw(const gfx::Rect& damage, const SkBitmap& frame) {
+  gfx::Rect rect =
+      options_.only_dirty ? damage : gfx::Rect(frame.width(), frame.height());
+  rect.Intersect(gfx::Rect(frame.width(), frame.height()));
+  if (rect.IsEmpty())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Copy the rows of |rect| as they were captured, without the stride,
+  // straight into the buffer handed to JS.
+  size_t row_bytes = rect.width() * frame.bytesPerPixel();
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(isolate, row_bytes * rect.height()).ToLocalChecked();
+  uint8_t* data = reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer));
+  for (int y = rect.y(); y < rect.bottom(); ++y) {
+    const uint8_t* row =
+        static_cast<const uint8_t*>(frame.getAddr(rect.x(), y));
+    std::copy(row, row + row_bytes, data);
+    data += row_bytes;
+  }
+
+  callback_.Run(buffer, damage);
+}
+
+void FrameSubscriber::DoneYUV(const base::ReadOnlySharedMemoryMapping& mapping,
+                              const ::media::mojom::VideoFrameInfo& info,
+                              const gfx::Rect& content_rect) {
+  if (content_rect.IsEmpty())
+    return;
+
+  auto frame = media::VideoFrame::WrapExternalData(
+      info.pixel_format, info.coded_size, content_rect, content_rect.size(),
+      static_cast<const uint8_t*>(mapping.memory()), mapping.size(),
+      info.timestamp);
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Pack the visible part of the planes one after another, without the
+  // strides of the frame, straight into the buffer handed to JS.
+  int width = content_rect.width();
+  int height = content_rect.height();
+  int chroma_width = (width + 1) / 2;
+  int chroma_height = (height + 1) / 2;
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(isolate,
+                        width * height + 2 * chroma_width * chroma_height)
+          .ToLocalChecked();
+  uint8_t* y_plane = reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer));
+  uint8_t* chroma = y_plane + width * height;
+  if (options_.format == media::PIXEL_FORMAT_NV12) {
+    libyuv::I420ToNV12(frame->visible_data(media::VideoFrame::kYPlane),
+                       frame->stride(media::VideoFrame::kYPlane),
+                       frame->visible_data(media::VideoFrame::kUPlane),
+                       frame->stride(media::VideoFrame::kUPlane),
+                       frame->visible_data(media::VideoFrame::kVPlane),
+                       frame->stride(media::VideoFrame::kVPlane), y_plane,
+                       width, chroma, 2 * chroma_width, width, height);
+  } else {
+    uint8_t* v_plane = chroma + chroma_width * chroma_height;
+    libyuv::I420Copy(frame->visible_data(media::VideoFrame::kYPlane),
+                     frame->stride(media::VideoFrame::kYPlane),
+                     frame->visible_data(media::VideoFrame::kUPlane),
+                     frame->stride(media::VideoFrame::kUPlane),
+                     frame->visible_data(media::VideoFrame::kVPlane),
+                     frame->stride(media::VideoFrame::kVPlane), y_plane, width,
+                     chroma, chroma_width, v_plane, chroma_width, width,
+                     height);
+  }
+
+  callback_.Run(buffer, gfx::Rect(content_rect.size()));
+}
+
+gfx::Size FrameSubscriber::GetCaptureSize() const {
+  return options_.size.IsEmpty() ? GetRenderViewSize() : options_.size;
+}
+
+media::VideoPixelFormat FrameSubscriber::GetCaptureFormat() const {
+  return options_.format == media::PIXEL_FORMAT_NV12 ? media::PIXEL_FORMAT_I420
+                                                     : options_.format;
 }
 
 gfx::Size FrameSubscriber::GetRenderViewSize() const {
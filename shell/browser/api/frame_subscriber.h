@@ -12,7 +12,10 @@
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_types.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "ui/gfx/color_space.h"
+#include "ui/gfx/geometry/size.h"
 #include "v8/include/v8.h"
 
 namespace gfx {
@@ -28,12 +31,27 @@ class WebContents;
 class FrameSubscriber : public content::WebContentsObserver,
                         public viz::mojom::FrameSinkVideoConsumer {
  public:
+  // Called with a NativeImage for ARGB frames, and with a Buffer holding the
+  // packed planes for raw ARGB, I420 and NV12 frames.
   using FrameCaptureCallback =
-      base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+      base::RepeatingCallback<void(v8::Local<v8::Value>, const gfx::Rect&)>;
+
+  struct Options {
+    bool only_dirty = false;
+    // Frames are scaled by the capturer to fit in |size|, keeping the aspect
+    // ratio. Frames have the size of the view when it is empty.
+    gfx::Size size;
+    int frame_rate = 30;
+    media::VideoPixelFormat format = media::PIXEL_FORMAT_ARGB;
+    // Deliver ARGB frames as a Buffer of the captured pixels, skipping the
+    // conversion to a NativeImage.
+    bool raw = false;
+    gfx::ColorSpace color_space = gfx::ColorSpace::CreateREC709();
+  };
 
   FrameSubscriber(content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const Options& options);
   ~FrameSubscriber() override;
 
  private:
@@ -55,12 +73,23 @@ class FrameSubscriber : public content::WebContentsObserver,
   void OnStopped() override;
 
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
+  void DoneRaw(const gfx::Rect& damage, const SkBitmap& frame);
+  void DoneYUV(const base::ReadOnlySharedMemoryMapping& mapping,
+               const ::media::mojom::VideoFrameInfo& info,
+               const gfx::Rect& content_rect);
 
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
+  // The size frames are captured at.
+  gfx::Size GetCaptureSize() const;
+
+  // The format frames are captured in, NV12 frames are captured as I420 and
+  // interleaved when they are delivered.
+  media::VideoPixelFormat GetCaptureFormat() const;
+
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  Options options_;
 
   content::RenderWidgetHost* host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -4,17 +4,70 @@
 
 #include "shell/browser/api/gpuinfo_manager.h"
 
+#include <string>
 #include <utility>
 
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/memory/singleton.h"
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/browser/browser_thread.h"
+#include "electron/electron_version.h"
 #include "gpu/config/gpu_info_collector.h"
 #include "shell/browser/api/gpu_info_enumerator.h"
+#include "shell/browser/electron_paths.h"
 #include "shell/common/gin_converters/value_converter.h"
 
 namespace electron {
 
+namespace {
+
+// A new GPU, driver or Electron may give different complete info. Collecting
+// the basic info enumerates the devices, so it is kept off the UI thread.
+std::string GetCacheKey() {
+  gpu::GPUInfo gpu_info;
+  gpu::CollectBasicGraphicsInfo(&gpu_info);
+  const gpu::GPUInfo::GPUDevice& gpu = gpu_info.active_gpu();
+  return base::StringPrintf("%s/%04x/%04x/%s", ELECTRON_VERSION_STRING,
+                            gpu.vendor_id, gpu.device_id,
+                            gpu.driver_version.c_str());
+}
+
+GPUInfoManager::CacheEntry ReadCacheFile(const base::FilePath& path) {
+  GPUInfoManager::CacheEntry entry;
+  entry.key = GetCacheKey();
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return entry;
+  base::Optional<base::Value> cache = base::JSONReader::Read(contents);
+  if (!cache || !cache->is_dict())
+    return entry;
+  const std::string* cache_key = cache->FindStringKey("key");
+  base::Value* info = cache->FindDictKey("info");
+  if (cache_key && *cache_key == entry.key && info)
+    entry.info = std::move(*info);
+  return entry;
+}
+
+void WriteCacheFile(const base::FilePath& path, const std::string& contents) {
+  base::FilePath temp_path = path.AddExtension(FILE_PATH_LITERAL(".tmp"));
+  if (base::WriteFile(temp_path, contents.data(), contents.size()) !=
+          static_cast<int>(contents.size()) ||
+      !base::ReplaceFile(temp_path, path, nullptr)) {
+    base::DeleteFile(temp_path, false);
+  }
+}
+
+}  // namespace
+
+GPUInfoManager::CacheEntry::CacheEntry() = default;
+GPUInfoManager::CacheEntry::CacheEntry(CacheEntry&&) = default;
+GPUInfoManager::CacheEntry::~CacheEntry() = default;
+
 GPUInfoManager* GPUInfoManager::GetInstance() {
   return base::Singleton<GPUInfoManager>::get();
 }
@@ -41,6 +94,16 @@ bool GPUInfoManager::NeedsCompleteGpuInfoCollection() const {
 #endif
 }
 
+bool GPUInfoManager::CompleteInfoCollected() const {
+#if defined(OS_MACOSX)
+  return !gpu_data_manager_->GetGPUInfo().gl_vendor.empty();
+#elif defined(OS_WIN)
+  return !gpu_data_manager_->GetGPUInfo().dx_diagnostics.IsEmpty();
+#else
+  return true;
+#endif
+}
+
 // Should be posted to the task runner
 void GPUInfoManager::ProcessCompleteInfo() {
   const auto result = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
@@ -50,6 +113,7 @@ void GPUInfoManager::ProcessCompleteInfo() {
     promise.Resolve(*result);
   }
   complete_info_promise_set_.clear();
+  WriteCache(*result);
 }
 
 void GPUInfoManager::OnGpuInfoUpdate() {
@@ -76,11 +140,85 @@ void GPUInfoManager::CompleteInfoFetcher(
 
 void GPUInfoManager::FetchCompleteInfo(
     gin_helper::Promise<base::DictionaryValue> promise) {
+  if (!CompleteInfoCollected()) {
+    if (cache_state_ != CacheState::kRead) {
+      cache_promise_set_.emplace_back(std::move(promise));
+      ReadCache();
+      return;
+    }
+    if (cached_info_) {
+      promise.Resolve(*cached_info_);
+      return;
+    }
+  }
+
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::CompleteInfoFetcher,
                                 base::Unretained(this), std::move(promise)));
 }
 
+void GPUInfoManager::ReadCache() {
+  if (cache_state_ != CacheState::kNotRead)
+    return;
+  cache_state_ = CacheState::kReading;
+
+  base::FilePath user_data_path;
+  base::PathService::Get(DIR_USER_DATA, &user_data_path);
+  cache_path_ = user_data_path.Append(FILE_PATH_LITERAL("GPUInfoCache.json"));
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadCacheFile, cache_path_),
+      base::BindOnce(&GPUInfoManager::OnCacheRead, base::Unretained(this)));
+}
+
+void GPUInfoManager::OnCacheRead(CacheEntry entry) {
+  cache_state_ = CacheState::kRead;
+  cache_key_ = std::move(entry.key);
+  // The complete info may have been collected while the cache was read.
+  if (CompleteInfoCollected())
+    WriteCache(*EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo()));
+  base::Optional<base::Value>& info = entry.info;
+  auto promises = std::move(cache_promise_set_);
+  cache_promise_set_.clear();
+
+  if (info && !CompleteInfoCollected()) {
+    cached_info_ = base::DictionaryValue::From(
+        base::Value::ToUniquePtrValue(std::move(*info)));
+    for (auto& promise : promises)
+      promise.Resolve(*cached_info_);
+    // Refreshes the cache in the background, once collected the complete
+    // info of this launch is used instead.
+    gpu_data_manager_->RequestDxdiagDx12VulkanGpuInfoIfNeeded(
+        content::kGpuInfoRequestAll, /* delayed */ true);
+    return;
+  }
+
+  for (auto& promise : promises)
+    CompleteInfoFetcher(std::move(promise));
+}
+
+void GPUInfoManager::WriteCache(const base::DictionaryValue& info) {
+  // Only the apps asking for the complete info get a cache.
+  if (cache_key_.empty() || !CompleteInfoCollected())
+    return;
+  if (cached_info_ && *cached_info_ == info)
+    return;
+  cached_info_ = info.CreateDeepCopy();
+
+  base::DictionaryValue cache;
+  cache.SetString("key", cache_key_);
+  cache.SetKey("info", info.Clone());
+  std::string contents;
+  if (!base::JSONWriter::Write(cache, &contents))
+    return;
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteCacheFile, cache_path_, std::move(contents)));
+}
+
 // This fetches the info synchronously, so no need to post to the task queue.
 // There cannot be multiple promises as they are resolved synchronously.
 void GPUInfoManager::FetchBasicInfo(
@@ -6,9 +6,13 @@
 #define SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/optional.h"
+#include "base/values.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"  // nogncheck
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
@@ -28,6 +32,17 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void FetchBasicInfo(gin_helper::Promise<base::DictionaryValue> promise);
   void OnGpuInfoUpdate() override;
 
+  // The key of the GPU and driver of this launch, and the complete info
+  // cached for them.
+  struct CacheEntry {
+    CacheEntry();
+    CacheEntry(CacheEntry&&);
+    ~CacheEntry();
+
+    std::string key;
+    base::Optional<base::Value> info;
+  };
+
  private:
   std::unique_ptr<base::DictionaryValue> EnumerateGPUInfo(
       gpu::GPUInfo gpu_info) const;
@@ -36,12 +51,28 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void CompleteInfoFetcher(gin_helper::Promise<base::DictionaryValue> promise);
   void ProcessCompleteInfo();
 
+  // The complete info of the previous launches is kept in a file of the user
+  // data directory, keyed by the GPU and its driver. It is used while the
+  // complete info of this launch is collected.
+  bool CompleteInfoCollected() const;
+  void ReadCache();
+  void OnCacheRead(CacheEntry entry);
+  void WriteCache(const base::DictionaryValue& info);
+
   // This set maintains all the promises that should be fulfilled
   // once we have the complete information data
   std::vector<gin_helper::Promise<base::DictionaryValue>>
       complete_info_promise_set_;
   content::GpuDataManagerImpl* gpu_data_manager_;
 
+  enum class CacheState { kNotRead, kReading, kRead };
+  CacheState cache_state_ = CacheState::kNotRead;
+  base::FilePath cache_path_;
+  std::string cache_key_;
+  std::unique_ptr<base::DictionaryValue> cached_info_;
+  // The promises waiting for the cache to be read.
+  std::vector<gin_helper::Promise<base::DictionaryValue>> cache_promise_set_;
+
   DISALLOW_COPY_AND_ASSIGN(GPUInfoManager);
 };
 
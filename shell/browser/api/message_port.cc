@@ -47,13 +47,12 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     return;
   }
 
-  electron::SerializeV8Value(args->isolate(), message_value,
-                             &transferable_message);
-
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
   if (args->GetNext(&transferables)) {
-    if (!gin::ConvertFromV8(args->isolate(), transferables, &wrapped_ports)) {
+    if (!ParseTransferList(args->isolate(), transferables, &wrapped_ports,
+                           &array_buffers)) {
       args->ThrowError();
       return;
     }
@@ -69,6 +68,12 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     }
   }
 
+  if (!electron::SerializeV8Value(args->isolate(), message_value,
+                                  array_buffers, &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return;
+  }
+
   bool threw_exception = false;
   transferable_message.ports = MessagePort::DisentanglePorts(
       args->isolate(), wrapped_ports, &threw_exception);
@@ -225,7 +230,9 @@ bool MessagePort::Accept(mojo::Message* mojo_message) {
 
   auto ports = EntanglePorts(isolate, std::move(message.ports));
 
-  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+  // Other processes can post to this port, so shared memory is not trusted.
+  v8::Local<v8::Value> message_value =
+      DeserializeV8Value(isolate, &message, false);
 
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
@@ -239,6 +246,28 @@ bool MessagePort::Accept(mojo::Message* mojo_message) {
   return true;
 }
 
+// static
+bool MessagePort::ParseTransferList(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> transfer,
+    std::vector<gin::Handle<MessagePort>>* ports,
+    std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers) {
+  std::vector<v8::Local<v8::Value>> transferables;
+  if (!gin::ConvertFromV8(isolate, transfer, &transferables))
+    return false;
+  for (auto transferable : transferables) {
+    if (transferable->IsArrayBuffer()) {
+      array_buffers->push_back(transferable.As<v8::ArrayBuffer>());
+      continue;
+    }
+    gin::Handle<MessagePort> port;
+    if (!gin::ConvertFromV8(isolate, transferable, &port))
+      return false;
+    ports->push_back(port);
+  }
+  return true;
+}
+
 gin::ObjectTemplateBuilder MessagePort::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<MessagePort>::GetObjectTemplateBuilder(isolate)
@@ -48,6 +48,14 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
       const std::vector<gin::Handle<MessagePort>>& ports,
       bool* threw_exception);
 
+  // Splits a postMessage() transfer list into the ports and the ArrayBuffers
+  // it holds, returns false if it holds anything else.
+  static bool ParseTransferList(
+      v8::Isolate* isolate,
+      v8::Local<v8::Value> transfer,
+      std::vector<gin::Handle<MessagePort>>* ports,
+      std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers);
+
   // gin::Wrappable
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
       v8::Isolate* isolate) override;
@@ -7,7 +7,6 @@
 #include <string>
 #include <utility>
 
-#include "base/callback.h"
 #include "base/files/file_path.h"
 #include "content/public/browser/web_contents.h"
 #include "shell/browser/electron_browser_context.h"
@@ -17,8 +16,11 @@ namespace electron {
 namespace api {
 
 SavePageHandler::SavePageHandler(content::WebContents* web_contents,
-                                 gin_helper::Promise<void> promise)
-    : web_contents_(web_contents), promise_(std::move(promise)) {}
+                                 gin_helper::Promise<void> promise,
+                                 base::RepeatingCallback<void(int)> progress)
+    : web_contents_(web_contents),
+      promise_(std::move(promise)),
+      progress_(std::move(progress)) {}
 
 SavePageHandler::~SavePageHandler() = default;
 
@@ -52,6 +54,14 @@ bool SavePageHandler::Handle(const base::FilePath& full_path,
 }
 
 void SavePageHandler::OnDownloadUpdated(download::DownloadItem* item) {
+  if (!item->IsDone() && progress_) {
+    int percent_complete = item->PercentComplete();
+    if (percent_complete != percent_complete_) {
+      percent_complete_ = percent_complete;
+      progress_.Run(percent_complete);
+    }
+  }
+
   if (item->IsDone()) {
     if (item->GetState() == download::DownloadItem::COMPLETE)
       promise_.Resolve();
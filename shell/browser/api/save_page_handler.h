@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "base/callback.h"
 #include "components/download/public/common/download_item.h"
 #include "content/public/browser/download_manager.h"
 #include "content/public/browser/save_page_type.h"
@@ -30,7 +31,8 @@ class SavePageHandler : public content::DownloadManager::Observer,
                         public download::DownloadItem::Observer {
  public:
   SavePageHandler(content::WebContents* web_contents,
-                  gin_helper::Promise<void> promise);
+                  gin_helper::Promise<void> promise,
+                  base::RepeatingCallback<void(int)> progress);
   ~SavePageHandler() override;
 
   bool Handle(const base::FilePath& full_path,
@@ -48,6 +50,10 @@ class SavePageHandler : public content::DownloadManager::Observer,
 
   content::WebContents* web_contents_;  // weak
   gin_helper::Promise<void> promise_;
+
+  // Called with the percentage saved each time it changes.
+  base::RepeatingCallback<void(int)> progress_;
+  int percent_complete_ = -1;
 };
 
 }  // namespace api
@@ -48,6 +48,7 @@ void AutoUpdater::SetFeedURL(gin_helper::Arguments* args) {
   std::string feed;
   HeaderMap requestHeaders;
   std::string serverType = "default";
+  bool background = false;
   if (args->GetNext(&opts)) {
     if (!opts.Get("url", &feed)) {
       thrower.ThrowError(
@@ -57,6 +58,7 @@ void AutoUpdater::SetFeedURL(gin_helper::Arguments* args) {
     }
     opts.Get("headers", &requestHeaders);
     opts.Get("serverType", &serverType);
+    opts.Get("background", &background);
     if (serverType != "default" && serverType != "json") {
       thrower.ThrowError("Expected serverType to be 'default' or 'json'");
       return;
@@ -83,6 +85,11 @@ void AutoUpdater::SetFeedURL(gin_helper::Arguments* args) {
         forHTTPHeaderField:base::SysUTF8ToNSString(it.first)];
   }
 
+  // Squirrel copies the feed request for the download of the update, so the
+  // download gets the low network priority as well.
+  if (background)
+    urlRequest.networkServiceType = NSURLNetworkServiceTypeBackground;
+
   if (g_updater)
     [g_updater release];
 
@@ -23,6 +23,7 @@
 #include "shell/browser/window_list.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_helper/arguments.h"
+#include "shell/common/startup_timings.h"
 
 namespace electron {
 
@@ -174,6 +175,7 @@ void Browser::DidFinishLaunching(base::DictionaryValue launch_info) {
     base::CreateDirectoryAndGetError(user_data, nullptr);
 
   is_ready_ = true;
+  StartupTimings::GetInstance()->Record(StartupTimings::Milestone::kReady);
   if (ready_promise_) {
     ready_promise_->Resolve();
   }
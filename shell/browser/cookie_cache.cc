@@ -0,0 +1,112 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/cookie_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "services/network/public/mojom/cookie_manager.mojom.h"
+#include "shell/browser/electron_browser_context.h"
+
+namespace electron {
+
+namespace {
+
+// Longer paths first, then older cookies first, like the cookie store.
+bool CookieSorter(const net::CanonicalCookie& a,
+                  const net::CanonicalCookie& b) {
+  if (a.Path().length() != b.Path().length())
+    return a.Path().length() > b.Path().length();
+  return a.CreationDate() < b.CreationDate();
+}
+
+}  // namespace
+
+CookieCache::CookieCache(ElectronBrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+CookieCache::~CookieCache() = default;
+
+void CookieCache::GetAllCookies(GetCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (loaded_) {
+    std::move(callback).Run(GetSortedCookies());
+    return;
+  }
+
+  pending_gets_.push_back(std::move(callback));
+  if (loading_)
+    return;
+  loading_ = true;
+  content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+      ->GetCookieManagerForBrowserProcess()
+      ->GetAllCookies(base::BindOnce(&CookieCache::OnLoaded,
+                                     weak_factory_.GetWeakPtr()));
+}
+
+void CookieCache::OnCookieChange(const net::CookieChangeInfo& change) {
+  if (loading_)
+    pending_changes_.push_back(change);
+  if (!loaded_)
+    return;
+
+  const net::CanonicalCookie& cookie = change.cookie;
+  Key key(cookie.Name(), cookie.Domain(), cookie.Path());
+  cookies_.erase(key);
+  if (change.cause == net::CookieChangeCause::INSERTED)
+    cookies_.emplace(key, cookie);
+  sorted_cookies_dirty_ = true;
+}
+
+void CookieCache::Invalidate() {
+  // A load in progress may not have the missed changes either.
+  weak_factory_.InvalidateWeakPtrs();
+  loaded_ = false;
+  cookies_.clear();
+  sorted_cookies_.clear();
+  pending_changes_.clear();
+  if (loading_) {
+    loading_ = false;
+    std::vector<GetCallback> pending_gets = std::move(pending_gets_);
+    for (auto& callback : pending_gets)
+      GetAllCookies(std::move(callback));
+  }
+}
+
+void CookieCache::OnLoaded(const net::CookieList& cookies) {
+  loading_ = false;
+  loaded_ = true;
+  for (const auto& cookie : cookies) {
+    cookies_.emplace(Key(cookie.Name(), cookie.Domain(), cookie.Path()),
+                     cookie);
+  }
+  sorted_cookies_dirty_ = true;
+
+  std::vector<net::CookieChangeInfo> changes = std::move(pending_changes_);
+  for (const auto& change : changes)
+    OnCookieChange(change);
+
+  std::vector<GetCallback> pending_gets = std::move(pending_gets_);
+  for (auto& callback : pending_gets)
+    std::move(callback).Run(GetSortedCookies());
+}
+
+const net::CookieList& CookieCache::GetSortedCookies() {
+  if (sorted_cookies_dirty_) {
+    sorted_cookies_.clear();
+    sorted_cookies_.reserve(cookies_.size());
+    for (const auto& it : cookies_)
+      sorted_cookies_.push_back(it.second);
+    std::sort(sorted_cookies_.begin(), sorted_cookies_.end(), CookieSorter);
+    sorted_cookies_dirty_ = false;
+  }
+  return sorted_cookies_;
+}
+
+}  // namespace electron
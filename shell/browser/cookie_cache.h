@@ -0,0 +1,75 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_COOKIE_CACHE_H_
+#define SHELL_BROWSER_COOKIE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_change_dispatcher.h"
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Keeps a copy of the cookies of a browser context in the browser process,
+// so that they can be read without asking the network service each time. It
+// is loaded on first use and kept up to date by the cookie change
+// notifications only, the changes made by the cookies API invalidate it
+// instead so that reads right after them see the store.
+class CookieCache {
+ public:
+  using GetCallback = base::OnceCallback<void(const net::CookieList& cookies)>;
+
+  explicit CookieCache(ElectronBrowserContext* browser_context);
+  ~CookieCache();
+
+  // Runs |callback| with all the cookies, sorted the way the cookie store
+  // sorts them, once they are loaded. Expired cookies can be included until
+  // the store removes them.
+  void GetAllCookies(GetCallback callback);
+
+  // Applies a change notified by the cookie store.
+  void OnCookieChange(const net::CookieChangeInfo& change);
+
+  // Forgets the cookies, for when changes may have been missed or not be
+  // notified yet. They are loaded again on the next use.
+  void Invalidate();
+
+ private:
+  // Name, domain and path, cookies with the same key replace each other.
+  using Key = std::tuple<std::string, std::string, std::string>;
+
+  void OnLoaded(const net::CookieList& cookies);
+  const net::CookieList& GetSortedCookies();
+
+  ElectronBrowserContext* browser_context_;
+
+  bool loaded_ = false;
+  bool loading_ = false;
+  std::vector<GetCallback> pending_gets_;
+  // The order of the changes and of the loaded cookies is unknown, so the
+  // changes received while loading are applied again once they are loaded.
+  std::vector<net::CookieChangeInfo> pending_changes_;
+
+  std::map<Key, net::CanonicalCookie> cookies_;
+  // |cookies_| sorted, rebuilt when they change.
+  net::CookieList sorted_cookies_;
+  bool sorted_cookies_dirty_ = false;
+
+  base::WeakPtrFactory<CookieCache> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(CookieCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_COOKIE_CACHE_H_
@@ -18,7 +18,9 @@ namespace electron {
 
 CookieChangeNotifier::CookieChangeNotifier(
     ElectronBrowserContext* browser_context)
-    : browser_context_(browser_context), receiver_(this) {
+    : browser_context_(browser_context),
+      receiver_(this),
+      cookie_cache_(browser_context) {
   StartListening();
 }
 
@@ -55,12 +57,15 @@ void CookieChangeNotifier::OnConnectionError() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   receiver_.reset();
+  // The changes made while the listener was disconnected are not notified.
+  cookie_cache_.Invalidate();
   StartListening();
 }
 
 void CookieChangeNotifier::OnCookieChange(const net::CookieChangeInfo& change) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
+  cookie_cache_.OnCookieChange(change);
   cookie_change_sub_list_.Notify(change);
 }
 
@@ -12,6 +12,7 @@
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "net/cookies/cookie_change_dispatcher.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
+#include "shell/browser/cookie_cache.h"
 
 namespace electron {
 
@@ -29,6 +30,8 @@ class CookieChangeNotifier : public network::mojom::CookieChangeListener {
   RegisterCookieChangeCallback(
       const base::Callback<void(const net::CookieChangeInfo& change)>& cb);
 
+  CookieCache* cookie_cache() { return &cookie_cache_; }
+
  private:
   void StartListening();
   void OnConnectionError();
@@ -42,6 +45,8 @@ class CookieChangeNotifier : public network::mojom::CookieChangeListener {
 
   mojo::Receiver<network::mojom::CookieChangeListener> receiver_;
 
+  CookieCache cookie_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(CookieChangeNotifier);
 };
 
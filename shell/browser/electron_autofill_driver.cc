@@ -58,6 +58,12 @@ void AutofillDriver::ShowAutofillPopup(
   autofill_popup_->SetItems(values, labels);
 }
 
+void AutofillDriver::AppendAutofillSuggestions(
+    const std::vector<base::string16>& values,
+    const std::vector<base::string16>& labels) {
+  autofill_popup_->AppendItems(values, labels);
+}
+
 void AutofillDriver::HideAutofillPopup() {
   if (autofill_popup_)
     autofill_popup_->Hide();
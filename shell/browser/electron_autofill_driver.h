@@ -27,6 +27,9 @@ class AutofillDriver : public mojom::ElectronAutofillDriver {
   void ShowAutofillPopup(const gfx::RectF& bounds,
                          const std::vector<base::string16>& values,
                          const std::vector<base::string16>& labels) override;
+  void AppendAutofillSuggestions(
+      const std::vector<base::string16>& values,
+      const std::vector<base::string16>& labels) override;
   void HideAutofillPopup() override;
 
  private:
@@ -11,6 +11,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/files/file_util.h"
@@ -23,6 +24,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_version.h"
 #include "components/net_log/chrome_net_log.h"
@@ -82,7 +84,9 @@
 #include "shell/browser/notifications/notification_presenter.h"
 #include "shell/browser/notifications/platform_notification_service.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/renderer_process_pool.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/browser/web_contents_permission_helper.h"
 #include "shell/browser/web_contents_preferences.h"
@@ -182,6 +186,15 @@ bool IsSameWebSite(content::BrowserContext* browser_context,
           site_instance->GetSiteURL());
 }
 
+void FillSpareRenderers(base::WeakPtr<ElectronBrowserContext> browser_context,
+                        int frame_tree_node_id,
+                        const base::CommandLine& switches) {
+  auto* web_contents =
+      content::WebContents::FromFrameTreeNodeId(frame_tree_node_id);
+  if (browser_context && web_contents)
+    browser_context->spare_renderer_pool()->Fill(web_contents, switches);
+}
+
 ElectronBrowserClient* g_browser_client = nullptr;
 
 base::LazyInstance<std::string>::DestructorAtExit
@@ -563,6 +576,14 @@ ElectronBrowserClient::ShouldOverrideSiteInstanceForNavigation(
     return SiteInstanceForNavigationType::FORCE_AFFINITY;
   }
 
+  // Do the windows of the site share the renderers of a process pool?
+  content::SiteInstance* site_instance_from_pool =
+      GetSiteInstanceFromProcessPool(current_rfh, speculative_rfh, url);
+  if (site_instance_from_pool) {
+    *affinity_site_instance = site_instance_from_pool;
+    return SiteInstanceForNavigationType::FORCE_AFFINITY;
+  }
+
   if (!ShouldForceNewSiteInstance(current_rfh, speculative_rfh, browser_context,
                                   url, has_response_started)) {
     return SiteInstanceForNavigationType::ASK_CHROMIUM;
@@ -583,6 +604,17 @@ ElectronBrowserClient::ShouldOverrideSiteInstanceForNavigation(
   }
 
   if (!has_navigation_started) {
+    // The first navigation of a window can use a renderer that was launched
+    // ahead of time for it.
+    if (!current_rfh->GetParent() &&
+        !current_rfh->GetLastCommittedURL().is_valid()) {
+      content::SiteInstance* spare = TakeSpareRenderer(current_rfh);
+      if (spare) {
+        *affinity_site_instance = spare;
+        return SiteInstanceForNavigationType::FORCE_AFFINITY;
+      }
+    }
+
     // If the navigation didn't start yet, ignore any candidate site instance.
     // If such instance exists, it belongs to a previous navigation still
     // taking place. Fixes https://github.com/electron/electron/issues/17576.
@@ -648,7 +680,8 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
         switches::kStandardSchemes,      switches::kEnableSandbox,
         switches::kSecureSchemes,        switches::kBypassCSPSchemes,
         switches::kCORSSchemes,          switches::kFetchSchemes,
-        switches::kServiceWorkerSchemes, switches::kEnableApiFilteringLogging};
+        switches::kServiceWorkerSchemes, switches::kEnableApiFilteringLogging,
+        switches::kLogFormat};
     command_line->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
                                    kCommonSwitchNames,
                                    base::size(kCommonSwitchNames));
@@ -673,24 +706,122 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
     content::WebContents* web_contents =
         GetWebContentsFromProcessID(process_id);
     if (web_contents) {
-      auto* web_preferences = WebContentsPreferences::From(web_contents);
-      if (web_preferences)
-        web_preferences->AppendCommandLineSwitches(
-            command_line, IsRendererSubFrame(process_id));
-      auto preloads = SessionPreferences::GetValidPreloads(
-          web_contents->GetBrowserContext());
-      if (!preloads.empty())
-        command_line->AppendSwitchNative(
-            switches::kPreloadScripts,
-            base::JoinString(preloads, kPathDelimiter));
-      if (CanUseCustomSiteInstance()) {
-        command_line->AppendSwitch(
-            switches::kDisableElectronSiteInstanceOverrides);
-      }
+      AppendRendererSwitches(command_line, web_contents,
+                             IsRendererSubFrame(process_id));
     }
   }
 }
 
+void ElectronBrowserClient::AppendRendererSwitches(
+    base::CommandLine* command_line,
+    content::WebContents* web_contents,
+    bool is_subframe) const {
+  auto* web_preferences = WebContentsPreferences::From(web_contents);
+  if (web_preferences)
+    web_preferences->AppendCommandLineSwitches(command_line, is_subframe);
+  auto preloads =
+      SessionPreferences::GetValidPreloads(web_contents->GetBrowserContext());
+  if (!preloads.empty())
+    command_line->AppendSwitchNative(
+        switches::kPreloadScripts, base::JoinString(preloads, kPathDelimiter));
+  if (disable_process_restart_tricks_) {
+    command_line->AppendSwitch(switches::kDisableElectronSiteInstanceOverrides);
+  }
+}
+
+void ElectronBrowserClient::InitSpareRenderer(
+    content::RenderProcessHost* host,
+    content::WebContents* web_contents) {
+  // The command line and the process preferences are computed while the
+  // process is initialized, from the WebContents of the pending process.
+  int process_id = host->GetID();
+  pending_processes_[process_id] = web_contents;
+  host->Init();
+  pending_processes_.erase(process_id);
+}
+
+base::CommandLine ElectronBrowserClient::GetRendererSwitches(
+    content::WebContents* web_contents) const {
+  static const char* const kSandboxSwitchNames[] = {switches::kEnableSandbox};
+  base::CommandLine switches(base::CommandLine::NO_PROGRAM);
+  switches.CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
+                            kSandboxSwitchNames,
+                            base::size(kSandboxSwitchNames));
+  AppendRendererSwitches(&switches, web_contents, false);
+  return switches;
+}
+
+content::SiteInstance* ElectronBrowserClient::TakeSpareRenderer(
+    content::RenderFrameHost* rfh) const {
+  auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
+  auto* browser_context =
+      static_cast<ElectronBrowserContext*>(web_contents->GetBrowserContext());
+  auto* pool = browser_context->spare_renderer_pool();
+  if (!pool || pool->size() == 0 ||
+      !WebContentsPreferences::From(web_contents) ||
+      ChildWebContentsTracker::FromWebContents(web_contents))
+    return nullptr;
+
+  // Renderers that are sandboxed, or whose command line is tied to a single
+  // window, are not worth keeping spares for.
+  base::CommandLine switches = GetRendererSwitches(web_contents);
+  if (switches.HasSwitch(switches::kEnableSandbox) ||
+      switches.HasSwitch(switches::kGuestInstanceID) ||
+      switches.HasSwitch(switches::kOpenerID) ||
+      switches.HasSwitch(switches::kHiddenPage))
+    return nullptr;
+
+  content::SiteInstance* site_instance = pool->Take(switches);
+
+  // Launch the replacement after the navigation got its process.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&FillSpareRenderers, browser_context->GetWeakPtr(),
+                     rfh->GetFrameTreeNodeId(), std::move(switches)));
+  return site_instance;
+}
+
+content::SiteInstance* ElectronBrowserClient::GetSiteInstanceFromProcessPool(
+    content::RenderFrameHost* current_rfh,
+    content::RenderFrameHost* speculative_rfh,
+    const GURL& url) const {
+  auto* web_contents = content::WebContents::FromRenderFrameHost(current_rfh);
+  auto* browser_context =
+      static_cast<ElectronBrowserContext*>(web_contents->GetBrowserContext());
+  auto* pool = browser_context->renderer_process_pool();
+  if (!pool || !pool->enabled() ||
+      !WebContentsPreferences::From(web_contents) ||
+      ChildWebContentsTracker::FromWebContents(web_contents))
+    return nullptr;
+  if (url.SchemeIs(url::kJavaScriptScheme) ||
+      url.SchemeIs(url::kAboutScheme) || url.SchemeIs(url::kDataScheme) ||
+      url.SchemeIs(extensions::kExtensionScheme))
+    return nullptr;
+
+  // The navigation must keep the site instance it was given the first time it
+  // asked, and windows stay in their renderer while they navigate in a site.
+  if (speculative_rfh) {
+    content::SiteInstance* speculative_instance =
+        speculative_rfh->GetSiteInstance();
+    if (pool->Contains(speculative_instance) &&
+        IsSameWebSite(browser_context, speculative_instance, url))
+      return speculative_instance;
+  }
+  content::SiteInstance* current_instance = current_rfh->GetSiteInstance();
+  if (pool->Contains(current_instance) &&
+      IsSameWebSite(browser_context, current_instance, url))
+    return current_instance;
+
+  // Renderers whose command line is tied to a single window can't be shared.
+  base::CommandLine switches = GetRendererSwitches(web_contents);
+  if (switches.HasSwitch(switches::kGuestInstanceID) ||
+      switches.HasSwitch(switches::kOpenerID) ||
+      switches.HasSwitch(switches::kHiddenPage))
+    return nullptr;
+
+  return pool->Get(url, switches);
+}
+
 void ElectronBrowserClient::DidCreatePpapiPlugin(
     content::BrowserPpapiHost* host) {
 #if BUILDFLAG(ENABLE_PEPPER_FLASH)
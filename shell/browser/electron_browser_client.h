@@ -48,6 +48,11 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
   // Returns the WebContents for pending render processes.
   content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // Launches |host| as a spare renderer, with the command line and process
+  // preferences it would get for |web_contents|.
+  void InitSpareRenderer(content::RenderProcessHost* host,
+                         content::WebContents* web_contents);
+
   // Don't force renderer process to restart for once.
   static void SuppressRendererProcessRestartForOnce();
 
@@ -295,6 +300,26 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
 
   bool IsRendererSubFrame(int process_id) const;
 
+  // Appends the switches that depend on the web preferences of |web_contents|
+  // to the command line of its renderer.
+  void AppendRendererSwitches(base::CommandLine* command_line,
+                              content::WebContents* web_contents,
+                              bool is_subframe) const;
+  // Returns the switches the renderer of the main frame of |web_contents|
+  // would be launched with, including the sandbox one.
+  base::CommandLine GetRendererSwitches(
+      content::WebContents* web_contents) const;
+  // Returns a spare renderer for the first navigation of the main frame of
+  // |rfh|, and refills the pool afterwards.
+  content::SiteInstance* TakeSpareRenderer(
+      content::RenderFrameHost* rfh) const;
+  // Returns the site instance of the renderer process pool of the session of
+  // |current_rfh| for the navigation to |url|, or nullptr.
+  content::SiteInstance* GetSiteInstanceFromProcessPool(
+      content::RenderFrameHost* current_rfh,
+      content::RenderFrameHost* speculative_rfh,
+      const GURL& url) const;
+
   // pending_render_process => web contents.
   std::map<int, content::WebContents*> pending_processes_;
 
@@ -4,10 +4,12 @@
 
 #include "shell/browser/electron_browser_context.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <utility>
 
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
@@ -40,9 +42,14 @@
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_paths.h"
 #include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/net/download_throttle.h"
+#include "shell/browser/net/network_metrics.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/pref_store_delegate.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/renderer_process_pool.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/special_storage_policy.h"
 #include "shell/browser/ui/inspectable_web_contents_impl.h"
 #include "shell/browser/web_view_manager.h"
@@ -58,6 +65,7 @@
 #include "extensions/browser/pref_names.h"
 #include "extensions/common/extension_api.h"
 #include "shell/browser/extensions/electron_browser_context_keyed_service_factories.h"
+#include "shell/browser/extensions/electron_extension_loader.h"
 #include "shell/browser/extensions/electron_extension_system.h"
 #include "shell/browser/extensions/electron_extension_system_factory.h"
 #include "shell/browser/extensions/electron_extensions_browser_client.h"
@@ -83,6 +91,16 @@ namespace electron {
 
 namespace {
 
+// The preferences that configure a session rather than record what it did,
+// copied to its clones.
+const char* const kClonedPrefs[] = {
+    prefs::kDownloadDefaultDirectory,
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+    spellcheck::prefs::kSpellCheckDictionaries,
+    spellcheck::prefs::kSpellCheckUseSpellingService,
+#endif
+};
+
 // Convert string to lower case and escape it.
 std::string MakePartitionName(const std::string& input) {
   return net::EscapePath(base::ToLowerASCII(input));
@@ -102,6 +120,11 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
       in_memory_pref_store_(nullptr),
       storage_policy_(new SpecialStoragePolicy),
       protocol_registry_(new ProtocolRegistry),
+      spare_renderer_pool_(new SpareRendererPool(this)),
+      renderer_process_pool_(new RendererProcessPool(this)),
+      network_metrics_(new NetworkMetrics),
+      preconnect_predictor_(new PreconnectPredictor(this)),
+      download_throttle_(new DownloadThrottle),
       in_memory_(in_memory),
       weak_factory_(this) {
   // TODO(nornagon): remove once https://crbug.com/1048822 is fixed.
@@ -115,6 +138,12 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  options.GetInteger("cacheMaxSize", &max_cache_size_);
+  int cache_max_age;
+  if (options.GetInteger("cacheMaxAge", &cache_max_age) && cache_max_age > 0)
+    cache_max_age_ = base::TimeDelta::FromSeconds(cache_max_age);
+
+  options_ = std::move(options);
 
   if (!base::PathService::Get(DIR_USER_DATA, &path_)) {
     base::PathService::Get(DIR_APP_DATA, &path_);
@@ -138,7 +167,20 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
   // Initialize Pref Registry.
   InitPrefs();
 
-  cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  bool persist_preconnect_predictions = false;
+  options_.GetBoolean("persistPreconnectPredictions",
+                      &persist_preconnect_predictions);
+  preconnect_predictor_->InitPersistence(persist_preconnect_predictions);
+
+  if (use_cache_ && !cache_max_age_.is_zero()) {
+    // Expiring the entries twice per max age, but no more than once a minute,
+    // keeps them at most that much older than it.
+    cache_expiry_timer_.Start(
+        FROM_HERE,
+        std::max(cache_max_age_ / 2, base::TimeDelta::FromMinutes(1)),
+        base::BindRepeating(&ElectronBrowserContext::ExpireHttpCacheEntries,
+                            base::Unretained(this)));
+  }
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   BrowserContextDependencyManager::GetInstance()->CreateBrowserContextServices(
@@ -153,6 +195,10 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
 
 ElectronBrowserContext::~ElectronBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Release the spare and pooled renderers before their processes are shut
+  // down.
+  spare_renderer_pool_.reset();
+  renderer_process_pool_.reset();
   NotifyWillBeDestroyed(this);
   // Notify any keyed services of browser context destruction.
   BrowserContextDependencyManager::GetInstance()->DestroyBrowserContextServices(
@@ -197,8 +243,10 @@ void ElectronBrowserContext::InitPrefs() {
   MediaDeviceIDSalt::RegisterPrefs(registry.get());
   ZoomLevelDelegate::RegisterPrefs(registry.get());
   PrefProxyConfigTrackerImpl::RegisterPrefs(registry.get());
+  PreconnectPredictor::RegisterPrefs(registry.get());
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions::ExtensionPrefs::RegisterProfilePrefs(registry.get());
+  extensions::ElectronExtensionLoader::RegisterPrefs(registry.get());
 #endif
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
@@ -233,6 +281,50 @@ void ElectronBrowserContext::InitPrefs() {
 #endif
 }
 
+void ElectronBrowserContext::CopySettingsFrom(ElectronBrowserContext* source) {
+  user_agent_ = source->user_agent_;
+  shared_cache_urls_ = source->shared_cache_urls_;
+
+  for (const char* name : kClonedPrefs) {
+    const PrefService::Preference* pref = source->prefs()->FindPreference(name);
+    if (pref && pref->HasUserSetting())
+      prefs()->Set(name, *pref->GetValue());
+  }
+
+  // Set with ses.setProxy().
+  const base::Value* proxy = nullptr;
+  if (in_memory_pref_store_ && source->in_memory_pref_store_ &&
+      source->in_memory_pref_store_->GetValue(proxy_config::prefs::kProxy,
+                                              &proxy)) {
+    in_memory_pref_store_->SetValue(
+        proxy_config::prefs::kProxy,
+        std::make_unique<base::Value>(proxy->Clone()),
+        WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  }
+
+  download_throttle_->session_limiter()->SetLimit(
+      source->download_throttle_->session_limiter()->GetLimit());
+  renderer_process_pool_->SetLimits(
+      source->renderer_process_pool_->max_processes_per_site(),
+      source->renderer_process_pool_->max_processes());
+
+  if (source->permission_manager_) {
+    auto* permission_manager = static_cast<ElectronPermissionManager*>(
+        GetPermissionControllerDelegate());
+    permission_manager->SetPermissionRequestHandler(
+        source->permission_manager_->request_handler());
+    permission_manager->SetPermissionCheckHandler(
+        source->permission_manager_->check_handler(),
+        source->permission_manager_->check_cache_timeout());
+  }
+}
+
+CookieChangeNotifier* ElectronBrowserContext::GetCookieChangeNotifier() {
+  if (!cookie_change_notifier_)
+    cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  return cookie_change_notifier_.get();
+}
+
 void ElectronBrowserContext::SetUserAgent(const std::string& user_agent) {
   user_agent_ = user_agent;
 }
@@ -253,6 +345,14 @@ int ElectronBrowserContext::GetMaxCacheSize() const {
   return max_cache_size_;
 }
 
+void ElectronBrowserContext::ExpireHttpCacheEntries() {
+  // The cache dooms the entries last used in the range.
+  content::BrowserContext::GetDefaultStoragePartition(this)
+      ->GetNetworkContext()
+      ->ClearHttpCache(base::Time(), base::Time::Now() - cache_max_age_,
+                       nullptr, base::DoNothing());
+}
+
 content::ResourceContext* ElectronBrowserContext::GetResourceContext() {
   if (!resource_context_)
     resource_context_ = std::make_unique<content::ResourceContext>();
@@ -456,4 +556,23 @@ scoped_refptr<ElectronBrowserContext> ElectronBrowserContext::From(
   return scoped_refptr<ElectronBrowserContext>(new_context);
 }
 
+// static
+scoped_refptr<ElectronBrowserContext> ElectronBrowserContext::Clone(
+    ElectronBrowserContext* source,
+    const std::string& partition,
+    bool in_memory,
+    bool* created) {
+  PartitionKey key(partition, in_memory);
+  auto* browser_context = browser_context_map_[key].get();
+  *created = !browser_context;
+  if (browser_context)
+    return scoped_refptr<ElectronBrowserContext>(browser_context);
+
+  auto* new_context = new ElectronBrowserContext(
+      partition, in_memory, std::move(*source->options_.CreateDeepCopy()));
+  new_context->CopySettingsFrom(source);
+  browser_context_map_[key] = new_context->GetWeakPtr();
+  return scoped_refptr<ElectronBrowserContext>(new_context);
+}
+
 }  // namespace electron
@@ -8,10 +8,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/ref_counted_delete_on_sequence.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/predictors/preconnect_manager.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/resource_context.h"
@@ -19,6 +22,7 @@
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/media/media_device_id_salt.h"
+#include "shell/browser/net/url_pattern_matcher.h"
 
 class PrefRegistrySimple;
 class PrefService;
@@ -42,9 +46,14 @@ namespace electron {
 
 class ElectronBrowserContext;
 class ElectronDownloadManagerDelegate;
+class DownloadThrottle;
 class ElectronPermissionManager;
 class CookieChangeNotifier;
 class ResolveProxyHelper;
+class NetworkMetrics;
+class PreconnectPredictor;
+class RendererProcessPool;
+class SpareRendererPool;
 class SpecialStoragePolicy;
 class WebViewManager;
 class ProtocolRegistry;
@@ -83,6 +92,16 @@ class ElectronBrowserContext
       bool in_memory,
       base::DictionaryValue options = base::DictionaryValue());
 
+  // Get or create the BrowserContext of |partition| and |in_memory|. A new one
+  // gets the options and configuration of |source|, like its user agent,
+  // proxy, download settings and permission handlers, but none of its data.
+  // |created| is set to whether the BrowserContext did not exist yet.
+  static scoped_refptr<ElectronBrowserContext> Clone(
+      ElectronBrowserContext* source,
+      const std::string& partition,
+      bool in_memory,
+      bool* created);
+
   static BrowserContextMap browser_context_map() {
     return browser_context_map_;
   }
@@ -91,6 +110,8 @@ class ElectronBrowserContext
   std::string GetUserAgent() const;
   bool CanUseHttpCache() const;
   int GetMaxCacheSize() const;
+  // Zero when the cache entries do not expire.
+  base::TimeDelta cache_max_age() const { return cache_max_age_; }
   ResolveProxyHelper* GetResolveProxyHelper();
   predictors::PreconnectManager* GetPreconnectManager();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
@@ -124,9 +145,9 @@ class ElectronBrowserContext
       std::vector<network::mojom::CorsOriginPatternPtr> block_patterns,
       base::OnceClosure closure) override;
 
-  CookieChangeNotifier* cookie_change_notifier() const {
-    return cookie_change_notifier_.get();
-  }
+  // Created on first use, as listening for the cookie changes starts the
+  // network context of the partition.
+  CookieChangeNotifier* GetCookieChangeNotifier();
   PrefService* prefs() const { return prefs_.get(); }
   void set_in_memory_pref_store(ValueMapPrefStore* pref_store) {
     in_memory_pref_store_ = pref_store;
@@ -148,6 +169,32 @@ class ElectronBrowserContext
     return protocol_registry_.get();
   }
 
+  SpareRendererPool* spare_renderer_pool() const {
+    return spare_renderer_pool_.get();
+  }
+  RendererProcessPool* renderer_process_pool() const {
+    return renderer_process_pool_.get();
+  }
+
+  NetworkMetrics* network_metrics() const { return network_metrics_.get(); }
+
+  PreconnectPredictor* preconnect_predictor() const {
+    return preconnect_predictor_.get();
+  }
+
+  DownloadThrottle* download_throttle() const {
+    return download_throttle_.get();
+  }
+
+  // The URLs of the immutable resources the session loads through the
+  // SharedAssetCache of the app, none when it did not opt in.
+  const URLPatternMatcher& shared_cache_urls() const {
+    return shared_cache_urls_;
+  }
+  void set_shared_cache_urls(URLPatternMatcher urls) {
+    shared_cache_urls_ = std::move(urls);
+  }
+
  protected:
   ElectronBrowserContext(const std::string& partition,
                          bool in_memory,
@@ -165,6 +212,12 @@ class ElectronBrowserContext
   // Initialize pref registry.
   void InitPrefs();
 
+  // Copies the configuration of |source| that Clone() carries over.
+  void CopySettingsFrom(ElectronBrowserContext* source);
+
+  // Removes the HTTP cache entries not used for |cache_max_age_|.
+  void ExpireHttpCacheEntries();
+
   static BrowserContextMap browser_context_map_;
 
   ValueMapPrefStore* in_memory_pref_store_;
@@ -180,12 +233,22 @@ class ElectronBrowserContext
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<SpareRendererPool> spare_renderer_pool_;
+  std::unique_ptr<RendererProcessPool> renderer_process_pool_;
+  std::unique_ptr<NetworkMetrics> network_metrics_;
+  std::unique_ptr<PreconnectPredictor> preconnect_predictor_;
+  std::unique_ptr<DownloadThrottle> download_throttle_;
 
   std::string user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  base::TimeDelta cache_max_age_;
+  base::RepeatingTimer cache_expiry_timer_;
+  URLPatternMatcher shared_cache_urls_;
+  // The options the context was created with, for its clones.
+  base::DictionaryValue options_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // Owned by the KeyedService system.
@@ -13,12 +13,14 @@
 #endif
 
 #include "base/base_switches.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/icon_manager.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/child_process_security_policy.h"
@@ -50,6 +52,7 @@
 #include "shell/common/gin_helper/trackable_object.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timings.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -297,9 +300,14 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 
   // Add Electron extended APIs.
   electron_bindings_->BindTo(js_env_->isolate(), env->process_object());
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kNodeInitialized);
 
   // Load everything.
   node_bindings_->LoadEnvironment(env);
+  // The main script of the app runs synchronously while loading.
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kMainScriptEvaluated);
 
   // Wrap the uv loop with global env.
   node_bindings_->set_uv_env(env);
@@ -309,6 +317,7 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // switches at that point. Lets reinitialize it here to pick up the
   // command-line changes.
   base::FeatureList::ClearInstanceForTesting();
+  InitializeFieldTrials();
   InitializeFeatureList();
 
   // Initialize after user script environment creation.
@@ -390,6 +399,9 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 void ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kPreMainMessageLoopRun);
+
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareMessageLoop();
@@ -440,6 +452,13 @@ void ElectronBrowserMainParts::PreMainMessageLoopRun() {
 
   // Notify observers that main thread message loop was initialized.
   Browser::Get()->PreMainMessageLoopRun();
+
+  // The archives of the app are open once its main script ran, their native
+  // modules for this platform are extracted before the renderers require
+  // them.
+  base::ThreadPool::PostTask(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&asar::ExtractNativeModules));
 }
 
 bool ElectronBrowserMainParts::MainMessageLoopRun(int* result_code) {
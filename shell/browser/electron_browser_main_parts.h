@@ -79,6 +79,7 @@ class ElectronBrowserMainParts : public content::BrowserMainParts {
   IconManager* GetIconManager();
 
   Browser* browser() { return browser_.get(); }
+  NodeBindings* node_bindings() { return node_bindings_.get(); }
   BrowserProcessImpl* browser_process() { return fake_browser_process_.get(); }
 
  protected:
@@ -23,6 +23,8 @@ namespace electron {
 
 namespace {
 
+constexpr size_t kMaxCheckCacheSize = 1024;
+
 bool WebContentsDestroyed(int process_id) {
   content::WebContents* web_contents =
       static_cast<ElectronBrowserClient*>(ElectronBrowserClient::Get())
@@ -108,8 +110,11 @@ void ElectronPermissionManager::SetPermissionRequestHandler(
 }
 
 void ElectronPermissionManager::SetPermissionCheckHandler(
-    const CheckHandler& handler) {
+    const CheckHandler& handler,
+    base::TimeDelta cache_timeout) {
   check_handler_ = handler;
+  check_cache_timeout_ = cache_timeout;
+  check_cache_.clear();
 }
 
 int ElectronPermissionManager::RequestPermission(
@@ -246,6 +251,25 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
   if (check_handler_.is_null()) {
     return true;
   }
+
+  // Blink checks some permissions many times per page, for example on each
+  // enumeration of the media devices.
+  CheckKey key;
+  base::TimeTicks now;
+  if (!check_cache_timeout_.is_zero()) {
+    const std::string* media_type =
+        details ? details->FindStringKey("mediaType") : nullptr;
+    key = CheckKey(permission, requesting_origin,
+                   media_type ? *media_type : std::string());
+    now = base::TimeTicks::Now();
+    auto it = check_cache_.find(key);
+    if (it != check_cache_.end()) {
+      if (it->second.expiry > now)
+        return it->second.granted;
+      check_cache_.erase(it);
+    }
+  }
+
   auto* web_contents =
       content::WebContents::FromRenderFrameHost(render_frame_host);
   auto mutable_details =
@@ -254,8 +278,17 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
                                render_frame_host->GetLastCommittedURL().spec());
   mutable_details.SetBoolKey("isMainFrame",
                              render_frame_host->GetParent() == nullptr);
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            mutable_details);
+  bool granted = check_handler_.Run(web_contents, permission, requesting_origin,
+                                    mutable_details);
+
+  if (!check_cache_timeout_.is_zero()) {
+    // The expired entries of other origins are only dropped when the cache
+    // is full.
+    if (check_cache_.size() >= kMaxCheckCacheSize)
+      check_cache_.clear();
+    check_cache_[key] = {granted, now + check_cache_timeout_};
+  }
+  return granted;
 }
 
 blink::mojom::PermissionStatus
@@ -7,12 +7,17 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/containers/id_map.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/permission_controller_delegate.h"
+#include "content/public/browser/permission_type.h"
+#include "url/gurl.h"
 
 namespace content {
 class WebContents;
@@ -40,7 +45,14 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
 
   // Handler to dispatch permission requests in JS.
   void SetPermissionRequestHandler(const RequestHandler& handler);
-  void SetPermissionCheckHandler(const CheckHandler& handler);
+  // The results of |handler| are reused for |cache_timeout| when it is not
+  // zero, for the same permission, requesting origin and media type.
+  void SetPermissionCheckHandler(
+      const CheckHandler& handler,
+      base::TimeDelta cache_timeout = base::TimeDelta());
+  const RequestHandler& request_handler() const { return request_handler_; }
+  const CheckHandler& check_handler() const { return check_handler_; }
+  base::TimeDelta check_cache_timeout() const { return check_cache_timeout_; }
 
   // content::PermissionControllerDelegate:
   int RequestPermission(content::PermissionType permission,
@@ -102,9 +114,19 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   class PendingRequest;
   using PendingRequestsMap = base::IDMap<std::unique_ptr<PendingRequest>>;
 
+  // Permission, requesting origin and media type of a check.
+  using CheckKey = std::tuple<content::PermissionType, GURL, std::string>;
+  struct CheckResult {
+    bool granted;
+    base::TimeTicks expiry;
+  };
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
 
+  base::TimeDelta check_cache_timeout_;
+  mutable std::map<CheckKey, CheckResult> check_cache_;
+
   PendingRequestsMap pending_requests_;
 
   DISALLOW_COPY_AND_ASSIGN(ElectronPermissionManager);
@@ -4,21 +4,36 @@
 
 #include "shell/browser/extensions/electron_extension_loader.h"
 
+#include <algorithm>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/auto_reset.h"
 #include "base/bind.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
 #include "extensions/browser/extension_file_task_runner.h"
 #include "extensions/browser/extension_prefs.h"
 #include "extensions/browser/extension_registry.h"
+#include "extensions/common/extension_l10n_util.h"
 #include "extensions/common/file_util.h"
+#include "extensions/common/install_warning.h"
+#include "extensions/common/manifest_constants.h"
+#include "shell/browser/electron_browser_context.h"
 
 namespace extensions {
 
@@ -26,43 +41,151 @@ using LoadErrorBehavior = ExtensionRegistrar::LoadErrorBehavior;
 
 namespace {
 
-std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
-    const base::FilePath& extension_dir) {
+// Dictionary that maps the directories of the unpacked extensions that were
+// validated to the hash of their files at the time, and to the warnings of
+// the validation.
+const char kValidatedUnpackedExtensions[] =
+    "electron.extensions.validated_unpacked";
+
+const char kValidationKey[] = "key";
+const char kWarningsKey[] = "warnings";
+
+// The hash of the paths and contents of every file under |extension_dir|,
+// which changes when any file of the extension is added, removed or edited,
+// whatever its modification time. Empty when a file can not be read.
+std::string GetValidationKey(const base::FilePath& extension_dir) {
+  std::vector<base::FilePath> files;
+  base::FileEnumerator enumerator(extension_dir, true /* recursive */,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath file = enumerator.Next(); !file.empty();
+       file = enumerator.Next()) {
+    files.push_back(file);
+  }
+  // The enumeration order depends on the file system.
+  std::sort(files.begin(), files.end());
+
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  for (const auto& file : files) {
+    base::FilePath relative_path;
+    std::string contents;
+    if (!extension_dir.AppendRelativePath(file, &relative_path) ||
+        !base::ReadFileToString(file, &contents)) {
+      return std::string();
+    }
+    std::string header = relative_path.AsUTF8Unsafe() + '\0' +
+                         base::NumberToString(contents.size()) + '\0';
+    hash->Update(header.data(), header.size());
+    hash->Update(contents.data(), contents.size());
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest));
+}
+
+// Turns the persistent background page of |manifest|, if it has one, into an
+// event page.
+void MakeBackgroundLazy(base::DictionaryValue* manifest) {
+  if (!manifest->FindPath(manifest_keys::kBackgroundPage) &&
+      !manifest->FindPath(manifest_keys::kBackgroundScripts)) {
+    return;
+  }
+  manifest->SetPath(manifest_keys::kBackgroundPersistent, base::Value(false));
+}
+
+// Like file_util::LoadExtension(), but the files of the extension are only
+// validated when it changed since the last time they were, according to the
+// |validated| entry of the session preferences.
+std::unique_ptr<ElectronExtensionLoader::LoadResult> LoadUnpacked(
+    const base::FilePath& extension_dir,
+    base::Value validated,
+    bool lazy_background) {
+  auto result = std::make_unique<ElectronExtensionLoader::LoadResult>();
   // app_shell only supports unpacked extensions.
   // NOTE: If you add packed extension support consider removing the flag
   // FOLLOW_SYMLINKS_ANYWHERE below. Packed extensions should not have symlinks.
   if (!base::DirectoryExists(extension_dir)) {
-    std::string err = "Extension directory not found: " +
+    result->message = "Extension directory not found: " +
                       base::UTF16ToUTF8(extension_dir.LossyDisplayName());
-    return std::make_pair(nullptr, err);
+    return result;
   }
 
+  result->validation_key = GetValidationKey(extension_dir);
+  const std::string* validated_key =
+      validated.is_dict() ? validated.FindStringKey(kValidationKey) : nullptr;
+  bool skip_validation = !result->validation_key.empty() && validated_key &&
+                         *validated_key == result->validation_key;
+
   int load_flags = Extension::FOLLOW_SYMLINKS_ANYWHERE;
   std::string load_error;
-  scoped_refptr<Extension> extension = file_util::LoadExtension(
-      extension_dir, Manifest::COMMAND_LINE, load_flags, &load_error);
-  if (!extension.get()) {
-    std::string err = "Loading extension at " +
+  scoped_refptr<Extension> extension;
+  std::unique_ptr<base::DictionaryValue> manifest =
+      file_util::LoadManifest(extension_dir, &load_error);
+  if (manifest && lazy_background)
+    MakeBackgroundLazy(manifest.get());
+  if (manifest &&
+      extension_l10n_util::LocalizeExtension(
+          extension_dir, manifest.get(),
+          extension_l10n_util::GetGzippedMessagesPermissionForLocation(
+              Manifest::COMMAND_LINE),
+          &load_error)) {
+    extension = Extension::Create(extension_dir, Manifest::COMMAND_LINE,
+                                  *manifest, load_flags, &load_error);
+  }
+
+  std::vector<InstallWarning> install_warnings;
+  if (extension && skip_validation) {
+    const base::Value* warnings = validated.FindListKey(kWarningsKey);
+    if (warnings) {
+      for (const auto& warning : warnings->GetList()) {
+        if (warning.is_string())
+          install_warnings.emplace_back(warning.GetString());
+      }
+    }
+  } else if (extension) {
+    if (file_util::ValidateExtension(extension.get(), &load_error,
+                                     &install_warnings)) {
+      result->validated = true;
+      for (const auto& warning : install_warnings)
+        result->validation_warnings.push_back(warning.message);
+    } else {
+      extension = nullptr;
+    }
+  }
+
+  if (!extension) {
+    result->message = "Loading extension at " +
                       base::UTF16ToUTF8(extension_dir.LossyDisplayName()) +
                       " failed with: " + load_error;
-    return std::make_pair(nullptr, err);
+    return result;
   }
+  extension->AddInstallWarnings(std::move(install_warnings));
 
-  std::string warnings;
   // Log warnings.
   if (extension->install_warnings().size()) {
-    warnings += "Warnings loading extension at " +
-                base::UTF16ToUTF8(extension_dir.LossyDisplayName()) + ": ";
+    result->message += "Warnings loading extension at " +
+                       base::UTF16ToUTF8(extension_dir.LossyDisplayName()) +
+                       ": ";
     for (const auto& warning : extension->install_warnings()) {
-      warnings += warning.message + " ";
+      result->message += warning.message + " ";
     }
   }
 
-  return std::make_pair(extension, warnings);
+  result->extension = extension;
+  return result;
 }
 
 }  // namespace
 
+ElectronExtensionLoader::LoadResult::LoadResult() = default;
+ElectronExtensionLoader::LoadResult::~LoadResult() = default;
+
+// static
+void ElectronExtensionLoader::RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterDictionaryPref(kValidatedUnpackedExtensions);
+}
+
 ElectronExtensionLoader::ElectronExtensionLoader(
     content::BrowserContext* browser_context)
     : browser_context_(browser_context),
@@ -73,12 +196,20 @@ ElectronExtensionLoader::~ElectronExtensionLoader() = default;
 
 void ElectronExtensionLoader::LoadExtension(
     const base::FilePath& extension_dir,
+    bool lazy_background,
     base::OnceCallback<void(const Extension*, const std::string&)> cb) {
+  if (lazy_background)
+    lazy_background_dirs_.insert(extension_dir);
+  else
+    lazy_background_dirs_.erase(extension_dir);
+
   base::PostTaskAndReplyWithResult(
       GetExtensionFileTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&LoadUnpacked, extension_dir),
+      base::BindOnce(&LoadUnpacked, extension_dir,
+                     GetValidatedEntry(extension_dir), lazy_background),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionLoad,
-                     weak_factory_.GetWeakPtr(), std::move(cb)));
+                     weak_factory_.GetWeakPtr(), extension_dir,
+                     std::move(cb)));
 }
 
 void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
@@ -103,20 +234,58 @@ void ElectronExtensionLoader::UnloadExtension(
   extension_registrar_.RemoveExtension(extension_id, reason);
 }
 
+base::Value ElectronExtensionLoader::GetValidatedEntry(
+    const base::FilePath& extension_dir) const {
+  const base::Value* validated =
+      GetPrefs()->GetDictionary(kValidatedUnpackedExtensions);
+  const base::Value* entry =
+      validated->FindDictKey(extension_dir.AsUTF8Unsafe());
+  return entry ? entry->Clone() : base::Value();
+}
+
+void ElectronExtensionLoader::UpdateValidatedEntry(
+    const base::FilePath& extension_dir,
+    const LoadResult& result) {
+  DictionaryPrefUpdate update(GetPrefs(), kValidatedUnpackedExtensions);
+  if (!result.extension || result.validation_key.empty()) {
+    update->RemoveKey(extension_dir.AsUTF8Unsafe());
+    return;
+  }
+  if (!result.validated)
+    return;
+
+  base::Value warnings(base::Value::Type::LIST);
+  for (const auto& warning : result.validation_warnings)
+    warnings.Append(warning);
+  base::Value entry(base::Value::Type::DICTIONARY);
+  entry.SetStringKey(kValidationKey, result.validation_key);
+  entry.SetKey(kWarningsKey, std::move(warnings));
+  update->SetKey(extension_dir.AsUTF8Unsafe(), std::move(entry));
+}
+
+PrefService* ElectronExtensionLoader::GetPrefs() const {
+  return static_cast<electron::ElectronBrowserContext*>(browser_context_)
+      ->prefs();
+}
+
 void ElectronExtensionLoader::FinishExtensionLoad(
+    const base::FilePath& extension_dir,
     base::OnceCallback<void(const Extension*, const std::string&)> cb,
-    std::pair<scoped_refptr<const Extension>, std::string> result) {
-  scoped_refptr<const Extension> extension = result.first;
+    std::unique_ptr<LoadResult> result) {
+  UpdateValidatedEntry(extension_dir, *result);
+  scoped_refptr<const Extension> extension = result->extension;
   if (extension) {
     extension_registrar_.AddExtension(extension);
   }
-  std::move(cb).Run(extension.get(), result.second);
+  std::move(cb).Run(extension.get(), result->message);
 }
 
 void ElectronExtensionLoader::FinishExtensionReload(
     const ExtensionId& old_extension_id,
-    std::pair<scoped_refptr<const Extension>, std::string> result) {
-  scoped_refptr<const Extension> extension = result.first;
+    const base::FilePath& extension_dir,
+    std::unique_ptr<LoadResult> result) {
+  UpdateValidatedEntry(extension_dir, *result);
+  scoped_refptr<const Extension> extension = result->extension;
   if (extension) {
     extension_registrar_.AddExtension(extension);
   }
@@ -157,9 +326,10 @@ void ElectronExtensionLoader::LoadExtensionForReload(
 
   base::PostTaskAndReplyWithResult(
       GetExtensionFileTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&LoadUnpacked, path),
+      base::BindOnce(&LoadUnpacked, path, GetValidatedEntry(path),
+                     base::Contains(lazy_background_dirs_, path)),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionReload,
-                     weak_factory_.GetWeakPtr(), extension_id));
+                     weak_factory_.GetWeakPtr(), extension_id, path));
   did_schedule_reload_ = true;
 }
 
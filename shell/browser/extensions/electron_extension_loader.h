@@ -6,18 +6,21 @@
 #define SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_LOADER_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "extensions/browser/extension_registrar.h"
 #include "extensions/common/extension_id.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
+class PrefRegistrySimple;
+class PrefService;
 
 namespace content {
 class BrowserContext;
@@ -30,12 +33,35 @@ class Extension;
 // Handles extension loading and reloading using ExtensionRegistrar.
 class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
  public:
+  // What loading an unpacked extension on the extension file task runner
+  // gives back.
+  struct LoadResult {
+    LoadResult();
+    ~LoadResult();
+
+    scoped_refptr<const Extension> extension;
+    // The error, or the warnings of the loaded extension.
+    std::string message;
+    // Changes with the extension, see GetValidationKey().
+    std::string validation_key;
+    // Whether the files of the extension were validated, rather than known to
+    // be valid from an earlier load, and the warnings of the validation.
+    bool validated = false;
+    std::vector<std::string> validation_warnings;
+  };
+
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
   explicit ElectronExtensionLoader(content::BrowserContext* browser_context);
   ~ElectronExtensionLoader() override;
 
   // Loads an unpacked extension from a directory synchronously. Returns the
-  // extension on success, or nullptr otherwise.
+  // extension on success, or nullptr otherwise. With |lazy_background|, a
+  // persistent background page is loaded as an event page: it only starts
+  // with the first event or message sent to the extension, and is suspended
+  // again once idle. This also holds for the reloads of the extension.
   void LoadExtension(const base::FilePath& extension_dir,
+                     bool lazy_background,
                      base::OnceCallback<void(const Extension* extension,
                                              const std::string&)> cb);
 
@@ -54,13 +80,21 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
  private:
   // If the extension loaded successfully, enables it. If it's an app, launches
   // it. If the load failed, updates ShellKeepAliveRequester.
-  void FinishExtensionReload(
-      const ExtensionId& old_extension_id,
-      std::pair<scoped_refptr<const Extension>, std::string> result);
+  void FinishExtensionReload(const ExtensionId& old_extension_id,
+                             const base::FilePath& extension_dir,
+                             std::unique_ptr<LoadResult> result);
 
   void FinishExtensionLoad(
+      const base::FilePath& extension_dir,
       base::OnceCallback<void(const Extension*, const std::string&)> cb,
-      std::pair<scoped_refptr<const Extension>, std::string> result);
+      std::unique_ptr<LoadResult> result);
+
+  // The entry of |extension_dir| in the validated extensions of the session,
+  // and its update after a load.
+  base::Value GetValidatedEntry(const base::FilePath& extension_dir) const;
+  void UpdateValidatedEntry(const base::FilePath& extension_dir,
+                            const LoadResult& result);
+  PrefService* GetPrefs() const;
 
   // ExtensionRegistrar::Delegate:
   void PreAddExtension(const Extension* extension,
@@ -89,6 +123,9 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
   // LoadExtensionForReload().
   bool did_schedule_reload_ = false;
 
+  // The directories of the extensions loaded with a lazy background page.
+  std::set<base::FilePath> lazy_background_dirs_;
+
   base::WeakPtrFactory<ElectronExtensionLoader> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(ElectronExtensionLoader);
@@ -38,9 +38,11 @@ class ElectronExtensionSystem : public ExtensionSystem {
   ~ElectronExtensionSystem() override;
 
   // Loads an unpacked extension from a directory. Returns the extension on
-  // success, or nullptr otherwise.
+  // success, or nullptr otherwise. See ElectronExtensionLoader::LoadExtension()
+  // for |lazy_background|.
   void LoadExtension(
       const base::FilePath& extension_dir,
+      bool lazy_background,
       base::OnceCallback<void(const Extension*, const std::string&)> cb);
 
   // Finish initialization for the shell extension system.
@@ -4,17 +4,53 @@
 
 #include "electron/shell/browser/feature_list.h"
 
+#include <map>
 #include <string>
 
 #include "base/base_switches.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/metrics/field_trial.h"
+#include "base/metrics/field_trial_params.h"
+#include "components/download/public/common/download_features.h"
 #include "content/public/common/content_features.h"
 #include "electron/buildflags/buildflags.h"
 #include "media/base/media_switches.h"
+#include "shell/common/options_switches.h"
 
 namespace electron {
 
+namespace {
+
+// Chromium reads the configuration of parallel downloads from the params of
+// the field trial of the feature.
+const char kParallelDownloadTrial[] = "ElectronParallelDownloads";
+const char kParallelDownloadGroup[] = "Enabled";
+
+}  // namespace
+
+void InitializeFieldTrials() {
+  auto* cmd_line = base::CommandLine::ForCurrentProcess();
+  if (!cmd_line->HasSwitch(switches::kEnableParallelDownloads) ||
+      base::FieldTrialList::TrialExists(kParallelDownloadTrial)) {
+    return;
+  }
+
+  std::map<std::string, std::string> params;
+  if (cmd_line->HasSwitch(switches::kParallelDownloadRequestCount)) {
+    params["request_count"] = cmd_line->GetSwitchValueASCII(
+        switches::kParallelDownloadRequestCount);
+  }
+  if (cmd_line->HasSwitch(switches::kParallelDownloadMinSliceSize)) {
+    params["min_slice_size"] = cmd_line->GetSwitchValueASCII(
+        switches::kParallelDownloadMinSliceSize);
+  }
+  base::AssociateFieldTrialParams(kParallelDownloadTrial,
+                                  kParallelDownloadGroup, params);
+  base::FieldTrialList::CreateFieldTrial(kParallelDownloadTrial,
+                                         kParallelDownloadGroup);
+}
+
 void InitializeFeatureList() {
   auto* cmd_line = base::CommandLine::ForCurrentProcess();
   auto enable_features =
@@ -37,6 +73,12 @@ void InitializeFeatureList() {
 #if !BUILDFLAG(ENABLE_PICTURE_IN_PICTURE)
   disable_features += std::string(",") + media::kPictureInPicture.name;
 #endif
+
+  if (base::FieldTrialList::TrialExists(kParallelDownloadTrial)) {
+    enable_features += std::string(",") +
+                       download::features::kParallelDownloading.name + "<" +
+                       kParallelDownloadTrial;
+  }
   base::FeatureList::InitializeInstance(enable_features, disable_features);
 }
 
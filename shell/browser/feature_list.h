@@ -7,6 +7,9 @@
 
 namespace electron {
 void InitializeFeatureList();
+// Creates the field trials whose params configure the features enabled by
+// InitializeFeatureList(), must be called before it.
+void InitializeFieldTrials();
 }
 
 #endif  // SHELL_BROWSER_FEATURE_LIST_H_
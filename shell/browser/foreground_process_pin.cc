@@ -0,0 +1,60 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/foreground_process_pin.h"
+
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+
+namespace electron {
+
+ForegroundProcessPin::ForegroundProcessPin(content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents) {
+  PinProcess(web_contents->GetMainFrame()->GetProcess());
+}
+
+ForegroundProcessPin::~ForegroundProcessPin() {
+  UnpinProcess();
+}
+
+content::RenderProcessHostPriorityClient::Priority
+ForegroundProcessPin::GetPriority() {
+  Priority priority;
+  priority.is_hidden = false;
+  priority.frame_depth = 0;
+  priority.intersects_viewport = true;
+  return priority;
+}
+
+void ForegroundProcessPin::PinProcess(content::RenderProcessHost* process) {
+  UnpinProcess();
+  if (!process)
+    return;
+  process_id_ = process->GetID();
+  process->AddPriorityClient(this);
+}
+
+void ForegroundProcessPin::UnpinProcess() {
+  if (process_id_ == -1)
+    return;
+  auto* process = content::RenderProcessHost::FromID(process_id_);
+  if (process)
+    process->RemovePriorityClient(this);
+  process_id_ = -1;
+}
+
+void ForegroundProcessPin::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  if (new_host && !new_host->GetParent() &&
+      new_host->GetProcess()->GetID() != process_id_)
+    PinProcess(new_host->GetProcess());
+}
+
+void ForegroundProcessPin::WebContentsDestroyed() {
+  UnpinProcess();
+}
+
+}  // namespace electron
@@ -0,0 +1,48 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_FOREGROUND_PROCESS_PIN_H_
+#define SHELL_BROWSER_FOREGROUND_PROCESS_PIN_H_
+
+#include "base/macros.h"
+#include "content/public/browser/render_process_host_priority_client.h"
+#include "content/public/browser/web_contents_observer.h"
+
+namespace electron {
+
+// Keeps the renderer of the main frame of a WebContents at the foreground
+// priority, also while the page is hidden.
+//
+// Chromium lowers the priority of a renderer once all the pages it shows are
+// hidden, which maps to the background scheduling classes of the OS. The pin
+// counts as a visible page of the renderer, and follows the main frame when
+// it moves to another renderer.
+class ForegroundProcessPin : public content::WebContentsObserver,
+                             public content::RenderProcessHostPriorityClient {
+ public:
+  explicit ForegroundProcessPin(content::WebContents* web_contents);
+  ~ForegroundProcessPin() override;
+
+  // content::RenderProcessHostPriorityClient:
+  Priority GetPriority() override;
+
+ private:
+  void PinProcess(content::RenderProcessHost* process);
+  void UnpinProcess();
+
+  // content::WebContentsObserver:
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
+  void WebContentsDestroyed() override;
+
+  // The ID of the pinned renderer, the host can be gone by the time it is
+  // unpinned.
+  int process_id_ = -1;
+
+  DISALLOW_COPY_AND_ASSIGN(ForegroundProcessPin);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_FOREGROUND_PROCESS_PIN_H_
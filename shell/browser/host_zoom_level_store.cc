@@ -0,0 +1,171 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/host_zoom_level_store.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_restrictions.h"
+
+namespace electron {
+
+namespace {
+
+// How long changes are batched for before being written.
+constexpr base::TimeDelta kCommitDelay = base::TimeDelta::FromSeconds(2);
+
+// The log is rewritten when it has this many more lines than twice the number
+// of hosts.
+constexpr size_t kCompactionSlack = 100;
+
+// Each line is "<zoom level> <host>", or "- <host>" when the zoom level of
+// the host was reset.
+const char kResetMarker[] = "-";
+
+}  // namespace
+
+// The zoom levels as written in the log, only used on the task runner once
+// loaded.
+class HostZoomLevelStore::Backend {
+ public:
+  explicit Backend(const base::FilePath& path)
+      : path_(path), levels_(kMaxHosts) {}
+
+  Levels Load() {
+    std::string contents;
+    if (base::ReadFileToString(path_, &contents)) {
+      for (const auto& line : base::SplitStringPiece(
+               contents, "\n", base::TRIM_WHITESPACE,
+               base::SPLIT_WANT_NONEMPTY)) {
+        ++line_count_;
+        size_t space = line.find(' ');
+        if (space == base::StringPiece::npos || space + 1 == line.size())
+          continue;
+        std::string host = line.substr(space + 1).as_string();
+        base::StringPiece value = line.substr(0, space);
+        double level = 0;
+        if (value == kResetMarker)
+          Erase(host);
+        else if (base::StringToDouble(value, &level))
+          levels_.Put(host, level);
+      }
+    }
+    if (NeedsCompaction())
+      Rewrite();
+
+    // MRUCache iterates from the most recently changed.
+    Levels result;
+    for (auto it = levels_.rbegin(); it != levels_.rend(); ++it)
+      result.emplace_back(it->first, it->second);
+    return result;
+  }
+
+  void Apply(std::vector<Change> changes) {
+    std::string lines;
+    for (const auto& change : changes) {
+      if (change.has_level) {
+        levels_.Put(change.host, change.level);
+        lines += base::NumberToString(change.level);
+      } else {
+        Erase(change.host);
+        lines += kResetMarker;
+      }
+      lines += ' ' + change.host + '\n';
+    }
+    line_count_ += changes.size();
+
+    if (NeedsCompaction() ||
+        !base::AppendToFile(path_, lines.data(), lines.size())) {
+      Rewrite();
+    }
+  }
+
+ private:
+  void Erase(const std::string& host) {
+    auto it = levels_.Peek(host);
+    if (it != levels_.end())
+      levels_.Erase(it);
+  }
+
+  bool NeedsCompaction() const {
+    return line_count_ > 2 * levels_.size() + kCompactionSlack;
+  }
+
+  void Rewrite() {
+    std::string contents;
+    for (auto it = levels_.rbegin(); it != levels_.rend(); ++it)
+      contents += base::NumberToString(it->second) + ' ' + it->first + '\n';
+    if (base::ImportantFileWriter::WriteFileAtomically(path_, contents))
+      line_count_ = levels_.size();
+  }
+
+  const base::FilePath path_;
+  base::MRUCache<std::string, double> levels_;
+  size_t line_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Backend);
+};
+
+HostZoomLevelStore::HostZoomLevelStore(const base::FilePath& path)
+    : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      backend_(new Backend(path),
+               base::OnTaskRunnerDeleter(task_runner_)) {}
+
+HostZoomLevelStore::~HostZoomLevelStore() {
+  // The backend is deleted after the last changes are applied, on the same
+  // sequence.
+  Commit();
+}
+
+HostZoomLevelStore::Levels HostZoomLevelStore::Load() {
+  // Like the preferences of the session, the zoom levels are needed before
+  // the first page loads.
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  return backend_->Load();
+}
+
+void HostZoomLevelStore::Set(const std::string& host, double level) {
+  AddChange({host, true, level});
+}
+
+void HostZoomLevelStore::Remove(const std::string& host) {
+  AddChange({host, false, 0});
+}
+
+void HostZoomLevelStore::AddChange(Change change) {
+  // Lines are split on newlines and hosts on the first space.
+  if (change.host.empty() ||
+      change.host.find_first_of(" \n\r") != std::string::npos) {
+    return;
+  }
+  pending_changes_.push_back(std::move(change));
+  if (!commit_timer_.IsRunning()) {
+    commit_timer_.Start(FROM_HERE, kCommitDelay,
+                        base::BindOnce(&HostZoomLevelStore::Commit,
+                                       base::Unretained(this)));
+  }
+}
+
+void HostZoomLevelStore::Commit() {
+  commit_timer_.Stop();
+  if (pending_changes_.empty())
+    return;
+  // |backend_| is only deleted on |task_runner_|, after this task.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Backend::Apply,
+                                base::Unretained(backend_.get()),
+                                std::move(pending_changes_)));
+  pending_changes_.clear();
+}
+
+}  // namespace electron
@@ -0,0 +1,71 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_HOST_ZOOM_LEVEL_STORE_H_
+#define SHELL_BROWSER_HOST_ZOOM_LEVEL_STORE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+// Keeps the zoom levels of the hosts of a partition in a log file, so that a
+// zoom change appends a line rather than rewriting the preferences of the
+// session. Changes are batched, and written a moment after the first one of a
+// batch on a sequence of the thread pool. The log is rewritten without its
+// stale lines once it gets much longer than the number of hosts, and only the
+// most recently changed hosts are kept past kMaxHosts.
+class HostZoomLevelStore {
+ public:
+  // Host => zoom level, the least recently changed first.
+  using Levels = std::vector<std::pair<std::string, double>>;
+
+  static constexpr size_t kMaxHosts = 10000;
+
+  explicit HostZoomLevelStore(const base::FilePath& path);
+  // Writes the pending changes.
+  ~HostZoomLevelStore();
+
+  // Reads the log synchronously. Must be called before any change.
+  Levels Load();
+
+  // Records that the zoom level of |host| was set to |level|, or reset to
+  // the default.
+  void Set(const std::string& host, double level);
+  void Remove(const std::string& host);
+
+ private:
+  class Backend;
+
+  struct Change {
+    std::string host;
+    // False when the level was reset.
+    bool has_level;
+    double level;
+  };
+
+  void AddChange(Change change);
+  void Commit();
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Lives on |task_runner_| once loaded.
+  std::unique_ptr<Backend, base::OnTaskRunnerDeleter> backend_;
+
+  std::vector<Change> pending_changes_;
+  base::OneShotTimer commit_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostZoomLevelStore);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_HOST_ZOOM_LEVEL_STORE_H_
@@ -10,17 +10,33 @@
 
 #include "base/command_line.h"
 #include "base/message_loop/message_loop_current.h"
+#include "base/strings/stringprintf.h"
 #include "base/task/thread_pool/initialization_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/common/content_switches.h"
 #include "gin/array_buffer.h"
 #include "gin/v8_initializer.h"
 #include "shell/browser/microtasks_runner.h"
+#include "shell/common/cpu_profiler.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
 #include "shell/common/node_includes.h"
 #include "tracing/trace_event.h"
 
 namespace electron {
 
+namespace {
+
+void OnFullGC(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags) {
+  v8::HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+  crash_reporter::RecordBreadcrumb(
+      "gc", base::StringPrintf("used=%zuMB limit=%zuMB",
+                               stats.used_heap_size() >> 20,
+                               stats.heap_size_limit() >> 20));
+}
+
+}  // namespace
+
 JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
     : isolate_(Initialize(event_loop)),
       isolate_holder_(base::ThreadTaskRunnerHandle::Get(),
@@ -31,6 +47,8 @@ JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
                       isolate_),
       locker_(isolate_) {
   isolate_->Enter();
+  // The minor collections are too frequent to be worth a breadcrumb.
+  isolate_->AddGCEpilogueCallback(OnFullGC, v8::kGCTypeMarkSweepCompact);
   v8::HandleScope scope(isolate_);
   auto context = node::NewContext(isolate_);
   context_ = v8::Global<v8::Context>(isolate_, context);
@@ -38,6 +56,7 @@ JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
 }
 
 JavascriptEnvironment::~JavascriptEnvironment() {
+  DisposeCPUProfiler(isolate_);
   {
     v8::HandleScope scope(isolate_);
     context_.Get(isolate_)->Exit();
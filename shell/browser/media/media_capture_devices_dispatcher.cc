@@ -4,7 +4,12 @@
 
 #include "shell/browser/media/media_capture_devices_dispatcher.h"
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/task/post_task.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/media_capture_devices.h"
 
@@ -14,6 +19,10 @@ namespace electron {
 
 namespace {
 
+// How long the requests made before the devices are enumerated wait for it.
+constexpr base::TimeDelta kEnumerationTimeout =
+    base::TimeDelta::FromMilliseconds(500);
+
 // Finds a device in |devices| that has |device_id|, or NULL if not found.
 const blink::MediaStreamDevice* FindDeviceWithId(
     const blink::MediaStreamDevices& devices,
@@ -116,13 +125,76 @@ MediaCaptureDevicesDispatcher::GetFirstAvailableVideoDevice() {
   return &(*video_devices.begin());
 }
 
+void MediaCaptureDevicesDispatcher::StartDeviceMonitoring() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (is_monitoring_ || is_device_enumeration_disabled_)
+    return;
+  is_monitoring_ = true;
+  // The first call starts the monitoring.
+  content::MediaCaptureDevices::GetInstance()->GetAudioCaptureDevices();
+}
+
+void MediaCaptureDevicesDispatcher::WhenDevicesEnumerated(
+    base::OnceClosure callback) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  StartDeviceMonitoring();
+  if (is_device_enumeration_disabled_ ||
+      (audio_devices_enumerated_ && video_devices_enumerated_)) {
+    std::move(callback).Run();
+    return;
+  }
+
+  enumerated_callbacks_.push_back(std::move(callback));
+  if (!enumeration_timer_.IsRunning()) {
+    enumeration_timer_.Start(
+        FROM_HERE, kEnumerationTimeout,
+        base::BindOnce(&MediaCaptureDevicesDispatcher::RunEnumeratedCallbacks,
+                       base::Unretained(this)));
+  }
+}
+
 void MediaCaptureDevicesDispatcher::DisableDeviceEnumerationForTesting() {
   is_device_enumeration_disabled_ = true;
 }
 
-void MediaCaptureDevicesDispatcher::OnAudioCaptureDevicesChanged() {}
+void MediaCaptureDevicesDispatcher::OnAudioDevicesEnumerated() {
+  audio_devices_enumerated_ = true;
+  if (video_devices_enumerated_)
+    RunEnumeratedCallbacks();
+}
 
-void MediaCaptureDevicesDispatcher::OnVideoCaptureDevicesChanged() {}
+void MediaCaptureDevicesDispatcher::OnVideoDevicesEnumerated() {
+  video_devices_enumerated_ = true;
+  if (audio_devices_enumerated_)
+    RunEnumeratedCallbacks();
+}
+
+void MediaCaptureDevicesDispatcher::RunEnumeratedCallbacks() {
+  // After a timeout the lists are used as they are, the OS may not report
+  // anything when there is no device.
+  audio_devices_enumerated_ = true;
+  video_devices_enumerated_ = true;
+  enumeration_timer_.Stop();
+  auto callbacks = std::move(enumerated_callbacks_);
+  enumerated_callbacks_.clear();
+  for (auto& callback : callbacks)
+    std::move(callback).Run();
+}
+
+// Called on the IO thread.
+void MediaCaptureDevicesDispatcher::OnAudioCaptureDevicesChanged() {
+  base::PostTask(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&MediaCaptureDevicesDispatcher::OnAudioDevicesEnumerated,
+                     base::Unretained(this)));
+}
+
+void MediaCaptureDevicesDispatcher::OnVideoCaptureDevicesChanged() {
+  base::PostTask(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&MediaCaptureDevicesDispatcher::OnVideoDevicesEnumerated,
+                     base::Unretained(this)));
+}
 
 void MediaCaptureDevicesDispatcher::OnMediaRequestStateChanged(
     int render_process_id,
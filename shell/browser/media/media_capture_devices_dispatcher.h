@@ -6,8 +6,11 @@
 #define SHELL_BROWSER_MEDIA_MEDIA_CAPTURE_DEVICES_DISPATCHER_H_
 
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/memory/singleton.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/media_observer.h"
 #include "content/public/browser/media_stream_request.h"
 #include "third_party/blink/public/common/mediastream/media_stream_request.h"
@@ -45,6 +48,16 @@ class MediaCaptureDevicesDispatcher : public content::MediaObserver {
   const blink::MediaStreamDevice* GetFirstAvailableAudioDevice();
   const blink::MediaStreamDevice* GetFirstAvailableVideoDevice();
 
+  // Content enumerates the capture devices on its device thread once asked
+  // for them, and keeps the lists up to date from the device change
+  // notifications of the OS. Starting it before the first request gives the
+  // request ready lists.
+  void StartDeviceMonitoring();
+
+  // Runs |callback| once the capture devices have been enumerated, or right
+  // away if they already have been.
+  void WhenDevicesEnumerated(base::OnceClosure callback);
+
   // Unittests that do not require actual device enumeration should call this
   // API on the singleton. It is safe to call this multiple times on the
   // signleton.
@@ -73,6 +86,10 @@ class MediaCaptureDevicesDispatcher : public content::MediaObserver {
   MediaCaptureDevicesDispatcher();
   ~MediaCaptureDevicesDispatcher() override;
 
+  void OnAudioDevicesEnumerated();
+  void OnVideoDevicesEnumerated();
+  void RunEnumeratedCallbacks();
+
   // Only for testing, a list of cached audio capture devices.
   blink::MediaStreamDevices test_audio_devices_;
 
@@ -82,6 +99,15 @@ class MediaCaptureDevicesDispatcher : public content::MediaObserver {
   // Flag used by unittests to disable device enumeration.
   bool is_device_enumeration_disabled_;
 
+  bool is_monitoring_ = false;
+  bool audio_devices_enumerated_ = false;
+  bool video_devices_enumerated_ = false;
+
+  // Waiting for the devices to be enumerated, or for |enumeration_timer_|
+  // when the OS does not report some of them.
+  std::vector<base::OnceClosure> enumerated_callbacks_;
+  base::OneShotTimer enumeration_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(MediaCaptureDevicesDispatcher);
 };
 
@@ -12,11 +12,13 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/native_browser_view.h"
 #include "shell/browser/window_list.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/persistent_dictionary.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "ui/views/widget/widget.h"
 
 #if defined(OS_WIN)
@@ -57,6 +59,8 @@ NativeWindow::NativeWindow(const gin_helper::Dictionary& options,
     options.Get("modal", &is_modal_);
 
   WindowList::AddWindow(this);
+  StartupTimings::GetInstance()->Record(
+      StartupTimings::Milestone::kFirstWindowCreated);
 }
 
 NativeWindow::~NativeWindow() {
@@ -324,6 +328,12 @@ void NativeWindow::SetFocusable(bool focusable) {}
 
 void NativeWindow::SetMenu(ElectronMenuModel* menu) {}
 
+void NativeWindow::SetBrowserViewsBounds(
+    const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds) {
+  for (const auto& it : bounds)
+    it.first->SetBounds(it.second);
+}
+
 void NativeWindow::SetParentWindow(NativeWindow* parent) {
   parent_ = parent;
 }
@@ -1272,6 +1272,15 @@ void NativeWindowMac::AddBrowserView(NativeBrowserView* view) {
   [CATransaction commit];
 }
 
+void NativeWindowMac::SetBrowserViewsBounds(
+    const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds) {
+  // Committed together, so that no frame shows only some of the views moved.
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  NativeWindow::SetBrowserViewsBounds(bounds);
+  [CATransaction commit];
+}
+
 void NativeWindowMac::RemoveBrowserView(NativeBrowserView* view) {
   [CATransaction begin];
   [CATransaction setDisableActions:YES];
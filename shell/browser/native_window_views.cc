@@ -32,6 +32,7 @@
 #include "shell/common/options_switches.h"
 #include "ui/aura/window_tree_host.h"
 #include "ui/base/hit_test.h"
+#include "ui/compositor/layer.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/views/background.h"
@@ -937,6 +938,14 @@ bool NativeWindowViews::HasShadow() {
 void NativeWindowViews::SetOpacity(const double opacity) {
 #if defined(OS_WIN)
   const double boundedOpacity = base::ClampToRange(opacity, 0.0, 1.0);
+  if (transparent()) {
+    // Transparent windows are already presented with alpha by the GPU, making
+    // them layered would have every frame read back and uploaded by the CPU
+    // with UpdateLayeredWindow, so the compositor fades the contents instead.
+    GetNativeWindow()->layer()->SetOpacity(boundedOpacity);
+    opacity_ = boundedOpacity;
+    return;
+  }
   HWND hwnd = GetAcceleratedWidget();
   if (!layered_) {
     LONG ex_style = ::GetWindowLong(hwnd, GWL_EXSTYLE);
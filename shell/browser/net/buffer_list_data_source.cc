@@ -0,0 +1,71 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/buffer_list_data_source.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+BufferListDataSource::BufferListDataSource() = default;
+
+BufferListDataSource::~BufferListDataSource() = default;
+
+bool BufferListDataSource::Append(v8::Local<v8::Value> value) {
+  if (!node::Buffer::HasInstance(value))
+    return false;
+  auto view = value.As<v8::ArrayBufferView>();
+  Chunk chunk;
+  chunk.backing_store = view->Buffer()->GetBackingStore();
+  chunk.data = static_cast<const char*>(chunk.backing_store->Data()) +
+               view->ByteOffset();
+  chunk.size = view->ByteLength();
+  length_ += chunk.size;
+  chunks_.push_back(std::move(chunk));
+  return true;
+}
+
+uint64_t BufferListDataSource::GetLength() const {
+  return length_;
+}
+
+BufferListDataSource::ReadResult BufferListDataSource::Read(
+    uint64_t offset,
+    base::span<char> buffer) {
+  ReadResult result;
+  if (offset > length_) {
+    NOTREACHED();
+    result.result = MOJO_RESULT_OUT_OF_RANGE;
+    return result;
+  }
+  // The pipe is written in order, so the search for the chunk holding
+  // |offset| starts from the one the last read ended in.
+  if (offset < chunk_start_) {
+    chunk_index_ = 0;
+    chunk_start_ = 0;
+  }
+  size_t bytes_read = 0;
+  while (chunk_index_ < chunks_.size() && bytes_read < buffer.size()) {
+    const Chunk& chunk = chunks_[chunk_index_];
+    uint64_t position = offset + bytes_read;
+    if (position >= chunk_start_ + chunk.size) {
+      chunk_start_ += chunk.size;
+      ++chunk_index_;
+      continue;
+    }
+    size_t chunk_offset = position - chunk_start_;
+    size_t size =
+        std::min(chunk.size - chunk_offset, buffer.size() - bytes_read);
+    memcpy(buffer.data() + bytes_read, chunk.data + chunk_offset, size);
+    bytes_read += size;
+  }
+  result.bytes_read = bytes_read;
+  return result;
+}
+
+}  // namespace electron
@@ -0,0 +1,53 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_BUFFER_LIST_DATA_SOURCE_H_
+#define SHELL_BROWSER_NET_BUFFER_LIST_DATA_SOURCE_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Reads a response body straight from the memory of a list of Buffers,
+// instead of first joining them into one string. The backing stores keep the
+// memory alive while the pipe is written on another thread.
+class BufferListDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  BufferListDataSource();
+  ~BufferListDataSource() override;
+
+  // Returns false when |value| is not a Buffer.
+  bool Append(v8::Local<v8::Value> value);
+
+  bool empty() const { return length_ == 0; }
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override;
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override;
+
+ private:
+  struct Chunk {
+    std::shared_ptr<v8::BackingStore> backing_store;
+    const char* data = nullptr;
+    size_t size = 0;
+  };
+
+  std::vector<Chunk> chunks_;
+  uint64_t length_ = 0;
+
+  // The chunk the last read ended in, and its offset in the body.
+  size_t chunk_index_ = 0;
+  uint64_t chunk_start_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferListDataSource);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_BUFFER_LIST_DATA_SOURCE_H_
@@ -0,0 +1,361 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/directory_url_loader_factory.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/escape.h"
+#include "net/base/filename_util.h"
+#include "net/base/mime_sniffer.h"
+#include "net/base/mime_util.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/electron_constants.h"
+
+namespace electron {
+
+namespace {
+
+constexpr char kIndexFile[] = "index.html";
+
+// Returns the size and modification time of the file at |path|, which can be
+// in an asar archive. The files in an archive carry the time of the archive.
+bool GetFileStat(const base::FilePath& path,
+                 int64_t* size,
+                 base::Time* last_modified) {
+  base::File::Info file_info;
+  base::FilePath asar_path, relative_path;
+  if (!asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    if (!base::GetFileInfo(path, &file_info) || file_info.is_directory)
+      return false;
+    *size = file_info.size;
+    *last_modified = file_info.last_modified;
+    return true;
+  }
+
+  std::shared_ptr<asar::Archive> archive =
+      asar::GetOrCreateAsarArchive(asar_path);
+  asar::Archive::FileInfo info;
+  if (!archive || !archive->GetFileInfo(relative_path, &info) ||
+      !base::GetFileInfo(archive->path(), &file_info))
+    return false;
+  *size = info.size;
+  *last_modified = file_info.last_modified;
+  return true;
+}
+
+// Formats |time| as an HTTP date, e.g. "Wed, 21 Oct 2015 07:28:00 GMT".
+std::string FormatHTTPDate(base::Time time) {
+  static constexpr const char* kDays[] = {"Sun", "Mon", "Tue", "Wed",
+                                          "Thu", "Fri", "Sat"};
+  static constexpr const char* kMonths[] = {"Jan", "Feb", "Mar", "Apr",
+                                            "May", "Jun", "Jul", "Aug",
+                                            "Sep", "Oct", "Nov", "Dec"};
+  base::Time::Exploded exploded;
+  time.UTCExplode(&exploded);
+  return base::StringPrintf(
+      "%s, %02d %s %04d %02d:%02d:%02d GMT", kDays[exploded.day_of_week],
+      exploded.day_of_month, kMonths[exploded.month - 1], exploded.year,
+      exploded.hour, exploded.minute, exploded.second);
+}
+
+// Whether the validators of the client still match the file, in which case
+// it gets a 304 instead of the file.
+bool IsNotModified(const net::HttpRequestHeaders& headers,
+                   const std::string& etag,
+                   base::Time last_modified) {
+  std::string value;
+  if (headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch, &value)) {
+    for (const auto& tag : base::SplitStringPiece(
+             value, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+      if (tag == "*" || tag == etag)
+        return true;
+    }
+    return false;
+  }
+  base::Time since;
+  if (headers.GetHeader(net::HttpRequestHeaders::kIfModifiedSince, &value) &&
+      base::Time::FromString(value.c_str(), &since)) {
+    // HTTP dates have a resolution of seconds.
+    return last_modified - since < base::TimeDelta::FromSeconds(1);
+  }
+  return false;
+}
+
+// Keeps the cached entry and the client alive while the entry is written.
+struct WriteData {
+  mojo::Remote<network::mojom::URLLoaderClient> client;
+  std::shared_ptr<const StaticFileCache::Entry> entry;
+  std::unique_ptr<mojo::DataPipeProducer> producer;
+};
+
+void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
+  if (result != MOJO_RESULT_OK) {
+    write_data->client->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_FAILED));
+    return;
+  }
+
+  network::URLLoaderCompletionStatus status(net::OK);
+  status.encoded_data_length = write_data->entry->data.size();
+  status.encoded_body_length = write_data->entry->data.size();
+  status.decoded_body_length = write_data->entry->data.size();
+  write_data->client->OnComplete(status);
+}
+
+void SendResponse(mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+                  network::mojom::URLResponseHeadPtr head,
+                  std::shared_ptr<const StaticFileCache::Entry> entry) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  head->content_length = entry ? entry->data.size() : 0;
+  client_remote->OnReceiveResponse(std::move(head));
+  client_remote->OnStartLoadingResponseBody(std::move(consumer));
+  if (!entry) {
+    client_remote->OnComplete(network::URLLoaderCompletionStatus(net::OK));
+    return;
+  }
+
+  auto write_data = std::make_unique<WriteData>();
+  write_data->client = std::move(client_remote);
+  write_data->entry = std::move(entry);
+  write_data->producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+
+  mojo::DataPipeProducer* producer_ptr = write_data->producer.get();
+  base::StringPiece data(write_data->entry->data);
+  producer_ptr->Write(
+      std::make_unique<mojo::StringDataSource>(
+          data, mojo::StringDataSource::AsyncWritingMode::
+                    STRING_STAYS_VALID_UNTIL_COMPLETION),
+      base::BindOnce(OnWrite, std::move(write_data)));
+}
+
+// Reads the file at |path| into a cache entry, or returns null when the file
+// changed since it was stat'ed as |size| and |last_modified|. Otherwise the
+// data of the new file would be cached and validated under the ETag of the
+// old one.
+std::shared_ptr<const StaticFileCache::Entry> ReadEntry(
+    const base::FilePath& path,
+    const GURL& url,
+    int64_t size,
+    base::Time last_modified) {
+  auto entry = std::make_shared<StaticFileCache::Entry>();
+  if (!asar::ReadFileToString(path, &entry->data) ||
+      entry->data.size() != static_cast<size_t>(size))
+    return nullptr;
+  int64_t new_size = 0;
+  base::Time new_last_modified;
+  if (!GetFileStat(path, &new_size, &new_last_modified) || new_size != size ||
+      new_last_modified != last_modified)
+    return nullptr;
+  if (!net::GetMimeTypeFromFile(path, &entry->mime_type)) {
+    size_t sniff_size = std::min(entry->data.size(), net::kMaxBytesToSniff);
+    net::SniffMimeType(entry->data.data(), sniff_size, url, std::string(),
+                       net::ForceSniffFileUrlsForHtml::kDisabled,
+                       &entry->mime_type);
+  }
+  entry->size = size;
+  entry->last_modified = last_modified;
+  return entry;
+}
+
+// Runs on the thread pool.
+void StartLoad(const base::FilePath& path,
+               const network::ResourceRequest& request,
+               mojo::PendingReceiver<network::mojom::URLLoader> loader,
+               mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+               scoped_refptr<StaticFileCache> cache) {
+  int64_t size = 0;
+  base::Time last_modified;
+  if (!GetFileStat(path, &size, &last_modified)) {
+    mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+        std::move(client));
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_FILE_NOT_FOUND));
+    return;
+  }
+
+  int64_t mtime = last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds();
+  std::string etag = "\"" + base::NumberToString(size) + "-" +
+                     base::NumberToString(mtime) + "\"";
+  auto head = network::mojom::URLResponseHead::New();
+  head->request_start = base::TimeTicks::Now();
+  head->response_start = base::TimeTicks::Now();
+
+  if (IsNotModified(request.headers, etag, last_modified)) {
+    head->headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+        "HTTP/1.1 304 Not Modified");
+  } else {
+    head->headers =
+        base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200 OK");
+  }
+  head->headers->AddHeader(kCORSHeader);
+  head->headers->AddHeader("ETag: " + etag);
+  head->headers->AddHeader("Last-Modified: " + FormatHTTPDate(last_modified));
+  if (head->headers->response_code() == 304) {
+    SendResponse(std::move(client), std::move(head), nullptr);
+    return;
+  }
+
+  // Ranges are left to the asar loader, which reads only the requested part
+  // of the file.
+  if (cache && static_cast<uint64_t>(size) <= cache->max_entry_bytes() &&
+      !request.headers.HasHeader(net::HttpRequestHeaders::kRange)) {
+    std::shared_ptr<const StaticFileCache::Entry> entry = cache->Get(path);
+    if (!entry || entry->size != size ||
+        entry->last_modified != last_modified) {
+      entry = ReadEntry(path, request.url, size, last_modified);
+      if (entry)
+        cache->Put(path, entry);
+    }
+    if (entry) {
+      head->mime_type = entry->mime_type;
+      head->headers->AddHeader(
+          base::StringPrintf("%s: %s", net::HttpRequestHeaders::kContentType,
+                             entry->mime_type.c_str()));
+      SendResponse(std::move(client), std::move(head), std::move(entry));
+      return;
+    }
+  }
+
+  network::ResourceRequest file_request = request;
+  file_request.url = net::FilePathToFileURL(path);
+  asar::CreateAsarURLLoader(file_request, std::move(loader), std::move(client),
+                            std::move(head->headers));
+}
+
+}  // namespace
+
+StaticFileCache::StaticFileCache(size_t max_bytes)
+    : max_bytes_(max_bytes), entries_(Entries::NO_AUTO_EVICT) {}
+
+StaticFileCache::~StaticFileCache() = default;
+
+std::shared_ptr<const StaticFileCache::Entry> StaticFileCache::Get(
+    const base::FilePath& path) {
+  base::AutoLock auto_lock(lock_);
+  auto it = entries_.Get(path);
+  return it == entries_.end() ? nullptr : it->second;
+}
+
+void StaticFileCache::Put(const base::FilePath& path,
+                          std::shared_ptr<const Entry> entry) {
+  base::AutoLock auto_lock(lock_);
+  auto it = entries_.Peek(path);
+  if (it != entries_.end()) {
+    bytes_ -= it->second->data.size();
+    entries_.Erase(it);
+  }
+  bytes_ += entry->data.size();
+  entries_.Put(path, std::move(entry));
+  while (bytes_ > max_bytes_) {
+    auto oldest = entries_.rbegin();
+    bytes_ -= oldest->second->data.size();
+    entries_.Erase(oldest);
+  }
+}
+
+DirectoryProtocol::DirectoryProtocol() = default;
+DirectoryProtocol::DirectoryProtocol(const DirectoryProtocol&) = default;
+DirectoryProtocol::~DirectoryProtocol() = default;
+
+DirectoryURLLoaderFactory::DirectoryURLLoaderFactory(
+    const DirectoryProtocol& protocol)
+    : protocol_(protocol) {}
+
+DirectoryURLLoaderFactory::~DirectoryURLLoaderFactory() = default;
+
+// static
+base::FilePath DirectoryURLLoaderFactory::GetFilePath(
+    const DirectoryRoutes& routes,
+    const GURL& url) {
+  // Standard schemes carry the first part of the path in the host.
+  std::string path = url.has_host() ? url.host() + url.path() : url.path();
+  path = net::UnescapeBinaryURLComponent(path);
+  // Directories are served from their index file.
+  bool is_directory =
+      path.empty() || base::EndsWith(path, "/", base::CompareCase::SENSITIVE);
+  base::TrimString(path, "/", &path);
+
+  // The longest prefix wins.
+  const DirectoryRoutes::value_type* route = nullptr;
+  for (const auto& it : routes) {
+    const std::string& prefix = it.first;
+    bool matches =
+        prefix.empty() ||
+        (base::StartsWith(path, prefix, base::CompareCase::SENSITIVE) &&
+         (path.size() == prefix.size() || path[prefix.size()] == '/'));
+    if (matches && (!route || prefix.size() > route->first.size()))
+      route = &it;
+  }
+  if (!route)
+    return base::FilePath();
+
+  std::string relative_path = path.substr(route->first.size());
+  base::TrimString(relative_path, "/", &relative_path);
+  base::FilePath relative = base::FilePath::FromUTF8Unsafe(relative_path);
+  if (relative.IsAbsolute() || relative.ReferencesParent())
+    return base::FilePath();
+  if (is_directory || relative_path.empty())
+    relative = relative.AppendASCII(kIndexFile);
+  return route->second.Append(relative);
+}
+
+void DirectoryURLLoaderFactory::CreateLoaderAndStart(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
+  base::FilePath path = GetFilePath(protocol_.routes, request.url);
+  if (path.empty()) {
+    mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+        std::move(client));
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_FILE_NOT_FOUND));
+    return;
+  }
+
+  auto task_runner = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  task_runner->PostTask(
+      FROM_HERE, base::BindOnce(&StartLoad, path, request, std::move(loader),
+                                std::move(client), protocol_.cache));
+}
+
+void DirectoryURLLoaderFactory::Clone(
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver) {
+  receivers_.Add(this, std::move(receiver));
+}
+
+}  // namespace electron
@@ -0,0 +1,118 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
+#define SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Path prefix => directory, or asar archive, the paths under it are served
+// from.
+using DirectoryRoutes = std::map<std::string, base::FilePath>;
+
+// Keeps the most recently served files of a directory protocol in memory, up
+// to a total size. It is shared by all the factories of the protocol and used
+// from the thread pool.
+class StaticFileCache : public base::RefCountedThreadSafe<StaticFileCache> {
+ public:
+  struct Entry {
+    std::string data;
+    std::string mime_type;
+    // The file the data was read from, an entry is only used while they
+    // still match.
+    int64_t size = 0;
+    base::Time last_modified;
+  };
+
+  explicit StaticFileCache(size_t max_bytes);
+
+  // Returns the entry of |path|, or null when it is not cached.
+  std::shared_ptr<const Entry> Get(const base::FilePath& path);
+  void Put(const base::FilePath& path, std::shared_ptr<const Entry> entry);
+
+  // Files larger than this are not cached, so that a single file can not
+  // evict all the others.
+  size_t max_entry_bytes() const { return max_bytes_ / 4; }
+
+ private:
+  friend class base::RefCountedThreadSafe<StaticFileCache>;
+
+  using Entries = base::MRUCache<base::FilePath, std::shared_ptr<const Entry>>;
+
+  ~StaticFileCache();
+
+  const size_t max_bytes_;
+
+  base::Lock lock_;
+  Entries entries_;
+  size_t bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticFileCache);
+};
+
+struct DirectoryProtocol {
+  DirectoryProtocol();
+  DirectoryProtocol(const DirectoryProtocol&);
+  ~DirectoryProtocol();
+
+  DirectoryRoutes routes;
+  // Null when the protocol does not cache its files.
+  scoped_refptr<StaticFileCache> cache;
+};
+
+// scheme => protocol.
+using DirectoryProtocolsMap = std::map<std::string, DirectoryProtocol>;
+
+// Serves the requests of a scheme from files, mapping their paths through a
+// route table. Unlike the protocols with a JS handler no JS runs for the
+// requests, the files are read on the thread pool.
+class DirectoryURLLoaderFactory : public network::mojom::URLLoaderFactory {
+ public:
+  explicit DirectoryURLLoaderFactory(const DirectoryProtocol& protocol);
+  ~DirectoryURLLoaderFactory() override;
+
+  // Returns the file |url| maps to, or an empty path when no route matches or
+  // the path leaves the directory of its route.
+  static base::FilePath GetFilePath(const DirectoryRoutes& routes,
+                                    const GURL& url);
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override;
+  void Clone(mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver)
+      override;
+
+ private:
+  mojo::ReceiverSet<network::mojom::URLLoaderFactory> receivers_;
+
+  DirectoryProtocol protocol_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryURLLoaderFactory);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
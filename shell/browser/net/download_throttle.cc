@@ -0,0 +1,334 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/download_throttle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/timer/timer.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "net/http/http_byte_range.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_util.h"
+#include "net/url_request/redirect_info.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+
+namespace electron {
+
+namespace {
+
+// How much of a second of budget can pile up while a download does not use
+// it, which bounds the bursts after a pause.
+constexpr double kBurstSeconds = 0.25;
+
+// Waits shorter than this are not worth a timer on their own.
+constexpr base::TimeDelta kMinRetryDelay =
+    base::TimeDelta::FromMilliseconds(10);
+
+// How many chunks a pump moves before letting the other pumps of the
+// sequence run.
+constexpr int kChunksPerTask = 16;
+
+constexpr size_t kMaxPendingResponses = 32;
+
+// The first byte requested by |request|, which is where a resumed download
+// starts again.
+int64_t GetRangeOffset(const network::ResourceRequest& request) {
+  std::string range;
+  std::vector<net::HttpByteRange> ranges;
+  if (!request.headers.GetHeader(net::HttpRequestHeaders::kRange, &range) ||
+      !net::HttpUtil::ParseRangeHeader(range, &ranges) || ranges.size() != 1 ||
+      !ranges[0].HasFirstBytePosition())
+    return 0;
+  return ranges[0].first_byte_position();
+}
+
+// Moves a body from |source| to |destination| within the budget of the
+// limiters, on the sequence it is created on. Deletes itself once either
+// pipe is closed.
+class BodyPump {
+ public:
+  BodyPump(mojo::ScopedDataPipeConsumerHandle source,
+           mojo::ScopedDataPipeProducerHandle destination,
+           scoped_refptr<BandwidthLimiter> download_limiter,
+           scoped_refptr<BandwidthLimiter> session_limiter)
+      : source_(std::move(source)),
+        destination_(std::move(destination)),
+        download_limiter_(std::move(download_limiter)),
+        session_limiter_(std::move(session_limiter)),
+        source_watcher_(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL),
+        destination_watcher_(FROM_HERE,
+                             mojo::SimpleWatcher::ArmingPolicy::MANUAL) {
+    source_watcher_.Watch(
+        source_.get(),
+        MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&BodyPump::OnReady, base::Unretained(this)));
+    destination_watcher_.Watch(
+        destination_.get(),
+        MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&BodyPump::OnReady, base::Unretained(this)));
+  }
+
+  static void Start(mojo::ScopedDataPipeConsumerHandle source,
+                    mojo::ScopedDataPipeProducerHandle destination,
+                    scoped_refptr<BandwidthLimiter> download_limiter,
+                    scoped_refptr<BandwidthLimiter> session_limiter) {
+    (new BodyPump(std::move(source), std::move(destination),
+                  std::move(download_limiter), std::move(session_limiter)))
+        ->Pump();
+  }
+
+ private:
+  void OnReady(MojoResult result) { Pump(); }
+
+  // Takes from both budgets, returns what the session could not give to the
+  // download.
+  size_t Take(size_t wanted, base::TimeDelta* retry_after) {
+    size_t granted = download_limiter_->Take(wanted, retry_after);
+    if (!granted)
+      return 0;
+    size_t session_granted = session_limiter_->Take(granted, retry_after);
+    if (session_granted < granted)
+      download_limiter_->Return(granted - session_granted);
+    return session_granted;
+  }
+
+  void Pump() {
+    for (int i = 0; i < kChunksPerTask; ++i) {
+      const void* in = nullptr;
+      uint32_t available = 0;
+      MojoResult result =
+          source_->BeginReadData(&in, &available, MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        source_watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The whole body was moved.
+        delete this;
+        return;
+      }
+
+      void* out = nullptr;
+      uint32_t space = 0;
+      result =
+          destination_->BeginWriteData(&out, &space, MOJO_WRITE_DATA_FLAG_NONE);
+      if (result != MOJO_RESULT_OK) {
+        source_->EndReadData(0);
+        if (result == MOJO_RESULT_SHOULD_WAIT) {
+          destination_watcher_.ArmOrNotify();
+        } else {
+          // The download went away.
+          delete this;
+        }
+        return;
+      }
+
+      base::TimeDelta retry_after;
+      size_t granted =
+          Take(std::min<size_t>(available, space), &retry_after);
+      if (granted)
+        memcpy(out, in, granted);
+      destination_->EndWriteData(granted);
+      source_->EndReadData(granted);
+      if (!granted) {
+        retry_timer_.Start(FROM_HERE, std::max(retry_after, kMinRetryDelay),
+                           base::BindOnce(&BodyPump::Pump,
+                                          base::Unretained(this)));
+        return;
+      }
+    }
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&BodyPump::Pump, weak_factory_.GetWeakPtr()));
+  }
+
+  mojo::ScopedDataPipeConsumerHandle source_;
+  mojo::ScopedDataPipeProducerHandle destination_;
+  scoped_refptr<BandwidthLimiter> download_limiter_;
+  scoped_refptr<BandwidthLimiter> session_limiter_;
+  mojo::SimpleWatcher source_watcher_;
+  mojo::SimpleWatcher destination_watcher_;
+  base::OneShotTimer retry_timer_;
+
+  base::WeakPtrFactory<BodyPump> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(BodyPump);
+};
+
+}  // namespace
+
+BandwidthLimiter::BandwidthLimiter() = default;
+BandwidthLimiter::~BandwidthLimiter() = default;
+
+void BandwidthLimiter::SetLimit(int64_t bytes_per_second) {
+  base::AutoLock lock(lock_);
+  limit_ = std::max<int64_t>(bytes_per_second, 0);
+  budget_ = 0;
+  last_refill_ = base::TimeTicks::Now();
+}
+
+int64_t BandwidthLimiter::GetLimit() const {
+  base::AutoLock lock(lock_);
+  return limit_;
+}
+
+size_t BandwidthLimiter::Take(size_t wanted, base::TimeDelta* retry_after) {
+  base::AutoLock lock(lock_);
+  if (!limit_)
+    return wanted;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  budget_ = std::min(budget_ + (now - last_refill_).InSecondsF() * limit_,
+                     std::max(limit_ * kBurstSeconds, 1.0));
+  last_refill_ = now;
+  if (budget_ < 1) {
+    *retry_after = base::TimeDelta::FromSecondsD((1 - budget_) / limit_);
+    return 0;
+  }
+  size_t granted = std::min<size_t>(wanted, budget_);
+  budget_ -= granted;
+  return granted;
+}
+
+void BandwidthLimiter::Return(size_t bytes) {
+  base::AutoLock lock(lock_);
+  if (limit_)
+    budget_ += bytes;
+}
+
+// Forwards the events of a download loader, with the body going through a
+// BodyPump, and deletes itself when either side goes away.
+class DownloadThrottle::ClientProxy : public network::mojom::URLLoaderClient {
+ public:
+  ClientProxy(base::WeakPtr<DownloadThrottle> throttle,
+              mojo::PendingReceiver<network::mojom::URLLoaderClient> receiver,
+              mojo::PendingRemote<network::mojom::URLLoaderClient> target)
+      : throttle_(std::move(throttle)),
+        receiver_(this, std::move(receiver)),
+        target_(std::move(target)),
+        limiter_(base::MakeRefCounted<BandwidthLimiter>()) {
+    receiver_.set_disconnect_handler(
+        base::BindOnce(&ClientProxy::OnDisconnect, base::Unretained(this)));
+    target_.set_disconnect_handler(
+        base::BindOnce(&ClientProxy::OnDisconnect, base::Unretained(this)));
+  }
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override {
+    if (throttle_)
+      throttle_->AddResponse(url_, offset_, limiter_);
+    target_->OnReceiveResponse(std::move(head));
+  }
+
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {
+    url_ = redirect_info.new_url;
+    target_->OnReceiveRedirect(redirect_info, std::move(head));
+  }
+
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override {
+    target_->OnUploadProgress(current_position, total_size,
+                              std::move(callback));
+  }
+
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override {
+    target_->OnReceiveCachedMetadata(std::move(data));
+  }
+
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {
+    target_->OnTransferSizeUpdated(transfer_size_diff);
+  }
+
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override {
+    mojo::ScopedDataPipeProducerHandle producer;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    if (!throttle_ ||
+        mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
+      target_->OnStartLoadingResponseBody(std::move(body));
+      return;
+    }
+    throttle_->task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&BodyPump::Start, std::move(body), std::move(producer),
+                       limiter_, throttle_->session_limiter_));
+    target_->OnStartLoadingResponseBody(std::move(consumer));
+  }
+
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    target_->OnComplete(status);
+  }
+
+  void set_url(const GURL& url) { url_ = url; }
+  void set_offset(int64_t offset) { offset_ = offset; }
+
+ private:
+  void OnDisconnect() { delete this; }
+
+  base::WeakPtr<DownloadThrottle> throttle_;
+  mojo::Receiver<network::mojom::URLLoaderClient> receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> target_;
+  scoped_refptr<BandwidthLimiter> limiter_;
+  GURL url_;
+  int64_t offset_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ClientProxy);
+};
+
+DownloadThrottle::DownloadThrottle()
+    : session_limiter_(base::MakeRefCounted<BandwidthLimiter>()),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_VISIBLE})) {}
+
+DownloadThrottle::~DownloadThrottle() = default;
+
+mojo::PendingRemote<network::mojom::URLLoaderClient>
+DownloadThrottle::WrapClient(
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  mojo::PendingRemote<network::mojom::URLLoaderClient> proxy_remote;
+  auto* proxy =
+      new ClientProxy(weak_factory_.GetWeakPtr(),
+                      proxy_remote.InitWithNewPipeAndPassReceiver(),
+                      std::move(client));
+  proxy->set_url(request.url);
+  proxy->set_offset(GetRangeOffset(request));
+  return proxy_remote;
+}
+
+scoped_refptr<BandwidthLimiter> DownloadThrottle::TakeLimiter(
+    const GURL& url,
+    int64_t offset) {
+  for (auto it = responses_.begin(); it != responses_.end(); ++it) {
+    if (it->url == url && it->offset == offset) {
+      scoped_refptr<BandwidthLimiter> limiter = std::move(it->limiter);
+      responses_.erase(it);
+      return limiter;
+    }
+  }
+  return nullptr;
+}
+
+void DownloadThrottle::AddResponse(const GURL& url,
+                                   int64_t offset,
+                                   scoped_refptr<BandwidthLimiter> limiter) {
+  responses_.push_front({url, offset, std::move(limiter)});
+  if (responses_.size() > kMaxPendingResponses)
+    responses_.pop_back();
+}
+
+}  // namespace electron
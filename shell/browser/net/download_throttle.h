@@ -0,0 +1,101 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_DOWNLOAD_THROTTLE_H_
+#define SHELL_BROWSER_NET_DOWNLOAD_THROTTLE_H_
+
+#include <list>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// A token bucket of bytes per second, shared by the sequences that move the
+// bodies of downloads.
+class BandwidthLimiter : public base::RefCountedThreadSafe<BandwidthLimiter> {
+ public:
+  BandwidthLimiter();
+
+  // 0 for no limit.
+  void SetLimit(int64_t bytes_per_second);
+  int64_t GetLimit() const;
+
+  // Takes up to |wanted| bytes from the budget. When it gives none,
+  // |retry_after| is how long until there is some again.
+  size_t Take(size_t wanted, base::TimeDelta* retry_after);
+  // Gives back bytes that were taken but not used.
+  void Return(size_t bytes);
+
+ private:
+  friend class base::RefCountedThreadSafe<BandwidthLimiter>;
+  ~BandwidthLimiter();
+
+  mutable base::Lock lock_;
+  int64_t limit_ = 0;
+  double budget_ = 0;
+  base::TimeTicks last_refill_;
+
+  DISALLOW_COPY_AND_ASSIGN(BandwidthLimiter);
+};
+
+// Moves the response bodies of the downloads of a session through data pipes
+// of its own, at the rate allowed by the limit of the session and by the one
+// of each download, so that background downloads leave bandwidth to the other
+// requests. The bodies are moved on a sequence of the thread pool.
+class DownloadThrottle {
+ public:
+  DownloadThrottle();
+  ~DownloadThrottle();
+
+  BandwidthLimiter* session_limiter() const { return session_limiter_.get(); }
+
+  // Returns a client that forwards to |client| with a throttled body, for
+  // |request|.
+  mojo::PendingRemote<network::mojom::URLLoaderClient> WrapClient(
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+
+  // Returns the limiter of the most recent response for |url| starting at
+  // |offset| that no download took yet, null if there is none. Download items
+  // take the one of the response they are created for, and the one of each
+  // resumption, which starts at the bytes they already received.
+  scoped_refptr<BandwidthLimiter> TakeLimiter(const GURL& url, int64_t offset);
+
+ private:
+  class ClientProxy;
+
+  struct PendingResponse {
+    GURL url;
+    int64_t offset;
+    scoped_refptr<BandwidthLimiter> limiter;
+  };
+
+  void AddResponse(const GURL& url,
+                   int64_t offset,
+                   scoped_refptr<BandwidthLimiter> limiter);
+
+  scoped_refptr<BandwidthLimiter> session_limiter_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Most recent first, only a few responses are waiting for their download
+  // item at a time.
+  std::list<PendingResponse> responses_;
+
+  base::WeakPtrFactory<DownloadThrottle> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(DownloadThrottle);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_DOWNLOAD_THROTTLE_H_
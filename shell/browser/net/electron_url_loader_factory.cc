@@ -4,11 +4,14 @@
 
 #include "shell/browser/net/electron_url_loader_factory.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "base/guid.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/binding.h"
@@ -21,6 +24,7 @@
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/buffer_list_data_source.h"
 #include "shell/browser/net/node_stream_loader.h"
 #include "shell/browser/net/url_pipe_loader.h"
 #include "shell/common/electron_constants.h"
@@ -139,10 +143,56 @@ network::mojom::URLResponseHeadPtr ToResponseHead(
   return head;
 }
 
-// Helper to write string to pipe.
+v8::Global<v8::Object>* GetFileReadStreamPrototypeReference() {
+  static base::NoDestructor<v8::Global<v8::Object>> prototype;
+  return prototype.get();
+}
+
+// Whether |object| inherits from fs.ReadStream.prototype.
+bool IsFileReadStream(v8::Isolate* isolate, v8::Local<v8::Object> object) {
+  if (GetFileReadStreamPrototypeReference()->IsEmpty())
+    return false;
+  v8::Local<v8::Object> prototype =
+      GetFileReadStreamPrototypeReference()->Get(isolate);
+  for (v8::Local<v8::Value> value = object->GetPrototype(); value->IsObject();
+       value = value.As<v8::Object>()->GetPrototype()) {
+    if (value->StrictEquals(prototype))
+      return true;
+  }
+  return false;
+}
+
+// Returns the file of |stream| when it is an fs.ReadStream of a whole file
+// that has not been read from yet.
+bool GetReadStreamPath(const gin_helper::Dictionary& stream,
+                       base::FilePath* path) {
+  if (!IsFileReadStream(stream.isolate(), stream.GetHandle()))
+    return false;
+  v8::Local<v8::Value> start;
+  if (stream.Get("start", &start) && !start->IsUndefined() &&
+      !(start->IsNumber() && start.As<v8::Number>()->Value() == 0))
+    return false;
+  double end = 0;
+  double bytes_read = -1;
+  return stream.Get("end", &end) && std::isinf(end) &&
+         stream.Get("bytesRead", &bytes_read) && bytes_read == 0 &&
+         stream.Get("path", path) && path->IsAbsolute();
+}
+
+// Ends the span of the time the JS handler of a request took to respond.
+void OnHandlerResponse(uint64_t trace_id,
+                       StartLoadingCallback callback,
+                       gin::Arguments* args) {
+  TRACE_EVENT_NESTABLE_ASYNC_END0("electron", "ProtocolHandler",
+                                  TRACE_ID_LOCAL(trace_id));
+  std::move(callback).Run(args);
+}
+
+// Helper to write data to pipe.
 struct WriteData {
   mojo::Remote<network::mojom::URLLoaderClient> client;
   std::string data;
+  uint64_t size = 0;
   std::unique_ptr<mojo::DataPipeProducer> producer;
 };
 
@@ -153,12 +203,45 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   }
 
   network::URLLoaderCompletionStatus status(net::OK);
-  status.encoded_data_length = write_data->data.size();
-  status.encoded_body_length = write_data->data.size();
-  status.decoded_body_length = write_data->data.size();
+  status.encoded_data_length = write_data->size;
+  status.encoded_body_length = write_data->size;
+  status.decoded_body_length = write_data->size;
   write_data->client->OnComplete(status);
 }
 
+// Sends the response body read from |source|, |write_data| keeps the data
+// |source| reads from alive until the write completes.
+void WriteContents(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    network::mojom::URLResponseHeadPtr head,
+    std::unique_ptr<WriteData> write_data,
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> source) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+  head->headers->AddHeader(kCORSHeader);
+  client_remote->OnReceiveResponse(std::move(head));
+
+  // Code bellow follows the pattern of data_url_loader_factory.cc.
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  client_remote->OnStartLoadingResponseBody(std::move(consumer));
+
+  write_data->client = std::move(client_remote);
+  write_data->size = source->GetLength();
+  write_data->producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+
+  mojo::DataPipeProducer* producer_ptr = write_data->producer.get();
+  producer_ptr->Write(std::move(source),
+                      base::BindOnce(OnWrite, std::move(write_data)));
+}
+
 }  // namespace
 
 ElectronURLLoaderFactory::ElectronURLLoaderFactory(
@@ -177,11 +260,19 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static uint64_t next_trace_id = 0;
+  uint64_t trace_id = next_trace_id++;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron", "ProtocolHandler",
+                                    TRACE_ID_LOCAL(trace_id), "url",
+                                    request.url.possibly_invalid_spec());
   handler_.Run(
       request,
-      base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
-                     routing_id, request_id, options, request,
-                     std::move(client), traffic_annotation, nullptr, type_));
+      base::BindOnce(
+          &OnHandlerResponse, trace_id,
+          base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
+                         std::move(loader), routing_id, request_id, options,
+                         request, std::move(client), traffic_annotation,
+                         nullptr, type_)));
 }
 
 void ElectronURLLoaderFactory::Clone(
@@ -201,6 +292,8 @@ void ElectronURLLoaderFactory::StartLoading(
     network::mojom::URLLoaderFactory* proxy_factory,
     ProtocolType type,
     gin::Arguments* args) {
+  TRACE_EVENT1("electron", "ElectronURLLoaderFactory::StartLoading", "url",
+               request.url.possibly_invalid_spec());
   // Send network error when there is no argument passed.
   //
   // Note that we should not throw JS error in the callback no matter what is
@@ -289,8 +382,8 @@ void ElectronURLLoaderFactory::StartLoading(
                        traffic_annotation, dict);
       break;
     case ProtocolType::kStream:
-      StartLoadingStream(std::move(loader), std::move(client), std::move(head),
-                         dict);
+      StartLoadingStream(std::move(loader), request, std::move(client),
+                         std::move(head), dict);
       break;
     case ProtocolType::kFree:
       ProtocolType type;
@@ -313,9 +406,24 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict) {
-  v8::Local<v8::Value> buffer = dict.GetHandle();
-  dict.Get("data", &buffer);
-  if (!node::Buffer::HasInstance(buffer)) {
+  v8::Local<v8::Value> data = dict.GetHandle();
+  dict.Get("data", &data);
+  auto source = std::make_unique<BufferListDataSource>();
+  bool valid = false;
+  if (data->IsArray()) {
+    // A list of Buffers is sent in order as one body.
+    v8::Isolate* isolate = dict.isolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> chunks = data.As<v8::Array>();
+    valid = true;
+    for (uint32_t i = 0; valid && i < chunks->Length(); ++i) {
+      v8::Local<v8::Value> chunk;
+      valid = chunks->Get(context, i).ToLocal(&chunk) && source->Append(chunk);
+    }
+  } else {
+    valid = source->Append(data);
+  }
+  if (!valid) {
     mojo::Remote<network::mojom::URLLoaderClient> client_remote(
         std::move(client));
     client_remote->OnComplete(
@@ -323,9 +431,8 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     return;
   }
 
-  SendContents(
-      std::move(client), std::move(head),
-      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
+  WriteContents(std::move(client), std::move(head),
+                std::make_unique<WriteData>(), std::move(source));
 }
 
 // static
@@ -427,6 +534,7 @@ void ElectronURLLoaderFactory::StartLoadingHttp(
 // static
 void ElectronURLLoaderFactory::StartLoadingStream(
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    network::ResourceRequest request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict) {
@@ -473,43 +581,42 @@ void ElectronURLLoaderFactory::StartLoadingStream(
     return;
   }
 
+  // An untouched fs.ReadStream is served by the file loader, which reads the
+  // file on the thread pool and also handles range requests. The stream still
+  // runs to its end, so its events are emitted and it closes its file.
+  base::FilePath path;
+  if (GetReadStreamPath(data, &path)) {
+    node::MakeCallback(data.isolate(), data.GetHandle(), "resume", 0, nullptr,
+                       {0, 0});
+    request.url = net::FilePathToFileURL(path);
+    asar::CreateAsarURLLoader(request, std::move(loader), std::move(client),
+                              head->headers);
+    return;
+  }
+
   new NodeStreamLoader(std::move(head), std::move(loader), std::move(client),
                        data.isolate(), data.GetHandle());
 }
 
+// static
+void ElectronURLLoaderFactory::SetFileReadStreamPrototype(
+    v8::Isolate* isolate,
+    v8::Local<v8::Object> prototype) {
+  GetFileReadStreamPrototypeReference()->Reset(isolate, prototype);
+}
+
 // static
 void ElectronURLLoaderFactory::SendContents(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     std::string data) {
-  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
-      std::move(client));
-  head->headers->AddHeader(kCORSHeader);
-  client_remote->OnReceiveResponse(std::move(head));
-
-  // Code bellow follows the pattern of data_url_loader_factory.cc.
-  mojo::ScopedDataPipeProducerHandle producer;
-  mojo::ScopedDataPipeConsumerHandle consumer;
-  if (mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
-    client_remote->OnComplete(
-        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
-    return;
-  }
-
-  client_remote->OnStartLoadingResponseBody(std::move(consumer));
-
   auto write_data = std::make_unique<WriteData>();
-  write_data->client = std::move(client_remote);
   write_data->data = std::move(data);
-  write_data->producer =
-      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-
   base::StringPiece string_piece(write_data->data);
-  write_data->producer->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-      base::BindOnce(OnWrite, std::move(write_data)));
+  WriteContents(std::move(client), std::move(head), std::move(write_data),
+                std::make_unique<mojo::StringDataSource>(
+                    string_piece, mojo::StringDataSource::AsyncWritingMode::
+                                      STRING_STAYS_VALID_UNTIL_COMPLETION));
 }
 
 }  // namespace electron
@@ -69,6 +69,11 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
       ProtocolType type,
       gin::Arguments* args);
 
+  // Sets fs.ReadStream.prototype, which identifies the streams whose file can
+  // be sent without reading it in JavaScript.
+  static void SetFileReadStreamPrototype(v8::Isolate* isolate,
+                                         v8::Local<v8::Object> prototype);
+
  private:
   static void StartLoadingBuffer(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
@@ -96,6 +101,7 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
       const gin_helper::Dictionary& dict);
   static void StartLoadingStream(
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      network::ResourceRequest request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict);
@@ -44,20 +44,21 @@ NetworkContextService::CreateNetworkContextParams(bool in_memory,
       net::HttpUtil::GenerateAcceptLanguageHeader(
           ElectronBrowserClient::Get()->GetApplicationLocale());
 
-  // Enable the HTTP cache.
+  // Enable the HTTP cache. Without a path, in-memory sessions get a memory
+  // cache, which evicts the least recently used entries past its size.
   network_context_params->http_cache_enabled =
       browser_context_->CanUseHttpCache();
+  network_context_params->http_cache_max_size =
+      browser_context_->GetMaxCacheSize();
 
   network_context_params->cookie_manager_params =
       network::mojom::CookieManagerParams::New();
 
   // Configure on-disk storage for persistent sessions.
   if (!in_memory) {
-    // Configure the HTTP cache path and size.
+    // Configure the HTTP cache path.
     network_context_params->http_cache_path =
         path.Append(chrome::kCacheDirname);
-    network_context_params->http_cache_max_size =
-        browser_context_->GetMaxCacheSize();
 
     // Currently this just contains HttpServerProperties
     network_context_params->http_server_properties_path =
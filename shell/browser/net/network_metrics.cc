@@ -0,0 +1,83 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/network_metrics.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+#include "net/base/host_port_pair.h"
+
+namespace electron {
+
+namespace {
+
+void AddInterval(NetworkMetrics::Histogram* histogram,
+                 base::TimeTicks start,
+                 base::TimeTicks end) {
+  if (!start.is_null() && !end.is_null() && end >= start)
+    histogram->Add(end - start);
+}
+
+}  // namespace
+
+NetworkMetrics::Histogram::Histogram()
+    : buckets_(GetBucketBoundaries().size() + 1) {}
+NetworkMetrics::Histogram::Histogram(const Histogram&) = default;
+NetworkMetrics::Histogram::~Histogram() = default;
+
+void NetworkMetrics::Histogram::Add(base::TimeDelta duration) {
+  const std::vector<int>& boundaries = GetBucketBoundaries();
+  auto it = std::lower_bound(boundaries.begin(), boundaries.end(),
+                             duration.InMillisecondsRoundedUp());
+  ++buckets_[it - boundaries.begin()];
+  ++count_;
+  total_ += duration;
+}
+
+NetworkMetrics::HostMetrics::HostMetrics() = default;
+NetworkMetrics::HostMetrics::HostMetrics(const HostMetrics&) = default;
+NetworkMetrics::HostMetrics::~HostMetrics() = default;
+
+// static
+const std::vector<int>& NetworkMetrics::GetBucketBoundaries() {
+  static base::NoDestructor<std::vector<int>> boundaries(
+      {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000});
+  return *boundaries;
+}
+
+NetworkMetrics::NetworkMetrics() = default;
+
+NetworkMetrics::~NetworkMetrics() = default;
+
+void NetworkMetrics::RecordLoad(const GURL& url,
+                                const net::LoadTimingInfo& timing,
+                                bool was_cached) {
+  if (!url.SchemeIsHTTPOrHTTPS() && !url.SchemeIsWSOrWSS())
+    return;
+
+  HostMetrics& host = hosts_[net::HostPortPair::FromURL(url).ToString()];
+  ++host.requests;
+  if (was_cached) {
+    ++host.cached_requests;
+    return;
+  }
+
+  if (timing.socket_reused) {
+    ++host.reused_sockets;
+  } else {
+    ++host.new_sockets;
+    const net::LoadTimingInfo::ConnectTiming& connect = timing.connect_timing;
+    AddInterval(&host.dns, connect.dns_start, connect.dns_end);
+    AddInterval(&host.connect, connect.connect_start, connect.connect_end);
+    AddInterval(&host.tls, connect.ssl_start, connect.ssl_end);
+  }
+  AddInterval(&host.ttfb, timing.send_start, timing.receive_headers_end);
+}
+
+void NetworkMetrics::Clear() {
+  hosts_.clear();
+}
+
+}  // namespace electron
@@ -0,0 +1,85 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_NETWORK_METRICS_H_
+#define SHELL_BROWSER_NET_NETWORK_METRICS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "net/base/load_timing_info.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Aggregates the load timing of the network requests of a session per host,
+// for tuning preconnects and proxy settings.
+class NetworkMetrics {
+ public:
+  // Counts durations in buckets, bucket i holds the durations up to
+  // GetBucketBoundaries()[i] and the last bucket the longer ones.
+  class Histogram {
+   public:
+    Histogram();
+    Histogram(const Histogram&);
+    ~Histogram();
+
+    void Add(base::TimeDelta duration);
+
+    int count() const { return count_; }
+    base::TimeDelta total() const { return total_; }
+    const std::vector<int>& buckets() const { return buckets_; }
+
+   private:
+    int count_ = 0;
+    base::TimeDelta total_;
+    std::vector<int> buckets_;
+  };
+
+  struct HostMetrics {
+    HostMetrics();
+    HostMetrics(const HostMetrics&);
+    ~HostMetrics();
+
+    int requests = 0;
+    // Requests served from the HTTP cache, which have no timing.
+    int cached_requests = 0;
+    // Requests sent over a socket opened for them, or over a reused one.
+    int new_sockets = 0;
+    int reused_sockets = 0;
+    Histogram dns;
+    Histogram connect;
+    Histogram tls;
+    // From sending the request to receiving the response headers.
+    Histogram ttfb;
+  };
+
+  // host:port => metrics.
+  using HostMetricsMap = std::map<std::string, HostMetrics>;
+
+  // In milliseconds.
+  static const std::vector<int>& GetBucketBoundaries();
+
+  NetworkMetrics();
+  ~NetworkMetrics();
+
+  void RecordLoad(const GURL& url,
+                  const net::LoadTimingInfo& timing,
+                  bool was_cached);
+  void Clear();
+
+  const HostMetricsMap& hosts() const { return hosts_; }
+
+ private:
+  HostMetricsMap hosts_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetworkMetrics);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_NETWORK_METRICS_H_
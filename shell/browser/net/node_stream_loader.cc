@@ -4,14 +4,37 @@
 
 #include "shell/browser/net/node_stream_loader.h"
 
+#include <algorithm>
 #include <utility>
 
-#include "mojo/public/cpp/system/string_data_source.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/node_includes.h"
 
 namespace electron {
 
+namespace {
+
+// The capacity of the data pipe is picked from the Content-Length of the
+// response, a pipe that holds the whole body lets the stream be drained
+// without waiting for the renderer.
+constexpr uint32_t kMinPipeSize = 64 * 1024;
+constexpr uint32_t kMaxPipeSize = 2 * 1024 * 1024;
+constexpr uint32_t kDefaultPipeSize = 512 * 1024;
+
+// Reading ahead stops once this much data is waiting to be written.
+constexpr uint64_t kMaxPendingSize = 1024 * 1024;
+
+uint32_t GetPipeSize(const network::mojom::URLResponseHead& head) {
+  int64_t content_length = head.headers ? head.headers->GetContentLength() : -1;
+  if (content_length < 0)
+    return kDefaultPipeSize;
+  return static_cast<uint32_t>(
+      std::max<int64_t>(kMinPipeSize, std::min<int64_t>(content_length,
+                                                        kMaxPipeSize)));
+}
+
+}  // namespace
+
 NodeStreamLoader::NodeStreamLoader(
     network::mojom::URLResponseHeadPtr head,
     network::mojom::URLLoaderRequest loader,
@@ -22,6 +45,7 @@ NodeStreamLoader::NodeStreamLoader(
       client_(std::move(client)),
       isolate_(isolate),
       emitter_(isolate, emitter),
+      pending_(std::make_unique<BufferListDataSource>()),
       weak_factory_(this) {
   binding_.set_connection_error_handler(
       base::BindOnce(&NodeStreamLoader::NotifyComplete,
@@ -45,9 +69,14 @@ NodeStreamLoader::~NodeStreamLoader() {
 }
 
 void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = GetPipeSize(*head);
   mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, &producer, &consumer);
+  MojoResult rv = mojo::CreateDataPipe(&options, &producer, &consumer);
   if (rv != MOJO_RESULT_OK) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
@@ -66,9 +95,8 @@ void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
 }
 
 void NodeStreamLoader::NotifyReadable() {
-  if (!readable_)
-    ReadMore();
   readable_ = true;
+  ReadMore();
 }
 
 void NodeStreamLoader::NotifyComplete(int result) {
@@ -93,48 +121,54 @@ void NodeStreamLoader::ReadMore() {
   is_reading_ = true;
   auto weak = weak_factory_.GetWeakPtr();
   v8::HandleScope scope(isolate_);
-  // buffer = emitter.read()
-  v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
-      isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
-  DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
-
-  // If there is no buffer read, wait until |readable| is emitted again.
-  v8::Local<v8::Value> buffer;
-  if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
-    readable_ = false;
-    is_reading_ = false;
-    if (ended_) {
+  while (readable_ && !ended_ && pending_->GetLength() < kMaxPendingSize) {
+    // buffer = emitter.read()
+    v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
+        isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
+    DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
+
+    // If there is no buffer read, wait until |readable| is emitted again.
+    v8::Local<v8::Value> buffer;
+    if (!ret.ToLocal(&buffer) || !pending_->Append(buffer))
+      readable_ = false;
+  }
+  is_reading_ = false;
+
+  // Otherwise the chunks are written when the current write is done.
+  if (!is_writing_)
+    Flush();
+}
+
+void NodeStreamLoader::Flush() {
+  // The chunks read before a failure are dropped.
+  if (pending_->empty() || (ended_ && result_ != net::OK)) {
+    if (ended_)
       NotifyComplete(result_);
-    }
     return;
   }
 
-  // Hold the buffer until the write is done.
-  buffer_.Reset(isolate_, buffer);
-
-  // Write buffer to mojo pipe asyncronously.
-  is_reading_ = false;
+  // Write buffers to mojo pipe asyncronously.
   is_writing_ = true;
-  producer_->Write(std::make_unique<mojo::StringDataSource>(
-                       base::StringPiece(node::Buffer::Data(buffer),
-                                         node::Buffer::Length(buffer)),
-                       mojo::StringDataSource::AsyncWritingMode::
-                           STRING_STAYS_VALID_UNTIL_COMPLETION),
-                   base::BindOnce(&NodeStreamLoader::DidWrite, weak));
+  producer_->Write(std::move(pending_),
+                   base::BindOnce(&NodeStreamLoader::DidWrite,
+                                  weak_factory_.GetWeakPtr()));
+  pending_ = std::make_unique<BufferListDataSource>();
+
+  // Read the next chunks while these are being written.
+  if (readable_)
+    ReadMore();
 }
 
 void NodeStreamLoader::DidWrite(MojoResult result) {
   is_writing_ = false;
-  // We were told to end streaming.
-  if (ended_) {
-    NotifyComplete(result_);
+  if (result != MOJO_RESULT_OK) {
+    NotifyComplete(net::ERR_FAILED);
     return;
   }
 
-  if (result == MOJO_RESULT_OK && readable_)
-    ReadMore();
-  else
-    NotifyComplete(net::ERR_FAILED);
+  // Tops up the chunks read during the write and writes them, or completes
+  // the request when the stream has ended.
+  ReadMore();
 }
 
 void NodeStreamLoader::On(const char* event, EventCallback callback) {
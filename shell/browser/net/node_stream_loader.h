@@ -16,6 +16,7 @@
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/buffer_list_data_source.h"
 #include "v8/include/v8.h"
 
 namespace electron {
@@ -28,6 +29,10 @@ namespace electron {
 // We use |paused mode| to read data from |Readable| stream, so we don't need to
 // copy data from buffer and hold it in memory, and we only need to make sure
 // the passed |Buffer| is alive while writing data to pipe.
+//
+// While a write is in progress the loader keeps reading ahead, and the chunks
+// read meanwhile are written together by the next write, so small chunks do
+// not each cost a round trip through the pipe.
 class NodeStreamLoader : public network::mojom::URLLoader {
  public:
   NodeStreamLoader(network::mojom::URLResponseHeadPtr head,
@@ -45,6 +50,8 @@ class NodeStreamLoader : public network::mojom::URLLoader {
   void NotifyReadable();
   void NotifyComplete(int result);
   void ReadMore();
+  // Writes the chunks read since the last write.
+  void Flush();
   void DidWrite(MojoResult result);
 
   // Subscribe to events of |emitter|.
@@ -64,11 +71,13 @@ class NodeStreamLoader : public network::mojom::URLLoader {
 
   v8::Isolate* isolate_;
   v8::Global<v8::Object> emitter_;
-  v8::Global<v8::Value> buffer_;
 
   // Mojo data pipe where the data that is being read is written to.
   std::unique_ptr<mojo::DataPipeProducer> producer_;
 
+  // The chunks read while the previous ones were being written.
+  std::unique_ptr<BufferListDataSource> pending_;
+
   // Whether we are in the middle of write.
   bool is_writing_ = false;
 
@@ -0,0 +1,242 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/preconnect_predictor.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+#include "base/values.h"
+#include "chrome/browser/predictors/preconnect_manager.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "net/base/network_isolation_key.h"
+#include "shell/browser/electron_browser_context.h"
+#include "url/origin.h"
+
+namespace electron {
+
+namespace {
+
+// The persisted PreconnectPredictor::pages_.
+const char kPreconnectPredictorPages[] = "preconnect_predictor.pages";
+
+const char kLastVisitKey[] = "last_visit";
+const char kOriginsKey[] = "origins";
+
+// The scores are moving averages of whether the loads of a page contacted an
+// origin, the origins start at 1 when they are first contacted.
+constexpr double kScoreWeight = 0.3;
+
+// Origins scoring at least this get a connection, the ones below only get
+// their host resolved, and the ones below |kMinScore| are forgotten.
+constexpr double kPreconnectScore = 0.5;
+constexpr double kMinScore = 0.1;
+
+constexpr size_t kMaxPages = 64;
+constexpr size_t kMaxOriginsPerPage = 16;
+
+// Set by the power policy of the app, for all sessions.
+bool g_deferred = false;
+
+// Returns the key of the page at |url|, or an empty string when its loads
+// are not learned.
+std::string GetPageKey(const GURL& url) {
+  GURL origin = url.GetOrigin();
+  return origin.is_valid() ? origin.spec() : std::string();
+}
+
+double GetScore(const base::Value& value) {
+  return value.is_double() || value.is_int() ? value.GetDouble() : 0;
+}
+
+void EvictOldestPage(base::Value* pages) {
+  std::string oldest_key;
+  double oldest_visit = 0;
+  for (const auto& item : pages->DictItems()) {
+    double visit = item.second.FindDoubleKey(kLastVisitKey).value_or(0);
+    if (oldest_key.empty() || visit < oldest_visit) {
+      oldest_key = item.first;
+      oldest_visit = visit;
+    }
+  }
+  pages->RemoveKey(oldest_key);
+}
+
+}  // namespace
+
+PreconnectPredictor::PageLoad::PageLoad() = default;
+PreconnectPredictor::PageLoad::PageLoad(const PageLoad&) = default;
+PreconnectPredictor::PageLoad::~PageLoad() = default;
+
+// static
+void PreconnectPredictor::RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterDictionaryPref(kPreconnectPredictorPages);
+}
+
+// static
+void PreconnectPredictor::SetDeferred(bool deferred) {
+  g_deferred = deferred;
+}
+
+PreconnectPredictor::PreconnectPredictor(
+    ElectronBrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+PreconnectPredictor::~PreconnectPredictor() = default;
+
+void PreconnectPredictor::InitPersistence(bool persistent) {
+  persistent_ = persistent;
+  PrefService* prefs = browser_context_->prefs();
+  if (persistent)
+    pages_ = prefs->GetDictionary(kPreconnectPredictorPages)->Clone();
+  else
+    prefs->ClearPref(kPreconnectPredictorPages);
+}
+
+void PreconnectPredictor::OnNavigationStarted(
+    content::WebContents* web_contents,
+    const GURL& url) {
+  OnWebContentsDestroyed(web_contents);
+
+  std::string key = GetPageKey(url);
+  if (key.empty())
+    return;
+  PageLoad& page_load = page_loads_[web_contents];
+  page_load.url = url;
+  page_load.key = key;
+  if (!g_deferred)
+    Preconnect(url, key);
+}
+
+void PreconnectPredictor::OnOriginContacted(
+    content::WebContents* web_contents,
+    const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return;
+  auto it = page_loads_.find(web_contents);
+  if (it == page_loads_.end())
+    return;
+  // The navigation itself connects to the origin of the page.
+  std::string origin = url.GetOrigin().spec();
+  if (origin != it->second.key)
+    it->second.origins.insert(origin);
+}
+
+void PreconnectPredictor::OnWebContentsDestroyed(
+    content::WebContents* web_contents) {
+  auto it = page_loads_.find(web_contents);
+  if (it == page_loads_.end())
+    return;
+  Learn(it->second);
+  page_loads_.erase(it);
+}
+
+void PreconnectPredictor::Clear() {
+  pages_ = base::Value(base::Value::Type::DICTIONARY);
+  browser_context_->prefs()->ClearPref(kPreconnectPredictorPages);
+  for (auto& it : page_loads_)
+    it.second.origins.clear();
+}
+
+void PreconnectPredictor::ClearOrigins(const std::vector<GURL>& origins) {
+  std::set<std::string> keys;
+  for (const GURL& origin : origins) {
+    std::string key = GetPageKey(origin);
+    if (!key.empty())
+      keys.insert(key);
+  }
+  if (keys.empty())
+    return;
+
+  for (const std::string& key : keys)
+    pages_.RemoveKey(key);
+  for (auto item : pages_.DictItems()) {
+    base::Value* learned = item.second.FindDictKey(kOriginsKey);
+    if (!learned)
+      continue;
+    for (const std::string& key : keys)
+      learned->RemoveKey(key);
+  }
+  Save();
+
+  for (auto& it : page_loads_) {
+    if (keys.count(it.second.key)) {
+      it.second.origins.clear();
+      continue;
+    }
+    for (const std::string& key : keys)
+      it.second.origins.erase(key);
+  }
+}
+
+void PreconnectPredictor::Save() {
+  if (persistent_)
+    browser_context_->prefs()->Set(kPreconnectPredictorPages, pages_);
+}
+
+void PreconnectPredictor::Learn(const PageLoad& page_load) {
+  base::Value* pages = &pages_;
+  base::Value* page = pages->FindDictKey(page_load.key);
+  if (!page) {
+    if (page_load.origins.empty())
+      return;
+    if (pages->DictSize() >= kMaxPages)
+      EvictOldestPage(pages);
+    page = pages->SetKey(page_load.key,
+                         base::Value(base::Value::Type::DICTIONARY));
+  }
+  page->SetDoubleKey(kLastVisitKey, base::Time::Now().ToDoubleT());
+
+  base::Value* origins = page->FindDictKey(kOriginsKey);
+  if (!origins) {
+    origins = page->SetKey(kOriginsKey,
+                           base::Value(base::Value::Type::DICTIONARY));
+  }
+
+  std::vector<std::pair<double, std::string>> scores;
+  for (const auto& item : origins->DictItems()) {
+    double score = GetScore(item.second) * (1 - kScoreWeight);
+    if (page_load.origins.count(item.first))
+      score += kScoreWeight;
+    scores.emplace_back(score, item.first);
+  }
+  for (const std::string& origin : page_load.origins) {
+    if (!origins->FindKey(origin))
+      scores.emplace_back(1, origin);
+  }
+
+  std::sort(scores.begin(), scores.end(), std::greater<>());
+  base::Value learned(base::Value::Type::DICTIONARY);
+  for (const auto& score : scores) {
+    if (score.first < kMinScore || learned.DictSize() >= kMaxOriginsPerPage)
+      break;
+    learned.SetDoubleKey(score.second, score.first);
+  }
+  page->SetKey(kOriginsKey, std::move(learned));
+  Save();
+}
+
+void PreconnectPredictor::Preconnect(const GURL& url, const std::string& key) {
+  const base::Value* page = pages_.FindDictKey(key);
+  const base::Value* origins = page ? page->FindDictKey(kOriginsKey) : nullptr;
+  if (!origins)
+    return;
+
+  std::vector<predictors::PreconnectRequest> requests;
+  for (const auto& item : origins->DictItems()) {
+    double score = GetScore(item.second);
+    requests.emplace_back(url::Origin::Create(GURL(item.first)),
+                          score >= kPreconnectScore ? 1 : 0,
+                          net::NetworkIsolationKey());
+  }
+  if (!requests.empty())
+    browser_context_->GetPreconnectManager()->Start(url, std::move(requests));
+}
+
+}  // namespace electron
@@ -0,0 +1,90 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
+#define SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+class PrefRegistrySimple;
+
+namespace content {
+class WebContents;
+}
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Learns which origins the pages of a session contact, and preconnects to
+// them as soon as a navigation to the same page origin starts. When the
+// session opts in, what it learns is kept in the session preferences, so the
+// first pages loaded after a restart start with warm connections.
+class PreconnectPredictor {
+ public:
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
+  // While deferred, the predictors of all sessions keep learning but do not
+  // connect ahead of the pages, to save power.
+  static void SetDeferred(bool deferred);
+
+  explicit PreconnectPredictor(ElectronBrowserContext* browser_context);
+  ~PreconnectPredictor();
+
+  // Called once the preferences of the session are loaded. Without
+  // |persistent|, what was learned by earlier runs is removed from them.
+  void InitPersistence(bool persistent);
+
+  // Called by the WebContents of the session when a main frame navigation to
+  // |url| starts, when they load a resource from |url| or are hinted to
+  // preconnect to it, and when they are destroyed.
+  void OnNavigationStarted(content::WebContents* web_contents, const GURL& url);
+  void OnOriginContacted(content::WebContents* web_contents, const GURL& url);
+  void OnWebContentsDestroyed(content::WebContents* web_contents);
+
+  // Forgets everything learned so far.
+  void Clear();
+  // Forgets the pages of |origins| and the connections to them.
+  void ClearOrigins(const std::vector<GURL>& origins);
+
+ private:
+  struct PageLoad {
+    PageLoad();
+    PageLoad(const PageLoad&);
+    ~PageLoad();
+
+    GURL url;
+    std::string key;
+    std::set<std::string> origins;
+  };
+
+  // Updates the learned origins of a page with the ones its load contacted.
+  void Learn(const PageLoad& page_load);
+  void Preconnect(const GURL& url, const std::string& key);
+  // Writes |pages_| to the preferences when they are persistent.
+  void Save();
+
+  ElectronBrowserContext* browser_context_;
+  bool persistent_ = false;
+
+  // Page origins => the time they were last visited and the scores of the
+  // origins they contact.
+  base::Value pages_{base::Value::Type::DICTIONARY};
+
+  // The loads in progress, from their navigation to the next one.
+  std::map<content::WebContents*, PageLoad> page_loads_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreconnectPredictor);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
@@ -16,7 +16,10 @@
 #include "net/base/load_flags.h"
 #include "net/http/http_util.h"
 #include "services/network/public/cpp/features.h"
+#include "shell/browser/electron_browser_context.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/download_throttle.h"
+#include "shell/browser/net/shared_asset_cache.h"
 #include "shell/common/options_switches.h"
 
 namespace electron {
@@ -749,6 +752,156 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnRequestError(
   factory_->RemoveRequest(network_service_request_id_, request_id_);
 }
 
+ProxyingURLLoaderFactory::BypassedRequest::BypassedRequest(
+    ProxyingURLLoaderFactory* factory,
+    int32_t routing_id,
+    int32_t network_service_request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client)
+    : factory_(factory),
+      request_(request),
+      routing_id_(routing_id),
+      network_service_request_id_(network_service_request_id),
+      options_(options),
+      traffic_annotation_(traffic_annotation),
+      proxied_loader_receiver_(this, std::move(loader_receiver)),
+      target_client_(std::move(client)) {
+  // If there is a client error, clean up the request.
+  target_client_.set_disconnect_handler(base::BindOnce(
+      &ProxyingURLLoaderFactory::BypassedRequest::Finish,
+      base::Unretained(this)));
+  proxied_loader_receiver_.set_disconnect_handler(base::BindOnce(
+      &ProxyingURLLoaderFactory::BypassedRequest::Finish,
+      base::Unretained(this)));
+}
+
+ProxyingURLLoaderFactory::BypassedRequest::~BypassedRequest() = default;
+
+void ProxyingURLLoaderFactory::BypassedRequest::BindTarget(
+    mojo::PendingReceiver<network::mojom::URLLoader>* target_loader,
+    mojo::PendingRemote<network::mojom::URLLoaderClient>* target_client) {
+  *target_loader = target_loader_.BindNewPipeAndPassReceiver();
+  *target_client = proxied_client_receiver_.BindNewPipeAndPassRemote();
+  proxied_client_receiver_.set_disconnect_handler(base::BindOnce(
+      &ProxyingURLLoaderFactory::BypassedRequest::OnTargetDisconnected,
+      base::Unretained(this)));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::FollowRedirect(
+    const std::vector<std::string>& removed_headers,
+    const net::HttpRequestHeaders& modified_headers,
+    const base::Optional<GURL>& new_url) {
+  if (!hand_over_on_redirect_) {
+    if (target_loader_)
+      target_loader_->FollowRedirect(removed_headers, modified_headers,
+                                     new_url);
+    return;
+  }
+
+  if (new_url)
+    request_.url = new_url.value();
+  for (const std::string& header : removed_headers)
+    request_.headers.RemoveHeader(header);
+  request_.headers.MergeFrom(modified_headers);
+
+  // Restart the request from the new URL, where webRequest sees it.
+  target_loader_.reset();
+  proxied_client_receiver_.reset();
+  factory_->StartRequest(proxied_loader_receiver_.Unbind(), routing_id_,
+                         network_service_request_id_, options_, request_,
+                         target_client_.Unbind(), traffic_annotation_);
+  // Deletes |this|.
+  factory_->RemoveBypassedRequest(this);
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::SetPriority(
+    net::RequestPriority priority,
+    int32_t intra_priority_value) {
+  if (target_loader_)
+    target_loader_->SetPriority(priority, intra_priority_value);
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::PauseReadingBodyFromNet() {
+  if (target_loader_)
+    target_loader_->PauseReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::ResumeReadingBodyFromNet() {
+  if (target_loader_)
+    target_loader_->ResumeReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnReceiveResponse(
+    network::mojom::URLResponseHeadPtr head) {
+  target_client_->OnReceiveResponse(std::move(head));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnReceiveRedirect(
+    const net::RedirectInfo& redirect_info,
+    network::mojom::URLResponseHeadPtr head) {
+  // Only the schemes the network service can follow redirects to are handed
+  // over.
+  hand_over_on_redirect_ =
+      redirect_info.new_url.SchemeIsHTTPOrHTTPS() &&
+      factory_->web_request_api()->HasListenerForURL(redirect_info.new_url);
+  request_.url = redirect_info.new_url;
+  request_.method = redirect_info.new_method;
+  request_.site_for_cookies = redirect_info.new_site_for_cookies;
+  request_.referrer = GURL(redirect_info.new_referrer);
+  request_.referrer_policy = redirect_info.new_referrer_policy;
+
+  // The request method can be changed to "GET". In this case we need to
+  // reset the request body manually.
+  if (request_.method == net::HttpRequestHeaders::kGetMethod)
+    request_.request_body = nullptr;
+
+  target_client_->OnReceiveRedirect(redirect_info, std::move(head));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnUploadProgress(
+    int64_t current_position,
+    int64_t total_size,
+    OnUploadProgressCallback callback) {
+  target_client_->OnUploadProgress(current_position, total_size,
+                                   std::move(callback));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnReceiveCachedMetadata(
+    mojo_base::BigBuffer data) {
+  target_client_->OnReceiveCachedMetadata(std::move(data));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnTransferSizeUpdated(
+    int32_t transfer_size_diff) {
+  target_client_->OnTransferSizeUpdated(transfer_size_diff);
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnStartLoadingResponseBody(
+    mojo::ScopedDataPipeConsumerHandle body) {
+  target_client_->OnStartLoadingResponseBody(std::move(body));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnComplete(
+    const network::URLLoaderCompletionStatus& status) {
+  target_client_->OnComplete(status);
+  Finish();
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::OnTargetDisconnected() {
+  // Waiting for FollowRedirect.
+  if (hand_over_on_redirect_)
+    return;
+  OnComplete(network::URLLoaderCompletionStatus(net::ERR_ABORTED));
+}
+
+void ProxyingURLLoaderFactory::BypassedRequest::Finish() {
+  // Deletes |this|.
+  factory_->RemoveBypassedRequest(this);
+}
+
 ProxyingURLLoaderFactory::ProxyingURLLoaderFactory(
     WebRequestAPI* web_request_api,
     const HandlersMap& intercepted_handlers,
@@ -813,6 +966,26 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     request.load_flags |= net::LOAD_IGNORE_LIMITS;
   }
 
+  // Downloads get their body through the bandwidth limits of the session.
+  if (loader_factory_type_ ==
+      content::ContentBrowserClient::URLLoaderFactoryType::kDownload) {
+    client = static_cast<ElectronBrowserContext*>(browser_context_)
+                 ->download_throttle()
+                 ->WrapClient(request, std::move(client));
+  }
+
+  StartRequest(std::move(loader), routing_id, request_id, options, request,
+               std::move(client), traffic_annotation);
+}
+
+void ProxyingURLLoaderFactory::StartRequest(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   // Check if user has intercepted this scheme.
   auto it = intercepted_handlers_.find(request.url.scheme());
   if (it != intercepted_handlers_.end()) {
@@ -832,11 +1005,38 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
-  if (!web_request_api()->HasListener()) {
+  if (!web_request_api()->HasListenerForURL(request.url)) {
+    // The request still goes through a BypassedRequest, which checks its
+    // redirects.
+    auto bypassed_request = std::make_unique<BypassedRequest>(
+        this, routing_id, request_id, options, request, traffic_annotation,
+        std::move(loader), std::move(client));
+    mojo::PendingReceiver<network::mojom::URLLoader> target_loader;
+    mojo::PendingRemote<network::mojom::URLLoaderClient> target_client;
+    bypassed_request->BindTarget(&target_loader, &target_client);
+    bypassed_requests_.insert(std::move(bypassed_request));
+
+    auto* electron_browser_context =
+        static_cast<ElectronBrowserContext*>(browser_context_);
+    if (SharedAssetCache::CanHandleRequest(request) &&
+        electron_browser_context->shared_cache_urls().MatchesURL(
+            request.url)) {
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory;
+      target_factory_->Clone(target_factory.InitWithNewPipeAndPassReceiver());
+      // In-memory sessions are served from the store but add nothing to it,
+      // so what they load is never written to disk.
+      SharedAssetCache::Get()->CreateLoaderAndStart(
+          !electron_browser_context->IsOffTheRecord(),
+          std::move(target_factory), std::move(target_loader), routing_id,
+          request_id, options, request, std::move(target_client),
+          traffic_annotation);
+      return;
+    }
+
     // Pass-through to the original factory.
     target_factory_->CreateLoaderAndStart(
-        std::move(loader), routing_id, request_id, options, request,
-        std::move(client), traffic_annotation);
+        std::move(target_loader), routing_id, request_id, options, request,
+        std::move(target_client), traffic_annotation);
     return;
   }
 
@@ -905,10 +1105,20 @@ void ProxyingURLLoaderFactory::RemoveRequest(int32_t network_service_request_id,
   MaybeDeleteThis();
 }
 
+void ProxyingURLLoaderFactory::RemoveBypassedRequest(
+    BypassedRequest* request) {
+  auto it = bypassed_requests_.find(request);
+  DCHECK(it != bypassed_requests_.end());
+  bypassed_requests_.erase(it);
+
+  MaybeDeleteThis();
+}
+
 void ProxyingURLLoaderFactory::MaybeDeleteThis() {
   // Even if all URLLoaderFactory pipes connected to this object have been
   // closed it has to stay alive until all active requests have completed.
-  if (target_factory_.is_bound() || !requests_.empty())
+  if (target_factory_.is_bound() || !requests_.empty() ||
+      !bypassed_requests_.empty())
     return;
 
   delete this;
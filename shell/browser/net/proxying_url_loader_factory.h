@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/unique_ptr_adapters.h"
 #include "base/optional.h"
 #include "content/public/browser/content_browser_client.h"
 #include "extensions/browser/api/web_request/web_request_info.h"
@@ -169,6 +170,73 @@ class ProxyingURLLoaderFactory
     DISALLOW_COPY_AND_ASSIGN(InProgressRequest);
   };
 
+  // Passes a request that no webRequest listener matches to the target
+  // factory, and hands it over to an InProgressRequest when it is redirected
+  // to a URL that a listener or a rule matches.
+  class BypassedRequest : public network::mojom::URLLoader,
+                          public network::mojom::URLLoaderClient {
+   public:
+    BypassedRequest(
+        ProxyingURLLoaderFactory* factory,
+        int32_t routing_id,
+        int32_t network_service_request_id,
+        uint32_t options,
+        const network::ResourceRequest& request,
+        const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+        mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+        mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+    ~BypassedRequest() override;
+
+    // Creates the pipes to start the request with in the target factory.
+    void BindTarget(
+        mojo::PendingReceiver<network::mojom::URLLoader>* target_loader,
+        mojo::PendingRemote<network::mojom::URLLoaderClient>* target_client);
+
+    // network::mojom::URLLoader:
+    void FollowRedirect(const std::vector<std::string>& removed_headers,
+                        const net::HttpRequestHeaders& modified_headers,
+                        const base::Optional<GURL>& new_url) override;
+    void SetPriority(net::RequestPriority priority,
+                     int32_t intra_priority_value) override;
+    void PauseReadingBodyFromNet() override;
+    void ResumeReadingBodyFromNet() override;
+
+    // network::mojom::URLLoaderClient:
+    void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override;
+    void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                           network::mojom::URLResponseHeadPtr head) override;
+    void OnUploadProgress(int64_t current_position,
+                          int64_t total_size,
+                          OnUploadProgressCallback callback) override;
+    void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override;
+    void OnTransferSizeUpdated(int32_t transfer_size_diff) override;
+    void OnStartLoadingResponseBody(
+        mojo::ScopedDataPipeConsumerHandle body) override;
+    void OnComplete(const network::URLLoaderCompletionStatus& status) override;
+
+   private:
+    void OnTargetDisconnected();
+    void Finish();
+
+    ProxyingURLLoaderFactory* factory_;
+    network::ResourceRequest request_;
+    const int32_t routing_id_ = 0;
+    const int32_t network_service_request_id_ = 0;
+    const uint32_t options_ = 0;
+    const net::MutableNetworkTrafficAnnotationTag traffic_annotation_;
+    mojo::Receiver<network::mojom::URLLoader> proxied_loader_receiver_;
+    mojo::Remote<network::mojom::URLLoaderClient> target_client_;
+
+    mojo::Remote<network::mojom::URLLoader> target_loader_;
+    mojo::Receiver<network::mojom::URLLoaderClient> proxied_client_receiver_{
+        this};
+
+    // Set when the pending redirect goes to a URL that webRequest sees.
+    bool hand_over_on_redirect_ = false;
+
+    DISALLOW_COPY_AND_ASSIGN(BypassedRequest);
+  };
+
   ProxyingURLLoaderFactory(
       WebRequestAPI* web_request_api,
       const HandlersMap& intercepted_handlers,
@@ -213,9 +281,20 @@ class ProxyingURLLoaderFactory
   bool IsForServiceWorkerScript() const;
 
  private:
+  // Starts |request| once the download throttle was set up for it.
+  void StartRequest(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation);
+
   void OnTargetFactoryError();
   void OnProxyBindingError();
   void RemoveRequest(int32_t network_service_request_id, uint64_t request_id);
+  void RemoveBypassedRequest(BypassedRequest* request);
   void MaybeDeleteThis();
 
   bool ShouldIgnoreConnectionsLimit(const network::ResourceRequest& request);
@@ -252,6 +331,10 @@ class ProxyingURLLoaderFactory
   // internally generated request ID for the same request.
   std::map<int32_t, uint64_t> network_request_id_to_web_request_id_;
 
+  // The requests passed to the target factory without an InProgressRequest.
+  std::set<std::unique_ptr<BypassedRequest>, base::UniquePtrComparator>
+      bypassed_requests_;
+
   std::vector<std::string> ignore_connections_limit_domains_;
 
   DISALLOW_COPY_AND_ASSIGN(ProxyingURLLoaderFactory);
@@ -7,9 +7,12 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "components/proxy_config/proxy_config_pref_names.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/base/net_errors.h"
 #include "net/proxy_resolution/proxy_info.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "shell/browser/electron_browser_context.h"
@@ -18,84 +21,134 @@ using content::BrowserThread;
 
 namespace electron {
 
+namespace {
+
+// How long a resolved proxy is used for. PAC scripts can return other proxies
+// over time, so the results are not kept forever even when nothing changes.
+constexpr base::TimeDelta kCacheTTL = base::TimeDelta::FromMinutes(5);
+
+}  // namespace
+
 ResolveProxyHelper::ResolveProxyHelper(ElectronBrowserContext* browser_context)
-    : browser_context_(browser_context) {}
+    : browser_context_(browser_context) {
+  pref_change_registrar_.Init(browser_context_->prefs());
+  pref_change_registrar_.Add(
+      proxy_config::prefs::kProxy,
+      base::BindRepeating(&ResolveProxyHelper::ClearCache,
+                          base::Unretained(this)));
+  content::GetNetworkConnectionTracker()->AddNetworkConnectionObserver(this);
+}
 
 ResolveProxyHelper::~ResolveProxyHelper() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(!owned_self_);
-  DCHECK(!receiver_.is_bound());
-  // Clear all pending requests if the ProxyService is still alive.
-  pending_requests_.clear();
+  DCHECK(lookups_.empty());
+  content::GetNetworkConnectionTracker()->RemoveNetworkConnectionObserver(this);
 }
 
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       ResolveProxyCallback callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  // Enqueue the pending request.
-  pending_requests_.emplace_back(url, std::move(callback));
+  GURL lookup_url = GetLookupURL(url);
+  const std::string& key = lookup_url.spec();
+
+  auto cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    if (cached->second.expiry > base::TimeTicks::Now()) {
+      std::move(callback).Run(cached->second.proxy);
+      return;
+    }
+    cache_.erase(cached);
+  }
+
+  pending_requests_[key].push_back(std::move(callback));
+  if (lookups_.count(key))
+    return;
 
-  // If nothing is in progress, start.
-  if (!receiver_.is_bound()) {
-    DCHECK_EQ(1u, pending_requests_.size());
-    StartPendingRequest();
+  owned_self_ = this;
+  auto lookup = std::make_unique<ProxyLookup>(this, key);
+  ProxyLookup* lookup_ptr = lookup.get();
+  lookups_[key] = std::move(lookup);
+  lookup_ptr->Start(lookup_url);
+}
+
+void ResolveProxyHelper::ClearCache() {
+  cache_.clear();
+  ++generation_;
+}
+
+void ResolveProxyHelper::OnConnectionChanged(
+    network::mojom::ConnectionType type) {
+  // Another network can have another proxy, through WPAD for example.
+  ClearCache();
+}
+
+// static
+GURL ResolveProxyHelper::GetLookupURL(const GURL& url) {
+  // Like the URLs given to PAC scripts: never the credentials and the
+  // fragment, and only the scheme, host and port of https and wss URLs, so
+  // that those share the result of their host. The path of other URLs can
+  // change the proxy.
+  GURL::Replacements replacements;
+  replacements.ClearUsername();
+  replacements.ClearPassword();
+  replacements.ClearRef();
+  if (url.SchemeIsCryptographic()) {
+    replacements.ClearQuery();
+    replacements.SetPathStr("/");
   }
+  return url.ReplaceComponents(replacements);
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
+void ResolveProxyHelper::OnLookupComplete(const std::string& key,
+                                          int generation,
+                                          int32_t net_error,
+                                          const std::string& proxy) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!receiver_.is_bound());
-  DCHECK(!pending_requests_.empty());
+  if (net_error == net::OK && generation == generation_)
+    cache_[key] = {proxy, base::TimeTicks::Now() + kCacheTTL};
+
+  std::vector<ResolveProxyCallback> callbacks =
+      std::move(pending_requests_[key]);
+  pending_requests_.erase(key);
+  // Deletes the lookup, which called this.
+  lookups_.erase(key);
+
+  // Keep this alive while the callbacks run, they can start other lookups.
+  scoped_refptr<ResolveProxyHelper> self = this;
+  if (lookups_.empty())
+    owned_self_ = nullptr;
+  for (auto& callback : callbacks)
+    std::move(callback).Run(proxy);
+}
 
-  // Start the request.
+ResolveProxyHelper::ProxyLookup::ProxyLookup(ResolveProxyHelper* helper,
+                                             const std::string& key)
+    : helper_(helper), key_(key), generation_(helper->generation_) {}
+
+ResolveProxyHelper::ProxyLookup::~ProxyLookup() = default;
+
+void ResolveProxyHelper::ProxyLookup::Start(const GURL& url) {
   mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
       receiver_.BindNewPipeAndPassRemote();
   receiver_.set_disconnect_handler(
-      base::BindOnce(&ResolveProxyHelper::OnProxyLookupComplete,
+      base::BindOnce(&ProxyLookup::OnProxyLookupComplete,
                      base::Unretained(this), net::ERR_ABORTED, base::nullopt));
-  content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+  content::BrowserContext::GetDefaultStoragePartition(helper_->browser_context_)
       ->GetNetworkContext()
-      ->LookUpProxyForURL(pending_requests_.front().url,
-                          net::NetworkIsolationKey::Todo(),
+      ->LookUpProxyForURL(url, net::NetworkIsolationKey::Todo(),
                           std::move(proxy_lookup_client));
 }
 
-void ResolveProxyHelper::OnProxyLookupComplete(
+void ResolveProxyHelper::ProxyLookup::OnProxyLookupComplete(
     int32_t net_error,
     const base::Optional<net::ProxyInfo>& proxy_info) {
-  DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!pending_requests_.empty());
-
   receiver_.reset();
-
-  // Clear the current (completed) request.
-  PendingRequest completed_request = std::move(pending_requests_.front());
-  pending_requests_.pop_front();
-
   std::string proxy;
   if (proxy_info)
     proxy = proxy_info->ToPacString();
-
-  if (!completed_request.callback.is_null())
-    std::move(completed_request.callback).Run(proxy);
-
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+  // Deletes this.
+  helper_->OnLookupComplete(key_, generation_, net_error, proxy);
 }
 
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    const GURL& url,
-    ResolveProxyCallback callback)
-    : url(url), callback(std::move(callback)) {}
-
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    ResolveProxyHelper::PendingRequest&& pending_request) = default;
-
-ResolveProxyHelper::PendingRequest::~PendingRequest() noexcept = default;
-
-ResolveProxyHelper::PendingRequest& ResolveProxyHelper::PendingRequest::
-operator=(ResolveProxyHelper::PendingRequest&& pending_request) noexcept =
-    default;
-
 }  // namespace electron
@@ -5,12 +5,17 @@
 #ifndef SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 #define SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
-#include <deque>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "base/optional.h"
+#include "base/time/time.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "mojo/public/cpp/bindings/receiver.h"
+#include "services/network/public/cpp/network_connection_tracker.h"
 #include "services/network/public/mojom/proxy_lookup_client.mojom.h"
 #include "url/gurl.h"
 
@@ -18,9 +23,13 @@ namespace electron {
 
 class ElectronBrowserContext;
 
+// Resolves the proxies of URLs for a browser context. The lookups run in
+// parallel, lookups of the same scheme, host and port share their result, and
+// the results are cached for a while, until the proxy settings or the network
+// change.
 class ResolveProxyHelper
     : public base::RefCountedThreadSafe<ResolveProxyHelper>,
-      network::mojom::ProxyLookupClient {
+      public network::NetworkConnectionTracker::NetworkConnectionObserver {
  public:
   using ResolveProxyCallback = base::OnceCallback<void(std::string)>;
 
@@ -28,41 +37,68 @@ class ResolveProxyHelper
 
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
 
+  // Forgets the cached results.
+  void ClearCache();
+
+  // network::NetworkConnectionTracker::NetworkConnectionObserver:
+  void OnConnectionChanged(network::mojom::ConnectionType type) override;
+
  protected:
   ~ResolveProxyHelper() override;
 
  private:
   friend class base::RefCountedThreadSafe<ResolveProxyHelper>;
-  // A PendingRequest is a resolve request that is in progress, or queued.
-  struct PendingRequest {
+
+  // A lookup in progress, for all the pending requests of its key.
+  class ProxyLookup : public network::mojom::ProxyLookupClient {
    public:
-    PendingRequest(const GURL& url, ResolveProxyCallback callback);
-    PendingRequest(PendingRequest&& pending_request) noexcept;
-    ~PendingRequest();
+    ProxyLookup(ResolveProxyHelper* helper, const std::string& key);
+    ~ProxyLookup() override;
 
-    PendingRequest& operator=(PendingRequest&& pending_request) noexcept;
+    void Start(const GURL& url);
 
-    GURL url;
-    ResolveProxyCallback callback;
+    // network::mojom::ProxyLookupClient implementation.
+    void OnProxyLookupComplete(
+        int32_t net_error,
+        const base::Optional<net::ProxyInfo>& proxy_info) override;
 
    private:
-    DISALLOW_COPY_AND_ASSIGN(PendingRequest);
+    ResolveProxyHelper* helper_;
+    const std::string key_;
+    // The lookups started before the cache is cleared do not fill it.
+    const int generation_;
+
+    mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+
+    DISALLOW_COPY_AND_ASSIGN(ProxyLookup);
   };
 
-  // Starts the first pending request.
-  void StartPendingRequest();
+  struct CacheEntry {
+    std::string proxy;
+    base::TimeTicks expiry;
+  };
+
+  // Returns the URL the proxy of |url| is looked up with, which the whole
+  // scheme, host and port share for https and wss.
+  static GURL GetLookupURL(const GURL& url);
 
-  // network::mojom::ProxyLookupClient implementation.
-  void OnProxyLookupComplete(
-      int32_t net_error,
-      const base::Optional<net::ProxyInfo>& proxy_info) override;
+  void OnLookupComplete(const std::string& key,
+                        int generation,
+                        int32_t net_error,
+                        const std::string& proxy);
 
   // Self-reference. Owned as long as there's an outstanding proxy lookup.
   scoped_refptr<ResolveProxyHelper> owned_self_;
 
-  std::deque<PendingRequest> pending_requests_;
-  // Receiver for the currently in-progress request, if any.
-  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+  // Lookup URL => result.
+  std::map<std::string, CacheEntry> cache_;
+  int generation_ = 0;
+
+  // Lookup URL => lookup in progress, and the requests waiting for it.
+  std::map<std::string, std::unique_ptr<ProxyLookup>> lookups_;
+  std::map<std::string, std::vector<ResolveProxyCallback>> pending_requests_;
+
+  PrefChangeRegistrar pref_change_registrar_;
 
   // Weak Ref
   ElectronBrowserContext* browser_context_;
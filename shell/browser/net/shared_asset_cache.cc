@@ -0,0 +1,650 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/shared_asset_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
+#include "base/path_service.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+#include "crypto/sha2.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/cors/cors.h"
+#include "services/network/public/cpp/cors/cors_error_status.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/electron_paths.h"
+#include "url/origin.h"
+
+namespace electron {
+
+namespace {
+
+// Larger responses are passed to the client without being stored.
+constexpr size_t kMaxEntryBytes = 16 * 1024 * 1024;
+
+constexpr int64_t kMaxTotalBytes = 512 * 1024 * 1024;
+
+// Whether |request| goes to another origin than the one of its initiator.
+bool IsCrossOrigin(const network::ResourceRequest& request) {
+  return request.mode != network::mojom::RequestMode::kNavigate &&
+         request.request_initiator &&
+         !request.request_initiator->IsSameOriginWith(
+             url::Origin::Create(request.url));
+}
+
+// Checks a stored response like the network service checks the responses
+// to cross-origin requests, so that a hit exposes no more than a fetch.
+base::Optional<network::CorsErrorStatus> CheckAccess(
+    const network::ResourceRequest& request,
+    const net::HttpResponseHeaders& headers,
+    network::mojom::FetchResponseType* response_type) {
+  if (!IsCrossOrigin(request)) {
+    *response_type = network::mojom::FetchResponseType::kBasic;
+    return base::nullopt;
+  }
+
+  base::Optional<std::string> allow_origin;
+  base::Optional<std::string> allow_credentials;
+  std::string value;
+  if (headers.GetNormalizedHeader("Access-Control-Allow-Origin", &value))
+    allow_origin = value;
+  if (headers.GetNormalizedHeader("Access-Control-Allow-Credentials", &value))
+    allow_credentials = value;
+  *response_type = network::mojom::FetchResponseType::kCors;
+  return network::cors::CheckAccess(request.url, allow_origin,
+                                    allow_credentials, request.credentials_mode,
+                                    *request.request_initiator);
+}
+
+// Keeps the body and the client alive while the body is written.
+struct WriteData {
+  mojo::Remote<network::mojom::URLLoaderClient> client;
+  std::unique_ptr<std::string> body;
+  std::unique_ptr<mojo::DataPipeProducer> producer;
+};
+
+void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
+  if (result != MOJO_RESULT_OK) {
+    write_data->client->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_FAILED));
+    return;
+  }
+
+  network::URLLoaderCompletionStatus status(net::OK);
+  status.decoded_body_length = write_data->body->size();
+  write_data->client->OnComplete(status);
+}
+
+void SendResponse(mojo::Remote<network::mojom::URLLoaderClient> client,
+                  network::mojom::URLResponseHeadPtr head,
+                  std::unique_ptr<std::string> body) {
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
+    client->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  head->content_length = body->size();
+  head->headers->SetHeader(net::HttpRequestHeaders::kContentLength,
+                           base::NumberToString(body->size()));
+  client->OnReceiveResponse(std::move(head));
+  client->OnStartLoadingResponseBody(std::move(consumer));
+
+  auto write_data = std::make_unique<WriteData>();
+  write_data->client = std::move(client);
+  write_data->body = std::move(body);
+  write_data->producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+
+  mojo::DataPipeProducer* producer_ptr = write_data->producer.get();
+  base::StringPiece data(*write_data->body);
+  producer_ptr->Write(
+      std::make_unique<mojo::StringDataSource>(
+          data, mojo::StringDataSource::AsyncWritingMode::
+                    STRING_STAYS_VALID_UNTIL_COMPLETION),
+      base::BindOnce(OnWrite, std::move(write_data)));
+}
+
+// Serves a request from the cache, or has the target factory load it while
+// copying the response for the cache as it is passed to the client. It
+// deletes itself once the response is sent, or when the client goes away.
+class SharedAssetLoader : public network::mojom::URLLoaderClient {
+ public:
+  SharedAssetLoader(
+      scoped_refptr<SharedAssetCache> cache,
+      bool store_response,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      : cache_(std::move(cache)),
+        store_response_(store_response),
+        target_factory_(std::move(target_factory)),
+        loader_(std::move(loader)),
+        routing_id_(routing_id),
+        request_id_(request_id),
+        options_(options),
+        request_(request),
+        client_(std::move(client)),
+        traffic_annotation_(traffic_annotation),
+        body_watcher_(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL),
+        client_body_watcher_(FROM_HERE,
+                             mojo::SimpleWatcher::ArmingPolicy::MANUAL) {
+    client_.set_disconnect_handler(base::BindOnce(
+        &SharedAssetLoader::DeleteSelf, base::Unretained(this)));
+  }
+
+  void Start() {
+    base::PostTaskAndReplyWithResult(
+        cache_->task_runner(), FROM_HERE,
+        base::BindOnce(&SharedAssetCache::ReadEntry, cache_, request_),
+        base::BindOnce(&SharedAssetLoader::OnEntryRead,
+                       weak_factory_.GetWeakPtr()));
+  }
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override {
+    store_ = store_response_ && head->headers &&
+             SharedAssetCache::IsShareable(request_, *head->headers) &&
+             head->content_length <= static_cast<int64_t>(kMaxEntryBytes);
+    if (store_) {
+      entry_ = std::make_unique<SharedAssetCache::Entry>();
+      // The body is stored decoded, and its length is set when it is served.
+      auto headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+          head->headers->raw_headers());
+      headers->RemoveHeader("Content-Encoding");
+      headers->RemoveHeader(net::HttpRequestHeaders::kContentLength);
+      headers->RemoveHeader("Transfer-Encoding");
+      entry_->raw_headers = headers->raw_headers();
+      entry_->mime_type = head->mime_type;
+    }
+    client_->OnReceiveResponse(std::move(head));
+  }
+
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {
+    // Only the final response of the requested URL would be stored.
+    StopStoring();
+    redirected_ = true;
+    client_->OnReceiveRedirect(redirect_info, std::move(head));
+  }
+
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override {
+    client_->OnUploadProgress(current_position, total_size,
+                              std::move(callback));
+  }
+
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override {
+    client_->OnReceiveCachedMetadata(std::move(data));
+  }
+
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {
+    client_->OnTransferSizeUpdated(transfer_size_diff);
+  }
+
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override {
+    if (!store_) {
+      body_done_ = true;
+      client_->OnStartLoadingResponseBody(std::move(body));
+      return;
+    }
+
+    mojo::ScopedDataPipeConsumerHandle client_body;
+    if (mojo::CreateDataPipe(nullptr, &client_body_, &client_body) !=
+        MOJO_RESULT_OK) {
+      StopStoring();
+      body_done_ = true;
+      client_->OnStartLoadingResponseBody(std::move(body));
+      return;
+    }
+    client_->OnStartLoadingResponseBody(std::move(client_body));
+
+    body_ = std::move(body);
+    body_watcher_.Watch(body_.get(),
+                        MOJO_HANDLE_SIGNAL_READABLE |
+                            MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+                        base::BindRepeating(&SharedAssetLoader::CopyBody,
+                                            base::Unretained(this)));
+    client_body_watcher_.Watch(
+        client_body_.get(),
+        MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&SharedAssetLoader::CopyBody,
+                            base::Unretained(this)));
+    CopyBody(MOJO_RESULT_OK);
+  }
+
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    completed_ = true;
+    if (status.error_code != net::OK)
+      StopStoring();
+    client_->OnComplete(status);
+    MaybeFinish();
+  }
+
+ private:
+  void OnEntryRead(std::unique_ptr<SharedAssetCache::Entry> entry) {
+    if (!entry) {
+      Fetch();
+      return;
+    }
+
+    auto head = network::mojom::URLResponseHead::New();
+    head->request_start = base::TimeTicks::Now();
+    head->response_start = base::TimeTicks::Now();
+    head->headers =
+        base::MakeRefCounted<net::HttpResponseHeaders>(entry->raw_headers);
+    head->mime_type = entry->mime_type;
+    head->was_fetched_via_cache = true;
+    base::Optional<network::CorsErrorStatus> error =
+        CheckAccess(request_, *head->headers, &head->response_type);
+    if (error) {
+      client_->OnComplete(network::URLLoaderCompletionStatus(*error));
+      delete this;
+      return;
+    }
+
+    client_.set_disconnect_handler(base::OnceClosure());
+    SendResponse(std::move(client_), std::move(head),
+                 std::make_unique<std::string>(std::move(entry->body)));
+    delete this;
+  }
+
+  void Fetch() {
+    target_factory_->CreateLoaderAndStart(
+        std::move(loader_), routing_id_, request_id_, options_, request_,
+        receiver_.BindNewPipeAndPassRemote(), traffic_annotation_);
+    receiver_.set_disconnect_handler(base::BindOnce(
+        &SharedAssetLoader::OnTargetDisconnected, base::Unretained(this)));
+  }
+
+  void OnTargetDisconnected() {
+    if (!completed_)
+      OnComplete(network::URLLoaderCompletionStatus(net::ERR_ABORTED));
+  }
+
+  // Moves what can be read from the target's body to the client's, keeping
+  // a copy for the cache.
+  void CopyBody(MojoResult) {
+    while (true) {
+      const void* buffer;
+      uint32_t available = 0;
+      MojoResult result =
+          body_->BeginReadData(&buffer, &available, MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        body_watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The whole body has been read.
+        FinishBody();
+        return;
+      }
+
+      uint32_t written = available;
+      result = client_body_->WriteData(buffer, &written,
+                                       MOJO_WRITE_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        body_->EndReadData(0);
+        client_body_watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The client stopped reading.
+        body_->EndReadData(0);
+        StopStoring();
+        FinishBody();
+        return;
+      }
+
+      if (store_) {
+        if (entry_->body.size() + written > kMaxEntryBytes)
+          StopStoring();
+        else
+          entry_->body.append(static_cast<const char*>(buffer), written);
+      }
+      body_->EndReadData(written);
+    }
+  }
+
+  void FinishBody() {
+    body_watcher_.Cancel();
+    client_body_watcher_.Cancel();
+    body_.reset();
+    client_body_.reset();
+    body_done_ = true;
+    MaybeFinish();
+  }
+
+  void StopStoring() {
+    store_ = false;
+    entry_.reset();
+  }
+
+  void MaybeFinish() {
+    if (!completed_ || !body_done_)
+      return;
+    if (store_ && !redirected_) {
+      cache_->task_runner()->PostTask(
+          FROM_HERE, base::BindOnce(&SharedAssetCache::WriteEntry, cache_,
+                                    request_, std::move(entry_)));
+    }
+    delete this;
+  }
+
+  void DeleteSelf() { delete this; }
+
+  scoped_refptr<SharedAssetCache> cache_;
+  const bool store_response_;
+  mojo::Remote<network::mojom::URLLoaderFactory> target_factory_;
+  mojo::PendingReceiver<network::mojom::URLLoader> loader_;
+  const int32_t routing_id_;
+  const int32_t request_id_;
+  const uint32_t options_;
+  const network::ResourceRequest request_;
+  mojo::Remote<network::mojom::URLLoaderClient> client_;
+  const net::MutableNetworkTrafficAnnotationTag traffic_annotation_;
+
+  mojo::Receiver<network::mojom::URLLoaderClient> receiver_{this};
+
+  bool store_ = false;
+  bool redirected_ = false;
+  bool completed_ = false;
+  bool body_done_ = false;
+  std::unique_ptr<SharedAssetCache::Entry> entry_;
+
+  mojo::ScopedDataPipeConsumerHandle body_;
+  mojo::ScopedDataPipeProducerHandle client_body_;
+  mojo::SimpleWatcher body_watcher_;
+  mojo::SimpleWatcher client_body_watcher_;
+
+  base::WeakPtrFactory<SharedAssetLoader> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(SharedAssetLoader);
+};
+
+}  // namespace
+
+// static
+SharedAssetCache* SharedAssetCache::Get() {
+  static base::NoDestructor<scoped_refptr<SharedAssetCache>> instance;
+  if (!*instance) {
+    base::FilePath path;
+    base::PathService::Get(DIR_USER_DATA, &path);
+    *instance = base::WrapRefCounted(new SharedAssetCache(
+        path.Append(FILE_PATH_LITERAL("Shared Asset Cache"))));
+  }
+  return instance->get();
+}
+
+// static
+bool SharedAssetCache::CanHandleRequest(
+    const network::ResourceRequest& request) {
+  if (request.method != net::HttpRequestHeaders::kGetMethod ||
+      !request.url.SchemeIsHTTPOrHTTPS() || request.request_body ||
+      request.headers.HasHeader(net::HttpRequestHeaders::kRange) ||
+      (request.load_flags & (net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE)))
+    return false;
+
+  if (!IsCrossOrigin(request))
+    return true;
+
+  // Opaque responses and preflights are left to the network service, hits
+  // for other cross-origin requests get the same CORS checks as fetches.
+  if (request.mode != network::mojom::RequestMode::kCors)
+    return false;
+  net::HttpRequestHeaders::Iterator it(request.headers);
+  while (it.GetNext()) {
+    if (!network::cors::IsCorsSafelistedHeader(it.name(), it.value()))
+      return false;
+  }
+  return true;
+}
+
+// static
+bool SharedAssetCache::IsShareable(const network::ResourceRequest& request,
+                                   const net::HttpResponseHeaders& headers) {
+  // Responses to authenticated requests are only for their sender.
+  if (request.headers.HasHeader(net::HttpRequestHeaders::kAuthorization))
+    return false;
+  if (headers.response_code() != 200 || headers.HasHeader("Set-Cookie"))
+    return false;
+  if (headers.HasHeaderValue("Cache-Control", "no-store") ||
+      headers.HasHeaderValue("Cache-Control", "private"))
+    return false;
+  // The same URL could have other responses for other requests.
+  size_t iter = 0;
+  std::string vary;
+  while (headers.EnumerateHeader(&iter, "Vary", &vary)) {
+    if (!base::EqualsCaseInsensitiveASCII(vary, "accept-encoding"))
+      return false;
+  }
+  return true;
+}
+
+SharedAssetCache::SharedAssetCache(const base::FilePath& path)
+    : path_(path),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+SharedAssetCache::~SharedAssetCache() = default;
+
+void SharedAssetCache::CreateLoaderAndStart(
+    bool store_response,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
+  auto* shared_loader = new SharedAssetLoader(
+      this, store_response, std::move(target_factory), std::move(loader),
+      routing_id, request_id, options, request, std::move(client),
+      traffic_annotation);
+  shared_loader->Start();
+}
+
+void SharedAssetCache::Clear(base::OnceClosure callback) {
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(&SharedAssetCache::ClearOnSequence,
+                     base::RetainedRef(this)),
+      std::move(callback));
+}
+
+std::unique_ptr<SharedAssetCache::Entry> SharedAssetCache::ReadEntry(
+    const network::ResourceRequest& request) {
+  DCHECK(task_runner_->RunsTasksInCurrentSequence());
+  LoadIndex();
+  const base::FilePath::StringType name = GetEntryName(request);
+  if (!index_.count(name))
+    return nullptr;
+
+  std::string data;
+  std::string body_hash;
+  base::FilePath::StringType body_name;
+  auto entry = std::make_unique<Entry>();
+  bool read = base::ReadFileToString(path_.Append(name), &data);
+  if (read) {
+    base::Pickle pickle(data.data(), data.size());
+    base::PickleIterator iter(pickle);
+    read = iter.ReadString(&entry->raw_headers) &&
+           iter.ReadString(&entry->mime_type) && iter.ReadString(&body_hash) &&
+           body_hash.size() == crypto::kSHA256Length;
+  }
+  if (read) {
+    // The body may have been removed to make room, or have been damaged.
+    body_name = GetBodyName(body_hash);
+    read = index_.count(body_name) &&
+           base::ReadFileToString(path_.Append(body_name), &entry->body) &&
+           crypto::SHA256HashString(entry->body) == body_hash;
+  }
+  if (!read) {
+    RemoveCacheFile(name);
+    if (!body_name.empty())
+      RemoveCacheFile(body_name);
+    return nullptr;
+  }
+
+  TouchCacheFile(name);
+  TouchCacheFile(body_name);
+  return entry;
+}
+
+void SharedAssetCache::WriteEntry(const network::ResourceRequest& request,
+                                  std::unique_ptr<Entry> entry) {
+  DCHECK(task_runner_->RunsTasksInCurrentSequence());
+  LoadIndex();
+  if (!base::CreateDirectory(path_))
+    return;
+
+  // A body already stored for another URL, or by another session, is shared.
+  const std::string body_hash = crypto::SHA256HashString(entry->body);
+  const base::FilePath::StringType body_name = GetBodyName(body_hash);
+  if (index_.count(body_name))
+    TouchCacheFile(body_name);
+  else if (!WriteCacheFile(body_name, entry->body))
+    return;
+
+  base::Pickle pickle;
+  pickle.WriteString(entry->raw_headers);
+  pickle.WriteString(entry->mime_type);
+  pickle.WriteString(body_hash);
+  if (!WriteCacheFile(GetEntryName(request),
+                      std::string(static_cast<const char*>(pickle.data()),
+                                  pickle.size())))
+    return;
+
+  while (total_bytes_ > kMaxTotalBytes && !index_.empty())
+    RemoveLeastRecentlyUsed();
+}
+
+// static
+base::FilePath::StringType SharedAssetCache::GetEntryName(
+    const network::ResourceRequest& request) {
+  // Responses to requests with credentials can depend on them.
+  const bool credentials =
+      request.credentials_mode != network::mojom::CredentialsMode::kOmit;
+  std::string hash = crypto::SHA256HashString(
+      request.url.GetWithoutRef().spec() + (credentials ? "\n1" : "\n0"));
+  return base::FilePath()
+      .AppendASCII(base::HexEncode(hash.data(), hash.size()))
+      .value();
+}
+
+// static
+base::FilePath::StringType SharedAssetCache::GetBodyName(
+    const std::string& hash) {
+  return base::FilePath()
+      .AppendASCII(base::HexEncode(hash.data(), hash.size()))
+      .AddExtension(FILE_PATH_LITERAL("body"))
+      .value();
+}
+
+void SharedAssetCache::ClearOnSequence() {
+  DCHECK(task_runner_->RunsTasksInCurrentSequence());
+  index_.clear();
+  total_bytes_ = 0;
+  index_loaded_ = true;
+  base::DeleteFile(path_, true);
+}
+
+void SharedAssetCache::LoadIndex() {
+  if (index_loaded_)
+    return;
+  index_loaded_ = true;
+  base::FileEnumerator enumerator(path_, false, base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    // Left over by writes that did not finish.
+    if (path.MatchesExtension(FILE_PATH_LITERAL(".tmp"))) {
+      base::DeleteFile(path, false);
+      continue;
+    }
+    base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    IndexEntry& entry = index_[path.BaseName().value()];
+    entry.size = info.GetSize();
+    entry.last_used = info.GetLastModifiedTime();
+    total_bytes_ += entry.size;
+  }
+}
+
+bool SharedAssetCache::WriteCacheFile(
+    const base::FilePath::StringType& name,
+    const std::string& data) {
+  // Writing to a temporary file first keeps a partly written file from being
+  // read.
+  base::FilePath path = path_.Append(name);
+  base::FilePath temp_path = path.AddExtension(FILE_PATH_LITERAL("tmp"));
+  if (base::WriteFile(temp_path, data.data(), data.size()) !=
+          static_cast<int>(data.size()) ||
+      !base::ReplaceFile(temp_path, path, nullptr)) {
+    base::DeleteFile(temp_path, false);
+    return false;
+  }
+
+  IndexEntry& entry = index_[name];
+  total_bytes_ += static_cast<int64_t>(data.size()) - entry.size;
+  entry.size = data.size();
+  entry.last_used = base::Time::Now();
+  return true;
+}
+
+void SharedAssetCache::TouchCacheFile(
+    const base::FilePath::StringType& name) {
+  base::Time now = base::Time::Now();
+  index_[name].last_used = now;
+  base::TouchFile(path_.Append(name), now, now);
+}
+
+void SharedAssetCache::RemoveCacheFile(
+    const base::FilePath::StringType& name) {
+  auto it = index_.find(name);
+  if (it == index_.end())
+    return;
+  base::DeleteFile(path_.Append(name), false);
+  total_bytes_ -= it->second.size;
+  index_.erase(it);
+}
+
+void SharedAssetCache::RemoveLeastRecentlyUsed() {
+  // Entries whose body is removed are dropped when they are next read.
+  auto oldest = std::min_element(
+      index_.begin(), index_.end(), [](const auto& a, const auto& b) {
+        return a.second.last_used < b.second.last_used;
+      });
+  RemoveCacheFile(oldest->first);
+}
+
+}  // namespace electron
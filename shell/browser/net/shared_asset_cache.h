@@ -0,0 +1,126 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_SHARED_ASSET_CACHE_H_
+#define SHELL_BROWSER_NET_SHARED_ASSET_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+
+namespace net {
+class HttpResponseHeaders;
+}
+
+namespace electron {
+
+// Keeps the responses of the immutable resources of the app, like assets with
+// a hash of their content in their URL, so that they are served to the pages
+// of every session that opts in with ses.setSharedCacheURLs() without going
+// to the network, not even to revalidate them. There is one store for the
+// whole app, in the user data directory, and the least recently used files
+// are removed past a total size.
+//
+// Entries are keyed by the URL and whether the request sends credentials, and
+// hold the response headers and the SHA-256 of the body. Bodies are stored
+// once per hash, so a resource served under several URLs takes the space of
+// one, and are checked against it when read. The files are only touched on a
+// sequence of the thread pool.
+class SharedAssetCache : public base::RefCountedThreadSafe<SharedAssetCache> {
+ public:
+  struct Entry {
+    // In the format of net::HttpResponseHeaders::raw_headers().
+    std::string raw_headers;
+    std::string mime_type;
+    std::string body;
+  };
+
+  // The store of the app, created on first use.
+  static SharedAssetCache* Get();
+
+  // Whether |request| can be served from the cache.
+  static bool CanHandleRequest(const network::ResourceRequest& request);
+
+  // Whether the response with |headers| to |request| can be stored.
+  static bool IsShareable(const network::ResourceRequest& request,
+                          const net::HttpResponseHeaders& headers);
+
+  // Serves |request| from the cache, or fetches it with |target_factory| and
+  // stores the response when it can be shared and |store_response| is set.
+  void CreateLoaderAndStart(
+      bool store_response,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation);
+
+  // Removes all the entries, |callback| is called on the current sequence
+  // once they are gone.
+  void Clear(base::OnceClosure callback);
+
+  // Read and write the entry of |request|, on |task_runner()|.
+  std::unique_ptr<Entry> ReadEntry(const network::ResourceRequest& request);
+  void WriteEntry(const network::ResourceRequest& request,
+                  std::unique_ptr<Entry> entry);
+
+  base::SequencedTaskRunner* task_runner() const { return task_runner_.get(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<SharedAssetCache>;
+
+  struct IndexEntry {
+    int64_t size = 0;
+    base::Time last_used;
+  };
+
+  explicit SharedAssetCache(const base::FilePath& path);
+  ~SharedAssetCache();
+
+  // The name of the file of the entry of |request|.
+  static base::FilePath::StringType GetEntryName(
+      const network::ResourceRequest& request);
+  // The name of the file of the body with the SHA-256 |hash|.
+  static base::FilePath::StringType GetBodyName(const std::string& hash);
+
+  void ClearOnSequence();
+  void LoadIndex();
+  // Writes the file |name| and adds it to the index.
+  bool WriteCacheFile(const base::FilePath::StringType& name,
+                      const std::string& data);
+  void TouchCacheFile(const base::FilePath::StringType& name);
+  void RemoveCacheFile(const base::FilePath::StringType& name);
+  void RemoveLeastRecentlyUsed();
+
+  const base::FilePath path_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Only used on |task_runner_|, loaded from the directory on first use.
+  bool index_loaded_ = false;
+  // File name => entry, for the files of both the entries and the bodies.
+  std::map<base::FilePath::StringType, IndexEntry> index_;
+  int64_t total_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedAssetCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_SHARED_ASSET_CACHE_H_
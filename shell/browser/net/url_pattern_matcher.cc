@@ -0,0 +1,81 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/url_pattern_matcher.h"
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+
+namespace electron {
+
+namespace {
+
+// The index key of |host|, the patterns still do the exact matching.
+std::string GetHostKey(base::StringPiece host) {
+  base::TrimString(host, ".", &host);
+  return base::ToLowerASCII(host);
+}
+
+}  // namespace
+
+URLPatternMatcher::URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(const std::set<URLPattern>& patterns)
+    : patterns_(patterns.begin(), patterns.end()) {
+  for (size_t i = 0; i < patterns_.size(); ++i) {
+    const URLPattern& pattern = patterns_[i];
+    std::string host = GetHostKey(pattern.host());
+    if (pattern.match_all_urls() || host.empty())
+      any_host_.push_back(i);
+    else if (pattern.match_subdomains())
+      domains_[host].push_back(i);
+    else
+      hosts_[host].push_back(i);
+  }
+}
+
+URLPatternMatcher::URLPatternMatcher(const URLPatternMatcher&) = default;
+URLPatternMatcher::URLPatternMatcher(URLPatternMatcher&&) = default;
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+URLPatternMatcher& URLPatternMatcher::operator=(const URLPatternMatcher&) =
+    default;
+URLPatternMatcher& URLPatternMatcher::operator=(URLPatternMatcher&&) = default;
+
+bool URLPatternMatcher::MatchesURL(const GURL& url) const {
+  if (MatchesAny(any_host_, url))
+    return true;
+
+  std::string host = GetHostKey(url.host_piece());
+  if (host.empty())
+    return false;
+  auto it = hosts_.find(host);
+  if (it != hosts_.end() && MatchesAny(it->second, url))
+    return true;
+
+  if (domains_.empty())
+    return false;
+  // Try "a.example.com", then "example.com", then "com".
+  base::StringPiece domain(host);
+  while (true) {
+    it = domains_.find(domain.as_string());
+    if (it != domains_.end() && MatchesAny(it->second, url))
+      return true;
+    size_t dot = domain.find('.');
+    if (dot == base::StringPiece::npos)
+      return false;
+    domain.remove_prefix(dot + 1);
+  }
+}
+
+bool URLPatternMatcher::MatchesAny(const std::vector<size_t>& candidates,
+                                   const GURL& url) const {
+  for (size_t i : candidates) {
+    if (patterns_[i].MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace electron
@@ -0,0 +1,58 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+#define SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Matches URLs against a set of URLPatterns without testing every pattern.
+//
+// The patterns are indexed by host: patterns of a single host are looked up
+// by the host of the URL, and patterns matching subdomains by each suffix of
+// it, so a URL is only tested against the patterns that can match its host
+// and the patterns without a host.
+class URLPatternMatcher {
+ public:
+  URLPatternMatcher();
+  explicit URLPatternMatcher(const std::set<URLPattern>& patterns);
+  URLPatternMatcher(const URLPatternMatcher&);
+  URLPatternMatcher(URLPatternMatcher&&);
+  ~URLPatternMatcher();
+
+  URLPatternMatcher& operator=(const URLPatternMatcher&);
+  URLPatternMatcher& operator=(URLPatternMatcher&&);
+
+  bool empty() const { return patterns_.empty(); }
+
+  // Whether any of the patterns matches |url|.
+  bool MatchesURL(const GURL& url) const;
+
+ private:
+  using Index = std::unordered_map<std::string, std::vector<size_t>>;
+
+  bool MatchesAny(const std::vector<size_t>& candidates, const GURL& url) const;
+
+  std::vector<URLPattern> patterns_;
+
+  // Indices in |patterns_| of the patterns without a host, like <all_urls>
+  // or file:///*.
+  std::vector<size_t> any_host_;
+  // Host => patterns of exactly that host.
+  Index hosts_;
+  // Host => patterns of that host and its subdomains, like *.example.com.
+  Index domains_;
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
@@ -24,6 +24,9 @@ class WebRequestAPI {
                               int error_code)>;
 
   virtual bool HasListener() const = 0;
+  // Whether a listener or rule can apply to requests of |url|, the requests
+  // that none applies to are not proxied at all.
+  virtual bool HasListenerForURL(const GURL& url) const = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
@@ -0,0 +1,122 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/web_request_rules.h"
+
+#include "net/base/net_errors.h"
+
+namespace electron {
+
+namespace {
+
+// Rules without patterns apply to all URLs, unlike an empty matcher.
+std::set<URLPattern> GetPatterns(const WebRequestRules::Rule& rule) {
+  if (!rule.url_patterns.empty())
+    return rule.url_patterns;
+  return {URLPattern(URLPattern::SCHEME_ALL, URLPattern::kAllUrlsPattern)};
+}
+
+bool Matches(const URLPatternMatcher& matcher, const GURL& url) {
+  return !matcher.empty() && matcher.MatchesURL(url);
+}
+
+}  // namespace
+
+WebRequestRules::Rule::Rule() = default;
+WebRequestRules::Rule::Rule(const Rule&) = default;
+WebRequestRules::Rule::~Rule() = default;
+
+WebRequestRules::WebRequestRules() = default;
+
+WebRequestRules::WebRequestRules(const std::vector<Rule>& rules)
+    : empty_(rules.empty()) {
+  std::set<URLPattern> any;
+  std::set<URLPattern> allow;
+  std::set<URLPattern> block;
+  for (const Rule& rule : rules) {
+    std::set<URLPattern> patterns = GetPatterns(rule);
+    any.insert(patterns.begin(), patterns.end());
+    switch (rule.action) {
+      case Action::kAllow:
+        allow.insert(patterns.begin(), patterns.end());
+        break;
+      case Action::kBlock:
+        block.insert(patterns.begin(), patterns.end());
+        break;
+      case Action::kRedirect:
+        redirects_.emplace_back(URLPatternMatcher(patterns), rule.redirect_url);
+        break;
+      case Action::kModifyHeaders:
+        if (!rule.request_headers.empty())
+          request_headers_.emplace_back(URLPatternMatcher(patterns),
+                                        rule.request_headers);
+        if (!rule.response_headers.empty())
+          response_headers_.emplace_back(URLPatternMatcher(patterns),
+                                         rule.response_headers);
+        break;
+    }
+  }
+  any_ = URLPatternMatcher(any);
+  allow_ = URLPatternMatcher(allow);
+  block_ = URLPatternMatcher(block);
+}
+
+WebRequestRules::~WebRequestRules() = default;
+
+WebRequestRules& WebRequestRules::operator=(WebRequestRules&&) = default;
+
+bool WebRequestRules::MatchesURL(const GURL& url) const {
+  return Matches(any_, url);
+}
+
+int WebRequestRules::OnBeforeRequest(const GURL& url, GURL* new_url) const {
+  if (Matches(allow_, url))
+    return net::OK;
+  if (Matches(block_, url))
+    return net::ERR_BLOCKED_BY_CLIENT;
+  for (const auto& redirect : redirects_) {
+    // A rule matching the URL it redirects to would redirect forever.
+    if (redirect.second != url && Matches(redirect.first, url)) {
+      *new_url = redirect.second;
+      break;
+    }
+  }
+  return net::OK;
+}
+
+void WebRequestRules::OnBeforeSendHeaders(
+    const GURL& url,
+    net::HttpRequestHeaders* headers) const {
+  for (const auto& rule : request_headers_) {
+    if (!Matches(rule.first, url))
+      continue;
+    for (const auto& edit : rule.second) {
+      if (edit.second)
+        headers->SetHeader(edit.first, *edit.second);
+      else
+        headers->RemoveHeader(edit.first);
+    }
+  }
+}
+
+scoped_refptr<net::HttpResponseHeaders> WebRequestRules::OnHeadersReceived(
+    const GURL& url,
+    const net::HttpResponseHeaders* headers) const {
+  scoped_refptr<net::HttpResponseHeaders> edited;
+  for (const auto& rule : response_headers_) {
+    if (!Matches(rule.first, url))
+      continue;
+    if (!edited)
+      edited = base::MakeRefCounted<net::HttpResponseHeaders>(
+          headers->raw_headers());
+    for (const auto& edit : rule.second) {
+      edited->RemoveHeader(edit.first);
+      if (edit.second)
+        edited->AddHeader(edit.first + ": " + *edit.second);
+    }
+  }
+  return edited;
+}
+
+}  // namespace electron
@@ -0,0 +1,91 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+#define SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/optional.h"
+#include "extensions/common/url_pattern.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "shell/browser/net/url_pattern_matcher.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Declarative webRequest rules, which are applied to requests natively
+// instead of calling into JS.
+//
+// Allow rules take precedence over block rules, which take precedence over
+// redirect rules, of which the first matching one is used. The header edits of
+// all matching rules are applied in order.
+class WebRequestRules {
+ public:
+  enum class Action {
+    kAllow,
+    kBlock,
+    kRedirect,
+    kModifyHeaders,
+  };
+
+  // Header name => value to set, or null to remove the header.
+  using HeaderEdits = std::map<std::string, base::Optional<std::string>>;
+
+  struct Rule {
+    Rule();
+    Rule(const Rule&);
+    ~Rule();
+
+    // The rule applies to all URLs when empty.
+    std::set<URLPattern> url_patterns;
+    Action action = Action::kBlock;
+    GURL redirect_url;
+    HeaderEdits request_headers;
+    HeaderEdits response_headers;
+  };
+
+  WebRequestRules();
+  explicit WebRequestRules(const std::vector<Rule>& rules);
+  WebRequestRules(const WebRequestRules&) = delete;
+  ~WebRequestRules();
+
+  WebRequestRules& operator=(WebRequestRules&&);
+
+  bool empty() const { return empty_; }
+
+  // Whether any rule applies to |url|.
+  bool MatchesURL(const GURL& url) const;
+
+  // Returns net::ERR_BLOCKED_BY_CLIENT when the request is blocked, and sets
+  // |new_url| when it is redirected.
+  int OnBeforeRequest(const GURL& url, GURL* new_url) const;
+  void OnBeforeSendHeaders(const GURL& url,
+                           net::HttpRequestHeaders* headers) const;
+  // Returns the edited headers, or null when no rule edits them.
+  scoped_refptr<net::HttpResponseHeaders> OnHeadersReceived(
+      const GURL& url,
+      const net::HttpResponseHeaders* headers) const;
+
+ private:
+  bool empty_ = true;
+  // The patterns of all the rules.
+  URLPatternMatcher any_;
+  URLPatternMatcher allow_;
+  URLPatternMatcher block_;
+  std::vector<std::pair<URLPatternMatcher, GURL>> redirects_;
+  // Rules editing request or response headers.
+  std::vector<std::pair<URLPatternMatcher, HeaderEdits>> request_headers_;
+  std::vector<std::pair<URLPatternMatcher, HeaderEdits>> response_headers_;
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
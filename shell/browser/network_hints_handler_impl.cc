@@ -10,9 +10,11 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "v8/include/v8.h"
 
@@ -29,11 +31,14 @@ void NetworkHintsHandlerImpl::Preconnect(const GURL& url,
                                          bool allow_credentials) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  content::BrowserContext* browser_context =
-      render_frame_host_->GetProcess()->GetBrowserContext();
+  auto* browser_context = static_cast<electron::ElectronBrowserContext*>(
+      render_frame_host_->GetProcess()->GetBrowserContext());
+  // Remember the hint, so the next loads of the page preconnect before they
+  // get to it.
+  browser_context->preconnect_predictor()->OnOriginContacted(
+      content::WebContents::FromRenderFrameHost(render_frame_host_), url);
   auto* session = electron::api::Session::FromWrappedClass(
-      v8::Isolate::GetCurrent(),
-      static_cast<electron::ElectronBrowserContext*>(browser_context));
+      v8::Isolate::GetCurrent(), browser_context);
   if (session) {
     session->Emit("preconnect", url, allow_credentials);
   }
@@ -27,6 +27,9 @@ void NodeDebugger::Start() {
   if (inspector == nullptr)
     return;
 
+  // The agent has to be started even without --inspect, the inspector module
+  // and SIGUSR1 rely on it, it only listens on its port when asked to.
+  //
   // DebugOptions will already have been set by ProcessGlobalArgs,
   // so just pull the ones from there to pass to the InspectorAgent
   const auto debug_options = env_->options()->debug_options();
@@ -35,6 +35,9 @@ class CocoaNotification : public Notification {
   NSUserNotification* notification() const { return notification_; }
 
  private:
+  // Closes and destroys the notification, its delivered notification was
+  // replaced by one of the same group.
+  void Replaced();
   void LogAction(const char* action);
 
   base::scoped_nsobject<NSUserNotification> notification_;
@@ -21,6 +21,8 @@ CocoaNotification::CocoaNotification(NotificationDelegate* delegate,
     : Notification(delegate, presenter) {}
 
 CocoaNotification::~CocoaNotification() {
+  // Replaced notifications no longer have one, their identifier belongs to
+  // the notification that replaced them.
   if (notification_)
     [NSUserNotificationCenter.defaultUserNotificationCenter
         removeDeliveredNotification:notification_];
@@ -29,16 +31,32 @@ CocoaNotification::~CocoaNotification() {
 void CocoaNotification::Show(const NotificationOptions& options) {
   notification_.reset([[NSUserNotification alloc] init]);
 
+  // Delivered notifications with the same identifier are replaced.
   NSString* identifier =
-      [NSString stringWithFormat:@"%@:notification:%@",
-                                 [[NSBundle mainBundle] bundleIdentifier],
-                                 [[[NSUUID alloc] init] UUIDString]];
+      options.tag.empty()
+          ? [NSString stringWithFormat:@"%@:notification:%@",
+                                       [[NSBundle mainBundle] bundleIdentifier],
+                                       [[[NSUUID alloc] init] UUIDString]]
+          : [NSString stringWithFormat:@"%@:group:%@",
+                                       [[NSBundle mainBundle] bundleIdentifier],
+                                       base::SysUTF8ToNSString(options.tag)];
 
   [notification_ setTitle:base::SysUTF16ToNSString(options.title)];
   [notification_ setSubtitle:base::SysUTF16ToNSString(options.subtitle)];
   [notification_ setInformativeText:base::SysUTF16ToNSString(options.msg)];
   [notification_ setIdentifier:identifier];
 
+  // The delivered notification of the group is replaced by this one, and
+  // so is the notification it was delivered for.
+  if (!options.tag.empty()) {
+    for (Notification* notification : presenter()->notifications()) {
+      auto* previous = static_cast<CocoaNotification*>(notification);
+      if (previous != this && previous->notification() &&
+          [previous->notification().identifier isEqual:identifier])
+        previous->Replaced();
+    }
+  }
+
   if (getenv("ELECTRON_DEBUG_NOTIFICATIONS")) {
     LOG(INFO) << "Notification created (" << [identifier UTF8String] << ")";
   }
@@ -162,6 +180,13 @@ void CocoaNotification::NotificationDismissed() {
   this->LogAction("dismissed");
 }
 
+void CocoaNotification::Replaced() {
+  NotificationDismissed();
+  // Removing its delivered notification would remove the replacement.
+  notification_.reset(nil);
+  Destroy();
+}
+
 void CocoaNotification::LogAction(const char* action) {
   if (getenv("ELECTRON_DEBUG_NOTIFICATIONS")) {
     NSString* identifier = [notification_ valueForKey:@"identifier"];
@@ -13,9 +13,11 @@
 #include "base/environment.h"
 #include "base/files/file_util.h"
 #include "base/hash/md5.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/scoped_blocking_call.h"
 #include "base/threading/thread_restrictions.h"
-#include "base/time/time.h"
 #include "base/win/windows_version.h"
 #include "shell/browser/notifications/win/notification_presenter_win7.h"
 #include "shell/browser/notifications/win/windows_toast_notification.h"
@@ -42,6 +44,22 @@ bool SaveIconToPath(const SkBitmap& bitmap, const base::FilePath& path) {
   return base::WriteFile(path, data, size) == size;
 }
 
+// Identical icons, like the one of an app or of a contact shown for each of
+// their messages, share their file and are only encoded once.
+std::string GetIconFileName(const SkBitmap& icon) {
+  base::MD5Context context;
+  base::MD5Init(&context);
+  base::MD5Update(&context, base::StringPrintf("%dx%d:%d:", icon.width(),
+                                               icon.height(),
+                                               icon.colorType()));
+  base::MD5Update(&context,
+                  base::StringPiece(static_cast<const char*>(icon.getPixels()),
+                                    icon.computeByteSize()));
+  base::MD5Digest digest;
+  base::MD5Final(&digest, &context);
+  return base::MD5DigestToBase16(digest) + ".png";
+}
+
 }  // namespace
 
 // static
@@ -62,7 +80,9 @@ NotificationPresenter* NotificationPresenter::Create() {
   return presenter.release();
 }
 
-NotificationPresenterWin::NotificationPresenterWin() {}
+NotificationPresenterWin::NotificationPresenterWin()
+    : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE})) {}
 
 NotificationPresenterWin::~NotificationPresenterWin() {}
 
@@ -71,20 +91,18 @@ bool NotificationPresenterWin::Init() {
   return temp_dir_.CreateUniqueTempDir();
 }
 
+// static
 base::string16 NotificationPresenterWin::SaveIconToFilesystem(
+    const base::FilePath& directory,
     const SkBitmap& icon,
     const GURL& origin) {
-  std::string filename;
+  if (icon.drawsNothing())
+    return base::UTF8ToUTF16(origin.spec());
 
-  if (origin.is_valid()) {
-    filename = base::MD5String(origin.spec()) + ".png";
-  } else {
-    base::TimeTicks now = base::TimeTicks::Now();
-    filename = std::to_string(now.ToInternalValue()) + ".png";
-  }
-
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
-  base::FilePath path = temp_dir_.GetPath().Append(base::UTF8ToUTF16(filename));
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::FilePath path =
+      directory.Append(base::UTF8ToUTF16(GetIconFileName(icon)));
   if (base::PathExists(path))
     return path.value();
   if (SaveIconToPath(icon, path))
@@ -24,6 +24,8 @@
 #define SHELL_BROWSER_NOTIFICATIONS_WIN_NOTIFICATION_PRESENTER_WIN_H_
 
 #include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string16.h"
 #include "shell/browser/notifications/notification_presenter.h"
 
@@ -39,13 +41,25 @@ class NotificationPresenterWin : public NotificationPresenter {
 
   bool Init();
 
-  base::string16 SaveIconToFilesystem(const SkBitmap& icon, const GURL& origin);
+  // Writes |icon| in |directory| as a PNG named after the hash of its pixels,
+  // unless such a file is already there, and returns its path, or the spec of
+  // |origin| when there is no icon. Blocks, so only runs on |task_runner()|.
+  static base::string16 SaveIconToFilesystem(const base::FilePath& directory,
+                                             const SkBitmap& icon,
+                                             const GURL& origin);
+
+  // The directory of the icons of the notifications.
+  const base::FilePath& icon_directory() const { return temp_dir_.GetPath(); }
+
+  // Where the icons are saved and the toasts are prepared, off the UI thread.
+  base::SequencedTaskRunner* task_runner() const { return task_runner_.get(); }
 
  private:
   Notification* CreateNotificationObject(
       NotificationDelegate* delegate) override;
 
   base::ScopedTempDir temp_dir_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
   DISALLOW_COPY_AND_ASSIGN(NotificationPresenterWin);
 };
@@ -11,9 +11,12 @@
 #include <shlobj.h>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/environment.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/win/scoped_com_initializer.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "shell/browser/notifications/notification_delegate.h"
@@ -88,14 +91,43 @@ WindowsToastNotification::~WindowsToastNotification() {
 }
 
 void WindowsToastNotification::Show(const NotificationOptions& options) {
+  // Encoding the icon and building the XML of the toast take a while, which
+  // adds up in bursts of notifications, so they are done off the UI thread.
   auto* presenter_win = static_cast<NotificationPresenterWin*>(presenter());
-  std::wstring icon_path =
-      presenter_win->SaveIconToFilesystem(options.icon, options.icon_url);
+  base::PostTaskAndReplyWithResult(
+      presenter_win->task_runner(), FROM_HERE,
+      base::BindOnce(&WindowsToastNotification::CreateToastXml,
+                     presenter_win->icon_directory(), options),
+      base::BindOnce(&WindowsToastNotification::ShowToastXml,
+                     weak_factory_.GetWeakPtr(), options));
+}
+
+// static
+ComPtr<IXmlDocument> WindowsToastNotification::CreateToastXml(
+    const base::FilePath& icon_directory,
+    const NotificationOptions& options) {
+  base::win::ScopedCOMInitializer com_initializer(
+      base::win::ScopedCOMInitializer::kMTA);
+  std::wstring icon_path = NotificationPresenterWin::SaveIconToFilesystem(
+      icon_directory, options.icon, options.icon_url);
 
   ComPtr<IXmlDocument> toast_xml;
-  if (FAILED(GetToastXml(toast_manager_.Get(), options.title, options.msg,
-                         icon_path, options.timeout_type, options.silent,
-                         &toast_xml))) {
+  if (!GetToastXml(toast_manager_.Get(), options.title, options.msg,
+                   icon_path, options.timeout_type, options.silent,
+                   &toast_xml)) {
+    return nullptr;
+  }
+  return toast_xml;
+}
+
+void WindowsToastNotification::ShowToastXml(const NotificationOptions& options,
+                                            ComPtr<IXmlDocument> toast_xml) {
+  if (dismissed_) {
+    NotificationDismissed();
+    return;
+  }
+
+  if (!toast_xml) {
     NotificationFailed();
     return;
   }
@@ -121,6 +153,14 @@ void WindowsToastNotification::Show(const NotificationOptions& options) {
     return;
   }
 
+  // Toasts with the same tag replace each other in the action center.
+  if (!options.tag.empty()) {
+    ComPtr<ABI::Windows::UI::Notifications::IToastNotification2> toast2;
+    ScopedHString tag(base::UTF8ToWide(options.tag));
+    if (tag.success() && SUCCEEDED(toast_notification_.As(&toast2)))
+      toast2->put_Tag(tag);
+  }
+
   if (!SetupCallbacks(toast_notification_.Get())) {
     NotificationFailed();
     return;
@@ -139,6 +179,11 @@ void WindowsToastNotification::Show(const NotificationOptions& options) {
 }
 
 void WindowsToastNotification::Dismiss() {
+  if (!toast_notification_) {
+    // The toast is still being prepared, it is not shown once ready.
+    dismissed_ = true;
+    return;
+  }
   if (IsDebuggingNotifications())
     LOG(INFO) << "Hiding notification";
   toast_notifier_->Hide(toast_notification_.Get());
@@ -15,6 +15,8 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
 #include "shell/browser/notifications/notification.h"
 
 using Microsoft::WRL::ClassicCom;
@@ -57,7 +59,16 @@ class WindowsToastNotification : public Notification {
  private:
   friend class ToastEventHandler;
 
-  bool GetToastXml(
+  // Builds the XML of the toast, after saving its icon in |icon_directory|.
+  // Runs on the task runner of the presenter, returns null on failure.
+  static ComPtr<ABI::Windows::Data::Xml::Dom::IXmlDocument> CreateToastXml(
+      const base::FilePath& icon_directory,
+      const NotificationOptions& options);
+  void ShowToastXml(
+      const NotificationOptions& options,
+      ComPtr<ABI::Windows::Data::Xml::Dom::IXmlDocument> toast_xml);
+
+  static bool GetToastXml(
       ABI::Windows::UI::Notifications::IToastNotificationManagerStatics*
           toastManager,
       const std::wstring& title,
@@ -66,22 +77,25 @@ class WindowsToastNotification : public Notification {
       const std::wstring& timeout_type,
       const bool silent,
       ABI::Windows::Data::Xml::Dom::IXmlDocument** toastXml);
-  bool SetXmlAudioSilent(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc);
-  bool SetXmlScenarioReminder(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc);
-  bool SetXmlText(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
-                  const std::wstring& text);
-  bool SetXmlText(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
-                  const std::wstring& title,
-                  const std::wstring& body);
-  bool SetXmlImage(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
-                   const std::wstring& icon_path);
-  bool GetTextNodeList(ScopedHString* tag,
-                       ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
-                       ABI::Windows::Data::Xml::Dom::IXmlNodeList** nodeList,
-                       uint32_t reqLength);
-  bool AppendTextToXml(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
-                       ABI::Windows::Data::Xml::Dom::IXmlNode* node,
-                       const std::wstring& text);
+  static bool SetXmlAudioSilent(
+      ABI::Windows::Data::Xml::Dom::IXmlDocument* doc);
+  static bool SetXmlScenarioReminder(
+      ABI::Windows::Data::Xml::Dom::IXmlDocument* doc);
+  static bool SetXmlText(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
+                         const std::wstring& text);
+  static bool SetXmlText(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
+                         const std::wstring& title,
+                         const std::wstring& body);
+  static bool SetXmlImage(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
+                          const std::wstring& icon_path);
+  static bool GetTextNodeList(
+      ScopedHString* tag,
+      ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
+      ABI::Windows::Data::Xml::Dom::IXmlNodeList** nodeList,
+      uint32_t reqLength);
+  static bool AppendTextToXml(ABI::Windows::Data::Xml::Dom::IXmlDocument* doc,
+                              ABI::Windows::Data::Xml::Dom::IXmlNode* node,
+                              const std::wstring& text);
   bool SetupCallbacks(
       ABI::Windows::UI::Notifications::IToastNotification* toast);
   bool RemoveCallbacks(
@@ -101,6 +115,11 @@ class WindowsToastNotification : public Notification {
   ComPtr<ABI::Windows::UI::Notifications::IToastNotification>
       toast_notification_;
 
+  // Whether the notification was dismissed before its toast was ready.
+  bool dismissed_ = false;
+
+  base::WeakPtrFactory<WindowsToastNotification> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(WindowsToastNotification);
 };
 
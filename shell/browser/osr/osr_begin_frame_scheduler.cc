@@ -0,0 +1,146 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_begin_frame_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+
+namespace electron {
+
+namespace {
+
+// The phases the clients are spread over, in fractions of their interval.
+constexpr int kPhaseCount = 8;
+
+// Clients due this close to each other are run by the same timer task.
+constexpr base::TimeDelta kTimerSlack = base::TimeDelta::FromMilliseconds(1);
+
+// After this many begin frames in a row without damage, clients only get a
+// begin frame every |kIdleIntervalFactor| intervals.
+constexpr int kIdleFrameCount = 60;
+constexpr int kIdleIntervalFactor = 4;
+
+}  // namespace
+
+// static
+OffScreenBeginFrameScheduler* OffScreenBeginFrameScheduler::GetInstance() {
+  static base::NoDestructor<OffScreenBeginFrameScheduler> instance;
+  return instance.get();
+}
+
+OffScreenBeginFrameScheduler::OffScreenBeginFrameScheduler() = default;
+
+OffScreenBeginFrameScheduler::~OffScreenBeginFrameScheduler() = default;
+
+void OffScreenBeginFrameScheduler::AddClient(Client* client) {
+  Entry& entry = clients_[client];
+  entry.phase = added_clients_++ % kPhaseCount;
+  entry.next_frame =
+      base::TimeTicks::Now() + entry.interval * entry.phase / kPhaseCount;
+}
+
+void OffScreenBeginFrameScheduler::RemoveClient(Client* client) {
+  clients_.erase(client);
+  Schedule();
+}
+
+void OffScreenBeginFrameScheduler::UpdateClient(Client* client,
+                                                base::TimeDelta interval,
+                                                bool visible) {
+  DCHECK(!interval.is_zero());
+  auto it = clients_.find(client);
+  if (it == clients_.end())
+    return;
+  Entry& entry = it->second;
+  if (entry.interval != interval) {
+    entry.interval = interval;
+    entry.next_frame =
+        base::TimeTicks::Now() + interval * entry.phase / kPhaseCount;
+  }
+  if (visible && !entry.visible)
+    entry.idle_frames = 0;
+  entry.visible = visible;
+  Schedule();
+}
+
+void OffScreenBeginFrameScheduler::WakeClient(Client* client) {
+  auto it = clients_.find(client);
+  if (it == clients_.end() || it->second.idle_frames < kIdleFrameCount)
+    return;
+  Entry& entry = it->second;
+  entry.idle_frames = 0;
+  entry.next_frame =
+      std::min(entry.next_frame, base::TimeTicks::Now() + entry.interval);
+  Schedule();
+}
+
+base::TimeDelta OffScreenBeginFrameScheduler::GetInterval(
+    const Entry& entry) const {
+  if (entry.idle_frames >= kIdleFrameCount)
+    return entry.interval * kIdleIntervalFactor;
+  return entry.interval;
+}
+
+void OffScreenBeginFrameScheduler::Schedule() {
+  base::TimeTicks next_frame = base::TimeTicks::Max();
+  for (const auto& it : clients_) {
+    if (it.second.visible)
+      next_frame = std::min(next_frame, it.second.next_frame);
+  }
+  if (next_frame.is_max()) {
+    timer_.Stop();
+    return;
+  }
+  base::TimeDelta delay =
+      std::max(next_frame - base::TimeTicks::Now(), base::TimeDelta());
+  timer_.Start(FROM_HERE, delay, this, &OffScreenBeginFrameScheduler::OnTimer);
+}
+
+void OffScreenBeginFrameScheduler::OnTimer() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<std::pair<Client*, base::TimeDelta>> due;
+  for (auto& it : clients_) {
+    Entry& entry = it.second;
+    if (!entry.visible || entry.next_frame > now + kTimerSlack)
+      continue;
+    base::TimeDelta interval = GetInterval(entry);
+    // Frames the client missed are skipped rather than issued in a burst.
+    int64_t missed = 0;
+    if (entry.next_frame < now) {
+      missed = (now - entry.next_frame).InMicroseconds() /
+               interval.InMicroseconds();
+    }
+    entry.next_frame += interval * (missed + 1);
+    due.emplace_back(it.first, interval);
+  }
+
+  for (const auto& it : due) {
+    // A client can go away while an earlier one handles its begin frame.
+    if (!clients_.count(it.first))
+      continue;
+    it.first->OnBeginFrame(
+        now, it.second,
+        base::BindOnce(&OffScreenBeginFrameScheduler::OnFrameDone,
+                       weak_ptr_factory_.GetWeakPtr(), it.first));
+  }
+  Schedule();
+}
+
+void OffScreenBeginFrameScheduler::OnFrameDone(Client* client,
+                                               bool has_damage) {
+  auto it = clients_.find(client);
+  if (it == clients_.end())
+    return;
+  if (has_damage)
+    it->second.idle_frames = 0;
+  else
+    it->second.idle_frames =
+        std::min(it->second.idle_frames + 1, kIdleFrameCount);
+}
+
+}  // namespace electron
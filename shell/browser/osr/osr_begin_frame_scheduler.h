@@ -0,0 +1,79 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_SCHEDULER_H_
+#define SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_SCHEDULER_H_
+
+#include <map>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+// Issues the begin frames of all offscreen views from a single timer. The
+// views are spread over their frame interval so they do not all draw and
+// capture at once, hidden views get no begin frames, and views that have
+// produced no damage for a while are throttled until they draw again.
+class OffScreenBeginFrameScheduler {
+ public:
+  class Client {
+   public:
+    // Issues a begin frame, |callback| is run with whether it had damage.
+    virtual void OnBeginFrame(base::TimeTicks frame_time,
+                              base::TimeDelta interval,
+                              base::OnceCallback<void(bool)> callback) = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  static OffScreenBeginFrameScheduler* GetInstance();
+
+  void AddClient(Client* client);
+  void RemoveClient(Client* client);
+  void UpdateClient(Client* client, base::TimeDelta interval, bool visible);
+
+  // Ends the throttling of |client|, for example when it gets input.
+  void WakeClient(Client* client);
+
+ private:
+  friend class base::NoDestructor<OffScreenBeginFrameScheduler>;
+
+  struct Entry {
+    base::TimeDelta interval = base::TimeDelta::FromSeconds(1) / 60;
+    base::TimeTicks next_frame;
+    // The part of the interval the frames of the client are issued at, in
+    // eighths.
+    int phase = 0;
+    bool visible = false;
+    // Begin frames in a row that had no damage.
+    int idle_frames = 0;
+  };
+
+  OffScreenBeginFrameScheduler();
+  ~OffScreenBeginFrameScheduler();
+
+  base::TimeDelta GetInterval(const Entry& entry) const;
+  void Schedule();
+  void OnTimer();
+  void OnFrameDone(Client* client, bool has_damage);
+
+  std::map<Client*, Entry> clients_;
+  // Counts the added clients, to give each one its phase.
+  int added_clients_ = 0;
+  base::OneShotTimer timer_;
+
+  base::WeakPtrFactory<OffScreenBeginFrameScheduler> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenBeginFrameScheduler);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_SCHEDULER_H_
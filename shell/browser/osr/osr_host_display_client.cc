@@ -77,10 +77,18 @@ void LayeredWindowUpdater::Draw(const gfx::Rect& damage_rect,
   std::move(draw_callback).Run();
 }
 
+OffScreenSharedTexture::OffScreenSharedTexture() = default;
+OffScreenSharedTexture::OffScreenSharedTexture(OffScreenSharedTexture&&) =
+    default;
+OffScreenSharedTexture::~OffScreenSharedTexture() = default;
+
 OffScreenHostDisplayClient::OffScreenHostDisplayClient(
     gfx::AcceleratedWidget widget,
-    OnPaintCallback callback)
-    : viz::HostDisplayClient(widget), callback_(callback) {}
+    OnPaintCallback callback,
+    OnTexturePaintCallback texture_callback)
+    : viz::HostDisplayClient(widget),
+      callback_(callback),
+      texture_callback_(texture_callback) {}
 OffScreenHostDisplayClient::~OffScreenHostDisplayClient() = default;
 
 void OffScreenHostDisplayClient::SetActive(bool active) {
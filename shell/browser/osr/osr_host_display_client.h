@@ -13,11 +13,30 @@
 #include "services/viz/privileged/mojom/compositing/layered_window_updater.mojom.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/native_widget_types.h"
 
 namespace electron {
 
+// A frame the compositor drew into a platform texture, handed to the embedder
+// as is instead of being copied into a bitmap.
+struct OffScreenSharedTexture {
+  OffScreenSharedTexture();
+  OffScreenSharedTexture(OffScreenSharedTexture&&);
+  ~OffScreenSharedTexture();
+
+  gfx::Size pixel_size;
+  // The IOSurfaceRef of the frame on macOS.
+  void* handle = nullptr;
+  // The compositor does not draw into the texture again until this has run.
+  base::OnceClosure release;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenSharedTexture);
+};
+
 typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
+typedef base::RepeatingCallback<void(const gfx::Rect&, OffScreenSharedTexture)>
+    OnTexturePaintCallback;
 
 class LayeredWindowUpdater : public viz::mojom::LayeredWindowUpdater {
  public:
@@ -48,8 +67,11 @@ class LayeredWindowUpdater : public viz::mojom::LayeredWindowUpdater {
 
 class OffScreenHostDisplayClient : public viz::HostDisplayClient {
  public:
-  explicit OffScreenHostDisplayClient(gfx::AcceleratedWidget widget,
-                                      OnPaintCallback callback);
+  // Frames are passed to |texture_callback| instead of |callback| when it is
+  // not null and the platform draws into textures it can share.
+  OffScreenHostDisplayClient(gfx::AcceleratedWidget widget,
+                             OnPaintCallback callback,
+                             OnTexturePaintCallback texture_callback);
   ~OffScreenHostDisplayClient() override;
 
   void SetActive(bool active);
@@ -72,6 +94,7 @@ class OffScreenHostDisplayClient : public viz::HostDisplayClient {
 
   std::unique_ptr<LayeredWindowUpdater> layered_window_updater_;
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
   bool active_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(OffScreenHostDisplayClient);
@@ -6,6 +6,10 @@
 
 #include <IOSurface/IOSurface.h>
 
+#include <utility>
+
+#include "base/bind.h"
+
 namespace electron {
 
 void OffScreenHostDisplayClient::OnDisplayReceivedCALayerParams(
@@ -14,6 +18,22 @@ void OffScreenHostDisplayClient::OnDisplayReceivedCALayerParams(
     base::ScopedCFTypeRef<IOSurfaceRef> io_surface(
         IOSurfaceLookupFromMachPort(ca_layer_params.io_surface_mach_port));
 
+    if (texture_callback_) {
+      // The output device only reuses the surfaces that are not in use, so
+      // holding a use count keeps the frame intact until it is released.
+      IOSurfaceIncrementUseCount(io_surface);
+      OffScreenSharedTexture texture;
+      texture.pixel_size = ca_layer_params.pixel_size;
+      texture.handle = io_surface.get();
+      texture.release = base::BindOnce(
+          [](base::ScopedCFTypeRef<IOSurfaceRef> io_surface) {
+            IOSurfaceDecrementUseCount(io_surface);
+          },
+          io_surface);
+      texture_callback_.Run(ca_layer_params.damage, std::move(texture));
+      return;
+    }
+
     gfx::Size pixel_size_ = ca_layer_params.pixel_size;
     void* pixels = static_cast<void*>(IOSurfaceGetBaseAddress(io_surface));
     size_t stride = IOSurfaceGetBytesPerRow(io_surface);
@@ -14,8 +14,10 @@
 #include "base/memory/ptr_util.h"
 #include "base/optional.h"
 #include "base/single_thread_task_runner.h"
+#include "base/stl_util.h"
 #include "base/task/post_task.h"
 #include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "components/viz/common/frame_sinks/copy_output_request.h"
@@ -168,9 +170,12 @@ class ElectronDelegatedFrameHostClient
 
 OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
+    bool external_begin_frames,
+    bool shared_begin_frames,
     bool painting,
     int frame_rate,
     const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback,
     content::RenderWidgetHost* host,
     OffScreenRenderWidgetHostView* parent_host_view,
     gfx::Size initial_size)
@@ -178,7 +183,10 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       render_widget_host_(content::RenderWidgetHostImpl::From(host)),
       parent_host_view_(parent_host_view),
       transparent_(transparent),
+      external_begin_frames_(external_begin_frames),
+      shared_begin_frames_(shared_begin_frames && !external_begin_frames),
       callback_(callback),
+      texture_callback_(texture_callback),
       frame_rate_(frame_rate),
       size_(initial_size),
       painting_(painting),
@@ -215,7 +223,8 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
   compositor_ = std::make_unique<ui::Compositor>(
       context_factory->AllocateFrameSinkId(), context_factory,
       base::ThreadTaskRunnerHandle::Get(), false /* enable_pixel_canvas */,
-      false /* use_external_begin_frame_control */);
+      external_begin_frames_ ||
+          shared_begin_frames_ /* use_external_begin_frame_control */);
   compositor_->SetAcceleratedWidget(gfx::kNullAcceleratedWidget);
   compositor_->SetDelegate(this);
   compositor_->SetRootLayer(root_layer_.get());
@@ -226,14 +235,23 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
 
   if (content::GpuDataManager::GetInstance()->HardwareAccelerationEnabled()) {
     video_consumer_ = std::make_unique<OffScreenVideoConsumer>(
-        this, base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
-                                  weak_ptr_factory_.GetWeakPtr()));
+        this,
+        base::BindRepeating(&OffScreenRenderWidgetHostView::OnCapturedFrame,
+                            weak_ptr_factory_.GetWeakPtr()));
     video_consumer_->SetActive(IsPainting());
     video_consumer_->SetFrameRate(GetFrameRate());
   }
+
+  if (shared_begin_frames_) {
+    OffScreenBeginFrameScheduler::GetInstance()->AddClient(this);
+    UpdateBeginFrameScheduler();
+  }
 }
 
 OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
+  if (shared_begin_frames_)
+    OffScreenBeginFrameScheduler::GetInstance()->RemoveClient(this);
+
   // Marking the DelegatedFrameHost as removed from the window hierarchy is
   // necessary to remove all connections to its old ui::Compositor.
   if (is_showing_)
@@ -312,6 +330,8 @@ void OffScreenRenderWidgetHostView::Show() {
 
   if (render_widget_host_)
     render_widget_host_->WasShown(base::nullopt);
+
+  UpdateBeginFrameScheduler();
 }
 
 void OffScreenRenderWidgetHostView::Hide() {
@@ -327,6 +347,7 @@ void OffScreenRenderWidgetHostView::Hide() {
   GetDelegatedFrameHost()->DetachFromCompositor();
 
   is_showing_ = false;
+  UpdateBeginFrameScheduler();
 }
 
 bool OffScreenRenderWidgetHostView::IsShowing() {
@@ -544,8 +565,9 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->GetFrameRate(), callback_,
-      render_widget_host, embedder_host_view, size());
+      transparent_, false, false, true, embedder_host_view->GetFrameRate(),
+      callback_, texture_callback_, render_widget_host, embedder_host_view,
+      size());
 }
 
 const viz::FrameSinkId& OffScreenRenderWidgetHostView::GetFrameSinkId() const {
@@ -623,10 +645,17 @@ void OffScreenRenderWidgetHostView::ProxyViewDestroyed(
 std::unique_ptr<viz::HostDisplayClient>
 OffScreenRenderWidgetHostView::CreateHostDisplayClient(
     ui::Compositor* compositor) {
+  OnTexturePaintCallback texture_callback;
+  if (texture_callback_) {
+    texture_callback =
+        base::BindRepeating(&OffScreenRenderWidgetHostView::OnTexturePaint,
+                            weak_ptr_factory_.GetWeakPtr());
+  }
   host_display_client_ = new OffScreenHostDisplayClient(
       gfx::kNullAcceleratedWidget,
       base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
-                          weak_ptr_factory_.GetWeakPtr()));
+                          weak_ptr_factory_.GetWeakPtr()),
+      texture_callback);
   host_display_client_->SetActive(IsPainting());
   return base::WrapUnique(host_display_client_);
 }
@@ -654,10 +683,45 @@ bool OffScreenRenderWidgetHostView::UpdateNSViewAndDisplay() {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
+  frame_timing_ = OffScreenFrameTiming();
+  frame_timing_.received = base::TimeTicks::Now();
+  PaintBitmap(damage_rect, bitmap);
+}
+
+void OffScreenRenderWidgetHostView::PaintBitmap(const gfx::Rect& damage_rect,
+                                                const SkBitmap& bitmap) {
   backing_ = std::make_unique<SkBitmap>();
   backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
   bitmap.readPixels(backing_->pixmap());
 
+  OnBackingChanged(damage_rect);
+}
+
+void OffScreenRenderWidgetHostView::OnCapturedFrame(
+    const gfx::Rect& damage_rect,
+    const SkBitmap& bitmap,
+    const OffScreenFrameTiming& timing) {
+  frame_timing_ = timing;
+  frame_timing_.begin_frame = last_begin_frame_time_;
+
+  // Captured frames are immutable and the capturer does not reuse their
+  // memory while their pixels are referenced, so they are used as backing
+  // without a copy. Frames whose rows are padded are still copied, users of
+  // the paint event expect tightly packed pixels.
+  if (bitmap.rowBytes() != bitmap.info().minRowBytes()) {
+    PaintBitmap(damage_rect, bitmap);
+    return;
+  }
+
+  backing_ = std::make_unique<SkBitmap>(bitmap);
+  if (!transparent_)
+    backing_->setAlphaType(kOpaque_SkAlphaType);
+
+  OnBackingChanged(damage_rect);
+}
+
+void OffScreenRenderWidgetHostView::OnBackingChanged(
+    const gfx::Rect& damage_rect) {
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
   } else {
@@ -665,6 +729,21 @@ void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
   }
 }
 
+void OffScreenRenderWidgetHostView::OnTexturePaint(
+    const gfx::Rect& damage_rect,
+    OffScreenSharedTexture texture) {
+  frame_timing_ = OffScreenFrameTiming();
+  frame_timing_.received = base::TimeTicks::Now();
+  TraceFrameTiming();
+
+  // Popups and proxy views are only composited into bitmap frames.
+  HoldResize();
+  texture_callback_.Run(
+      gfx::IntersectRects(gfx::Rect(texture.pixel_size), damage_rect),
+      std::move(texture));
+  ReleaseResize();
+}
+
 gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
   if (IsPopupWidget()) {
     return gfx::ConvertSizeToPixel(current_device_scale_factor_,
@@ -711,6 +790,8 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
     }
   }
 
+  TraceFrameTiming();
+
   paint_callback_running_ = true;
   callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
                 frame);
@@ -719,6 +800,38 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
   ReleaseResize();
 }
 
+void OffScreenRenderWidgetHostView::TraceFrameTiming() {
+  // Each frame is an async slice from its earliest known stage to its
+  // delivery, with a nested slice for each stage.
+  const OffScreenFrameTiming& timing = frame_timing_;
+  base::TimeTicks delivered = base::TimeTicks::Now();
+  base::TimeTicks stages[] = {timing.begin_frame, timing.frame_time,
+                              timing.capture_begin, timing.capture_end,
+                              timing.received, delivered};
+  const char* names[] = {"Draw", "CaptureQueue", "Capture", "Transfer",
+                         "Delivery"};
+  uint64_t id = ++painted_frame_count_;
+  base::TimeTicks start;
+  for (const base::TimeTicks& stage : stages) {
+    if (!stage.is_null()) {
+      start = stage;
+      break;
+    }
+  }
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      "electron", "OffScreenFrame", TRACE_ID_LOCAL(id), start);
+  for (size_t i = 0; i + 1 < base::size(stages); ++i) {
+    if (stages[i].is_null() || stages[i + 1].is_null())
+      continue;
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+        "electron", names[i], TRACE_ID_LOCAL(id), stages[i]);
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+        "electron", names[i], TRACE_ID_LOCAL(id), stages[i + 1]);
+  }
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      "electron", "OffScreenFrame", TRACE_ID_LOCAL(id), delivered);
+}
+
 void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect) {
   InvalidateBounds(
       gfx::ConvertRectToPixel(current_device_scale_factor_, damage_rect));
@@ -757,6 +870,7 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
     return;
   }
 
+  WakeBeginFrameScheduler();
   ResizeRootLayer(true);
 }
 
@@ -795,6 +909,7 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
 
   if (!render_widget_host_)
     return;
+  WakeBeginFrameScheduler();
   render_widget_host_->ForwardMouseEvent(event);
 }
 
@@ -878,6 +993,7 @@ void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
   }
   if (!render_widget_host_)
     return;
+  WakeBeginFrameScheduler();
   render_widget_host_->ForwardWheelEvent(event);
 }
 
@@ -896,6 +1012,8 @@ void OffScreenRenderWidgetHostView::SetPainting(bool painting) {
   } else if (host_display_client_) {
     host_display_client_->SetActive(IsPainting());
   }
+
+  UpdateBeginFrameScheduler();
 }
 
 bool OffScreenRenderWidgetHostView::IsPainting() const {
@@ -960,6 +1078,7 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
         base::TimeTicks::Now(),
         base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_));
   }
+  UpdateBeginFrameScheduler();
 }
 
 void OffScreenRenderWidgetHostView::Invalidate() {
@@ -967,9 +1086,65 @@ void OffScreenRenderWidgetHostView::Invalidate() {
 }
 
 void OffScreenRenderWidgetHostView::InvalidateBounds(const gfx::Rect& bounds) {
+  // A throttled view would otherwise wait for its next slow begin frame.
+  WakeBeginFrameScheduler();
   CompositeFrame(bounds);
 }
 
+void OffScreenRenderWidgetHostView::IssueBeginFrame() {
+  if (!external_begin_frames_ || !compositor_)
+    return;
+
+  base::TimeTicks frame_time = base::TimeTicks::Now();
+  last_begin_frame_time_ = frame_time;
+  base::TimeDelta interval =
+      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
+  viz::BeginFrameArgs args = viz::BeginFrameArgs::Create(
+      BEGINFRAME_FROM_HERE, viz::BeginFrameArgs::kManualSourceId,
+      begin_frame_number_++, frame_time, frame_time + interval, interval,
+      viz::BeginFrameArgs::NORMAL);
+  compositor_->IssueExternalBeginFrame(args, true /* force */,
+                                       base::DoNothing());
+}
+
+void OffScreenRenderWidgetHostView::OnBeginFrame(
+    base::TimeTicks frame_time,
+    base::TimeDelta interval,
+    base::OnceCallback<void(bool)> callback) {
+  last_begin_frame_time_ = frame_time;
+  viz::BeginFrameArgs args = viz::BeginFrameArgs::Create(
+      BEGINFRAME_FROM_HERE, viz::BeginFrameArgs::kManualSourceId,
+      begin_frame_number_++, frame_time, frame_time + interval, interval,
+      viz::BeginFrameArgs::NORMAL);
+  // The display only draws when the frame has damage, which tells the
+  // scheduler whether to throttle the view.
+  compositor_->IssueExternalBeginFrame(
+      args, false /* force */,
+      base::BindOnce(
+          [](base::OnceCallback<void(bool)> callback,
+             const viz::BeginFrameAck& ack) {
+            std::move(callback).Run(ack.has_damage);
+          },
+          std::move(callback)));
+}
+
+void OffScreenRenderWidgetHostView::UpdateBeginFrameScheduler() {
+  if (!shared_begin_frames_)
+    return;
+  // Views that are not painting keep a low rate so the page still runs its
+  // frames.
+  base::TimeDelta interval = base::TimeDelta::FromSeconds(1);
+  if (IsPainting())
+    interval = base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
+  OffScreenBeginFrameScheduler::GetInstance()->UpdateClient(this, interval,
+                                                            is_showing_);
+}
+
+void OffScreenRenderWidgetHostView::WakeBeginFrameScheduler() {
+  if (shared_begin_frames_)
+    OffScreenBeginFrameScheduler::GetInstance()->WakeClient(this);
+}
+
 void OffScreenRenderWidgetHostView::ResizeRootLayer(bool force) {
   SetupFrameRate(false);
 
@@ -17,6 +17,7 @@
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
 #include "base/time/time.h"
+#include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "content/browser/renderer_host/delegated_frame_host.h"  // nogncheck
@@ -24,6 +25,7 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_view_base.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_view.h"  // nogncheck
+#include "shell/browser/osr/osr_begin_frame_scheduler.h"
 #include "shell/browser/osr/osr_host_display_client.h"
 #include "shell/browser/osr/osr_video_consumer.h"
 #include "shell/browser/osr/osr_view_proxy.h"
@@ -55,14 +57,19 @@ class ElectronDelegatedFrameHostClient;
 typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
 typedef base::Callback<void(const gfx::Rect&)> OnPopupPaintCallback;
 
-class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
-                                      public ui::CompositorDelegate,
-                                      public OffscreenViewProxyObserver {
+class OffScreenRenderWidgetHostView
+    : public content::RenderWidgetHostViewBase,
+      public ui::CompositorDelegate,
+      public OffscreenViewProxyObserver,
+      public OffScreenBeginFrameScheduler::Client {
  public:
   OffScreenRenderWidgetHostView(bool transparent,
+                                bool external_begin_frames,
+                                bool shared_begin_frames,
                                 bool painting,
                                 int frame_rate,
                                 const OnPaintCallback& callback,
+                                const OnTexturePaintCallback& texture_callback,
                                 content::RenderWidgetHost* render_widget_host,
                                 OffScreenRenderWidgetHostView* parent_host_view,
                                 gfx::Size initial_size);
@@ -163,13 +170,31 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void RemoveViewProxy(OffscreenViewProxy* proxy);
   void ProxyViewDestroyed(OffscreenViewProxy* proxy) override;
 
+  // OffScreenBeginFrameScheduler::Client:
+  void OnBeginFrame(base::TimeTicks frame_time,
+                    base::TimeDelta interval,
+                    base::OnceCallback<void(bool)> callback) override;
+
   void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void PaintBitmap(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnCapturedFrame(const gfx::Rect& damage_rect,
+                       const SkBitmap& bitmap,
+                       const OffScreenFrameTiming& timing);
+  void OnTexturePaint(const gfx::Rect& damage_rect,
+                      OffScreenSharedTexture texture);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
   gfx::Size SizeInPixels();
 
+  void OnBackingChanged(const gfx::Rect& damage_rect);
   void CompositeFrame(const gfx::Rect& damage_rect);
+  // Adds the stages of |frame_timing_| to the trace.
+  void TraceFrameTiming();
+  // Tells the scheduler the rate and visibility of the view.
+  void UpdateBeginFrameScheduler();
+  // Gives a throttled view its full rate again.
+  void WakeBeginFrameScheduler();
 
   bool IsPopupWidget() const {
     return widget_type_ == content::WidgetType::kPopup;
@@ -198,6 +223,12 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void Invalidate();
   void InvalidateBounds(const gfx::Rect&);
 
+  // Starts a new frame when begin frames are issued by the embedder.
+  void IssueBeginFrame();
+
+  // The timing of the frame being painted.
+  const OffScreenFrameTiming& frame_timing() const { return frame_timing_; }
+
   content::RenderWidgetHostImpl* render_widget_host() const {
     return render_widget_host_;
   }
@@ -232,7 +263,19 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   std::set<OffscreenViewProxy*> proxy_views_;
 
   const bool transparent_;
+  // Whether begin frames are issued by IssueBeginFrame() instead of the
+  // OffScreenBeginFrameScheduler.
+  const bool external_begin_frames_;
+  // Whether begin frames are issued by the OffScreenBeginFrameScheduler
+  // instead of the timer of the compositor.
+  const bool shared_begin_frames_;
+  uint64_t begin_frame_number_ = viz::BeginFrameArgs::kStartingFrameNumber;
+  base::TimeTicks last_begin_frame_time_;
+  OffScreenFrameTiming frame_timing_;
+  // Identifies the trace events of each painted frame.
+  uint64_t painted_frame_count_ = 0;
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
   OnPopupPaintCallback parent_callback_;
 
   int frame_rate_ = 0;
@@ -15,7 +15,7 @@ namespace electron {
 
 OffScreenVideoConsumer::OffScreenVideoConsumer(
     OffScreenRenderWidgetHostView* view,
-    OnPaintCallback callback)
+    OnCapturedFrameCallback callback)
     : callback_(callback),
       view_(view),
       video_capturer_(view->CreateVideoCapturer()),
@@ -56,6 +56,7 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
+  base::TimeTicks received = base::TimeTicks::Now();
   if (!CheckContentRect(content_rect)) {
     gfx::Size view_size = view_->SizeInPixels();
     video_capturer_->SetResolutionConstraints(view_size, view_size, true);
@@ -121,7 +122,16 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     damage_rect = content_rect;
   }
 
-  callback_.Run(damage_rect, bitmap);
+  OffScreenFrameTiming timing;
+  timing.received = received;
+  metadata.GetTimeTicks(media::VideoFrameMetadata::REFERENCE_TIME,
+                        &timing.frame_time);
+  metadata.GetTimeTicks(media::VideoFrameMetadata::CAPTURE_BEGIN_TIME,
+                        &timing.capture_begin);
+  metadata.GetTimeTicks(media::VideoFrameMetadata::CAPTURE_END_TIME,
+                        &timing.capture_end);
+
+  callback_.Run(damage_rect, bitmap, timing);
 }
 
 void OffScreenVideoConsumer::OnStopped() {}
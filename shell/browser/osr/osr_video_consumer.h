@@ -9,6 +9,7 @@
 
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 
@@ -19,10 +20,28 @@ class OffScreenRenderWidgetHostView;
 typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
     OnPaintCallback;
 
+// When a frame went through the stages of offscreen rendering. The stages a
+// frame did not go through are null.
+struct OffScreenFrameTiming {
+  // When the begin frame was issued.
+  base::TimeTicks begin_frame;
+  // The display time the compositor drew the frame for.
+  base::TimeTicks frame_time;
+  // When viz started and finished copying the frame out.
+  base::TimeTicks capture_begin;
+  base::TimeTicks capture_end;
+  // When the frame arrived in the browser process.
+  base::TimeTicks received;
+};
+
+typedef base::RepeatingCallback<
+    void(const gfx::Rect&, const SkBitmap&, const OffScreenFrameTiming&)>
+    OnCapturedFrameCallback;
+
 class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
  public:
   OffScreenVideoConsumer(OffScreenRenderWidgetHostView* view,
-                         OnPaintCallback callback);
+                         OnCapturedFrameCallback callback);
   ~OffScreenVideoConsumer() override;
 
   void SetActive(bool active);
@@ -41,7 +60,7 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
 
   bool CheckContentRect(const gfx::Rect& content_rect);
 
-  OnPaintCallback callback_;
+  OnCapturedFrameCallback callback_;
 
   OffScreenRenderWidgetHostView* view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
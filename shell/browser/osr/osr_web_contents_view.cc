@@ -13,8 +13,16 @@ namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
-    const OnPaintCallback& callback)
-    : native_window_(nullptr), transparent_(transparent), callback_(callback) {
+    bool external_begin_frames,
+    bool shared_begin_frames,
+    const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback)
+    : native_window_(nullptr),
+      transparent_(transparent),
+      external_begin_frames_(external_begin_frames),
+      shared_begin_frames_(shared_begin_frames),
+      callback_(callback),
+      texture_callback_(texture_callback) {
 #if defined(OS_MACOSX)
   PlatformCreate();
 #endif
@@ -121,7 +129,8 @@ OffScreenWebContentsView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
+      transparent_, external_begin_frames_, shared_begin_frames_, painting_,
+      GetFrameRate(), callback_, texture_callback_, render_widget_host,
       nullptr, GetSize());
 }
 
@@ -138,9 +147,10 @@ OffScreenWebContentsView::CreateViewForChildWidget(
                     ->GetRenderWidgetHostView()
               : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->GetFrameRate(), callback_,
-                                           render_widget_host, view, GetSize());
+  // Child widgets are composited into the frames of their parent.
+  return new OffScreenRenderWidgetHostView(
+      transparent_, false, false, painting_, view->GetFrameRate(), callback_,
+      OnTexturePaintCallback(), render_widget_host, view, GetSize());
 }
 
 void OffScreenWebContentsView::SetPageTitle(const base::string16& title) {}
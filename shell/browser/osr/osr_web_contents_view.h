@@ -27,7 +27,11 @@ class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView,
                                  public NativeWindowObserver {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  OffScreenWebContentsView(bool transparent,
+                           bool external_begin_frames,
+                           bool shared_begin_frames,
+                           const OnPaintCallback& callback,
+                           const OnTexturePaintCallback& texture_callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -92,9 +96,12 @@ class OffScreenWebContentsView : public content::WebContentsView,
   NativeWindow* native_window_;
 
   const bool transparent_;
+  const bool external_begin_frames_;
+  const bool shared_begin_frames_;
   bool painting_ = true;
   int frame_rate_ = 60;
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
 
   // Weak refs.
   content::WebContents* web_contents_ = nullptr;
@@ -3,12 +3,57 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <utility>
 
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/protocol_registry.h"
 
 namespace electron {
 
+namespace {
+
+// Passes the requests of a frame or navigation to the shared factory of the
+// protocol. It keeps the factory the protocol had when it was created, like
+// the factory of its own it used to get.
+class ProtocolURLLoaderFactory : public network::mojom::URLLoaderFactory {
+ public:
+  using SharedFactory = ProtocolRegistry::SharedFactory;
+
+  explicit ProtocolURLLoaderFactory(scoped_refptr<SharedFactory> factory)
+      : factory_(std::move(factory)) {}
+  ~ProtocolURLLoaderFactory() override = default;
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override {
+    factory_->data->CreateLoaderAndStart(std::move(loader), routing_id,
+                                         request_id, options, request,
+                                         std::move(client), traffic_annotation);
+  }
+
+  void Clone(mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver)
+      override {
+    receivers_.Add(this, std::move(receiver));
+  }
+
+ private:
+  mojo::ReceiverSet<network::mojom::URLLoaderFactory> receivers_;
+
+  scoped_refptr<SharedFactory> factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolURLLoaderFactory);
+};
+
+}  // namespace
+
 // static
 ProtocolRegistry* ProtocolRegistry::FromBrowserContext(
     content::BrowserContext* context) {
@@ -21,24 +66,45 @@ ProtocolRegistry::~ProtocolRegistry() = default;
 
 void ProtocolRegistry::RegisterURLLoaderFactories(
     content::ContentBrowserClient::NonNetworkURLLoaderFactoryMap* factories) {
-  for (const auto& it : handlers_) {
-    factories->emplace(it.first, std::make_unique<ElectronURLLoaderFactory>(
-                                     it.second.first, it.second.second));
+  for (const auto& it : factories_) {
+    factories->emplace(it.first,
+                       std::make_unique<ProtocolURLLoaderFactory>(it.second));
   }
 }
 
 bool ProtocolRegistry::RegisterProtocol(ProtocolType type,
                                         const std::string& scheme,
                                         const ProtocolHandler& handler) {
-  return base::TryEmplace(handlers_, scheme, type, handler).second;
+  if (base::Contains(directory_handlers_, scheme) ||
+      !base::TryEmplace(handlers_, scheme, type, handler).second) {
+    return false;
+  }
+  factories_[scheme] = base::MakeRefCounted<SharedFactory>(
+      std::make_unique<ElectronURLLoaderFactory>(type, handler));
+  return true;
+}
+
+bool ProtocolRegistry::RegisterDirectoryProtocol(
+    const std::string& scheme,
+    const DirectoryProtocol& protocol) {
+  if (base::Contains(handlers_, scheme) ||
+      !base::TryEmplace(directory_handlers_, scheme, protocol).second) {
+    return false;
+  }
+  factories_[scheme] = base::MakeRefCounted<SharedFactory>(
+      std::make_unique<DirectoryURLLoaderFactory>(protocol));
+  return true;
 }
 
 bool ProtocolRegistry::UnregisterProtocol(const std::string& scheme) {
-  return handlers_.erase(scheme) != 0;
+  factories_.erase(scheme);
+  return handlers_.erase(scheme) != 0 ||
+         directory_handlers_.erase(scheme) != 0;
 }
 
 bool ProtocolRegistry::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(directory_handlers_, scheme);
 }
 
 bool ProtocolRegistry::InterceptProtocol(ProtocolType type,
@@ -5,9 +5,13 @@
 #ifndef SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 #define SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
+#include "base/memory/ref_counted.h"
 #include "content/public/browser/content_browser_client.h"
+#include "shell/browser/net/directory_url_loader_factory.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
 
 namespace content {
@@ -18,6 +22,11 @@ namespace electron {
 
 class ProtocolRegistry {
  public:
+  // The factory of a protocol is created once when it is registered, and is
+  // shared by the factories content asks for each frame and navigation.
+  using SharedFactory =
+      base::RefCountedData<std::unique_ptr<network::mojom::URLLoaderFactory>>;
+
   ~ProtocolRegistry();
 
   static ProtocolRegistry* FromBrowserContext(content::BrowserContext*);
@@ -30,6 +39,8 @@ class ProtocolRegistry {
   bool RegisterProtocol(ProtocolType type,
                         const std::string& scheme,
                         const ProtocolHandler& handler);
+  bool RegisterDirectoryProtocol(const std::string& scheme,
+                                 const DirectoryProtocol& protocol);
   bool UnregisterProtocol(const std::string& scheme);
   bool IsProtocolRegistered(const std::string& scheme);
 
@@ -45,7 +56,11 @@ class ProtocolRegistry {
   ProtocolRegistry();
 
   HandlersMap handlers_;
+  DirectoryProtocolsMap directory_handlers_;
   HandlersMap intercept_handlers_;
+
+  // scheme => factory of the registered protocols.
+  std::unordered_map<std::string, scoped_refptr<SharedFactory>> factories_;
 };
 
 }  // namespace electron
@@ -12,6 +12,8 @@
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/process/launch.h"
+#include "base/strings/string_util.h"
+#include "base/threading/platform_thread.h"
 #include "content/public/common/content_paths.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/main_function_params.h"
@@ -31,10 +33,43 @@ const int kRelauncherSyncFD = STDERR_FILENO + 1;
 
 const CharType* kRelauncherTypeArg = FILE_PATH_LITERAL("--type=relauncher");
 const CharType* kRelauncherArgSeparator = FILE_PATH_LITERAL("---");
+const CharType* kRelauncherPrefetchArg = FILE_PATH_LITERAL("--prefetch=");
 
 }  // namespace internal
 
+namespace {
+
+// Prefetching stops at this many bytes per file, larger files are only
+// partly warmed up.
+constexpr int64_t kMaxPrefetchBytes = 512 * 1024 * 1024;
+
+// Reads files into the OS cache on a thread of its own, so that the
+// relauncher keeps waiting for the parent meanwhile. The thread is not
+// joined, it ends with the relauncher process at the latest.
+class PrefetchThread : public base::PlatformThread::Delegate {
+ public:
+  explicit PrefetchThread(std::vector<base::FilePath> paths)
+      : paths_(std::move(paths)) {}
+
+  void ThreadMain() override {
+    base::PlatformThread::SetName("ElectronRelauncherPrefetch");
+    for (const auto& path : paths_)
+      base::PreReadFile(path, false, kMaxPrefetchBytes);
+    delete this;
+  }
+
+ private:
+  std::vector<base::FilePath> paths_;
+};
+
+}  // namespace
+
 bool RelaunchApp(const StringVector& argv) {
+  return RelaunchApp(argv, {});
+}
+
+bool RelaunchApp(const StringVector& argv,
+                 const std::vector<base::FilePath>& prefetch_paths) {
   // Use the currently-running application's helper process. The automatic
   // update feature is careful to leave the currently-running version alone,
   // so this is safe even if the relaunch is the result of an update having
@@ -48,6 +83,8 @@ bool RelaunchApp(const StringVector& argv) {
   }
 
   StringVector relauncher_args;
+  for (const auto& path : prefetch_paths)
+    relauncher_args.push_back(internal::kRelauncherPrefetchArg + path.value());
   return RelaunchAppWithHelper(child_path, relauncher_args, argv);
 }
 
@@ -145,19 +182,22 @@ int RelauncherMain(const content::MainFunctionParams& main_parameters) {
     return 1;
   }
 
-  internal::RelauncherSynchronizeWithParent();
-
   // Figure out what to execute, what arguments to pass it, and whether to
   // start it in the background.
   bool in_relauncher_args = false;
   StringType relaunch_executable;
   StringVector relauncher_args;
   StringVector launch_argv;
+  std::vector<base::FilePath> prefetch_paths;
+  const StringType prefetch_arg(internal::kRelauncherPrefetchArg);
   for (size_t argv_index = 2; argv_index < argv.size(); ++argv_index) {
     const StringType& arg(argv[argv_index]);
     if (!in_relauncher_args) {
       if (arg == internal::kRelauncherArgSeparator) {
         in_relauncher_args = true;
+      } else if (base::StartsWith(arg, prefetch_arg,
+                                  base::CompareCase::SENSITIVE)) {
+        prefetch_paths.emplace_back(arg.substr(prefetch_arg.size()));
       } else {
         relauncher_args.push_back(arg);
       }
@@ -166,6 +206,14 @@ int RelauncherMain(const content::MainFunctionParams& main_parameters) {
     }
   }
 
+  if (!prefetch_paths.empty()) {
+    auto* prefetch_thread = new PrefetchThread(std::move(prefetch_paths));
+    if (!base::PlatformThread::CreateNonJoinable(0, prefetch_thread))
+      delete prefetch_thread;
+  }
+
+  internal::RelauncherSynchronizeWithParent();
+
   if (launch_argv.empty()) {
     LOG(ERROR) << "nothing to relaunch";
     return 1;
@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/files/file_path.h"
 
 #if defined(OS_WIN)
 #include "base/process/process_handle.h"
@@ -61,6 +62,12 @@ using StringVector = base::CommandLine::StringVector;
 // relauncher process. Returns false when the relaunch definitely failed.
 bool RelaunchApp(const StringVector& argv);
 
+// Like RelaunchApp, but the relauncher process also reads |prefetch_paths|
+// into the OS file cache while the parent exits, so that the relaunched
+// process finds them warm.
+bool RelaunchApp(const StringVector& argv,
+                 const std::vector<base::FilePath>& prefetch_paths);
+
 // Identical to RelaunchApp, but uses |helper| as the path to the relauncher
 // process, and allows additional arguments to be supplied to the relauncher
 // process in relauncher_args. Unlike args[0], |helper| must be a pathname to
@@ -98,6 +105,10 @@ extern const CharType* kRelauncherTypeArg;
 // reporting.
 extern const CharType* kRelauncherArgSeparator;
 
+// The prefix of the relauncher arguments naming a file to prefetch
+// ("--prefetch=").
+extern const CharType* kRelauncherPrefetchArg;
+
 #if defined(OS_WIN)
 StringType GetWaitEventName(base::ProcessId pid);
 
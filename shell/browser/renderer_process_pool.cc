@@ -0,0 +1,88 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/renderer_process_pool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "content/public/browser/site_instance.h"
+
+namespace electron {
+
+RendererProcessPool::Entry::Entry(
+    const GURL& site,
+    const base::CommandLine::StringVector& argv,
+    scoped_refptr<content::SiteInstance> site_instance)
+    : site(site), argv(argv), site_instance(std::move(site_instance)) {}
+
+RendererProcessPool::Entry::Entry(Entry&&) = default;
+
+RendererProcessPool::Entry::~Entry() = default;
+
+RendererProcessPool::RendererProcessPool(
+    content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+RendererProcessPool::~RendererProcessPool() = default;
+
+void RendererProcessPool::SetLimits(size_t max_processes_per_site,
+                                    size_t max_processes) {
+  max_processes_per_site_ = max_processes_per_site;
+  max_processes_ = max_processes;
+  if (!enabled())
+    entries_.clear();
+  Trim();
+}
+
+content::SiteInstance* RendererProcessPool::Get(
+    const GURL& url,
+    const base::CommandLine& switches) {
+  if (!enabled())
+    return nullptr;
+
+  RemoveUnusedEntries();
+
+  GURL site = content::SiteInstance::GetSiteForURL(browser_context_, url);
+  size_t count = 0;
+  auto least_recently_used = entries_.end();
+  for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+    if (iter->site == site && iter->argv == switches.argv()) {
+      ++count;
+      least_recently_used = iter;
+    }
+  }
+
+  if (count < max_processes_per_site_) {
+    entries_.emplace_front(site, switches.argv(),
+                           content::SiteInstance::CreateForURL(
+                               browser_context_, url));
+    Trim();
+  } else {
+    entries_.splice(entries_.begin(), entries_, least_recently_used);
+  }
+  return entries_.front().site_instance.get();
+}
+
+bool RendererProcessPool::Contains(content::SiteInstance* site_instance) const {
+  return std::any_of(entries_.begin(), entries_.end(),
+                     [site_instance](const Entry& entry) {
+                       return entry.site_instance.get() == site_instance;
+                     });
+}
+
+void RendererProcessPool::RemoveUnusedEntries() {
+  // Site instances that are only used by the pool belong to windows that were
+  // closed, or to navigations that did not happen.
+  entries_.remove_if(
+      [](const Entry& entry) { return entry.site_instance->HasOneRef(); });
+}
+
+void RendererProcessPool::Trim() {
+  if (max_processes_ > 0 && entries_.size() > max_processes_)
+    entries_.erase(std::next(entries_.begin(), max_processes_), entries_.end());
+}
+
+}  // namespace electron
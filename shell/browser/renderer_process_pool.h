@@ -0,0 +1,82 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
+#define SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
+
+#include <list>
+
+#include "base/command_line.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "url/gurl.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+}  // namespace content
+
+namespace electron {
+
+// Renderer processes shared by the windows of a session that show the same
+// site.
+//
+// Electron starts a new renderer for the main frame of every window, so apps
+// with many windows of the same site get as many processes. The pool spreads
+// the windows of a site over a limited number of renderers instead, and only
+// shares a renderer between windows whose renderer would get the same command
+// line, so that process level preferences like nodeIntegration still hold.
+class RendererProcessPool {
+ public:
+  explicit RendererProcessPool(content::BrowserContext* browser_context);
+  ~RendererProcessPool();
+
+  // Sets the number of renderers the windows of a site are spread over, 0
+  // disables the pool, and the number of renderers the pool keeps for all
+  // sites, 0 for no limit. The least recently used ones are forgotten past the
+  // limit, and exit once their windows are closed.
+  void SetLimits(size_t max_processes_per_site, size_t max_processes);
+  size_t max_processes_per_site() const { return max_processes_per_site_; }
+  size_t max_processes() const { return max_processes_; }
+  bool enabled() const { return max_processes_per_site_ > 0; }
+
+  // Returns the site instance to use for a window navigating to |url| whose
+  // renderer would be launched with |switches|. It is a new one when the site
+  // has fewer renderers than allowed, otherwise the least recently used one.
+  content::SiteInstance* Get(const GURL& url,
+                             const base::CommandLine& switches);
+
+  // Whether |site_instance| was handed out by the pool.
+  bool Contains(content::SiteInstance* site_instance) const;
+
+ private:
+  struct Entry {
+    Entry(const GURL& site,
+          const base::CommandLine::StringVector& argv,
+          scoped_refptr<content::SiteInstance> site_instance);
+    Entry(Entry&&);
+    ~Entry();
+
+    GURL site;
+    base::CommandLine::StringVector argv;
+    scoped_refptr<content::SiteInstance> site_instance;
+  };
+
+  void RemoveUnusedEntries();
+  void Trim();
+
+  content::BrowserContext* browser_context_;
+
+  size_t max_processes_per_site_ = 0;
+  size_t max_processes_ = 0;
+
+  // Most recently used first.
+  std::list<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererProcessPool);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_renderer_pool.h"
+
+#include <utility>
+
+#include "base/stl_util.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "shell/browser/electron_browser_client.h"
+
+namespace electron {
+
+namespace {
+
+bool IsUsable(content::SiteInstance* site_instance) {
+  // A spare can die, or be given to another site instance when Chromium
+  // reuses processes past the renderer limit.
+  auto* process = site_instance->GetProcess();
+  return process->IsInitializedAndNotDead() && process->IsUnused();
+}
+
+}  // namespace
+
+SpareRendererPool::SpareRendererPool(content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+SpareRendererPool::~SpareRendererPool() = default;
+
+void SpareRendererPool::SetSize(size_t size) {
+  size_ = size;
+  if (spares_.size() > size_)
+    spares_.resize(size_);
+}
+
+content::SiteInstance* SpareRendererPool::Take(
+    const base::CommandLine& switches) {
+  taken_ = nullptr;
+  if (switches.argv() != switches_.argv())
+    return nullptr;
+
+  while (!spares_.empty()) {
+    scoped_refptr<content::SiteInstance> site_instance =
+        std::move(spares_.front());
+    spares_.erase(spares_.begin());
+    if (IsUsable(site_instance.get())) {
+      taken_ = std::move(site_instance);
+      break;
+    }
+  }
+  return taken_.get();
+}
+
+void SpareRendererPool::Fill(content::WebContents* web_contents,
+                             const base::CommandLine& switches) {
+  if (switches.argv() != switches_.argv()) {
+    spares_.clear();
+    switches_ = switches;
+  }
+
+  base::EraseIf(spares_, [](const auto& site_instance) {
+    return !IsUsable(site_instance.get());
+  });
+
+  while (spares_.size() < size_) {
+    scoped_refptr<content::SiteInstance> site_instance =
+        content::SiteInstance::Create(browser_context_);
+    auto* process = site_instance->GetProcess();
+    // Past the renderer limit the site instance gets an existing process.
+    if (process->IsInitializedAndNotDead())
+      break;
+    ElectronBrowserClient::Get()->InitSpareRenderer(process, web_contents);
+    spares_.push_back(std::move(site_instance));
+  }
+}
+
+}  // namespace electron
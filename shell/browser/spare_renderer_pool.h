@@ -0,0 +1,66 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+#define SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+class WebContents;
+}  // namespace content
+
+namespace electron {
+
+// Renderer processes launched ahead of time for the windows of a session.
+//
+// Electron starts a new renderer for the first navigation of every window, so
+// opening a window waits for a process to launch and initialize. The pool
+// keeps renderers launched with the command line of the last window that
+// navigated, and hands them to the next windows whose renderer would get the
+// same command line.
+class SpareRendererPool {
+ public:
+  explicit SpareRendererPool(content::BrowserContext* browser_context);
+  ~SpareRendererPool();
+
+  // Sets the number of spare renderers to keep, 0 disables the pool.
+  void SetSize(size_t size);
+  size_t size() const { return size_; }
+
+  // Returns the site instance of a spare renderer launched with |switches|, or
+  // nullptr. The pool keeps a reference until the next call, so the caller can
+  // hand out the raw pointer.
+  content::SiteInstance* Take(const base::CommandLine& switches);
+
+  // Launches spare renderers for |web_contents| until the pool is full. Spares
+  // that were launched with other switches are dropped.
+  void Fill(content::WebContents* web_contents,
+            const base::CommandLine& switches);
+
+ private:
+  content::BrowserContext* browser_context_;
+
+  size_t size_ = 0;
+
+  // The switches the spares were launched with.
+  base::CommandLine switches_{base::CommandLine::NO_PROGRAM};
+
+  std::vector<scoped_refptr<content::SiteInstance>> spares_;
+
+  // The spare returned by the last call to Take().
+  scoped_refptr<content::SiteInstance> taken_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererPool);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_SPARE_RENDERER_POOL_H_
@@ -0,0 +1,95 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/storage_data_clearer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "shell/browser/electron_browser_context.h"
+
+namespace electron {
+
+StorageDataClearer::Options::Options() = default;
+StorageDataClearer::Options::Options(const Options&) = default;
+StorageDataClearer::Options::~Options() = default;
+
+// static
+void StorageDataClearer::Start(ElectronBrowserContext* browser_context,
+                               Options options,
+                               base::OnceClosure callback) {
+  auto* clearer = new StorageDataClearer(browser_context, std::move(options),
+                                         std::move(callback));
+  clearer->RunNextStep();
+}
+
+StorageDataClearer::StorageDataClearer(ElectronBrowserContext* browser_context,
+                                       Options options,
+                                       base::OnceClosure callback)
+    : browser_context_(browser_context->GetWeakPtr()),
+      options_(std::move(options)),
+      callback_(std::move(callback)) {
+  std::vector<GURL> origins = options_.origins;
+  if (origins.empty())
+    origins.emplace_back();
+  for (const auto& origin : origins) {
+    if (!options_.incremental) {
+      steps_.push_back({origin, options_.storage_types});
+      continue;
+    }
+    for (uint32_t type = 1; type && type <= options_.storage_types;
+         type <<= 1) {
+      if (options_.storage_types & type)
+        steps_.push_back({origin, type});
+    }
+  }
+}
+
+StorageDataClearer::~StorageDataClearer() = default;
+
+void StorageDataClearer::RunNextStep() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!browser_context_) {
+    delete this;
+    return;
+  }
+  if (next_step_ == steps_.size()) {
+    std::move(callback_).Run();
+    delete this;
+    return;
+  }
+
+  const Step& step = steps_[next_step_];
+  content::BrowserContext::GetDefaultStoragePartition(browser_context_.get())
+      ->ClearData(step.storage_types, options_.quota_types, step.origin,
+                  options_.since, base::Time::Max(),
+                  base::BindOnce(&StorageDataClearer::OnStepDone,
+                                 weak_factory_.GetWeakPtr()));
+}
+
+void StorageDataClearer::OnStepDone() {
+  if (!browser_context_) {
+    delete this;
+    return;
+  }
+  ++next_step_;
+  if (options_.progress)
+    options_.progress.Run(next_step_, steps_.size());
+
+  if (!options_.incremental || next_step_ == steps_.size()) {
+    RunNextStep();
+    return;
+  }
+  base::PostTask(FROM_HERE,
+                 {content::BrowserThread::UI, base::TaskPriority::BEST_EFFORT},
+                 base::BindOnce(&StorageDataClearer::RunNextStep,
+                                weak_factory_.GetWeakPtr()));
+}
+
+}  // namespace electron
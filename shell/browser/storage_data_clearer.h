@@ -0,0 +1,79 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_STORAGE_DATA_CLEARER_H_
+#define SHELL_BROWSER_STORAGE_DATA_CLEARER_H_
+
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Clears the storage data of a browser context in steps, one storage type of
+// one origin at a time, so that the storage partition is not busy with a
+// single long clear. In incremental mode the next step is only started by a
+// background priority task, letting the pages use their storage in between.
+// It deletes itself once done.
+class StorageDataClearer {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    // Empty to clear the data of all origins.
+    std::vector<GURL> origins;
+    uint32_t storage_types;
+    uint32_t quota_types;
+    // Only the data modified since then is cleared.
+    base::Time since;
+    // Clears each storage type separately, with background priority tasks
+    // in between.
+    bool incremental = false;
+    // Run after each step with the steps done and the total of steps.
+    base::RepeatingCallback<void(int, int)> progress;
+  };
+
+  // Starts clearing, |callback| is run once everything is cleared, or not at
+  // all if the browser context goes away first.
+  static void Start(ElectronBrowserContext* browser_context,
+                    Options options,
+                    base::OnceClosure callback);
+
+ private:
+  struct Step {
+    GURL origin;
+    uint32_t storage_types;
+  };
+
+  StorageDataClearer(ElectronBrowserContext* browser_context,
+                     Options options,
+                     base::OnceClosure callback);
+  ~StorageDataClearer();
+
+  void RunNextStep();
+  void OnStepDone();
+
+  base::WeakPtr<ElectronBrowserContext> browser_context_;
+  Options options_;
+  base::OnceClosure callback_;
+
+  std::vector<Step> steps_;
+  size_t next_step_ = 0;
+
+  base::WeakPtrFactory<StorageDataClearer> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(StorageDataClearer);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_STORAGE_DATA_CLEARER_H_
@@ -0,0 +1,91 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/system_snapshot_publisher.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/post_task.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "shell/browser/api/electron_api_native_theme.h"
+#include "shell/browser/api/electron_api_system_preferences.h"
+#include "shell/common/system_snapshot.h"
+#include "ui/native_theme/native_theme.h"
+
+#if defined(OS_WIN)
+#include "ui/gfx/win/singleton_hwnd_observer.h"
+#endif
+
+namespace electron {
+
+// static
+SystemSnapshotPublisher* SystemSnapshotPublisher::GetInstance() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<SystemSnapshotPublisher> instance;
+  return instance.get();
+}
+
+SystemSnapshotPublisher::SystemSnapshotPublisher()
+    : region_(base::ReadOnlySharedMemoryRegion::Create(
+          sizeof(SystemSnapshotData))) {
+  CHECK(region_.IsValid());
+  new (region_.mapping.memory()) SystemSnapshotData();
+  Update();
+  ui::NativeTheme::GetInstanceForNativeUi()->AddObserver(this);
+#if defined(OS_WIN)
+  hwnd_observer_ = std::make_unique<gfx::SingletonHwndObserver>(
+      base::BindRepeating(&SystemSnapshotPublisher::OnWndProc,
+                          base::Unretained(this)));
+#endif
+}
+
+SystemSnapshotPublisher::~SystemSnapshotPublisher() {
+  ui::NativeTheme::GetInstanceForNativeUi()->RemoveObserver(this);
+}
+
+base::ReadOnlySharedMemoryRegion SystemSnapshotPublisher::DuplicateRegion()
+    const {
+  return region_.region.Duplicate();
+}
+
+void SystemSnapshotPublisher::Update() {
+  ui::NativeTheme* theme = ui::NativeTheme::GetInstanceForNativeUi();
+  SystemSnapshotValues values;
+  if (theme->ShouldUseDarkColors())
+    values.flags |= SystemSnapshotValues::kShouldUseDarkColors;
+  if (theme->UsesHighContrastColors())
+    values.flags |= SystemSnapshotValues::kShouldUseHighContrastColors;
+  if (api::NativeTheme::IsInvertedColorScheme())
+    values.flags |= SystemSnapshotValues::kShouldUseInvertedColorScheme;
+  values.theme_source = static_cast<uint32_t>(theme->theme_source());
+#if defined(OS_WIN) || defined(OS_MACOSX)
+  std::string accent_color = api::SystemPreferences::GetAccentColor();
+  if (base::HexStringToUInt(accent_color, &values.accent_color))
+    values.flags |= SystemSnapshotValues::kHasAccentColor;
+#endif
+  WriteSystemSnapshot(region_.mapping.GetMemoryAs<SystemSnapshotData>(),
+                      values);
+}
+
+void SystemSnapshotPublisher::OnNativeThemeUpdated(ui::NativeTheme* theme) {
+  // Like api::NativeTheme, the theme can notify from other threads.
+  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                 base::BindOnce(&SystemSnapshotPublisher::Update,
+                                base::Unretained(this)));
+}
+
+#if defined(OS_WIN)
+void SystemSnapshotPublisher::OnWndProc(HWND hwnd,
+                                        UINT message,
+                                        WPARAM wparam,
+                                        LPARAM lparam) {
+  if (message == WM_DWMCOLORIZATIONCOLORCHANGED)
+    Update();
+}
+#endif
+
+}  // namespace electron
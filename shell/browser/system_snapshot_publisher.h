@@ -0,0 +1,63 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_SYSTEM_SNAPSHOT_PUBLISHER_H_
+#define SHELL_BROWSER_SYSTEM_SNAPSHOT_PUBLISHER_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/no_destructor.h"
+#include "build/build_config.h"
+#include "ui/native_theme/native_theme_observer.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#endif
+
+namespace gfx {
+class SingletonHwndObserver;
+}
+
+namespace electron {
+
+struct SystemSnapshotData;
+
+// Keeps the shared memory snapshot of the theme and system preferences up to
+// date, renderers map it read-only and read the values without IPC.
+class SystemSnapshotPublisher : public ui::NativeThemeObserver {
+ public:
+  static SystemSnapshotPublisher* GetInstance();
+
+  // Returns a read-only handle to the snapshot to send to a renderer.
+  base::ReadOnlySharedMemoryRegion DuplicateRegion() const;
+
+  // Writes the current values to the snapshot.
+  void Update();
+
+ private:
+  friend class base::NoDestructor<SystemSnapshotPublisher>;
+
+  SystemSnapshotPublisher();
+  ~SystemSnapshotPublisher() override;
+
+  // ui::NativeThemeObserver:
+  void OnNativeThemeUpdated(ui::NativeTheme* theme) override;
+
+#if defined(OS_WIN)
+  void OnWndProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam);
+
+  // Notifies of the accent color changes, which the theme does not follow.
+  std::unique_ptr<gfx::SingletonHwndObserver> hwnd_observer_;
+#endif
+
+  base::MappedReadOnlyRegion region_;
+
+  DISALLOW_COPY_AND_ASSIGN(SystemSnapshotPublisher);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_SYSTEM_SNAPSHOT_PUBLISHER_H_
@@ -6,9 +6,11 @@
 
 #include <stdio.h>
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
@@ -17,8 +19,20 @@
 
 namespace accelerator_util {
 
-bool StringToAccelerator(const std::string& shortcut,
-                         ui::Accelerator* accelerator) {
+namespace {
+
+// Apps pass the same few descriptions over and over, to register, check and
+// unregister shortcuts and to build menus, so the parsed ones are kept. Only
+// used on the UI thread.
+constexpr size_t kMaxCachedAccelerators = 1024;
+
+std::map<std::string, ui::Accelerator>& GetAcceleratorCache() {
+  static base::NoDestructor<std::map<std::string, ui::Accelerator>> cache;
+  return *cache;
+}
+
+bool ParseAccelerator(const std::string& shortcut,
+                      ui::Accelerator* accelerator) {
   if (!base::IsStringASCII(shortcut)) {
     LOG(ERROR) << "The accelerator string can only contain ASCII characters";
     return false;
@@ -67,6 +81,26 @@ bool StringToAccelerator(const std::string& shortcut,
   return true;
 }
 
+}  // namespace
+
+bool StringToAccelerator(const std::string& shortcut,
+                         ui::Accelerator* accelerator) {
+  auto& cache = GetAcceleratorCache();
+  auto it = cache.find(shortcut);
+  if (it != cache.end()) {
+    *accelerator = it->second;
+    return true;
+  }
+
+  // Invalid descriptions are not cached, so that they keep being reported.
+  if (!ParseAccelerator(shortcut, accelerator))
+    return false;
+  if (cache.size() >= kMaxCachedAccelerators)
+    cache.clear();
+  cache.emplace(shortcut, *accelerator);
+  return true;
+}
+
 void GenerateAcceleratorTable(AcceleratorTable* table,
                               electron::ElectronMenuModel* model) {
   int count = model->GetItemCount();
@@ -0,0 +1,28 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ui/accelerator_util.h"
+
+#include "base/stl_util.h"
+#include "shell/common/perf_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace accelerator_util {
+
+TEST(AcceleratorUtilPerfTest, StringToAccelerator) {
+  const char* descriptions[] = {
+      "CommandOrControl+Shift+Z", "Alt+F4", "Ctrl+Space",
+      "Super+Esc",                "F12",    "CmdOrCtrl+Plus",
+  };
+  size_t n = 0;
+  auto parse = [&]() {
+    ui::Accelerator accelerator;
+    ASSERT_TRUE(StringToAccelerator(
+        descriptions[n++ % base::size(descriptions)], &accelerator));
+  };
+  electron::MeasureRunsPerSecond("accelerator_util", "string_to_accelerator",
+                                 parse);
+}
+
+}  // namespace accelerator_util
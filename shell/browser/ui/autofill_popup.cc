@@ -107,12 +107,30 @@ void AutofillPopup::SetItems(const std::vector<base::string16>& values,
   DCHECK(view_);
   values_ = values;
   labels_ = labels;
+  first_visible_line_ = 0;
+  content_width_ = 0;
+  MeasureRows(0);
   UpdatePopupBounds();
   view_->OnSuggestionsChanged();
   if (view_)  // could be hidden after the change
     view_->DoUpdateBoundsAndRedrawPopup();
 }
 
+void AutofillPopup::AppendItems(const std::vector<base::string16>& values,
+                                const std::vector<base::string16>& labels) {
+  // The popup could have been hidden while the suggestions were on their way.
+  if (!view_)
+    return;
+  size_t first_row = values_.size();
+  values_.insert(values_.end(), values.begin(), values.end());
+  labels_.insert(labels_.end(), labels.begin(), labels.end());
+  MeasureRows(first_row);
+  UpdatePopupBounds();
+  view_->OnSuggestionsChanged();
+  if (view_)
+    view_->DoUpdateBoundsAndRedrawPopup();
+}
+
 void AutofillPopup::AcceptSuggestion(int index) {
   mojo::AssociatedRemote<mojom::ElectronAutofillAgent> autofill_agent;
   frame_host_->GetRemoteAssociatedInterfaces()->GetInterface(&autofill_agent);
@@ -131,6 +149,8 @@ void AutofillPopup::UpdatePopupBounds() {
   popup_bounds_ = popup_view_common.CalculatePopupBounds(
       GetDesiredPopupWidth(), GetDesiredPopupHeight(), bounds,
       gfx::NativeView(), base::i18n::IsRTL());
+  // The number of rows that fit could have changed.
+  SetFirstVisibleLine(first_visible_line_);
 }
 
 gfx::Rect AutofillPopup::popup_bounds_in_view() {
@@ -142,6 +162,7 @@ gfx::Rect AutofillPopup::popup_bounds_in_view() {
 
 void AutofillPopup::OnViewBoundsChanged(views::View* view) {
   UpdatePopupBounds();
+  view_->CreateChildViews();
   view_->DoUpdateBoundsAndRedrawPopup();
 }
 
@@ -150,13 +171,16 @@ void AutofillPopup::OnViewIsDeleting(views::View* view) {
 }
 
 int AutofillPopup::GetDesiredPopupHeight() {
-  return 2 * kPopupBorderThickness + values_.size() * kRowHeight;
+  int rows = std::min(GetLineCount(), kMaxVisibleRows);
+  return 2 * kPopupBorderThickness + rows * kRowHeight;
 }
 
 int AutofillPopup::GetDesiredPopupWidth() {
-  int popup_width = element_bounds_.width();
+  return std::max(element_bounds_.width(), content_width_);
+}
 
-  for (size_t i = 0; i < values_.size(); ++i) {
+void AutofillPopup::MeasureRows(size_t first_row) {
+  for (size_t i = first_row; i < values_.size(); ++i) {
     int row_size =
         kEndPadding + 2 * kPopupBorderThickness +
         gfx::GetStringWidth(GetValueAt(i), GetValueFontListForRow(i)) +
@@ -164,14 +188,13 @@ int AutofillPopup::GetDesiredPopupWidth() {
     if (GetLabelAt(i).length() > 0)
       row_size += kNamePadding + kEndPadding;
 
-    popup_width = std::max(popup_width, row_size);
+    content_width_ = std::max(content_width_, row_size);
   }
-
-  return popup_width;
 }
 
 gfx::Rect AutofillPopup::GetRowBounds(int index) {
-  int top = kPopupBorderThickness + index * kRowHeight;
+  int top =
+      kPopupBorderThickness + (index - first_visible_line_) * kRowHeight;
 
   return gfx::Rect(kPopupBorderThickness, top,
                    popup_bounds_.width() - 2 * kPopupBorderThickness,
@@ -206,16 +229,32 @@ base::string16 AutofillPopup::GetLabelAt(int i) {
 }
 
 int AutofillPopup::LineFromY(int y) const {
-  int current_height = kPopupBorderThickness;
+  int line = first_visible_line_ +
+             std::max(0, y - kPopupBorderThickness - 1) / kRowHeight;
+  return std::min(line, static_cast<int>(values_.size()) - 1);
+}
 
-  for (size_t i = 0; i < values_.size(); ++i) {
-    current_height += kRowHeight;
+int AutofillPopup::GetVisibleLineCount() const {
+  return std::max(
+      1, (popup_bounds_.height() - 2 * kPopupBorderThickness) / kRowHeight);
+}
 
-    if (y <= current_height)
-      return i;
-  }
+bool AutofillPopup::SetFirstVisibleLine(int line) {
+  int last_first_line = std::max(0, GetLineCount() - GetVisibleLineCount());
+  line = std::max(0, std::min(line, last_first_line));
+  if (line == first_visible_line_)
+    return false;
+  first_visible_line_ = line;
+  return true;
+}
 
-  return values_.size() - 1;
+bool AutofillPopup::ScrollToLine(int line) {
+  if (line < first_visible_line_)
+    return SetFirstVisibleLine(line);
+  int visible_line_count = GetVisibleLineCount();
+  if (line >= first_visible_line_ + visible_line_count)
+    return SetFirstVisibleLine(line - visible_line_count + 1);
+  return false;
 }
 
 }  // namespace electron
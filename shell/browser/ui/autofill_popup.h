@@ -32,6 +32,9 @@ class AutofillPopup : public views::ViewObserver {
 
   void SetItems(const std::vector<base::string16>& values,
                 const std::vector<base::string16>& labels);
+  // Adds suggestions after the ones already shown.
+  void AppendItems(const std::vector<base::string16>& values,
+                   const std::vector<base::string16>& labels);
   void UpdatePopupBounds();
 
   gfx::Rect popup_bounds_in_view();
@@ -47,6 +50,8 @@ class AutofillPopup : public views::ViewObserver {
 
   int GetDesiredPopupHeight();
   int GetDesiredPopupWidth();
+  // Measures the rows from |first_row| on into |content_width_|.
+  void MeasureRows(size_t first_row);
   gfx::Rect GetRowBounds(int i);
   const gfx::FontList& GetValueFontListForRow(int index) const;
   const gfx::FontList& GetLabelFontListForRow(int index) const;
@@ -57,6 +62,13 @@ class AutofillPopup : public views::ViewObserver {
   base::string16 GetLabelAt(int i);
   int LineFromY(int y) const;
 
+  // The rows that fit in the popup, starting at the first visible one.
+  int GetFirstVisibleLine() const { return first_visible_line_; }
+  int GetVisibleLineCount() const;
+  // Both return whether the visible rows changed.
+  bool SetFirstVisibleLine(int line);
+  bool ScrollToLine(int line);
+
   int selected_index_;
 
   // Popup location
@@ -69,6 +81,12 @@ class AutofillPopup : public views::ViewObserver {
   std::vector<base::string16> values_;
   std::vector<base::string16> labels_;
 
+  // Index of the suggestion shown in the first row.
+  int first_visible_line_ = 0;
+
+  // Width of the widest suggestion.
+  int content_width_ = 0;
+
   // Font lists for the suggestions
   gfx::FontList smaller_font_list_;
   gfx::FontList bold_font_list_;
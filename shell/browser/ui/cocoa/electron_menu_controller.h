@@ -29,6 +29,8 @@ class ElectronMenuModel;
   BOOL isMenuOpen_;
   BOOL useDefaultAccelerator_;
   base::OnceClosure closeCallback;
+  // Controllers of the lazy submenus, which build their items when opened.
+  base::scoped_nsobject<NSMutableArray> lazyControllers_;
 }
 
 @property(nonatomic, assign) electron::ElectronMenuModel* model;
@@ -43,6 +45,12 @@ class ElectronMenuModel;
 // Populate current NSMenu with |model|.
 - (void)populateWithModel:(electron::ElectronMenuModel*)model;
 
+// Updates the title and tooltip of the item built from the item at |index| of
+// |model|, which is the model of the menu or of one of its submenus, without
+// building the menu again.
+- (void)refreshItemAtIndex:(int)index
+                   ofModel:(electron::ElectronMenuModel*)model;
+
 // Programmatically close the constructed menu.
 - (void)cancel;
 
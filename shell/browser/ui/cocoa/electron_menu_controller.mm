@@ -87,6 +87,11 @@ NSMenu* MakeEmptySubmenu() {
 
 }  // namespace
 
+// A controller for a lazy submenu, which only builds its items when it opens,
+// once its model had a chance to fill them in.
+@interface ElectronLazyMenuController : ElectronMenuController
+@end
+
 // Menu item is located for ease of removing it from the parent owner
 static base::scoped_nsobject<NSMenuItem> recentDocumentsMenuItem_;
 
@@ -139,6 +144,7 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
 
   model_ = model;
   [menu_ removeAllItems];
+  [lazyControllers_ removeAllObjects];
 
   const int count = model->GetItemCount();
   for (int index = 0; index < count; index++) {
@@ -149,6 +155,39 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
   }
 }
 
+- (void)refreshItemAtIndex:(int)index
+                   ofModel:(electron::ElectronMenuModel*)model {
+  NSMenuItem* item = [self findItemAtIndex:index ofModel:model inMenu:menu_];
+  if (!item)
+    return;
+
+  NSString* label = l10n_util::FixUpWindowsStyleLabel(model->GetLabelAt(index));
+  [item setTitle:label];
+  if ([item submenu])
+    [[item submenu] setTitle:label];
+  [item setToolTip:base::SysUTF16ToNSString(model->GetToolTipAt(index))];
+}
+
+// Returns the item of |menu| or of its submenus that was built from the item at
+// |index| of |model|.
+- (NSMenuItem*)findItemAtIndex:(int)index
+                       ofModel:(electron::ElectronMenuModel*)model
+                        inMenu:(NSMenu*)menu {
+  for (NSMenuItem* item in [menu itemArray]) {
+    if ([item tag] == index &&
+        [[item representedObject] pointerValue] == model)
+      return item;
+    if ([item submenu]) {
+      NSMenuItem* found = [self findItemAtIndex:index
+                                        ofModel:model
+                                         inMenu:[item submenu]];
+      if (found)
+        return found;
+    }
+  }
+  return nil;
+}
+
 - (void)cancel {
   if (isMenuOpen_) {
     [menu_ cancelTracking];
@@ -243,6 +282,14 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
   base::string16 toolTip = model->GetToolTipAt(index);
   [item setToolTip:base::SysUTF16ToNSString(toolTip)];
 
+  // The MenuModel works on indexes so we can't just set the command id as the
+  // tag like we do in other menus. Also set the represented object to be
+  // the model so hierarchical menus check the correct index in the correct
+  // model, and so that the item can be found when it is updated.
+  [item setTag:index];
+  NSValue* modelObject = [NSValue valueWithPointer:model];
+  [item setRepresentedObject:modelObject];  // Retains |modelObject|.
+
   base::string16 role = model->GetRoleAt(index);
   electron::ElectronMenuModel::ItemType type = model->GetTypeAt(index);
 
@@ -268,9 +315,21 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
     electron::ElectronMenuModel* submenuModel =
         static_cast<electron::ElectronMenuModel*>(
             model->GetSubmenuModelAt(index));
-    NSMenu* submenu = MenuHasVisibleItems(submenuModel)
-                          ? [self menuFromModel:submenuModel]
-                          : MakeEmptySubmenu();
+    NSMenu* submenu;
+    if (submenuModel->lazy()) {
+      base::scoped_nsobject<ElectronLazyMenuController> controller(
+          [[ElectronLazyMenuController alloc]
+                     initWithModel:submenuModel
+             useDefaultAccelerator:useDefaultAccelerator_]);
+      if (!lazyControllers_)
+        lazyControllers_.reset([[NSMutableArray alloc] init]);
+      [lazyControllers_ addObject:controller];
+      submenu = [controller menu];
+    } else {
+      submenu = MenuHasVisibleItems(submenuModel)
+                    ? [self menuFromModel:submenuModel]
+                    : MakeEmptySubmenu();
+    }
     [submenu setTitle:[item title]];
     [item setSubmenu:submenu];
 
@@ -284,14 +343,6 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
     else if (role == base::ASCIIToUTF16("recentdocuments"))
       [self replaceSubmenuShowingRecentDocuments:item];
   } else {
-    // The MenuModel works on indexes so we can't just set the command id as the
-    // tag like we do in other menus. Also set the represented object to be
-    // the model so hierarchical menus check the correct index in the correct
-    // model. Setting the target to |self| allows this class to participate
-    // in validation of the menu items.
-    [item setTag:index];
-    NSValue* modelObject = [NSValue valueWithPointer:model];
-    [item setRepresentedObject:modelObject];  // Retains |modelObject|.
     ui::Accelerator accelerator;
     if (model->GetAcceleratorAtWithParams(index, useDefaultAccelerator_,
                                           &accelerator)) {
@@ -308,7 +359,8 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
           setAllowsKeyEquivalentWhenHidden:(model->WorksWhenHiddenAt(index))];
     }
 
-    // Set menu item's role.
+    // Set menu item's role. Setting the target to |self| allows this class to
+    // participate in validation of the menu items.
     [item setTarget:self];
     if (!role.empty()) {
       for (const Role& pair : kRolesMap) {
@@ -396,3 +448,41 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
 }
 
 @end
+
+@implementation ElectronLazyMenuController
+
+- (NSMenu*)menu {
+  if (!menu_) {
+    // Filled in by menuNeedsUpdate:.
+    menu_.reset([MakeEmptySubmenu() retain]);
+    [menu_ setDelegate:self];
+  }
+  return menu_.get();
+}
+
+- (void)menuNeedsUpdate:(NSMenu*)menu {
+  model_->MenuWillShow();
+  [self populateWithModel:model_];
+  if (!MenuHasVisibleItems(model_)) {
+    NSString* title = l10n_util::GetNSString(IDS_APP_MENU_EMPTY_SUBMENU);
+    NSMenuItem* item = [menu_ addItemWithTitle:title
+                                        action:NULL
+                                 keyEquivalent:@""];
+    [item setEnabled:NO];
+  }
+}
+
+- (void)menuWillOpen:(NSMenu*)menu {
+  // The model was told in menuNeedsUpdate:.
+  isMenuOpen_ = YES;
+}
+
+- (BOOL)menuHasKeyEquivalent:(NSMenu*)menu
+                    forEvent:(NSEvent*)event
+                      target:(id*)target
+                      action:(SEL*)action {
+  // Otherwise AppKit would fill in the menu to look for key equivalents.
+  return NO;
+}
+
+@end
@@ -15,7 +15,7 @@ bool ElectronMenuModel::Delegate::GetAcceleratorForCommandId(
 }
 
 ElectronMenuModel::ElectronMenuModel(Delegate* delegate)
-    : ui::SimpleMenuModel(delegate), delegate_(delegate) {}
+    : ui::SimpleMenuModel(delegate), delegate_(delegate), weak_factory_(this) {}
 
 ElectronMenuModel::~ElectronMenuModel() = default;
 
@@ -7,6 +7,7 @@
 
 #include <map>
 
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "ui/base/models/simple_menu_model.h"
@@ -65,6 +66,11 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   bool ShouldRegisterAcceleratorAt(int index) const;
   bool WorksWhenHiddenAt(int index) const;
 
+  // Whether the items of this submenu are filled in when it is about to be
+  // shown, in which case the native menus only build them then.
+  void set_lazy(bool lazy) { lazy_ = lazy; }
+  bool lazy() const { return lazy_; }
+
   // ui::SimpleMenuModel:
   void MenuWillClose() override;
   void MenuWillShow() override;
@@ -72,14 +78,21 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   using SimpleMenuModel::GetSubmenuModelAt;
   ElectronMenuModel* GetSubmenuModelAt(int index);
 
+  base::WeakPtr<ElectronMenuModel> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
  private:
   Delegate* delegate_;  // weak ref.
+  bool lazy_ = false;
 
   std::map<int, base::string16> toolTips_;   // command id -> tooltip
   std::map<int, base::string16> roles_;      // command id -> role
   std::map<int, base::string16> sublabels_;  // command id -> sublabel
   base::ObserverList<Observer> observers_;
 
+  base::WeakPtrFactory<ElectronMenuModel> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(ElectronMenuModel);
 };
 
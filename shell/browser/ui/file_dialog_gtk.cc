@@ -2,14 +2,23 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <dlfcn.h>
+
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/gtk_util.h"
 
+#include "base/bind.h"
 #include "base/callback.h"
+#include "base/environment.h"
 #include "base/files/file_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/ui/gtk/gtk_util.h"
 #include "shell/browser/native_window_views.h"
 #include "shell/browser/unresponsive_suppressor.h"
@@ -28,19 +37,107 @@ namespace {
 static const int kPreviewWidth = 256;
 static const int kPreviewHeight = 512;
 
-// Makes sure that .jpg also shows .JPG.
-gboolean FileFilterCaseInsensitive(const GtkFileFilterInfo* file_info,
-                                   std::string* file_extension) {
-  // Makes .* file extension matches all file types.
-  if (*file_extension == ".*")
+// GtkFileChooserNative is only in GTK 3.20 and newer, so its functions are
+// looked up at runtime. Through it, the dialog is shown by the
+// xdg-desktop-portal in its own process, and listing folders does not block
+// the UI thread.
+struct PortalFunctions {
+  using NewFunc = GObject* (*)(const gchar*,
+                               GtkWindow*,
+                               GtkFileChooserAction,
+                               const gchar*,
+                               const gchar*);
+  using DialogFunc = void (*)(GObject*);
+  using RunFunc = gint (*)(GObject*);
+  using SetModalFunc = void (*)(GObject*, gboolean);
+
+  PortalFunctions() {
+    file_chooser_native_new = reinterpret_cast<NewFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_file_chooser_native_new"));
+    show = reinterpret_cast<DialogFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_native_dialog_show"));
+    hide = reinterpret_cast<DialogFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_native_dialog_hide"));
+    destroy = reinterpret_cast<DialogFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_native_dialog_destroy"));
+    run = reinterpret_cast<RunFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_native_dialog_run"));
+    set_modal = reinterpret_cast<SetModalFunc>(
+        dlsym(RTLD_DEFAULT, "gtk_native_dialog_set_modal"));
+  }
+
+  bool IsAvailable() const {
+    return file_chooser_native_new && show && hide && destroy && run &&
+           set_modal;
+  }
+
+  NewFunc file_chooser_native_new = nullptr;
+  DialogFunc show = nullptr;
+  DialogFunc hide = nullptr;
+  DialogFunc destroy = nullptr;
+  RunFunc run = nullptr;
+  SetModalFunc set_modal = nullptr;
+};
+
+const PortalFunctions* GetPortalFunctions() {
+  static base::NoDestructor<PortalFunctions> functions;
+  return functions->IsAvailable() ? functions.get() : nullptr;
+}
+
+// Same conditions as GTK's own for using the portal: when asked to, or in a
+// Flatpak sandbox. Elsewhere GtkFileChooserNative would fall back to an in
+// process dialog without the preview.
+bool ShouldUsePortal() {
+  std::string use_portal;
+  if (base::Environment::Create()->GetVar("GTK_USE_PORTAL", &use_portal) &&
+      use_portal == "1") {
     return true;
-  return base::EndsWith(file_info->filename, *file_extension,
-                        base::CompareCase::INSENSITIVE_ASCII);
+  }
+  return base::PathExists(base::FilePath("/.flatpak-info"));
 }
 
-// Deletes |data| when gtk_file_filter_add_custom() is done with it.
-void OnFileFilterDataDestroyed(std::string* file_extension) {
-  delete file_extension;
+// Makes sure that .jpg also shows .JPG. Patterns rather than custom filters
+// are understood by the portal, and do not call back into Electron for every
+// file of the folder.
+std::string CaseInsensitivePattern(const std::string& extension) {
+  // Makes .* file extension matches all file types.
+  if (extension == "*")
+    return "*";
+  std::string pattern = "*.";
+  for (char c : extension) {
+    if (base::IsAsciiAlpha(c)) {
+      pattern += '[';
+      pattern += base::ToLowerASCII(c);
+      pattern += base::ToUpperASCII(c);
+      pattern += ']';
+    } else if (c == '*' || c == '?' || c == '[' || c == ']') {
+      pattern += '[';
+      pattern += c;
+      pattern += ']';
+    } else {
+      pattern += c;
+    }
+  }
+  return pattern;
+}
+
+struct GObjectDeleter {
+  void operator()(gpointer object) const { g_object_unref(object); }
+};
+using ScopedGdkPixbuf = std::unique_ptr<GdkPixbuf, GObjectDeleter>;
+
+// Runs on the thread pool, decoding large images or reading from slow file
+// systems would otherwise freeze the UI thread.
+ScopedGdkPixbuf LoadPreview(const std::string& filename) {
+  // Don't attempt to open anything which isn't a regular file. If a named pipe,
+  // this may hang. See https://crbug.com/534754.
+  struct stat stat_buf;
+  if (stat(filename.c_str(), &stat_buf) != 0 || !S_ISREG(stat_buf.st_mode))
+    return nullptr;
+
+  // This will preserve the image's aspect ratio.
+  return ScopedGdkPixbuf(gdk_pixbuf_new_from_file_at_size(
+      filename.c_str(), kPreviewWidth, kPreviewHeight, nullptr));
 }
 
 class FileChooserDialog {
@@ -58,49 +155,64 @@ class FileChooserDialog {
     else if (action == GTK_FILE_CHOOSER_ACTION_OPEN)
       confirm_text = gtk_util::kOpenLabel;
 
-    dialog_ = gtk_file_chooser_dialog_new(
-        settings.title.c_str(), nullptr, action, gtk_util::kCancelLabel,
-        GTK_RESPONSE_CANCEL, confirm_text, GTK_RESPONSE_ACCEPT, NULL);
-    if (parent_) {
-      parent_->SetEnabled(false);
-      gtk::SetGtkTransientForAura(dialog_, parent_->GetNativeWindow());
-      gtk_window_set_modal(GTK_WINDOW(dialog_), TRUE);
+    portal_ = ShouldUsePortal() ? GetPortalFunctions() : nullptr;
+    if (portal_) {
+      native_ = portal_->file_chooser_native_new(settings.title.c_str(),
+                                                 nullptr, action, confirm_text,
+                                                 gtk_util::kCancelLabel);
+      portal_->set_modal(native_, parent_ ? TRUE : FALSE);
+      if (parent_)
+        parent_->SetEnabled(false);
+    } else {
+      dialog_ = gtk_file_chooser_dialog_new(
+          settings.title.c_str(), nullptr, action, gtk_util::kCancelLabel,
+          GTK_RESPONSE_CANCEL, confirm_text, GTK_RESPONSE_ACCEPT, NULL);
+      if (parent_) {
+        parent_->SetEnabled(false);
+        gtk::SetGtkTransientForAura(dialog_, parent_->GetNativeWindow());
+        gtk_window_set_modal(GTK_WINDOW(dialog_), TRUE);
+      }
     }
 
     if (action == GTK_FILE_CHOOSER_ACTION_SAVE)
-      gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(dialog_),
-                                                     TRUE);
+      gtk_file_chooser_set_do_overwrite_confirmation(chooser(), TRUE);
     if (action != GTK_FILE_CHOOSER_ACTION_OPEN)
-      gtk_file_chooser_set_create_folders(GTK_FILE_CHOOSER(dialog_), TRUE);
+      gtk_file_chooser_set_create_folders(chooser(), TRUE);
 
     if (!settings.default_path.empty()) {
       if (base::DirectoryExists(settings.default_path)) {
         gtk_file_chooser_set_current_folder(
-            GTK_FILE_CHOOSER(dialog_), settings.default_path.value().c_str());
+            chooser(), settings.default_path.value().c_str());
       } else {
         if (settings.default_path.IsAbsolute()) {
           gtk_file_chooser_set_current_folder(
-              GTK_FILE_CHOOSER(dialog_),
-              settings.default_path.DirName().value().c_str());
+              chooser(), settings.default_path.DirName().value().c_str());
         }
 
         gtk_file_chooser_set_current_name(
-            GTK_FILE_CHOOSER(dialog_),
-            settings.default_path.BaseName().value().c_str());
+            chooser(), settings.default_path.BaseName().value().c_str());
       }
     }
 
     if (!settings.filters.empty())
       AddFilters(settings.filters);
 
-    preview_ = gtk_image_new();
-    g_signal_connect(dialog_, "update-preview",
-                     G_CALLBACK(OnUpdatePreviewThunk), this);
-    gtk_file_chooser_set_preview_widget(GTK_FILE_CHOOSER(dialog_), preview_);
+    // The portal has no preview widget, the desktop provides its own.
+    if (dialog_) {
+      preview_ = gtk_image_new();
+      g_signal_connect(dialog_, "update-preview",
+                       G_CALLBACK(OnUpdatePreviewThunk), this);
+      gtk_file_chooser_set_preview_widget(chooser(), preview_);
+    }
   }
 
   ~FileChooserDialog() {
-    gtk_widget_destroy(dialog_);
+    if (native_) {
+      portal_->destroy(native_);
+      g_object_unref(native_);
+    } else {
+      gtk_widget_destroy(dialog_);
+    }
     if (parent_)
       parent_->SetEnabled(true);
   }
@@ -109,7 +221,7 @@ class FileChooserDialog {
     const auto hasProp = [properties](OpenFileDialogProperty prop) {
       return gboolean((properties & prop) != 0);
     };
-    auto* file_chooser = GTK_FILE_CHOOSER(dialog());
+    auto* file_chooser = chooser();
     gtk_file_chooser_set_select_multiple(file_chooser,
                                          hasProp(OPEN_DIALOG_MULTI_SELECTIONS));
     gtk_file_chooser_set_show_hidden(file_chooser,
@@ -120,7 +232,7 @@ class FileChooserDialog {
     const auto hasProp = [properties](SaveFileDialogProperty prop) {
       return gboolean((properties & prop) != 0);
     };
-    auto* file_chooser = GTK_FILE_CHOOSER(dialog());
+    auto* file_chooser = chooser();
     gtk_file_chooser_set_show_hidden(file_chooser,
                                      hasProp(SAVE_DIALOG_SHOW_HIDDEN_FILES));
     gtk_file_chooser_set_do_overwrite_confirmation(
@@ -128,6 +240,13 @@ class FileChooserDialog {
   }
 
   void RunAsynchronous() {
+    if (native_) {
+      g_signal_connect(native_, "response",
+                       G_CALLBACK(OnFileDialogResponseThunk), this);
+      portal_->show(native_);
+      return;
+    }
+
     g_signal_connect(dialog_, "delete-event",
                      G_CALLBACK(gtk_widget_hide_on_delete), NULL);
     g_signal_connect(dialog_, "response", G_CALLBACK(OnFileDialogResponseThunk),
@@ -156,8 +275,16 @@ class FileChooserDialog {
     RunAsynchronous();
   }
 
+  // Shows the dialog and returns its response once closed.
+  int RunModal() {
+    if (native_)
+      return portal_->run(native_);
+    gtk_widget_show_all(dialog_);
+    return gtk_dialog_run(GTK_DIALOG(dialog_));
+  }
+
   base::FilePath GetFileName() const {
-    gchar* filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog_));
+    gchar* filename = gtk_file_chooser_get_filename(chooser());
     const base::FilePath path(filename);
     g_free(filename);
     return path;
@@ -165,7 +292,7 @@ class FileChooserDialog {
 
   std::vector<base::FilePath> GetFileNames() const {
     std::vector<base::FilePath> paths;
-    auto* filenames = gtk_file_chooser_get_filenames(GTK_FILE_CHOOSER(dialog_));
+    auto* filenames = gtk_file_chooser_get_filenames(chooser());
     for (auto* iter = filenames; iter != nullptr; iter = iter->next) {
       auto* filename = static_cast<char*>(iter->data);
       paths.emplace_back(filename);
@@ -181,16 +308,26 @@ class FileChooserDialog {
                      GtkWidget*,
                      int);
 
-  GtkWidget* dialog() const { return dialog_; }
+  GtkFileChooser* chooser() const {
+    return native_ ? GTK_FILE_CHOOSER(native_) : GTK_FILE_CHOOSER(dialog_);
+  }
 
  private:
   void AddFilters(const Filters& filters);
+  void OnPreviewLoaded(const std::string& filename, ScopedGdkPixbuf pixbuf);
 
   electron::NativeWindowViews* parent_;
   electron::UnresponsiveSuppressor unresponsive_suppressor_;
 
-  GtkWidget* dialog_;
-  GtkWidget* preview_;
+  // Only one of them is set, |native_| when the portal shows the dialog.
+  const PortalFunctions* portal_ = nullptr;
+  GObject* native_ = nullptr;
+  GtkWidget* dialog_ = nullptr;
+  GtkWidget* preview_ = nullptr;
+
+  // The file whose preview is being loaded, the previews of the files
+  // selected before it are dropped when they arrive.
+  std::string preview_filename_;
 
   Filters filters_;
   std::unique_ptr<gin_helper::Promise<gin_helper::Dictionary>> save_promise_;
@@ -199,11 +336,16 @@ class FileChooserDialog {
   // Callback for when we update the preview for the selection.
   CHROMEG_CALLBACK_0(FileChooserDialog, void, OnUpdatePreview, GtkWidget*);
 
+  base::WeakPtrFactory<FileChooserDialog> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(FileChooserDialog);
 };
 
 void FileChooserDialog::OnFileDialogResponse(GtkWidget* widget, int response) {
-  gtk_widget_hide(dialog_);
+  if (native_)
+    portal_->hide(native_);
+  else
+    gtk_widget_hide(dialog_);
   if (save_promise_) {
     gin_helper::Dictionary dict =
         gin::Dictionary::CreateEmpty(save_promise_->isolate());
@@ -235,48 +377,42 @@ void FileChooserDialog::AddFilters(const Filters& filters) {
     GtkFileFilter* gtk_filter = gtk_file_filter_new();
 
     for (const auto& extension : filter.second) {
-      auto file_extension = std::make_unique<std::string>("." + extension);
-      gtk_file_filter_add_custom(
-          gtk_filter, GTK_FILE_FILTER_FILENAME,
-          reinterpret_cast<GtkFileFilterFunc>(FileFilterCaseInsensitive),
-          file_extension.release(),
-          reinterpret_cast<GDestroyNotify>(OnFileFilterDataDestroyed));
+      gtk_file_filter_add_pattern(gtk_filter,
+                                  CaseInsensitivePattern(extension).c_str());
     }
 
     gtk_file_filter_set_name(gtk_filter, filter.first.c_str());
-    gtk_file_chooser_add_filter(GTK_FILE_CHOOSER(dialog_), gtk_filter);
+    gtk_file_chooser_add_filter(chooser(), gtk_filter);
   }
 }
 
 void FileChooserDialog::OnUpdatePreview(GtkWidget* chooser) {
   gchar* filename =
       gtk_file_chooser_get_preview_filename(GTK_FILE_CHOOSER(chooser));
+  // The previous preview stays hidden until the new one is loaded.
+  gtk_file_chooser_set_preview_widget_active(GTK_FILE_CHOOSER(chooser), FALSE);
   if (!filename) {
-    gtk_file_chooser_set_preview_widget_active(GTK_FILE_CHOOSER(chooser),
-                                               FALSE);
+    preview_filename_.clear();
     return;
   }
 
-  // Don't attempt to open anything which isn't a regular file. If a named pipe,
-  // this may hang. See https://crbug.com/534754.
-  struct stat stat_buf;
-  if (stat(filename, &stat_buf) != 0 || !S_ISREG(stat_buf.st_mode)) {
-    g_free(filename);
-    gtk_file_chooser_set_preview_widget_active(GTK_FILE_CHOOSER(chooser),
-                                               FALSE);
-    return;
-  }
-
-  // This will preserve the image's aspect ratio.
-  GdkPixbuf* pixbuf = gdk_pixbuf_new_from_file_at_size(filename, kPreviewWidth,
-                                                       kPreviewHeight, nullptr);
+  preview_filename_ = filename;
   g_free(filename);
-  if (pixbuf) {
-    gtk_image_set_from_pixbuf(GTK_IMAGE(preview_), pixbuf);
-    g_object_unref(pixbuf);
-  }
-  gtk_file_chooser_set_preview_widget_active(GTK_FILE_CHOOSER(chooser),
-                                             pixbuf ? TRUE : FALSE);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&LoadPreview, preview_filename_),
+      base::BindOnce(&FileChooserDialog::OnPreviewLoaded,
+                     weak_factory_.GetWeakPtr(), preview_filename_));
+}
+
+void FileChooserDialog::OnPreviewLoaded(const std::string& filename,
+                                        ScopedGdkPixbuf pixbuf) {
+  if (filename != preview_filename_ || !pixbuf)
+    return;
+  gtk_image_set_from_pixbuf(GTK_IMAGE(preview_), pixbuf.get());
+  gtk_file_chooser_set_preview_widget_active(chooser(), TRUE);
 }
 
 }  // namespace
@@ -289,8 +425,7 @@ bool ShowOpenDialogSync(const DialogSettings& settings,
   FileChooserDialog open_dialog(action, settings);
   open_dialog.SetupOpenProperties(settings.properties);
 
-  gtk_widget_show_all(open_dialog.dialog());
-  int response = gtk_dialog_run(GTK_DIALOG(open_dialog.dialog()));
+  int response = open_dialog.RunModal();
   if (response == GTK_RESPONSE_ACCEPT) {
     *paths = open_dialog.GetFileNames();
     return true;
@@ -312,8 +447,7 @@ bool ShowSaveDialogSync(const DialogSettings& settings, base::FilePath* path) {
   FileChooserDialog save_dialog(GTK_FILE_CHOOSER_ACTION_SAVE, settings);
   save_dialog.SetupSaveProperties(settings.properties);
 
-  gtk_widget_show_all(save_dialog.dialog());
-  int response = gtk_dialog_run(GTK_DIALOG(save_dialog.dialog()));
+  int response = save_dialog.RunModal();
   if (response == GTK_RESPONSE_ACCEPT) {
     *path = save_dialog.GetFileName();
     return true;
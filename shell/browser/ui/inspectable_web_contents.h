@@ -52,6 +52,9 @@ class InspectableWebContents {
   virtual void ShowDevTools(bool activate) = 0;
   virtual void CloseDevTools() = 0;
   virtual bool IsDevToolsViewShowing() = 0;
+  // Keeps the DevTools loaded in the background when they are closed, so that
+  // opening them again only shows them.
+  virtual void SetKeepDevToolsLoaded(bool keep) = 0;
   virtual void AttachTo(scoped_refptr<content::DevToolsAgentHost>) = 0;
   virtual void Detach() = 0;
   virtual void CallClientFunction(const std::string& function_name,
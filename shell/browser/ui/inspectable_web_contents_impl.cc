@@ -401,6 +401,8 @@ content::WebContents* InspectableWebContentsImpl::GetDevToolsWebContents()
 }
 
 void InspectableWebContentsImpl::InspectElement(int x, int y) {
+  if (devtools_hidden_)
+    ShowDevTools(true);
   if (agent_host_)
     agent_host_->InspectElement(web_contents_->GetMainFrame(), x, y);
 }
@@ -439,6 +441,17 @@ void InspectableWebContentsImpl::SetDevToolsWebContents(
 }
 
 void InspectableWebContentsImpl::ShowDevTools(bool activate) {
+  if (devtools_hidden_) {
+    // A front-end loaded for a detached window can not be docked and the
+    // other way around.
+    if (can_dock_ == loaded_can_dock_) {
+      activate_ = activate;
+      ShowHiddenDevTools();
+      return;
+    }
+    DestroyHiddenDevTools();
+  }
+
   if (embedder_message_dispatcher_) {
     if (managed_devtools_web_contents_)
       view_->ShowDevTools(activate);
@@ -461,12 +474,29 @@ void InspectableWebContentsImpl::ShowDevTools(bool activate) {
   Observe(GetDevToolsWebContents());
   AttachTo(content::DevToolsAgentHost::GetOrCreateFor(web_contents_.get()));
 
+  loaded_can_dock_ = can_dock_;
   GetDevToolsWebContents()->GetController().LoadURL(
       GetDevToolsURL(can_dock_), content::Referrer(),
       ui::PAGE_TRANSITION_AUTO_TOPLEVEL, std::string());
 }
 
 void InspectableWebContentsImpl::CloseDevTools() {
+  if (devtools_hidden_)
+    return;
+
+  // The front-end is only kept once loaded, so that it is not shown half way
+  // through its initialization.
+  if (keep_devtools_loaded_ && managed_devtools_web_contents_ &&
+      frontend_loaded_) {
+    devtools_hidden_ = true;
+    view_->CloseDevTools();
+    if (view_->GetDelegate())
+      view_->GetDelegate()->DevToolsClosed();
+    if (!IsGuest())
+      web_contents_->Focus();
+    return;
+  }
+
   if (GetDevToolsWebContents()) {
     frontend_loaded_ = false;
     if (managed_devtools_web_contents_) {
@@ -483,6 +513,37 @@ bool InspectableWebContentsImpl::IsDevToolsViewShowing() {
   return managed_devtools_web_contents_ && view_->IsDevToolsViewShowing();
 }
 
+void InspectableWebContentsImpl::SetKeepDevToolsLoaded(bool keep) {
+  keep_devtools_loaded_ = keep;
+  if (!keep && devtools_hidden_)
+    DestroyHiddenDevTools();
+}
+
+void InspectableWebContentsImpl::ShowHiddenDevTools() {
+  devtools_hidden_ = false;
+  // Restore the window the DevTools were closed in, the front-end then docks
+  // them to the requested side, as when it is loaded.
+  view_->SetIsDocked(is_docked_, activate_);
+  if (can_dock_ && !dock_state_.empty()) {
+    base::string16 javascript = base::UTF8ToUTF16(
+        "Components.dockController.setDockSide(\"" + dock_state_ + "\");");
+    GetDevToolsWebContents()->GetMainFrame()->ExecuteJavaScript(
+        javascript, base::NullCallback());
+  }
+
+  if (view_->GetDelegate())
+    view_->GetDelegate()->DevToolsOpened();
+}
+
+void InspectableWebContentsImpl::DestroyHiddenDevTools() {
+  frontend_loaded_ = false;
+  // The delegate was told when the DevTools were hidden, so it is not told
+  // again when their WebContents is destroyed.
+  managed_devtools_web_contents_.reset();
+  embedder_message_dispatcher_.reset();
+  devtools_hidden_ = false;
+}
+
 void InspectableWebContentsImpl::AttachTo(
     scoped_refptr<content::DevToolsAgentHost> host) {
   Detach();
@@ -561,7 +622,8 @@ void InspectableWebContentsImpl::CloseWindow() {
 
 void InspectableWebContentsImpl::LoadCompleted() {
   frontend_loaded_ = true;
-  if (managed_devtools_web_contents_)
+  // The front-end of hidden DevTools can be reloaded, they stay hidden.
+  if (managed_devtools_web_contents_ && !devtools_hidden_)
     view_->ShowDevTools(activate_);
 
   // If the devtools can dock, "SetIsDocked" will be called by devtools itself.
@@ -585,7 +647,7 @@ void InspectableWebContentsImpl::LoadCompleted() {
   AddDevToolsExtensionsToClient();
 #endif
 
-  if (view_->GetDelegate())
+  if (view_->GetDelegate() && !devtools_hidden_)
     view_->GetDelegate()->DevToolsOpened();
 }
 
@@ -700,7 +762,8 @@ void InspectableWebContentsImpl::LoadNetworkResource(
 
 void InspectableWebContentsImpl::SetIsDocked(const DispatchCallback& callback,
                                              bool docked) {
-  if (managed_devtools_web_contents_)
+  is_docked_ = docked;
+  if (managed_devtools_web_contents_ && !devtools_hidden_)
     view_->SetIsDocked(docked, activate_);
   if (!callback.is_null())
     callback.Run(nullptr);
@@ -950,7 +1013,7 @@ void InspectableWebContentsImpl::WebContentsDestroyed() {
   Detach();
   embedder_message_dispatcher_.reset();
 
-  if (view_ && view_->GetDelegate())
+  if (view_ && view_->GetDelegate() && !devtools_hidden_)
     view_->GetDelegate()->DevToolsClosed();
 }
 
@@ -64,6 +64,7 @@ class InspectableWebContentsImpl
   void ShowDevTools(bool activate) override;
   void CloseDevTools() override;
   bool IsDevToolsViewShowing() override;
+  void SetKeepDevToolsLoaded(bool keep) override;
   void AttachTo(scoped_refptr<content::DevToolsAgentHost>) override;
   void Detach() override;
   void CallClientFunction(const std::string& function_name,
@@ -199,6 +200,11 @@ class InspectableWebContentsImpl
   void AddDevToolsExtensionsToClient();
 #endif
 
+  // Shows again the DevTools that were kept loaded when closed.
+  void ShowHiddenDevTools();
+  // Destroys the DevTools that were kept loaded when closed.
+  void DestroyHiddenDevTools();
+
   bool frontend_loaded_;
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
   std::unique_ptr<content::DevToolsFrontendHost> frontend_host_;
@@ -210,6 +216,14 @@ class InspectableWebContentsImpl
   bool can_dock_;
   std::string dock_state_;
   bool activate_ = true;
+  bool is_docked_ = true;
+
+  // Whether the DevTools are kept loaded in the background when closed, and
+  // whether they currently are.
+  bool keep_devtools_loaded_ = false;
+  bool devtools_hidden_ = false;
+  // The |can_dock_| the front-end was loaded with.
+  bool loaded_can_dock_ = true;
 
   InspectableWebContentsDelegate* delegate_;  // weak references.
 
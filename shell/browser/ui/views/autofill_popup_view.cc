@@ -4,6 +4,7 @@
 
 #include "shell/browser/ui/views/autofill_popup_view.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -26,6 +27,8 @@ namespace electron {
 void AutofillPopupChildView::GetAccessibleNodeData(ui::AXNodeData* node_data) {
   node_data->role = ax::mojom::Role::kMenuItem;
   node_data->SetName(suggestion_);
+  node_data->AddIntAttribute(ax::mojom::IntAttribute::kPosInSet, index_ + 1);
+  node_data->AddIntAttribute(ax::mojom::IntAttribute::kSetSize, count_);
 }
 
 AutofillPopupView::AutofillPopupView(AutofillPopup* popup,
@@ -152,8 +155,10 @@ void AutofillPopupView::OnSelectedRowChanged(
   SchedulePaint();
 
   if (current_row_selection) {
-    int selected = current_row_selection.value_or(-1);
-    if (selected == -1 || static_cast<size_t>(selected) >= children().size())
+    // Only the visible rows have a child view.
+    int selected = current_row_selection.value_or(-1) -
+                   popup_->GetFirstVisibleLine();
+    if (selected < 0 || static_cast<size_t>(selected) >= children().size())
       return;
     children().at(selected)->NotifyAccessibilityEvent(
         ax::mojom::Event::kSelection, true);
@@ -214,13 +219,26 @@ void AutofillPopupView::CreateChildViews() {
 
   RemoveAllChildViews(true);
 
-  for (int i = 0; i < popup_->GetLineCount(); ++i) {
-    auto* child_view = new AutofillPopupChildView(popup_->GetValueAt(i));
+  int line_count = popup_->GetLineCount();
+  int first_line = popup_->GetFirstVisibleLine();
+  int last_line =
+      std::min(line_count, first_line + popup_->GetVisibleLineCount());
+  for (int i = first_line; i < last_line; ++i) {
+    auto* child_view =
+        new AutofillPopupChildView(popup_->GetValueAt(i), i, line_count);
     child_view->set_drag_controller(this);
     AddChildView(child_view);
   }
 }
 
+void AutofillPopupView::ScrollBy(int lines) {
+  if (!popup_ ||
+      !popup_->SetFirstVisibleLine(popup_->GetFirstVisibleLine() + lines))
+    return;
+  CreateChildViews();
+  SchedulePaint();
+}
+
 void AutofillPopupView::DoUpdateBoundsAndRedrawPopup() {
   if (!popup_)
     return;
@@ -235,8 +253,7 @@ void AutofillPopupView::DoUpdateBoundsAndRedrawPopup() {
 }
 
 void AutofillPopupView::OnPaint(gfx::Canvas* canvas) {
-  if (!popup_ ||
-      static_cast<size_t>(popup_->GetLineCount()) != children().size())
+  if (!popup_)
     return;
   gfx::Canvas* draw_canvas = canvas;
   SkBitmap bitmap;
@@ -255,7 +272,12 @@ void AutofillPopupView::OnPaint(gfx::Canvas* canvas) {
       ui::NativeTheme::kColorId_ResultsTableNormalBackground));
   OnPaintBorder(draw_canvas);
 
-  for (int i = 0; i < popup_->GetLineCount(); ++i) {
+  // Only the visible rows are painted, plus the one cut by the bottom border
+  // when the popup is shorter than its rows.
+  int first_line = popup_->GetFirstVisibleLine();
+  int last_line = std::min(popup_->GetLineCount(),
+                           first_line + popup_->GetVisibleLineCount() + 1);
+  for (int i = first_line; i < last_line; ++i) {
     gfx::Rect line_rect = popup_->GetRowBounds(i);
 
     DrawAutofillEntry(draw_canvas, i, line_rect);
@@ -292,6 +314,16 @@ bool AutofillPopupView::OnMouseDragged(const ui::MouseEvent& event) {
   return false;
 }
 
+bool AutofillPopupView::OnMouseWheel(const ui::MouseWheelEvent& event) {
+  // Three rows per notch of the wheel, and at least one row for the small
+  // deltas of touchpads.
+  int lines = -3 * event.y_offset() / ui::MouseWheelEvent::kWheelDelta;
+  if (lines == 0 && event.y_offset() != 0)
+    lines = event.y_offset() > 0 ? -1 : 1;
+  ScrollBy(lines);
+  return true;
+}
+
 void AutofillPopupView::OnMouseExited(const ui::MouseEvent& event) {
   // Pressing return causes the cursor to hide, which will generate an
   // OnMouseExited event. Pressing return should activate the current selection
@@ -451,6 +483,8 @@ void AutofillPopupView::SetSelectedLine(base::Optional<int> selected_line) {
 
   auto previous_selected_line(selected_line_);
   selected_line_ = selected_line;
+  if (selected_line && popup_->ScrollToLine(selected_line.value()))
+    CreateChildViews();
   OnSelectedRowChanged(previous_selected_line, selected_line_);
 }
 
@@ -30,6 +30,9 @@ const int kSmallerFontSizeDelta = -1;
 const int kEndPadding = 8;
 const int kNamePadding = 15;
 const int kRowHeight = 24;
+// Rows past this are scrolled into view instead of growing the popup, only
+// the visible ones are painted.
+const int kMaxVisibleRows = 20;
 
 class AutofillPopup;
 
@@ -37,8 +40,10 @@ class AutofillPopup;
 // by |AutofillPopupViewViews|.
 class AutofillPopupChildView : public views::View {
  public:
-  explicit AutofillPopupChildView(const base::string16& suggestion)
-      : suggestion_(suggestion) {
+  AutofillPopupChildView(const base::string16& suggestion,
+                         int index,
+                         int count)
+      : suggestion_(suggestion), index_(index), count_(count) {
     SetFocusBehavior(FocusBehavior::ALWAYS);
   }
 
@@ -49,6 +54,8 @@ class AutofillPopupChildView : public views::View {
   void GetAccessibleNodeData(ui::AXNodeData* node_data) override;
 
   base::string16 suggestion_;
+  int index_;
+  int count_;
 
   DISALLOW_COPY_AND_ASSIGN(AutofillPopupChildView);
 };
@@ -88,11 +95,14 @@ class AutofillPopupView : public views::WidgetDelegateView,
                          int index,
                          const gfx::Rect& entry_rect);
 
-  // Creates child views based on the suggestions given by |controller_|. These
+  // Creates child views for the visible suggestions given by |popup_|. These
   // child views are used for accessibility events only. We need child views to
   // populate the correct |AXNodeData| when user selects a suggestion.
   void CreateChildViews();
 
+  // Scrolls the suggestions by |lines| rows.
+  void ScrollBy(int lines);
+
   void DoUpdateBoundsAndRedrawPopup();
 
   // views::Views implementation.
@@ -100,6 +110,7 @@ class AutofillPopupView : public views::WidgetDelegateView,
   void GetAccessibleNodeData(ui::AXNodeData* node_data) override;
   void OnMouseCaptureLost() override;
   bool OnMouseDragged(const ui::MouseEvent& event) override;
+  bool OnMouseWheel(const ui::MouseWheelEvent& event) override;
   void OnMouseExited(const ui::MouseEvent& event) override;
   void OnMouseMoved(const ui::MouseEvent& event) override;
   bool OnMousePressed(const ui::MouseEvent& event) override;
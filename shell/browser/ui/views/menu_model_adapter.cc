@@ -4,6 +4,8 @@
 
 #include "shell/browser/ui/views/menu_model_adapter.h"
 
+#include "ui/views/controls/menu/menu_item_view.h"
+
 namespace electron {
 
 MenuModelAdapter::MenuModelAdapter(ElectronMenuModel* menu_model)
@@ -22,4 +24,51 @@ bool MenuModelAdapter::GetAccelerator(int id,
   return false;
 }
 
+void MenuModelAdapter::WillShowMenu(views::MenuItemView* menu) {
+  // The menus built lazily are unknown to views::MenuModelAdapter, so the
+  // models are looked up from the command ids instead.
+  ElectronMenuModel* model = GetModelForMenu(menu);
+  if (!model)
+    return;
+  model->MenuWillShow();
+  if (model->lazy())
+    BuildLazyMenu(menu, model);
+}
+
+void MenuModelAdapter::WillHideMenu(views::MenuItemView* menu) {
+  ElectronMenuModel* model = GetModelForMenu(menu);
+  if (model)
+    model->MenuWillClose();
+}
+
+ElectronMenuModel* MenuModelAdapter::GetModelForMenu(
+    views::MenuItemView* menu) const {
+  if (!menu->GetParentMenuItem())
+    return menu_model_;
+  ui::MenuModel* model = menu_model_;
+  int index = 0;
+  if (!ui::MenuModel::GetModelAndIndexForCommandId(menu->GetCommand(), &model,
+                                                   &index) ||
+      model->GetTypeAt(index) != ui::MenuModel::TYPE_SUBMENU) {
+    return nullptr;
+  }
+  return static_cast<ElectronMenuModel*>(model->GetSubmenuModelAt(index));
+}
+
+void MenuModelAdapter::BuildLazyMenu(views::MenuItemView* menu,
+                                     ElectronMenuModel* model) {
+  if (menu->HasSubmenu())
+    menu->RemoveAllMenuItems();
+  for (int i = 0; i < model->GetItemCount(); ++i) {
+    views::MenuItemView* item = AppendMenuItemFromModel(
+        model, i, menu, model->GetCommandIdAt(i));
+    if (item && model->GetTypeAt(i) == ui::MenuModel::TYPE_SUBMENU) {
+      ElectronMenuModel* submodel = model->GetSubmenuModelAt(i);
+      if (!submodel->lazy())
+        BuildLazyMenu(item, submodel);
+    }
+  }
+  menu->ChildrenChanged();
+}
+
 }  // namespace electron
@@ -15,10 +15,20 @@ class MenuModelAdapter : public views::MenuModelAdapter {
   explicit MenuModelAdapter(ElectronMenuModel* menu_model);
   ~MenuModelAdapter() override;
 
+  // views::MenuModelAdapter:
+  void WillShowMenu(views::MenuItemView* menu) override;
+  void WillHideMenu(views::MenuItemView* menu) override;
+
  protected:
   bool GetAccelerator(int id, ui::Accelerator* accelerator) const override;
 
  private:
+  // Returns the model of the items of |menu|.
+  ElectronMenuModel* GetModelForMenu(views::MenuItemView* menu) const;
+
+  // Builds the items of |menu| from |model|, down to the lazy submenus.
+  void BuildLazyMenu(views::MenuItemView* menu, ElectronMenuModel* model);
+
   ElectronMenuModel* menu_model_;
 
   DISALLOW_COPY_AND_ASSIGN(MenuModelAdapter);
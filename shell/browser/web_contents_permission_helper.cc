@@ -8,9 +8,11 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/render_process_host.h"
 #include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/media/media_capture_devices_dispatcher.h"
 #include "shell/browser/media/media_stream_devices_controller.h"
 
 namespace {
@@ -32,14 +34,23 @@ namespace electron {
 
 namespace {
 
+void TakeMediaAction(const content::MediaStreamRequest& request,
+                     content::MediaResponseCallback callback) {
+  MediaStreamDevicesController controller(request, std::move(callback));
+  controller.TakeAction();
+}
+
 void MediaAccessAllowed(const content::MediaStreamRequest& request,
                         content::MediaResponseCallback callback,
                         bool allowed) {
+  if (allowed) {
+    // The first request after launch could otherwise find no device.
+    MediaCaptureDevicesDispatcher::GetInstance()->WhenDevicesEnumerated(
+        base::BindOnce(&TakeMediaAction, request, std::move(callback)));
+    return;
+  }
   MediaStreamDevicesController controller(request, std::move(callback));
-  if (allowed)
-    controller.TakeAction();
-  else
-    controller.Deny(blink::mojom::MediaStreamRequestResult::PERMISSION_DENIED);
+  controller.Deny(blink::mojom::MediaStreamRequestResult::PERMISSION_DENIED);
 }
 
 void OnPointerLockResponse(content::WebContents* web_contents, bool allowed) {
@@ -152,6 +163,10 @@ void WebContentsPermissionHelper::RequestOpenExternalPermission(
 bool WebContentsPermissionHelper::CheckMediaAccessPermission(
     const GURL& security_origin,
     blink::mojom::MediaStreamType type) const {
+  // Pages usually enumerate the devices before asking for them, the lists are
+  // then ready by the time they do.
+  MediaCaptureDevicesDispatcher::GetInstance()->StartDeviceMonitoring();
+
   base::DictionaryValue details;
   details.SetString("securityOrigin", security_origin.spec());
   details.SetString("mediaType", MediaStreamTypeToString(type));
@@ -10,7 +10,13 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/containers/mru_cache.h"
+#include "base/json/json_writer.h"
+#include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
@@ -33,6 +39,9 @@
 
 namespace {
 
+// How many distinct sets of preferences are kept parsed for sharing.
+constexpr size_t kMaxRecentlyParsedPreferences = 8;
+
 bool GetAsString(const base::Value* val,
                  base::StringPiece path,
                  std::string* out) {
@@ -178,7 +187,9 @@ void WebContentsPreferences::SetDefaults() {
     SetBool(options::kNativeWindowOpen, true);
   }
 
+  parsed_ = nullptr;
   last_preference_ = preference_.Clone();
+  last_parsed_ = nullptr;
 }
 
 bool WebContentsPreferences::SetDefaultBoolIfUndefined(base::StringPiece key,
@@ -189,12 +200,19 @@ bool WebContentsPreferences::SetDefaultBoolIfUndefined(base::StringPiece key,
     return current_value->GetBool();
   } else {
     preference_.SetKey(key, base::Value(val));
+    parsed_ = nullptr;
     return val;
   }
 }
 
 void WebContentsPreferences::SetBool(base::StringPiece key, bool value) {
-  preference_.SetKey(key, base::Value(value));
+  SetPreference(key, base::Value(value));
+}
+
+void WebContentsPreferences::SetPreference(base::StringPiece key,
+                                           base::Value value) {
+  preference_.SetKey(key, std::move(value));
+  parsed_ = nullptr;
 }
 
 bool WebContentsPreferences::IsEnabled(base::StringPiece name,
@@ -216,6 +234,7 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+  parsed_ = nullptr;
 }
 
 bool WebContentsPreferences::GetPreference(base::StringPiece name,
@@ -266,54 +285,110 @@ WebContentsPreferences* WebContentsPreferences::From(
   return FromWebContents(web_contents);
 }
 
-void WebContentsPreferences::AppendCommandLineSwitches(
-    base::CommandLine* command_line,
-    bool is_subframe) {
+// The preferences as renderers get them: the switches that only depend on the
+// preferences, and the overrides of the WebKit preferences.
+struct WebContentsPreferences::ParsedPreferences
+    : public base::RefCounted<ParsedPreferences> {
+  ParsedPreferences() = default;
+
+  // Switches with their value, empty for the ones without.
+  std::vector<std::pair<std::string, std::string>> switches;
+  base::FilePath::StringType preload;
+  std::vector<std::string> custom_args;
+  std::vector<std::string> custom_switches;
+  bool sandbox = false;
+  bool node_integration_in_sub_frames = false;
+  int guest_instance_id = 0;
+
+  bool javascript_enabled = true;
+  bool images_enabled = true;
+  bool text_areas_are_resizable = true;
+  bool navigate_on_drag_drop = false;
+  content::AutoplayPolicy autoplay_policy =
+      content::AutoplayPolicy::kNoUserGestureRequired;
+  bool webgl_enabled = true;
+  bool web_security_enabled = true;
+  bool allow_running_insecure_content = false;
+  base::Optional<base::string16> standard_font_family;
+  base::Optional<base::string16> serif_font_family;
+  base::Optional<base::string16> sans_serif_font_family;
+  base::Optional<base::string16> fixed_font_family;
+  base::Optional<base::string16> cursive_font_family;
+  base::Optional<base::string16> fantasy_font_family;
+  base::Optional<int> default_font_size;
+  base::Optional<int> default_fixed_font_size;
+  base::Optional<int> minimum_font_size;
+  base::Optional<std::string> default_encoding;
+
+ private:
+  friend class base::RefCounted<ParsedPreferences>;
+  ~ParsedPreferences() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(ParsedPreferences);
+};
+
+const WebContentsPreferences::ParsedPreferences&
+WebContentsPreferences::GetParsedPreferences() {
+  if (parsed_)
+    return *parsed_;
+
+  // Apps tend to open their windows with the same preferences, so the most
+  // recently parsed ones are kept by their serialization. Looking them up
+  // costs one walk of the preferences, however many WebContents there are.
+  static base::NoDestructor<base::HashingMRUCache<
+      std::string, scoped_refptr<const ParsedPreferences>>>
+      recently_parsed(kMaxRecentlyParsedPreferences);
+  std::string key;
+  if (!base::JSONWriter::Write(preference_, &key)) {
+    parsed_ = ParsePreferences();
+    return *parsed_;
+  }
+  auto it = recently_parsed->Get(key);
+  if (it != recently_parsed->end()) {
+    parsed_ = it->second;
+  } else {
+    parsed_ = ParsePreferences();
+    recently_parsed->Put(key, parsed_);
+  }
+  return *parsed_;
+}
+
+scoped_refptr<const WebContentsPreferences::ParsedPreferences>
+WebContentsPreferences::ParsePreferences() const {
+  auto parsed = base::MakeRefCounted<ParsedPreferences>();
+  auto& switches = parsed->switches;
+
   // Check if plugins are enabled.
   if (IsEnabled(options::kPlugins))
-    command_line->AppendSwitch(switches::kEnablePlugins);
+    switches.emplace_back(switches::kEnablePlugins, std::string());
 
   // Experimental flags.
   if (IsEnabled(options::kExperimentalFeatures))
-    command_line->AppendSwitch(
-        ::switches::kEnableExperimentalWebPlatformFeatures);
+    switches.emplace_back(::switches::kEnableExperimentalWebPlatformFeatures,
+                          std::string());
 
   // Check if we have node integration specified.
   if (IsEnabled(options::kNodeIntegration))
-    command_line->AppendSwitch(switches::kNodeIntegration);
+    switches.emplace_back(switches::kNodeIntegration, std::string());
 
   // Whether to enable node integration in Worker.
   if (IsEnabled(options::kNodeIntegrationInWorker))
-    command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
+    switches.emplace_back(switches::kNodeIntegrationInWorker, std::string());
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
   if (IsEnabled(options::kWebviewTag))
-    command_line->AppendSwitch(switches::kWebviewTag);
+    switches.emplace_back(switches::kWebviewTag, std::string());
 
-  // Sandbox can be enabled for renderer processes hosting cross-origin frames
-  // unless nodeIntegrationInSubFrames is enabled
-  bool can_sandbox_frame =
-      is_subframe && !IsEnabled(options::kNodeIntegrationInSubFrames);
-
-  // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
-  // pass `--enable-sandbox` to the renderer so it won't have any node.js
-  // integration. Otherwise disable Chromium sandbox, unless app.enableSandbox()
-  // was called.
-  if (IsEnabled(options::kSandbox) || can_sandbox_frame) {
-    command_line->AppendSwitch(switches::kEnableSandbox);
-  } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
-    command_line->AppendSwitch(service_manager::switches::kNoSandbox);
-    command_line->AppendSwitch(::switches::kNoZygote);
-  }
+  parsed->sandbox = IsEnabled(options::kSandbox);
+  parsed->node_integration_in_sub_frames =
+      IsEnabled(options::kNodeIntegrationInSubFrames);
 
   // Check if nativeWindowOpen is enabled.
   if (IsEnabled(options::kNativeWindowOpen))
-    command_line->AppendSwitch(switches::kNativeWindowOpen);
+    switches.emplace_back(switches::kNativeWindowOpen, std::string());
 
   // The preload script.
-  base::FilePath::StringType preload;
-  if (GetPreloadPath(&preload))
-    command_line->AppendSwitchNative(switches::kPreloadScript, preload);
+  GetPreloadPath(&parsed->preload);
 
   // Custom args for renderer process
   auto* customArgs =
@@ -321,51 +396,52 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (customArgs) {
     for (const auto& customArg : customArgs->GetList()) {
       if (customArg.is_string())
-        command_line->AppendArg(customArg.GetString());
+        parsed->custom_args.push_back(customArg.GetString());
     }
   }
 
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
   // Whether to enable the remote module
   if (IsEnabled(options::kEnableRemoteModule, false))
-    command_line->AppendSwitch(switches::kEnableRemoteModule);
+    switches.emplace_back(switches::kEnableRemoteModule, std::string());
 #endif
 
   // Run Electron APIs and preload script in isolated world
   if (IsEnabled(options::kContextIsolation))
-    command_line->AppendSwitch(switches::kContextIsolation);
+    switches.emplace_back(switches::kContextIsolation, std::string());
 
   // --background-color.
   std::string s;
   if (GetAsString(&preference_, options::kBackgroundColor, &s)) {
-    command_line->AppendSwitchASCII(switches::kBackgroundColor, s);
+    switches.emplace_back(switches::kBackgroundColor, s);
   } else if (!IsEnabled(options::kOffscreen)) {
     // For non-OSR WebContents, we expect to have white background, see
     // https://github.com/electron/electron/issues/13764 for more.
-    command_line->AppendSwitchASCII(switches::kBackgroundColor, "#fff");
+    switches.emplace_back(switches::kBackgroundColor, "#fff");
   }
 
   // --offscreen
   if (IsEnabled(options::kOffscreen)) {
-    command_line->AppendSwitch(options::kOffscreen);
+    switches.emplace_back(options::kOffscreen, std::string());
   }
 
   // --guest-instance-id, which is used to identify guest WebContents.
-  int guest_instance_id = 0;
-  if (GetAsInteger(&preference_, options::kGuestInstanceID, &guest_instance_id))
-    command_line->AppendSwitchASCII(switches::kGuestInstanceID,
-                                    base::NumberToString(guest_instance_id));
+  if (GetAsInteger(&preference_, options::kGuestInstanceID,
+                   &parsed->guest_instance_id)) {
+    switches.emplace_back(switches::kGuestInstanceID,
+                          base::NumberToString(parsed->guest_instance_id));
+  }
 
   // Pass the opener's window id.
   int opener_id;
   if (GetAsInteger(&preference_, options::kOpenerID, &opener_id))
-    command_line->AppendSwitchASCII(switches::kOpenerID,
-                                    base::NumberToString(opener_id));
+    switches.emplace_back(switches::kOpenerID,
+                          base::NumberToString(opener_id));
 
 #if defined(OS_MACOSX)
   // Enable scroll bounce.
   if (IsEnabled(options::kScrollBounce))
-    command_line->AppendSwitch(switches::kScrollBounce);
+    switches.emplace_back(switches::kScrollBounce, std::string());
 #endif
 
   // Custom command line switches.
@@ -376,110 +452,185 @@ void WebContentsPreferences::AppendCommandLineSwitches(
       if (arg.is_string()) {
         const auto& arg_val = arg.GetString();
         if (!arg_val.empty())
-          command_line->AppendSwitch(arg_val);
+          parsed->custom_switches.push_back(arg_val);
       }
     }
   }
 
   // Enable blink features.
   if (GetAsString(&preference_, options::kEnableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures, s);
+    switches.emplace_back(::switches::kEnableBlinkFeatures, s);
 
   // Disable blink features.
   if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures, s);
-
-  if (guest_instance_id) {
-    // Webview `document.visibilityState` tracks window visibility so we need
-    // to let it know if the window happens to be hidden right now.
-    auto* manager = WebViewManager::GetWebViewManager(web_contents_);
-    if (manager) {
-      auto* embedder = manager->GetEmbedder(guest_instance_id);
-      if (embedder) {
-        auto* relay = NativeWindowRelay::FromWebContents(embedder);
-        if (relay) {
-          auto* window = relay->GetNativeWindow();
-          if (window) {
-            const bool visible = window->IsVisible() && !window->IsMinimized();
-            if (!visible) {
-              command_line->AppendSwitch(switches::kHiddenPage);
-            }
-          }
-        }
-      }
-    }
-  }
+    switches.emplace_back(::switches::kDisableBlinkFeatures, s);
 
-  if (IsEnabled(options::kNodeIntegrationInSubFrames))
-    command_line->AppendSwitch(switches::kNodeIntegrationInSubFrames);
+  if (parsed->node_integration_in_sub_frames)
+    switches.emplace_back(switches::kNodeIntegrationInSubFrames, std::string());
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   if (IsEnabled(options::kSpellcheck)) {
-    command_line->AppendSwitch(switches::kEnableSpellcheck);
+    switches.emplace_back(switches::kEnableSpellcheck, std::string());
   }
 #endif
 
-  // We are appending args to a webContents so let's save the current state
-  // of our preferences object so that during the lifetime of the WebContents
-  // we can fetch the options used to initally configure the WebContents
-  last_preference_ = preference_.Clone();
-}
-
-void WebContentsPreferences::OverrideWebkitPrefs(
-    content::WebPreferences* prefs) {
-  prefs->javascript_enabled =
+  parsed->javascript_enabled =
       IsEnabled(options::kJavaScript, true /* default_value */);
-  prefs->images_enabled = IsEnabled(options::kImages, true /* default_value */);
-  prefs->text_areas_are_resizable =
+  parsed->images_enabled =
+      IsEnabled(options::kImages, true /* default_value */);
+  parsed->text_areas_are_resizable =
       IsEnabled(options::kTextAreasAreResizable, true /* default_value */);
-  prefs->navigate_on_drag_drop =
+  parsed->navigate_on_drag_drop =
       IsEnabled(options::kNavigateOnDragDrop, false /* default_value */);
-  if (!GetAsAutoplayPolicy(&preference_, "autoplayPolicy",
-                           &prefs->autoplay_policy)) {
-    prefs->autoplay_policy = content::AutoplayPolicy::kNoUserGestureRequired;
-  }
+  GetAsAutoplayPolicy(&preference_, "autoplayPolicy",
+                      &parsed->autoplay_policy);
 
   // Check if webgl should be enabled.
-  bool is_webgl_enabled = IsEnabled(options::kWebGL, true /* default_value */);
-  prefs->webgl1_enabled = is_webgl_enabled;
-  prefs->webgl2_enabled = is_webgl_enabled;
+  parsed->webgl_enabled = IsEnabled(options::kWebGL, true /* default_value */);
 
   // Check if web security should be enabled.
-  bool is_web_security_enabled =
+  parsed->web_security_enabled =
       IsEnabled(options::kWebSecurity, true /* default_value */);
-  prefs->web_security_enabled = is_web_security_enabled;
-  prefs->allow_running_insecure_content =
+  parsed->allow_running_insecure_content =
       IsEnabled(options::kAllowRunningInsecureContent,
-                !is_web_security_enabled /* default_value */);
+                !parsed->web_security_enabled /* default_value */);
 
   auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
                                                base::Value::Type::DICTIONARY);
   if (fonts_dict) {
     base::string16 font;
     if (GetAsString(fonts_dict, "standard", &font))
-      prefs->standard_font_family_map[content::kCommonScript] = font;
+      parsed->standard_font_family = font;
     if (GetAsString(fonts_dict, "serif", &font))
-      prefs->serif_font_family_map[content::kCommonScript] = font;
+      parsed->serif_font_family = font;
     if (GetAsString(fonts_dict, "sansSerif", &font))
-      prefs->sans_serif_font_family_map[content::kCommonScript] = font;
+      parsed->sans_serif_font_family = font;
     if (GetAsString(fonts_dict, "monospace", &font))
-      prefs->fixed_font_family_map[content::kCommonScript] = font;
+      parsed->fixed_font_family = font;
     if (GetAsString(fonts_dict, "cursive", &font))
-      prefs->cursive_font_family_map[content::kCommonScript] = font;
+      parsed->cursive_font_family = font;
     if (GetAsString(fonts_dict, "fantasy", &font))
-      prefs->fantasy_font_family_map[content::kCommonScript] = font;
+      parsed->fantasy_font_family = font;
   }
 
   int size;
   if (GetAsInteger(&preference_, "defaultFontSize", &size))
-    prefs->default_font_size = size;
+    parsed->default_font_size = size;
   if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
-    prefs->default_fixed_font_size = size;
+    parsed->default_fixed_font_size = size;
   if (GetAsInteger(&preference_, "minimumFontSize", &size))
-    prefs->minimum_font_size = size;
+    parsed->minimum_font_size = size;
   std::string encoding;
   if (GetAsString(&preference_, "defaultEncoding", &encoding))
-    prefs->default_encoding = encoding;
+    parsed->default_encoding = encoding;
+
+  return parsed;
+}
+
+void WebContentsPreferences::AppendCommandLineSwitches(
+    base::CommandLine* command_line,
+    bool is_subframe) {
+  const ParsedPreferences& parsed = GetParsedPreferences();
+
+  for (const auto& item : parsed.switches)
+    command_line->AppendSwitchASCII(item.first, item.second);
+
+  // Sandbox can be enabled for renderer processes hosting cross-origin frames
+  // unless nodeIntegrationInSubFrames is enabled
+  bool can_sandbox_frame =
+      is_subframe && !parsed.node_integration_in_sub_frames;
+
+  // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
+  // pass `--enable-sandbox` to the renderer so it won't have any node.js
+  // integration. Otherwise disable Chromium sandbox, unless app.enableSandbox()
+  // was called.
+  if (parsed.sandbox || can_sandbox_frame) {
+    command_line->AppendSwitch(switches::kEnableSandbox);
+  } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
+    command_line->AppendSwitch(service_manager::switches::kNoSandbox);
+    command_line->AppendSwitch(::switches::kNoZygote);
+  }
+
+  if (!parsed.preload.empty())
+    command_line->AppendSwitchNative(switches::kPreloadScript, parsed.preload);
+
+  for (const auto& arg : parsed.custom_args)
+    command_line->AppendArg(arg);
+
+  for (const auto& custom_switch : parsed.custom_switches)
+    command_line->AppendSwitch(custom_switch);
+
+  if (parsed.guest_instance_id) {
+    // Webview `document.visibilityState` tracks window visibility so we need
+    // to let it know if the window happens to be hidden right now.
+    auto* manager = WebViewManager::GetWebViewManager(web_contents_);
+    if (manager) {
+      auto* embedder = manager->GetEmbedder(parsed.guest_instance_id);
+      if (embedder) {
+        auto* relay = NativeWindowRelay::FromWebContents(embedder);
+        if (relay) {
+          auto* window = relay->GetNativeWindow();
+          if (window) {
+            const bool visible = window->IsVisible() && !window->IsMinimized();
+            if (!visible) {
+              command_line->AppendSwitch(switches::kHiddenPage);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // We are appending args to a webContents so let's save the current state
+  // of our preferences object so that during the lifetime of the WebContents
+  // we can fetch the options used to initally configure the WebContents. The
+  // copy is only made again when the preferences changed since the last one.
+  if (last_parsed_ != parsed_) {
+    last_preference_ = preference_.Clone();
+    last_parsed_ = parsed_;
+  }
+}
+
+void WebContentsPreferences::OverrideWebkitPrefs(
+    content::WebPreferences* prefs) {
+  const ParsedPreferences& parsed = GetParsedPreferences();
+  prefs->javascript_enabled = parsed.javascript_enabled;
+  prefs->images_enabled = parsed.images_enabled;
+  prefs->text_areas_are_resizable = parsed.text_areas_are_resizable;
+  prefs->navigate_on_drag_drop = parsed.navigate_on_drag_drop;
+  prefs->autoplay_policy = parsed.autoplay_policy;
+  prefs->webgl1_enabled = parsed.webgl_enabled;
+  prefs->webgl2_enabled = parsed.webgl_enabled;
+  prefs->web_security_enabled = parsed.web_security_enabled;
+  prefs->allow_running_insecure_content = parsed.allow_running_insecure_content;
+
+  if (parsed.standard_font_family)
+    prefs->standard_font_family_map[content::kCommonScript] =
+        *parsed.standard_font_family;
+  if (parsed.serif_font_family)
+    prefs->serif_font_family_map[content::kCommonScript] =
+        *parsed.serif_font_family;
+  if (parsed.sans_serif_font_family)
+    prefs->sans_serif_font_family_map[content::kCommonScript] =
+        *parsed.sans_serif_font_family;
+  if (parsed.fixed_font_family)
+    prefs->fixed_font_family_map[content::kCommonScript] =
+        *parsed.fixed_font_family;
+  if (parsed.cursive_font_family)
+    prefs->cursive_font_family_map[content::kCommonScript] =
+        *parsed.cursive_font_family;
+  if (parsed.fantasy_font_family)
+    prefs->fantasy_font_family_map[content::kCommonScript] =
+        *parsed.fantasy_font_family;
+
+  if (parsed.default_font_size)
+    prefs->default_font_size = *parsed.default_font_size;
+  if (parsed.default_fixed_font_size)
+    prefs->default_fixed_font_size = *parsed.default_fixed_font_size;
+  if (parsed.minimum_font_size)
+    prefs->minimum_font_size = *parsed.minimum_font_size;
+  if (parsed.default_encoding)
+    prefs->default_encoding = *parsed.default_encoding;
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsPreferences)
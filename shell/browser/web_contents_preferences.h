@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_refptr.h"
 #include "base/values.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -61,14 +62,19 @@ class WebContentsPreferences
   // Returns the preload script path.
   bool GetPreloadPath(base::FilePath::StringType* path) const;
 
+  // Sets the preference |key| to |value|.
+  void SetPreference(base::StringPiece key, base::Value value);
+
   // Returns the web preferences.
-  base::Value* preference() { return &preference_; }
-  base::Value* last_preference() { return &last_preference_; }
+  const base::Value* preference() const { return &preference_; }
+  const base::Value* last_preference() const { return &last_preference_; }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class ElectronBrowserClient;
 
+  struct ParsedPreferences;
+
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
@@ -78,6 +84,11 @@ class WebContentsPreferences
   // Set preference value to given bool
   void SetBool(base::StringPiece key, bool value);
 
+  // Returns the parsed preferences, which are parsed again after a change.
+  // Identical preferences of different WebContents share them.
+  const ParsedPreferences& GetParsedPreferences();
+  scoped_refptr<const ParsedPreferences> ParsePreferences() const;
+
   static std::vector<WebContentsPreferences*> instances_;
 
   content::WebContents* web_contents_;
@@ -85,6 +96,11 @@ class WebContentsPreferences
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
 
+  // Null when |preference_| changed since they were parsed.
+  scoped_refptr<const ParsedPreferences> parsed_;
+  // The ones |last_preference_| was copied with.
+  scoped_refptr<const ParsedPreferences> last_parsed_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsPreferences);
@@ -36,6 +36,15 @@ bool WindowList::IsEmpty() {
   return GetInstance()->windows_.empty();
 }
 
+// static
+NativeWindow* WindowList::GetFocusedWindow() {
+  for (auto* window : GetInstance()->windows_) {
+    if (!window->IsClosed() && window->IsFocused())
+      return window;
+  }
+  return nullptr;
+}
+
 // static
 void WindowList::AddWindow(NativeWindow* window) {
   DCHECK(window);
@@ -23,6 +23,9 @@ class WindowList {
   static WindowVector GetWindows();
   static bool IsEmpty();
 
+  // Finds the focused window without copying the list with GetWindows().
+  static NativeWindow* GetFocusedWindow();
+
   // Adds or removes |window| from the list it is associated with.
   static void AddWindow(NativeWindow* window);
   static void RemoveWindow(NativeWindow* window);
@@ -0,0 +1,161 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/worker_ipc_queue.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/stl_util.h"
+#include "base/threading/thread_local.h"
+#include "gin/converter.h"
+#include "gin/data_object_builder.h"
+#include "shell/common/gin_converters/blink_converter.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+namespace {
+
+constexpr char kWorkerExited[] = "The worker handling the invoke exited";
+
+base::LazyInstance<base::ThreadLocalPointer<WorkerIPCQueue>>::Leaky
+    g_current_queue = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+scoped_refptr<WorkerIPCQueue> WorkerIPCQueue::Create(
+    int pool_id,
+    v8::Isolate* isolate,
+    v8::Local<v8::Function> dispatch) {
+  scoped_refptr<WorkerIPCQueue> queue(
+      new WorkerIPCQueue(pool_id, isolate, dispatch));
+  queue->self_ = queue;
+  g_current_queue.Pointer()->Set(queue.get());
+  node::AddEnvironmentCleanupHook(isolate, &WorkerIPCQueue::OnCleanup,
+                                  queue.get());
+  return queue;
+}
+
+// static
+WorkerIPCQueue* WorkerIPCQueue::GetCurrent() {
+  return g_current_queue.Pointer()->Get();
+}
+
+WorkerIPCQueue::WorkerIPCQueue(int pool_id,
+                               v8::Isolate* isolate,
+                               v8::Local<v8::Function> dispatch)
+    : pool_id_(pool_id),
+      async_(new uv_async_t),
+      isolate_(isolate),
+      context_(isolate, isolate->GetCurrentContext()),
+      dispatch_(isolate, dispatch) {
+  uv_async_init(node::GetCurrentEventLoop(isolate), async_,
+                &WorkerIPCQueue::OnAsync);
+  async_->data = this;
+}
+
+WorkerIPCQueue::~WorkerIPCQueue() = default;
+
+void WorkerIPCQueue::Push(WorkerInvoke invoke) {
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!closed_) {
+      pending_.push_back(std::move(invoke));
+      ++load_;
+      uv_async_send(async_);
+      return;
+    }
+  }
+  WorkerIPCRouter::ReplyWithError(std::move(invoke), kWorkerExited);
+}
+
+bool WorkerIPCQueue::Reply(int reply_id, v8::Local<v8::Value> result) {
+  auto it = waiting_for_reply_.find(reply_id);
+  if (it == waiting_for_reply_.end())
+    return false;
+
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate_, result, &message))
+    return false;
+
+  WorkerInvoke invoke = std::move(it->second);
+  waiting_for_reply_.erase(it);
+  --load_;
+  invoke.reply_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(std::move(invoke.callback), std::move(message)));
+  return true;
+}
+
+void WorkerIPCQueue::Close() {
+  std::deque<WorkerInvoke> pending;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (closed_)
+      return;
+    closed_ = true;
+    pending.swap(pending_);
+  }
+  node::RemoveEnvironmentCleanupHook(isolate_, &WorkerIPCQueue::OnCleanup,
+                                     this);
+  if (g_current_queue.Pointer()->Get() == this)
+    g_current_queue.Pointer()->Set(nullptr);
+  WorkerIPCRouter::GetInstance()->RemoveQueue(this);
+
+  for (auto& invoke : pending)
+    WorkerIPCRouter::ReplyWithError(std::move(invoke), kWorkerExited);
+  for (auto& it : waiting_for_reply_)
+    WorkerIPCRouter::ReplyWithError(std::move(it.second), kWorkerExited);
+  waiting_for_reply_.clear();
+  load_ = 0;
+
+  dispatch_.Reset();
+  context_.Reset();
+  uv_close(reinterpret_cast<uv_handle_t*>(async_), [](uv_handle_t* handle) {
+    delete reinterpret_cast<uv_async_t*>(handle);
+  });
+  async_ = nullptr;
+  self_ = nullptr;
+}
+
+// static
+void WorkerIPCQueue::OnAsync(uv_async_t* handle) {
+  static_cast<WorkerIPCQueue*>(handle->data)->DispatchPending();
+}
+
+// static
+void WorkerIPCQueue::OnCleanup(void* arg) {
+  static_cast<WorkerIPCQueue*>(arg)->Close();
+}
+
+void WorkerIPCQueue::DispatchPending() {
+  std::deque<WorkerInvoke> pending;
+  {
+    base::AutoLock auto_lock(lock_);
+    pending.swap(pending_);
+  }
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  for (auto& invoke : pending) {
+    int reply_id = next_reply_id_++;
+    v8::Local<v8::Value> argv[] = {
+        gin::DataObjectBuilder(isolate_)
+            .Set("senderId", invoke.sender_id)
+            .Set("processId", invoke.process_id)
+            .Set("frameId", invoke.frame_id)
+            .Build(),
+        gin::StringToV8(isolate_, invoke.channel),
+        DeserializeV8Value(isolate_, invoke.args),
+        gin::ConvertToV8(isolate_, reply_id)};
+    waiting_for_reply_.emplace(reply_id, std::move(invoke));
+    node::MakeCallback(isolate_, context->Global(), dispatch_.Get(isolate_),
+                       base::size(argv), argv, {0, 0});
+  }
+}
+
+}  // namespace electron
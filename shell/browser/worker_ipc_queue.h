@@ -0,0 +1,85 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_WORKER_IPC_QUEUE_H_
+#define SHELL_BROWSER_WORKER_IPC_QUEUE_H_
+
+#include <atomic>
+#include <deque>
+#include <map>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "shell/browser/worker_ipc_router.h"
+#include "uv.h"  // NOLINT(build/include)
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// The invokes sent to one worker thread of a pool. Invokes are pushed from the
+// UI thread and wake the event loop of the worker up, which calls |dispatch|
+// with each of them. The worker replies with Reply() from its own thread, and
+// the reply is sent from the UI thread.
+class WorkerIPCQueue : public base::RefCountedThreadSafe<WorkerIPCQueue> {
+ public:
+  // Called on the thread of the worker, the queue closes itself when the
+  // Node environment of the worker is cleaned up.
+  static scoped_refptr<WorkerIPCQueue> Create(int pool_id,
+                                              v8::Isolate* isolate,
+                                              v8::Local<v8::Function> dispatch);
+
+  // The queue of the worker running on the calling thread, if any.
+  static WorkerIPCQueue* GetCurrent();
+
+  // Can be called from any thread, fails |invoke| once the queue is closed.
+  void Push(WorkerInvoke invoke);
+
+  // Called on the thread of the worker. Returns false when |reply_id| is not
+  // waiting for a reply or |result| can not be serialized.
+  bool Reply(int reply_id, v8::Local<v8::Value> result);
+
+  void Close();
+
+  int pool_id() const { return pool_id_; }
+  // The number of invokes pushed and not replied to yet.
+  int load() const { return load_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<WorkerIPCQueue>;
+
+  WorkerIPCQueue(int pool_id,
+                 v8::Isolate* isolate,
+                 v8::Local<v8::Function> dispatch);
+  ~WorkerIPCQueue();
+
+  static void OnAsync(uv_async_t* handle);
+  static void OnCleanup(void* arg);
+
+  void DispatchPending();
+
+  const int pool_id_;
+  std::atomic<int> load_{0};
+
+  base::Lock lock_;
+  bool closed_ = false;
+  std::deque<WorkerInvoke> pending_;
+  // Owned by the event loop of the worker once the queue is closed.
+  uv_async_t* async_;
+
+  // Only used on the thread of the worker.
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  v8::Global<v8::Function> dispatch_;
+  int next_reply_id_ = 1;
+  std::map<int, WorkerInvoke> waiting_for_reply_;
+  // Keeps the queue alive until it is closed.
+  scoped_refptr<WorkerIPCQueue> self_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerIPCQueue);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_WORKER_IPC_QUEUE_H_
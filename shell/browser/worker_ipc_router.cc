@@ -0,0 +1,152 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/worker_ipc_router.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "gin/data_object_builder.h"
+#include "shell/browser/worker_ipc_queue.h"
+#include "shell/common/gin_converters/blink_converter.h"
+
+namespace electron {
+
+namespace {
+
+void RunWithError(mojom::ElectronBrowser::InvokeCallback callback,
+                  const std::string& error) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  auto result = gin::DataObjectBuilder(isolate).Set("error", error).Build();
+  blink::CloneableMessage message;
+  if (gin::ConvertFromV8(isolate, result, &message))
+    std::move(callback).Run(std::move(message));
+}
+
+}  // namespace
+
+WorkerInvoke::WorkerInvoke() = default;
+WorkerInvoke::WorkerInvoke(WorkerInvoke&&) = default;
+WorkerInvoke& WorkerInvoke::operator=(WorkerInvoke&&) = default;
+WorkerInvoke::~WorkerInvoke() = default;
+
+WorkerIPCRouter::Pool::Pool() = default;
+WorkerIPCRouter::Pool::Pool(Pool&&) = default;
+WorkerIPCRouter::Pool::~Pool() = default;
+
+WorkerIPCRouter::WorkerIPCRouter() = default;
+WorkerIPCRouter::~WorkerIPCRouter() = default;
+
+// static
+WorkerIPCRouter* WorkerIPCRouter::GetInstance() {
+  static base::NoDestructor<WorkerIPCRouter> instance;
+  return instance.get();
+}
+
+// static
+void WorkerIPCRouter::ReplyWithError(WorkerInvoke invoke,
+                                     const std::string& error) {
+  invoke.reply_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(&RunWithError, std::move(invoke.callback), error));
+}
+
+int WorkerIPCRouter::CreatePool() {
+  base::AutoLock auto_lock(lock_);
+  int pool_id = next_pool_id_++;
+  pools_.emplace(pool_id, Pool());
+  return pool_id;
+}
+
+void WorkerIPCRouter::DestroyPool(int pool_id) {
+  std::deque<WorkerInvoke> backlog;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto it = pools_.find(pool_id);
+    if (it == pools_.end())
+      return;
+    backlog.swap(it->second.backlog);
+    pools_.erase(it);
+    for (auto channel = channels_.begin(); channel != channels_.end();) {
+      if (channel->second == pool_id)
+        channel = channels_.erase(channel);
+      else
+        ++channel;
+    }
+  }
+  for (auto& invoke : backlog)
+    ReplyWithError(std::move(invoke), "The worker pool was closed");
+}
+
+bool WorkerIPCRouter::Bind(const std::string& channel, int pool_id) {
+  base::AutoLock auto_lock(lock_);
+  if (!pools_.count(pool_id))
+    return false;
+  return channels_.emplace(channel, pool_id).second;
+}
+
+void WorkerIPCRouter::Unbind(const std::string& channel) {
+  base::AutoLock auto_lock(lock_);
+  channels_.erase(channel);
+}
+
+bool WorkerIPCRouter::HasChannel(const std::string& channel) {
+  base::AutoLock auto_lock(lock_);
+  return channels_.count(channel) > 0;
+}
+
+void WorkerIPCRouter::Dispatch(WorkerInvoke invoke) {
+  scoped_refptr<WorkerIPCQueue> queue;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto channel = channels_.find(invoke.channel);
+    if (channel != channels_.end()) {
+      Pool& pool = pools_[channel->second];
+      if (pool.queues.empty()) {
+        pool.backlog.push_back(std::move(invoke));
+        return;
+      }
+      queue = *std::min_element(
+          pool.queues.begin(), pool.queues.end(),
+          [](const scoped_refptr<WorkerIPCQueue>& a,
+             const scoped_refptr<WorkerIPCQueue>& b) {
+            return a->load() < b->load();
+          });
+    }
+  }
+  if (!queue) {
+    std::string error = "No handler registered for '" + invoke.channel + "'";
+    ReplyWithError(std::move(invoke), error);
+    return;
+  }
+  queue->Push(std::move(invoke));
+}
+
+bool WorkerIPCRouter::AddQueue(scoped_refptr<WorkerIPCQueue> queue) {
+  std::deque<WorkerInvoke> backlog;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto it = pools_.find(queue->pool_id());
+    if (it == pools_.end())
+      return false;
+    it->second.queues.push_back(queue);
+    backlog.swap(it->second.backlog);
+  }
+  for (auto& invoke : backlog)
+    queue->Push(std::move(invoke));
+  return true;
+}
+
+void WorkerIPCRouter::RemoveQueue(WorkerIPCQueue* queue) {
+  base::AutoLock auto_lock(lock_);
+  auto it = pools_.find(queue->pool_id());
+  if (it == pools_.end())
+    return;
+  auto& queues = it->second.queues;
+  queues.erase(std::remove(queues.begin(), queues.end(), queue), queues.end());
+}
+
+}  // namespace electron
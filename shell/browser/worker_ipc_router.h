@@ -0,0 +1,104 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_WORKER_IPC_ROUTER_H_
+#define SHELL_BROWSER_WORKER_IPC_ROUTER_H_
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/no_destructor.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "shell/common/v8_value_serializer.h"
+
+namespace electron {
+
+class WorkerIPCQueue;
+
+// An ipcRenderer.invoke() call on a channel handled in a worker thread of the
+// main process. |callback| has to be run on |reply_task_runner|.
+struct WorkerInvoke {
+  WorkerInvoke();
+  WorkerInvoke(WorkerInvoke&&);
+  WorkerInvoke& operator=(WorkerInvoke&&);
+  ~WorkerInvoke();
+
+  int32_t sender_id = 0;
+  int process_id = 0;
+  int frame_id = 0;
+  std::string channel;
+  SerializedValue args;
+  mojom::ElectronBrowser::InvokeCallback callback;
+  scoped_refptr<base::SequencedTaskRunner> reply_task_runner;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerInvoke);
+};
+
+// Routes the invokes of the channels bound to a worker pool straight to the
+// worker threads of the pool, without deserializing their arguments in the
+// isolate of the UI thread nor running any JavaScript there.
+//
+// The pools are created and their channels bound from the UI thread, while
+// the workers add their queue from their own thread once they are ready to
+// handle invokes, hence the lock.
+class WorkerIPCRouter {
+ public:
+  static WorkerIPCRouter* GetInstance();
+
+  // Replies to |invoke| with |error| on its reply task runner.
+  static void ReplyWithError(WorkerInvoke invoke, const std::string& error);
+
+  int CreatePool();
+  // Unbinds the channels of the pool and fails the invokes still waiting for
+  // one of its workers. The queues of the workers are left for the workers to
+  // remove as they exit.
+  void DestroyPool(int pool_id);
+
+  // Returns false when |channel| is already bound or the pool is gone.
+  bool Bind(const std::string& channel, int pool_id);
+  void Unbind(const std::string& channel);
+  bool HasChannel(const std::string& channel);
+
+  // Sends |invoke| to the least busy worker of the pool its channel is bound
+  // to, or keeps it until a worker of the pool is ready.
+  void Dispatch(WorkerInvoke invoke);
+
+  // Returns false when the pool of |queue| is gone.
+  bool AddQueue(scoped_refptr<WorkerIPCQueue> queue);
+  void RemoveQueue(WorkerIPCQueue* queue);
+
+ private:
+  friend class base::NoDestructor<WorkerIPCRouter>;
+
+  struct Pool {
+    Pool();
+    Pool(Pool&&);
+    ~Pool();
+
+    std::vector<scoped_refptr<WorkerIPCQueue>> queues;
+    // Invokes received before any worker of the pool was ready.
+    std::deque<WorkerInvoke> backlog;
+  };
+
+  WorkerIPCRouter();
+  ~WorkerIPCRouter();
+
+  base::Lock lock_;
+  int next_pool_id_ = 1;
+  std::map<int, Pool> pools_;
+  // Channel => ID of the pool handling it.
+  std::map<std::string, int> channels_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerIPCRouter);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_WORKER_IPC_ROUTER_H_
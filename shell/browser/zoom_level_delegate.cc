@@ -6,9 +6,11 @@
 
 #include <functional>
 #include <memory>
-#include <vector>
+#include <set>
+#include <string>
 
 #include "base/bind.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/values.h"
 #include "components/prefs/json_pref_store.h"
@@ -27,9 +29,13 @@ namespace {
 const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 
 // Dictionary that maps hostnames to zoom levels.  Hosts not in this pref will
-// be displayed at the default zoom level.
+// be displayed at the default zoom level. Only read to migrate the levels to
+// the HostZoomLevelStore of the partition.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+const base::FilePath::CharType kZoomLevelsFileName[] =
+    FILE_PATH_LITERAL("Zoom Levels");
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
@@ -45,7 +51,9 @@ void ZoomLevelDelegate::RegisterPrefs(PrefRegistrySimple* registry) {
 
 ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
                                      const base::FilePath& partition_path)
-    : pref_service_(pref_service), host_zoom_map_(nullptr) {
+    : pref_service_(pref_service),
+      host_zoom_map_(nullptr),
+      host_zoom_level_store_(partition_path.Append(kZoomLevelsFileName)) {
   DCHECK(pref_service_);
   partition_key_ = GetHash(partition_path);
 }
@@ -78,29 +86,18 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     return;
 
   double level = change.zoom_level;
-  DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-  base::DictionaryValue* host_zoom_dictionaries = update.Get();
-  DCHECK(host_zoom_dictionaries);
-
   bool modification_is_removal =
       blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
 
-  base::DictionaryValue* host_zoom_dictionary = nullptr;
-  if (!host_zoom_dictionaries->GetDictionary(partition_key_,
-                                             &host_zoom_dictionary)) {
-    host_zoom_dictionary = host_zoom_dictionaries->SetDictionary(
-        partition_key_, std::make_unique<base::DictionaryValue>());
-  }
-
   if (modification_is_removal)
-    host_zoom_dictionary->RemoveWithoutPathExpansion(change.host, nullptr);
+    host_zoom_level_store_.Remove(change.host);
   else
-    host_zoom_dictionary->SetKey(change.host, base::Value(level));
+    host_zoom_level_store_.Set(change.host, level);
 }
 
-void ZoomLevelDelegate::ExtractPerHostZoomLevels(
-    const base::DictionaryValue* host_zoom_dictionary) {
-  std::vector<std::string> keys_to_remove;
+void ZoomLevelDelegate::MigratePerHostZoomLevels(
+    const base::DictionaryValue* host_zoom_dictionary,
+    const std::set<std::string>& stored_hosts) {
   std::unique_ptr<base::DictionaryValue> host_zoom_dictionary_copy =
       host_zoom_dictionary->DeepCopyWithoutEmptyChildren();
   for (base::DictionaryValue::Iterator i(*host_zoom_dictionary_copy);
@@ -110,33 +107,23 @@ void ZoomLevelDelegate::ExtractPerHostZoomLevels(
 
     bool has_valid_zoom_level = i.value().GetAsDouble(&zoom_level);
 
-    // Filter out A) the empty host, B) zoom levels equal to the default; and
-    // remember them, so that we can later erase them from Prefs.
+    // Filter out A) the empty host, B) zoom levels equal to the default.
     // Values of type B could further have been stored before the default zoom
     // level was set to its current value. In either case, SetZoomLevelForHost
-    // will ignore type B values, thus, to have consistency with HostZoomMap's
-    // internal state, these values must also be removed from Prefs.
+    // will ignore type B values, so they are not worth keeping.
     if (host.empty() || !has_valid_zoom_level ||
         blink::PageZoomValuesEqual(zoom_level,
-                                   host_zoom_map_->GetDefaultZoomLevel())) {
-      keys_to_remove.push_back(host);
+                                   host_zoom_map_->GetDefaultZoomLevel()) ||
+        base::Contains(stored_hosts, host)) {
       continue;
     }
 
     host_zoom_map_->SetZoomLevelForHost(host, zoom_level);
+    host_zoom_level_store_.Set(host, zoom_level);
   }
 
-  // Sanitize prefs to remove entries that match the default zoom level and/or
-  // have an empty host.
-  {
-    DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-    base::DictionaryValue* host_zoom_dictionaries = update.Get();
-    base::DictionaryValue* sanitized_host_zoom_dictionary = nullptr;
-    host_zoom_dictionaries->GetDictionary(partition_key_,
-                                          &sanitized_host_zoom_dictionary);
-    for (const std::string& s : keys_to_remove)
-      sanitized_host_zoom_dictionary->RemoveWithoutPathExpansion(s, nullptr);
-  }
+  DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
+  update->RemoveWithoutPathExpansion(partition_key_, nullptr);
 }
 
 void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
@@ -148,8 +135,19 @@ void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
   // Initialize the default zoom level.
   host_zoom_map_->SetDefaultZoomLevel(GetDefaultZoomLevelPref());
 
-  // Initialize the HostZoomMap with per-host zoom levels from the persisted
-  // zoom-level preference values.
+  // Initialize the HostZoomMap with the per-host zoom levels of the store,
+  // dropping the ones equal to the default, see MigratePerHostZoomLevels().
+  std::set<std::string> stored_hosts;
+  for (const auto& entry : host_zoom_level_store_.Load()) {
+    if (blink::PageZoomValuesEqual(entry.second,
+                                   host_zoom_map_->GetDefaultZoomLevel())) {
+      host_zoom_level_store_.Remove(entry.first);
+      continue;
+    }
+    host_zoom_map_->SetZoomLevelForHost(entry.first, entry.second);
+    stored_hosts.insert(entry.first);
+  }
+
   const base::DictionaryValue* host_zoom_dictionaries =
       pref_service_->GetDictionary(kPartitionPerHostZoomLevels);
   const base::DictionaryValue* host_zoom_dictionary = nullptr;
@@ -158,7 +156,7 @@ void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
     // Since we're calling this before setting up zoom_subscription_ below we
     // don't need to worry that host_zoom_dictionary is indirectly affected
     // by calls to HostZoomMap::SetZoomLevelForHost().
-    ExtractPerHostZoomLevels(host_zoom_dictionary);
+    MigratePerHostZoomLevels(host_zoom_dictionary, stored_hosts);
   }
   zoom_subscription_ =
       host_zoom_map_->AddZoomLevelChangedCallback(base::BindRepeating(
@@ -6,6 +6,7 @@
 #define SHELL_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/files/file_path.h"
@@ -13,6 +14,7 @@
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/zoom_level_delegate.h"
+#include "shell/browser/host_zoom_level_store.h"
 
 namespace base {
 class DictionaryValue;
@@ -27,7 +29,7 @@ namespace electron {
 // levels in HostZoomMap and preference system. All changes
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
-// OnZoomLevelChanged.
+// OnZoomLevelChanged, and kept in a HostZoomLevelStore of the partition.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
@@ -43,8 +45,11 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void InitHostZoomMap(content::HostZoomMap* host_zoom_map) override;
 
  private:
-  void ExtractPerHostZoomLevels(
-      const base::DictionaryValue* host_zoom_dictionary);
+  // Moves the per-host zoom levels that older versions kept in the
+  // preferences to the store, except the ones of |stored_hosts|.
+  void MigratePerHostZoomLevels(
+      const base::DictionaryValue* host_zoom_dictionary,
+      const std::set<std::string>& stored_hosts);
 
   // This is a callback function that receives notifications from HostZoomMap
   // when per-host zoom levels change. It is used to update the per-host
@@ -55,6 +60,7 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   content::HostZoomMap* host_zoom_map_;
   std::unique_ptr<content::HostZoomMap::Subscription> zoom_subscription_;
   std::string partition_key_;
+  HostZoomLevelStore host_zoom_level_store_;
 
   DISALLOW_COPY_AND_ASSIGN(ZoomLevelDelegate);
 };
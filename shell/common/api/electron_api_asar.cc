@@ -4,6 +4,8 @@
 
 #include <stddef.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "shell/common/asar/archive.h"
@@ -21,8 +23,11 @@ class Archive : public gin_helper::Wrappable<Archive> {
  public:
   static v8::Local<v8::Value> Create(v8::Isolate* isolate,
                                      const base::FilePath& path) {
-    auto archive = std::make_unique<asar::Archive>(path);
-    if (!archive->Init())
+    // Share the archive with the native readers and the other threads, so the
+    // header is only parsed once per process.
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(path);
+    if (!archive)
       return v8::False(isolate);
     return (new Archive(isolate, std::move(archive)))->GetWrapper();
   }
@@ -37,11 +42,13 @@ class Archive : public gin_helper::Wrappable<Archive> {
         .SetMethod("readdir", &Archive::Readdir)
         .SetMethod("realpath", &Archive::Realpath)
         .SetMethod("copyFileOut", &Archive::CopyFileOut)
+        .SetMethod("readFile", &Archive::ReadFile)
+        .SetMethod("writeIndex", &Archive::WriteIndex)
         .SetMethod("getFd", &Archive::GetFD);
   }
 
  protected:
-  Archive(v8::Isolate* isolate, std::unique_ptr<asar::Archive> archive)
+  Archive(v8::Isolate* isolate, std::shared_ptr<asar::Archive> archive)
       : archive_(std::move(archive)) {
     Init(isolate);
   }
@@ -59,6 +66,8 @@ class Archive : public gin_helper::Wrappable<Archive> {
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
     dict.Set("offset", info.offset);
+    dict.Set("compressed", info.compression != asar::Compression::kNone);
+    dict.Set("integrity", info.has_integrity());
     return dict.GetHandle();
   }
 
@@ -103,6 +112,54 @@ class Archive : public gin_helper::Wrappable<Archive> {
     return gin::ConvertToV8(isolate, new_path);
   }
 
+  // Reads the packed contents of a file from the memory-mapped archive, or
+  // decompresses them for compressed files. Returns false when the caller
+  // should fall back to reading from the fd.
+  v8::Local<v8::Value> ReadFile(v8::Isolate* isolate,
+                                const base::FilePath& path,
+                                bool as_utf8_string) {
+    asar::Archive::FileInfo info;
+    if (!archive_ || !archive_->GetFileInfo(path, &info))
+      return v8::False(isolate);
+
+    base::StringPiece contents;
+    std::string decompressed;
+    base::span<const uint8_t> mapped;
+    if (archive_->GetMappedContents(info, &mapped)) {
+      contents = base::StringPiece(
+          reinterpret_cast<const char*>(mapped.data()), mapped.size());
+    } else if (info.compression != asar::Compression::kNone ||
+               info.has_integrity()) {
+      // These can not be read from the fd directly.
+      if (!archive_->ReadFileContents(info, &decompressed))
+        return v8::False(isolate);
+      contents = decompressed;
+    } else {
+      return v8::False(isolate);
+    }
+
+    if (as_utf8_string) {
+      // Decode straight from the contents instead of going through a Buffer.
+      v8::Local<v8::String> str;
+      if (!v8::String::NewFromUtf8(isolate, contents.data(),
+                                   v8::NewStringType::kNormal, contents.size())
+               .ToLocal(&str))
+        return v8::False(isolate);
+      return str;
+    }
+
+    v8::Local<v8::Object> buffer;
+    if (!node::Buffer::Copy(isolate, contents.data(), contents.size())
+             .ToLocal(&buffer))
+      return v8::False(isolate);
+    return buffer;
+  }
+
+  // Writes the precompiled index of the archive to |path|.
+  bool WriteIndex(const base::FilePath& path) {
+    return archive_ && archive_->WriteIndex(path);
+  }
+
   // Return the file descriptor.
   int GetFD() const {
     if (!archive_)
@@ -111,7 +168,7 @@ class Archive : public gin_helper::Wrappable<Archive> {
   }
 
  private:
-  std::unique_ptr<asar::Archive> archive_;
+  std::shared_ptr<asar::Archive> archive_;
 
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
@@ -147,6 +204,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("createArchive", &Archive::Create);
   dict.SetMethod("splitPath", &SplitPath);
+  dict.SetMethod("logArchiveRead", &asar::LogArchiveRead);
   dict.SetMethod("initAsarSupport", &InitAsarSupport);
 }
 
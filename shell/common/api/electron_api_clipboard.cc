@@ -4,20 +4,161 @@
 
 #include "shell/common/api/electron_api_clipboard.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/base/clipboard/clipboard_constants.h"
 #include "ui/base/clipboard/clipboard_format_type.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/gfx/codec/png_codec.h"
 
 namespace electron {
 
 namespace api {
 
+namespace {
+
+base::string16 ReadTextFrom(ui::Clipboard* clipboard,
+                            ui::ClipboardBuffer type) {
+  base::string16 data;
+  if (clipboard->IsFormatAvailable(ui::ClipboardFormatType::GetPlainTextType(),
+                                   type)) {
+    clipboard->ReadText(type, &data);
+  } else {
+#if defined(OS_WIN)
+    if (clipboard->IsFormatAvailable(
+            ui::ClipboardFormatType::GetPlainTextAType(), type)) {
+      std::string result;
+      clipboard->ReadAsciiText(type, &result);
+      data = base::ASCIIToUTF16(result);
+    }
+#endif
+  }
+  return data;
+}
+
+base::string16 ReadHTMLFrom(ui::Clipboard* clipboard,
+                            ui::ClipboardBuffer type) {
+  base::string16 html;
+  std::string url;
+  uint32_t start;
+  uint32_t end;
+  clipboard->ReadHTML(type, &html, &url, &start, &end);
+  return html.substr(start, end - start);
+}
+
+base::string16 ReadRTFFrom(ui::Clipboard* clipboard,
+                           ui::ClipboardBuffer type) {
+  std::string data;
+  clipboard->ReadRTF(type, &data);
+  return base::UTF8ToUTF16(data);
+}
+
+gfx::Image ReadImageFrom(ui::Clipboard* clipboard, ui::ClipboardBuffer type) {
+  SkBitmap bitmap = clipboard->ReadImage(type);
+  return gfx::Image::CreateFrom1xBitmap(bitmap);
+}
+
+#if defined(USE_X11)
+constexpr base::TaskTraits kReadTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_BLOCKING};
+
+// Runs on the thread pool, returns null when the data has to be read from
+// ui::Clipboard instead.
+std::unique_ptr<std::string> ReadSelection(ui::ClipboardBuffer type,
+                                           const std::string& target) {
+  auto data = std::make_unique<std::string>();
+  if (!ReadX11Selection(type, target, data.get()))
+    return nullptr;
+  return data;
+}
+
+// Tries the text targets in the order of ui::Clipboard. STRING and TEXT are
+// only offered by older owners, and hold Latin-1.
+std::unique_ptr<base::string16> ReadSelectionText(ui::ClipboardBuffer type) {
+  auto text = std::make_unique<base::string16>();
+  for (const char* target : {"UTF8_STRING", ui::kMimeTypeText}) {
+    std::unique_ptr<std::string> data = ReadSelection(type, target);
+    if (!data)
+      return nullptr;
+    if (!data->empty()) {
+      *text = base::UTF8ToUTF16(*data);
+      return text;
+    }
+  }
+  for (const char* target : {"STRING", "TEXT"}) {
+    std::unique_ptr<std::string> data = ReadSelection(type, target);
+    if (!data)
+      return nullptr;
+    if (!data->empty()) {
+      text->assign(data->begin(), data->end());
+      return text;
+    }
+  }
+  return text;
+}
+
+std::unique_ptr<SkBitmap> ReadSelectionImage(ui::ClipboardBuffer type) {
+  std::unique_ptr<std::string> data = ReadSelection(type, ui::kMimeTypePNG);
+  if (!data)
+    return nullptr;
+  auto bitmap = std::make_unique<SkBitmap>();
+  if (!data->empty()) {
+    gfx::PNGCodec::Decode(reinterpret_cast<const uint8_t*>(data->data()),
+                          data->size(), bitmap.get());
+  }
+  return bitmap;
+}
+#endif
+
+void OnTextRead(gin_helper::Promise<base::string16> promise,
+                ui::ClipboardBuffer type,
+                std::unique_ptr<base::string16> text) {
+  if (text)
+    promise.Resolve(*text);
+  else
+    promise.Resolve(ReadTextFrom(ui::Clipboard::GetForCurrentThread(), type));
+}
+
+void OnImageRead(gin_helper::Promise<gfx::Image> promise,
+                 ui::ClipboardBuffer type,
+                 std::unique_ptr<SkBitmap> bitmap) {
+  if (bitmap)
+    promise.Resolve(gfx::Image::CreateFrom1xBitmap(*bitmap));
+  else
+    promise.Resolve(ReadImageFrom(ui::Clipboard::GetForCurrentThread(), type));
+}
+
+void OnBufferRead(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                  const std::string& format_string,
+                  std::unique_ptr<std::string> data) {
+  std::string result;
+  if (data) {
+    result = std::move(*data);
+  } else {
+    ui::Clipboard::GetForCurrentThread()->ReadData(
+        ui::ClipboardFormatType::GetType(format_string), &result);
+  }
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(node::Buffer::Copy(isolate, result.data(), result.length())
+                      .ToLocalChecked());
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -61,6 +202,52 @@ v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
       .ToLocalChecked();
 }
 
+v8::Local<v8::Value> Clipboard::ReadMany(
+    const std::vector<std::string>& formats,
+    gin_helper::Arguments* args) {
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  auto type = GetClipboardBuffer(args);
+
+  // Each read can be a round trip to the clipboard owner, so the formats that
+  // are not on the clipboard are skipped without asking for them.
+  std::vector<base::string16> available;
+  bool ignore;
+  clipboard->ReadAvailableTypes(type, &available, &ignore);
+  auto has_type = [&available](const char* mime_type) {
+    return std::find(available.begin(), available.end(),
+                     base::ASCIIToUTF16(mime_type)) != available.end();
+  };
+
+  gin_helper::Dictionary dict =
+      gin_helper::Dictionary::CreateEmpty(args->isolate());
+  for (const auto& format : formats) {
+    if (format == "text" || format == ui::kMimeTypeText) {
+      if (has_type(ui::kMimeTypeText))
+        dict.Set(format, ReadTextFrom(clipboard, type));
+    } else if (format == "html" || format == ui::kMimeTypeHTML) {
+      if (has_type(ui::kMimeTypeHTML))
+        dict.Set(format, ReadHTMLFrom(clipboard, type));
+    } else if (format == "rtf" || format == ui::kMimeTypeRTF) {
+      if (has_type(ui::kMimeTypeRTF))
+        dict.Set(format, ReadRTFFrom(clipboard, type));
+    } else if (format == "image" || format == ui::kMimeTypePNG) {
+      if (has_type(ui::kMimeTypePNG))
+        dict.Set(format, ReadImageFrom(clipboard, type));
+    } else {
+      ui::ClipboardFormatType format_type(
+          ui::ClipboardFormatType::GetType(format));
+      if (!clipboard->IsFormatAvailable(format_type, type))
+        continue;
+      std::string data;
+      clipboard->ReadData(format_type, &data);
+      dict.Set(format, node::Buffer::Copy(args->isolate(), data.data(),
+                                          data.length())
+                           .ToLocalChecked());
+    }
+  }
+  return dict.GetHandle();
+}
+
 void Clipboard::WriteBuffer(const std::string& format,
                             const v8::Local<v8::Value> buffer,
                             gin_helper::Arguments* args) {
@@ -104,23 +291,8 @@ void Clipboard::Write(const gin_helper::Dictionary& data,
 }
 
 base::string16 Clipboard::ReadText(gin_helper::Arguments* args) {
-  base::string16 data;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  auto type = GetClipboardBuffer(args);
-  if (clipboard->IsFormatAvailable(ui::ClipboardFormatType::GetPlainTextType(),
-                                   type)) {
-    clipboard->ReadText(type, &data);
-  } else {
-#if defined(OS_WIN)
-    if (clipboard->IsFormatAvailable(
-            ui::ClipboardFormatType::GetPlainTextAType(), type)) {
-      std::string result;
-      clipboard->ReadAsciiText(type, &result);
-      data = base::ASCIIToUTF16(result);
-    }
-#endif
-  }
-  return data;
+  return ReadTextFrom(ui::Clipboard::GetForCurrentThread(),
+                      GetClipboardBuffer(args));
 }
 
 void Clipboard::WriteText(const base::string16& text,
@@ -130,10 +302,8 @@ void Clipboard::WriteText(const base::string16& text,
 }
 
 base::string16 Clipboard::ReadRTF(gin_helper::Arguments* args) {
-  std::string data;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadRTF(GetClipboardBuffer(args), &data);
-  return base::UTF8ToUTF16(data);
+  return ReadRTFFrom(ui::Clipboard::GetForCurrentThread(),
+                     GetClipboardBuffer(args));
 }
 
 void Clipboard::WriteRTF(const std::string& text, gin_helper::Arguments* args) {
@@ -142,15 +312,8 @@ void Clipboard::WriteRTF(const std::string& text, gin_helper::Arguments* args) {
 }
 
 base::string16 Clipboard::ReadHTML(gin_helper::Arguments* args) {
-  base::string16 data;
-  base::string16 html;
-  std::string url;
-  uint32_t start;
-  uint32_t end;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadHTML(GetClipboardBuffer(args), &html, &url, &start, &end);
-  data = html.substr(start, end - start);
-  return data;
+  return ReadHTMLFrom(ui::Clipboard::GetForCurrentThread(),
+                      GetClipboardBuffer(args));
 }
 
 void Clipboard::WriteHTML(const base::string16& html,
@@ -179,9 +342,8 @@ void Clipboard::WriteBookmark(const base::string16& title,
 }
 
 gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  SkBitmap bitmap = clipboard->ReadImage(GetClipboardBuffer(args));
-  return gfx::Image::CreateFrom1xBitmap(bitmap);
+  return ReadImageFrom(ui::Clipboard::GetForCurrentThread(),
+                       GetClipboardBuffer(args));
 }
 
 void Clipboard::WriteImage(const gfx::Image& image,
@@ -196,6 +358,51 @@ void Clipboard::WriteImage(const gfx::Image& image,
   }
 }
 
+v8::Local<v8::Promise> Clipboard::ReadTextAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<base::string16> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  auto type = GetClipboardBuffer(args);
+#if defined(USE_X11)
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kReadTaskTraits,
+      base::BindOnce(&ReadSelectionText, type),
+      base::BindOnce(&OnTextRead, std::move(promise), type));
+#else
+  OnTextRead(std::move(promise), type, nullptr);
+#endif
+  return handle;
+}
+
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  auto type = GetClipboardBuffer(args);
+#if defined(USE_X11)
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kReadTaskTraits, base::BindOnce(&ReadSelectionImage, type),
+      base::BindOnce(&OnImageRead, std::move(promise), type));
+#else
+  OnImageRead(std::move(promise), type, nullptr);
+#endif
+  return handle;
+}
+
+v8::Local<v8::Promise> Clipboard::ReadBufferAsync(
+    const std::string& format_string,
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+#if defined(USE_X11)
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kReadTaskTraits,
+      base::BindOnce(&ReadSelection, GetClipboardBuffer(args), format_string),
+      base::BindOnce(&OnBufferRead, std::move(promise), format_string));
+#else
+  OnBufferRead(std::move(promise), format_string, nullptr);
+#endif
+  return handle;
+}
+
 #if !defined(OS_MACOSX)
 void Clipboard::WriteFindText(const base::string16& text) {}
 base::string16 Clipboard::ReadFindText() {
@@ -233,8 +440,13 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
+  dict.SetMethod("readTextAsync", &electron::api::Clipboard::ReadTextAsync);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
+  dict.SetMethod("readBufferAsync",
+                 &electron::api::Clipboard::ReadBufferAsync);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
+  dict.SetMethod("readMany", &electron::api::Clipboard::ReadMany);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
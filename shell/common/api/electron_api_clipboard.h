@@ -53,9 +53,22 @@ class Clipboard {
   static gfx::Image ReadImage(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
+  // Like the reads above, but on X11 the data is transferred off the thread
+  // of the clipboard, so that a slow selection owner does not block it.
+  static v8::Local<v8::Promise> ReadTextAsync(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadBufferAsync(
+      const std::string& format_string,
+      gin_helper::Arguments* args);
+
   static base::string16 ReadFindText();
   static void WriteFindText(const base::string16& text);
 
+  // Reads all the available |formats| at once, with a single query of the
+  // formats on the clipboard.
+  static v8::Local<v8::Value> ReadMany(const std::vector<std::string>& formats,
+                                       gin_helper::Arguments* args);
+
   static v8::Local<v8::Value> ReadBuffer(const std::string& format_string,
                                          gin_helper::Arguments* args);
   static void WriteBuffer(const std::string& format_string,
@@ -66,6 +79,15 @@ class Clipboard {
   DISALLOW_COPY_AND_ASSIGN(Clipboard);
 };
 
+#if defined(USE_X11)
+// Reads |target| from the X selection of |buffer| on an X connection of its
+// own, blocking until the selection owner answers. |data| is left empty when
+// the target is not available, returns false when there is no X server.
+bool ReadX11Selection(ui::ClipboardBuffer buffer,
+                      const std::string& target,
+                      std::string* data);
+#endif
+
 }  // namespace api
 
 }  // namespace electron
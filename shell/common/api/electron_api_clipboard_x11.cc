@@ -0,0 +1,128 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/api/electron_api_clipboard.h"
+
+#include <X11/Xatom.h>
+#include <errno.h>
+#include <poll.h>
+
+#include "base/threading/scoped_blocking_call.h"
+#include "base/time/time.h"
+#include "ui/gfx/x/x11.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// How long the selection owner has to answer each request, like the
+// clipboard of Chromium.
+constexpr base::TimeDelta kRequestTimeout = base::TimeDelta::FromSeconds(10);
+
+// Waits for an event of |type| for |window|, returns false on timeout.
+bool WaitForEvent(XDisplay* display,
+                  ::Window window,
+                  int type,
+                  XEvent* event) {
+  base::TimeTicks deadline = base::TimeTicks::Now() + kRequestTimeout;
+  XFlush(display);
+  while (!XCheckTypedWindowEvent(display, window, type, event)) {
+    base::TimeDelta remaining = deadline - base::TimeTicks::Now();
+    if (remaining <= base::TimeDelta())
+      return false;
+    pollfd fd = {ConnectionNumber(display), POLLIN, 0};
+    if (poll(&fd, 1, remaining.InMilliseconds() + 1) < 0 && errno != EINTR)
+      return false;
+  }
+  return true;
+}
+
+// Reads and deletes |property| of |window|.
+bool TakeProperty(XDisplay* display,
+                  ::Window window,
+                  ::Atom property,
+                  ::Atom* type,
+                  std::string* data) {
+  int format = 0;
+  unsigned long item_count = 0;  // NOLINT(runtime/int)
+  unsigned long bytes_after = 0;  // NOLINT(runtime/int)
+  unsigned char* value = nullptr;
+  if (XGetWindowProperty(display, window, property, 0, ~0L >> 2, x11::True,
+                         AnyPropertyType, type, &format, &item_count,
+                         &bytes_after, &value) != x11::Success) {
+    return false;
+  }
+  // Xlib returns the items of 32 bit properties as longs.
+  size_t item_size = format == 32 ? sizeof(long) : format / 8;  // NOLINT
+  if (value) {
+    data->assign(reinterpret_cast<const char*>(value),
+                 item_count * item_size);
+    XFree(value);
+  } else {
+    data->clear();
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ReadX11Selection(ui::ClipboardBuffer buffer,
+                      const std::string& target,
+                      std::string* data) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::WILL_BLOCK);
+  data->clear();
+  XDisplay* display = XOpenDisplay(nullptr);
+  if (!display)
+    return false;
+
+  ::Window window = XCreateSimpleWindow(display, DefaultRootWindow(display),
+                                        0, 0, 1, 1, 0, 0, 0);
+  XSelectInput(display, window, PropertyChangeMask);
+  ::Atom selection = buffer == ui::ClipboardBuffer::kSelection
+                         ? XA_PRIMARY
+                         : XInternAtom(display, "CLIPBOARD", x11::False);
+  ::Atom property = XInternAtom(display, "ELECTRON_SELECTION", x11::False);
+  ::Atom incr = XInternAtom(display, "INCR", x11::False);
+  XConvertSelection(display, selection,
+                    XInternAtom(display, target.c_str(), x11::False), property,
+                    window, x11::CurrentTime);
+
+  XEvent event;
+  ::Atom type = x11::None;
+  if (WaitForEvent(display, window, SelectionNotify, &event) &&
+      event.xselection.property != x11::None &&
+      TakeProperty(display, window, property, &type, data) && type == incr) {
+    // Large payloads come in chunks, each one is requested by deleting the
+    // property, and an empty chunk ends the transfer.
+    data->clear();
+    std::string chunk;
+    while (true) {
+      if (!WaitForEvent(display, window, PropertyNotify, &event)) {
+        // A partial payload is of no use.
+        data->clear();
+        break;
+      }
+      if (event.xproperty.atom != property ||
+          event.xproperty.state != PropertyNewValue) {
+        continue;
+      }
+      if (!TakeProperty(display, window, property, &type, &chunk) ||
+          chunk.empty()) {
+        break;
+      }
+      data->append(chunk);
+    }
+  }
+
+  XDestroyWindow(display, window);
+  XCloseDisplay(display);
+  return true;
+}
+
+}  // namespace api
+
+}  // namespace electron
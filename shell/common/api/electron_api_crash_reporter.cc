@@ -7,11 +7,17 @@
 
 #include "base/bind.h"
 #include "gin/data_object_builder.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
 #include "shell/common/crash_reporter/crash_reporter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 
+#if defined(OS_WIN) || defined(OS_LINUX) || \
+    (defined(OS_MACOSX) && !defined(MAS_BUILD))
+#include "shell/common/crash_reporter/hang_watchdog.h"
+#endif
+
 #include "shell/common/node_includes.h"
 
 using crash_reporter::CrashReporter;
@@ -36,6 +42,14 @@ struct Converter<CrashReporter::UploadReportResult> {
 
 namespace {
 
+void StartHangWatchdog(v8::Isolate* isolate, double timeout) {
+#if defined(OS_WIN) || defined(OS_LINUX) || \
+    (defined(OS_MACOSX) && !defined(MAS_BUILD))
+  crash_reporter::HangWatchdog::Start(
+      isolate, base::TimeDelta::FromMillisecondsD(timeout));
+#endif
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -60,6 +74,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod(
       "getUploadToServer",
       base::BindRepeating(&CrashReporter::GetUploadToServer, reporter));
+  dict.SetMethod("startHangWatchdog", &StartHangWatchdog);
+  dict.SetMethod("setBreadcrumbsEnabled",
+                 &crash_reporter::SetBreadcrumbsEnabled);
 }
 
 }  // namespace
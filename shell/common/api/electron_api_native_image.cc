@@ -9,10 +9,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
@@ -22,8 +24,10 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -98,7 +102,167 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 }
 #endif
 
-void Noop(char*, void*) {}
+void UnrefPixels(char*, void* hint) {
+  static_cast<SkPixelRef*>(hint)->unref();
+}
+
+void ReleaseBackingStore(void*, void* context) {
+  delete static_cast<std::shared_ptr<v8::BackingStore>*>(context);
+}
+
+// The images are encoded and decoded for the page, but with a lower priority
+// than the requests the user is waiting for.
+constexpr base::TaskTraits kCodecTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE};
+
+v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate,
+                              const std::vector<unsigned char>& data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  return node::Buffer::Copy(isolate, reinterpret_cast<const char*>(&data[0]),
+                            data.size())
+      .ToLocalChecked();
+}
+
+void ResolveWithBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(ToBuffer(isolate, data));
+}
+
+// Returns pixels of |bitmap| that can be read from another thread. Mutable
+// pixels may be written through getBitmap() while they are read, so they are
+// copied first.
+SkBitmap GetBitmapForThreadPool(const SkBitmap& bitmap) {
+  if (bitmap.isImmutable())
+    return bitmap;
+  SkBitmap copy;
+  if (!copy.tryAllocPixels(bitmap.info()) || !bitmap.readPixels(copy.pixmap()))
+    return SkBitmap();
+  copy.setImmutable();
+  return copy;
+}
+
+std::vector<gfx::ImageSkiaRep> GetRepresentationsForThreadPool(
+    const std::vector<gfx::ImageSkiaRep>& reps) {
+  std::vector<gfx::ImageSkiaRep> copied_reps;
+  for (const auto& rep : reps) {
+    copied_reps.emplace_back(GetBitmapForThreadPool(rep.GetBitmap()),
+                             rep.scale());
+  }
+  return copied_reps;
+}
+
+// Runs |encode| on the thread pool, and resolves with the data it returns.
+v8::Local<v8::Promise> EncodeAsync(
+    v8::Isolate* isolate,
+    base::OnceCallback<std::vector<unsigned char>()> encode) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kCodecTaskTraits, std::move(encode),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+struct ResizeOptions {
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method =
+      skia::ImageOperations::RESIZE_BEST;
+  // Whether the image is scaled with the bilinear filter of Skia's raster
+  // pipeline, the fastest method, rather than with a convolution.
+  bool bilinear = false;
+};
+
+ResizeOptions GetResizeOptions(const gfx::Size& image_size,
+                               float aspect_ratio,
+                               const base::DictionaryValue& options) {
+  ResizeOptions resize;
+  int width = image_size.width();
+  int height = image_size.height();
+  bool width_set = options.GetInteger("width", &width);
+  bool height_set = options.GetInteger("height", &height);
+  resize.size.SetSize(width, height);
+
+  if (width_set && !height_set) {
+    // Scale height to preserve original aspect ratio
+    resize.size.set_height(width);
+    resize.size = gfx::ScaleToRoundedSize(resize.size, 1.f, 1.f / aspect_ratio);
+  } else if (height_set && !width_set) {
+    // Scale width to preserve original aspect ratio
+    resize.size.set_width(height);
+    resize.size = gfx::ScaleToRoundedSize(resize.size, aspect_ratio, 1.f);
+  }
+
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good") {
+    resize.method = skia::ImageOperations::RESIZE_GOOD;
+  } else if (quality == "better") {
+    resize.method = skia::ImageOperations::RESIZE_BETTER;
+  } else if (quality == "box") {
+    resize.method = skia::ImageOperations::RESIZE_BOX;
+  } else if (quality == "lanczos") {
+    resize.method = skia::ImageOperations::RESIZE_LANCZOS3;
+  } else if (quality == "bilinear") {
+    resize.bilinear = true;
+  }
+  return resize;
+}
+
+SkBitmap ResizeBitmap(const SkBitmap& bitmap,
+                      const ResizeOptions& resize,
+                      const gfx::Size& size) {
+  if (!resize.bilinear) {
+    return skia::ImageOperations::Resize(bitmap, resize.method, size.width(),
+                                         size.height());
+  }
+  SkBitmap resized;
+  SkPixmap pixmap;
+  if (!bitmap.peekPixels(&pixmap) ||
+      !resized.tryAllocPixels(bitmap.info().makeWH(size.width(),
+                                                   size.height()))) {
+    return SkBitmap();
+  }
+  SkPixmap resized_pixmap;
+  resized.peekPixels(&resized_pixmap);
+  if (!pixmap.scalePixels(resized_pixmap, kLow_SkFilterQuality))
+    return SkBitmap();
+  return resized;
+}
+
+// Resizes each of |reps| to |resize.size|, can run on any thread.
+std::vector<gfx::ImageSkiaRep> ResizeRepresentations(
+    const std::vector<gfx::ImageSkiaRep>& reps,
+    const ResizeOptions& resize) {
+  std::vector<gfx::ImageSkiaRep> resized_reps;
+  if (resize.size.IsEmpty())
+    return resized_reps;
+  for (const auto& rep : reps) {
+    gfx::Size pixel_size = gfx::ScaleToCeiledSize(resize.size, rep.scale());
+    SkBitmap resized = ResizeBitmap(rep.GetBitmap(), resize, pixel_size);
+    if (!resized.drawsNothing())
+      resized_reps.emplace_back(resized, rep.scale());
+  }
+  return resized_reps;
+}
+
+gfx::ImageSkia CreateImageSkia(const std::vector<gfx::ImageSkiaRep>& reps) {
+  gfx::ImageSkia image_skia;
+  for (const auto& rep : reps)
+    image_skia.AddRepresentation(rep);
+  return image_skia;
+}
+
+gfx::ImageSkia ReadImageSkiaFromPath(const base::FilePath& path) {
+  gfx::ImageSkia image_skia;
+  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, path);
+  // The image is handed to the thread that asked for it.
+  image_skia.DetachStorageFromSequence();
+  return image_skia;
+}
 
 }  // namespace
 
@@ -200,6 +364,50 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Value> NativeImage::ToWebP(v8::Isolate* isolate, int quality) {
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(1.0f).GetBitmap();
+  return ToBuffer(isolate, electron::util::EncodeWebP(bitmap, quality));
+}
+
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      return gin_helper::Promise<v8::Local<v8::Value>>::ResolvedPromise(
+          args->isolate(),
+          node::Buffer::Copy(args->isolate(),
+                             reinterpret_cast<const char*>(png->front()),
+                             png->size())
+              .ToLocalChecked());
+    }
+  }
+
+  const SkBitmap bitmap = GetBitmapForThreadPool(
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap());
+  return EncodeAsync(args->isolate(),
+                     base::BindOnce(&electron::util::EncodePNG, bitmap));
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  const SkBitmap bitmap = GetBitmapForThreadPool(
+      image_.AsImageSkia().GetRepresentation(1.0f).GetBitmap());
+  return EncodeAsync(
+      isolate, base::BindOnce(&electron::util::EncodeJPEG, bitmap, quality));
+}
+
+v8::Local<v8::Promise> NativeImage::ToWebPAsync(v8::Isolate* isolate,
+                                                int quality) {
+  const SkBitmap bitmap = GetBitmapForThreadPool(
+      image_.AsImageSkia().GetRepresentation(1.0f).GetBitmap());
+  return EncodeAsync(
+      isolate, base::BindOnce(&electron::util::EncodeWebP, bitmap, quality));
+}
+
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -222,9 +430,19 @@ v8::Local<v8::Value> NativeImage::GetBitmap(gin::Arguments* args) {
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+  // Immutable pixels are shared with others, like the capturer of offscreen
+  // frames, which may even map them read-only, and can't be written to.
+  if (bitmap.isImmutable()) {
+    return node::Buffer::Copy(args->isolate(),
+                              reinterpret_cast<const char*>(ref->pixels()),
+                              bitmap.computeByteSize())
+        .ToLocalChecked();
+  }
+  // The buffer keeps a reference to the pixels, so they outlive the image.
+  ref->ref();
   return node::Buffer::New(args->isolate(),
                            reinterpret_cast<char*>(ref->pixels()),
-                           bitmap.computeByteSize(), &Noop, nullptr)
+                           bitmap.computeByteSize(), &UnrefPixels, ref)
       .ToLocalChecked();
 }
 
@@ -262,38 +480,42 @@ float NativeImage::GetAspectRatio() {
 
 gin::Handle<NativeImage> NativeImage::Resize(v8::Isolate* isolate,
                                              base::DictionaryValue options) {
-  gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
-  bool width_set = options.GetInteger("width", &width);
-  bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
-
-  if (width_set && !height_set) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
-  } else if (height_set && !width_set) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
-
-  gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+  // The representations are resized the same way as in ResizeAsync, so both
+  // give the same pixels for the same options.
+  ResizeOptions resize =
+      GetResizeOptions(GetSize(), GetAspectRatio(), options);
+  gfx::ImageSkia resized = CreateImageSkia(
+      ResizeRepresentations(image_.AsImageSkia().image_reps(), resize));
   return gin::CreateHandle(isolate,
                            new NativeImage(isolate, gfx::Image(resized)));
 }
 
+v8::Local<v8::Promise> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    base::DictionaryValue options) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  ResizeOptions resize =
+      GetResizeOptions(GetSize(), GetAspectRatio(), options);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kCodecTaskTraits,
+      base::BindOnce(
+          &ResizeRepresentations,
+          GetRepresentationsForThreadPool(image_.AsImageSkia().image_reps()),
+          resize),
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             std::vector<gfx::ImageSkiaRep> reps) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(promise.GetContext());
+            promise.Resolve(
+                Create(isolate, gfx::Image(CreateImageSkia(reps))).ToV8());
+          },
+          std::move(promise)));
+  return handle;
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -399,19 +621,68 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
   return handle;
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::FilePath image_path = NormalizePath(path);
+#if defined(OS_WIN)
+  // The icons are loaded lazily by size.
+  if (image_path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise.Resolve(CreateFromPath(isolate, image_path).ToV8());
+    return handle;
+  }
+#endif
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kCodecTaskTraits,
+      base::BindOnce(&ReadImageSkiaFromPath, image_path),
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             const base::FilePath& image_path, gfx::ImageSkia image_skia) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(promise.GetContext());
+            gin::Handle<NativeImage> image =
+                Create(isolate, gfx::Image(image_skia));
+#if defined(OS_MACOSX)
+            if (IsTemplateFilename(image_path))
+              image->SetTemplateImage(true);
+#endif
+            promise.Resolve(image.ToV8());
+          },
+          std::move(promise), image_path));
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
     gin_helper::ErrorThrower thrower,
     v8::Local<v8::Value> buffer,
     const gin_helper::Dictionary& options) {
-  if (!node::Buffer::HasInstance(buffer)) {
-    thrower.ThrowError("buffer must be a node Buffer");
+  char* data = nullptr;
+  size_t length = 0;
+  v8::Local<v8::ArrayBuffer> array_buffer;
+  if (node::Buffer::HasInstance(buffer)) {
+    data = node::Buffer::Data(buffer);
+    length = node::Buffer::Length(buffer);
+    array_buffer = buffer.As<v8::ArrayBufferView>()->Buffer();
+  } else if (buffer->IsArrayBuffer()) {
+    array_buffer = buffer.As<v8::ArrayBuffer>();
+    data = static_cast<char*>(array_buffer->GetBackingStore()->Data());
+    length = array_buffer->ByteLength();
+  } else {
+    thrower.ThrowError("buffer must be a Buffer or an ArrayBuffer");
     return gin::Handle<NativeImage>();
   }
 
   unsigned int width = 0;
   unsigned int height = 0;
   double scale_factor = 1.;
+  bool copy = true;
 
   if (!options.Get("width", &width)) {
     thrower.ThrowError("width is required");
@@ -426,20 +697,35 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
   auto info = SkImageInfo::MakeN32(width, height, kPremul_SkAlphaType);
   auto size_bytes = info.computeMinByteSize();
 
-  if (size_bytes != node::Buffer::Length(buffer)) {
+  if (size_bytes != length) {
     thrower.ThrowError("invalid buffer size");
     return gin::Handle<NativeImage>();
   }
 
   options.Get("scaleFactor", &scale_factor);
+  options.Get("copy", &copy);
 
   if (width == 0 || height == 0) {
     return CreateEmpty(thrower.isolate());
   }
 
   SkBitmap bitmap;
-  bitmap.allocN32Pixels(width, height, false);
-  bitmap.writePixels({info, node::Buffer::Data(buffer), bitmap.rowBytes()});
+  // The pixels can only be taken when they are aligned like Skia needs, and
+  // when the buffer is the only one over its memory, unlike the small Buffers
+  // Node allocates from a pool.
+  if (!copy && reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t) == 0 &&
+      array_buffer->ByteLength() == length && array_buffer->IsDetachable()) {
+    // The bitmap keeps the backing store alive, and the buffer is detached so
+    // the pixels can't be changed from JS anymore.
+    bitmap.installPixels(info, data, info.minRowBytes(), &ReleaseBackingStore,
+                         new std::shared_ptr<v8::BackingStore>(
+                             array_buffer->GetBackingStore()));
+    bitmap.setImmutable();
+    array_buffer->Detach();
+  } else {
+    bitmap.allocN32Pixels(width, height, false);
+    bitmap.writePixels({info, data, bitmap.rowBytes()});
+  }
 
   gfx::ImageSkia image_skia;
   image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
@@ -504,6 +790,10 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toWebP", &NativeImage::ToWebP)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("toWebPAsync", &NativeImage::ToWebPAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -515,6 +805,7 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
       .SetProperty("isMacTemplateImage", &NativeImage::IsTemplateImage,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -583,11 +874,15 @@ void Initialize(v8::Local<v8::Object> exports,
 
   native_image.SetMethod("createEmpty", &NativeImage::CreateEmpty);
   native_image.SetMethod("createFromPath", &NativeImage::CreateFromPath);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
   native_image.SetMethod("createFromBitmap", &NativeImage::CreateFromBitmap);
   native_image.SetMethod("createFromBuffer", &NativeImage::CreateFromBuffer);
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
+  native_image.SetMethod("_getDecodedImageCacheHits",
+                         &electron::util::GetDecodedImageCacheHits);
 }
 
 }  // namespace
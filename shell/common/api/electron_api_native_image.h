@@ -51,6 +51,9 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
                                                  size_t length);
   static gin::Handle<NativeImage> CreateFromPath(v8::Isolate* isolate,
                                                  const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
   static gin::Handle<NativeImage> CreateFromBitmap(
       gin_helper::ErrorThrower thrower,
       v8::Local<v8::Value> buffer,
@@ -83,11 +86,18 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
  private:
   v8::Local<v8::Value> ToPNG(gin::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Value> ToWebP(v8::Isolate* isolate, int quality);
+  // Like the methods above, but the image is encoded on the thread pool.
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToWebPAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
   gin::Handle<NativeImage> Resize(v8::Isolate* isolate,
                                   base::DictionaryValue options);
+  v8::Local<v8::Promise> ResizeAsync(v8::Isolate* isolate,
+                                     base::DictionaryValue options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(gin::Arguments* args);
   bool IsEmpty();
@@ -22,6 +22,7 @@
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/browser/browser.h"
 #include "shell/common/application_info.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/locker.h"
@@ -91,6 +92,10 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   BindProcess(isolate, &dict, metrics_.get());
 
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("startSamplingHeapProfiler", &StartSamplingHeapProfiler);
+  dict.SetMethod("stopSamplingHeapProfiler", &StopSamplingHeapProfiler);
+  dict.SetMethod("startCPUProfiler", &StartCPUProfiler);
+  dict.SetMethod("stopCPUProfiler", &StopCPUProfiler);
 #if defined(OS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
@@ -354,4 +359,53 @@ bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return electron::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+bool ElectronBindings::StartSamplingHeapProfiler(gin_helper::Arguments* args) {
+  uint64_t sampling_interval = kDefaultHeapSamplingInterval;
+  int stack_depth = kDefaultHeapSamplingStackDepth;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval == 0 || stack_depth <= 0) {
+    args->ThrowError("samplingInterval and stackDepth must be positive");
+    return false;
+  }
+  return electron::StartSamplingHeapProfiler(args->isolate(),
+                                             sampling_interval, stack_depth);
+}
+
+// static
+v8::Local<v8::Value> ElectronBindings::StopSamplingHeapProfiler(
+    v8::Isolate* isolate) {
+  std::string profile = electron::StopSamplingHeapProfiler(isolate);
+  if (profile.empty())
+    return v8::Null(isolate);
+  return gin::StringToV8(isolate, profile);
+}
+
+// static
+bool ElectronBindings::StartCPUProfiler(gin_helper::Arguments* args) {
+  double sampling_interval = kDefaultCPUSamplingInterval.InMicrosecondsF();
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval < 1) {
+    args->ThrowError("samplingInterval must be positive");
+    return false;
+  }
+  return electron::StartCPUProfiler(
+      args->isolate(), base::TimeDelta::FromMicroseconds(
+                           static_cast<int64_t>(sampling_interval)));
+}
+
+// static
+v8::Local<v8::Value> ElectronBindings::StopCPUProfiler(v8::Isolate* isolate) {
+  std::string profile = electron::StopCPUProfiler(isolate);
+  if (profile.empty())
+    return v8::Null(isolate);
+  return gin::StringToV8(isolate, profile);
+}
+
 }  // namespace electron
@@ -63,6 +63,10 @@ class ElectronBindings {
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static bool StartSamplingHeapProfiler(gin_helper::Arguments* args);
+  static v8::Local<v8::Value> StopSamplingHeapProfiler(v8::Isolate* isolate);
+  static bool StartCPUProfiler(gin_helper::Arguments* args);
+  static v8::Local<v8::Value> StopCPUProfiler(v8::Isolate* isolate);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
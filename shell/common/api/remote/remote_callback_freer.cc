@@ -4,9 +4,18 @@
 
 #include "shell/common/api/remote/remote_callback_freer.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -14,6 +23,39 @@
 
 namespace electron {
 
+namespace {
+
+// The callbacks collected by a garbage collection are released together after
+// a short delay, with a single message per frame.
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromMilliseconds(100);
+
+// { process_id, routing_id } ==> dereferences waiting to be sent
+using PendingDereferences =
+    std::map<std::pair<int, int>,
+             std::vector<mojom::RemoteCallbackDereferencePtr>>;
+
+PendingDereferences& GetPendingDereferences() {
+  static base::NoDestructor<PendingDereferences> pending;
+  return *pending;
+}
+
+void FlushDereferences() {
+  PendingDereferences pending;
+  pending.swap(GetPendingDereferences());
+  for (auto& it : pending) {
+    auto* frame_host =
+        content::RenderFrameHost::FromID(it.first.first, it.first.second);
+    if (!frame_host || !frame_host->IsRenderFrameLive())
+      continue;
+    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+    frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+        &electron_renderer);
+    electron_renderer->DereferenceRemoteJSCallbacks(std::move(it.second));
+  }
+}
+
+}  // namespace
+
 // static
 void RemoteCallbackFreer::BindTo(v8::Isolate* isolate,
                                  v8::Local<v8::Object> target,
@@ -46,9 +88,15 @@ void RemoteCallbackFreer::RunDestructor() {
   });
 
   if (iter != frames.end() && (*iter)->IsRenderFrameLive()) {
-    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
-    (*iter)->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
-    electron_renderer->DereferenceRemoteJSCallback(context_id_, object_id_);
+    // This runs during garbage collection, the message is sent from a task.
+    PendingDereferences& pending = GetPendingDereferences();
+    if (pending.empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE, base::BindOnce(&FlushDereferences), kFlushDelay);
+    }
+    auto key = std::make_pair((*iter)->GetProcess()->GetID(), frame_id_);
+    pending[key].push_back(
+        mojom::RemoteCallbackDereference::New(context_id_, object_id_));
   }
 
   Observe(nullptr);
@@ -4,7 +4,14 @@
 
 #include "shell/common/api/remote/remote_object_freer.h"
 
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -25,6 +32,34 @@ content::RenderFrame* GetCurrentRenderFrame() {
   return content::RenderFrame::FromWebFrame(frame);
 }
 
+// The objects collected by a garbage collection are released together after a
+// short delay, with a single message per frame.
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromMilliseconds(100);
+
+// routing_id ==> dereferences waiting to be sent
+using PendingDereferences =
+    std::map<int, std::vector<mojom::RemoteObjectDereferencePtr>>;
+
+PendingDereferences& GetPendingDereferences() {
+  static base::NoDestructor<PendingDereferences> pending;
+  return *pending;
+}
+
+void FlushDereferences() {
+  PendingDereferences pending;
+  pending.swap(GetPendingDereferences());
+  for (auto& it : pending) {
+    content::RenderFrame* render_frame =
+        content::RenderFrame::FromRoutingID(it.first);
+    if (!render_frame)
+      continue;
+    mojom::ElectronBrowserPtr electron_ptr;
+    render_frame->GetRemoteInterfaces()->GetInterface(
+        mojo::MakeRequest(&electron_ptr));
+    electron_ptr->DereferenceRemoteJSObjects(std::move(it.second));
+  }
+}
+
 }  // namespace
 
 // static
@@ -60,9 +95,7 @@ RemoteObjectFreer::RemoteObjectFreer(v8::Isolate* isolate,
 RemoteObjectFreer::~RemoteObjectFreer() = default;
 
 void RemoteObjectFreer::RunDestructor() {
-  content::RenderFrame* render_frame =
-      content::RenderFrame::FromRoutingID(routing_id_);
-  if (!render_frame)
+  if (!content::RenderFrame::FromRoutingID(routing_id_))
     return;
 
   // Reset our local ref count in case we are in a GC race condition
@@ -80,10 +113,14 @@ void RemoteObjectFreer::RunDestructor() {
       ref_mapper_.erase(objects_it);
   }
 
-  mojom::ElectronBrowserPtr electron_ptr;
-  render_frame->GetRemoteInterfaces()->GetInterface(
-      mojo::MakeRequest(&electron_ptr));
-  electron_ptr->DereferenceRemoteJSObject(context_id_, object_id_, ref_count);
+  // This runs during garbage collection, the message is sent from a task.
+  PendingDereferences& pending = GetPendingDereferences();
+  if (pending.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&FlushDereferences), kFlushDelay);
+  }
+  pending[routing_id_].push_back(
+      mojom::RemoteObjectDereference::New(context_id_, object_id_, ref_count));
 }
 
 }  // namespace electron
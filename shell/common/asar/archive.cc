@@ -4,6 +4,10 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,10 +18,18 @@
 #include "base/logging.h"
 #include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "crypto/sha2.h"
+#include "shell/common/asar/archive_index.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/extraction_cache.h"
 #include "shell/common/asar/scoped_temporary_file.h"
+#include "third_party/brotli/include/brotli/decode.h"
 
 #if defined(OS_WIN)
 #include <io.h>
@@ -27,91 +39,37 @@ namespace asar {
 
 namespace {
 
+// Looks up |path| in |index|, on POSIX the path is used in place.
+const ArchiveIndex::Entry* LookupPath(const ArchiveIndex& index,
+                                      const base::FilePath& path) {
 #if defined(OS_WIN)
-const char kSeparators[] = "\\/";
+  return index.Resolve(path.AsUTF8Unsafe());
 #else
-const char kSeparators[] = "/";
+  return index.Resolve(path.value());
 #endif
-
-bool GetNodeFromPath(std::string path,
-                     const base::DictionaryValue* root,
-                     const base::DictionaryValue** out);
-
-// Gets the "files" from "dir".
-bool GetFilesNode(const base::DictionaryValue* root,
-                  const base::DictionaryValue* dir,
-                  const base::DictionaryValue** out) {
-  // Test for symbol linked directory.
-  std::string link;
-  if (dir->GetStringWithoutPathExpansion("link", &link)) {
-    const base::DictionaryValue* linked_node = nullptr;
-    if (!GetNodeFromPath(link, root, &linked_node))
-      return false;
-    dir = linked_node;
-  }
-
-  return dir->GetDictionaryWithoutPathExpansion("files", out);
-}
-
-// Gets sub-file "name" from "dir".
-bool GetChildNode(const base::DictionaryValue* root,
-                  const std::string& name,
-                  const base::DictionaryValue* dir,
-                  const base::DictionaryValue** out) {
-  if (name == "") {
-    *out = root;
-    return true;
-  }
-
-  const base::DictionaryValue* files = nullptr;
-  return GetFilesNode(root, dir, &files) &&
-         files->GetDictionaryWithoutPathExpansion(name, out);
 }
 
-// Gets the node of "path" from "root".
-bool GetNodeFromPath(std::string path,
-                     const base::DictionaryValue* root,
-                     const base::DictionaryValue** out) {
-  if (path == "") {
-    *out = root;
-    return true;
-  }
-
-  const base::DictionaryValue* dir = root;
-  for (size_t delimiter_position = path.find_first_of(kSeparators);
-       delimiter_position != std::string::npos;
-       delimiter_position = path.find_first_of(kSeparators)) {
-    const base::DictionaryValue* child = nullptr;
-    if (!GetChildNode(root, path.substr(0, delimiter_position), dir, &child))
-      return false;
-
-    dir = child;
-    path.erase(0, delimiter_position + 1);
-  }
-
-  return GetChildNode(root, path, dir, out);
-}
-
-bool FillFileInfoWithNode(Archive::FileInfo* info,
-                          uint32_t header_size,
-                          const base::DictionaryValue* node) {
-  int size;
-  if (!node->GetInteger("size", &size))
+bool FillFileInfoWithEntry(Archive::FileInfo* info,
+                           uint32_t header_size,
+                           const ArchiveIndex& index,
+                           const ArchiveIndex::Entry& entry) {
+  if (!entry.valid || entry.type != ArchiveIndex::EntryType::kFile)
     return false;
-  info->size = static_cast<uint32_t>(size);
 
-  if (node->GetBoolean("unpacked", &info->unpacked) && info->unpacked)
+  info->size = entry.size;
+  info->unpacked = entry.unpacked;
+  if (info->unpacked)
     return true;
 
-  std::string offset;
-  if (!node->GetString("offset", &offset))
-    return false;
-  if (!base::StringToUint64(offset, &info->offset))
-    return false;
-  info->offset += header_size;
-
-  node->GetBoolean("executable", &info->executable);
-
+  info->offset = entry.offset + header_size;
+  info->executable = entry.executable;
+  info->compression = entry.compression;
+  info->compressed_size = entry.compressed_size;
+  info->block_size = entry.block_size;
+  info->blocks = index.GetBlocks(entry);
+  info->integrity_block_size = entry.integrity_block_size;
+  info->first_hash = entry.first_hash;
+  info->hashes = index.GetHashes(entry);
   return true;
 }
 
@@ -141,6 +99,8 @@ Archive::~Archive() {
 }
 
 bool Archive::Init() {
+  TRACE_EVENT1("electron", "asar::Archive::Init", "path",
+               path_.AsUTF8Unsafe());
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(WARNING) << "Opening " << path_.value() << ": "
@@ -186,88 +146,146 @@ bool Archive::Init() {
     return false;
   }
 
-  base::Optional<base::Value> value = base::JSONReader::Read(header);
-  if (!value || !value->is_dict()) {
-    LOG(ERROR) << "Failed to parse header";
+  header_size_ = 8 + size;
+  header_hash_ = ArchiveIndex::HashHeader(header);
+
+  // The block hashes are part of the header, so they only detect tampering
+  // when the header itself can be trusted. Opening an archive whose header
+  // does not match the hash pinned by the app must not fall back to anything
+  // else.
+  std::string pinned_hash;
+  const bool is_pinned = GetHeaderIntegrity(path_, &pinned_hash);
+  if (is_pinned && pinned_hash != header_hash_) {
+    LOG(FATAL) << "Integrity check failed for the header of "
+               << path_.value();
     return false;
   }
 
-  header_size_ = 8 + size;
-  header_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(*value)));
+  // Names this generation of the archive in the extraction cache. The header
+  // hash covers the file table, the size and modification time of the archive
+  // cover contents that changed under the same header.
+  base::File::Info file_info;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    if (!file_.GetInfo(&file_info)) {
+      PLOG(ERROR) << "Failed to stat " << path_.value();
+      return false;
+    }
+  }
+  const std::string identity = base::StringPrintf(
+      "%s\n%" PRId64 "\n%" PRId64 "\n", path_.AsUTF8Unsafe().c_str(),
+      file_info.size,
+      file_info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  const std::string archive_hash =
+      crypto::SHA256HashString(identity + header_hash_);
+  archive_id_ = base::HexEncode(archive_hash.data(), archive_hash.size() / 2);
+
+  // The archive is mapped up front rather than on first read: it is shared
+  // by all the threads of the process, and mapping only reserves address
+  // space until pages are touched.
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+    // The mapping takes ownership of the file it is given, so hand it a
+    // duplicate and keep |file_| for the fd-based readers.
+    if (mapped_file->Initialize(file_.Duplicate()))
+      mapped_file_ = std::move(mapped_file);
+    else
+      LOG(WARNING) << "Failed to map " << path_.value();
+  }
+
+  // Prefer the precompiled index shipped next to the archive, which saves
+  // parsing the JSON header in every process. It is only used when it was
+  // built from this exact header. The pin does not cover the index, which
+  // carries the block hashes too, so pinned archives always parse the header.
+  if (!is_pinned) {
+    index_ = ArchiveIndex::CreateFromFile(
+        path_.AddExtension(FILE_PATH_LITERAL("idx")), header_hash_);
+  }
+  if (!index_) {
+    base::Optional<base::Value> value = base::JSONReader::Read(header);
+    const base::DictionaryValue* dict = nullptr;
+    if (!value || !value->GetAsDictionary(&dict)) {
+      LOG(ERROR) << "Failed to parse header";
+      return false;
+    }
+
+    // The JSON tree is only needed to build the index.
+    index_ = ArchiveIndex::Create(*dict);
+    if (!index_) {
+      LOG(ERROR) << "Failed to index header of " << path_.value();
+      return false;
+    }
+  }
+
+  verified_blocks_.resize(index_->hash_count());
   return true;
 }
 
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::DictionaryValue* node;
-  if (!GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node))
+  const ArchiveIndex::Entry* entry = LookupPath(*index_, path);
+  if (entry && entry->type == ArchiveIndex::EntryType::kLink)
+    entry = index_->ResolveLink(*entry);
+  if (!entry)
     return false;
 
-  std::string link;
-  if (node->GetString("link", &link))
-    return GetFileInfo(base::FilePath::FromUTF8Unsafe(link), info);
-
-  return FillFileInfoWithNode(info, header_size_, node);
+  return FillFileInfoWithEntry(info, header_size_, *index_, *entry);
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::DictionaryValue* node;
-  if (!GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node))
+  const ArchiveIndex::Entry* entry = LookupPath(*index_, path);
+  if (!entry)
     return false;
 
-  if (node->FindKey("link")) {
+  if (entry->type == ArchiveIndex::EntryType::kLink) {
     stats->is_file = false;
     stats->is_link = true;
     return true;
   }
 
-  if (node->FindKey("files")) {
+  if (entry->type == ArchiveIndex::EntryType::kDirectory) {
     stats->is_file = false;
     stats->is_directory = true;
     return true;
   }
 
-  return FillFileInfoWithNode(stats, header_size_, node);
+  return FillFileInfoWithEntry(stats, header_size_, *index_, *entry);
 }
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* list) {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::DictionaryValue* node;
-  if (!GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node))
+  const ArchiveIndex::Entry* entry = LookupPath(*index_, path);
+  if (entry && entry->type == ArchiveIndex::EntryType::kLink)
+    entry = index_->ResolveLink(*entry);
+  if (!entry || entry->type != ArchiveIndex::EntryType::kDirectory)
     return false;
 
-  const base::DictionaryValue* files;
-  if (!GetFilesNode(header_.get(), node, &files))
-    return false;
-
-  base::DictionaryValue::Iterator iter(*files);
-  while (!iter.IsAtEnd()) {
-    list->push_back(base::FilePath::FromUTF8Unsafe(iter.key()));
-    iter.Advance();
-  }
+  for (const ArchiveIndex::Entry* child : index_->GetChildren(*entry))
+    list->push_back(
+        base::FilePath::FromUTF8Unsafe(index_->GetName(*child).as_string()));
   return true;
 }
 
 bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::DictionaryValue* node;
-  if (!GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node))
+  const ArchiveIndex::Entry* entry = LookupPath(*index_, path);
+  if (!entry)
     return false;
 
-  std::string link;
-  if (node->GetString("link", &link)) {
-    *realpath = base::FilePath::FromUTF8Unsafe(link);
+  if (entry->type == ArchiveIndex::EntryType::kLink) {
+    *realpath = base::FilePath::FromUTF8Unsafe(
+        index_->GetLinkTarget(*entry).as_string());
     return true;
   }
 
@@ -276,9 +294,11 @@ bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
+  TRACE_EVENT0("electron", "asar::Archive::CopyFileOut");
+  base::AutoLock auto_lock(external_files_lock_);
   auto it = external_files_.find(path.value());
   if (it != external_files_.end()) {
-    *out = it->second->path();
+    *out = it->second;
     return true;
   }
 
@@ -291,10 +311,47 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return true;
   }
 
-  auto temp_file = std::make_unique<ScopedTemporaryFile>();
+  LogArchiveRead(path_, path, info.offset);
+
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size))
+
+  // The copy of a file is named after the archive generation and the
+  // location of the file in it, so a copy extracted by an earlier launch or
+  // by another process is found without reading the file. Files with
+  // integrity information are always read and verified instead, and their
+  // copy is compared with the verified contents: the name does not vouch for
+  // what was written under it.
+  const std::string key = archive_id_ + "-" +
+                          base::NumberToString(info.offset) + "-" +
+                          base::NumberToString(info.size);
+  if (!info.has_integrity() && GetCachedCopy(key, ext, info.size, out)) {
+    external_files_[path.value()] = *out;
+    return true;
+  }
+
+  base::span<const uint8_t> contents;
+  std::string buffer;
+  if (!GetMappedContents(info, &contents)) {
+    if (!ReadFileContents(info, &buffer))
+      return false;
+    contents = base::as_bytes(base::make_span(buffer));
+  }
+
+  if (ExtractToCache(key, ext, contents, info.executable, out)) {
+    external_files_[path.value()] = *out;
+    return true;
+  }
+
+  auto temp_file = std::make_unique<ScopedTemporaryFile>();
+  if (!temp_file->Init(ext))
     return false;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    if (base::WriteFile(temp_file->path(),
+                        reinterpret_cast<const char*>(contents.data()),
+                        contents.size()) != static_cast<int>(contents.size()))
+      return false;
+  }
 
 #if defined(OS_POSIX)
   if (info.executable) {
@@ -304,12 +361,208 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
 #endif
 
   *out = temp_file->path();
-  external_files_[path.value()] = std::move(temp_file);
+  external_files_[path.value()] = *out;
+  temp_files_.push_back(std::move(temp_file));
   return true;
 }
 
+bool Archive::WriteIndex(const base::FilePath& path) {
+  if (!index_)
+    return false;
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  std::string data = index_->Serialize(header_hash_);
+  return base::WriteFile(path, data.data(), data.size()) ==
+         static_cast<int>(data.size());
+}
+
+std::vector<base::FilePath> Archive::GetLoadableNativeModules() {
+  std::vector<base::FilePath> paths;
+  if (!index_)
+    return paths;
+
+  for (const ArchiveIndex::Entry& entry : index_->entries()) {
+    FileInfo info;
+    if (!FillFileInfoWithEntry(&info, header_size_, *index_, entry) ||
+        info.unpacked)
+      continue;
+    base::StringPiece entry_path = index_->GetPath(entry);
+    if (!base::EndsWith(entry_path, ".node", base::CompareCase::SENSITIVE))
+      continue;
+    // Packages commonly ship prebuilt modules for every platform, only the
+    // ones this process can load are worth extracting. The headers that tell
+    // them apart fit in the first page.
+    base::span<const uint8_t> head;
+    if (!GetMappedRange(info, 0, std::min<uint64_t>(info.size, 4096), &head) ||
+        !IsLoadableNativeModule(head))
+      continue;
+    paths.push_back(base::FilePath::FromUTF8Unsafe(entry_path.as_string()));
+  }
+  return paths;
+}
+
 int Archive::GetFD() const {
   return fd_;
 }
 
+bool Archive::GetMappedContents(const FileInfo& info,
+                                base::span<const uint8_t>* out) {
+  return GetMappedRange(info, 0, info.size, out);
+}
+
+bool Archive::GetMappedRange(const FileInfo& info,
+                             uint64_t offset,
+                             uint64_t length,
+                             base::span<const uint8_t>* out) {
+  if (info.unpacked || info.compression != Compression::kNone ||
+      !file_.IsValid())
+    return false;
+
+  if (!mapped_file_)
+    return false;
+
+  if (info.offset > mapped_file_->length() ||
+      info.size > mapped_file_->length() - info.offset ||
+      offset > info.size || length > info.size - offset)
+    return false;
+
+  if (!VerifyRange(info, offset, offset + length))
+    return false;
+
+  *out = base::make_span(mapped_file_->data() + info.offset + offset, length);
+  return true;
+}
+
+bool Archive::VerifyRange(const FileInfo& info, uint64_t begin, uint64_t end) {
+  if (!info.has_integrity() || begin >= end)
+    return true;
+
+  const uint64_t stored_size = info.compression == Compression::kNone
+                                   ? info.size
+                                   : info.compressed_size;
+  const size_t hash_count = info.hashes.size() / ArchiveIndex::kHashLength;
+  const size_t first = begin / info.integrity_block_size;
+  const size_t last = (end - 1) / info.integrity_block_size;
+  if (end > stored_size || last >= hash_count)
+    return false;
+
+  std::vector<char> buffer;
+  for (size_t i = first; i <= last; ++i) {
+    const size_t bit = info.first_hash + i;
+    {
+      base::AutoLock auto_lock(verified_blocks_lock_);
+      if (bit >= verified_blocks_.size())
+        return false;
+      if (verified_blocks_[bit])
+        continue;
+    }
+
+    // Hash the whole block, even when only part of it is read.
+    const uint64_t block_begin =
+        static_cast<uint64_t>(i) * info.integrity_block_size;
+    const size_t block_length = std::min<uint64_t>(
+        info.integrity_block_size, stored_size - block_begin);
+    const uint64_t block_offset = info.offset + block_begin;
+    base::StringPiece block;
+    if (mapped_file_ && block_offset + block_length <= mapped_file_->length()) {
+      block = base::StringPiece(
+          reinterpret_cast<const char*>(mapped_file_->data() + block_offset),
+          block_length);
+    } else {
+      base::ThreadRestrictions::ScopedAllowIO allow_io;
+      buffer.resize(block_length);
+      if (file_.Read(block_offset, buffer.data(), buffer.size()) !=
+          static_cast<int>(buffer.size()))
+        return false;
+      block = base::StringPiece(buffer.data(), buffer.size());
+    }
+
+    const std::string hash = crypto::SHA256HashString(block);
+    const uint8_t* expected =
+        info.hashes.data() + i * ArchiveIndex::kHashLength;
+    if (memcmp(hash.data(), expected, ArchiveIndex::kHashLength) != 0) {
+      LOG(ERROR) << "Integrity check failed for block " << i << " at offset "
+                 << info.offset << " in " << path_.value();
+      return false;
+    }
+
+    base::AutoLock auto_lock(verified_blocks_lock_);
+    verified_blocks_[bit] = true;
+  }
+  return true;
+}
+
+bool Archive::DecompressBlock(const FileInfo& info,
+                              size_t index,
+                              std::string* out) {
+  if (info.compression != Compression::kBrotli || index >= info.blocks.size())
+    return false;
+
+  const uint32_t begin = index == 0 ? 0 : info.blocks[index - 1];
+  const uint32_t end = info.blocks[index];
+  const uint64_t block_start = static_cast<uint64_t>(index) * info.block_size;
+  if (begin > end || end > info.compressed_size || block_start > info.size ||
+      !VerifyRange(info, begin, end))
+    return false;
+  const size_t expected_size =
+      std::min<uint64_t>(info.block_size, info.size - block_start);
+
+  // Read the compressed block from the mapping when possible.
+  std::vector<char> buffer;
+  const uint8_t* encoded = nullptr;
+  const size_t encoded_size = end - begin;
+  if (mapped_file_ && info.offset + end <= mapped_file_->length()) {
+    encoded = mapped_file_->data() + info.offset + begin;
+  } else {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    buffer.resize(encoded_size);
+    if (file_.Read(info.offset + begin, buffer.data(), buffer.size()) !=
+        static_cast<int>(buffer.size()))
+      return false;
+    encoded = reinterpret_cast<const uint8_t*>(buffer.data());
+  }
+
+  out->resize(expected_size);
+  size_t decoded_size = out->size();
+  if (BrotliDecoderDecompress(encoded_size, encoded, &decoded_size,
+                              reinterpret_cast<uint8_t*>(&(*out)[0])) !=
+          BROTLI_DECODER_RESULT_SUCCESS ||
+      decoded_size != expected_size) {
+    LOG(ERROR) << "Failed to decompress block " << index << " in "
+               << path_.value();
+    return false;
+  }
+  return true;
+}
+
+bool Archive::ReadFileContents(const FileInfo& info, std::string* out) {
+  TRACE_EVENT1("electron", "asar::Archive::ReadFileContents", "size",
+               info.size);
+  if (info.unpacked)
+    return false;
+
+  if (info.compression == Compression::kNone) {
+    base::span<const uint8_t> mapped;
+    if (GetMappedContents(info, &mapped)) {
+      out->assign(reinterpret_cast<const char*>(mapped.data()), mapped.size());
+      return true;
+    }
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    out->resize(info.size);
+    return static_cast<int>(info.size) ==
+               file_.Read(info.offset, &(*out)[0], out->size()) &&
+           VerifyRange(info, 0, info.size);
+  }
+
+  out->clear();
+  out->reserve(info.size);
+  std::string block;
+  for (size_t i = 0; i < info.blocks.size(); ++i) {
+    if (!DecompressBlock(info, i, &block))
+      return false;
+    out->append(block);
+  }
+  return out->size() == info.size;
+}
+
 }  // namespace asar
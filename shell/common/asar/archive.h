@@ -6,22 +6,37 @@
 #define SHELL_COMMON_ASAR_ARCHIVE_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
-
-namespace base {
-class DictionaryValue;
-}
+#include "base/files/memory_mapped_file.h"
+#include "base/synchronization/lock.h"
+#include "shell/common/asar/archive_index.h"
 
 namespace asar {
 
 class ScopedTemporaryFile;
 
+// Looks up the SHA256 of the header that the app pinned for the archive at
+// |path|, in the Info.plist of the bundle on macOS and in a resource of the
+// executable on Windows. Returns false if the archive is not pinned. A pin
+// that can not be read sets |hash| to an empty string, which no header
+// matches.
+bool GetHeaderIntegrity(const base::FilePath& path, std::string* hash);
+
+// Whether |head|, the start of a native module, is a shared library for the
+// platform and architecture of this process.
+bool IsLoadableNativeModule(base::span<const uint8_t> head);
+
 // This class represents an asar package, and provides methods to read
 // information from it.
+//
+// The archive is immutable once Init() succeeds, so a single instance can be
+// shared by all threads of a process.
 class Archive {
  public:
   struct FileInfo {
@@ -30,6 +45,21 @@ class Archive {
     bool executable;
     uint32_t size;
     uint64_t offset;
+    // For compressed files |offset| points at the compressed contents, and
+    // |blocks| holds the end offsets of the compressed blocks, it is valid for
+    // as long as the Archive is alive.
+    Compression compression = Compression::kNone;
+    uint32_t compressed_size = 0;
+    uint32_t block_size = 0;
+    base::span<const uint32_t> blocks;
+    // Files with integrity information are verified in blocks of
+    // |integrity_block_size| stored bytes on first read, |hashes| holds the
+    // expected SHA256 of each block.
+    uint32_t integrity_block_size = 0;
+    uint32_t first_hash = 0;
+    base::span<const uint8_t> hashes;
+
+    bool has_integrity() const { return !hashes.empty(); }
   };
 
   struct Stats : public FileInfo {
@@ -57,27 +87,81 @@ class Archive {
   // Fs.realpath(path).
   bool Realpath(const base::FilePath& path, base::FilePath* realpath);
 
-  // Copy the file into a temporary file, and return the new path.
+  // Copy the file out of the archive, and return the new path.
   // For unpacked file, this method will return its real path.
+  //
+  // Packed files are extracted into a read-only cache shared across launches
+  // and processes, so that the processes loading the same native module share
+  // its pages. A temporary file is only used when the cache can not be used.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
+  // Returns the paths of the packed native modules that can be loaded on this
+  // platform.
+  std::vector<base::FilePath> GetLoadableNativeModules();
+
+  // Decompresses block |index| of a compressed file into |out|.
+  bool DecompressBlock(const FileInfo& info, size_t index, std::string* out);
+
+  // Reads the whole contents of a packed file, decompressing it if needed.
+  bool ReadFileContents(const FileInfo& info, std::string* out);
+
+  // Serializes the index of the header into |path|, packaging tools ship it
+  // as "<archive>.idx" so that Init() can map it instead of parsing the JSON.
+  bool WriteIndex(const base::FilePath& path);
+
   // Returns the file's fd.
   int GetFD() const;
 
+  // Gets a view of the packed contents of |info| from the memory-mapped
+  // archive. Returns false for unpacked or compressed files, or when the
+  // archive could not be mapped, in which case callers should fall back to
+  // reading from the fd. Also returns false if the contents fail their
+  // integrity check, callers must not fall back for files that
+  // has_integrity().
+  //
+  // The view is valid for as long as the Archive is alive.
+  bool GetMappedContents(const FileInfo& info, base::span<const uint8_t>* out);
+
+  // Like GetMappedContents(), but only gets and verifies |length| bytes
+  // starting at |offset| of the file.
+  bool GetMappedRange(const FileInfo& info,
+                      uint64_t offset,
+                      uint64_t length,
+                      base::span<const uint8_t>* out);
+
+  // Verifies the integrity blocks covering the stored bytes [begin, end) of
+  // a file, blocks are only hashed the first time they are read. Returns true
+  // for files without integrity information.
+  bool VerifyRange(const FileInfo& info, uint64_t begin, uint64_t end);
+
   base::FilePath path() const { return path_; }
-  base::DictionaryValue* header() const { return header_.get(); }
 
  private:
   base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
-  std::unique_ptr<base::DictionaryValue> header_;
-
-  // Cached external temporary files.
-  std::unordered_map<base::FilePath::StringType,
-                     std::unique_ptr<ScopedTemporaryFile>>
+  std::string header_hash_;
+  // Hex encoded hash of the path, size, modification time and header hash of
+  // the archive, which names the copies of its files in the extraction cache.
+  std::string archive_id_;
+  std::unique_ptr<ArchiveIndex> index_;
+
+  // Read-only mapping of the whole archive, created by Init() and null when
+  // mapping failed. The pages are backed by the OS file cache and shared
+  // between processes, and are only read when they are first accessed.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
+  // Integrity blocks of all files that have been verified, indexed by hash.
+  base::Lock verified_blocks_lock_;
+  std::vector<bool> verified_blocks_;
+
+  // Paths of the files that were copied out, and the temporary files that
+  // back them.
+  base::Lock external_files_lock_;
+  std::unordered_map<base::FilePath::StringType, base::FilePath>
       external_files_;
+  std::vector<std::unique_ptr<ScopedTemporaryFile>> temp_files_;
 
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
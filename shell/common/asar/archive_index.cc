@@ -0,0 +1,553 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_index.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/values.h"
+#include "crypto/sha2.h"
+
+namespace asar {
+
+namespace {
+
+#if defined(OS_WIN)
+const char kSeparators[] = "\\/";
+#else
+const char kSeparators[] = "/";
+#endif
+
+// Maximum number of links followed when resolving a path, guards against
+// cycles in malformed headers.
+const int kMaxLinkDepth = 32;
+
+const uint32_t kSerializedMagic = 0x58444941;  // "AIDX"
+const uint32_t kSerializedVersion = 5;
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+  char header_hash[ArchiveIndex::kHashLength];
+  uint32_t entry_count;
+  uint32_t children_count;
+  uint32_t blocks_count;
+  uint32_t hashes_count;
+  uint32_t strings_size;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(SerializedHeader) % 8 == 0,
+              "Sections of the serialized index must stay aligned");
+static_assert(std::is_trivially_copyable<ArchiveIndex::Entry>::value,
+              "Entries are written and mapped as raw bytes");
+// Entries are written as they are in memory, padding would carry whatever
+// bytes happened to be there into the file.
+static_assert(sizeof(ArchiveIndex::Entry) == 72,
+              "Entries must not have padding");
+
+size_t AlignSection(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+void AppendSection(std::string* out, const void* data, size_t size) {
+  out->append(static_cast<const char*>(data), size);
+  out->resize(AlignSection(out->size()), '\0');
+}
+
+template <typename T>
+bool TakeSection(base::span<const uint8_t>* data,
+                 size_t count,
+                 base::span<const T>* out) {
+  if (count > data->size() / sizeof(T))
+    return false;
+  const size_t size = count * sizeof(T);
+  const size_t aligned = std::min(AlignSection(size), data->size());
+  *out = base::make_span(reinterpret_cast<const T*>(data->data()), count);
+  *data = data->subspan(aligned);
+  return true;
+}
+
+inline unsigned char NormalizeSeparator(char c) {
+#if defined(OS_WIN)
+  return c == '\\' ? '/' : c;
+#else
+  return c;
+#endif
+}
+
+// Compares two paths byte by byte, treating all separators alike.
+int ComparePaths(base::StringPiece a, base::StringPiece b) {
+  const size_t length = std::min(a.size(), b.size());
+  for (size_t i = 0; i < length; ++i) {
+    unsigned char ca = NormalizeSeparator(a[i]);
+    unsigned char cb = NormalizeSeparator(b[i]);
+    if (ca != cb)
+      return ca < cb ? -1 : 1;
+  }
+  if (a.size() == b.size())
+    return 0;
+  return a.size() < b.size() ? -1 : 1;
+}
+
+}  // namespace
+
+ArchiveIndex::ArchiveIndex() = default;
+
+ArchiveIndex::~ArchiveIndex() = default;
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Create(
+    const base::DictionaryValue& header) {
+  auto index = base::WrapUnique(new ArchiveIndex);
+  uint32_t root;
+  if (!index->AddNode(header, std::string(), 0, &root))
+    return nullptr;
+
+  index->owned_entries_.shrink_to_fit();
+  index->owned_children_.shrink_to_fit();
+  index->owned_blocks_.shrink_to_fit();
+  index->owned_hashes_.shrink_to_fit();
+  index->owned_strings_.shrink_to_fit();
+  index->entries_ = index->owned_entries_;
+  index->children_ = index->owned_children_;
+  index->blocks_ = index->owned_blocks_;
+  index->hashes_ = index->owned_hashes_;
+  index->strings_ = index->owned_strings_;
+
+  std::vector<uint32_t>& sorted = index->owned_sorted_;
+  sorted.resize(index->entries_.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+  const ArchiveIndex* self = index.get();
+  std::sort(sorted.begin(), sorted.end(), [self](uint32_t a, uint32_t b) {
+    return ComparePaths(self->GetPath(self->entries_[a]),
+                        self->GetPath(self->entries_[b])) < 0;
+  });
+  index->sorted_ = sorted;
+  return index;
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::CreateFromFile(
+    const base::FilePath& path,
+    base::StringPiece header_hash) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return nullptr;
+
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(std::move(file)))
+    return nullptr;
+
+  base::span<const uint8_t> data(mapped_file->data(), mapped_file->length());
+  if (data.size() < sizeof(SerializedHeader))
+    return nullptr;
+  SerializedHeader header;
+  memcpy(&header, data.data(), sizeof(header));
+  data = data.subspan(sizeof(header));
+  if (header.magic != kSerializedMagic ||
+      header.version != kSerializedVersion ||
+      header_hash != base::StringPiece(header.header_hash,
+                                       sizeof(header.header_hash))) {
+    LOG(WARNING) << "Ignoring stale asar index " << path.value();
+    return nullptr;
+  }
+
+  auto index = base::WrapUnique(new ArchiveIndex);
+  base::span<const char> strings;
+  if (!TakeSection(&data, header.entry_count, &index->entries_) ||
+      !TakeSection(&data, header.entry_count, &index->sorted_) ||
+      !TakeSection(&data, header.children_count, &index->children_) ||
+      !TakeSection(&data, header.blocks_count, &index->blocks_) ||
+      !TakeSection(&data, header.hashes_count * size_t{kHashLength},
+                   &index->hashes_) ||
+      !TakeSection(&data, header.strings_size, &strings)) {
+    LOG(ERROR) << "Truncated asar index " << path.value();
+    return nullptr;
+  }
+  index->strings_ = base::StringPiece(strings.data(), strings.size());
+  index->mapped_file_ = std::move(mapped_file);
+
+  if (!index->Validate()) {
+    LOG(ERROR) << "Malformed asar index " << path.value();
+    return nullptr;
+  }
+  return index;
+}
+
+// static
+std::string ArchiveIndex::HashHeader(base::StringPiece header) {
+  return crypto::SHA256HashString(header);
+}
+
+std::string ArchiveIndex::Serialize(base::StringPiece header_hash) const {
+  SerializedHeader header = {};
+  header.magic = kSerializedMagic;
+  header.version = kSerializedVersion;
+  header_hash.copy(header.header_hash, sizeof(header.header_hash));
+  header.entry_count = base::checked_cast<uint32_t>(entries_.size());
+  header.children_count = base::checked_cast<uint32_t>(children_.size());
+  header.blocks_count = base::checked_cast<uint32_t>(blocks_.size());
+  header.hashes_count = base::checked_cast<uint32_t>(hash_count());
+  header.strings_size = base::checked_cast<uint32_t>(strings_.size());
+
+  std::string out;
+  AppendSection(&out, &header, sizeof(header));
+  AppendSection(&out, entries_.data(), entries_.size_bytes());
+  AppendSection(&out, sorted_.data(), sorted_.size_bytes());
+  AppendSection(&out, children_.data(), children_.size_bytes());
+  AppendSection(&out, blocks_.data(), blocks_.size_bytes());
+  AppendSection(&out, hashes_.data(), hashes_.size_bytes());
+  AppendSection(&out, strings_.data(), strings_.size());
+  return out;
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::Resolve(base::StringPiece path) const {
+  return ResolveWithDepth(path, 0);
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::ResolveLink(const Entry& link) const {
+  const Entry* entry = &link;
+  for (int depth = 0; entry && entry->type == EntryType::kLink; ++depth) {
+    if (depth >= kMaxLinkDepth)
+      return nullptr;
+    entry = ResolveWithDepth(GetLinkTarget(*entry), depth);
+  }
+  return entry;
+}
+
+base::StringPiece ArchiveIndex::GetPath(const Entry& entry) const {
+  return base::StringPiece(strings_.data() + entry.path_offset,
+                           entry.path_length);
+}
+
+base::StringPiece ArchiveIndex::GetName(const Entry& entry) const {
+  return GetPath(entry).substr(entry.path_length - entry.name_length);
+}
+
+base::StringPiece ArchiveIndex::GetLinkTarget(const Entry& entry) const {
+  if (entry.type != EntryType::kLink)
+    return base::StringPiece();
+  return base::StringPiece(strings_.data() + entry.begin, entry.count);
+}
+
+std::vector<const ArchiveIndex::Entry*> ArchiveIndex::GetChildren(
+    const Entry& entry) const {
+  std::vector<const Entry*> children;
+  if (entry.type != EntryType::kDirectory)
+    return children;
+  children.reserve(entry.count);
+  for (uint32_t i = entry.begin; i < entry.begin + entry.count; ++i)
+    children.push_back(&entries_[children_[i]]);
+  return children;
+}
+
+base::span<const uint32_t> ArchiveIndex::GetBlocks(const Entry& entry) const {
+  if (entry.compression == Compression::kNone)
+    return base::span<const uint32_t>();
+  return blocks_.subspan(entry.first_block, entry.block_count);
+}
+
+base::span<const uint8_t> ArchiveIndex::GetHashes(const Entry& entry) const {
+  return hashes_.subspan(entry.first_hash * kHashLength,
+                         entry.hash_count * kHashLength);
+}
+
+bool ArchiveIndex::AddNode(const base::DictionaryValue& node,
+                           const std::string& path,
+                           size_t name_length,
+                           uint32_t* index) {
+  const uint32_t id = owned_entries_.size();
+  *index = id;
+  owned_entries_.emplace_back();
+  {
+    // Note that |entry| is invalidated once children are added below.
+    Entry& entry = owned_entries_.back();
+    entry.path_offset = InternString(path);
+    entry.path_length = path.size();
+    entry.name_length = name_length;
+  }
+
+  std::string link;
+  const base::DictionaryValue* files = nullptr;
+  if (node.GetStringWithoutPathExpansion("link", &link)) {
+    Entry& entry = owned_entries_[id];
+    entry.type = EntryType::kLink;
+    entry.valid = true;
+    entry.begin = InternString(link);
+    entry.count = link.size();
+    return true;
+  }
+
+  if (node.GetDictionaryWithoutPathExpansion("files", &files)) {
+    // Reserve the range of children up front, so the children of a directory
+    // are contiguous even though grandchildren are added in between.
+    const uint32_t begin = owned_children_.size();
+    owned_children_.resize(begin + files->size());
+    uint32_t count = 0;
+    for (base::DictionaryValue::Iterator iter(*files); !iter.IsAtEnd();
+         iter.Advance()) {
+      const base::DictionaryValue* child = nullptr;
+      if (!iter.value().GetAsDictionary(&child))
+        continue;
+      const std::string& name = iter.key();
+      uint32_t child_index;
+      if (!AddNode(*child, path.empty() ? name : path + '/' + name,
+                   name.size(), &child_index))
+        return false;
+      owned_children_[begin + count++] = child_index;
+    }
+    owned_children_.resize(begin + count);
+
+    Entry& entry = owned_entries_[id];
+    entry.type = EntryType::kDirectory;
+    entry.valid = true;
+    entry.begin = begin;
+    entry.count = count;
+    return true;
+  }
+
+  Entry& entry = owned_entries_[id];
+  entry.type = EntryType::kFile;
+  int size;
+  if (!node.GetInteger("size", &size))
+    return true;
+  entry.size = static_cast<uint32_t>(size);
+
+  if (node.GetBoolean("unpacked", &entry.unpacked) && entry.unpacked) {
+    entry.valid = true;
+    return true;
+  }
+
+  std::string offset;
+  if (!node.GetString("offset", &offset) ||
+      !base::StringToUint64(offset, &entry.offset))
+    return true;
+
+  node.GetBoolean("executable", &entry.executable);
+
+  const base::DictionaryValue* compression = nullptr;
+  if (node.GetDictionaryWithoutPathExpansion("compression", &compression) &&
+      !AddCompression(*compression, &entry))
+    return true;
+
+  // A file whose integrity information can not be read is not readable,
+  // rather than silently unverified.
+  const base::DictionaryValue* integrity = nullptr;
+  if (node.GetDictionaryWithoutPathExpansion("integrity", &integrity) &&
+      !AddIntegrity(*integrity, &entry))
+    return true;
+
+  entry.valid = true;
+  return true;
+}
+
+bool ArchiveIndex::AddCompression(const base::DictionaryValue& compression,
+                                  Entry* entry) {
+  std::string algorithm;
+  int compressed_size;
+  if (!compression.GetString("algorithm", &algorithm) ||
+      !compression.GetInteger("size", &compressed_size) ||
+      compressed_size < 0)
+    return false;
+  if (algorithm != "brotli") {
+    LOG(WARNING) << "Unsupported asar compression " << algorithm;
+    return false;
+  }
+  entry->compression = Compression::kBrotli;
+  entry->compressed_size = static_cast<uint32_t>(compressed_size);
+
+  // Without a seek table the file is a single compressed block.
+  const base::ListValue* blocks = nullptr;
+  int block_size = 0;
+  if (!compression.GetList("blocks", &blocks) ||
+      !compression.GetInteger("blockSize", &block_size)) {
+    entry->block_size = entry->size;
+    entry->first_block = owned_blocks_.size();
+    entry->block_count = 1;
+    owned_blocks_.push_back(entry->compressed_size);
+    return true;
+  }
+
+  if (block_size <= 0 ||
+      blocks->GetSize() != (entry->size + block_size - 1) / block_size)
+    return false;
+
+  entry->block_size = static_cast<uint32_t>(block_size);
+  entry->first_block = owned_blocks_.size();
+  entry->block_count = blocks->GetSize();
+  uint64_t end = 0;
+  for (const base::Value& block : blocks->GetList()) {
+    if (!block.is_int() || block.GetInt() < 0)
+      return false;
+    end += block.GetInt();
+    if (end > entry->compressed_size)
+      return false;
+    owned_blocks_.push_back(static_cast<uint32_t>(end));
+  }
+  return end == entry->compressed_size;
+}
+
+bool ArchiveIndex::AddIntegrity(const base::DictionaryValue& integrity,
+                                Entry* entry) {
+  std::string algorithm;
+  if (!integrity.GetString("algorithm", &algorithm) || algorithm != "SHA256") {
+    LOG(WARNING) << "Unsupported asar integrity algorithm " << algorithm;
+    return false;
+  }
+
+  // The hashes cover the bytes stored in the archive.
+  const uint32_t stored_size = entry->compression == Compression::kNone
+                                   ? entry->size
+                                   : entry->compressed_size;
+
+  // Without block hashes the hash of the whole file is a single block.
+  std::vector<std::string> hashes;
+  const base::ListValue* blocks = nullptr;
+  int block_size = 0;
+  if (integrity.GetList("blocks", &blocks) &&
+      integrity.GetInteger("blockSize", &block_size)) {
+    if (block_size <= 0 ||
+        blocks->GetSize() != (stored_size + block_size - 1) / block_size)
+      return false;
+    for (const base::Value& block : blocks->GetList()) {
+      if (!block.is_string())
+        return false;
+      hashes.push_back(block.GetString());
+    }
+  } else {
+    std::string hash;
+    if (!integrity.GetString("hash", &hash))
+      return false;
+    block_size = stored_size;
+    hashes.push_back(hash);
+  }
+
+  std::vector<uint8_t> bytes;
+  for (const std::string& hash : hashes) {
+    std::vector<uint8_t> hash_bytes;
+    if (!base::HexStringToBytes(hash, &hash_bytes) ||
+        hash_bytes.size() != kHashLength)
+      return false;
+    bytes.insert(bytes.end(), hash_bytes.begin(), hash_bytes.end());
+  }
+
+  // Empty files have nothing to verify.
+  if (stored_size == 0)
+    return true;
+
+  entry->integrity_block_size = static_cast<uint32_t>(block_size);
+  entry->first_hash = owned_hashes_.size() / kHashLength;
+  entry->hash_count = hashes.size();
+  owned_hashes_.insert(owned_hashes_.end(), bytes.begin(), bytes.end());
+  return true;
+}
+
+uint32_t ArchiveIndex::InternString(base::StringPiece str) {
+  const uint32_t offset = owned_strings_.size();
+  owned_strings_.append(str.data(), str.size());
+  return offset;
+}
+
+bool ArchiveIndex::Validate() const {
+  if (entries_.empty())
+    return false;
+  auto in_strings = [this](uint64_t offset, uint64_t length) {
+    return offset <= strings_.size() && length <= strings_.size() - offset;
+  };
+  for (const Entry& entry : entries_) {
+    if (!in_strings(entry.path_offset, entry.path_length) ||
+        entry.name_length > entry.path_length)
+      return false;
+    switch (entry.type) {
+      case EntryType::kFile:
+        if (entry.compression != Compression::kNone &&
+            (entry.compression != Compression::kBrotli ||
+             entry.first_block > blocks_.size() ||
+             entry.block_count > blocks_.size() - entry.first_block))
+          return false;
+        if (entry.hash_count > 0 &&
+            (entry.integrity_block_size == 0 ||
+             entry.first_hash > hash_count() ||
+             entry.hash_count > hash_count() - entry.first_hash))
+          return false;
+        break;
+      case EntryType::kLink:
+        if (!in_strings(entry.begin, entry.count))
+          return false;
+        break;
+      case EntryType::kDirectory:
+        if (entry.begin > children_.size() ||
+            entry.count > children_.size() - entry.begin)
+          return false;
+        break;
+      default:
+        return false;
+    }
+  }
+  for (uint32_t id : sorted_) {
+    if (id >= entries_.size())
+      return false;
+  }
+  for (uint32_t id : children_) {
+    if (id >= entries_.size())
+      return false;
+  }
+  return true;
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::Find(base::StringPiece path) const {
+  auto iter = std::lower_bound(
+      sorted_.begin(), sorted_.end(), path,
+      [this](uint32_t id, base::StringPiece key) {
+        return ComparePaths(GetPath(entries_[id]), key) < 0;
+      });
+  if (iter == sorted_.end() || ComparePaths(GetPath(entries_[*iter]), path))
+    return nullptr;
+  return &entries_[*iter];
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::ResolveWithDepth(
+    base::StringPiece path,
+    int depth) const {
+  while (!path.empty() &&
+         base::StringPiece(kSeparators).find(path.back()) !=
+             base::StringPiece::npos)
+    path.remove_suffix(1);
+
+  if (const Entry* entry = Find(path))
+    return entry;
+
+  // The path might go through a linked directory, find the nearest parent
+  // that exists and rewrite the path against the target if it is a link.
+  size_t pos = path.find_last_of(kSeparators);
+  while (pos != base::StringPiece::npos && pos > 0) {
+    const Entry* parent = Find(path.substr(0, pos));
+    if (parent) {
+      if (parent->type != EntryType::kLink || depth >= kMaxLinkDepth)
+        return nullptr;
+      std::string rewritten = GetLinkTarget(*parent).as_string();
+      path.substr(pos).AppendToString(&rewritten);
+      return ResolveWithDepth(rewritten, depth + 1);
+    }
+    pos = path.find_last_of(kSeparators, pos - 1);
+  }
+  return nullptr;
+}
+
+}  // namespace asar
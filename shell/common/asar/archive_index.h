@@ -0,0 +1,195 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+#define SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class DictionaryValue;
+class FilePath;
+class MemoryMappedFile;
+}  // namespace base
+
+namespace asar {
+
+// Compression of the packed contents of a file.
+enum class Compression : uint8_t {
+  kNone,
+  kBrotli,
+};
+
+// A compact, immutable index of the entries of an asar archive.
+//
+// The JSON header is walked only once to build the index, afterwards the
+// entries are kept as packed records with their paths interned in a single
+// string table, and lookups are binary searches that do not allocate.
+//
+// The index can also be serialized into a sidecar file, which packaging tools
+// ship next to the archive (app.asar.idx), so processes can map it directly
+// instead of parsing the JSON header. The serialized layout is:
+//
+//   SerializedHeader
+//   Entry[entry_count]
+//   uint32_t sorted[entry_count]
+//   uint32_t children[children_count]
+//   uint32_t blocks[blocks_count]
+//   uint8_t hashes[hashes_count * kHashLength]
+//   char strings[strings_size]
+//
+// with each section padded to 8 bytes, in little endian.
+class ArchiveIndex {
+ public:
+  enum class EntryType : uint8_t {
+    kFile,
+    kDirectory,
+    kLink,
+  };
+
+  struct Entry {
+    // Offset of the file contents, relative to the end of the header. It comes
+    // first so that the fields need no padding.
+    uint64_t offset = 0;
+    // Full path of the entry relative to the archive root, separated by "/".
+    uint32_t path_offset = 0;
+    uint32_t path_length = 0;
+    // The base name is the tail of the path.
+    uint32_t name_length = 0;
+    // Uncompressed size of the file.
+    uint32_t size = 0;
+    // Size of the compressed contents in the archive.
+    uint32_t compressed_size = 0;
+    // Compressed files can be split into blocks of |block_size| uncompressed
+    // bytes that are compressed independently, so a range can be read without
+    // decompressing the whole file. The blocks are the range of |blocks_| that
+    // holds the end offset of each compressed block.
+    uint32_t block_size = 0;
+    uint32_t first_block = 0;
+    uint32_t block_count = 0;
+    // Files with integrity information are split into blocks of
+    // |integrity_block_size| stored bytes, and the SHA256 of each block is
+    // the range of |hashes_| starting at |first_hash|.
+    uint32_t integrity_block_size = 0;
+    uint32_t first_hash = 0;
+    uint32_t hash_count = 0;
+    // Directories: range of the children in |children_|.
+    // Links: the target path in |strings_|.
+    uint32_t begin = 0;
+    uint32_t count = 0;
+    EntryType type = EntryType::kFile;
+    Compression compression = Compression::kNone;
+    // Whether the header has all the information to read the file.
+    bool valid = false;
+    bool unpacked = false;
+    bool executable = false;
+    // Written as zeroes, fills the entry up to its alignment.
+    uint8_t reserved[7] = {};
+  };
+
+  // Length of the SHA256 hash of an integrity block, and of the header hash
+  // recorded in serialized indices.
+  static constexpr size_t kHashLength = 32;
+
+  ~ArchiveIndex();
+
+  // Builds the index from the parsed JSON header, returns nullptr if the
+  // header is malformed.
+  static std::unique_ptr<ArchiveIndex> Create(
+      const base::DictionaryValue& header);
+
+  // Maps a serialized index from |path|, returns nullptr if the file does not
+  // exist, is malformed, or was not built from a header with |header_hash|.
+  static std::unique_ptr<ArchiveIndex> CreateFromFile(
+      const base::FilePath& path,
+      base::StringPiece header_hash);
+
+  // Computes the hash recorded in serialized indices for the raw JSON header.
+  static std::string HashHeader(base::StringPiece header);
+
+  // Serializes the index, tagged with |header_hash|.
+  std::string Serialize(base::StringPiece header_hash) const;
+
+  // Returns the entry of |path| following links in the parent directories,
+  // but not the entry itself. Returns nullptr if there is no such entry.
+  const Entry* Resolve(base::StringPiece path) const;
+
+  // Returns the entry that |link| points at, or nullptr.
+  const Entry* ResolveLink(const Entry& link) const;
+
+  base::StringPiece GetPath(const Entry& entry) const;
+  base::StringPiece GetName(const Entry& entry) const;
+  base::StringPiece GetLinkTarget(const Entry& entry) const;
+
+  // Returns the children of a directory entry.
+  std::vector<const Entry*> GetChildren(const Entry& entry) const;
+
+  // Returns the end offsets of the compressed blocks of a file entry, relative
+  // to the start of its compressed contents.
+  base::span<const uint32_t> GetBlocks(const Entry& entry) const;
+
+  // Returns the hashes of the integrity blocks of a file entry, each one is
+  // |kHashLength| bytes.
+  base::span<const uint8_t> GetHashes(const Entry& entry) const;
+
+  size_t size() const { return entries_.size(); }
+  base::span<const Entry> entries() const { return entries_; }
+
+  // Total number of integrity blocks of all entries.
+  size_t hash_count() const { return hashes_.size() / kHashLength; }
+
+ private:
+  ArchiveIndex();
+
+  bool AddNode(const base::DictionaryValue& node,
+               const std::string& path,
+               size_t name_length,
+               uint32_t* index);
+  // Reads the "compression" field of a file node into |entry|, returns false
+  // if the file can not be read.
+  bool AddCompression(const base::DictionaryValue& compression, Entry* entry);
+  // Reads the "integrity" field of a file node into |entry|, returns false if
+  // it is malformed.
+  bool AddIntegrity(const base::DictionaryValue& integrity, Entry* entry);
+  uint32_t InternString(base::StringPiece str);
+
+  // Checks that every record of a mapped index is within bounds.
+  bool Validate() const;
+
+  // Exact lookup of |path|, without following links.
+  const Entry* Find(base::StringPiece path) const;
+  const Entry* ResolveWithDepth(base::StringPiece path, int depth) const;
+
+  base::span<const Entry> entries_;
+  // Indices into |entries_| sorted by path.
+  base::span<const uint32_t> sorted_;
+  // Indices into |entries_| of the children of each directory.
+  base::span<const uint32_t> children_;
+  base::span<const uint32_t> blocks_;
+  base::span<const uint8_t> hashes_;
+  base::StringPiece strings_;
+
+  // Backing storage when the index is built from the header.
+  std::vector<Entry> owned_entries_;
+  std::vector<uint32_t> owned_sorted_;
+  std::vector<uint32_t> owned_children_;
+  std::vector<uint32_t> owned_blocks_;
+  std::vector<uint8_t> owned_hashes_;
+  std::string owned_strings_;
+
+  // Backing storage when the index is mapped from a file.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArchiveIndex);
+};
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
@@ -0,0 +1,47 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive.h"
+
+#include <elf.h>
+#include <string.h>
+
+#include <string>
+
+#include "build/build_config.h"
+
+namespace asar {
+
+bool GetHeaderIntegrity(const base::FilePath& path, std::string* hash) {
+  // There is no place to pin the header on Linux that the app controls and
+  // that is covered by its signature.
+  return false;
+}
+
+bool IsLoadableNativeModule(base::span<const uint8_t> head) {
+#if defined(ARCH_CPU_X86_64)
+  const uint16_t kMachine = EM_X86_64;
+#elif defined(ARCH_CPU_ARM64)
+  const uint16_t kMachine = EM_AARCH64;
+#elif defined(ARCH_CPU_ARMEL)
+  const uint16_t kMachine = EM_ARM;
+#elif defined(ARCH_CPU_X86)
+  const uint16_t kMachine = EM_386;
+#elif defined(ARCH_CPU_MIPS_FAMILY)
+  const uint16_t kMachine = EM_MIPS;
+#else
+  // Any machine is considered loadable on other architectures.
+  const uint16_t kMachine = EM_NONE;
+#endif
+  Elf32_Ehdr header;
+  if (head.size() < sizeof(header))
+    return false;
+  // e_machine is at the same offset in 32 and 64 bit headers.
+  memcpy(&header, head.data(), sizeof(header));
+  return memcmp(header.e_ident, ELFMAG, SELFMAG) == 0 &&
+         header.e_type == ET_DYN &&
+         (kMachine == EM_NONE || header.e_machine == kMachine);
+}
+
+}  // namespace asar
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive.h"
+
+#import <Foundation/Foundation.h>
+#include <mach-o/fat.h>
+#include <mach-o/loader.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/mac/foundation_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/sys_string_conversions.h"
+#include "build/build_config.h"
+#include "shell/common/mac/main_application_bundle.h"
+
+namespace asar {
+
+bool GetHeaderIntegrity(const base::FilePath& path, std::string* hash) {
+  NSDictionary* integrity = base::mac::ObjCCast<NSDictionary>(
+      [electron::MainApplicationBundle().infoDictionary
+          objectForKey:@"ElectronAsarIntegrity"]);
+  if (!integrity)
+    return false;
+
+  // Archives are listed relative to the Contents directory of the bundle.
+  base::FilePath relative_path;
+  if (!electron::MainApplicationBundlePath()
+           .Append("Contents")
+           .AppendRelativePath(path, &relative_path))
+    return false;
+
+  NSDictionary* entry = base::mac::ObjCCast<NSDictionary>([integrity
+      objectForKey:base::SysUTF8ToNSString(relative_path.value())]);
+  if (!entry)
+    return false;
+
+  // A malformed entry still pins the archive, to a hash nothing matches.
+  hash->clear();
+  NSString* algorithm =
+      base::mac::ObjCCast<NSString>([entry objectForKey:@"algorithm"]);
+  NSString* value = base::mac::ObjCCast<NSString>([entry objectForKey:@"hash"]);
+  std::vector<uint8_t> bytes;
+  if ([algorithm isEqualToString:@"SHA256"] && value &&
+      base::HexStringToBytes(base::SysNSStringToUTF8(value), &bytes))
+    hash->assign(bytes.begin(), bytes.end());
+  return true;
+}
+
+bool IsLoadableNativeModule(base::span<const uint8_t> head) {
+#if defined(ARCH_CPU_ARM64)
+  const cpu_type_t kCpuType = CPU_TYPE_ARM64;
+#else
+  const cpu_type_t kCpuType = CPU_TYPE_X86_64;
+#endif
+  uint32_t magic;
+  if (head.size() < sizeof(magic))
+    return false;
+  memcpy(&magic, head.data(), sizeof(magic));
+
+  // Universal binaries are stored big endian, and usually carry this
+  // architecture.
+  if (magic == FAT_CIGAM || magic == FAT_MAGIC)
+    return true;
+
+  mach_header_64 header;
+  if (magic != MH_MAGIC_64 || head.size() < sizeof(header))
+    return false;
+  memcpy(&header, head.data(), sizeof(header));
+  return header.cputype == kCpuType &&
+         (header.filetype == MH_BUNDLE || header.filetype == MH_DYLIB);
+}
+
+}  // namespace asar
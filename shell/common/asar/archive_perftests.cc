@@ -0,0 +1,125 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive.h"
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/values.h"
+#include "shell/common/perf_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace asar {
+
+namespace {
+
+constexpr int kDirectoryCount = 20;
+constexpr int kFilesPerDirectory = 50;
+constexpr size_t kFileSize = 4096;
+
+base::FilePath GetFilePath(int directory, int file) {
+  return base::FilePath::FromUTF8Unsafe(
+      base::StringPrintf("dir-%d/file-%d.txt", directory, file));
+}
+
+class ArchivePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("perf.asar");
+
+    // Same layout as the archives of the asar package: the size of the
+    // header pickle, the pickled JSON header, then the file contents.
+    base::Value files(base::Value::Type::DICTIONARY);
+    uint64_t offset = 0;
+    for (int i = 0; i < kDirectoryCount; ++i) {
+      base::Value directory_files(base::Value::Type::DICTIONARY);
+      for (int j = 0; j < kFilesPerDirectory; ++j) {
+        base::Value file(base::Value::Type::DICTIONARY);
+        file.SetIntKey("size", kFileSize);
+        file.SetStringKey("offset", base::NumberToString(offset));
+        directory_files.SetKey(base::StringPrintf("file-%d.txt", j),
+                               std::move(file));
+        offset += kFileSize;
+      }
+      base::Value directory(base::Value::Type::DICTIONARY);
+      directory.SetKey("files", std::move(directory_files));
+      files.SetKey(base::StringPrintf("dir-%d", i), std::move(directory));
+    }
+    base::Value root(base::Value::Type::DICTIONARY);
+    root.SetKey("files", std::move(files));
+    std::string json;
+    ASSERT_TRUE(base::JSONWriter::Write(root, &json));
+
+    base::Pickle header;
+    header.WriteString(json);
+    base::Pickle header_size;
+    header_size.WriteUInt32(header.size());
+
+    std::string contents(static_cast<const char*>(header_size.data()),
+                         header_size.size());
+    contents.append(static_cast<const char*>(header.data()), header.size());
+    contents.append(offset, 'a');
+    ASSERT_TRUE(base::WriteFile(path_, contents));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(ArchivePerfTest, Init) {
+  electron::MeasureRunsPerSecond("asar_archive", "init", [&]() {
+    Archive archive(path_);
+    ASSERT_TRUE(archive.Init());
+  });
+}
+
+TEST_F(ArchivePerfTest, GetFileInfo) {
+  Archive archive(path_);
+  ASSERT_TRUE(archive.Init());
+  int n = 0;
+  electron::MeasureRunsPerSecond("asar_archive", "get_file_info", [&]() {
+    Archive::FileInfo info;
+    ASSERT_TRUE(archive.GetFileInfo(
+        GetFilePath(n % kDirectoryCount, n % kFilesPerDirectory), &info));
+    ++n;
+  });
+}
+
+TEST_F(ArchivePerfTest, Stat) {
+  Archive archive(path_);
+  ASSERT_TRUE(archive.Init());
+  int n = 0;
+  electron::MeasureRunsPerSecond("asar_archive", "stat", [&]() {
+    Archive::Stats stats;
+    ASSERT_TRUE(archive.Stat(
+        GetFilePath(n % kDirectoryCount, n % kFilesPerDirectory), &stats));
+    ++n;
+  });
+}
+
+TEST_F(ArchivePerfTest, ReadFileContents) {
+  Archive archive(path_);
+  ASSERT_TRUE(archive.Init());
+  int n = 0;
+  electron::MeasureRunsPerSecond("asar_archive", "read_file_contents", [&]() {
+    Archive::FileInfo info;
+    ASSERT_TRUE(archive.GetFileInfo(
+        GetFilePath(n % kDirectoryCount, n % kFilesPerDirectory), &info));
+    std::string contents;
+    ASSERT_TRUE(archive.ReadFileContents(info, &contents));
+    ++n;
+  });
+}
+
+}  // namespace asar
@@ -0,0 +1,110 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive.h"
+
+#include <string.h>
+#include <windows.h>
+
+#include <string>
+#include <vector>
+
+#include "base/base_paths.h"
+#include "base/files/file_path.h"
+#include "base/json/json_reader.h"
+#include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "build/build_config.h"
+
+namespace asar {
+
+namespace {
+
+// Reads the RCDATA resource that packaging tools embed into the executable,
+// a JSON list of {"file": <path relative to the executable>, "alg":
+// "sha256", "value": <hex hash>} records.
+base::Optional<base::Value> ReadIntegrityResource() {
+  HMODULE module = ::GetModuleHandle(nullptr);
+  HRSRC resource = ::FindResource(module, L"ELECTRONASAR", L"INTEGRITY");
+  if (!resource)
+    return base::nullopt;
+  HGLOBAL data = ::LoadResource(module, resource);
+  const DWORD size = ::SizeofResource(module, resource);
+  const char* bytes = data ? static_cast<const char*>(::LockResource(data))
+                           : nullptr;
+  if (!bytes)
+    return base::nullopt;
+  return base::JSONReader::Read(base::StringPiece(bytes, size));
+}
+
+}  // namespace
+
+bool GetHeaderIntegrity(const base::FilePath& path, std::string* hash) {
+  base::Optional<base::Value> records = ReadIntegrityResource();
+  if (!records || !records->is_list())
+    return false;
+
+  base::FilePath exe_dir;
+  base::FilePath relative_path;
+  if (!base::PathService::Get(base::DIR_EXE, &exe_dir) ||
+      !exe_dir.AppendRelativePath(path, &relative_path))
+    return false;
+
+  for (const base::Value& record : records->GetList()) {
+    if (!record.is_dict())
+      continue;
+    const std::string* file = record.FindStringKey("file");
+    if (!file || !base::FilePath::CompareEqualIgnoreCase(
+                     base::FilePath::FromUTF8Unsafe(*file)
+                         .NormalizePathSeparators()
+                         .value(),
+                     relative_path.value()))
+      continue;
+
+    // A malformed record still pins the archive, to a hash nothing matches.
+    hash->clear();
+    const std::string* algorithm = record.FindStringKey("alg");
+    const std::string* value = record.FindStringKey("value");
+    std::vector<uint8_t> bytes;
+    if (algorithm && base::LowerCaseEqualsASCII(*algorithm, "sha256") &&
+        value && base::HexStringToBytes(*value, &bytes))
+      hash->assign(bytes.begin(), bytes.end());
+    return true;
+  }
+  return false;
+}
+
+bool IsLoadableNativeModule(base::span<const uint8_t> head) {
+#if defined(ARCH_CPU_X86_64)
+  const WORD kMachine = IMAGE_FILE_MACHINE_AMD64;
+#elif defined(ARCH_CPU_ARM64)
+  const WORD kMachine = IMAGE_FILE_MACHINE_ARM64;
+#else
+  const WORD kMachine = IMAGE_FILE_MACHINE_I386;
+#endif
+  IMAGE_DOS_HEADER dos_header;
+  if (head.size() < sizeof(dos_header))
+    return false;
+  memcpy(&dos_header, head.data(), sizeof(dos_header));
+  if (dos_header.e_magic != IMAGE_DOS_SIGNATURE || dos_header.e_lfanew < 0)
+    return false;
+
+  const size_t offset = static_cast<size_t>(dos_header.e_lfanew);
+  DWORD signature;
+  IMAGE_FILE_HEADER file_header;
+  if (offset > head.size() ||
+      head.size() - offset < sizeof(signature) + sizeof(file_header))
+    return false;
+  memcpy(&signature, head.data() + offset, sizeof(signature));
+  memcpy(&file_header, head.data() + offset + sizeof(signature),
+         sizeof(file_header));
+  return signature == IMAGE_NT_SIGNATURE &&
+         file_header.Machine == kMachine &&
+         (file_header.Characteristics & IMAGE_FILE_DLL) != 0;
+}
+
+}  // namespace asar
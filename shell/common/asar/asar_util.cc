@@ -5,12 +5,19 @@
 #include "shell/common/asar/asar_util.h"
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
 #include "shell/common/asar/archive.h"
@@ -19,24 +26,98 @@ namespace asar {
 
 namespace {
 
-// The global instance of ArchiveMap, will be destroyed on exit.
 typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
+
+// Process-wide registry of opened archives. Archives are immutable once
+// opened, so all threads, including workers, share the same instances.
+struct SharedArchives {
+  base::Lock lock;
+  ArchiveMap map;
+};
+
+base::LazyInstance<SharedArchives>::Leaky g_shared_archives =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Per-thread view of |g_shared_archives|, so that archives this thread has
+// already seen are found without taking the lock.
 base::LazyInstance<base::ThreadLocalPointer<ArchiveMap>>::Leaky
     g_archive_map_tls = LAZY_INSTANCE_INITIALIZER;
 
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
+base::LazyInstance<base::Lock>::Leaky g_is_directory_cache_lock =
+    LAZY_INSTANCE_INITIALIZER;
 std::map<base::FilePath, bool> g_is_directory_cache;
 
 bool IsDirectoryCached(const base::FilePath& path) {
-  auto it = g_is_directory_cache.find(path);
-  if (it != g_is_directory_cache.end()) {
-    return it->second;
+  {
+    base::AutoLock auto_lock(g_is_directory_cache_lock.Get());
+    auto it = g_is_directory_cache.find(path);
+    if (it != g_is_directory_cache.end()) {
+      return it->second;
+    }
   }
   base::ThreadRestrictions::ScopedAllowIO allow_io;
-  return g_is_directory_cache[path] = base::DirectoryExists(path);
+  bool is_directory = base::DirectoryExists(path);
+  base::AutoLock auto_lock(g_is_directory_cache_lock.Get());
+  return g_is_directory_cache[path] = is_directory;
 }
 
+// Records the read order of archives for ELECTRON_LOG_ASAR_READS.
+class ReadLogger {
+ public:
+  static ReadLogger* Get() {
+    static base::NoDestructor<ReadLogger> logger;
+    return logger.get();
+  }
+
+  ReadLogger() {
+    enabled_ = base::Environment::Create()->HasVar("ELECTRON_LOG_ASAR_READS");
+  }
+
+  void Log(const base::FilePath& asar_path,
+           const base::FilePath& relative_path,
+           uint64_t offset) {
+    if (!enabled_)
+      return;
+
+    base::AutoLock auto_lock(lock_);
+    // Only the first read matters for the ordering.
+    if (!seen_.emplace(asar_path, relative_path).second)
+      return;
+
+    auto it = logs_.find(asar_path);
+    if (it == logs_.end()) {
+      base::ThreadRestrictions::ScopedAllowIO allow_io;
+      base::FilePath temp_dir;
+      base::File log;
+      if (base::GetTempDir(&temp_dir)) {
+        base::FilePath::StringType name =
+            asar_path.BaseName().RemoveExtension().value();
+        log.Initialize(temp_dir.Append(name + FILE_PATH_LITERAL(
+                                                  "-access-log.txt")),
+                       base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+      }
+      it = logs_.emplace(asar_path, std::move(log)).first;
+    }
+
+    if (!it->second.IsValid())
+      return;
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    std::string line = base::NumberToString(offset) + ": " +
+                       relative_path.AsUTF8Unsafe() + "\n";
+    it->second.WriteAtCurrentPos(line.data(), line.size());
+  }
+
+ private:
+  bool enabled_ = false;
+  base::Lock lock_;
+  std::set<std::pair<base::FilePath, base::FilePath>> seen_;
+  std::map<base::FilePath, base::File> logs_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadLogger);
+};
+
 }  // namespace
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
@@ -44,25 +125,72 @@ std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
     g_archive_map_tls.Pointer()->Set(new ArchiveMap);
   ArchiveMap& map = *g_archive_map_tls.Pointer()->Get();
 
-  // if we have it, return it
+  // if this thread has it, return it
   const auto lower = map.lower_bound(path);
   if (lower != std::end(map) && !map.key_comp()(path, lower->first))
     return lower->second;
 
+  // if another thread has it, share it
+  SharedArchives& shared = g_shared_archives.Get();
+  std::shared_ptr<Archive> archive;
+  {
+    base::AutoLock auto_lock(shared.lock);
+    auto it = shared.map.find(path);
+    if (it != shared.map.end())
+      archive = it->second;
+  }
+
   // if we can create it, return it
-  auto archive = std::make_shared<Archive>(path);
-  if (archive->Init()) {
-    base::TryEmplace(map, lower, path, archive);
-    return archive;
+  if (!archive) {
+    // Parse the header without holding the lock, if another thread opened the
+    // same archive meanwhile, use the one that got registered first.
+    auto new_archive = std::make_shared<Archive>(path);
+    if (!new_archive->Init()) {
+      // didn't have it, couldn't create it
+      return nullptr;
+    }
+    base::AutoLock auto_lock(shared.lock);
+    archive = shared.map.emplace(path, std::move(new_archive)).first->second;
   }
 
-  // didn't have it, couldn't create it
-  return nullptr;
+  base::TryEmplace(map, lower, path, archive);
+  return archive;
 }
 
 void ClearArchives() {
-  if (g_archive_map_tls.Pointer()->Get())
+  if (g_archive_map_tls.Pointer()->Get()) {
     delete g_archive_map_tls.Pointer()->Get();
+    g_archive_map_tls.Pointer()->Set(nullptr);
+  }
+
+  // Close the archives that no other thread is using anymore.
+  SharedArchives& shared = g_shared_archives.Get();
+  base::AutoLock auto_lock(shared.lock);
+  base::EraseIf(shared.map, [](const ArchiveMap::value_type& entry) {
+    return entry.second.use_count() == 1;
+  });
+}
+
+std::vector<base::FilePath> GetOpenArchivePaths() {
+  SharedArchives& shared = g_shared_archives.Get();
+  base::AutoLock auto_lock(shared.lock);
+  std::vector<base::FilePath> paths;
+  paths.reserve(shared.map.size());
+  for (const auto& entry : shared.map)
+    paths.push_back(entry.first);
+  return paths;
+}
+
+void ExtractNativeModules() {
+  for (const base::FilePath& asar_path : GetOpenArchivePaths()) {
+    std::shared_ptr<Archive> archive = GetOrCreateAsarArchive(asar_path);
+    if (!archive)
+      continue;
+    for (const base::FilePath& path : archive->GetLoadableNativeModules()) {
+      base::FilePath extracted_path;
+      archive->CopyFileOut(path, &extracted_path);
+    }
+  }
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -109,14 +237,15 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
-  base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
-  if (!src.IsValid())
-    return false;
+  LogArchiveRead(asar_path, relative_path, info.offset);
+
+  return archive->ReadFileContents(info, contents);
+}
 
-  contents->resize(info.size);
-  return static_cast<int>(info.size) ==
-         src.Read(info.offset, const_cast<char*>(contents->data()),
-                  contents->size());
+void LogArchiveRead(const base::FilePath& asar_path,
+                    const base::FilePath& relative_path,
+                    uint64_t offset) {
+  ReadLogger::Get()->Log(asar_path, relative_path, offset);
 }
 
 }  // namespace asar
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace base {
 class FilePath;
@@ -16,12 +17,22 @@ namespace asar {
 
 class Archive;
 
-// Gets or creates a new Archive from the path.
+// Gets or creates a new Archive from the path, the Archive is shared by all
+// threads of the process.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
 
-// Destroy cached Archive objects.
+// Destroy the cached Archive objects of the calling thread, and close the
+// archives that are no longer used by any thread.
 void ClearArchives();
 
+// Returns the paths of the archives opened by any thread of this process.
+std::vector<base::FilePath> GetOpenArchivePaths();
+
+// Extracts the native modules for this platform packed in the open archives
+// into the extraction cache, so that the processes requiring them later find
+// them extracted. It blocks, and is meant to run on the thread pool.
+void ExtractNativeModules();
+
 // Separates the path to Archive out.
 bool GetAsarArchivePath(const base::FilePath& full_path,
                         base::FilePath* asar_path,
@@ -31,6 +42,14 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
 // Same with base::ReadFileToString but supports asar Archive.
 bool ReadFileToString(const base::FilePath& path, std::string* contents);
 
+// When ELECTRON_LOG_ASAR_READS is set, appends the first read of each file
+// in an archive to "<archive>-access-log.txt" in the temp dir. The resulting
+// read-order profile can be passed to `asar pack --ordering` so that startup
+// reads become mostly sequential.
+void LogArchiveRead(const base::FilePath& asar_path,
+                    const base::FilePath& relative_path,
+                    uint64_t offset);
+
 }  // namespace asar
 
 #endif  // SHELL_COMMON_ASAR_ASAR_UTIL_H_
@@ -0,0 +1,207 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/extraction_cache.h"
+
+#include <string.h>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+
+#if defined(OS_POSIX)
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(OS_WIN)
+#include <windows.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+// Cached copies that have not been used for this long are removed.
+constexpr base::TimeDelta kMaxUnusedAge = base::TimeDelta::FromDays(30);
+
+#if defined(OS_POSIX)
+// The temporary directory can be shared by all users, only use a cache
+// directory that is owned by us and not accessible by anyone else, otherwise
+// another user could plant code in it.
+bool IsPrivateDirectory(const base::FilePath& path) {
+  struct stat st;
+  if (lstat(path.value().c_str(), &st) != 0)
+    return false;
+  return S_ISDIR(st.st_mode) && st.st_uid == geteuid() &&
+         (st.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+}
+#endif
+
+// Returns the cache directory, or an empty path if it can not be used.
+base::FilePath CreateCacheDirectory() {
+  base::FilePath temp_dir;
+  if (!base::GetTempDir(&temp_dir))
+    return base::FilePath();
+
+#if defined(OS_POSIX)
+  base::FilePath dir = temp_dir.Append(
+      "electron-asar-cache-" + base::NumberToString(geteuid()));
+  if (!base::DirectoryExists(dir) && mkdir(dir.value().c_str(), 0700) != 0 &&
+      errno != EEXIST)
+    return base::FilePath();
+  if (!IsPrivateDirectory(dir)) {
+    LOG(WARNING) << "Not using asar extraction cache " << dir.value();
+    return base::FilePath();
+  }
+#else
+  // The temporary directory is per user on Windows.
+  base::FilePath dir =
+      temp_dir.Append(FILE_PATH_LITERAL("electron-asar-cache"));
+  if (!base::CreateDirectory(dir))
+    return base::FilePath();
+#endif
+  return dir;
+}
+
+// Removes the copies, and the leftovers of interrupted extractions, that no
+// process used recently. Loaded copies stay valid on POSIX, and can not be
+// removed on Windows.
+void RemoveUnusedCopies(const base::FilePath& dir) {
+  const base::Time cutoff = base::Time::Now() - kMaxUnusedAge;
+  base::FileEnumerator enumerator(dir, false, base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (enumerator.GetInfo().GetLastModifiedTime() >= cutoff)
+      continue;
+#if defined(OS_WIN)
+    ::SetFileAttributes(path.value().c_str(), FILE_ATTRIBUTE_NORMAL);
+#endif
+    base::DeleteFile(path, false);
+  }
+}
+
+const base::FilePath& GetCacheDirectory() {
+  static const base::NoDestructor<base::FilePath> dir([] {
+    base::FilePath dir = CreateCacheDirectory();
+    if (!dir.empty())
+      RemoveUnusedCopies(dir);
+    return dir;
+  }());
+  return *dir;
+}
+
+base::FilePath GetCachedCopyPath(const base::FilePath& dir,
+                                 const std::string& key,
+                                 const base::FilePath::StringType& ext) {
+  base::FilePath path = dir.AppendASCII(key);
+  if (!ext.empty())
+    path = path.AddExtension(ext);
+  return path;
+}
+
+// Whether |path| is a copy of |size| bytes. The key already identifies the
+// contents, and copies only get their name once they are completely written,
+// so the size is enough to catch a copy that was since truncated.
+bool HasCachedCopy(const base::FilePath& path, uint64_t size) {
+  int64_t cached_size;
+  if (!base::GetFileSize(path, &cached_size) ||
+      static_cast<uint64_t>(cached_size) != size)
+    return false;
+  // Keeps the copy from being removed as unused.
+  const base::Time now = base::Time::Now();
+  base::TouchFile(path, now, now);
+  return true;
+}
+
+// Whether |path| is a copy of exactly |contents|. Callers that have the
+// contents at hand compare them, so that a copy damaged or planted under the
+// right name and size is not used.
+bool IsCachedCopyOf(const base::FilePath& path,
+                    base::span<const uint8_t> contents) {
+  std::string cached;
+  if (!base::ReadFileToStringWithMaxSize(path, &cached, contents.size()) ||
+      cached.size() != contents.size() ||
+      (!contents.empty() &&
+       memcmp(cached.data(), contents.data(), contents.size()) != 0))
+    return false;
+  return HasCachedCopy(path, contents.size());
+}
+
+}  // namespace
+
+bool ExtractToCache(const std::string& key,
+                    const base::FilePath::StringType& ext,
+                    base::span<const uint8_t> contents,
+                    bool executable,
+                    base::FilePath* out) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  const base::FilePath& dir = GetCacheDirectory();
+  if (dir.empty())
+    return false;
+
+  base::FilePath path = GetCachedCopyPath(dir, key, ext);
+  if (IsCachedCopyOf(path, contents)) {
+    *out = path;
+    return true;
+  }
+
+  base::FilePath temp_path;
+  if (!base::CreateTemporaryFileInDir(dir, &temp_path))
+    return false;
+  if (base::WriteFile(temp_path, reinterpret_cast<const char*>(contents.data()),
+                      contents.size()) != static_cast<int>(contents.size())) {
+    base::DeleteFile(temp_path, false);
+    return false;
+  }
+
+  // Copies are shared by all processes and launches, none of them may
+  // modify a copy that the others have loaded.
+#if defined(OS_POSIX)
+  base::SetPosixFilePermissions(temp_path, executable ? 0500 : 0400);
+#elif defined(OS_WIN)
+  ::SetFileAttributes(temp_path.value().c_str(), FILE_ATTRIBUTE_READONLY);
+#endif
+
+#if defined(OS_WIN)
+  // A copy with other contents is read-only too, which keeps it from being
+  // replaced.
+  if (base::PathExists(path))
+    ::SetFileAttributes(path.value().c_str(), FILE_ATTRIBUTE_NORMAL);
+#endif
+
+  // Another process may have extracted the same file meanwhile, on Windows
+  // the rename then fails if that copy is already loaded.
+  if (!base::ReplaceFile(temp_path, path, nullptr)) {
+    base::DeleteFile(temp_path, false);
+    if (!IsCachedCopyOf(path, contents))
+      return false;
+  }
+
+  *out = path;
+  return true;
+}
+
+bool GetCachedCopy(const std::string& key,
+                   const base::FilePath::StringType& ext,
+                   uint64_t size,
+                   base::FilePath* out) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  const base::FilePath& dir = GetCacheDirectory();
+  if (dir.empty())
+    return false;
+
+  base::FilePath path = GetCachedCopyPath(dir, key, ext);
+  if (!HasCachedCopy(path, size))
+    return false;
+  *out = path;
+  return true;
+}
+
+}  // namespace asar
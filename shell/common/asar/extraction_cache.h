@@ -0,0 +1,49 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+#define SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+
+namespace asar {
+
+// Files that have to be copied out of an archive, like native modules and
+// executables, are extracted once into a per-user cache directory and reused
+// by later launches and by other processes. All processes load a native
+// module from the same copy, so the OS shares its pages between them. Copies
+// are read-only once written.
+//
+// Entries are named by |key|, which callers derive from the identity of the
+// archive plus the offset and size of the file, so that a copy can be found
+// without reading the file from the archive. Entries are written to a
+// temporary file first and then renamed, so a copy under its final name is
+// complete and concurrent extractions of the same file are safe. Entries that
+// no process used for a month are removed.
+//
+// A copy already under the name of |key| is only used if it holds |contents|,
+// otherwise it is replaced.
+//
+// Returns false if the cache directory can not be used, in which case callers
+// should fall back to a temporary file.
+bool ExtractToCache(const std::string& key,
+                    const base::FilePath::StringType& ext,
+                    base::span<const uint8_t> contents,
+                    bool executable,
+                    base::FilePath* out);
+
+// Looks up the copy that ExtractToCache() wrote for |key|, which is only
+// checked to have |size| bytes, so it must not be used for files whose
+// contents have to be verified. Returns false if there is none.
+bool GetCachedCopy(const std::string& key,
+                   const base::FilePath::StringType& ext,
+                   uint64_t size,
+                   base::FilePath* out);
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
@@ -0,0 +1,194 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/async_log_sink.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/string_escape.h"
+#include "base/logging.h"
+#include "base/process/process_handle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+
+namespace electron {
+
+namespace {
+
+// The writer wakes up when this many messages are queued, or after the
+// interval otherwise.
+constexpr size_t kBatchSize = 256;
+constexpr base::TimeDelta kFlushInterval =
+    base::TimeDelta::FromMilliseconds(100);
+
+// Messages past this are dropped until the writer catches up, and counted in
+// a message of their own.
+constexpr size_t kMaxQueuedMessages = 64 * 1024;
+
+bool g_installed = false;
+
+const char* GetSeverityName(int severity) {
+  switch (severity) {
+    case logging::LOG_INFO:
+      return "INFO";
+    case logging::LOG_WARNING:
+      return "WARNING";
+    case logging::LOG_ERROR:
+      return "ERROR";
+    case logging::LOG_FATAL:
+      return "FATAL";
+    default:
+      return severity < 0 ? "VERBOSE" : "UNKNOWN";
+  }
+}
+
+}  // namespace
+
+// static
+bool AsyncLogSink::Install(const std::string& format) {
+  Format sink_format;
+  if (format == "text")
+    sink_format = Format::kText;
+  else if (format == "json")
+    sink_format = Format::kJSON;
+  else
+    return false;
+
+  GetInstance()->Start(sink_format);
+  logging::SetLogMessageHandler(&AsyncLogSink::HandleMessage);
+  g_installed = true;
+  // exit() skips ProcessExiting(), for example when process.exit() is called.
+  atexit(&AsyncLogSink::Flush);
+  return true;
+}
+
+// static
+void AsyncLogSink::Flush() {
+  if (g_installed)
+    GetInstance()->Write();
+}
+
+// static
+AsyncLogSink* AsyncLogSink::GetInstance() {
+  static base::NoDestructor<AsyncLogSink> instance;
+  return instance.get();
+}
+
+// static
+bool AsyncLogSink::HandleMessage(int severity,
+                                 const char* file,
+                                 int line,
+                                 size_t message_start,
+                                 const std::string& str) {
+  // Let Chromium write fatal messages itself before crashing, after the ones
+  // still queued.
+  if (severity >= logging::LOG_FATAL) {
+    Flush();
+    return false;
+  }
+
+  Message message;
+  message.severity = severity;
+  message.file = file;
+  message.line = line;
+  message.time = base::Time::Now().ToJsTime();
+  message.thread_id = base::PlatformThread::CurrentId();
+  if (GetInstance()->format_ == Format::kText) {
+    message.text = str;
+  } else {
+    size_t length = str.size() - std::min(message_start, str.size());
+    if (length > 0 && str.back() == '\n')
+      --length;
+    message.text = str.substr(message_start, length);
+  }
+  GetInstance()->Append(std::move(message));
+  return true;
+}
+
+AsyncLogSink::AsyncLogSink()
+    : process_id_(base::GetCurrentProcId()), messages_queued_(&lock_) {}
+
+AsyncLogSink::~AsyncLogSink() = default;
+
+void AsyncLogSink::Start(Format format) {
+  format_ = format;
+  base::PlatformThread::CreateNonJoinable(0, this);
+}
+
+void AsyncLogSink::Append(Message message) {
+  base::AutoLock auto_lock(lock_);
+  if (messages_.size() >= kMaxQueuedMessages) {
+    ++dropped_count_;
+    return;
+  }
+  messages_.push_back(std::move(message));
+  if (messages_.size() == kBatchSize)
+    messages_queued_.Signal();
+}
+
+void AsyncLogSink::Write() {
+  base::AutoLock write_lock(write_lock_);
+  std::vector<Message> messages;
+  size_t dropped_count;
+  {
+    base::AutoLock auto_lock(lock_);
+    messages.swap(messages_);
+    dropped_count = dropped_count_;
+    dropped_count_ = 0;
+  }
+  if (messages.empty() && dropped_count == 0)
+    return;
+
+  std::string output;
+  for (const auto& message : messages)
+    output += FormatMessage(message);
+  if (dropped_count > 0) {
+    Message message = {logging::LOG_WARNING, __FILE__, __LINE__,
+                       base::Time::Now().ToJsTime(),
+                       base::PlatformThread::CurrentId(),
+                       base::StringPrintf("%zu log messages were dropped",
+                                          dropped_count)};
+    if (format_ == Format::kText)
+      message.text = "[" + base::NumberToString(process_id_) + "] " +
+                     message.text + "\n";
+    output += FormatMessage(message);
+  }
+
+  fwrite(output.data(), 1, output.size(), stderr);
+  fflush(stderr);
+}
+
+std::string AsyncLogSink::FormatMessage(const Message& message) const {
+  if (format_ == Format::kText)
+    return message.text;
+
+  std::string json = base::StringPrintf(
+      "{\"time\":%.3f,\"pid\":%s,\"tid\":%s,\"severity\":\"%s\",\"file\":",
+      message.time, base::NumberToString(process_id_).c_str(),
+      base::NumberToString(message.thread_id).c_str(),
+      GetSeverityName(message.severity));
+  base::EscapeJSONString(message.file ? message.file : "", true, &json);
+  json += ",\"line\":" + base::NumberToString(message.line) + ",\"message\":";
+  base::EscapeJSONString(message.text, true, &json);
+  json += "}\n";
+  return json;
+}
+
+void AsyncLogSink::ThreadMain() {
+  base::PlatformThread::SetName("LogWriter");
+  while (true) {
+    {
+      base::AutoLock auto_lock(lock_);
+      if (messages_.size() < kBatchSize)
+        messages_queued_.TimedWait(kFlushInterval);
+    }
+    Write();
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,90 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASYNC_LOG_SINK_H_
+#define SHELL_COMMON_ASYNC_LOG_SINK_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+// Writes the messages of Chromium logging to stderr from a background thread,
+// so that the threads that log only queue them.
+//
+// The messages are written in batches, either as the usual lines or as one
+// JSON object per line. Fatal messages are written right away, after the ones
+// still queued, and the queue is written when the process exits. The messages
+// of the last batch interval are lost when the process crashes or is killed,
+// as renderers are on fast shutdown.
+class AsyncLogSink : public base::PlatformThread::Delegate {
+ public:
+  enum class Format {
+    kText,
+    kJSON,
+  };
+
+  // Routes the messages of Chromium logging through the sink, |format| is
+  // "text" or "json". Returns false for other formats.
+  static bool Install(const std::string& format);
+
+  // Writes the queued messages in the calling thread, if the sink is
+  // installed.
+  static void Flush();
+
+ private:
+  friend class base::NoDestructor<AsyncLogSink>;
+
+  struct Message {
+    int severity;
+    const char* file;
+    int line;
+    double time;
+    base::PlatformThreadId thread_id;
+    std::string text;
+  };
+
+  AsyncLogSink();
+  ~AsyncLogSink() override;
+
+  static AsyncLogSink* GetInstance();
+
+  static bool HandleMessage(int severity,
+                            const char* file,
+                            int line,
+                            size_t message_start,
+                            const std::string& str);
+
+  void Start(Format format);
+  void Append(Message message);
+  void Write();
+  std::string FormatMessage(const Message& message) const;
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override;
+
+  Format format_ = Format::kText;
+  base::ProcessId process_id_;
+
+  base::Lock lock_;
+  base::ConditionVariable messages_queued_;
+  std::vector<Message> messages_;
+  size_t dropped_count_ = 0;
+
+  // Held while writing, so that a flush does not interleave with the writer.
+  base::Lock write_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncLogSink);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_ASYNC_LOG_SINK_H_
@@ -0,0 +1,166 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/cpu_profiler.h"
+
+#include <map>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "v8/include/v8-profiler.h"
+
+namespace {
+
+const char kProfileTitle[] = "electron";
+
+// Workers have isolates of their own on other threads.
+base::Lock& GetProfilersLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+std::map<v8::Isolate*, v8::CpuProfiler*>& GetProfilers() {
+  static base::NoDestructor<std::map<v8::Isolate*, v8::CpuProfiler*>>
+      profilers;
+  return *profilers;
+}
+
+// Removes the profiler of |isolate| from the map, or returns null.
+v8::CpuProfiler* TakeProfiler(v8::Isolate* isolate) {
+  base::AutoLock auto_lock(GetProfilersLock());
+  auto& profilers = GetProfilers();
+  auto it = profilers.find(isolate);
+  if (it == profilers.end())
+    return nullptr;
+  v8::CpuProfiler* profiler = it->second;
+  profilers.erase(it);
+  return profiler;
+}
+
+std::string ToString(v8::Isolate* isolate, v8::Local<v8::String> string) {
+  std::string result;
+  gin::ConvertFromV8(isolate, string, &result);
+  return result;
+}
+
+// DevTools lists the nodes flat, with the IDs of their children.
+void AppendNode(v8::Isolate* isolate,
+                const v8::CpuProfileNode* node,
+                base::Value* nodes) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetStringKey("functionName",
+                          ToString(isolate, node->GetFunctionName()));
+  call_frame.SetStringKey("scriptId", std::to_string(node->GetScriptId()));
+  call_frame.SetStringKey("url",
+                          ToString(isolate, node->GetScriptResourceName()));
+  // V8 counts lines and columns from 1, DevTools from 0.
+  call_frame.SetIntKey("lineNumber", node->GetLineNumber() - 1);
+  call_frame.SetIntKey("columnNumber", node->GetColumnNumber() - 1);
+
+  base::Value children(base::Value::Type::LIST);
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children.Append(static_cast<int>(node->GetChild(i)->GetNodeId()));
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetIntKey("id", node->GetNodeId());
+  value.SetKey("callFrame", std::move(call_frame));
+  value.SetIntKey("hitCount", node->GetHitCount());
+  value.SetKey("children", std::move(children));
+  nodes->Append(std::move(value));
+
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    AppendNode(isolate, node->GetChild(i), nodes);
+}
+
+std::string SerializeProfile(v8::Isolate* isolate,
+                             const v8::CpuProfile* profile) {
+  base::Value nodes(base::Value::Type::LIST);
+  AppendNode(isolate, profile->GetTopDownRoot(), &nodes);
+
+  base::Value samples(base::Value::Type::LIST);
+  base::Value time_deltas(base::Value::Type::LIST);
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(static_cast<int>(profile->GetSample(i)->GetNodeId()));
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<double>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("nodes", std::move(nodes));
+  result.SetDoubleKey("startTime",
+                      static_cast<double>(profile->GetStartTime()));
+  result.SetDoubleKey("endTime", static_cast<double>(profile->GetEndTime()));
+  result.SetKey("samples", std::move(samples));
+  result.SetKey("timeDeltas", std::move(time_deltas));
+
+  std::string json;
+  base::JSONWriter::Write(result, &json);
+  return json;
+}
+
+}  // namespace
+
+namespace electron {
+
+bool StartCPUProfiler(v8::Isolate* isolate,
+                      base::TimeDelta sampling_interval) {
+  DCHECK(isolate);
+  base::AutoLock auto_lock(GetProfilersLock());
+  auto& profilers = GetProfilers();
+  if (profilers.find(isolate) != profilers.end())
+    return false;
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(isolate);
+  profiler->SetSamplingInterval(
+      static_cast<int>(sampling_interval.InMicroseconds()));
+  if (profiler->StartProfiling(gin::StringToV8(isolate, kProfileTitle),
+                               true) != v8::CpuProfilingStatus::kStarted) {
+    profiler->Dispose();
+    return false;
+  }
+  profilers[isolate] = profiler;
+  return true;
+}
+
+std::string StopCPUProfiler(v8::Isolate* isolate) {
+  DCHECK(isolate);
+  v8::CpuProfiler* profiler = TakeProfiler(isolate);
+  if (!profiler)
+    return std::string();
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfile* profile =
+      profiler->StopProfiling(gin::StringToV8(isolate, kProfileTitle));
+  std::string json;
+  if (profile) {
+    json = SerializeProfile(isolate, profile);
+    profile->Delete();
+  }
+  profiler->Dispose();
+  return json;
+}
+
+void DisposeCPUProfiler(v8::Isolate* isolate) {
+  DCHECK(isolate);
+  v8::CpuProfiler* profiler = TakeProfiler(isolate);
+  if (!profiler)
+    return;
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfile* profile =
+      profiler->StopProfiling(gin::StringToV8(isolate, kProfileTitle));
+  if (profile)
+    profile->Delete();
+  profiler->Dispose();
+}
+
+}  // namespace electron
@@ -0,0 +1,37 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CPU_PROFILER_H_
+#define SHELL_COMMON_CPU_PROFILER_H_
+
+#include <string>
+
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// The default of DevTools.
+constexpr base::TimeDelta kDefaultCPUSamplingInterval =
+    base::TimeDelta::FromMicroseconds(1000);
+
+// Starts sampling the JavaScript stacks of |isolate| every
+// |sampling_interval|. Returns false when a profile is already being
+// recorded for |isolate|.
+bool StartCPUProfiler(v8::Isolate* isolate,
+                      base::TimeDelta sampling_interval);
+
+// Stops the profiler and returns the samples in the JSON format of the
+// .cpuprofile files of DevTools. Returns an empty string when the profiler was
+// not started.
+std::string StopCPUProfiler(v8::Isolate* isolate);
+
+// Stops the profiler of |isolate| without serializing its profile, if it was
+// started. Must be called before |isolate| is disposed, as the profilers are
+// keyed by isolate.
+void DisposeCPUProfiler(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_CPU_PROFILER_H_
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/crash_reporter/breadcrumbs.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+
+namespace crash_reporter {
+
+namespace {
+
+// Spaces rather than zeros, so that the annotation reads as text.
+struct Buffer {
+  Buffer() {
+    memset(data, ' ', sizeof(data));
+    for (size_t i = 0; i < kBreadcrumbCount; ++i)
+      data[(i + 1) * kBreadcrumbLength - 1] = '\n';
+  }
+
+  char data[kBreadcrumbsSize];
+};
+
+Buffer& GetBuffer() {
+  static Buffer buffer;
+  return buffer;
+}
+
+std::atomic<uint32_t> g_next_sequence{0};
+std::atomic<bool> g_enabled{true};
+
+}  // namespace
+
+void RecordBreadcrumb(base::StringPiece category, base::StringPiece detail) {
+  if (!g_enabled.load(std::memory_order_relaxed))
+    return;
+  uint32_t sequence = g_next_sequence.fetch_add(1, std::memory_order_relaxed);
+  char* line =
+      GetBuffer().data + (sequence % kBreadcrumbCount) * kBreadcrumbLength;
+
+  // Two threads only write the same line when a whole round of the buffer is
+  // recorded in between, which can garble that line but nothing else.
+  char text[kBreadcrumbLength];
+  int length = base::snprintf(
+      text, sizeof(text), "%u %.0f %.*s %.*s", sequence,
+      base::Time::Now().ToJsTime(), static_cast<int>(category.size()),
+      category.data(), static_cast<int>(detail.size()), detail.data());
+  size_t used = std::min(static_cast<size_t>(std::max(length, 0)),
+                         kBreadcrumbLength - 1);
+  memcpy(line, text, used);
+  memset(line + used, ' ', kBreadcrumbLength - 1 - used);
+}
+
+const char* GetBreadcrumbs() {
+  return GetBuffer().data;
+}
+
+void SetBreadcrumbsEnabled(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+  if (!enabled)
+    GetBuffer() = Buffer();
+}
+
+bool AreBreadcrumbsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+}  // namespace crash_reporter
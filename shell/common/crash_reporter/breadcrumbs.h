@@ -0,0 +1,40 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CRASH_REPORTER_BREADCRUMBS_H_
+#define SHELL_COMMON_CRASH_REPORTER_BREADCRUMBS_H_
+
+#include <stddef.h>
+
+#include "base/strings/string_piece.h"
+
+namespace crash_reporter {
+
+// The latest events of the process, like the IPC messages it handled, its
+// navigations and garbage collections, kept in a fixed buffer of text lines
+// that crash reports include as the "electron-breadcrumbs" annotation.
+//
+// Recording an event writes its line into the next slot of the buffer, the
+// oldest one once the buffer is full, without taking a lock or allocating.
+// Each line starts with a sequence number, so that the order of the events
+// can be restored from the buffer.
+constexpr size_t kBreadcrumbCount = 64;
+constexpr size_t kBreadcrumbLength = 64;
+constexpr size_t kBreadcrumbsSize = kBreadcrumbCount * kBreadcrumbLength;
+
+// |category| is a short word like "ipc", |detail| is truncated to fit.
+void RecordBreadcrumb(base::StringPiece category, base::StringPiece detail);
+
+// The kBreadcrumbsSize bytes of the buffer.
+const char* GetBreadcrumbs();
+
+// Breadcrumbs name IPC channels and origins, apps that don't want them in
+// their reports turn them off before starting the crash reporter. Nothing is
+// recorded afterwards and the buffer is cleared.
+void SetBreadcrumbsEnabled(bool enabled);
+bool AreBreadcrumbsEnabled();
+
+}  // namespace crash_reporter
+
+#endif  // SHELL_COMMON_CRASH_REPORTER_BREADCRUMBS_H_
@@ -8,10 +8,14 @@
 #include <memory>
 
 #include "base/files/file_util.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
+#include "third_party/crashpad/crashpad/client/annotation.h"
+#include "third_party/crashpad/crashpad/client/annotation_list.h"
 #include "third_party/crashpad/crashpad/client/settings.h"
 
 namespace crash_reporter {
@@ -44,6 +48,19 @@ void CrashReporterCrashpad::SetInitialCrashKeyValues() {
     SetCrashKeyValue(upload_parameter.first, upload_parameter.second);
 }
 
+void CrashReporterCrashpad::AttachBreadcrumbs() {
+  // Crashpad reads the annotation from the memory of the process when it
+  // crashes, so recording a breadcrumb does not have to tell it.
+  if (!AreBreadcrumbsEnabled())
+    return;
+  if (!crashpad::AnnotationList::Get())
+    crashpad::AnnotationList::Register();
+  static base::NoDestructor<crashpad::Annotation> annotation(
+      crashpad::Annotation::Type::kString, "electron-breadcrumbs",
+      const_cast<char*>(GetBreadcrumbs()));
+  annotation->SetSize(kBreadcrumbsSize);
+}
+
 void CrashReporterCrashpad::AddExtraParameter(const std::string& key,
                                               const std::string& value) {
   if (simple_string_dictionary_) {
@@ -34,6 +34,8 @@ class CrashReporterCrashpad : public CrashReporter {
   void SetUploadsEnabled(bool enable_uploads);
   void SetCrashKeyValue(base::StringPiece key, base::StringPiece value);
   void SetInitialCrashKeyValues();
+  // Includes the breadcrumbs of the process in its crash reports.
+  void AttachBreadcrumbs();
 
   std::vector<UploadReportResult> GetUploadedReports(
       const base::FilePath& crashes_dir) override;
@@ -85,6 +85,16 @@ bool CrashReporterLinux::GetUploadToServer() {
   return upload_to_server_;
 }
 
+void CrashReporterLinux::WriteDumpWithoutCrashing(const std::string& key,
+                                                  const std::string& value) {
+  if (!breakpad_ || !crash_keys_)
+    return;
+  // The value is cut to the size of a crash key.
+  crash_keys_->SetKeyValue(key.c_str(), value.c_str());
+  breakpad_->WriteMinidump();
+  crash_keys_->RemoveKey(key.c_str());
+}
+
 void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
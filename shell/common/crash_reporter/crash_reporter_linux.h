@@ -38,6 +38,12 @@ class CrashReporterLinux : public CrashReporter {
   void SetUploadParameters() override;
   bool GetUploadToServer() override;
 
+  // Writes and uploads a minidump of the process, which keeps running, with
+  // the |key| parameter set to |value|. Does nothing when the crash reporter
+  // was not started.
+  void WriteDumpWithoutCrashing(const std::string& key,
+                                const std::string& value);
+
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterLinux>;
 
@@ -61,6 +61,7 @@ void CrashReporterMac::Init(const std::string& product_name,
   crashpad_info->set_simple_annotations(simple_string_dictionary_.get());
 
   SetInitialCrashKeyValues();
+  AttachBreadcrumbs();
   if (process_type_.empty()) {  // browser process
     database_ = crashpad::CrashReportDatabase::Initialize(crashes_dir);
     SetUploadToServer(upload_to_server);
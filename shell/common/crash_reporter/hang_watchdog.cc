@@ -0,0 +1,182 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/crash_reporter/hang_watchdog.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop_current.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
+#include "gin/converter.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
+#include "v8/include/v8.h"
+
+#if defined(OS_LINUX)
+#include "shell/common/crash_reporter/crash_reporter_linux.h"
+#else
+#include "third_party/crashpad/crashpad/client/annotation.h"
+#include "third_party/crashpad/crashpad/client/annotation_list.h"
+#include "third_party/crashpad/crashpad/client/simulate_crash.h"
+#endif
+
+namespace crash_reporter {
+
+namespace {
+
+HangWatchdog* g_watchdog = nullptr;
+
+// How long the hung thread has to reach a JavaScript interrupt check, it never
+// does when it is blocked in native code.
+constexpr base::TimeDelta kStackCaptureTimeout =
+    base::TimeDelta::FromSeconds(1);
+
+constexpr int kMaxStackFrames = 32;
+
+const char kJavaScriptStackKey[] = "electron-hang-js-stack";
+
+#if !defined(OS_LINUX)
+crashpad::StringAnnotation<4096>& GetJavaScriptStackAnnotation() {
+  static base::NoDestructor<crashpad::StringAnnotation<4096>> annotation(
+      kJavaScriptStackKey);
+  return *annotation;
+}
+#endif
+
+std::string ToString(v8::Isolate* isolate, v8::Local<v8::String> string) {
+  std::string result;
+  if (!string.IsEmpty())
+    gin::ConvertFromV8(isolate, string, &result);
+  return result;
+}
+
+int64_t Now() {
+  return base::TimeTicks::Now().since_origin().InMicroseconds();
+}
+
+}  // namespace
+
+// static
+void HangWatchdog::Start(v8::Isolate* isolate, base::TimeDelta timeout) {
+  if (g_watchdog)
+    return;
+#if !defined(OS_LINUX)
+  if (!crashpad::AnnotationList::Get())
+    crashpad::AnnotationList::Register();
+#endif
+  // Lives as long as the process, the watched thread may outlive any owner.
+  g_watchdog = new HangWatchdog(isolate, timeout);
+}
+
+HangWatchdog::HangWatchdog(v8::Isolate* isolate, base::TimeDelta timeout)
+    : isolate_(isolate),
+      timeout_(timeout),
+      stack_captured_(base::WaitableEvent::ResetPolicy::AUTOMATIC),
+      thread_("ElectronHangWatchdog") {
+  base::MessageLoopCurrent::Get()->AddTaskObserver(this);
+  thread_.Start();
+  thread_.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&HangWatchdog::Check, base::Unretained(this)));
+}
+
+HangWatchdog::~HangWatchdog() = default;
+
+HangWatchdog::ScopedWork::ScopedWork() {
+  if (g_watchdog &&
+      g_watchdog->task_start_.load(std::memory_order_relaxed) == 0) {
+    g_watchdog->task_start_.store(Now(), std::memory_order_relaxed);
+    started_ = true;
+  }
+}
+
+HangWatchdog::ScopedWork::~ScopedWork() {
+  if (started_)
+    g_watchdog->task_start_.store(0, std::memory_order_relaxed);
+}
+
+void HangWatchdog::WillProcessTask(const base::PendingTask& pending_task,
+                                   bool was_blocked_or_low_priority) {
+  task_start_.store(Now(), std::memory_order_relaxed);
+}
+
+void HangWatchdog::DidProcessTask(const base::PendingTask& pending_task) {
+  // A task of a nested loop also ends the wait of the task that runs the
+  // loop, a modal dialog is not a hang.
+  task_start_.store(0, std::memory_order_relaxed);
+}
+
+void HangWatchdog::Check() {
+  int64_t task_start = task_start_.load(std::memory_order_relaxed);
+  if (task_start != 0 && task_start != reported_task_start_) {
+    base::TimeDelta duration =
+        base::TimeDelta::FromMicroseconds(Now() - task_start);
+    if (duration >= timeout_) {
+      reported_task_start_ = task_start;
+      ReportHang(duration);
+    }
+  }
+  // Checking a few times per timeout bounds how late a hang is reported.
+  thread_.task_runner()->PostDelayedTask(
+      FROM_HERE, base::BindOnce(&HangWatchdog::Check, base::Unretained(this)),
+      std::max(timeout_ / 4, base::TimeDelta::FromMilliseconds(100)));
+}
+
+void HangWatchdog::ReportHang(base::TimeDelta duration) {
+  RecordBreadcrumb("hang", base::StringPrintf("%" PRId64 "ms",
+                                              duration.InMilliseconds()));
+  js_stack_.clear();
+  capture_requested_.store(true);
+  isolate_->RequestInterrupt(&HangWatchdog::CaptureJavaScriptStack, this);
+  if (!stack_captured_.TimedWait(kStackCaptureTimeout) &&
+      !capture_requested_.exchange(false)) {
+    // The interrupt started capturing in the meantime.
+    stack_captured_.Wait();
+  }
+  WriteHangReport(js_stack_);
+}
+
+// static
+void HangWatchdog::WriteHangReport(const std::string& js_stack) {
+  // The minidump has the stacks of all the threads of the process, and is
+  // uploaded like the ones of crashes.
+#if defined(OS_LINUX)
+  CrashReporterLinux::GetInstance()->WriteDumpWithoutCrashing(
+      kJavaScriptStackKey, js_stack);
+#else
+  GetJavaScriptStackAnnotation().Set(js_stack);
+  CRASHPAD_SIMULATE_CRASH();
+  // Later crashes are not hangs.
+  GetJavaScriptStackAnnotation().Clear();
+#endif
+}
+
+// static
+void HangWatchdog::CaptureJavaScriptStack(v8::Isolate* isolate, void* data) {
+  auto* self = static_cast<HangWatchdog*>(data);
+  if (!self->capture_requested_.exchange(false))
+    return;
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack_trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < stack_trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = stack_trace->GetFrame(isolate, i);
+    std::string function_name = ToString(isolate, frame->GetFunctionName());
+    std::string script_name = ToString(isolate, frame->GetScriptName());
+    base::StringAppendF(&stack, "%s (%s:%d:%d)\n",
+                        function_name.empty() ? "<anonymous>"
+                                              : function_name.c_str(),
+                        script_name.c_str(), frame->GetLineNumber(),
+                        frame->GetColumn());
+  }
+  self->js_stack_ = std::move(stack);
+  self->stack_captured_.Signal();
+}
+
+}  // namespace crash_reporter
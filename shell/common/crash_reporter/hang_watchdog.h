@@ -0,0 +1,95 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CRASH_REPORTER_HANG_WATCHDOG_H_
+#define SHELL_COMMON_CRASH_REPORTER_HANG_WATCHDOG_H_
+
+#include <atomic>
+#include <string>
+
+#include "base/macros.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/task_observer.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace crash_reporter {
+
+// Writes a crash report, without crashing, when a task of the thread it
+// watches runs for longer than a timeout. The report has the stacks of all the
+// threads, and the JavaScript stack of the hung thread when it is running
+// JavaScript, in the "electron-hang-js-stack" annotation. Each hang is only
+// reported once. On Linux the JavaScript stack is cut to the 255 bytes of a
+// breakpad crash key.
+//
+// Only the tasks, and the work wrapped in a ScopedWork, are timed, so an idle
+// thread or one whose message loop has quit is not taken for a hung one.
+class HangWatchdog : public base::TaskObserver {
+ public:
+  // Times work of the watched thread that runs outside of its tasks, like the
+  // libuv callbacks that the GLib message pump dispatches on Linux. Does
+  // nothing when no watchdog was started, or within a task, which is already
+  // timed. Must not be used on other threads.
+  class ScopedWork {
+   public:
+    ScopedWork();
+    ~ScopedWork();
+
+   private:
+    bool started_ = false;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedWork);
+  };
+
+  // Watches the current thread, which runs |isolate|. Does nothing when a
+  // watchdog was already started.
+  static void Start(v8::Isolate* isolate, base::TimeDelta timeout);
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  HangWatchdog(v8::Isolate* isolate, base::TimeDelta timeout);
+  ~HangWatchdog() override;
+
+  // Run on |thread_|.
+  void Check();
+  void ReportHang(base::TimeDelta duration);
+
+  // Run on the watched thread, from a V8 interrupt.
+  static void CaptureJavaScriptStack(v8::Isolate* isolate, void* data);
+
+  // Writes the report with the crash reporter of the platform.
+  static void WriteHangReport(const std::string& js_stack);
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta timeout_;
+
+  // The start of the task or ScopedWork in progress in microseconds since the
+  // origin of base::TimeTicks, 0 when the thread is between them.
+  std::atomic<int64_t> task_start_{0};
+
+  // The start of the last task that was reported, only used on |thread_|.
+  int64_t reported_task_start_ = 0;
+
+  // Set while ReportHang() waits for the stack. An interrupt that runs later
+  // finds it unset, so its stack can't end up in another report.
+  std::atomic<bool> capture_requested_{false};
+  // Written by the interrupt before it signals |stack_captured_|.
+  std::string js_stack_;
+  base::WaitableEvent stack_captured_;
+  base::Thread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(HangWatchdog);
+};
+
+}  // namespace crash_reporter
+
+#endif  // SHELL_COMMON_CRASH_REPORTER_HANG_WATCHDOG_H_
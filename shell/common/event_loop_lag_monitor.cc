@@ -0,0 +1,245 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/event_loop_lag_monitor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "gin/converter.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kMaxStackFrames = 20;
+
+std::string ToString(v8::Isolate* isolate, v8::Local<v8::String> string) {
+  std::string result;
+  if (string.IsEmpty() || !gin::ConvertFromV8(isolate, string, &result))
+    return std::string();
+  return result;
+}
+
+// Formats the stack like Error.prototype.stack, without the message.
+std::string CurrentStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, i);
+    std::string function_name = ToString(isolate, frame->GetFunctionName());
+    base::StringAppendF(
+        &stack, "    at %s (%s:%d:%d)\n",
+        function_name.empty() ? "<anonymous>" : function_name.c_str(),
+        ToString(isolate, frame->GetScriptName()).c_str(),
+        frame->GetLineNumber(), frame->GetColumn());
+  }
+  return stack;
+}
+
+}  // namespace
+
+// Watches the probes of the main thread from another thread, and interrupts
+// V8 to capture the stack of the main thread once a probe is overdue.
+class EventLoopLagMonitor::Watchdog
+    : public base::RefCountedThreadSafe<Watchdog> {
+ public:
+  Watchdog(v8::Isolate* isolate, base::TimeDelta threshold)
+      : isolate_(isolate), threshold_(threshold) {}
+
+  // Main thread, |due| is null when no probe is pending.
+  void SetProbeDue(base::TimeTicks due) {
+    interrupt_requested_ = false;
+    probe_due_us_ = due.is_null() ? 0 : due.since_origin().InMicroseconds();
+  }
+
+  // Main thread.
+  std::string TakeStack() {
+    base::AutoLock auto_lock(lock_);
+    return std::move(stack_);
+  }
+
+  // Watchdog thread, checks the probes until the thread is stopped.
+  static void Run(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+                  scoped_refptr<Watchdog> watchdog) {
+    watchdog->Check();
+    base::TimeDelta interval = std::max(watchdog->threshold_ / 4,
+                                        base::TimeDelta::FromMilliseconds(1));
+    task_runner->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(&Watchdog::Run, task_runner, std::move(watchdog)),
+        interval);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Watchdog>;
+  ~Watchdog() = default;
+
+  void Check() {
+    int64_t due_us = probe_due_us_;
+    if (!due_us || interrupt_requested_)
+      return;
+    base::TimeTicks due =
+        base::TimeTicks() + base::TimeDelta::FromMicroseconds(due_us);
+    if (base::TimeTicks::Now() - due < threshold_)
+      return;
+    interrupt_requested_ = true;
+    // Released by the interrupt.
+    AddRef();
+    isolate_->RequestInterrupt(&Watchdog::OnInterrupt, this);
+  }
+
+  // Main thread, the next time V8 checks for interrupts.
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    auto* self = static_cast<Watchdog*>(data);
+    // The main thread may only run JavaScript again once it is no longer
+    // blocked, in which case the stack is not the one that blocked it.
+    if (self->interrupt_requested_ && self->probe_due_us_) {
+      std::string stack = CurrentStack(isolate);
+      base::AutoLock auto_lock(self->lock_);
+      self->stack_ = std::move(stack);
+    }
+    self->Release();
+  }
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta threshold_;
+  std::atomic<int64_t> probe_due_us_{0};
+  std::atomic<bool> interrupt_requested_{false};
+
+  base::Lock lock_;
+  std::string stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(Watchdog);
+};
+
+EventLoopLagMonitor::Histogram::Histogram() = default;
+
+EventLoopLagMonitor::Histogram::~Histogram() = default;
+
+void EventLoopLagMonitor::Histogram::Add(base::TimeDelta sample) {
+  size_t bucket = 0;
+  int64_t ms = sample.InMilliseconds();
+  while (bucket < kBucketCount - 1 && ms >= (int64_t{1} << bucket))
+    ++bucket;
+  ++buckets_[bucket];
+  ++count_;
+  total_ += sample;
+  max_ = std::max(max_, sample);
+}
+
+base::Value EventLoopLagMonitor::Histogram::ToValue() const {
+  base::Value buckets(base::Value::Type::LIST);
+  for (double count : buckets_)
+    buckets.Append(count);
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetDoubleKey("count", count_);
+  result.SetDoubleKey("mean",
+                      count_ ? total_.InMillisecondsF() / count_ : 0);
+  result.SetDoubleKey("max", max_.InMillisecondsF());
+  result.SetKey("buckets", std::move(buckets));
+  return result;
+}
+
+EventLoopLagMonitor::EventLoopLagMonitor(
+    v8::Isolate* isolate,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner)
+    : isolate_(isolate), task_runner_(std::move(task_runner)) {}
+
+EventLoopLagMonitor::~EventLoopLagMonitor() {
+  Stop();
+}
+
+void EventLoopLagMonitor::Start(const Options& options,
+                                const BlockedCallback& callback) {
+  Stop();
+  options_ = options;
+  callback_ = callback;
+  running_ = true;
+
+  if (options_.capture_stack) {
+    watchdog_ = base::MakeRefCounted<Watchdog>(isolate_, options_.threshold);
+    watchdog_thread_ = std::make_unique<base::Thread>("ElectronLagWatchdog");
+    watchdog_thread_->Start();
+    watchdog_thread_->task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&Watchdog::Run,
+                                  watchdog_thread_->task_runner(), watchdog_));
+  }
+
+  ScheduleProbe();
+}
+
+void EventLoopLagMonitor::Stop() {
+  if (!running_)
+    return;
+  running_ = false;
+  ++generation_;
+  callback_.Reset();
+  // Joins the thread, the watchdog no longer interrupts V8 after it.
+  watchdog_thread_.reset();
+  watchdog_ = nullptr;
+}
+
+void EventLoopLagMonitor::RecordUvRun(base::TimeDelta elapsed) {
+  if (!running_)
+    return;
+  uv_loop_.Add(elapsed);
+  if (elapsed >= options_.threshold)
+    last_long_uv_run_ = base::TimeTicks::Now();
+}
+
+base::Value EventLoopLagMonitor::GetHistograms() const {
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("taskQueueing", task_queueing_.ToValue());
+  result.SetKey("uvLoop", uv_loop_.ToValue());
+  return result;
+}
+
+void EventLoopLagMonitor::ScheduleProbe() {
+  base::TimeTicks due = base::TimeTicks::Now() + options_.sample_interval;
+  if (watchdog_)
+    watchdog_->SetProbeDue(due);
+  // The monitor is owned by the NodeBindings of the main thread, which
+  // outlive its tasks.
+  task_runner_->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&EventLoopLagMonitor::OnProbe, base::Unretained(this),
+                     generation_, due),
+      options_.sample_interval);
+}
+
+void EventLoopLagMonitor::OnProbe(uint64_t generation, base::TimeTicks due) {
+  if (generation != generation_)
+    return;
+
+  base::TimeDelta delay =
+      std::max(base::TimeTicks::Now() - due, base::TimeDelta());
+  if (watchdog_)
+    watchdog_->SetProbeDue(base::TimeTicks());
+  task_queueing_.Add(delay);
+  base::UmaHistogramTimes("Electron.MainThread.TaskQueueingDelay", delay);
+
+  if (delay >= options_.threshold) {
+    Source source =
+        last_long_uv_run_ >= due ? Source::kUvLoop : Source::kTaskQueue;
+    std::string stack = watchdog_ ? watchdog_->TakeStack() : std::string();
+    // The callback can stop or restart the monitor.
+    callback_.Run(source, delay, stack);
+    if (generation != generation_)
+      return;
+  }
+
+  ScheduleProbe();
+}
+
+}  // namespace electron
@@ -0,0 +1,116 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_EVENT_LOOP_LAG_MONITOR_H_
+#define SHELL_COMMON_EVENT_LOOP_LAG_MONITOR_H_
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "v8/include/v8.h"
+
+namespace base {
+class Thread;
+}
+
+namespace electron {
+
+// Measures how long the main thread is blocked, both as the delay of the
+// tasks posted to it and as the time each run of the libuv loop takes.
+//
+// While started, a probe task is posted every |sample_interval| and the
+// delay with which it runs is recorded. A delay past |threshold| is reported,
+// optionally with the JavaScript stack of the main thread at the time it was
+// blocked, which is captured by interrupting V8 from a watchdog thread.
+class EventLoopLagMonitor {
+ public:
+  enum class Source {
+    // The main thread was busy with Chromium tasks.
+    kTaskQueue,
+    // The main thread was busy running the libuv loop, that is JavaScript.
+    kUvLoop,
+  };
+
+  struct Options {
+    base::TimeDelta threshold = base::TimeDelta::FromMilliseconds(100);
+    base::TimeDelta sample_interval = base::TimeDelta::FromMilliseconds(50);
+    bool capture_stack = false;
+  };
+
+  using BlockedCallback = base::RepeatingCallback<
+      void(Source source, base::TimeDelta duration, const std::string& stack)>;
+
+  EventLoopLagMonitor(v8::Isolate* isolate,
+                      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+  ~EventLoopLagMonitor();
+
+  // Starts sampling with |options|, or restarts it with new ones. The
+  // histograms are kept.
+  void Start(const Options& options, const BlockedCallback& callback);
+  void Stop();
+  bool running() const { return running_; }
+
+  // Called after each run of the libuv loop.
+  void RecordUvRun(base::TimeDelta elapsed);
+
+  // {taskQueueing, uvLoop}, the histograms of the samples recorded while the
+  // monitor was running.
+  base::Value GetHistograms() const;
+
+ private:
+  class Watchdog;
+
+  class Histogram {
+   public:
+    Histogram();
+    ~Histogram();
+
+    void Add(base::TimeDelta sample);
+    base::Value ToValue() const;
+
+   private:
+    // Bucket i counts the samples shorter than 2^i ms, the last one the
+    // longer ones.
+    static constexpr size_t kBucketCount = 14;
+    std::array<double, kBucketCount> buckets_ = {};
+    double count_ = 0;
+    base::TimeDelta total_;
+    base::TimeDelta max_;
+  };
+
+  void ScheduleProbe();
+  void OnProbe(uint64_t generation, base::TimeTicks due);
+
+  v8::Isolate* isolate_;
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+
+  Options options_;
+  BlockedCallback callback_;
+  bool running_ = false;
+  // Incremented by Start() and Stop(), so that the probes of a previous run
+  // are dropped.
+  uint64_t generation_ = 0;
+
+  Histogram task_queueing_;
+  Histogram uv_loop_;
+  // When the last run of the libuv loop longer than the threshold ended.
+  base::TimeTicks last_long_uv_run_;
+
+  // Only when capturing stacks.
+  scoped_refptr<Watchdog> watchdog_;
+  std::unique_ptr<base::Thread> watchdog_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventLoopLagMonitor);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_EVENT_LOOP_LAG_MONITOR_H_
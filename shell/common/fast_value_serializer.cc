@@ -0,0 +1,699 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/fast_value_serializer.h"
+
+#include <string.h>
+
+#include <limits>
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+// The blink and V8 wire formats both start with 0xFF.
+const uint8_t kFastVersionTag = 0xFE;
+
+// Nesting deeper than this is left to the full serializer, and rejected when
+// decoding so a malicious sender can not exhaust the stack.
+const int kMaxDepth = 100;
+
+// Arrays longer than this may be sparse, they are left to the full
+// serializer rather than being written element by element.
+const uint32_t kMaxArrayLength = 1 << 16;
+
+enum Tag : uint8_t {
+  kUndefined = '_',
+  kNull = '0',
+  kTrue = 'T',
+  kFalse = 'F',
+  kInt32 = 'I',
+  kDouble = 'N',
+  kOneByteString = '"',
+  kTwoByteString = 'c',
+  // Followed by the property count, then the keys and values.
+  kObject = 'o',
+  // Followed by the length, the elements, then the count of named properties
+  // and their keys and values.
+  kArray = 'a',
+  kHole = '-',
+  kArrayBuffer = 'B',
+  // Followed by the view type, byte offset, byte length and the buffer.
+  kArrayBufferView = 'V',
+  // Followed by the ID of an object written before, IDs are assigned in the
+  // order the objects are written.
+  kReference = '^',
+};
+
+enum ViewTag : uint8_t {
+  kInt8Array = 'b',
+  kUint8Array = 'B',
+  kUint8ClampedArray = 'C',
+  kInt16Array = 'w',
+  kUint16Array = 'W',
+  kInt32Array = 'd',
+  kUint32Array = 'D',
+  kFloat32Array = 'f',
+  kFloat64Array = 'F',
+  kBigInt64Array = 'q',
+  kBigUint64Array = 'Q',
+  kDataView = '?',
+};
+
+bool IsPlainObject(v8::Local<v8::Object> object,
+                   v8::Local<v8::Value> object_prototype) {
+  // Checked first as reading the prototype of a Proxy runs a trap.
+  if (object->IsProxy() || object->IsFunction() ||
+      object->InternalFieldCount() > 0)
+    return false;
+  v8::Local<v8::Value> prototype = object->GetPrototype();
+  if (!prototype->StrictEquals(object_prototype) && !prototype->IsNull())
+    return false;
+  // Objects that keep their internal state when their prototype is replaced.
+  return !object->IsArgumentsObject() && !object->IsModuleNamespaceObject() &&
+         !object->IsDate() && !object->IsRegExp() && !object->IsMap() &&
+         !object->IsSet() && !object->IsNativeError() &&
+         !object->IsBooleanObject() && !object->IsNumberObject() &&
+         !object->IsStringObject() && !object->IsBigIntObject() &&
+         !object->IsSymbolObject();
+}
+
+bool GetViewTag(v8::Local<v8::ArrayBufferView> view, uint8_t* tag) {
+  if (view->IsInt8Array())
+    *tag = kInt8Array;
+  else if (view->IsUint8Array())
+    *tag = kUint8Array;
+  else if (view->IsUint8ClampedArray())
+    *tag = kUint8ClampedArray;
+  else if (view->IsInt16Array())
+    *tag = kInt16Array;
+  else if (view->IsUint16Array())
+    *tag = kUint16Array;
+  else if (view->IsInt32Array())
+    *tag = kInt32Array;
+  else if (view->IsUint32Array())
+    *tag = kUint32Array;
+  else if (view->IsFloat32Array())
+    *tag = kFloat32Array;
+  else if (view->IsFloat64Array())
+    *tag = kFloat64Array;
+  else if (view->IsBigInt64Array())
+    *tag = kBigInt64Array;
+  else if (view->IsBigUint64Array())
+    *tag = kBigUint64Array;
+  else if (view->IsDataView())
+    *tag = kDataView;
+  else
+    return false;
+  return true;
+}
+
+size_t GetElementSize(uint8_t tag) {
+  switch (tag) {
+    case kInt8Array:
+    case kUint8Array:
+    case kUint8ClampedArray:
+    case kDataView:
+      return 1;
+    case kInt16Array:
+    case kUint16Array:
+      return 2;
+    case kInt32Array:
+    case kUint32Array:
+    case kFloat32Array:
+      return 4;
+    case kFloat64Array:
+    case kBigInt64Array:
+    case kBigUint64Array:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+class FastSerializer {
+ public:
+  FastSerializer(v8::Isolate* isolate,
+                 std::vector<uint8_t>* out,
+                 size_t max_array_buffer_size)
+      : isolate_(isolate),
+        context_(isolate->GetCurrentContext()),
+        object_prototype_(v8::Object::New(isolate)->GetPrototype()),
+        out_(out),
+        max_array_buffer_size_(max_array_buffer_size) {}
+
+  FastSerializeResult Serialize(v8::Local<v8::Value> value) {
+    out_->clear();
+    out_->push_back(kFastVersionTag);
+    return WriteValue(value, 0);
+  }
+
+ private:
+  FastSerializeResult WriteValue(v8::Local<v8::Value> value, int depth) {
+    if (value->IsUndefined()) {
+      WriteTag(kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(kNull);
+    } else if (value->IsTrue()) {
+      WriteTag(kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(kFalse);
+    } else if (value->IsInt32()) {
+      WriteTag(kInt32);
+      int32_t i = value.As<v8::Int32>()->Value();
+      // Zigzag encoding keeps small negative numbers short.
+      WriteVarint((static_cast<uint32_t>(i) << 1) ^
+                  static_cast<uint32_t>(i >> 31));
+    } else if (value->IsNumber()) {
+      WriteTag(kDouble);
+      double d = value.As<v8::Number>()->Value();
+      WriteBytes(&d, sizeof(d));
+    } else if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsObject()) {
+      if (depth >= kMaxDepth)
+        return FastSerializeResult::kUnsupported;
+      v8::Local<v8::Object> object = value.As<v8::Object>();
+      if (WriteReference(object))
+        return FastSerializeResult::kSerialized;
+      if (object->IsArray())
+        return WriteArray(object.As<v8::Array>(), depth);
+      if (object->IsArrayBuffer())
+        return WriteArrayBuffer(object.As<v8::ArrayBuffer>());
+      if (object->IsArrayBufferView())
+        return WriteArrayBufferView(object.As<v8::ArrayBufferView>());
+      if (IsPlainObject(object, object_prototype_))
+        return WriteObject(object, depth);
+      return FastSerializeResult::kUnsupported;
+    } else {
+      // Symbols and BigInts.
+      return FastSerializeResult::kUnsupported;
+    }
+    return FastSerializeResult::kSerialized;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    int length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(kOneByteString);
+      WriteVarint(length);
+      size_t offset = out_->size();
+      out_->resize(offset + length);
+      string->WriteOneByte(isolate_, out_->data() + offset, 0, length,
+                           v8::String::NO_NULL_TERMINATION);
+    } else {
+      WriteTag(kTwoByteString);
+      WriteVarint(length * sizeof(uint16_t));
+      std::vector<uint16_t> buffer(length);
+      string->Write(isolate_, buffer.data(), 0, length,
+                    v8::String::NO_NULL_TERMINATION);
+      WriteBytes(buffer.data(), length * sizeof(uint16_t));
+    }
+  }
+
+  // Reads an own property of |object| without running any script. Accessors
+  // make the value unsupported before their getter is called, so the full
+  // serializer is the only one to call it.
+  FastSerializeResult GetDataProperty(v8::Local<v8::Object> object,
+                                      v8::Local<v8::String> key,
+                                      v8::Local<v8::Value>* out) {
+    bool is_accessor;
+    if (!object->HasRealNamedCallbackProperty(context_, key).To(&is_accessor))
+      return FastSerializeResult::kFailed;
+    if (is_accessor)
+      return FastSerializeResult::kUnsupported;
+    if (!object->Get(context_, key).ToLocal(out))
+      return FastSerializeResult::kFailed;
+    return FastSerializeResult::kSerialized;
+  }
+
+  // Properties are read the same way v8::ValueSerializer reads them: own
+  // enumerable string keys, in order.
+  FastSerializeResult WriteProperties(v8::Local<v8::Object> object,
+                                      v8::Local<v8::Array> keys,
+                                      int depth) {
+    WriteVarint(keys->Length());
+    for (uint32_t i = 0; i < keys->Length(); ++i) {
+      v8::Local<v8::Value> key;
+      if (!keys->Get(context_, i).ToLocal(&key))
+        return FastSerializeResult::kFailed;
+      v8::Local<v8::Value> property;
+      FastSerializeResult result =
+          GetDataProperty(object, key.As<v8::String>(), &property);
+      if (result != FastSerializeResult::kSerialized)
+        return result;
+      WriteString(key.As<v8::String>());
+      result = WriteValue(property, depth + 1);
+      if (result != FastSerializeResult::kSerialized)
+        return result;
+    }
+    return FastSerializeResult::kSerialized;
+  }
+
+  FastSerializeResult WriteObject(v8::Local<v8::Object> object, int depth) {
+    v8::Local<v8::Array> keys;
+    if (!object
+             ->GetOwnPropertyNames(
+                 context_,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys))
+      return FastSerializeResult::kFailed;
+    WriteTag(kObject);
+    return WriteProperties(object, keys, depth);
+  }
+
+  FastSerializeResult WriteArray(v8::Local<v8::Array> array, int depth) {
+    uint32_t length = array->Length();
+    if (length > kMaxArrayLength)
+      return FastSerializeResult::kUnsupported;
+    WriteTag(kArray);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      // Holes are not looked up on the prototype chain, which could run
+      // getters; the full serializer only writes own elements of such arrays.
+      bool has_element;
+      if (!array->HasRealIndexedProperty(context_, i).To(&has_element))
+        return FastSerializeResult::kFailed;
+      if (!has_element) {
+        WriteTag(kHole);
+        continue;
+      }
+      v8::Local<v8::String> index;
+      v8::Local<v8::Value> element;
+      if (!v8::Integer::NewFromUnsigned(isolate_, i)
+               ->ToString(context_)
+               .ToLocal(&index))
+        return FastSerializeResult::kFailed;
+      FastSerializeResult result = GetDataProperty(array, index, &element);
+      if (result != FastSerializeResult::kSerialized)
+        return result;
+      result = WriteValue(element, depth + 1);
+      if (result != FastSerializeResult::kSerialized)
+        return result;
+    }
+    v8::Local<v8::Array> keys;
+    if (!array
+             ->GetPropertyNames(
+                 context_, v8::KeyCollectionMode::kOwnOnly,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::IndexFilter::kSkipIndices,
+                 v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys))
+      return FastSerializeResult::kFailed;
+    return WriteProperties(array, keys, depth);
+  }
+
+  FastSerializeResult WriteArrayBuffer(v8::Local<v8::ArrayBuffer> buffer) {
+    // Detached buffers, which make the full serializer throw, can not be told
+    // apart from empty ones.
+    if (buffer->ByteLength() == 0 ||
+        buffer->ByteLength() >= max_array_buffer_size_)
+      return FastSerializeResult::kUnsupported;
+    auto backing_store = buffer->GetBackingStore();
+    WriteTag(kArrayBuffer);
+    WriteVarint(backing_store->ByteLength());
+    WriteBytes(backing_store->Data(), backing_store->ByteLength());
+    return FastSerializeResult::kSerialized;
+  }
+
+  FastSerializeResult WriteArrayBufferView(
+      v8::Local<v8::ArrayBufferView> view) {
+    uint8_t view_tag;
+    if (!GetViewTag(view, &view_tag))
+      return FastSerializeResult::kUnsupported;
+    v8::Local<v8::ArrayBuffer> buffer = view->Buffer();
+    // Views of a SharedArrayBuffer make the full serializer throw, which would
+    // be lost by copying them.
+    if (buffer.IsEmpty() || buffer->IsSharedArrayBuffer())
+      return FastSerializeResult::kUnsupported;
+    WriteTag(kArrayBufferView);
+    WriteTag(view_tag);
+    WriteVarint(view->ByteOffset());
+    WriteVarint(view->ByteLength());
+    if (WriteReference(buffer))
+      return FastSerializeResult::kSerialized;
+    return WriteArrayBuffer(buffer);
+  }
+
+  // Writes a reference if |object| was written before, otherwise assigns it
+  // the next ID.
+  bool WriteReference(v8::Local<v8::Object> object) {
+    auto range = ids_.equal_range(object->GetIdentityHash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (objects_[it->second] == object) {
+        WriteTag(kReference);
+        WriteVarint(it->second);
+        return true;
+      }
+    }
+    ids_.emplace(object->GetIdentityHash(), objects_.size());
+    objects_.push_back(object);
+    return false;
+  }
+
+  void WriteTag(uint8_t tag) { out_->push_back(tag); }
+
+  void WriteVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      if (value)
+        byte |= 0x80;
+      out_->push_back(byte);
+    } while (value);
+  }
+
+  void WriteBytes(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out_->insert(out_->end(), bytes, bytes + length);
+  }
+
+  v8::Isolate* isolate_;
+  v8::Local<v8::Context> context_;
+  v8::Local<v8::Value> object_prototype_;
+  std::vector<uint8_t>* out_;
+  size_t max_array_buffer_size_;
+  std::unordered_multimap<int, uint32_t> ids_;
+  std::vector<v8::Local<v8::Object>> objects_;
+
+  DISALLOW_COPY_AND_ASSIGN(FastSerializer);
+};
+
+class FastDeserializer {
+ public:
+  FastDeserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
+      : isolate_(isolate),
+        context_(isolate->GetCurrentContext()),
+        position_(data.data()),
+        end_(data.data() + data.size()) {}
+
+  v8::Local<v8::Value> Deserialize() {
+    uint8_t tag;
+    v8::Local<v8::Value> value;
+    if (!ReadByte(&tag) || tag != kFastVersionTag || !ReadValue(0, &value) ||
+        position_ != end_)
+      return v8::Local<v8::Value>();
+    return value;
+  }
+
+ private:
+  bool ReadValue(int depth, v8::Local<v8::Value>* out) {
+    if (depth > kMaxDepth)
+      return false;
+    uint8_t tag;
+    if (!ReadByte(&tag))
+      return false;
+    switch (tag) {
+      case kUndefined:
+        *out = v8::Undefined(isolate_);
+        return true;
+      case kNull:
+        *out = v8::Null(isolate_);
+        return true;
+      case kTrue:
+        *out = v8::True(isolate_);
+        return true;
+      case kFalse:
+        *out = v8::False(isolate_);
+        return true;
+      case kInt32: {
+        uint64_t zigzag;
+        if (!ReadVarint(&zigzag) ||
+            zigzag > std::numeric_limits<uint32_t>::max())
+          return false;
+        uint32_t u = static_cast<uint32_t>(zigzag);
+        *out = v8::Integer::New(isolate_,
+                                static_cast<int32_t>((u >> 1) ^ -(u & 1)));
+        return true;
+      }
+      case kDouble: {
+        double d;
+        if (!ReadBytes(&d, sizeof(d)))
+          return false;
+        *out = v8::Number::New(isolate_, d);
+        return true;
+      }
+      case kOneByteString:
+      case kTwoByteString: {
+        v8::Local<v8::String> string;
+        if (!ReadString(tag, &string))
+          return false;
+        *out = string;
+        return true;
+      }
+      case kObject:
+        return ReadObject(depth, out);
+      case kArray:
+        return ReadArray(depth, out);
+      case kArrayBuffer:
+        return ReadArrayBuffer(out);
+      case kArrayBufferView:
+        return ReadArrayBufferView(out);
+      case kReference: {
+        uint64_t id;
+        if (!ReadVarint(&id) || id >= objects_.size() || objects_[id].IsEmpty())
+          return false;
+        *out = objects_[id];
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool ReadString(uint8_t tag, v8::Local<v8::String>* out) {
+    uint64_t length;
+    if (!ReadVarint(&length) || length > Remaining() ||
+        length > static_cast<uint64_t>(v8::String::kMaxLength))
+      return false;
+    const uint8_t* data = position_;
+    position_ += length;
+    if (tag == kOneByteString) {
+      return v8::String::NewFromOneByte(isolate_, data,
+                                        v8::NewStringType::kNormal, length)
+          .ToLocal(out);
+    }
+    if (tag != kTwoByteString || length % sizeof(uint16_t))
+      return false;
+    // The data may not be aligned for uint16_t.
+    std::vector<uint16_t> buffer(length / sizeof(uint16_t));
+    memcpy(buffer.data(), data, length);
+    return v8::String::NewFromTwoByte(isolate_, buffer.data(),
+                                      v8::NewStringType::kNormal, buffer.size())
+        .ToLocal(out);
+  }
+
+  bool ReadProperties(v8::Local<v8::Object> object, int depth) {
+    uint64_t count;
+    if (!ReadVarint(&count) || count > Remaining())
+      return false;
+    for (uint64_t i = 0; i < count; ++i) {
+      uint8_t tag;
+      v8::Local<v8::String> key;
+      v8::Local<v8::Value> value;
+      bool created;
+      if (!ReadByte(&tag) || !ReadString(tag, &key) ||
+          !ReadValue(depth + 1, &value) ||
+          !object->CreateDataProperty(context_, key, value).To(&created))
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadObject(int depth, v8::Local<v8::Value>* out) {
+    v8::Local<v8::Object> object = v8::Object::New(isolate_);
+    objects_.push_back(object);
+    if (!ReadProperties(object, depth))
+      return false;
+    *out = object;
+    return true;
+  }
+
+  bool ReadArray(int depth, v8::Local<v8::Value>* out) {
+    uint64_t length;
+    // Every element takes at least a byte.
+    if (!ReadVarint(&length) || length > kMaxArrayLength ||
+        length > Remaining())
+      return false;
+    v8::Local<v8::Array> array = v8::Array::New(isolate_, length);
+    objects_.push_back(array);
+    for (uint32_t i = 0; i < length; ++i) {
+      if (position_ < end_ && *position_ == kHole) {
+        position_++;
+        continue;
+      }
+      v8::Local<v8::Value> element;
+      bool created;
+      if (!ReadValue(depth + 1, &element) ||
+          !array->CreateDataProperty(context_, i, element).To(&created))
+        return false;
+    }
+    if (!ReadProperties(array, depth))
+      return false;
+    *out = array;
+    return true;
+  }
+
+  bool ReadArrayBuffer(v8::Local<v8::Value>* out) {
+    uint64_t length;
+    if (!ReadVarint(&length) || length > Remaining())
+      return false;
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate_, length);
+    if (length)
+      memcpy(buffer->GetBackingStore()->Data(), position_, length);
+    position_ += length;
+    objects_.push_back(buffer);
+    *out = buffer;
+    return true;
+  }
+
+  bool ReadArrayBufferView(v8::Local<v8::Value>* out) {
+    // The view gets its ID before its buffer, like it does when writing.
+    size_t id = objects_.size();
+    objects_.emplace_back();
+    uint8_t view_tag;
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint8_t buffer_tag;
+    v8::Local<v8::Value> buffer_value;
+    if (!ReadByte(&view_tag) || !ReadVarint(&byte_offset) ||
+        !ReadVarint(&byte_length) || !ReadByte(&buffer_tag))
+      return false;
+    if (buffer_tag == kArrayBuffer) {
+      if (!ReadArrayBuffer(&buffer_value))
+        return false;
+    } else if (buffer_tag == kReference) {
+      position_--;
+      if (!ReadValue(0, &buffer_value))
+        return false;
+    } else {
+      return false;
+    }
+    if (!buffer_value->IsArrayBuffer())
+      return false;
+    v8::Local<v8::ArrayBuffer> buffer = buffer_value.As<v8::ArrayBuffer>();
+    size_t element_size = GetElementSize(view_tag);
+    if (!element_size || byte_offset > buffer->ByteLength() ||
+        byte_length > buffer->ByteLength() - byte_offset ||
+        byte_offset % element_size || byte_length % element_size)
+      return false;
+    size_t length = byte_length / element_size;
+    v8::Local<v8::ArrayBufferView> view;
+    switch (view_tag) {
+      case kInt8Array:
+        view = v8::Int8Array::New(buffer, byte_offset, length);
+        break;
+      case kUint8Array:
+        view = v8::Uint8Array::New(buffer, byte_offset, length);
+        break;
+      case kUint8ClampedArray:
+        view = v8::Uint8ClampedArray::New(buffer, byte_offset, length);
+        break;
+      case kInt16Array:
+        view = v8::Int16Array::New(buffer, byte_offset, length);
+        break;
+      case kUint16Array:
+        view = v8::Uint16Array::New(buffer, byte_offset, length);
+        break;
+      case kInt32Array:
+        view = v8::Int32Array::New(buffer, byte_offset, length);
+        break;
+      case kUint32Array:
+        view = v8::Uint32Array::New(buffer, byte_offset, length);
+        break;
+      case kFloat32Array:
+        view = v8::Float32Array::New(buffer, byte_offset, length);
+        break;
+      case kFloat64Array:
+        view = v8::Float64Array::New(buffer, byte_offset, length);
+        break;
+      case kBigInt64Array:
+        view = v8::BigInt64Array::New(buffer, byte_offset, length);
+        break;
+      case kBigUint64Array:
+        view = v8::BigUint64Array::New(buffer, byte_offset, length);
+        break;
+      case kDataView:
+        view = v8::DataView::New(buffer, byte_offset, length);
+        break;
+      default:
+        return false;
+    }
+    objects_[id] = view;
+    *out = view;
+    return true;
+  }
+
+  size_t Remaining() const { return end_ - position_; }
+
+  bool ReadByte(uint8_t* out) {
+    if (position_ >= end_)
+      return false;
+    *out = *position_++;
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* out) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        *out = value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadBytes(void* out, size_t length) {
+    if (length > Remaining())
+      return false;
+    memcpy(out, position_, length);
+    position_ += length;
+    return true;
+  }
+
+  v8::Isolate* isolate_;
+  v8::Local<v8::Context> context_;
+  const uint8_t* position_;
+  const uint8_t* end_;
+  // Objects by ID, a view's slot is empty until its buffer has been read.
+  std::vector<v8::Local<v8::Value>> objects_;
+
+  DISALLOW_COPY_AND_ASSIGN(FastDeserializer);
+};
+
+}  // namespace
+
+FastSerializeResult FastSerializeV8Value(v8::Isolate* isolate,
+                                         v8::Local<v8::Value> value,
+                                         std::vector<uint8_t>* out,
+                                         size_t max_array_buffer_size) {
+  return FastSerializer(isolate, out, max_array_buffer_size).Serialize(value);
+}
+
+bool IsFastSerializedValue(base::span<const uint8_t> data) {
+  return !data.empty() && data[0] == kFastVersionTag;
+}
+
+v8::Local<v8::Value> FastDeserializeV8Value(v8::Isolate* isolate,
+                                            base::span<const uint8_t> data) {
+  v8::EscapableHandleScope scope(isolate);
+  v8::Local<v8::Value> value = FastDeserializer(isolate, data).Deserialize();
+  if (value.IsEmpty())
+    return v8::Local<v8::Value>();
+  return scope.Escape(value);
+}
+
+}  // namespace electron
@@ -0,0 +1,57 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_FAST_VALUE_SERIALIZER_H_
+#define SHELL_COMMON_FAST_VALUE_SERIALIZER_H_
+
+#include <limits>
+#include <vector>
+
+#include "base/containers/span.h"
+
+namespace v8 {
+class Isolate;
+template <class T>
+class Local;
+class Value;
+}  // namespace v8
+
+namespace electron {
+
+// A compact encoding for the values most IPC messages carry: primitives,
+// plain objects, arrays, ArrayBuffers and their views. Writing it is much
+// cheaper than going through v8::ValueSerializer and the blink envelope, and
+// the decoded value is the same a structured clone would produce, including
+// shared references, cycles and array holes.
+//
+// Encoded values start with a tag the blink wire format never starts with,
+// so DeserializeV8Value() can tell the two apart.
+enum class FastSerializeResult {
+  kSerialized,
+  // |value| holds something the encoding does not cover, it should be
+  // serialized with the full serializer instead. Properties with getters are
+  // among them, the fast path never runs script, so nothing has run twice.
+  kUnsupported,
+  // Reading |value| threw, the exception is left pending.
+  kFailed,
+};
+
+// ArrayBuffers of |max_array_buffer_size| bytes or more, wherever they are in
+// |value|, make it unsupported, so the full serializer can move them to
+// shared memory instead of copying them into the message.
+FastSerializeResult FastSerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    std::vector<uint8_t>* out,
+    size_t max_array_buffer_size = std::numeric_limits<size_t>::max());
+
+bool IsFastSerializedValue(base::span<const uint8_t> data);
+
+// Returns an empty handle if |data| is malformed.
+v8::Local<v8::Value> FastDeserializeV8Value(v8::Isolate* isolate,
+                                            base::span<const uint8_t> data);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_FAST_VALUE_SERIALIZER_H_
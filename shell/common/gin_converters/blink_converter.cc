@@ -494,4 +494,17 @@ bool Converter<blink::CloneableMessage>::FromV8(v8::Isolate* isolate,
   return electron::SerializeV8Value(isolate, val, out);
 }
 
+v8::Local<v8::Value> Converter<electron::SerializedValue>::ToV8(
+    v8::Isolate* isolate,
+    const electron::SerializedValue& in) {
+  return electron::DeserializeV8Value(isolate, in);
+}
+
+bool Converter<electron::SerializedValue>::FromV8(
+    v8::Isolate* isolate,
+    v8::Handle<v8::Value> val,
+    electron::SerializedValue* out) {
+  return electron::SerializeV8Value(isolate, val, out);
+}
+
 }  // namespace gin
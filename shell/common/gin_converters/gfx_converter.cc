@@ -4,6 +4,11 @@
 
 #include "shell/common/gin_converters/gfx_converter.h"
 
+#include <initializer_list>
+
+#include "base/strings/string_piece.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/wrapper_info.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
@@ -14,13 +19,58 @@
 
 namespace gin {
 
+namespace {
+
+WrapperInfo kPointTemplate = {kEmbedderNativeGin};
+WrapperInfo kSizeTemplate = {kEmbedderNativeGin};
+WrapperInfo kRectTemplate = {kEmbedderNativeGin};
+
+// Points, sizes and rects are converted for every bounds event, so instead of
+// adding the properties and the "simple" mark to an empty object one by one,
+// they are instantiated from a template kept in each isolate that already has
+// them, and only their values are set.
+v8::Local<v8::Object> CreateObject(
+    v8::Isolate* isolate,
+    WrapperInfo* key,
+    std::initializer_list<base::StringPiece> names) {
+  PerIsolateData* data = PerIsolateData::From(isolate);
+  v8::Local<v8::ObjectTemplate> templ;
+  if (data)
+    templ = data->GetObjectTemplate(key);
+  if (templ.IsEmpty()) {
+    templ = v8::ObjectTemplate::New(isolate);
+    templ->SetPrivate(
+        v8::Private::ForApi(isolate, StringToV8(isolate, "simple")),
+        v8::True(isolate));
+    for (base::StringPiece name : names)
+      templ->Set(StringToSymbol(isolate, name), v8::Integer::New(isolate, 0));
+    if (data)
+      data->SetObjectTemplate(key, templ);
+  }
+  return templ->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+}
+
+template <typename T>
+void SetProperty(v8::Isolate* isolate,
+                 v8::Local<v8::Object> object,
+                 base::StringPiece name,
+                 T value) {
+  object
+      ->CreateDataProperty(isolate->GetCurrentContext(),
+                           StringToSymbol(isolate, name),
+                           ConvertToV8(isolate, value))
+      .Check();
+}
+
+}  // namespace
+
 v8::Local<v8::Value> Converter<gfx::Point>::ToV8(v8::Isolate* isolate,
                                                  const gfx::Point& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.SetHidden("simple", true);
-  dict.Set("x", val.x());
-  dict.Set("y", val.y());
-  return dict.GetHandle();
+  v8::Local<v8::Object> object =
+      CreateObject(isolate, &kPointTemplate, {"x", "y"});
+  SetProperty(isolate, object, "x", val.x());
+  SetProperty(isolate, object, "y", val.y());
+  return object;
 }
 
 bool Converter<gfx::Point>::FromV8(v8::Isolate* isolate,
@@ -39,11 +89,11 @@ bool Converter<gfx::Point>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::PointF>::ToV8(v8::Isolate* isolate,
                                                   const gfx::PointF& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.SetHidden("simple", true);
-  dict.Set("x", val.x());
-  dict.Set("y", val.y());
-  return dict.GetHandle();
+  v8::Local<v8::Object> object =
+      CreateObject(isolate, &kPointTemplate, {"x", "y"});
+  SetProperty(isolate, object, "x", val.x());
+  SetProperty(isolate, object, "y", val.y());
+  return object;
 }
 
 bool Converter<gfx::PointF>::FromV8(v8::Isolate* isolate,
@@ -61,11 +111,11 @@ bool Converter<gfx::PointF>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::Size>::ToV8(v8::Isolate* isolate,
                                                 const gfx::Size& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.SetHidden("simple", true);
-  dict.Set("width", val.width());
-  dict.Set("height", val.height());
-  return dict.GetHandle();
+  v8::Local<v8::Object> object =
+      CreateObject(isolate, &kSizeTemplate, {"width", "height"});
+  SetProperty(isolate, object, "width", val.width());
+  SetProperty(isolate, object, "height", val.height());
+  return object;
 }
 
 bool Converter<gfx::Size>::FromV8(v8::Isolate* isolate,
@@ -83,13 +133,13 @@ bool Converter<gfx::Size>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::Rect>::ToV8(v8::Isolate* isolate,
                                                 const gfx::Rect& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.SetHidden("simple", true);
-  dict.Set("x", val.x());
-  dict.Set("y", val.y());
-  dict.Set("width", val.width());
-  dict.Set("height", val.height());
-  return dict.GetHandle();
+  v8::Local<v8::Object> object = CreateObject(
+      isolate, &kRectTemplate, {"x", "y", "width", "height"});
+  SetProperty(isolate, object, "x", val.x());
+  SetProperty(isolate, object, "y", val.y());
+  SetProperty(isolate, object, "width", val.width());
+  SetProperty(isolate, object, "height", val.height());
+  return object;
 }
 
 bool Converter<gfx::Rect>::FromV8(v8::Isolate* isolate,
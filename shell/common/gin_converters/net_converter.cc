@@ -4,6 +4,7 @@
 
 #include "shell/common/gin_converters/net_converter.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -152,20 +153,25 @@ v8::Local<v8::Value> Converter<net::CertPrincipal>::ToV8(
 v8::Local<v8::Value> Converter<net::HttpResponseHeaders*>::ToV8(
     v8::Isolate* isolate,
     net::HttpResponseHeaders* headers) {
-  base::DictionaryValue response_headers;
+  // Headers are converted for every request seen by the webRequest API, so
+  // the object is built directly rather than through a base::DictionaryValue.
+  std::map<std::string, std::vector<std::string>> response_headers;
   if (headers) {
     size_t iter = 0;
     std::string key;
     std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      key = base::ToLowerASCII(key);
-      base::Value* values = response_headers.FindListKey(key);
-      if (!values)
-        values = response_headers.SetKey(key, base::ListValue());
-      values->Append(value);
-    }
+    while (headers->EnumerateHeaderLines(&iter, &key, &value))
+      response_headers[base::ToLowerASCII(key)].push_back(value);
+  }
+  auto context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> object = v8::Object::New(isolate);
+  for (const auto& it : response_headers) {
+    object
+        ->CreateDataProperty(context, StringToV8(isolate, it.first),
+                             ConvertToV8(isolate, it.second))
+        .Check();
   }
-  return ConvertToV8(isolate, response_headers);
+  return object;
 }
 
 bool Converter<net::HttpResponseHeaders*>::FromV8(
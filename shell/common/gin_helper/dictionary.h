@@ -88,7 +88,7 @@ class Dictionary : public gin::Dictionary {
   template <typename T>
   bool SetMethod(base::StringPiece key, const T& callback) {
     auto context = isolate()->GetCurrentContext();
-    auto templ = CallbackTraits<T>::CreateTemplate(isolate(), callback);
+    auto templ = GetFunctionTemplate(isolate(), callback);
     return GetHandle()
         ->Set(context, gin::StringToV8(isolate(), key),
               templ->GetFunction(context).ToLocalChecked())
@@ -5,9 +5,12 @@
 #ifndef SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_H_
 #define SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_H_
 
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "content/public/browser/browser_thread.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
@@ -49,11 +52,33 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     return Base::GetWrapper(isolate);
   }
 
+  // Whether JavaScript listens to |name|. Only the events whose listeners are
+  // counted by SetListenerCount() can be known to have none, the others are
+  // assumed to be listened to.
+  bool HasListeners(base::StringPiece name) const {
+    for (const auto& it : listener_counts_) {
+      if (base::StringPiece(it.first) == name)
+        return it.second > 0;
+    }
+    return true;
+  }
+
+  // Called by JavaScript as the listeners of |name| are added and removed, a
+  // negative |count| stops counting them.
+  void SetListenerCount(const std::string& name, int count) {
+    if (count < 0)
+      listener_counts_.erase(name);
+    else
+      listener_counts_[name] = count;
+  }
+
   // this.emit(name, event, args...);
   template <typename... Args>
   bool EmitCustomEvent(base::StringPiece name,
                        v8::Local<v8::Object> event,
                        Args&&... args) {
+    if (!HasListeners(name))
+      return false;
     return EmitWithEvent(name,
                          internal::CreateEvent(isolate(), GetWrapper(), event),
                          std::forward<Args>(args)...);
@@ -62,6 +87,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, new Event(flags), args...);
   template <typename... Args>
   bool EmitWithFlags(base::StringPiece name, int flags, Args&&... args) {
+    if (!HasListeners(name))
+      return false;
     v8::Locker locker(isolate());
     v8::HandleScope handle_scope(isolate());
     return EmitCustomEvent(name,
@@ -72,6 +99,9 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, new Event(), args...);
   template <typename... Args>
   bool Emit(base::StringPiece name, Args&&... args) {
+    // Nothing to convert nor call when nobody listens.
+    if (!HasListeners(name))
+      return false;
     v8::Locker locker(isolate());
     v8::HandleScope handle_scope(isolate());
     v8::Local<v8::Object> wrapper = GetWrapper();
@@ -121,6 +151,9 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     return false;
   }
 
+  // Event name => number of listeners in JavaScript.
+  base::flat_map<std::string, int> listener_counts_;
+
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
 };
 
@@ -4,6 +4,9 @@
 
 #include "shell/common/gin_helper/event_emitter_caller.h"
 
+#include <string>
+
+#include "base/trace_event/trace_event.h"
 #include "shell/common/gin_helper/locker.h"
 #include "shell/common/node_includes.h"
 
@@ -15,6 +18,12 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
                                         v8::Local<v8::Object> obj,
                                         const char* method,
                                         ValueVector* args) {
+  // The event name is only read when tracing is on.
+  TRACE_EVENT2("electron", "gin_helper::CallMethodWithArgs", "method", method,
+               "event",
+               args->empty() || !args->front()->IsString()
+                   ? std::string()
+                   : gin::V8ToString(isolate, args->front()));
   // Perform microtask checkpoint after running JavaScript.
   v8::MicrotasksScope script_scope(isolate,
                                    v8::MicrotasksScope::kRunMicrotasks);
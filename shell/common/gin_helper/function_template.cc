@@ -4,6 +4,12 @@
 
 #include "shell/common/gin_helper/function_template.h"
 
+#include <map>
+#include <memory>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+
 namespace gin_helper {
 
 CallbackHolderBase::CallbackHolderBase(v8::Isolate* isolate)
@@ -33,4 +39,18 @@ void CallbackHolderBase::SecondWeakCallback(
   delete data.GetParameter();
 }
 
+gin::WrapperInfo* GetFunctionTemplateKey(const void* function) {
+  // The keys are shared by the isolates of all the threads, while the
+  // templates are owned by each isolate and go away with it.
+  static base::NoDestructor<base::Lock> lock;
+  static base::NoDestructor<
+      std::map<const void*, std::unique_ptr<gin::WrapperInfo>>>
+      keys;
+  base::AutoLock auto_lock(*lock);
+  auto& key = (*keys)[function];
+  if (!key)
+    key.reset(new gin::WrapperInfo{gin::kEmbedderNativeGin});
+  return key.get();
+}
+
 }  // namespace gin_helper
@@ -11,6 +11,8 @@
 #include "base/callback.h"
 #include "base/optional.h"
 #include "gin/arguments.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/wrapper_info.h"
 #include "shell/common/gin_helper/arguments.h"
 #include "shell/common/gin_helper/destroyable.h"
 #include "shell/common/gin_helper/error_thrower.h"
@@ -325,6 +327,42 @@ struct CallbackTraits<
   }
 };
 
+// Returns the key under which the template of the plain function |function| is
+// kept in the gin::PerIsolateData of each isolate.
+gin::WrapperInfo* GetFunctionTemplateKey(const void* function);
+
+// GetFunctionTemplate returns a template for |callback| that can be used in
+// any context of |isolate|.
+//
+// Plain functions hold no state, so their template is created once per isolate
+// and shared by all the contexts, instead of once per context for the modules
+// that are initialized in each of them. Other callbacks get a new template.
+template <typename T>
+v8::Local<v8::FunctionTemplate> GetFunctionTemplate(v8::Isolate* isolate,
+                                                    const T& callback) {
+  return CallbackTraits<T>::CreateTemplate(isolate, callback);
+}
+
+template <typename ReturnType, typename... ArgTypes>
+v8::Local<v8::FunctionTemplate> GetFunctionTemplate(
+    v8::Isolate* isolate,
+    ReturnType (*callback)(ArgTypes...)) {
+  using T = ReturnType (*)(ArgTypes...);
+  // Isolates created by Node.js for its workers have no gin data.
+  gin::PerIsolateData* data = gin::PerIsolateData::From(isolate);
+  if (!data)
+    return CallbackTraits<T>::CreateTemplate(isolate, callback);
+
+  gin::WrapperInfo* key =
+      GetFunctionTemplateKey(reinterpret_cast<const void*>(callback));
+  v8::Local<v8::FunctionTemplate> templ = data->GetFunctionTemplate(key);
+  if (templ.IsEmpty()) {
+    templ = CallbackTraits<T>::CreateTemplate(isolate, callback);
+    data->SetFunctionTemplate(key, templ);
+  }
+  return templ;
+}
+
 }  // namespace gin_helper
 
 #endif  // SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
@@ -5,12 +5,11 @@
 #ifndef SHELL_COMMON_GIN_HELPER_TRACKABLE_OBJECT_H_
 #define SHELL_COMMON_GIN_HELPER_TRACKABLE_OBJECT_H_
 
-#include <vector>
-
 #include "base/bind.h"
 #include "base/memory/weak_ptr.h"
+#include "gin/converter.h"
 #include "shell/common/gin_helper/event_emitter.h"
-#include "shell/common/key_weak_map.h"
+#include "shell/common/id_weak_map.h"
 
 namespace base {
 class SupportsUserData;
@@ -95,44 +94,44 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
   }
 
   // Returns all objects in this class's weak map.
-  static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+  static v8::Local<v8::Array> GetAll(v8::Isolate* isolate) {
+    auto* weak_map = GetWeakMap();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> objects = v8::Array::New(isolate, weak_map->size());
+    uint32_t index = 0;
+    weak_map->ForEach(isolate, [&](v8::Local<v8::Object> object) {
+      objects->Set(context, index++, object).Check();
+    });
+    return objects;
   }
 
   // Removes this instance from the weak map.
-  void RemoveFromWeakMap() {
-    if (weak_map_ && weak_map_->Has(weak_map_id()))
-      weak_map_->Remove(weak_map_id());
-  }
+  void RemoveFromWeakMap() { GetWeakMap()->Remove(weak_map_id()); }
 
  protected:
-  TrackableObject() { weak_map_id_ = ++next_id_; }
+  TrackableObject() { weak_map_id_ = GetWeakMap()->Add(); }
 
   ~TrackableObject() override { RemoveFromWeakMap(); }
 
   void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
     gin_helper::WrappableBase::InitWith(isolate, wrapper);
-    if (!weak_map_) {
-      weak_map_ = new electron::KeyWeakMap<int32_t>;
-    }
-    weak_map_->Set(isolate, weak_map_id_, wrapper);
+    GetWeakMap()->Set(isolate, weak_map_id_, wrapper);
   }
 
  private:
-  static int32_t next_id_;
-  static electron::KeyWeakMap<int32_t>* weak_map_;  // leaked on purpose
+  static electron::IDWeakMap* GetWeakMap() {
+    if (!weak_map_)
+      weak_map_ = new electron::IDWeakMap;
+    return weak_map_;
+  }
+
+  static electron::IDWeakMap* weak_map_;  // leaked on purpose
 
   DISALLOW_COPY_AND_ASSIGN(TrackableObject);
 };
 
 template <typename T>
-int32_t TrackableObject<T>::next_id_ = 0;
-
-template <typename T>
-electron::KeyWeakMap<int32_t>* TrackableObject<T>::weak_map_ = nullptr;
+electron::IDWeakMap* TrackableObject<T>::weak_map_ = nullptr;
 
 }  // namespace gin_helper
 
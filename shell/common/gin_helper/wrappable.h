@@ -6,6 +6,7 @@
 #define SHELL_COMMON_GIN_HELPER_WRAPPABLE_H_
 
 #include "base/bind.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/per_isolate_data.h"
 #include "shell/common/gin_helper/constructor.h"
 
@@ -25,6 +26,7 @@ class Wrappable : public WrappableBase {
   template <typename Sig>
   static void SetConstructor(v8::Isolate* isolate,
                              const base::Callback<Sig>& constructor) {
+    TRACE_EVENT0("electron", "gin_helper::Wrappable::SetConstructor");
     v8::Local<v8::FunctionTemplate> templ = CreateFunctionTemplate(
         isolate, base::Bind(&internal::InvokeNew<Sig>, constructor));
     templ->InstanceTemplate()->SetInternalFieldCount(1);
@@ -38,6 +40,8 @@ class Wrappable : public WrappableBase {
     auto* data = gin::PerIsolateData::From(isolate);
     auto templ = data->GetFunctionTemplate(&kWrapperInfo);
     if (templ.IsEmpty()) {
+      // Traced to show what building the prototypes costs at startup.
+      TRACE_EVENT0("electron", "gin_helper::Wrappable::BuildPrototype");
       templ = v8::FunctionTemplate::New(isolate);
       templ->InstanceTemplate()->SetInternalFieldCount(1);
       T::BuildPrototype(isolate, templ);
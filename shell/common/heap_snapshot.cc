@@ -4,6 +4,12 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "gin/converter.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
@@ -30,18 +36,75 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+class HeapSnapshotProgress : public v8::ActivityControl {
+ public:
+  explicit HeapSnapshotProgress(
+      const electron::HeapSnapshotProgressCallback& callback)
+      : callback_(callback) {}
+
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(uint32_t done, uint32_t total) override {
+    callback_.Run(done, total);
+    return kContinue;
+  }
+
+ private:
+  electron::HeapSnapshotProgressCallback callback_;
+};
+
+std::string ToString(v8::Isolate* isolate, v8::Local<v8::String> string) {
+  std::string result;
+  gin::ConvertFromV8(isolate, string, &result);
+  return result;
+}
+
+base::Value AllocationNodeToValue(v8::Isolate* isolate,
+                                  const v8::AllocationProfile::Node* node) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetStringKey("functionName", ToString(isolate, node->name));
+  call_frame.SetStringKey("scriptId", std::to_string(node->script_id));
+  call_frame.SetStringKey("url", ToString(isolate, node->script_name));
+  // V8 counts lines and columns from 1, DevTools from 0.
+  call_frame.SetIntKey("lineNumber", node->line_number - 1);
+  call_frame.SetIntKey("columnNumber", node->column_number - 1);
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value children(base::Value::Type::LIST);
+  for (const auto* child : node->children)
+    children.Append(AllocationNodeToValue(isolate, child));
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("callFrame", std::move(call_frame));
+  result.SetDoubleKey("selfSize", self_size);
+  result.SetIntKey("id", node->node_id);
+  result.SetKey("children", std::move(children));
+  return result;
+}
+
 }  // namespace
 
 namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
+  return TakeHeapSnapshot(isolate, file, HeapSnapshotProgressCallback());
+}
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotProgressCallback& progress) {
   DCHECK(isolate);
   DCHECK(file);
 
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  std::unique_ptr<HeapSnapshotProgress> control;
+  if (progress)
+    control = std::make_unique<HeapSnapshotProgress>(progress);
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(control.get());
   if (!snapshot)
     return false;
 
@@ -53,4 +116,41 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth) {
+  DCHECK(isolate);
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                               stack_depth);
+}
+
+std::string StopSamplingHeapProfiler(v8::Isolate* isolate) {
+  DCHECK(isolate);
+  v8::HandleScope handle_scope(isolate);
+  auto* heap_profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  heap_profiler->StopSamplingHeapProfiler();
+  if (!profile)
+    return std::string();
+
+  base::Value samples(base::Value::Type::LIST);
+  for (const auto& sample : profile->GetSamples()) {
+    base::Value value(base::Value::Type::DICTIONARY);
+    value.SetDoubleKey("size",
+                       static_cast<double>(sample.size) * sample.count);
+    value.SetIntKey("nodeId", sample.node_id);
+    value.SetDoubleKey("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(value));
+  }
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("head", AllocationNodeToValue(isolate, profile->GetRootNode()));
+  result.SetKey("samples", std::move(samples));
+
+  std::string json;
+  base::JSONWriter::Write(result, &json);
+  return json;
+}
+
 }  // namespace electron
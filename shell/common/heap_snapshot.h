@@ -5,12 +5,40 @@
 #ifndef SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <string>
+
+#include "base/callback.h"
 #include "base/files/file.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
+// Called with the number of objects processed so far and their total while
+// a snapshot is taken.
+using HeapSnapshotProgressCallback =
+    base::RepeatingCallback<void(uint32_t done, uint32_t total)>;
+
+// Writes a snapshot of the heap of |isolate| to |file|, in chunks as it is
+// serialized.
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotProgressCallback& progress);
+
+// The defaults of V8.
+constexpr uint64_t kDefaultHeapSamplingInterval = 512 * 1024;
+constexpr int kDefaultHeapSamplingStackDepth = 16;
+
+// The sampling heap profiler records the stack of an allocation every
+// |sample_interval| bytes on average, which is cheap enough to leave on.
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth);
+
+// Stops the profiler and returns the allocations still alive, in the JSON
+// format of the .heapprofile files of DevTools. Returns an empty string when
+// the profiler was not started.
+std::string StopSamplingHeapProfiler(v8::Isolate* isolate);
 
 }  // namespace electron
 
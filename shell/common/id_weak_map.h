@@ -0,0 +1,145 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ID_WEAK_MAP_H_
+#define SHELL_COMMON_ID_WEAK_MAP_H_
+
+#include <deque>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Like KeyWeakMap, but it picks the keys of its objects. A key is the index of
+// a slot in a dense array plus a generation of the slot, which is bumped each
+// time the slot is freed, so that the key of a removed object is not given to
+// another one. Lookups are an index, and iterating does not allocate.
+//
+// The first generation of the slots counts from 1 like a sequence, the later
+// ones have higher bits set. Keys are always positive.
+class IDWeakMap {
+ public:
+  IDWeakMap() = default;
+  ~IDWeakMap() {
+    for (auto& slot : slots_)
+      slot.object.ClearWeak();
+  }
+
+  // Reserves a key for an object added later with Set().
+  int32_t Add() {
+    size_t index;
+    if (free_slots_.empty()) {
+      index = slots_.size();
+      CHECK_LT(index, kMaxSlots);
+      slots_.emplace_back();
+      slots_.back().self = this;
+    } else {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    Slot& slot = slots_[index];
+    slot.used = true;
+    slot.id = static_cast<int32_t>((slot.generation << kSlotBits) | index) + 1;
+    return slot.id;
+  }
+
+  // Sets the object of |id|, which must have been given by Add().
+  void Set(v8::Isolate* isolate, int32_t id, v8::Local<v8::Object> object) {
+    Slot* slot = Find(id);
+    DCHECK(slot);
+    if (!slot)
+      return;
+    if (slot->object.IsEmpty())
+      ++object_count_;
+    slot->object.Reset(isolate, object);
+    slot->object.SetWeak(slot, OnObjectGC, v8::WeakCallbackType::kParameter);
+  }
+
+  // Gets the object of |id|, empty when it was removed or is not set yet.
+  v8::MaybeLocal<v8::Object> Get(v8::Isolate* isolate, int32_t id) const {
+    const Slot* slot = Find(id);
+    if (!slot || slot->object.IsEmpty())
+      return v8::MaybeLocal<v8::Object>();
+    return v8::Local<v8::Object>::New(isolate, slot->object);
+  }
+
+  bool Has(int32_t id) const {
+    return Find(id) != nullptr;
+  }
+
+  // Calls |callback| with each object, in the order of their slots.
+  template <typename Callback>
+  void ForEach(v8::Isolate* isolate, Callback callback) const {
+    for (const auto& slot : slots_) {
+      if (!slot.object.IsEmpty())
+        callback(v8::Local<v8::Object>::New(isolate, slot.object));
+    }
+  }
+
+  // The number of objects set, which ForEach() calls back with.
+  size_t size() const { return object_count_; }
+
+  // Frees the slot of |id|, the key is not given again.
+  void Remove(int32_t id) {
+    Slot* slot = Find(id);
+    if (!slot)
+      return;
+    if (!slot->object.IsEmpty())
+      --object_count_;
+    slot->object.Reset();
+    slot->used = false;
+    // A slot whose generations are used up is retired.
+    if (++slot->generation <= kMaxGeneration)
+      free_slots_.push_back(slot->index());
+  }
+
+ private:
+  static constexpr int kSlotBits = 20;
+  static constexpr size_t kMaxSlots = size_t{1} << kSlotBits;
+  // Keeps the keys below 2^31.
+  static constexpr uint32_t kMaxGeneration = (1u << (31 - kSlotBits)) - 2;
+
+  struct Slot {
+    uint32_t index() const { return (id - 1) & (kMaxSlots - 1); }
+
+    IDWeakMap* self = nullptr;
+    int32_t id = 0;
+    uint32_t generation = 0;
+    bool used = false;
+    v8::Global<v8::Object> object;
+  };
+
+  const Slot* Find(int32_t id) const {
+    if (id <= 0)
+      return nullptr;
+    size_t index = (id - 1) & (kMaxSlots - 1);
+    if (index >= slots_.size())
+      return nullptr;
+    const Slot& slot = slots_[index];
+    return slot.used && slot.id == id ? &slot : nullptr;
+  }
+  Slot* Find(int32_t id) {
+    return const_cast<Slot*>(static_cast<const IDWeakMap*>(this)->Find(id));
+  }
+
+  static void OnObjectGC(const v8::WeakCallbackInfo<Slot>& data) {
+    Slot* slot = data.GetParameter();
+    slot->self->Remove(slot->id);
+  }
+
+  // A deque keeps the slots in place as it grows, their addresses are the
+  // parameters of the weak callbacks.
+  std::deque<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  size_t object_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IDWeakMap);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_ID_WEAK_MAP_H_
@@ -0,0 +1,120 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/ipc_metrics.h"
+
+#include <algorithm>
+
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
+#include "shell/common/crash_reporter/breadcrumbs.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+
+namespace electron {
+
+namespace {
+
+// Channel names are chosen by the pages, so bound the number of channels that
+// get their own counters and histograms.
+constexpr size_t kMaxTrackedChannels = 1000;
+
+const char kOtherChannels[] = "<other>";
+
+std::string GetHistogramName(base::StringPiece metric,
+                             base::StringPiece channel) {
+  return base::StrCat({"Electron.IPC.", metric, ".", channel});
+}
+
+}  // namespace
+
+IPCMetrics::ScopedDispatch::ScopedDispatch(base::StringPiece channel,
+                                           size_t bytes)
+    : channel_(channel.as_string()),
+      bytes_(bytes),
+      start_time_(base::TimeTicks::Now()) {
+  crash_reporter::RecordBreadcrumb("ipc", channel);
+}
+
+IPCMetrics::ScopedDispatch::~ScopedDispatch() {
+  IPCMetrics::GetInstance()->RecordReceived(
+      channel_, bytes_, base::TimeTicks::Now() - start_time_);
+}
+
+// static
+IPCMetrics* IPCMetrics::GetInstance() {
+  static base::NoDestructor<IPCMetrics> instance;
+  return instance.get();
+}
+
+// static
+size_t IPCMetrics::GetSize(
+    const blink::CloneableMessage& message,
+    const std::vector<base::ReadOnlySharedMemoryRegion>& array_buffers) {
+  size_t size = message.encoded_message.size();
+  for (const auto& region : array_buffers)
+    size += region.GetSize();
+  return size;
+}
+
+IPCMetrics::IPCMetrics() = default;
+IPCMetrics::~IPCMetrics() = default;
+
+void IPCMetrics::RecordReceived(base::StringPiece channel,
+                                size_t bytes,
+                                base::TimeDelta handler_time) {
+  std::string tracked_channel;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto* entry = GetEntry(channel);
+    ChannelMetrics& metrics = entry->second;
+    metrics.messages_received++;
+    metrics.bytes_received += bytes;
+    metrics.handler_time += handler_time;
+    metrics.max_handler_time = std::max(metrics.max_handler_time, handler_time);
+    tracked_channel = entry->first;
+  }
+
+  UMA_HISTOGRAM_COUNTS_10M("Electron.IPC.ReceivedBytes", bytes);
+  UMA_HISTOGRAM_TIMES("Electron.IPC.HandlerTime", handler_time);
+  base::UmaHistogramCounts10M(
+      GetHistogramName("ReceivedBytes", tracked_channel), bytes);
+  base::UmaHistogramTimes(GetHistogramName("HandlerTime", tracked_channel),
+                          handler_time);
+}
+
+void IPCMetrics::RecordSent(base::StringPiece channel, size_t bytes) {
+  std::string tracked_channel;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto* entry = GetEntry(channel);
+    entry->second.messages_sent++;
+    entry->second.bytes_sent += bytes;
+    tracked_channel = entry->first;
+  }
+
+  UMA_HISTOGRAM_COUNTS_10M("Electron.IPC.SentBytes", bytes);
+  base::UmaHistogramCounts10M(GetHistogramName("SentBytes", tracked_channel),
+                              bytes);
+}
+
+std::map<std::string, IPCMetrics::ChannelMetrics> IPCMetrics::GetMetrics()
+    const {
+  base::AutoLock auto_lock(lock_);
+  return channels_;
+}
+
+std::pair<const std::string, IPCMetrics::ChannelMetrics>*
+IPCMetrics::GetEntry(base::StringPiece channel) {
+  lock_.AssertAcquired();
+  auto it = channels_.find(channel.as_string());
+  if (it == channels_.end()) {
+    if (channels_.size() >= kMaxTrackedChannels)
+      channel = kOtherChannels;
+    it = channels_.emplace(channel.as_string(), ChannelMetrics()).first;
+  }
+  return &*it;
+}
+
+}  // namespace electron
@@ -0,0 +1,90 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IPC_METRICS_H_
+#define SHELL_COMMON_IPC_METRICS_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace blink {
+struct CloneableMessage;
+}  // namespace blink
+
+namespace electron {
+
+// Per channel counters of the IPC messages handled by this process.
+//
+// Besides the counters kept in memory, every message is recorded in the
+// Electron.IPC.* histograms, in total and per channel.
+class IPCMetrics {
+ public:
+  struct ChannelMetrics {
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    // Time spent in the handlers of the received messages.
+    base::TimeDelta handler_time;
+    base::TimeDelta max_handler_time;
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+  };
+
+  // Records the dispatch of a received message, timing the handlers that run
+  // until it goes out of scope.
+  class ScopedDispatch {
+   public:
+    ScopedDispatch(base::StringPiece channel, size_t bytes);
+    ~ScopedDispatch();
+
+   private:
+    std::string channel_;
+    size_t bytes_;
+    base::TimeTicks start_time_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedDispatch);
+  };
+
+  static IPCMetrics* GetInstance();
+
+  // Returns the serialized size of an IPC payload.
+  static size_t GetSize(
+      const blink::CloneableMessage& message,
+      const std::vector<base::ReadOnlySharedMemoryRegion>& array_buffers = {});
+
+  void RecordReceived(base::StringPiece channel,
+                      size_t bytes,
+                      base::TimeDelta handler_time);
+  void RecordSent(base::StringPiece channel, size_t bytes);
+
+  std::map<std::string, ChannelMetrics> GetMetrics() const;
+
+ private:
+  friend class base::NoDestructor<IPCMetrics>;
+
+  IPCMetrics();
+  ~IPCMetrics();
+
+  // Returns the entry of |channel|, or the one shared by the channels that
+  // are not tracked when too many channels are tracked already.
+  std::pair<const std::string, ChannelMetrics>* GetEntry(
+      base::StringPiece channel);
+
+  mutable base::Lock lock_;
+  std::map<std::string, ChannelMetrics> channels_;
+
+  DISALLOW_COPY_AND_ASSIGN(IPCMetrics);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IPC_METRICS_H_
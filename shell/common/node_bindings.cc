@@ -15,16 +15,19 @@
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
+#include "base/optional.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/content_paths.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/electron_command_line.h"
+#include "shell/common/event_loop_lag_monitor.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
@@ -32,46 +35,56 @@
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_includes.h"
 
-#define ELECTRON_BUILTIN_MODULES(V)      \
-  V(electron_browser_app)                \
-  V(electron_browser_auto_updater)       \
-  V(electron_browser_browser_view)       \
-  V(electron_browser_content_tracing)    \
-  V(electron_browser_dialog)             \
-  V(electron_browser_download_item)      \
-  V(electron_browser_event)              \
-  V(electron_browser_event_emitter)      \
-  V(electron_browser_global_shortcut)    \
-  V(electron_browser_in_app_purchase)    \
-  V(electron_browser_menu)               \
-  V(electron_browser_message_port)       \
-  V(electron_browser_net)                \
-  V(electron_browser_power_monitor)      \
-  V(electron_browser_power_save_blocker) \
-  V(electron_browser_protocol)           \
-  V(electron_browser_session)            \
-  V(electron_browser_system_preferences) \
-  V(electron_browser_top_level_window)   \
-  V(electron_browser_tray)               \
-  V(electron_browser_web_contents)       \
-  V(electron_browser_web_contents_view)  \
-  V(electron_browser_view)               \
-  V(electron_browser_web_view_manager)   \
-  V(electron_browser_window)             \
-  V(electron_common_asar)                \
-  V(electron_common_clipboard)           \
-  V(electron_common_command_line)        \
-  V(electron_common_crash_reporter)      \
-  V(electron_common_features)            \
-  V(electron_common_native_image)        \
-  V(electron_common_native_theme)        \
-  V(electron_common_notification)        \
-  V(electron_common_screen)              \
-  V(electron_common_shell)               \
-  V(electron_common_v8_util)             \
-  V(electron_renderer_context_bridge)    \
-  V(electron_renderer_ipc)               \
-  V(electron_renderer_web_frame)
+#if defined(OS_WIN) || defined(OS_LINUX) || \
+    (defined(OS_MACOSX) && !defined(MAS_BUILD))
+#include "shell/common/crash_reporter/hang_watchdog.h"
+#endif
+
+#define ELECTRON_BUILTIN_MODULES(V)        \
+  V(electron_browser_app)                  \
+  V(electron_browser_auto_updater)         \
+  V(electron_browser_browser_view)         \
+  V(electron_browser_content_tracing)      \
+  V(electron_browser_dialog)               \
+  V(electron_browser_download_item)        \
+  V(electron_browser_event)                \
+  V(electron_browser_event_emitter)        \
+  V(electron_browser_global_shortcut)      \
+  V(electron_browser_in_app_purchase)      \
+  V(electron_browser_menu)                 \
+  V(electron_browser_message_port)         \
+  V(electron_browser_net)                  \
+  V(electron_browser_power_monitor)        \
+  V(electron_browser_power_save_blocker)   \
+  V(electron_browser_protocol)             \
+  V(electron_browser_session)              \
+  V(electron_browser_system_preferences)   \
+  V(electron_browser_top_level_window)     \
+  V(electron_browser_tray)                 \
+  V(electron_browser_utility_process)      \
+  V(electron_browser_web_contents)         \
+  V(electron_browser_web_contents_view)    \
+  V(electron_browser_view)                 \
+  V(electron_browser_web_view_manager)     \
+  V(electron_browser_window)               \
+  V(electron_browser_worker_ipc)           \
+  V(electron_common_asar)                  \
+  V(electron_common_clipboard)             \
+  V(electron_common_command_line)          \
+  V(electron_common_crash_reporter)        \
+  V(electron_common_features)              \
+  V(electron_common_native_image)          \
+  V(electron_common_native_theme)          \
+  V(electron_common_notification)          \
+  V(electron_common_screen)                \
+  V(electron_common_shell)                 \
+  V(electron_common_v8_util)               \
+  V(electron_renderer_context_bridge)      \
+  V(electron_renderer_ipc)                 \
+  V(electron_renderer_system_snapshot)     \
+  V(electron_renderer_web_frame)           \
+  V(electron_renderer_worker_module_cache) \
+  V(electron_utility_parent_port)
 
 #define ELECTRON_VIEWS_MODULES(V) V(electron_browser_image_view)
 
@@ -226,6 +239,12 @@ namespace electron {
 
 namespace {
 
+// Time the libuv loop may run, in one run or in back to back ones, before
+// the message loop gives Chromium's tasks a turn. It only bounds how often
+// the loop runs, a single busy run is not interrupted.
+constexpr base::TimeDelta kUvRunTimeSlice =
+    base::TimeDelta::FromMilliseconds(8);
+
 // Convert the given vector to an array of C-strings. The strings in the
 // returned vector are only guaranteed valid so long as the vector of strings
 // is not modified.
@@ -263,16 +282,18 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-  WakeupEmbedThread();
-
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+  if (embed_thread_started_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+    WakeupEmbedThread();
+
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   uv_close(reinterpret_cast<uv_handle_t*>(&dummy_uv_handle_), nullptr);
 
   // Clean up worker loop
@@ -299,7 +320,8 @@ bool NodeBindings::IsInitialized() {
 void NodeBindings::Initialize() {
   TRACE_EVENT0("electron", "NodeBindings::Initialize");
   // Open node's error reporting system for browser process.
-  node::g_standalone_mode = browser_env_ == BrowserEnvironment::BROWSER;
+  node::g_standalone_mode = browser_env_ == BrowserEnvironment::BROWSER ||
+                           browser_env_ == BrowserEnvironment::UTILITY;
   node::g_upstream_node_mode = false;
 
 #if defined(OS_LINUX)
@@ -344,6 +366,7 @@ void NodeBindings::Initialize() {
 node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context,
     node::MultiIsolatePlatform* platform) {
+  TRACE_EVENT0("electron", "NodeBindings::CreateEnvironment");
 #if defined(OS_WIN)
   auto& atom_args = ElectronCommandLine::argv();
   std::vector<std::string> args(atom_args.size());
@@ -365,13 +388,18 @@ node::Environment* NodeBindings::CreateEnvironment(
     case BrowserEnvironment::WORKER:
       process_type = "worker";
       break;
+    case BrowserEnvironment::UTILITY:
+      process_type = "utility";
+      break;
   }
 
   gin_helper::Dictionary global(context->GetIsolate(), context->Global());
   // Do not set DOM globals for renderer process.
   // We must set this before the node bootstrapper which is run inside
   // CreateEnvironment
-  if (browser_env_ != BrowserEnvironment::BROWSER)
+  bool no_browser_globals = browser_env_ != BrowserEnvironment::BROWSER &&
+                            browser_env_ != BrowserEnvironment::UTILITY;
+  if (no_browser_globals)
     global.Set("_noBrowserGlobals", true);
 
   base::FilePath resources_path = GetResourcesPath();
@@ -388,13 +416,14 @@ node::Environment* NodeBindings::CreateEnvironment(
 
   // Clean up the global _noBrowserGlobals that we unironically injected into
   // the global scope
-  if (browser_env_ != BrowserEnvironment::BROWSER) {
+  if (no_browser_globals) {
     // We need to bootstrap the env in non-browser processes so that
     // _noBrowserGlobals is read correctly before we remove it
     global.Delete("_noBrowserGlobals");
   }
 
-  if (browser_env_ == BrowserEnvironment::BROWSER) {
+  if (browser_env_ == BrowserEnvironment::BROWSER ||
+      browser_env_ == BrowserEnvironment::UTILITY) {
     // SetAutorunMicrotasks is no longer called in node::CreateEnvironment
     // so instead call it here to match expected node behavior
     context->GetIsolate()->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
@@ -412,10 +441,17 @@ node::Environment* NodeBindings::CreateEnvironment(
   base::PathService::Get(content::CHILD_PROCESS_EXE, &helper_exec_path);
   process.Set("helperExecPath", helper_exec_path);
 
+  // Created before the main script runs so that it can start the monitor.
+  if (browser_env_ == BrowserEnvironment::BROWSER) {
+    lag_monitor_ = std::make_unique<EventLoopLagMonitor>(
+        context->GetIsolate(), base::ThreadTaskRunnerHandle::Get());
+  }
+
   return env;
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  TRACE_EVENT0("electron", "NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env);
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -425,9 +461,13 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  if (!UsesEmbedThread())
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -461,8 +501,29 @@ void NodeBindings::UvRunOnce() {
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
+#if defined(OS_WIN) || defined(OS_LINUX) || \
+    (defined(OS_MACOSX) && !defined(MAS_BUILD))
+  // On Linux the uv callbacks of the main thread are dispatched by a GSource
+  // rather than a task, time them like one. Workers run on threads of their
+  // own, which are not watched.
+  base::Optional<crash_reporter::HangWatchdog::ScopedWork> hang_watchdog_work;
+  if (browser_env_ != BrowserEnvironment::WORKER)
+    hang_watchdog_work.emplace();
+#endif
+
   // Deal with uv events.
+  TRACE_EVENT0("electron", "NodeBindings::UvRunOnce");
+  base::TimeTicks start = base::TimeTicks::Now();
   int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+  uv_run_time_since_yield_ += elapsed;
+  if (lag_monitor_)
+    lag_monitor_->RecordUvRun(elapsed);
+  if (elapsed > kUvRunTimeSlice) {
+    TRACE_EVENT_INSTANT1("electron", "NodeBindings::UvRunOverBudget",
+                         TRACE_EVENT_SCOPE_THREAD, "ms",
+                         elapsed.InMillisecondsF());
+  }
 
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -471,7 +532,27 @@ void NodeBindings::UvRunOnce() {
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (embed_thread_started_)
+    uv_sem_post(&embed_sem_);
+  else
+    WatchEvents();
+
+  // The next run is then posted as a task of its own, behind the tasks that
+  // are already queued, which gives them their turn.
+  if (embed_thread_started_ || !UsesMessagePumpSource())
+    uv_run_time_since_yield_ = base::TimeDelta();
+}
+
+bool NodeBindings::uv_run_over_budget() const {
+  return uv_run_time_since_yield_ > kUvRunTimeSlice;
+}
+
+bool NodeBindings::UsesMessagePumpSource() const {
+  return false;
+}
+
+bool NodeBindings::UsesEmbedThread() const {
+  return true;
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -5,10 +5,13 @@
 #ifndef SHELL_COMMON_NODE_BINDINGS_H_
 #define SHELL_COMMON_NODE_BINDINGS_H_
 
+#include <memory>
+
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "uv.h"  // NOLINT(build/include)
 #include "v8/include/v8.h"
 
@@ -24,12 +27,15 @@ class IsolateData;
 
 namespace electron {
 
+class EventLoopLagMonitor;
+
 class NodeBindings {
  public:
   enum class BrowserEnvironment {
     BROWSER,
     RENDERER,
     WORKER,
+    UTILITY,
   };
 
   static NodeBindings* Create(BrowserEnvironment browser_env);
@@ -62,18 +68,45 @@ class NodeBindings {
 
   uv_loop_t* uv_loop() const { return uv_loop_; }
 
+  // Measures how long the main thread of the browser process is blocked, null
+  // in other processes.
+  EventLoopLagMonitor* lag_monitor() const { return lag_monitor_.get(); }
+
  protected:
   explicit NodeBindings(BrowserEnvironment browser_env);
 
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Whether uv's backend fd should be polled in the embed thread. Platforms
+  // that can watch it on the message pump of the current thread return false,
+  // and run UvRunOnce() themselves when it becomes readable.
+  virtual bool UsesEmbedThread() const;
+
+  // Called after each run of the libuv loop when the embed thread is not
+  // used, to start waiting for the next events.
+  virtual void WatchEvents() {}
+
   // Run the libuv loop for once.
   void UvRunOnce();
 
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
+  // Whether the libuv loop will be run from a source of the message pump
+  // rather than from posted tasks, in which case the source has to give
+  // Chromium's tasks their turn itself.
+  virtual bool UsesMessagePumpSource() const;
+
+  // Whether the runs of the libuv loop since Chromium's tasks last had a turn
+  // took longer than the time slice, in which case the message pump source
+  // should let the pending tasks run before the next one. Runs from posted
+  // tasks always leave the tasks queued before them a turn.
+  bool uv_run_over_budget() const;
+  void clear_uv_run_over_budget() {
+    uv_run_time_since_yield_ = base::TimeDelta();
+  }
+
   // Interrupt the PollEvents.
   void WakeupEmbedThread();
 
@@ -93,6 +126,11 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether PrepareMessageLoop() started the embed thread.
+  bool embed_thread_started_ = false;
+
+  base::TimeDelta uv_run_time_since_yield_;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
@@ -111,6 +149,8 @@ class NodeBindings {
   // Isolate data used in creating the environment
   node::IsolateData* isolate_data_ = nullptr;
 
+  std::unique_ptr<EventLoopLagMonitor> lag_monitor_;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindings);
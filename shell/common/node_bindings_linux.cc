@@ -5,9 +5,163 @@
 #include "shell/common/node_bindings_linux.h"
 
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
 
 namespace electron {
 
+// Every worker with node integration used to get its own embed thread. The
+// backend fds of their loops are instead watched by one epoll in a shared
+// thread, each one armed once per run of its loop, which posts the runs to
+// the task runners of the workers.
+class NodeBindingsLinux::WorkerPoller {
+ public:
+  static WorkerPoller* Get() {
+    static base::NoDestructor<WorkerPoller> poller;
+    return poller.get();
+  }
+
+  WorkerPoller() : epoll_(epoll_create1(EPOLL_CLOEXEC)) {
+    event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, event_fd_, &ev);
+    uv_thread_create(&thread_, ThreadRunner, this);
+  }
+
+  // Waits for the next events of |bindings|, or for |timeout| milliseconds
+  // when it is not -1, then runs its loop once.
+  void Watch(NodeBindingsLinux* bindings, int timeout) {
+    base::AutoLock auto_lock(lock_);
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = bindings;
+    int op = registered_.insert(bindings).second ? EPOLL_CTL_ADD
+                                                 : EPOLL_CTL_MOD;
+    epoll_ctl(epoll_, op, uv_backend_fd(bindings->uv_loop_), &ev);
+
+    if (timeout < 0) {
+      watched_[bindings] = base::TimeTicks::Max();
+    } else {
+      watched_[bindings] =
+          base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(timeout);
+      // The poller may be waiting for a later deadline.
+      uint64_t value = 1;
+      ignore_result(write(event_fd_, &value, sizeof(value)));
+    }
+  }
+
+  void Remove(NodeBindingsLinux* bindings) {
+    base::AutoLock auto_lock(lock_);
+    watched_.erase(bindings);
+    if (registered_.erase(bindings))
+      epoll_ctl(epoll_, EPOLL_CTL_DEL, uv_backend_fd(bindings->uv_loop_),
+                nullptr);
+  }
+
+ private:
+  static void ThreadRunner(void* arg) {
+    static_cast<WorkerPoller*>(arg)->Run();
+  }
+
+  void Run() {
+    while (true) {
+      int timeout = -1;
+      {
+        base::AutoLock auto_lock(lock_);
+        base::TimeTicks deadline = base::TimeTicks::Max();
+        for (const auto& iter : watched_)
+          deadline = std::min(deadline, iter.second);
+        if (!deadline.is_max()) {
+          timeout = std::max<int64_t>(
+              0, (deadline - base::TimeTicks::Now()).InMillisecondsRoundedUp());
+        }
+      }
+
+      constexpr int kMaxEvents = 16;
+      struct epoll_event events[kMaxEvents];
+      int r = epoll_wait(epoll_, events, kMaxEvents, timeout);
+      if (r == -1 && errno != EINTR)
+        return;
+
+      base::AutoLock auto_lock(lock_);
+      for (int i = 0; i < r; ++i) {
+        if (events[i].data.ptr) {
+          Wakeup(static_cast<NodeBindingsLinux*>(events[i].data.ptr));
+        } else {
+          uint64_t value;
+          ignore_result(read(event_fd_, &value, sizeof(value)));
+        }
+      }
+
+      base::TimeTicks now = base::TimeTicks::Now();
+      std::vector<NodeBindingsLinux*> expired;
+      for (const auto& iter : watched_) {
+        if (iter.second <= now)
+          expired.push_back(iter.first);
+      }
+      for (NodeBindingsLinux* bindings : expired)
+        Wakeup(bindings);
+    }
+  }
+
+  void Wakeup(NodeBindingsLinux* bindings) {
+    lock_.AssertAcquired();
+    if (!watched_.erase(bindings))
+      return;
+    // Disarm the fd in case it was a timeout that fired.
+    struct epoll_event ev = {0};
+    ev.data.ptr = bindings;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, uv_backend_fd(bindings->uv_loop_), &ev);
+    bindings->WakeupMainThread();
+  }
+
+  int epoll_;
+  int event_fd_;
+  uv_thread_t thread_;
+
+  base::Lock lock_;
+  // Workers waiting for events, with the time their next uv timer is due.
+  std::map<NodeBindingsLinux*, base::TimeTicks> watched_;
+  // Workers whose backend fd is in |epoll_|.
+  std::set<NodeBindingsLinux*> registered_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerPoller);
+};
+
+#if defined(USE_GLIB)
+struct NodeBindingsLinux::UvSource {
+  GSource source;
+  NodeBindingsLinux* bindings;
+  void* fd_tag;
+};
+
+namespace {
+
+GSourceFuncs g_uv_source_funcs = {};
+
+// The priority of the work source of base::MessagePumpGlib, so that libuv
+// events and Chromium tasks are dispatched in the same main context
+// iterations instead of libuv events always coming first.
+constexpr int kUvSourcePriority = 1;
+
+}  // namespace
+#endif
+
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
@@ -17,13 +171,41 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
-NodeBindingsLinux::~NodeBindingsLinux() = default;
+NodeBindingsLinux::~NodeBindingsLinux() {
+  if (browser_env_ == BrowserEnvironment::WORKER)
+    WorkerPoller::Get()->Remove(this);
+#if defined(USE_GLIB)
+  if (uv_source_) {
+    g_source_destroy(uv_source_);
+    g_source_unref(uv_source_);
+  }
+#endif
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+#if defined(USE_GLIB)
+  // The browser process runs glib's default main context on the main thread,
+  // so the backend fd can be watched there directly and the events handled
+  // without going through the embed thread.
+  if (!UsesEmbedThread() && !uv_source_) {
+    g_uv_source_funcs.prepare = OnSourcePrepare;
+    g_uv_source_funcs.check = OnSourceCheck;
+    g_uv_source_funcs.dispatch = OnSourceDispatch;
+    uv_source_ = g_source_new(&g_uv_source_funcs, sizeof(UvSource));
+    UvSource* source = reinterpret_cast<UvSource*>(uv_source_);
+    source->bindings = this;
+    source->fd_tag =
+        g_source_add_unix_fd(uv_source_, uv_backend_fd(uv_loop_), G_IO_IN);
+    g_source_set_can_recurse(uv_source_, FALSE);
+    g_source_set_priority(uv_source_, kUvSourcePriority);
+    g_source_attach(uv_source_, nullptr);
+  }
+#endif
+
   NodeBindings::RunMessageLoop();
 }
 
@@ -31,6 +213,15 @@ void NodeBindingsLinux::RunMessageLoop() {
 void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
+#if defined(USE_GLIB)
+  // The queue is changed on the main thread, so it is enough to run the loop
+  // again before the main context goes back to polling.
+  if (self->uv_source_) {
+    self->watcher_queue_changed_ = true;
+    return;
+  }
+#endif
+
   // We need to break the io polling in the epoll thread when loop's watcher
   // queue changes, otherwise new events cannot be notified.
   self->WakeupEmbedThread();
@@ -47,6 +238,84 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::UsesEmbedThread() const {
+  // Workers share the poller thread.
+  if (browser_env_ == BrowserEnvironment::WORKER)
+    return false;
+#if defined(USE_GLIB)
+  // Only the main thread of the browser process runs a glib message pump,
+  // renderers keep polling in the embed thread.
+  return browser_env_ != BrowserEnvironment::BROWSER;
+#else
+  return true;
+#endif
+}
+
+bool NodeBindingsLinux::UsesMessagePumpSource() const {
+#if defined(USE_GLIB)
+  return uv_source_ != nullptr;
+#else
+  return false;
+#endif
+}
+
+void NodeBindingsLinux::WatchEvents() {
+  if (browser_env_ == BrowserEnvironment::WORKER)
+    WorkerPoller::Get()->Watch(this, uv_backend_timeout(uv_loop_));
+}
+
+#if defined(USE_GLIB)
+// static
+int NodeBindingsLinux::OnSourcePrepare(GSource* source, int* timeout) {
+  NodeBindingsLinux* self = reinterpret_cast<UvSource*>(source)->bindings;
+
+  // After a long run the source sits out one iteration, so the pending tasks
+  // and the other sources get a turn before libuv runs again.
+  if (self->uv_run_over_budget()) {
+    *timeout = 0;
+    return FALSE;
+  }
+
+  if (self->watcher_queue_changed_) {
+    *timeout = 0;
+    return TRUE;
+  }
+
+  // Wake up in time for the next uv timer.
+  *timeout = uv_backend_timeout(self->uv_loop_);
+  return *timeout == 0;
+}
+
+// static
+int NodeBindingsLinux::OnSourceCheck(GSource* source) {
+  UvSource* uv_source = reinterpret_cast<UvSource*>(source);
+  if (uv_source->bindings->uv_run_over_budget()) {
+    uv_source->bindings->clear_uv_run_over_budget();
+    return FALSE;
+  }
+
+  if (g_source_query_unix_fd(source, uv_source->fd_tag) & G_IO_IN)
+    return TRUE;
+
+  // The main context may have been woken up by a timeout, uv only sees that
+  // its timers are due once its cached time is updated.
+  NodeBindingsLinux* self = uv_source->bindings;
+  uv_update_time(self->uv_loop_);
+  return self->watcher_queue_changed_ ||
+         uv_backend_timeout(self->uv_loop_) == 0;
+}
+
+// static
+int NodeBindingsLinux::OnSourceDispatch(GSource* source,
+                                        int (*callback)(void*),
+                                        void* user_data) {
+  NodeBindingsLinux* self = reinterpret_cast<UvSource*>(source)->bindings;
+  self->watcher_queue_changed_ = false;
+  self->UvRunOnce();
+  return TRUE;  // G_SOURCE_CONTINUE
+}
+#endif
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
@@ -8,6 +8,10 @@
 #include "base/compiler_specific.h"
 #include "shell/common/node_bindings.h"
 
+#if defined(USE_GLIB)
+typedef struct _GSource GSource;
+#endif
+
 namespace electron {
 
 class NodeBindingsLinux : public NodeBindings {
@@ -22,10 +26,35 @@ class NodeBindingsLinux : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool UsesEmbedThread() const override;
+  bool UsesMessagePumpSource() const override;
+  void WatchEvents() override;
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+  // Polls the loops of all the workers of the process in a single thread.
+  class WorkerPoller;
+
+#if defined(USE_GLIB)
+  struct UvSource;
+
+  // GSource callbacks that watch uv's backend fd on the main context.
+  static int OnSourcePrepare(GSource* source, int* timeout);
+  static int OnSourceCheck(GSource* source);
+  static int OnSourceDispatch(GSource* source,
+                              int (*callback)(void*),
+                              void* user_data);
+
+  // Attached to the default main context when the loop is integrated with
+  // the message pump instead of the embed thread.
+  GSource* uv_source_ = nullptr;
+
+  // Set when uv's watcher queue changed outside of uv_run, the new watchers
+  // are only added to the backend fd by the next run.
+  bool watcher_queue_changed_ = false;
+#endif
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
@@ -93,6 +93,9 @@ const char kOpacity[] = "opacity";
 // Whether the window can be activated.
 const char kFocusable[] = "focusable";
 
+// Emit at most one "move" and "resize" per frame.
+const char kCoalesceBoundsEvents[] = "coalesceBoundsEvents";
+
 // The WebPreferences.
 const char kWebPreferences[] = "webPreferences";
 
@@ -152,6 +155,19 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+// Pass the frames of offscreen rendering as shared textures.
+const char kOffscreenSharedTexture[] = "offscreenSharedTexture";
+
+// Pass only the damaged area of offscreen frames to the paint event.
+const char kOffscreenOnlyDirty[] = "offscreenOnlyDirty";
+
+// Let the embedder issue the begin frames of offscreen rendering.
+const char kOffscreenExternalBeginFrames[] = "offscreenExternalBeginFrames";
+
+// Issue the begin frames of offscreen rendering from a timer shared by all
+// offscreen views.
+const char kOffscreenSharedBeginFrames[] = "offscreenSharedBeginFrames";
+
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
 // Disable window resizing when HTML Fullscreen API is activated.
@@ -201,6 +217,12 @@ const char kPpapiFlashVersion[] = "ppapi-flash-version";
 // Disable HTTP cache.
 const char kDisableHttpCache[] = "disable-http-cache";
 
+// Download large files with several requests in parallel, and the number of
+// requests and the minimum size of the slice of each one.
+const char kEnableParallelDownloads[] = "enable-parallel-downloads";
+const char kParallelDownloadRequestCount[] = "parallel-download-request-count";
+const char kParallelDownloadMinSliceSize[] = "parallel-download-min-slice-size";
+
 // The list of standard schemes.
 const char kStandardSchemes[] = "standard-schemes";
 
@@ -227,6 +249,9 @@ const char kAppPath[] = "app-path";
 
 const char kEnableApiFilteringLogging[] = "enable-api-filtering-logging";
 
+// Writes the logs from a background thread, as text or JSON.
+const char kLogFormat[] = "log-format";
+
 // The command line switch versions of the options.
 const char kBackgroundColor[] = "background-color";
 const char kPreloadScript[] = "preload";
@@ -52,6 +52,7 @@ extern const char kBackgroundColor[];
 extern const char kHasShadow[];
 extern const char kOpacity[];
 extern const char kFocusable[];
+extern const char kCoalesceBoundsEvents[];
 extern const char kWebPreferences[];
 extern const char kVibrancyType[];
 extern const char kTrafficLightPosition[];
@@ -77,6 +78,10 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kOffscreenSharedTexture[];
+extern const char kOffscreenOnlyDirty[];
+extern const char kOffscreenExternalBeginFrames[];
+extern const char kOffscreenSharedBeginFrames[];
 extern const char kNodeIntegrationInSubFrames[];
 extern const char kDisableHtmlFullscreenWindowResize[];
 extern const char kJavaScript[];
@@ -104,6 +109,9 @@ extern const char kEnablePlugins[];
 extern const char kPpapiFlashPath[];
 extern const char kPpapiFlashVersion[];
 extern const char kDisableHttpCache[];
+extern const char kEnableParallelDownloads[];
+extern const char kParallelDownloadRequestCount[];
+extern const char kParallelDownloadMinSliceSize[];
 extern const char kStandardSchemes[];
 extern const char kServiceWorkerSchemes[];
 extern const char kSecureSchemes[];
@@ -113,6 +121,7 @@ extern const char kCORSSchemes[];
 extern const char kAppUserModelId[];
 extern const char kAppPath[];
 extern const char kEnableApiFilteringLogging[];
+extern const char kLogFormat[];
 
 extern const char kBackgroundColor[];
 extern const char kPreloadScript[];
@@ -0,0 +1,35 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_PERF_TEST_UTIL_H_
+#define SHELL_COMMON_PERF_TEST_UTIL_H_
+
+#include <string>
+
+#include "base/time/time.h"
+#include "base/timer/lap_timer.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace electron {
+
+// Runs |step| until a second has passed, after a few warmup runs, and
+// reports the runs per second as the |story| of |metric|.
+template <typename Step>
+void MeasureRunsPerSecond(const std::string& metric,
+                          const std::string& story,
+                          Step step) {
+  base::LapTimer timer(10, base::TimeDelta::FromSeconds(1), 10);
+  do {
+    step();
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter(metric, story);
+  reporter.RegisterImportantMetric(".runs_per_second", "runs/s");
+  reporter.AddResult(".runs_per_second", timer.LapsPerSecond());
+}
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_PERF_TEST_UTIL_H_
@@ -0,0 +1,35 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/test/launcher/unit_test_launcher.h"
+#include "base/test/perf_test_suite.h"
+#include "gin/v8_initializer.h"
+
+namespace {
+
+class ElectronPerfTestSuite : public base::PerfTestSuite {
+ public:
+  ElectronPerfTestSuite(int argc, char** argv)
+      : base::PerfTestSuite(argc, argv) {}
+
+ protected:
+  void Initialize() override {
+    base::PerfTestSuite::Initialize();
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+    gin::V8Initializer::LoadV8Snapshot();
+#endif
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ElectronPerfTestSuite test_suite(argc, argv);
+  // The timings would be skewed by tests running in parallel.
+  return base::LaunchUnitTestsSerially(
+      argc, argv,
+      base::BindOnce(&ElectronPerfTestSuite::Run,
+                     base::Unretained(&test_suite)));
+}
@@ -0,0 +1,27 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/shared_memory_buffer.h"
+
+#include <memory>
+#include <utility>
+
+namespace electron {
+
+v8::Local<v8::SharedArrayBuffer> NewSharedArrayBufferForMapping(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping) {
+  auto* holder = new base::WritableSharedMemoryMapping(std::move(mapping));
+  std::shared_ptr<v8::BackingStore> backing_store =
+      v8::SharedArrayBuffer::NewBackingStore(
+          holder->memory(), holder->size(),
+          [](void*, size_t, void* deleter_data) {
+            delete static_cast<base::WritableSharedMemoryMapping*>(
+                deleter_data);
+          },
+          holder);
+  return v8::SharedArrayBuffer::New(isolate, std::move(backing_store));
+}
+
+}  // namespace electron
@@ -0,0 +1,27 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SHARED_MEMORY_BUFFER_H_
+#define SHELL_COMMON_SHARED_MEMORY_BUFFER_H_
+
+#include <stddef.h>
+
+#include "base/memory/shared_memory_mapping.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Largest buffer webContents.createSharedBuffer() maps in both processes.
+constexpr size_t kMaxSharedBufferSize = 1024 * 1024 * 1024;
+
+// Returns a SharedArrayBuffer over the memory of |mapping|, which stays mapped
+// until the buffer is collected. Writes to it are seen by every other process
+// that has the region mapped.
+v8::Local<v8::SharedArrayBuffer> NewSharedArrayBufferForMapping(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_SHARED_MEMORY_BUFFER_H_
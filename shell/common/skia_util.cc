@@ -4,10 +4,14 @@
 
 #include <string>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_util.h"
+#include "base/no_destructor.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_restrictions.h"
+#include "crypto/sha2.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/node_includes.h"
@@ -15,6 +19,8 @@
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
@@ -30,6 +36,94 @@ namespace electron {
 
 namespace util {
 
+namespace {
+
+// The decoded images of files, by path and content, so that loading an image
+// again, like the frames of an animated tray icon or the icons of a menu that
+// is rebuilt, does not decode it again. It is used from all the threads the
+// images are loaded on.
+class DecodedImageCache {
+ public:
+  // The total size of the decoded pixels that are kept.
+  static constexpr size_t kMaxBytes = 16 * 1024 * 1024;
+
+  static DecodedImageCache* GetInstance() {
+    static base::NoDestructor<DecodedImageCache> instance;
+    return instance.get();
+  }
+
+  DecodedImageCache() : entries_(Entries::NO_AUTO_EVICT) {}
+
+  bool Get(const std::string& key, SkBitmap* bitmap) {
+    base::AutoLock auto_lock(lock_);
+    auto it = entries_.Get(key);
+    if (it == entries_.end())
+      return false;
+    *bitmap = it->second;
+    hits_++;
+    return true;
+  }
+
+  uint32_t hits() {
+    base::AutoLock auto_lock(lock_);
+    return hits_;
+  }
+
+  // |bitmap| must be immutable, it is shared by all the images of the file.
+  void Put(const std::string& key, const SkBitmap& bitmap) {
+    size_t bytes = bitmap.computeByteSize();
+    // A single large image would evict all the others.
+    if (bytes > kMaxBytes / 4)
+      return;
+    base::AutoLock auto_lock(lock_);
+    auto it = entries_.Peek(key);
+    if (it != entries_.end()) {
+      bytes_ -= it->second.computeByteSize();
+      entries_.Erase(it);
+    }
+    bytes_ += bytes;
+    entries_.Put(key, bitmap);
+    while (bytes_ > kMaxBytes) {
+      auto oldest = entries_.rbegin();
+      bytes_ -= oldest->second.computeByteSize();
+      entries_.Erase(oldest);
+    }
+  }
+
+ private:
+  using Entries = base::MRUCache<std::string, SkBitmap>;
+
+  base::Lock lock_;
+  Entries entries_;
+  size_t bytes_ = 0;
+  uint32_t hits_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+bool DecodePNG(const unsigned char* data, size_t size, SkBitmap* bitmap) {
+  return gfx::PNGCodec::Decode(data, size, bitmap);
+}
+
+bool DecodeJPEG(const unsigned char* data, size_t size, SkBitmap* bitmap) {
+  auto decoded = gfx::JPEGCodec::Decode(data, size);
+  if (!decoded)
+    return false;
+
+  // `JPEGCodec::Decode()` doesn't tell `SkBitmap` instance it creates
+  // that all of its pixels are opaque, that's why the bitmap gets
+  // an alpha type `kPremul_SkAlphaType` instead of `kOpaque_SkAlphaType`.
+  // Let's fix it here.
+  // TODO(alexeykuzmin): This workaround should be removed
+  // when the `JPEGCodec::Decode()` code is fixed.
+  // See https://github.com/electron/electron/issues/11294.
+  decoded->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
+  *bitmap = *decoded;
+  return true;
+}
+
+}  // namespace
+
 struct ScaleFactorPair {
   const char* name;
   float scale;
@@ -61,7 +155,7 @@ bool AddImageSkiaRepFromPNG(gfx::ImageSkia* image,
                             size_t size,
                             double scale_factor) {
   SkBitmap bitmap;
-  if (!gfx::PNGCodec::Decode(data, size, &bitmap))
+  if (!DecodePNG(data, size, &bitmap))
     return false;
 
   image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
@@ -72,20 +166,11 @@ bool AddImageSkiaRepFromJPEG(gfx::ImageSkia* image,
                              const unsigned char* data,
                              size_t size,
                              double scale_factor) {
-  auto bitmap = gfx::JPEGCodec::Decode(data, size);
-  if (!bitmap)
+  SkBitmap bitmap;
+  if (!DecodeJPEG(data, size, &bitmap))
     return false;
 
-  // `JPEGCodec::Decode()` doesn't tell `SkBitmap` instance it creates
-  // that all of its pixels are opaque, that's why the bitmap gets
-  // an alpha type `kPremul_SkAlphaType` instead of `kOpaque_SkAlphaType`.
-  // Let's fix it here.
-  // TODO(alexeykuzmin): This workaround should be removed
-  // when the `JPEGCodec::Decode()` code is fixed.
-  // See https://github.com/electron/electron/issues/11294.
-  bitmap->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
-
-  image->AddRepresentation(gfx::ImageSkiaRep(*bitmap, scale_factor));
+  image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
   return true;
 }
 
@@ -132,7 +217,23 @@ bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
       reinterpret_cast<const unsigned char*>(file_contents.data());
   size_t size = file_contents.size();
 
-  return AddImageSkiaRepFromBuffer(image, data, size, 0, 0, scale_factor);
+  // The content is part of the key, so a file that changed is decoded again.
+  std::string key =
+      path.AsUTF8Unsafe() + '\n' + crypto::SHA256HashString(file_contents);
+  SkBitmap bitmap;
+  if (!DecodedImageCache::GetInstance()->Get(key, &bitmap)) {
+    if (!DecodePNG(data, size, &bitmap) && !DecodeJPEG(data, size, &bitmap))
+      return false;
+    bitmap.setImmutable();
+    DecodedImageCache::GetInstance()->Put(key, bitmap);
+  }
+
+  image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
+  return true;
+}
+
+uint32_t GetDecodedImageCacheHits() {
+  return DecodedImageCache::GetInstance()->hits();
 }
 
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
@@ -150,6 +251,38 @@ bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
         image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
   return succeed;
 }
+
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  std::vector<unsigned char> encoded;
+  if (!bitmap.readyToDraw() ||
+      !gfx::JPEGCodec::Encode(bitmap, quality, &encoded)) {
+    encoded.clear();
+  }
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeWebP(const SkBitmap& bitmap, int quality) {
+  std::vector<unsigned char> encoded;
+  SkPixmap pixmap;
+  if (!bitmap.peekPixels(&pixmap))
+    return encoded;
+  SkWebpEncoder::Options options;
+  options.fCompression = SkWebpEncoder::Compression::kLossy;
+  options.fQuality = quality;
+  SkDynamicMemoryWStream stream;
+  if (!SkWebpEncoder::Encode(&stream, pixmap, options))
+    return encoded;
+  encoded.resize(stream.bytesWritten());
+  stream.copyTo(encoded.data());
+  return encoded;
+}
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SKIA_UTIL_H_
 
 #include <string>
+#include <vector>
 
 #include "ui/gfx/image/image_skia.h"
 
@@ -33,6 +34,16 @@ bool AddImageSkiaRepFromPNG(gfx::ImageSkia* image,
                             size_t size,
                             double scale_factor);
 
+// How many representations were found in the cache of decoded files instead
+// of being decoded again.
+uint32_t GetDecodedImageCacheHits();
+
+// Encode |bitmap|, the result is empty when it can not be encoded. They can be
+// used on any thread.
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap);
+std::vector<unsigned char> EncodeJPEG(const SkBitmap& bitmap, int quality);
+std::vector<unsigned char> EncodeWebP(const SkBitmap& bitmap, int quality);
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon);
 #endif
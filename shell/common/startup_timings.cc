@@ -0,0 +1,73 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timings.h"
+
+#include "base/metrics/histogram_functions.h"
+#include "base/process/process.h"
+#include "base/stl_util.h"
+#include "base/strings/strcat.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// Indexed by StartupTimings::Milestone.
+const char* const kMilestoneNames[] = {
+    "basicStartupComplete", "resourceBundleLoaded", "nodeInitialized",
+    "mainScriptEvaluated",  "preMainMessageLoopRun", "ready",
+    "firstWindowCreated",   "firstPaint",
+};
+
+static_assert(
+    base::size(kMilestoneNames) ==
+        static_cast<size_t>(StartupTimings::Milestone::kCount),
+    "Every milestone needs a name");
+
+}  // namespace
+
+// static
+StartupTimings* StartupTimings::GetInstance() {
+  static base::NoDestructor<StartupTimings> instance;
+  return instance.get();
+}
+
+StartupTimings::StartupTimings() {
+  // The process creation time is a wall clock time, translate it once to the
+  // monotonic clock of the milestones.
+  base::Time creation_time = base::Process::Current().CreationTime();
+  base::TimeTicks now = base::TimeTicks::Now();
+  process_creation_time_ =
+      creation_time.is_null() ? now : now - (base::Time::Now() - creation_time);
+}
+
+StartupTimings::~StartupTimings() = default;
+
+void StartupTimings::Record(Milestone milestone) {
+  auto& timing = timings_[static_cast<size_t>(milestone)];
+  if (!timing.is_null())
+    return;
+  timing = base::TimeTicks::Now();
+
+  const char* name = kMilestoneNames[static_cast<size_t>(milestone)];
+  TRACE_EVENT_INSTANT1("startup", "Electron.Startup", TRACE_EVENT_SCOPE_PROCESS,
+                       "milestone", name);
+  base::UmaHistogramMediumTimes(base::StrCat({"Electron.Startup.", name}),
+                                timing - process_creation_time_);
+}
+
+base::Value StartupTimings::GetTimings() const {
+  base::Value timings(base::Value::Type::DICTIONARY);
+  for (size_t i = 0; i < base::size(timings_); ++i) {
+    if (timings_[i].is_null())
+      continue;
+    timings.SetDoubleKey(
+        kMilestoneNames[i],
+        (timings_[i] - process_creation_time_).InMillisecondsF());
+  }
+  return timings;
+}
+
+}  // namespace electron
@@ -0,0 +1,56 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_STARTUP_TIMINGS_H_
+#define SHELL_COMMON_STARTUP_TIMINGS_H_
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace electron {
+
+// When this process reached the milestones of its startup.
+//
+// Each milestone is only recorded the first time it is reached, as a trace
+// event in the "startup" category and in the Electron.Startup.* histograms.
+// Only used on the main thread.
+class StartupTimings {
+ public:
+  enum class Milestone {
+    kBasicStartupComplete,
+    kResourceBundleLoaded,
+    kNodeInitialized,
+    kMainScriptEvaluated,
+    kPreMainMessageLoopRun,
+    kReady,
+    kFirstWindowCreated,
+    kFirstPaint,
+    kCount,
+  };
+
+  static StartupTimings* GetInstance();
+
+  void Record(Milestone milestone);
+
+  // Milestone name => milliseconds since the process was created, for the
+  // milestones reached so far.
+  base::Value GetTimings() const;
+
+ private:
+  friend class base::NoDestructor<StartupTimings>;
+
+  StartupTimings();
+  ~StartupTimings();
+
+  base::TimeTicks process_creation_time_;
+  base::TimeTicks timings_[static_cast<size_t>(Milestone::kCount)];
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTimings);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_STARTUP_TIMINGS_H_
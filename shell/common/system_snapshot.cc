@@ -0,0 +1,35 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/system_snapshot.h"
+
+namespace electron {
+
+void WriteSystemSnapshot(SystemSnapshotData* data,
+                         const SystemSnapshotValues& values) {
+  uint32_t sequence = data->sequence.load(std::memory_order_relaxed);
+  data->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  data->flags.store(values.flags, std::memory_order_relaxed);
+  data->theme_source.store(values.theme_source, std::memory_order_relaxed);
+  data->accent_color.store(values.accent_color, std::memory_order_relaxed);
+  data->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SystemSnapshotValues ReadSystemSnapshot(const SystemSnapshotData* data) {
+  SystemSnapshotValues values;
+  while (true) {
+    uint32_t sequence = data->sequence.load(std::memory_order_acquire);
+    if (sequence & 1)
+      continue;
+    values.flags = data->flags.load(std::memory_order_relaxed);
+    values.theme_source = data->theme_source.load(std::memory_order_relaxed);
+    values.accent_color = data->accent_color.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (data->sequence.load(std::memory_order_relaxed) == sequence)
+      return values;
+  }
+}
+
+}  // namespace electron
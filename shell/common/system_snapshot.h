@@ -0,0 +1,49 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SYSTEM_SNAPSHOT_H_
+#define SHELL_COMMON_SYSTEM_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace electron {
+
+// The values of nativeTheme and systemPreferences that the main process
+// publishes in shared memory, so that renderers can read them without IPC.
+struct SystemSnapshotValues {
+  enum Flags : uint32_t {
+    kShouldUseDarkColors = 1 << 0,
+    kShouldUseHighContrastColors = 1 << 1,
+    kShouldUseInvertedColorScheme = 1 << 2,
+    kHasAccentColor = 1 << 3,
+  };
+
+  uint32_t flags = 0;
+  // A ui::NativeTheme::ThemeSource.
+  uint32_t theme_source = 0;
+  // RGBA, valid with kHasAccentColor.
+  uint32_t accent_color = 0;
+};
+
+// Layout of the shared memory. The main process is the only writer, and the
+// sequence number tells readers whether they raced with an update.
+struct SystemSnapshotData {
+  // Odd while an update is being written.
+  std::atomic<uint32_t> sequence;
+  std::atomic<uint32_t> flags;
+  std::atomic<uint32_t> theme_source;
+  std::atomic<uint32_t> accent_color;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "The snapshot is shared between processes");
+
+void WriteSystemSnapshot(SystemSnapshotData* data,
+                         const SystemSnapshotValues& values);
+SystemSnapshotValues ReadSystemSnapshot(const SystemSnapshotData* data);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_SYSTEM_SNAPSHOT_H_
@@ -4,13 +4,12 @@
 
 #include "shell/common/v8_value_converter.h"
 
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
-#include <vector>
 
-#include "base/values.h"
+#include "base/containers/span.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
@@ -69,7 +68,8 @@ class V8ValueConverter::FromV8ValueState {
   bool HasReachedMaxRecursionDepth() { return max_recursion_depth_ < 0; }
 
  private:
-  using HashToHandleMap = std::multimap<int, v8::Local<v8::Object>>;
+  using HashToHandleMap =
+      std::unordered_multimap<int, v8::Local<v8::Object>>;
   using Iterator = HashToHandleMap::const_iterator;
 
   Iterator GetIteratorInMap(v8::Local<v8::Object> handle, int* hash) {
@@ -114,7 +114,6 @@ class V8ValueConverter::ScopedUniquenessGuard {
   bool is_valid() const { return is_valid_; }
 
  private:
-  typedef std::multimap<int, v8::Local<v8::Object>> HashToHandleMap;
   V8ValueConverter::FromV8ValueState* state_;
   v8::Local<v8::Object> value_;
   bool is_valid_;
@@ -150,7 +149,11 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Value(
   v8::Context::Scope context_scope(context);
   v8::HandleScope handle_scope(context->GetIsolate());
   FromV8ValueState state;
-  return FromV8ValueImpl(&state, val, context->GetIsolate());
+  base::Optional<base::Value> result =
+      FromV8ValueImpl(&state, val, context->GetIsolate());
+  if (!result)
+    return nullptr;
+  return base::Value::ToUniquePtrValue(std::move(*result));
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
@@ -204,16 +207,13 @@ v8::Local<v8::Value> V8ValueConverter::ToV8Array(
   v8::Local<v8::Array> result(v8::Array::New(isolate, val->GetSize()));
   auto context = isolate->GetCurrentContext();
 
-  for (size_t i = 0; i < val->GetSize(); ++i) {
-    const base::Value* child = nullptr;
-    val->Get(i, &child);
-
-    v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, child);
-
-    v8::TryCatch try_catch(isolate);
-    result->Set(context, static_cast<uint32_t>(i), child_v8).Check();
-    if (try_catch.HasCaught())
-      LOG(ERROR) << "Setter for index " << i << " threw an exception.";
+  uint32_t index = 0;
+  for (const base::Value& child : val->GetList()) {
+    v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, &child);
+    // The array is new, so defining its elements runs no setter.
+    if (result->CreateDataProperty(context, index, child_v8).IsNothing())
+      LOG(ERROR) << "Failed to set index " << index << ".";
+    ++index;
   }
 
   return result;
@@ -224,21 +224,23 @@ v8::Local<v8::Value> V8ValueConverter::ToV8Object(
     const base::DictionaryValue* val) const {
   gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
   result.SetHidden("simple", true);
+  v8::Local<v8::Object> object = result.GetHandle();
+  auto context = isolate->GetCurrentContext();
 
   for (base::DictionaryValue::Iterator iter(*val); !iter.IsAtEnd();
        iter.Advance()) {
     const std::string& key = iter.key();
     v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, &iter.value());
-
-    v8::TryCatch try_catch(isolate);
-    result.Set(key, child_v8);
-    if (try_catch.HasCaught()) {
-      LOG(ERROR) << "Setter for property " << key.c_str() << " threw an "
-                 << "exception.";
+    // Like for arrays, no setter of Object.prototype is run.
+    if (object
+            ->CreateDataProperty(context, gin::StringToV8(isolate, key),
+                                 child_v8)
+            .IsNothing()) {
+      LOG(ERROR) << "Failed to set property " << key << ".";
     }
   }
 
-  return result.GetHandle();
+  return object;
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToArrayBuffer(
@@ -288,43 +290,43 @@ v8::Local<v8::Value> V8ValueConverter::ToArrayBuffer(
   return v8::Uint8Array::New(array_buffer, 0, length);
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
+base::Optional<base::Value> V8ValueConverter::FromV8ValueImpl(
     FromV8ValueState* state,
     v8::Local<v8::Value> val,
     v8::Isolate* isolate) const {
   FromV8ValueState::Level state_level(state);
   if (state->HasReachedMaxRecursionDepth())
-    return nullptr;
+    return base::nullopt;
 
   if (val->IsExternal())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   if (val->IsNull())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   auto context = isolate->GetCurrentContext();
 
   if (val->IsBoolean())
-    return std::make_unique<base::Value>(val->ToBoolean(isolate)->Value());
+    return base::Value(val->ToBoolean(isolate)->Value());
 
   if (val->IsInt32())
-    return std::make_unique<base::Value>(val.As<v8::Int32>()->Value());
+    return base::Value(val.As<v8::Int32>()->Value());
 
   if (val->IsNumber()) {
     double val_as_double = val.As<v8::Number>()->Value();
     if (!std::isfinite(val_as_double))
-      return nullptr;
-    return std::make_unique<base::Value>(val_as_double);
+      return base::nullopt;
+    return base::Value(val_as_double);
   }
 
   if (val->IsString()) {
     v8::String::Utf8Value utf8(isolate, val);
-    return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
+    return base::Value(std::string(*utf8, utf8.length()));
   }
 
   if (val->IsUndefined())
     // JSON.stringify ignores undefined.
-    return nullptr;
+    return base::nullopt;
 
   if (val->IsDate()) {
     v8::Date* date = v8::Date::Cast(*val);
@@ -338,7 +340,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
           toISOString.As<v8::Function>()->Call(context, val, 0, nullptr);
       if (!result.IsEmpty()) {
         v8::String::Utf8Value utf8(isolate, result.ToLocalChecked());
-        return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
+        return base::Value(std::string(*utf8, utf8.length()));
       }
     }
   }
@@ -347,7 +349,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
     if (!reg_exp_allowed_)
       // JSON.stringify converts to an object.
       return FromV8Object(val.As<v8::Object>(), state, isolate);
-    return std::make_unique<base::Value>(*v8::String::Utf8Value(isolate, val));
+    return base::Value(*v8::String::Utf8Value(isolate, val));
   }
 
   // v8::Value doesn't have a ToArray() method for some reason.
@@ -357,7 +359,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
   if (val->IsFunction()) {
     if (!function_allowed_)
       // JSON.stringify refuses to convert function(){}.
-      return nullptr;
+      return base::nullopt;
     return FromV8Object(val.As<v8::Object>(), state, isolate);
   }
 
@@ -370,16 +372,16 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
   }
 
   LOG(ERROR) << "Unexpected v8 value type encountered.";
-  return nullptr;
+  return base::nullopt;
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
+base::Optional<base::Value> V8ValueConverter::FromV8Array(
     v8::Local<v8::Array> val,
     FromV8ValueState* state,
     v8::Isolate* isolate) const {
   ScopedUniquenessGuard uniqueness_guard(state, val);
   if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   std::unique_ptr<v8::Context::Scope> scope;
   // If val was created in a different context than our current one, change to
@@ -388,10 +390,12 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
       val->CreationContext() != isolate->GetCurrentContext())
     scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
 
-  std::unique_ptr<base::ListValue> result(new base::ListValue());
+  uint32_t length = val->Length();
+  base::Value::ListStorage result;
+  result.reserve(length);
 
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
+  for (uint32_t i = 0; i < length; ++i) {
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8;
     v8::MaybeLocal<v8::Value> maybe_child =
@@ -403,39 +407,39 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
 
     if (!val->HasRealIndexedProperty(isolate->GetCurrentContext(), i)
              .FromMaybe(false)) {
-      result->Append(std::make_unique<base::Value>());
+      result.emplace_back();
       continue;
     }
 
-    std::unique_ptr<base::Value> child =
+    base::Optional<base::Value> child =
         FromV8ValueImpl(state, child_v8, isolate);
     if (child)
-      result->Append(std::move(child));
+      result.push_back(std::move(*child));
     else
       // JSON.stringify puts null in places where values don't serialize, for
       // example undefined and functions. Emulate that behavior.
-      result->Append(std::make_unique<base::Value>());
+      result.emplace_back();
   }
-  return std::move(result);
+  return base::Value(std::move(result));
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromNodeBuffer(
+base::Optional<base::Value> V8ValueConverter::FromNodeBuffer(
     v8::Local<v8::Value> value,
     FromV8ValueState* state,
     v8::Isolate* isolate) const {
-  std::vector<char> buffer(
-      node::Buffer::Data(value),
-      node::Buffer::Data(value) + node::Buffer::Length(value));
-  return std::make_unique<base::Value>(std::move(buffer));
+  // Copied once into the blob of the value.
+  return base::Value(base::make_span(
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(value)),
+      node::Buffer::Length(value)));
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
+base::Optional<base::Value> V8ValueConverter::FromV8Object(
     v8::Local<v8::Object> val,
     FromV8ValueState* state,
     v8::Isolate* isolate) const {
   ScopedUniquenessGuard uniqueness_guard(state, val);
   if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   std::unique_ptr<v8::Context::Scope> scope;
   // If val was created in a different context than our current one, change to
@@ -444,11 +448,11 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
       val->CreationContext() != isolate->GetCurrentContext())
     scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
 
-  auto result = std::make_unique<base::DictionaryValue>();
+  base::Value result(base::Value::Type::DICTIONARY);
   v8::Local<v8::Array> property_names;
   if (!val->GetOwnPropertyNames(isolate->GetCurrentContext())
            .ToLocal(&property_names)) {
-    return std::move(result);
+    return result;
   }
 
   for (uint32_t i = 0; i < property_names->Length(); ++i) {
@@ -475,7 +479,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
       child_v8 = v8::Null(isolate);
     }
 
-    std::unique_ptr<base::Value> child =
+    base::Optional<base::Value> child =
         FromV8ValueImpl(state, child_v8, isolate);
     if (!child)
       // JSON.stringify skips properties whose values don't serialize, for
@@ -505,11 +509,11 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
     if (strip_null_from_objects_ && child->is_none())
       continue;
 
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    std::move(child));
+    result.SetKey(base::StringPiece(*name_utf8, name_utf8.length()),
+                  std::move(*child));
   }
 
-  return std::move(result);
+  return result;
 }
 
 }  // namespace electron
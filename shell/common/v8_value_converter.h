@@ -9,14 +9,10 @@
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "base/optional.h"
+#include "base/values.h"
 #include "v8/include/v8.h"
 
-namespace base {
-class DictionaryValue;
-class ListValue;
-class Value;
-}  // namespace base
-
 namespace electron {
 
 class V8ValueConverter {
@@ -46,18 +42,20 @@ class V8ValueConverter {
   v8::Local<v8::Value> ToArrayBuffer(v8::Isolate* isolate,
                                      const base::Value* value) const;
 
-  std::unique_ptr<base::Value> FromV8ValueImpl(FromV8ValueState* state,
-                                               v8::Local<v8::Value> value,
-                                               v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Array(v8::Local<v8::Array> array,
+  // The values are returned by value rather than allocated one by one, and
+  // are empty when they do not serialize.
+  base::Optional<base::Value> FromV8ValueImpl(FromV8ValueState* state,
+                                              v8::Local<v8::Value> value,
+                                              v8::Isolate* isolate) const;
+  base::Optional<base::Value> FromV8Array(v8::Local<v8::Array> array,
+                                          FromV8ValueState* state,
+                                          v8::Isolate* isolate) const;
+  base::Optional<base::Value> FromNodeBuffer(v8::Local<v8::Value> value,
+                                             FromV8ValueState* state,
+                                             v8::Isolate* isolate) const;
+  base::Optional<base::Value> FromV8Object(v8::Local<v8::Object> object,
                                            FromV8ValueState* state,
                                            v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromNodeBuffer(v8::Local<v8::Value> value,
-                                              FromV8ValueState* state,
-                                              v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Object(v8::Local<v8::Object> object,
-                                            FromV8ValueState* state,
-                                            v8::Isolate* isolate) const;
 
   // If true, we will convert RegExp JavaScript objects to string.
   bool reg_exp_allowed_ = false;
@@ -0,0 +1,150 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "gin/public/isolate_holder.h"
+#include "gin/test/v8_test.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/key_weak_map.h"
+#include "shell/common/perf_test_util.h"
+#include "shell/common/v8_value_converter.h"
+#include "shell/common/v8_value_serializer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace electron {
+
+namespace {
+
+// Something like the arguments of an IPC message: a dictionary of a few
+// scalars and a list of 100 small dictionaries.
+base::Value CreateTestValue() {
+  base::Value items(base::Value::Type::LIST);
+  for (int i = 0; i < 100; ++i) {
+    base::Value item(base::Value::Type::DICTIONARY);
+    item.SetIntKey("id", i);
+    item.SetStringKey("name", "item " + base::NumberToString(i));
+    item.SetBoolKey("enabled", i % 2 == 0);
+    item.SetDoubleKey("weight", i / 3.0);
+    items.Append(std::move(item));
+  }
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetStringKey("channel", "perf-test");
+  value.SetIntKey("count", 100);
+  value.SetKey("items", std::move(items));
+  return value;
+}
+
+class V8ValuePerfTest : public gin::V8Test {
+ protected:
+  v8::Isolate* isolate() { return instance_->isolate(); }
+  v8::Local<v8::Context> context() {
+    return v8::Local<v8::Context>::New(isolate(), context_);
+  }
+};
+
+}  // namespace
+
+TEST_F(V8ValuePerfTest, V8ValueConverterToV8) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  base::Value value = CreateTestValue();
+  V8ValueConverter converter;
+  MeasureRunsPerSecond("v8_value_converter", "to_v8", [&]() {
+    v8::HandleScope step_scope(isolate());
+    ASSERT_FALSE(converter.ToV8Value(&value, context()).IsEmpty());
+  });
+}
+
+TEST_F(V8ValuePerfTest, V8ValueConverterFromV8) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  base::Value value = CreateTestValue();
+  V8ValueConverter converter;
+  v8::Local<v8::Value> v8_value = converter.ToV8Value(&value, context());
+  MeasureRunsPerSecond("v8_value_converter", "from_v8", [&]() {
+    ASSERT_TRUE(converter.FromV8Value(v8_value, context()));
+  });
+}
+
+TEST_F(V8ValuePerfTest, SerializeV8Value) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  base::Value value = CreateTestValue();
+  v8::Local<v8::Value> v8_value = gin::ConvertToV8(isolate(), value);
+  MeasureRunsPerSecond("v8_value_serializer", "serialize", [&]() {
+    blink::CloneableMessage message;
+    ASSERT_TRUE(SerializeV8Value(isolate(), v8_value, &message));
+  });
+}
+
+TEST_F(V8ValuePerfTest, DeserializeV8Value) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  base::Value value = CreateTestValue();
+  blink::CloneableMessage message;
+  ASSERT_TRUE(SerializeV8Value(isolate(), gin::ConvertToV8(isolate(), value),
+                               &message));
+  MeasureRunsPerSecond("v8_value_serializer", "deserialize", [&]() {
+    v8::HandleScope step_scope(isolate());
+    ASSERT_FALSE(DeserializeV8Value(isolate(), message).IsEmpty());
+  });
+}
+
+TEST_F(V8ValuePerfTest, GinConvertStrings) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100; ++i)
+    strings.push_back("string " + base::NumberToString(i));
+  MeasureRunsPerSecond("gin_converter", "string_vector_round_trip", [&]() {
+    v8::HandleScope step_scope(isolate());
+    std::vector<std::string> out;
+    ASSERT_TRUE(gin::ConvertFromV8(
+        isolate(), gin::ConvertToV8(isolate(), strings), &out));
+  });
+}
+
+TEST_F(V8ValuePerfTest, GinConvertMap) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  std::map<std::string, std::string> map;
+  for (int i = 0; i < 100; ++i)
+    map["key " + base::NumberToString(i)] = "value";
+  MeasureRunsPerSecond("gin_converter", "string_map_round_trip", [&]() {
+    v8::HandleScope step_scope(isolate());
+    std::map<std::string, std::string> out;
+    ASSERT_TRUE(
+        gin::ConvertFromV8(isolate(), gin::ConvertToV8(isolate(), map), &out));
+  });
+}
+
+TEST_F(V8ValuePerfTest, KeyWeakMap) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(context());
+  std::vector<v8::Local<v8::Object>> objects;
+  for (int i = 0; i < 1000; ++i)
+    objects.push_back(v8::Object::New(isolate()));
+  MeasureRunsPerSecond("key_weak_map", "set_get_remove_1000", [&]() {
+    KeyWeakMap<int32_t> map;
+    for (int32_t i = 0; i < 1000; ++i)
+      map.Set(isolate(), i, objects[i]);
+    for (int32_t i = 0; i < 1000; ++i) {
+      v8::HandleScope step_scope(isolate());
+      ASSERT_FALSE(map.Get(isolate(), i).IsEmpty());
+    }
+    for (int32_t i = 0; i < 1000; ++i)
+      map.Remove(i);
+  });
+}
+
+}  // namespace electron
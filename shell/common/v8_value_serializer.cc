@@ -4,17 +4,132 @@
 
 #include "shell/common/v8_value_serializer.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/memory/shared_memory_mapping.h"
 #include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "shell/common/fast_value_serializer.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
 namespace {
+
 const uint8_t kVersionTag = 0xFF;
+
+// Tries the fast encoding first, returns false if either it or the full
+// serializer failed, with an exception pending.
+bool SerializeWithFastPath(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    blink::CloneableMessage* out,
+    bool* serialized,
+    size_t max_array_buffer_size = std::numeric_limits<size_t>::max()) {
+  std::vector<uint8_t> data;
+  switch (
+      FastSerializeV8Value(isolate, value, &data, max_array_buffer_size)) {
+    case FastSerializeResult::kSerialized:
+      out->owned_encoded_message = std::move(data);
+      out->encoded_message = out->owned_encoded_message;
+      *serialized = true;
+      return true;
+    case FastSerializeResult::kFailed:
+      return false;
+    case FastSerializeResult::kUnsupported:
+      *serialized = false;
+      return true;
+  }
+  NOTREACHED();
+  return false;
+}
+
+v8::Local<v8::Value> DeserializeFastPath(v8::Isolate* isolate,
+                                         base::span<const uint8_t> data) {
+  v8::Local<v8::Value> value = FastDeserializeV8Value(isolate, data);
+  if (value.IsEmpty())
+    return v8::Null(isolate);
+  return value;
+}
+
+// How deep arrays nested in the arguments are looked into for large
+// ArrayBuffers, results like lists of files are usually one level down.
+const int kMaxNestedArrayDepth = 3;
+
+// Arrays with more elements than this are not looked into, they are rarely
+// lists of buffers.
+const uint32_t kMaxLookedUpArrayElements = 1 << 12;
+
+// Calls |callback| with the ArrayBuffers at least kLargeArrayBufferThreshold
+// large among the elements of |value| and of the arrays nested in it. Only
+// the data elements of arrays are looked at: elements with getters are
+// skipped so that getters only run when the value is serialized, and holes
+// are skipped by only visiting the indices the array has. Returns false if
+// an element could not be read, with an exception pending.
+template <typename Callback>
+bool ForEachLargeArrayBuffer(v8::Local<v8::Context> context,
+                             v8::Local<v8::Value> value,
+                             const Callback& callback,
+                             int depth = 0) {
+  if (!value->IsArray() || depth > kMaxNestedArrayDepth)
+    return true;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Array> array = value.As<v8::Array>();
+  v8::Local<v8::Array> keys;
+  if (!array
+           ->GetPropertyNames(context, v8::KeyCollectionMode::kOwnOnly,
+                              static_cast<v8::PropertyFilter>(
+                                  v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                              v8::IndexFilter::kIncludeIndices,
+                              v8::KeyConversionMode::kKeepNumbers)
+           .ToLocal(&keys))
+    return false;
+  if (keys->Length() > kMaxLookedUpArrayElements)
+    return true;
+  v8::Local<v8::String> value_key = gin::StringToV8(isolate, "value");
+  for (uint32_t i = 0; i < keys->Length(); ++i) {
+    v8::Local<v8::Value> key;
+    v8::Local<v8::String> name;
+    if (!keys->Get(context, i).ToLocal(&key))
+      return false;
+    // Named properties come after the indices.
+    if (!key->IsUint32())
+      break;
+    v8::Local<v8::Value> descriptor;
+    if (!key->ToString(context).ToLocal(&name) ||
+        !array->GetOwnPropertyDescriptor(context, name).ToLocal(&descriptor))
+      return false;
+    if (!descriptor->IsObject())
+      continue;
+    // Undefined for accessors, whose descriptor has no value.
+    v8::Local<v8::Value> element;
+    if (!descriptor.As<v8::Object>()->Get(context, value_key).ToLocal(&element))
+      return false;
+    v8::Local<v8::ArrayBuffer> buffer;
+    if (element->IsArrayBuffer()) {
+      buffer = element.As<v8::ArrayBuffer>();
+    } else if (element->IsArrayBufferView()) {
+      buffer = element.As<v8::ArrayBufferView>()->Buffer();
+    } else {
+      if (!ForEachLargeArrayBuffer(context, element, callback, depth + 1))
+        return false;
+      continue;
+    }
+    if (buffer->ByteLength() >= kLargeArrayBufferThreshold)
+      callback(buffer);
+  }
+  return true;
+}
+
 }  // namespace
 
 class V8Serializer : public v8::ValueSerializer::Delegate {
@@ -23,24 +138,56 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
       : isolate_(isolate), serializer_(isolate, this) {}
   ~V8Serializer() override = default;
 
-  bool Serialize(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
+  bool Serialize(v8::Local<v8::Value> value,
+                 blink::CloneableMessage* out,
+                 std::vector<base::ReadOnlySharedMemoryRegion>* array_buffers =
+                     nullptr) {
     WriteBlinkEnvelope(19);
 
     serializer_.WriteHeader();
-    bool wrote_value;
-    if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
-             .To(&wrote_value)) {
-      isolate_->ThrowException(v8::Exception::Error(
-          gin::StringToV8(isolate_, "An object could not be cloned.")));
+    if (array_buffers && !TransferLargeArrayBuffers(value, array_buffers))
       return false;
+
+    return WriteValue(value, out);
+  }
+
+  bool Serialize(v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::ArrayBuffer>>& transfer,
+                 blink::TransferableMessage* out) {
+    WriteBlinkEnvelope(19);
+
+    serializer_.WriteHeader();
+    for (size_t i = 0; i < transfer.size(); ++i) {
+      if (!transfer[i]->IsDetachable()) {
+        ThrowDataCloneError(gin::StringToV8(
+            isolate_, "An ArrayBuffer is not detachable and could not be "
+                      "transferred."));
+        return false;
+      }
+      if (std::find(transfer.begin(), transfer.begin() + i, transfer[i]) !=
+          transfer.begin() + i) {
+        ThrowDataCloneError(gin::StringToV8(
+            isolate_, "ArrayBuffer at index " + std::to_string(i) +
+                          " is a duplicate of an earlier ArrayBuffer."));
+        return false;
+      }
+      serializer_.TransferArrayBuffer(i, transfer[i]);
     }
-    DCHECK(wrote_value);
 
-    std::pair<uint8_t*, size_t> buffer = serializer_.Release();
-    DCHECK_EQ(buffer.first, data_.data());
-    out->encoded_message = base::make_span(buffer.first, buffer.second);
-    out->owned_encoded_message = std::move(data_);
+    if (!WriteValue(value, out))
+      return false;
 
+    // The buffers are only detached once the value is known to be
+    // serializable, so a failed postMessage leaves them usable. BigBuffer can't
+    // adopt memory it didn't allocate, so their contents are copied into it.
+    out->array_buffer_contents_array.reserve(transfer.size());
+    for (const auto& buffer : transfer) {
+      auto backing_store = buffer->GetBackingStore();
+      out->array_buffer_contents_array.emplace_back(base::make_span(
+          static_cast<const uint8_t*>(backing_store->Data()),
+          backing_store->ByteLength()));
+      buffer->Detach();
+    }
     return true;
   }
 
@@ -66,6 +213,53 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
  private:
   void WriteTag(uint8_t tag) { serializer_.WriteRawBytes(&tag, 1); }
 
+  bool WriteValue(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
+    bool wrote_value;
+    if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
+             .To(&wrote_value)) {
+      isolate_->ThrowException(v8::Exception::Error(
+          gin::StringToV8(isolate_, "An object could not be cloned.")));
+      return false;
+    }
+    DCHECK(wrote_value);
+
+    std::pair<uint8_t*, size_t> buffer = serializer_.Release();
+    DCHECK_EQ(buffer.first, data_.data());
+    out->encoded_message = base::make_span(buffer.first, buffer.second);
+    out->owned_encoded_message = std::move(data_);
+
+    return true;
+  }
+
+  // Copies the large ArrayBuffers in |value| into shared memory, and has the
+  // serializer write references to them instead of their contents.
+  bool TransferLargeArrayBuffers(
+      v8::Local<v8::Value> value,
+      std::vector<base::ReadOnlySharedMemoryRegion>* array_buffers) {
+    std::vector<v8::Local<v8::ArrayBuffer>> transferred;
+    return ForEachLargeArrayBuffer(
+        isolate_->GetCurrentContext(), value,
+        [&](v8::Local<v8::ArrayBuffer> buffer) {
+          if (std::find(transferred.begin(), transferred.end(), buffer) !=
+              transferred.end())
+            return;
+
+          auto backing_store = buffer->GetBackingStore();
+          base::MappedReadOnlyRegion region =
+              base::ReadOnlySharedMemoryRegion::Create(
+                  backing_store->ByteLength());
+          if (!region.IsValid()) {
+            // Leave it to be copied into the message.
+            return;
+          }
+          memcpy(region.mapping.memory(), backing_store->Data(),
+                 backing_store->ByteLength());
+          serializer_.TransferArrayBuffer(array_buffers->size(), buffer);
+          array_buffers->push_back(std::move(region.region));
+          transferred.push_back(buffer);
+        });
+  }
+
   void WriteBlinkEnvelope(uint32_t blink_version) {
     // Write a dummy blink version envelope for compatibility with
     // blink::V8ScriptValueSerializer
@@ -86,7 +280,11 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
   V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
       : V8Deserializer(isolate, message.encoded_message) {}
 
-  v8::Local<v8::Value> Deserialize() {
+  v8::Local<v8::Value> Deserialize(
+      const std::vector<base::ReadOnlySharedMemoryRegion>* array_buffers =
+          nullptr,
+      std::vector<mojo_base::BigBuffer>* transferred_array_buffers = nullptr,
+      bool wrap_shared_memory = false) {
     v8::EscapableHandleScope scope(isolate_);
     auto context = isolate_->GetCurrentContext();
 
@@ -98,6 +296,11 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     if (!deserializer_.ReadHeader(context).To(&read_header))
       return v8::Null(isolate_);
     DCHECK(read_header);
+    if (array_buffers && !AdoptArrayBuffers(*array_buffers))
+      return v8::Null(isolate_);
+    if (transferred_array_buffers)
+      AdoptTransferredArrayBuffers(transferred_array_buffers,
+                                   wrap_shared_memory);
     v8::Local<v8::Value> value;
     if (!deserializer_.ReadValue(context).ToLocal(&value))
       return v8::Null(isolate_);
@@ -113,6 +316,54 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     return true;
   }
 
+  // The regions are read-only, while the ArrayBuffers handed to JavaScript are
+  // writable, so each one is copied once straight out of its mapping.
+  bool AdoptArrayBuffers(
+      const std::vector<base::ReadOnlySharedMemoryRegion>& array_buffers) {
+    for (size_t i = 0; i < array_buffers.size(); ++i) {
+      base::ReadOnlySharedMemoryMapping mapping = array_buffers[i].Map();
+      if (!mapping.IsValid())
+        return false;
+      v8::Local<v8::ArrayBuffer> buffer =
+          v8::ArrayBuffer::New(isolate_, mapping.size());
+      memcpy(buffer->GetBackingStore()->Data(), mapping.memory(),
+             mapping.size());
+      deserializer_.TransferArrayBuffer(i, buffer);
+    }
+    return true;
+  }
+
+  // Contents held in memory of this process are handed over to the
+  // ArrayBuffers without copying, those in shared memory are copied unless
+  // |wrap_shared_memory| says nobody else can write to them.
+  void AdoptTransferredArrayBuffers(std::vector<mojo_base::BigBuffer>* contents,
+                                    bool wrap_shared_memory) {
+    for (size_t i = 0; i < contents->size(); ++i) {
+      mojo_base::BigBuffer& content = (*contents)[i];
+      v8::Local<v8::ArrayBuffer> buffer;
+      if (content.size() == 0 ||
+          (content.storage_type() ==
+               mojo_base::BigBuffer::StorageType::kSharedMemory &&
+           !wrap_shared_memory)) {
+        buffer = v8::ArrayBuffer::New(isolate_, content.size());
+        if (content.size())
+          memcpy(buffer->GetBackingStore()->Data(), content.data(),
+                 content.size());
+      } else {
+        auto* holder = new mojo_base::BigBuffer(std::move(content));
+        std::shared_ptr<v8::BackingStore> backing_store =
+            v8::ArrayBuffer::NewBackingStore(
+                holder->data(), holder->size(),
+                [](void*, size_t, void* deleter_data) {
+                  delete static_cast<mojo_base::BigBuffer*>(deleter_data);
+                },
+                holder);
+        buffer = v8::ArrayBuffer::New(isolate_, std::move(backing_store));
+      }
+      deserializer_.TransferArrayBuffer(i, buffer);
+    }
+  }
+
   bool ReadBlinkEnvelope(uint32_t* blink_version) {
     // Read a dummy blink version envelope for compatibility with
     // blink::V8ScriptValueDeserializer
@@ -128,20 +379,72 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
   v8::ValueDeserializer deserializer_;
 };
 
+SerializedValue::SerializedValue() = default;
+SerializedValue::SerializedValue(
+    blink::CloneableMessage message,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers)
+    : message(std::move(message)), array_buffers(std::move(array_buffers)) {}
+SerializedValue::SerializedValue(SerializedValue&&) = default;
+SerializedValue& SerializedValue::operator=(SerializedValue&&) = default;
+SerializedValue::~SerializedValue() = default;
+
 bool SerializeV8Value(v8::Isolate* isolate,
                       v8::Local<v8::Value> value,
                       blink::CloneableMessage* out) {
-  return V8Serializer(isolate).Serialize(value, out);
+  bool serialized;
+  if (!SerializeWithFastPath(isolate, value, out, &serialized))
+    return false;
+  return serialized || V8Serializer(isolate).Serialize(value, out);
+}
+
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      SerializedValue* out) {
+  // The fast encoding gives up on the large ArrayBuffers the full serializer
+  // moves to shared memory, wherever they are in |value|.
+  bool serialized;
+  if (!SerializeWithFastPath(isolate, value, &out->message, &serialized,
+                             kLargeArrayBufferThreshold))
+    return false;
+  if (serialized)
+    return true;
+  return V8Serializer(isolate).Serialize(value, &out->message,
+                                         &out->array_buffers);
 }
 
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         const blink::CloneableMessage& in) {
+  if (IsFastSerializedValue(in.encoded_message))
+    return DeserializeFastPath(isolate, in.encoded_message);
   return V8Deserializer(isolate, in).Deserialize();
 }
 
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const SerializedValue& in) {
+  if (IsFastSerializedValue(in.message.encoded_message))
+    return DeserializeFastPath(isolate, in.message.encoded_message);
+  return V8Deserializer(isolate, in.message).Deserialize(&in.array_buffers);
+}
+
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data) {
+  if (IsFastSerializedValue(data))
+    return DeserializeFastPath(isolate, data);
   return V8Deserializer(isolate, data).Deserialize();
 }
 
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      const std::vector<v8::Local<v8::ArrayBuffer>>& transfer,
+                      blink::TransferableMessage* out) {
+  return V8Serializer(isolate).Serialize(value, transfer, out);
+}
+
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        blink::TransferableMessage* in,
+                                        bool wrap_shared_memory) {
+  return V8Deserializer(isolate, *in).Deserialize(
+      nullptr, &in->array_buffer_contents_array, wrap_shared_memory);
+}
+
 }  // namespace electron
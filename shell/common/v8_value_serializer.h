@@ -5,21 +5,58 @@
 #ifndef SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 #define SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 
+#include <vector>
+
 #include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+
+namespace blink {
+struct TransferableMessage;
+}  // namespace blink
 
 namespace v8 {
+class ArrayBuffer;
 class Isolate;
 template <class T>
 class Local;
 class Value;
 }  // namespace v8
 
-namespace blink {
-struct CloneableMessage;
-}
-
 namespace electron {
 
+// ArrayBuffers at least this large that are passed as IPC arguments, directly
+// or in nested arrays, are not copied into the encoded message, each one is
+// copied into its own shared memory region instead. This saves copying them
+// into the message buffer as it grows, and copying them out of it again on
+// the other side.
+constexpr size_t kLargeArrayBufferThreshold = 1024 * 1024;
+
+// A serialized value, with the large ArrayBuffers it references in the order
+// they are referenced.
+struct SerializedValue {
+  SerializedValue();
+  SerializedValue(blink::CloneableMessage message,
+                  std::vector<base::ReadOnlySharedMemoryRegion> array_buffers);
+  SerializedValue(SerializedValue&&);
+  SerializedValue& operator=(SerializedValue&&);
+  ~SerializedValue();
+
+  blink::CloneableMessage message;
+  std::vector<base::ReadOnlySharedMemoryRegion> array_buffers;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializedValue);
+};
+
+// Like SerializeV8Value(), but moves the large ArrayBuffers among the
+// elements of |value| and of its nested arrays out of the encoded message.
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      SerializedValue* out);
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const SerializedValue& in);
+
 bool SerializeV8Value(v8::Isolate* isolate,
                       v8::Local<v8::Value> value,
                       blink::CloneableMessage* out);
@@ -28,6 +65,23 @@ v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data);
 
+// Like SerializeV8Value(), but the ArrayBuffers in |transfer| are transferred
+// instead of cloned: their contents are copied once into buffers of their own
+// next to the message, in shared memory when they are large, rather than into
+// the encoded message, and they are detached. Throws a DataCloneError if one
+// of them can not be transferred.
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      const std::vector<v8::Local<v8::ArrayBuffer>>& transfer,
+                      blink::TransferableMessage* out);
+// Deserializes a message with transferred ArrayBuffers, taking their contents
+// out of |in|. Contents received in shared memory are only used in place when
+// |wrap_shared_memory| is true, which must be limited to trusted senders as
+// the sender could otherwise keep writing to them, and are copied otherwise.
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        blink::TransferableMessage* in,
+                                        bool wrap_shared_memory);
+
 }  // namespace electron
 
 #endif  // SHELL_COMMON_V8_VALUE_SERIALIZER_H_
@@ -4,58 +4,72 @@
 
 #include "shell/renderer/api/context_bridge/object_cache.h"
 
+#include <algorithm>
 #include <utility>
 
-#include "shell/common/api/remote/object_life_monitor.h"
-
 namespace electron {
 
 namespace api {
 
 namespace context_bridge {
 
-ObjectCachePairNode::ObjectCachePairNode(ObjectCachePair&& pair) {
-  this->pair = std::move(pair);
-}
+namespace {
+
+constexpr size_t kInitialCapacity = 16;
 
-ObjectCachePairNode::~ObjectCachePairNode() = default;
+}  // namespace
 
 ObjectCache::ObjectCache() {}
 ObjectCache::~ObjectCache() = default;
 
 void ObjectCache::CacheProxiedObject(v8::Local<v8::Value> from,
                                      v8::Local<v8::Value> proxy_value) {
-  if (from->IsObject() && !from->IsNullOrUndefined()) {
-    auto obj = v8::Local<v8::Object>::Cast(from);
-    int hash = obj->GetIdentityHash();
-
-    auto* node = new ObjectCachePairNode(std::make_pair(from, proxy_value));
-    proxy_map_[hash].Append(node);
-  }
+  if (!from->IsObject() || from->IsNullOrUndefined())
+    return;
+
+  if ((size_ + 1) * 2 > entries_.size())
+    Grow();
+  int hash = v8::Local<v8::Object>::Cast(from)->GetIdentityHash();
+  Entry& entry = entries_[FindSlot(from, hash)];
+  // The first value cached for an object is the one handed out.
+  if (!entry.from.IsEmpty())
+    return;
+  entry.hash = hash;
+  entry.from = from;
+  entry.proxy_value = proxy_value;
+  size_++;
 }
 
 v8::MaybeLocal<v8::Value> ObjectCache::GetCachedProxiedObject(
     v8::Local<v8::Value> from) const {
-  if (!from->IsObject() || from->IsNullOrUndefined())
+  if (entries_.empty() || !from->IsObject() || from->IsNullOrUndefined())
     return v8::MaybeLocal<v8::Value>();
 
-  auto obj = v8::Local<v8::Object>::Cast(from);
-  int hash = obj->GetIdentityHash();
-  auto iter = proxy_map_.find(hash);
-  if (iter == proxy_map_.end())
+  int hash = v8::Local<v8::Object>::Cast(from)->GetIdentityHash();
+  const Entry& entry = entries_[FindSlot(from, hash)];
+  if (entry.from.IsEmpty() || entry.proxy_value.IsEmpty())
     return v8::MaybeLocal<v8::Value>();
+  return entry.proxy_value;
+}
+
+size_t ObjectCache::FindSlot(v8::Local<v8::Value> from, int hash) const {
+  // Identity hashes are random, their low bits are used as is.
+  size_t mask = entries_.size() - 1;
+  for (size_t i = static_cast<uint32_t>(hash) & mask;; i = (i + 1) & mask) {
+    const Entry& entry = entries_[i];
+    if (entry.from.IsEmpty() || (entry.hash == hash && entry.from == from))
+      return i;
+  }
+}
 
-  auto& list = iter->second;
-  for (auto* node = list.head(); node != list.end(); node = node->next()) {
-    auto& pair = node->value()->pair;
-    auto from_cmp = pair.first;
-    if (from_cmp == from) {
-      if (pair.second.IsEmpty())
-        return v8::MaybeLocal<v8::Value>();
-      return pair.second;
-    }
+void ObjectCache::Grow() {
+  std::vector<Entry> old_entries(std::max(kInitialCapacity,
+                                          entries_.size() * 2));
+  entries_.swap(old_entries);
+  for (Entry& entry : old_entries) {
+    if (!entry.from.IsEmpty())
+      entries_[FindSlot(entry.from, entry.hash)] = std::move(entry);
   }
-  return v8::MaybeLocal<v8::Value>();
 }
 
 }  // namespace context_bridge
@@ -5,14 +5,9 @@
 #ifndef SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 #define SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 
-#include <map>
-#include <utility>
+#include <vector>
 
-#include "base/containers/linked_list.h"
-#include "content/public/renderer/render_frame.h"
-#include "content/public/renderer/render_frame_observer.h"
-#include "shell/renderer/electron_render_frame_observer.h"
-#include "third_party/blink/public/web/web_local_frame.h"
+#include "v8/include/v8.h"
 
 namespace electron {
 
@@ -20,15 +15,9 @@ namespace api {
 
 namespace context_bridge {
 
-using ObjectCachePair = std::pair<v8::Local<v8::Value>, v8::Local<v8::Value>>;
-
-struct ObjectCachePairNode : public base::LinkNode<ObjectCachePairNode> {
-  explicit ObjectCachePairNode(ObjectCachePair&& pair);
-  ~ObjectCachePairNode();
-
-  ObjectCachePair pair;
-};
-
+// Maps the objects passed during a single PassValueToOtherContext() call to
+// the values created for them in the other context, so that shared and cyclic
+// references keep their structure.
 class ObjectCache final {
  public:
   ObjectCache();
@@ -40,8 +29,20 @@ class ObjectCache final {
       v8::Local<v8::Value> from) const;
 
  private:
-  // object_identity ==> [from_value, proxy_value]
-  std::map<int, base::LinkedList<ObjectCachePairNode>> proxy_map_;
+  struct Entry {
+    int hash = 0;
+    v8::Local<v8::Value> from;
+    v8::Local<v8::Value> proxy_value;
+  };
+
+  // Returns the slot holding |from|, or the empty slot it would go in.
+  size_t FindSlot(v8::Local<v8::Value> from, int hash) const;
+  void Grow();
+
+  // Open addressing table keyed by the identity hash of |from|, with linear
+  // probing. The capacity is a power of two and at most half of it is used.
+  std::vector<Entry> entries_;
+  size_t size_ = 0;
 };
 
 }  // namespace context_bridge
@@ -0,0 +1,54 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/api/context_bridge/object_cache.h"
+
+#include <vector>
+
+#include "gin/public/isolate_holder.h"
+#include "gin/test/v8_test.h"
+#include "shell/common/perf_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace electron {
+
+namespace api {
+
+namespace context_bridge {
+
+namespace {
+
+class ObjectCachePerfTest : public gin::V8Test {
+ protected:
+  v8::Isolate* isolate() { return instance_->isolate(); }
+};
+
+}  // namespace
+
+// Like a contextBridge call passing an object graph of 1000 objects.
+TEST_F(ObjectCachePerfTest, CacheAndLookup) {
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(
+      v8::Local<v8::Context>::New(isolate(), context_));
+  std::vector<v8::Local<v8::Value>> objects;
+  for (int i = 0; i < 1000; ++i)
+    objects.push_back(v8::Object::New(isolate()));
+  auto cache_and_lookup = [&]() {
+    ObjectCache cache;
+    for (const auto& object : objects) {
+      if (cache.GetCachedProxiedObject(object).IsEmpty())
+        cache.CacheProxiedObject(object, object);
+    }
+    for (const auto& object : objects)
+      ASSERT_FALSE(cache.GetCachedProxiedObject(object).IsEmpty());
+  };
+  electron::MeasureRunsPerSecond("object_cache", "cache_and_lookup_1000",
+                                 cache_and_lookup);
+}
+
+}  // namespace context_bridge
+
+}  // namespace api
+
+}  // namespace electron
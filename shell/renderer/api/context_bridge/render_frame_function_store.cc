@@ -27,6 +27,61 @@ RenderFrameFunctionStore::RenderFrameFunctionStore(
 
 RenderFrameFunctionStore::~RenderFrameFunctionStore() = default;
 
+v8::MaybeLocal<v8::Value> RenderFrameFunctionStore::GetProxiedFunction(
+    v8::Isolate* isolate,
+    v8::Local<v8::Function> func,
+    v8::Local<v8::Context> destination_context,
+    bool share_array_buffers) {
+  auto range = func_ids_by_hash_.equal_range(func->GetIdentityHash());
+  for (auto it = range.first; it != range.second; ++it) {
+    auto function = functions_.find(it->second);
+    auto proxy = proxies_.find(it->second);
+    if (function == functions_.end() || proxy == proxies_.end())
+      continue;
+    if (std::get<0>(function->second) != func ||
+        std::get<2>(function->second) != share_array_buffers ||
+        proxy->second.destination_context != destination_context)
+      continue;
+    v8::Local<v8::Value> value = proxy->second.proxy.Get(isolate);
+    if (!value.IsEmpty())
+      return value;
+  }
+  return v8::MaybeLocal<v8::Value>();
+}
+
+void RenderFrameFunctionStore::CacheProxiedFunction(
+    v8::Isolate* isolate,
+    size_t func_id,
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Value> proxy) {
+  auto function = functions_.find(func_id);
+  if (function == functions_.end())
+    return;
+  int hash = std::get<0>(function->second).Get(isolate)->GetIdentityHash();
+  FunctionProxy& entry = proxies_[func_id];
+  entry.hash = hash;
+  entry.destination_context.Reset(isolate, destination_context);
+  entry.destination_context.SetWeak();
+  entry.proxy.Reset(isolate, proxy);
+  entry.proxy.SetWeak();
+  func_ids_by_hash_.emplace(hash, func_id);
+}
+
+void RenderFrameFunctionStore::ReleaseFunction(size_t func_id) {
+  functions_.erase(func_id);
+  auto proxy = proxies_.find(func_id);
+  if (proxy == proxies_.end())
+    return;
+  auto range = func_ids_by_hash_.equal_range(proxy->second.hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == func_id) {
+      func_ids_by_hash_.erase(it);
+      break;
+    }
+  }
+  proxies_.erase(proxy);
+}
+
 void RenderFrameFunctionStore::OnDestruct() {
   GetStoreMap().erase(routing_id_);
   delete this;
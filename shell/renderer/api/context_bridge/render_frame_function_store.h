@@ -7,6 +7,7 @@
 
 #include <map>
 #include <tuple>
+#include <unordered_map>
 
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -19,8 +20,10 @@ namespace api {
 
 namespace context_bridge {
 
+// The function, its owning context, and whether the values passed through its
+// proxy share ArrayBuffers instead of copying them.
 using FunctionContextPair =
-    std::tuple<v8::Global<v8::Function>, v8::Global<v8::Context>>;
+    std::tuple<v8::Global<v8::Function>, v8::Global<v8::Context>, bool>;
 
 class RenderFrameFunctionStore final : public content::RenderFrameObserver {
  public:
@@ -34,13 +37,40 @@ class RenderFrameFunctionStore final : public content::RenderFrameObserver {
 
   std::map<size_t, FunctionContextPair>& functions() { return functions_; }
 
+  // Returns the proxy created for |func| in |destination_context| by an
+  // earlier call, so passing the same function again is cheap and gives the
+  // same proxy. Returns an empty handle if there is none alive.
+  v8::MaybeLocal<v8::Value> GetProxiedFunction(
+      v8::Isolate* isolate,
+      v8::Local<v8::Function> func,
+      v8::Local<v8::Context> destination_context,
+      bool share_array_buffers);
+  void CacheProxiedFunction(v8::Isolate* isolate,
+                            size_t func_id,
+                            v8::Local<v8::Context> destination_context,
+                            v8::Local<v8::Value> proxy);
+
+  // Called once the proxy of |func_id| was garbage collected.
+  void ReleaseFunction(size_t func_id);
+
   base::WeakPtr<RenderFrameFunctionStore> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
   }
 
  private:
-  // func_id ==> { function, owning_context }
+  // func_id ==> { function, owning_context, share_array_buffers }
   std::map<size_t, FunctionContextPair> functions_;
+
+  struct FunctionProxy {
+    int hash;
+    // Both handles are weak, the proxy owns the entry.
+    v8::Global<v8::Context> destination_context;
+    v8::Global<v8::Value> proxy;
+  };
+  // func_id ==> proxy in the destination context
+  std::map<size_t, FunctionProxy> proxies_;
+  // identity hash of the function ==> func_id
+  std::unordered_multimap<int, size_t> func_ids_by_hash_;
   size_t next_func_id_ = 1;
 
   const int32_t routing_id_;
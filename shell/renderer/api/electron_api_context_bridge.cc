@@ -12,6 +12,7 @@
 
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "shell/common/api/remote/object_life_monitor.h"
@@ -108,6 +109,77 @@ bool IsPlainArray(const v8::Local<v8::Value>& arr) {
   return !arr->IsTypedArray();
 }
 
+// Creates a view of the same type and range as |view| on |buffer|.
+v8::Local<v8::Value> CreateViewOnBuffer(v8::Local<v8::ArrayBufferView> view,
+                                        v8::Local<v8::ArrayBuffer> buffer) {
+  size_t offset = view->ByteOffset();
+  if (view->IsDataView())
+    return v8::DataView::New(buffer, offset, view->ByteLength());
+  size_t length = v8::Local<v8::TypedArray>::Cast(view)->Length();
+  if (view->IsInt8Array())
+    return v8::Int8Array::New(buffer, offset, length);
+  if (view->IsUint8ClampedArray())
+    return v8::Uint8ClampedArray::New(buffer, offset, length);
+  if (view->IsInt16Array())
+    return v8::Int16Array::New(buffer, offset, length);
+  if (view->IsUint16Array())
+    return v8::Uint16Array::New(buffer, offset, length);
+  if (view->IsInt32Array())
+    return v8::Int32Array::New(buffer, offset, length);
+  if (view->IsUint32Array())
+    return v8::Uint32Array::New(buffer, offset, length);
+  if (view->IsFloat32Array())
+    return v8::Float32Array::New(buffer, offset, length);
+  if (view->IsFloat64Array())
+    return v8::Float64Array::New(buffer, offset, length);
+  if (view->IsBigInt64Array())
+    return v8::BigInt64Array::New(buffer, offset, length);
+  if (view->IsBigUint64Array())
+    return v8::BigUint64Array::New(buffer, offset, length);
+  return v8::Uint8Array::New(buffer, offset, length);
+}
+
+// The data of a proxy function, holds the store and the ID of the function.
+enum ProxyFunctionData {
+  kProxyFunctionStore,
+  kProxyFunctionId,
+  kProxyFunctionDataLength,
+};
+
+void ProxyFunctionCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  auto data = v8::Local<v8::Array>::Cast(info.Data());
+  auto* store = static_cast<context_bridge::RenderFrameFunctionStore*>(
+      v8::Local<v8::External>::Cast(
+          data->Get(context, kProxyFunctionStore).ToLocalChecked())
+          ->Value());
+  auto func_id = static_cast<size_t>(
+      data->Get(context, kProxyFunctionId).ToLocalChecked().As<v8::Number>()
+          ->Value());
+  gin::Arguments gin_args(info);
+  v8::Local<v8::Value> result = ProxyFunctionWrapper(
+      store, func_id, static_cast<gin_helper::Arguments*>(&gin_args));
+  if (!result.IsEmpty())
+    info.GetReturnValue().Set(result);
+}
+
+// Creates the proxy of |func_id| without going through gin, whose callback
+// holders are much more expensive to create and to call.
+v8::MaybeLocal<v8::Function> CreateProxyFunction(
+    v8::Local<v8::Context> context,
+    context_bridge::RenderFrameFunctionStore* store,
+    size_t func_id) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Value> data[kProxyFunctionDataLength];
+  data[kProxyFunctionStore] = v8::External::New(isolate, store);
+  data[kProxyFunctionId] =
+      v8::Number::New(isolate, static_cast<double>(func_id));
+  return v8::Function::New(
+      context, &ProxyFunctionCallback,
+      v8::Array::New(isolate, data, kProxyFunctionDataLength));
+}
+
 class FunctionLifeMonitor final : public ObjectLifeMonitor {
  public:
   static void BindTo(
@@ -130,7 +202,7 @@ class FunctionLifeMonitor final : public ObjectLifeMonitor {
   void RunDestructor() override {
     if (!store_)
       return;
-    store_->functions().erase(func_id_);
+    store_->ReleaseFunction(func_id_);
   }
 
  private:
@@ -146,6 +218,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     v8::Local<v8::Value> value,
     context_bridge::RenderFrameFunctionStore* store,
     context_bridge::ObjectCache* object_cache,
+    bool share_array_buffers,
     int recursion_depth) {
   if (recursion_depth >= kMaxRecursion) {
     v8::Context::Scope source_scope(source_context);
@@ -158,6 +231,11 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
       return v8::MaybeLocal<v8::Value>();
     }
   }
+  // Primitives are not bound to a context and can be used as is, which saves
+  // a round trip through the serializer for the most common arguments.
+  if (value->IsPrimitive() && !value->IsSymbol())
+    return value;
+
   // Check Cache
   auto cached_value = object_cache->GetCachedProxiedObject(value);
   if (!cached_value.IsEmpty()) {
@@ -168,21 +246,35 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   // the global handle at the right time.
   if (value->IsFunction()) {
     auto func = v8::Local<v8::Function>::Cast(value);
+    v8::Local<v8::Value> proxied;
+    if (store
+            ->GetProxiedFunction(source_context->GetIsolate(), func,
+                                 destination_context, share_array_buffers)
+            .ToLocal(&proxied)) {
+      object_cache->CacheProxiedObject(value, proxied);
+      return proxied;
+    }
     v8::Global<v8::Function> global_func(source_context->GetIsolate(), func);
     v8::Global<v8::Context> global_source(source_context->GetIsolate(),
                                           source_context);
 
     size_t func_id = store->take_func_id();
     store->functions()[func_id] =
-        std::make_tuple(std::move(global_func), std::move(global_source));
+        std::make_tuple(std::move(global_func), std::move(global_source),
+                        share_array_buffers);
     v8::Context::Scope destination_scope(destination_context);
     {
-      v8::Local<v8::Value> proxy_func = gin_helper::CallbackToV8Leaked(
-          destination_context->GetIsolate(),
-          base::BindRepeating(&ProxyFunctionWrapper, store, func_id));
+      v8::Local<v8::Value> proxy_func;
+      if (!CreateProxyFunction(destination_context, store, func_id)
+               .ToLocal(&proxy_func)) {
+        store->ReleaseFunction(func_id);
+        return v8::MaybeLocal<v8::Value>();
+      }
       FunctionLifeMonitor::BindTo(destination_context->GetIsolate(),
                                   v8::Local<v8::Object>::Cast(proxy_func),
                                   store->GetWeakPtr(), func_id);
+      store->CacheProxiedFunction(destination_context->GetIsolate(), func_id,
+                                  destination_context, proxy_func);
       object_cache->CacheProxiedObject(value, proxy_func);
       return v8::MaybeLocal<v8::Value>(proxy_func);
     }
@@ -204,12 +296,12 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
              v8::Global<v8::Context> global_source_context,
              v8::Global<v8::Context> global_destination_context,
              context_bridge::RenderFrameFunctionStore* store,
-             v8::Local<v8::Value> result) {
+             bool share_array_buffers, v8::Local<v8::Value> result) {
             context_bridge::ObjectCache object_cache;
-            auto val =
-                PassValueToOtherContext(global_source_context.Get(isolate),
-                                        global_destination_context.Get(isolate),
-                                        result, store, &object_cache, 0);
+            auto val = PassValueToOtherContext(
+                global_source_context.Get(isolate),
+                global_destination_context.Get(isolate), result, store,
+                &object_cache, share_array_buffers, 0);
             if (!val.IsEmpty())
               proxied_promise->Resolve(val.ToLocalChecked());
             delete proxied_promise;
@@ -218,19 +310,19 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
           v8::Global<v8::Context>(source_context->GetIsolate(), source_context),
           v8::Global<v8::Context>(destination_context->GetIsolate(),
                                   destination_context),
-          store);
+          store, share_array_buffers);
       auto catch_cb = base::BindOnce(
           [](gin_helper::Promise<v8::Local<v8::Value>>* proxied_promise,
              v8::Isolate* isolate,
              v8::Global<v8::Context> global_source_context,
              v8::Global<v8::Context> global_destination_context,
              context_bridge::RenderFrameFunctionStore* store,
-             v8::Local<v8::Value> result) {
+             bool share_array_buffers, v8::Local<v8::Value> result) {
             context_bridge::ObjectCache object_cache;
-            auto val =
-                PassValueToOtherContext(global_source_context.Get(isolate),
-                                        global_destination_context.Get(isolate),
-                                        result, store, &object_cache, 0);
+            auto val = PassValueToOtherContext(
+                global_source_context.Get(isolate),
+                global_destination_context.Get(isolate), result, store,
+                &object_cache, share_array_buffers, 0);
             if (!val.IsEmpty())
               proxied_promise->Reject(val.ToLocalChecked());
             delete proxied_promise;
@@ -239,7 +331,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
           v8::Global<v8::Context>(source_context->GetIsolate(), source_context),
           v8::Global<v8::Context>(destination_context->GetIsolate(),
                                   destination_context),
-          store);
+          store, share_array_buffers);
 
       ignore_result(source_promise->Then(
           source_context,
@@ -262,6 +354,36 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
             ->Get()));
   }
 
+  // Both contexts live in the same isolate, so ArrayBuffers can share their
+  // backing store with the other context instead of being copied.
+  if (share_array_buffers && value->IsArrayBuffer()) {
+    v8::Context::Scope destination_context_scope(destination_context);
+    {
+      auto buffer = v8::Local<v8::ArrayBuffer>::Cast(value);
+      v8::Local<v8::ArrayBuffer> shared_buffer = v8::ArrayBuffer::New(
+          destination_context->GetIsolate(), buffer->GetBackingStore());
+      object_cache->CacheProxiedObject(value, shared_buffer);
+      return v8::MaybeLocal<v8::Value>(shared_buffer);
+    }
+  }
+
+  if (share_array_buffers && value->IsArrayBufferView()) {
+    auto view = v8::Local<v8::ArrayBufferView>::Cast(value);
+    auto passed_buffer = PassValueToOtherContext(
+        source_context, destination_context, view->Buffer(), store,
+        object_cache, share_array_buffers, recursion_depth + 1);
+    if (passed_buffer.IsEmpty())
+      return v8::MaybeLocal<v8::Value>();
+    v8::Context::Scope destination_context_scope(destination_context);
+    {
+      v8::Local<v8::Value> shared_view = CreateViewOnBuffer(
+          view, v8::Local<v8::ArrayBuffer>::Cast(
+                    passed_buffer.ToLocalChecked()));
+      object_cache->CacheProxiedObject(value, shared_view);
+      return v8::MaybeLocal<v8::Value>(shared_view);
+    }
+  }
+
   // Manually go through the array and pass each value individually into a new
   // array so that functions deep inside arrays get proxied or arrays of
   // promises are proxied correctly.
@@ -276,7 +398,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         auto value_for_array = PassValueToOtherContext(
             source_context, destination_context,
             arr->Get(source_context, i).ToLocalChecked(), store, object_cache,
-            recursion_depth + 1);
+            share_array_buffers, recursion_depth + 1);
         if (value_for_array.IsEmpty())
           return v8::MaybeLocal<v8::Value>();
 
@@ -295,7 +417,8 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     auto object_value = v8::Local<v8::Object>::Cast(value);
     auto passed_value =
         CreateProxyForAPI(object_value, source_context, destination_context,
-                          store, object_cache, recursion_depth + 1);
+                          store, object_cache, share_array_buffers,
+                          recursion_depth + 1);
     if (passed_value.IsEmpty())
       return v8::MaybeLocal<v8::Value>();
     return v8::MaybeLocal<v8::Value>(passed_value.ToLocalChecked());
@@ -325,25 +448,30 @@ v8::Local<v8::Value> ProxyFunctionWrapper(
     context_bridge::RenderFrameFunctionStore* store,
     size_t func_id,
     gin_helper::Arguments* args) {
+  TRACE_EVENT0("electron", "ContextBridge::ProxyFunctionWrapper");
   // Context the proxy function was called from
   v8::Local<v8::Context> calling_context = args->isolate()->GetCurrentContext();
+  auto it = store->functions().find(func_id);
+  if (it == store->functions().end())
+    return v8::Undefined(args->isolate());
   // Context the function was created in
   v8::Local<v8::Context> func_owning_context =
-      std::get<1>(store->functions()[func_id]).Get(args->isolate());
+      std::get<1>(it->second).Get(args->isolate());
+  bool share_array_buffers = std::get<2>(it->second);
 
   v8::Context::Scope func_owning_context_scope(func_owning_context);
   context_bridge::ObjectCache object_cache;
   {
-    v8::Local<v8::Function> func =
-        (std::get<0>(store->functions()[func_id])).Get(args->isolate());
+    v8::Local<v8::Function> func = std::get<0>(it->second).Get(args->isolate());
 
     std::vector<v8::Local<v8::Value>> original_args;
     std::vector<v8::Local<v8::Value>> proxied_args;
     args->GetRemaining(&original_args);
 
     for (auto value : original_args) {
-      auto arg = PassValueToOtherContext(calling_context, func_owning_context,
-                                         value, store, &object_cache, 0);
+      auto arg =
+          PassValueToOtherContext(calling_context, func_owning_context, value,
+                                  store, &object_cache, share_array_buffers, 0);
       if (arg.IsEmpty())
         return v8::Undefined(args->isolate());
       proxied_args.push_back(arg.ToLocalChecked());
@@ -381,9 +509,10 @@ v8::Local<v8::Value> ProxyFunctionWrapper(
     if (maybe_return_value.IsEmpty())
       return v8::Undefined(args->isolate());
 
-    auto ret = PassValueToOtherContext(func_owning_context, calling_context,
-                                       maybe_return_value.ToLocalChecked(),
-                                       store, &object_cache, 0);
+    auto ret = PassValueToOtherContext(
+        func_owning_context, calling_context,
+        maybe_return_value.ToLocalChecked(), store, &object_cache,
+        share_array_buffers, 0);
     if (ret.IsEmpty())
       return v8::Undefined(args->isolate());
     return ret.ToLocalChecked();
@@ -396,6 +525,7 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
     const v8::Local<v8::Context>& destination_context,
     context_bridge::RenderFrameFunctionStore* store,
     context_bridge::ObjectCache* object_cache,
+    bool share_array_buffers,
     int recursion_depth) {
   gin_helper::Dictionary api(source_context->GetIsolate(), api_object);
   gin_helper::Dictionary proxy =
@@ -426,7 +556,8 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
 
       auto passed_value =
           PassValueToOtherContext(source_context, destination_context, value,
-                                  store, object_cache, recursion_depth + 1);
+                                  store, object_cache, share_array_buffers,
+                                  recursion_depth + 1);
       if (passed_value.IsEmpty())
         return v8::MaybeLocal<v8::Object>();
       proxy.Set(key_str, passed_value.ToLocalChecked());
@@ -436,6 +567,126 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
   }
 }
 
+namespace {
+
+// The data of the lazy properties of a proxy.
+enum LazyPropertyData {
+  kLazyPropertySource,
+  kLazyPropertyStore,
+  kLazyPropertyShareArrayBuffers,
+  kLazyPropertyDataLength,
+};
+
+v8::MaybeLocal<v8::Object> CreateLazyProxyForAPI(
+    v8::Local<v8::Object> api_object,
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    context_bridge::RenderFrameFunctionStore* store,
+    bool share_array_buffers);
+
+// Passes the value of a property of the API object the first time it is read
+// from the proxy, V8 then replaces the property with the returned value.
+void LazyPropertyGetter(v8::Local<v8::Name> property,
+                        const v8::PropertyCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Context> destination_context =
+      info.Holder()->CreationContext();
+  auto data = v8::Local<v8::Array>::Cast(info.Data());
+  auto api_object = v8::Local<v8::Object>::Cast(
+      data->Get(destination_context, kLazyPropertySource).ToLocalChecked());
+  auto* store = static_cast<context_bridge::RenderFrameFunctionStore*>(
+      v8::Local<v8::External>::Cast(
+          data->Get(destination_context, kLazyPropertyStore)
+              .ToLocalChecked())
+          ->Value());
+  bool share_array_buffers =
+      data->Get(destination_context, kLazyPropertyShareArrayBuffers)
+          .ToLocalChecked()
+          ->IsTrue();
+  v8::Local<v8::Context> source_context = api_object->CreationContext();
+
+  v8::Local<v8::Value> value;
+  {
+    v8::Context::Scope source_context_scope(source_context);
+    if (!api_object->Get(source_context, property).ToLocal(&value))
+      return;
+  }
+
+  // Nested objects are materialized lazily too, everything else is passed
+  // and frozen like the values of an eagerly exposed API.
+  v8::Local<v8::Value> passed_value;
+  if (IsPlainObject(value)) {
+    v8::Local<v8::Object> passed_object;
+    if (!CreateLazyProxyForAPI(v8::Local<v8::Object>::Cast(value),
+                               source_context, destination_context, store,
+                               share_array_buffers)
+             .ToLocal(&passed_object))
+      return;
+    passed_value = passed_object;
+  } else {
+    context_bridge::ObjectCache object_cache;
+    if (!PassValueToOtherContext(source_context, destination_context, value,
+                                 store, &object_cache, share_array_buffers, 0)
+             .ToLocal(&passed_value))
+      return;
+    if (passed_value->IsObject() && !passed_value->IsTypedArray() &&
+        !DeepFreeze(v8::Local<v8::Object>::Cast(passed_value),
+                    destination_context))
+      return;
+  }
+  info.GetReturnValue().Set(passed_value);
+}
+
+// Creates a proxy for |api_object| whose properties are only passed to the
+// destination context when they are first read, so exposing a large API does
+// not cost more than listing its keys. The proxy is frozen.
+v8::MaybeLocal<v8::Object> CreateLazyProxyForAPI(
+    v8::Local<v8::Object> api_object,
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    context_bridge::RenderFrameFunctionStore* store,
+    bool share_array_buffers) {
+  v8::Isolate* isolate = destination_context->GetIsolate();
+  v8::Local<v8::Array> keys;
+  if (!api_object
+           ->GetOwnPropertyNames(source_context,
+                                 static_cast<v8::PropertyFilter>(
+                                     v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                 v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return v8::MaybeLocal<v8::Object>();
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  {
+    v8::Local<v8::Object> proxy = v8::Object::New(isolate);
+    v8::Local<v8::Value> data[kLazyPropertyDataLength];
+    data[kLazyPropertySource] = api_object;
+    data[kLazyPropertyStore] = v8::External::New(isolate, store);
+    data[kLazyPropertyShareArrayBuffers] =
+        v8::Boolean::New(isolate, share_array_buffers);
+    v8::Local<v8::Array> lazy_data =
+        v8::Array::New(isolate, data, kLazyPropertyDataLength);
+
+    uint32_t length = keys->Length();
+    for (uint32_t i = 0; i < length; i++) {
+      v8::Local<v8::Value> key =
+          keys->Get(destination_context, i).ToLocalChecked();
+      if (!key->IsString())
+        continue;
+      if (!IsTrue(proxy->SetLazyDataProperty(
+              destination_context, v8::Local<v8::Name>::Cast(key),
+              &LazyPropertyGetter, lazy_data,
+              static_cast<v8::PropertyAttribute>(v8::ReadOnly |
+                                                 v8::DontDelete))))
+        return v8::MaybeLocal<v8::Object>();
+    }
+    if (!IsTrue(proxy->PreventExtensions(destination_context)))
+      return v8::MaybeLocal<v8::Object>();
+    return proxy;
+  }
+}
+
+}  // namespace
+
 #ifdef DCHECK_IS_ON
 gin_helper::Dictionary DebugGC(gin_helper::Dictionary empty) {
   auto* render_frame = GetRenderFrame(empty.GetHandle());
@@ -449,6 +700,15 @@ gin_helper::Dictionary DebugGC(gin_helper::Dictionary empty) {
 void ExposeAPIInMainWorld(const std::string& key,
                           v8::Local<v8::Object> api_object,
                           gin_helper::Arguments* args) {
+  TRACE_EVENT1("electron", "ContextBridge::ExposeAPIInMainWorld", "key", key);
+  bool share_array_buffers = false;
+  bool lazy = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("shareArrayBuffers", &share_array_buffers);
+    options.Get("lazy", &lazy);
+  }
+
   auto* render_frame = GetRenderFrame(api_object);
   CHECK(render_frame);
   context_bridge::RenderFrameFunctionStore* store =
@@ -472,12 +732,15 @@ void ExposeAPIInMainWorld(const std::string& key,
   context_bridge::ObjectCache object_cache;
   v8::Context::Scope main_context_scope(main_context);
   {
-    v8::MaybeLocal<v8::Object> maybe_proxy = CreateProxyForAPI(
-        api_object, isolated_context, main_context, store, &object_cache, 0);
+    v8::MaybeLocal<v8::Object> maybe_proxy =
+        lazy ? CreateLazyProxyForAPI(api_object, isolated_context,
+                                     main_context, store, share_array_buffers)
+             : CreateProxyForAPI(api_object, isolated_context, main_context,
+                                 store, &object_cache, share_array_buffers, 0);
     if (maybe_proxy.IsEmpty())
       return;
     auto proxy = maybe_proxy.ToLocalChecked();
-    if (!DeepFreeze(proxy, main_context))
+    if (!lazy && !DeepFreeze(proxy, main_context))
       return;
 
     global.SetReadOnlyNonConfigurable(key, proxy);
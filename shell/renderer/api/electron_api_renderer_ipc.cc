@@ -2,21 +2,30 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "gin/dictionary.h"
+#include "gin/function_template.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/promise.h"
+#include "shell/common/ipc_metrics.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/v8_value_serializer.h"
@@ -57,44 +66,155 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
       v8::Isolate* isolate) override {
     return gin::Wrappable<IPCRenderer>::GetObjectTemplateBuilder(isolate)
         .SetMethod("send", &IPCRenderer::Send)
+        .SetMethod("sendBatched", &IPCRenderer::SendBatched)
         .SetMethod("sendSync", &IPCRenderer::SendSync)
         .SetMethod("sendTo", &IPCRenderer::SendTo)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
         .SetMethod("invoke", &IPCRenderer::Invoke)
-        .SetMethod("postMessage", &IPCRenderer::PostMessage);
+        .SetMethod("postMessage", &IPCRenderer::PostMessage)
+        .SetMethod("setHighWaterMark", &IPCRenderer::SetHighWaterMark)
+        .SetMethod("getQueueStats", &IPCRenderer::GetQueueStats)
+        .SetMethod("whenDrained", &IPCRenderer::WhenDrained);
   }
 
   const char* GetTypeName() override { return "IPCRenderer"; }
 
  private:
-  void Send(v8::Isolate* isolate,
+  // Returns false when the messages the main process has yet to handle reach
+  // the high water mark, the message is still sent.
+  bool Send(v8::Isolate* isolate,
             bool internal,
             const std::string& channel,
             v8::Local<v8::Value> arguments) {
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    TRACE_EVENT1("electron", "IPCRenderer::Send", "channel", channel);
+    electron::SerializedValue value;
+    if (!electron::SerializeV8Value(isolate, arguments, &value)) {
+      return false;
+    }
+    FlushBatch();
+    if (high_water_mark_ == 0) {
+      electron_browser_ptr_->Message(internal, channel,
+                                     std::move(value.message),
+                                     std::move(value.array_buffers));
+      return true;
+    }
+    size_t size =
+        electron::IPCMetrics::GetSize(value.message, value.array_buffers);
+    pending_messages_++;
+    pending_bytes_ += size;
+    electron_browser_ptr_->MessageWithAck(
+        internal, channel, std::move(value.message),
+        std::move(value.array_buffers),
+        base::BindOnce(&IPCRenderer::OnMessagesAck, weak_factory_.GetWeakPtr(),
+                       1, size));
+    return pending_bytes_ < high_water_mark_;
+  }
+
+  void OnMessagesAck(size_t count, size_t size) {
+    pending_messages_ -= count;
+    pending_bytes_ -= size;
+    MaybeResolveDrained();
+  }
+
+  // Only the messages sent while the high water mark is set are counted, 0
+  // turns the accounting off.
+  void SetHighWaterMark(uint32_t bytes) {
+    high_water_mark_ = bytes;
+    MaybeResolveDrained();
+  }
+
+  gin::Dictionary GetQueueStats(v8::Isolate* isolate) {
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("pendingMessages", static_cast<double>(pending_messages_));
+    dict.Set("pendingBytes", static_cast<double>(pending_bytes_));
+    dict.Set("highWaterMark", static_cast<double>(high_water_mark_));
+    return dict;
+  }
+
+  // Resolves once the pending messages are below the high water mark.
+  v8::Local<v8::Promise> WhenDrained(v8::Isolate* isolate) {
+    if (IsDrained())
+      return gin_helper::Promise<void>::ResolvedPromise(isolate);
+    drained_promises_.emplace_back(isolate);
+    return drained_promises_.back().GetHandle();
+  }
+
+  bool IsDrained() const {
+    return high_water_mark_ == 0 || pending_bytes_ < high_water_mark_;
+  }
+
+  void MaybeResolveDrained() {
+    if (drained_promises_.empty() || !IsDrained())
       return;
+    std::vector<gin_helper::Promise<void>> promises;
+    promises.swap(drained_promises_);
+    for (auto& promise : promises)
+      promise.Resolve();
+  }
+
+  // Queues the message and sends all the messages queued in this microtask
+  // turn with a single MessageBatch call, which saves a mojo message and a
+  // wakeup of the browser UI thread per message. The arguments are still
+  // serialized right away, so later changes to them are not sent. Like with
+  // Send(), large ArrayBuffers go in shared memory and the messages count
+  // towards the high water mark from the time they are queued.
+  bool SendBatched(v8::Isolate* isolate,
+                   bool internal,
+                   const std::string& channel,
+                   v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendBatched", "channel", channel);
+    electron::SerializedValue value;
+    if (!electron::SerializeV8Value(isolate, arguments, &value)) {
+      return false;
+    }
+    if (pending_batch_.empty())
+      ScheduleFlushBatch(isolate);
+    if (high_water_mark_ != 0) {
+      size_t size =
+          electron::IPCMetrics::GetSize(value.message, value.array_buffers);
+      pending_messages_++;
+      pending_bytes_ += size;
+      pending_batch_acked_messages_++;
+      pending_batch_acked_bytes_ += size;
     }
-    electron_browser_ptr_->Message(internal, channel, std::move(message));
+    pending_batch_.push_back(electron::mojom::BatchedMessage::New(
+        internal, channel, std::move(value.message),
+        std::move(value.array_buffers)));
+    if (pending_batch_.size() >= kMaxBatchSize)
+      FlushBatch();
+    return IsDrained();
   }
 
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
                                 bool internal,
                                 const std::string& channel,
                                 v8::Local<v8::Value> arguments) {
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    TRACE_EVENT1("electron", "IPCRenderer::Invoke", "channel", channel);
+    electron::SerializedValue value;
+    if (!electron::SerializeV8Value(isolate, arguments, &value)) {
       return v8::Local<v8::Promise>();
     }
     gin_helper::Promise<blink::CloneableMessage> p(isolate);
     auto handle = p.GetHandle();
 
+    // Spans the time until the main process replies.
+    uint64_t trace_id = next_invoke_trace_id_++;
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron", "IPCRenderer::InvokeReply",
+                                      TRACE_ID_LOCAL(trace_id), "channel",
+                                      channel);
+    FlushBatch();
     electron_browser_ptr_->Invoke(
-        internal, channel, std::move(message),
+        internal, channel, std::move(value.message),
+        std::move(value.array_buffers),
         base::BindOnce(
             [](gin_helper::Promise<blink::CloneableMessage> p,
-               blink::CloneableMessage result) { p.Resolve(result); },
-            std::move(p)));
+               uint64_t trace_id, blink::CloneableMessage result) {
+              TRACE_EVENT_NESTABLE_ASYNC_END0("electron",
+                                              "IPCRenderer::InvokeReply",
+                                              TRACE_ID_LOCAL(trace_id));
+              p.Resolve(result);
+            },
+            std::move(p), trace_id));
 
     return handle;
   }
@@ -104,13 +224,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
                    const std::string& channel,
                    v8::Local<v8::Value> message_value,
                    base::Optional<v8::Local<v8::Value>> transfer) {
-    blink::TransferableMessage transferable_message;
-    if (!electron::SerializeV8Value(isolate, message_value,
-                                    &transferable_message)) {
-      // SerializeV8Value sets an exception.
-      return;
-    }
-
+    TRACE_EVENT1("electron", "IPCRenderer::PostMessage", "channel", channel);
     std::vector<v8::Local<v8::Object>> transferables;
     if (transfer) {
       if (!gin::ConvertFromV8(isolate, *transfer, &transferables)) {
@@ -119,8 +233,24 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
       }
     }
 
-    std::vector<blink::MessagePortChannel> ports;
+    std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+    std::vector<v8::Local<v8::Object>> port_objects;
     for (auto& transferable : transferables) {
+      if (transferable->IsArrayBuffer())
+        array_buffers.push_back(transferable.As<v8::ArrayBuffer>());
+      else
+        port_objects.push_back(transferable);
+    }
+
+    blink::TransferableMessage transferable_message;
+    if (!electron::SerializeV8Value(isolate, message_value, array_buffers,
+                                    &transferable_message)) {
+      // SerializeV8Value sets an exception.
+      return;
+    }
+
+    std::vector<blink::MessagePortChannel> ports;
+    for (auto& transferable : port_objects) {
       base::Optional<blink::MessagePortChannel> port =
           blink::WebMessagePortConverter::
               DisentangleAndExtractMessagePortChannel(isolate, transferable);
@@ -132,6 +262,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
     }
 
     transferable_message.ports = std::move(ports);
+    FlushBatch();
     electron_browser_ptr_->ReceivePostMessage(channel,
                                               std::move(transferable_message));
   }
@@ -142,25 +273,59 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
               int32_t web_contents_id,
               const std::string& channel,
               v8::Local<v8::Value> arguments) {
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendTo", "channel", channel);
+    electron::SerializedValue value;
+    if (!electron::SerializeV8Value(isolate, arguments, &value)) {
+      return;
+    }
+    FlushBatch();
+    if (!send_to_all) {
+      GetPeer(web_contents_id)
+          ->PeerMessage(internal, channel, std::move(value.message),
+                        std::move(value.array_buffers));
       return;
     }
     electron_browser_ptr_->MessageTo(internal, send_to_all, web_contents_id,
-                                     channel, std::move(message));
+                                     channel, std::move(value.message),
+                                     std::move(value.array_buffers));
+  }
+
+  // Returns the pipe to the main frame of |web_contents_id|, asking the
+  // browser to connect it the first time. Messages can be sent on it right
+  // away, they are queued until the target frame binds it.
+  electron::mojom::ElectronRendererPeer* GetPeer(int32_t web_contents_id) {
+    auto& peer = peers_[web_contents_id];
+    if (!peer.is_bound()) {
+      electron_browser_ptr_->ConnectToWebContents(
+          web_contents_id, peer.BindNewPipeAndPassReceiver());
+      // The pipe is closed when the target does not exist or its frame goes
+      // away, the next message connects again.
+      peer.set_disconnect_handler(base::BindOnce(&IPCRenderer::OnPeerClosed,
+                                                 weak_factory_.GetWeakPtr(),
+                                                 web_contents_id));
+    }
+    return peer.get();
+  }
+
+  void OnPeerClosed(int32_t web_contents_id) {
+    peers_.erase(web_contents_id);
   }
 
   void SendToHost(v8::Isolate* isolate,
                   const std::string& channel,
                   v8::Local<v8::Value> arguments) {
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendToHost", "channel", channel);
+    electron::SerializedValue value;
+    if (!electron::SerializeV8Value(isolate, arguments, &value)) {
       return;
     }
-    electron_browser_ptr_->MessageHost(channel, std::move(message));
+    FlushBatch();
+    electron_browser_ptr_->MessageHost(channel, std::move(value.message),
+                                       std::move(value.array_buffers));
   }
 
   v8::Local<v8::Value> SendSync(v8::Isolate* isolate,
+                                gin_helper::ErrorThrower thrower,
                                 bool internal,
                                 const std::string& channel,
                                 v8::Local<v8::Value> arguments) {
@@ -170,12 +335,81 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
     }
 
     blink::CloneableMessage result;
-    electron_browser_ptr_->MessageSync(internal, channel, std::move(message),
-                                       &result);
+    FlushBatch();
+    bool replied;
+    {
+      // Spans the time the renderer main thread is blocked.
+      TRACE_EVENT1("electron", "IPCRenderer::SendSync", "channel", channel);
+      replied = electron_browser_ptr_->MessageSync(internal, channel,
+                                                   std::move(message), &result);
+    }
+    // Serialized values are never empty, the browser replies with an empty
+    // message when the reply was not sent before the sync message deadline.
+    if (replied && result.encoded_message.empty()) {
+      thrower.ThrowError("sendSync() on channel '" + channel +
+                         "' did not receive a reply before the deadline");
+      return v8::Local<v8::Value>();
+    }
     return electron::DeserializeV8Value(isolate, result);
   }
 
+  void ScheduleFlushBatch(v8::Isolate* isolate) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Function> flush;
+    if (!gin::CreateFunctionTemplate(
+             isolate, base::BindRepeating(&IPCRenderer::FlushBatch,
+                                          weak_factory_.GetWeakPtr()))
+             ->GetFunction(context)
+             .ToLocal(&flush))
+      return;
+    if (v8::MicrotaskQueue* queue = context->GetMicrotaskQueue())
+      queue->EnqueueMicrotask(isolate, flush);
+    else
+      isolate->EnqueueMicrotask(flush);
+  }
+
+  // Sends the queued batch, every other message is sent after it so that
+  // messages arrive in the order they were sent.
+  void FlushBatch() {
+    if (pending_batch_.empty())
+      return;
+    if (pending_batch_acked_messages_ == 0) {
+      electron_browser_ptr_->MessageBatch(std::move(pending_batch_));
+    } else {
+      electron_browser_ptr_->MessageBatchWithAck(
+          std::move(pending_batch_),
+          base::BindOnce(&IPCRenderer::OnMessagesAck,
+                         weak_factory_.GetWeakPtr(),
+                         pending_batch_acked_messages_,
+                         pending_batch_acked_bytes_));
+    }
+    pending_batch_.clear();
+    pending_batch_acked_messages_ = 0;
+    pending_batch_acked_bytes_ = 0;
+  }
+
+  // Upper bound of the messages sent in one batch.
+  static constexpr size_t kMaxBatchSize = 1024;
+
   electron::mojom::ElectronBrowserPtr electron_browser_ptr_;
+  std::map<int32_t, mojo::Remote<electron::mojom::ElectronRendererPeer>>
+      peers_;
+  std::vector<electron::mojom::BatchedMessagePtr> pending_batch_;
+  // The messages of |pending_batch_| counted towards the high water mark.
+  size_t pending_batch_acked_messages_ = 0;
+  size_t pending_batch_acked_bytes_ = 0;
+
+  // Accounting of the messages sent with send() and sendBatched() that the
+  // main process has not handled yet.
+  size_t high_water_mark_ = 0;
+  size_t pending_messages_ = 0;
+  size_t pending_bytes_ = 0;
+  std::vector<gin_helper::Promise<void>> drained_promises_;
+
+  // Matches the begin and end of the trace of each invoke() reply.
+  uint64_t next_invoke_trace_id_ = 0;
+
+  base::WeakPtrFactory<IPCRenderer> weak_factory_{this};
 };
 
 gin::WrapperInfo IPCRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -28,6 +28,11 @@ namespace api {
 
 namespace {
 
+// The cache is dropped past this many words, except for the words of the
+// pending request, which bounds its memory while being far more than the
+// vocabulary of a document.
+constexpr size_t kMaxCheckedWords = 10000;
+
 bool HasWordCharacters(const base::string16& text, int index) {
   const base::char16* data = text.data();
   int length = text.length();
@@ -60,10 +65,12 @@ class SpellCheckClient::SpellcheckRequest {
   const base::string16& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
+  std::set<base::string16>& words() { return words_; }
 
  private:
   base::string16 text_;          // Text to be checked in this task.
   std::vector<Word> word_list_;  // List of Words found in text
+  std::set<base::string16> words_;  // The distinct words of |word_list_|.
   // The interface to send the misspelled ranges to WebKit.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 
@@ -155,7 +162,7 @@ void SpellCheckClient::SpellCheckText() {
   base::string16 word;
   size_t word_start;
   size_t word_length;
-  std::set<base::string16> words;
+  auto& words = pending_request_param_->words();
   auto& word_list = pending_request_param_->wordlist();
   Word word_entry;
   for (;;) {  // Run until end of text
@@ -182,26 +189,79 @@ void SpellCheckClient::SpellCheckText() {
     }
   }
 
-  // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  std::set<base::string16> unchecked_words;
+  for (const auto& w : words) {
+    if (checked_words_.find(w) == checked_words_.end())
+      unchecked_words.insert(w);
+  }
+  if (unchecked_words.empty()) {
+    FinishRequestIfChecked();
+    return;
+  }
+
+  // Send out the words data the spellchecker has not checked yet
+  SpellCheckWords(scope, unchecked_words);
 }
 
 void SpellCheckClient::OnSpellCheckDone(
+    const std::set<base::string16>& words,
     const std::vector<base::string16>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
+  // The results of a request that was cancelled since are still cached, the
+  // following request likely has the same words.
+  if (checked_words_.size() + words.size() > kMaxCheckedWords)
+    EvictCheckedWords();
   std::unordered_set<base::string16> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
+  for (const auto& word : words)
+    checked_words_[word] = misspelled.find(word) != misspelled.end();
 
-  auto& word_list = pending_request_param_->wordlist();
+  FinishRequestIfChecked();
+}
 
-  for (const auto& word : word_list) {
-    if (misspelled.find(word.text) != misspelled.end()) {
+void SpellCheckClient::EvictCheckedWords() {
+  if (!pending_request_param_) {
+    checked_words_.clear();
+    return;
+  }
+  // The words of the pending request that were answered already are not
+  // requested again, so they have to stay until it is finished.
+  const auto& words = pending_request_param_->words();
+  for (auto it = checked_words_.begin(); it != checked_words_.end();) {
+    if (words.find(it->first) == words.end())
+      it = checked_words_.erase(it);
+    else
+      ++it;
+  }
+}
+
+void SpellCheckClient::FinishRequestIfChecked() {
+  if (!pending_request_param_)
+    return;
+
+  auto is_misspelled = [this](const base::string16& word, bool* result) {
+    auto it = checked_words_.find(word);
+    if (it == checked_words_.end())
+      return false;
+    *result = it->second;
+    return true;
+  };
+
+  std::vector<blink::WebTextCheckingResult> results;
+  for (const auto& word : pending_request_param_->wordlist()) {
+    bool misspelled = false;
+    // Wait for the results of the words still being checked.
+    if (!is_misspelled(word.text, &misspelled))
+      return;
+    if (misspelled) {
       // If this is a contraction, iterate through parts and accept the word
       // if none of them are misspelled
       if (!word.contraction_words.empty()) {
         auto all_correct = true;
         for (const auto& contraction_word : word.contraction_words) {
-          if (misspelled.find(contraction_word) != misspelled.end()) {
+          bool contraction_misspelled = false;
+          if (!is_misspelled(contraction_word, &contraction_misspelled))
+            return;
+          if (contraction_misspelled) {
             all_correct = false;
             break;
           }
@@ -222,7 +282,8 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
 
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
       isolate_,
-      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
+      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr(),
+                          words));
 
   auto context = isolate_->GetCurrentContext();
   v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
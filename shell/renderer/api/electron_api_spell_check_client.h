@@ -8,6 +8,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/callback.h"
@@ -61,8 +62,8 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   };
 
   // Run through the word iterator and send out requests
-  // to the JS API for checking spellings of words in the current
-  // request.
+  // to the JS API for checking spellings of the words in the current
+  // request that are not cached yet.
   void SpellCheckText();
 
   // Call JavaScript to check spelling a word.
@@ -71,6 +72,12 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   void SpellCheckWords(const SpellCheckScope& scope,
                        const std::set<base::string16>& words);
 
+  // Drops the cached words, except for those of the pending request.
+  void EvictCheckedWords();
+
+  // Completes the current request if all its words are cached.
+  void FinishRequestIfChecked();
+
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
   // Output variable contraction_words will contain individual
@@ -79,8 +86,10 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                      const base::string16& word,
                      std::vector<base::string16>* contraction_words);
 
-  // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<base::string16>& misspelled_words);
+  // Callback for the JS API which returns the list of misspelled words
+  // among |words|.
+  void OnSpellCheckDone(const std::set<base::string16>& words,
+                        const std::vector<base::string16>& misspelled_words);
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -99,6 +108,11 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
 
+  // Word => whether the provider reported it as misspelled. Blink passes the
+  // whole paragraph again after each edit, so only the words that were not
+  // seen yet are sent to the provider.
+  std::unordered_map<base::string16, bool> checked_words_;
+
   v8::Isolate* isolate_;
   v8::Global<v8::Context> context_;
   v8::Global<v8::Object> provider_;
@@ -0,0 +1,91 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
+#include "content/public/renderer/render_frame.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/common/api/api.mojom.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "shell/common/system_snapshot.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+#include "ui/native_theme/native_theme.h"
+
+namespace {
+
+// Maps the snapshot the first time it is read, later reads are plain memory
+// reads. Only used on the main thread of the renderer.
+const electron::SystemSnapshotData* GetSnapshotData() {
+  static base::NoDestructor<base::ReadOnlySharedMemoryMapping> mapping;
+  if (!mapping->IsValid()) {
+    auto* frame = blink::WebLocalFrame::FrameForCurrentContext();
+    auto* render_frame =
+        frame ? content::RenderFrame::FromWebFrame(frame) : nullptr;
+    if (!render_frame)
+      return nullptr;
+
+    electron::mojom::ElectronBrowserPtr browser_ptr;
+    render_frame->GetRemoteInterfaces()->GetInterface(
+        mojo::MakeRequest(&browser_ptr));
+    base::ReadOnlySharedMemoryRegion region;
+    if (!browser_ptr->GetSystemSnapshot(&region) || !region.IsValid())
+      return nullptr;
+    *mapping = region.Map();
+    if (!mapping->IsValid() ||
+        mapping->size() < sizeof(electron::SystemSnapshotData)) {
+      *mapping = base::ReadOnlySharedMemoryMapping();
+      return nullptr;
+    }
+  }
+  return mapping->GetMemoryAs<electron::SystemSnapshotData>();
+}
+
+const char* ThemeSourceToString(uint32_t theme_source) {
+  switch (static_cast<ui::NativeTheme::ThemeSource>(theme_source)) {
+    case ui::NativeTheme::ThemeSource::kForcedDark:
+      return "dark";
+    case ui::NativeTheme::ThemeSource::kForcedLight:
+      return "light";
+    case ui::NativeTheme::ThemeSource::kSystem:
+    default:
+      return "system";
+  }
+}
+
+v8::Local<v8::Value> GetSystemSnapshot(v8::Isolate* isolate) {
+  const electron::SystemSnapshotData* data = GetSnapshotData();
+  if (!data)
+    return v8::Null(isolate);
+
+  using Values = electron::SystemSnapshotValues;
+  Values values = electron::ReadSystemSnapshot(data);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("shouldUseDarkColors",
+           !!(values.flags & Values::kShouldUseDarkColors));
+  dict.Set("shouldUseHighContrastColors",
+           !!(values.flags & Values::kShouldUseHighContrastColors));
+  dict.Set("shouldUseInvertedColorScheme",
+           !!(values.flags & Values::kShouldUseInvertedColorScheme));
+  dict.Set("themeSource", ThemeSourceToString(values.theme_source));
+  dict.Set("accentColor", values.flags & Values::kHasAccentColor
+                              ? base::StringPrintf("%08x", values.accent_color)
+                              : std::string());
+  return dict.GetHandle();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("getSystemSnapshot", &GetSystemSnapshot);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_renderer_system_snapshot, Initialize)
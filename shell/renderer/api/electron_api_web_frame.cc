@@ -3,12 +3,15 @@
 // found in the LICENSE file.
 
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/render_frame_visitor.h"
@@ -20,11 +23,14 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/world_ids.h"
 #include "shell/renderer/api/electron_api_spell_check_client.h"
+#include "shell/renderer/electron_render_frame_observer.h"
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/common/web_cache/web_cache_resource_type_stats.h"
 #include "third_party/blink/public/platform/web_cache.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
+#include "third_party/blink/public/web/web_console_message.h"
 #include "third_party/blink/public/web/web_custom_element.h"
 #include "third_party/blink/public/web/web_document.h"
 #include "third_party/blink/public/web/web_element.h"
@@ -110,6 +116,172 @@ class RenderFrameStatus final : public content::RenderFrameObserver {
   void OnDestruct() final {}
 };
 
+const char* GetWorldType(int world_id) {
+  if (world_id == WorldIDs::MAIN_WORLD_ID)
+    return "main";
+  if (world_id == WorldIDs::ISOLATED_WORLD_ID)
+    return "isolated";
+  if (world_id >= WorldIDs::ISOLATED_WORLD_ID_EXTENSIONS &&
+      world_id <= WorldIDs::ISOLATED_WORLD_ID_EXTENSIONS_END)
+    return "extension";
+  return "other";
+}
+
+// Resolves with the V8 heap used by the script contexts of this process,
+// grouped by the frame and the world they belong to.
+class WorldMemoryMeasurement : public v8::MeasureMemoryDelegate {
+ public:
+  explicit WorldMemoryMeasurement(
+      gin_helper::Promise<v8::Local<v8::Value>> promise)
+      : promise_(std::move(promise)) {}
+  ~WorldMemoryMeasurement() override = default;
+
+  // v8::MeasureMemoryDelegate:
+  bool ShouldMeasure(v8::Local<v8::Context> context) override { return true; }
+
+  void MeasurementComplete(
+      const std::vector<std::pair<v8::Local<v8::Context>, size_t>>&
+          context_sizes_in_bytes,
+      size_t unattributed_size_in_bytes) override {
+    struct Usage {
+      int context_count = 0;
+      size_t size = 0;
+    };
+    // (routing id, world id) => usage.
+    std::map<std::pair<int, int>, Usage> usages;
+    size_t unattributed_size = unattributed_size_in_bytes;
+    for (const auto& context_size : context_sizes_in_bytes) {
+      v8::Local<v8::Context> context = context_size.first;
+      auto* frame = blink::WebLocalFrame::FrameForContext(context);
+      auto* render_frame =
+          frame ? content::RenderFrame::FromWebFrame(frame) : nullptr;
+      int world_id = ElectronRenderFrameObserver::GetWorldId(context);
+      if (!render_frame || world_id < 0) {
+        unattributed_size += context_size.second;
+        continue;
+      }
+      Usage& usage = usages[{render_frame->GetRoutingID(), world_id}];
+      usage.context_count++;
+      usage.size += context_size.second;
+    }
+
+    v8::Isolate* isolate = promise_.isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(promise_.GetContext());
+    std::vector<gin_helper::Dictionary> worlds;
+    for (const auto& it : usages) {
+      gin_helper::Dictionary world = gin::Dictionary::CreateEmpty(isolate);
+      world.Set("frameRoutingId", it.first.first);
+      world.Set("worldId", it.first.second);
+      world.Set("type", GetWorldType(it.first.second));
+      world.Set("contextCount", it.second.context_count);
+      world.Set("size", static_cast<double>(it.second.size));
+      worlds.push_back(world);
+    }
+    gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+    result.Set("worlds", worlds);
+    result.Set("unattributedSize", static_cast<double>(unattributed_size));
+    promise_.Resolve(gin::ConvertToV8(isolate, result));
+  }
+
+ private:
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorldMemoryMeasurement);
+};
+
+// Collects the results of a script run in several frames, and resolves with
+// them once every frame has completed.
+class AllFramesScriptResults
+    : public base::RefCounted<AllFramesScriptResults> {
+ public:
+  AllFramesScriptResults(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                         size_t frame_count)
+      : promise_(std::move(promise)), frame_count_(frame_count) {
+    if (frame_count_ == 0)
+      Resolve();
+  }
+
+  void Add(int routing_id,
+           v8::Local<v8::Value> result,
+           v8::Local<v8::Value> error) {
+    v8::Isolate* isolate = promise_.isolate();
+    Entry entry;
+    entry.routing_id = routing_id;
+    if (!result.IsEmpty())
+      entry.result.Reset(isolate, result);
+    if (!error.IsEmpty())
+      entry.error.Reset(isolate, error);
+    entries_.push_back(std::move(entry));
+    if (entries_.size() == frame_count_)
+      Resolve();
+  }
+
+ private:
+  friend class base::RefCounted<AllFramesScriptResults>;
+
+  struct Entry {
+    int routing_id;
+    v8::Global<v8::Value> result;
+    v8::Global<v8::Value> error;
+  };
+
+  ~AllFramesScriptResults() = default;
+
+  void Resolve() {
+    v8::Isolate* isolate = promise_.isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(promise_.GetContext());
+    std::vector<gin_helper::Dictionary> results;
+    for (const auto& entry : entries_) {
+      gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+      result.Set("frameId", entry.routing_id);
+      if (!entry.error.IsEmpty())
+        result.Set("error", entry.error.Get(isolate));
+      else
+        result.Set("result", entry.result.Get(isolate));
+      results.push_back(result);
+    }
+    promise_.Resolve(gin::ConvertToV8(isolate, results));
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+  const size_t frame_count_;
+  std::vector<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllFramesScriptResults);
+};
+
+class FrameScriptExecutionCallback : public blink::WebScriptExecutionCallback {
+ public:
+  FrameScriptExecutionCallback(scoped_refptr<AllFramesScriptResults> results,
+                               int routing_id)
+      : results_(std::move(results)), routing_id_(routing_id) {}
+  ~FrameScriptExecutionCallback() override = default;
+
+  void Completed(
+      const blink::WebVector<v8::Local<v8::Value>>& result) override {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    if (!result.empty() && !result[0].IsEmpty()) {
+      results_->Add(routing_id_, result[0], v8::Local<v8::Value>());
+    } else {
+      const char* error_message =
+          result.empty() ? "The frame was removed before the script could run"
+                         : "Script failed to execute";
+      results_->Add(routing_id_, v8::Local<v8::Value>(),
+                    v8::Exception::Error(gin::StringToV8(isolate,
+                                                         error_message)));
+    }
+    delete this;
+  }
+
+ private:
+  scoped_refptr<AllFramesScriptResults> results_;
+  const int routing_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameScriptExecutionCallback);
+};
+
 class ScriptExecutionCallback : public blink::WebScriptExecutionCallback {
  public:
   // for compatibility with the older version of this, error is after result
@@ -478,6 +650,119 @@ v8::Local<v8::Promise> ExecuteJavaScriptInIsolatedWorld(
   return handle;
 }
 
+// Runs |code| in the world |world_id| of every local frame of the page of
+// |window| in this process.
+v8::Local<v8::Promise> ExecuteJavaScriptInAllFrames(
+    gin_helper::Arguments* args,
+    v8::Local<v8::Value> window,
+    const base::string16& code,
+    int world_id) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool has_user_gesture = false;
+  args->GetNext(&has_user_gesture);
+
+  // A process can host several disjoint subtrees of the page, so the whole
+  // tree is walked rather than the subtree of the frame.
+  std::vector<blink::WebLocalFrame*> frames;
+  blink::WebView* web_view = GetRenderFrame(window)->GetWebFrame()->View();
+  for (blink::WebFrame* frame = web_view->MainFrame(); frame;
+       frame = frame->TraverseNext()) {
+    if (frame->IsWebLocalFrame())
+      frames.push_back(frame->ToWebLocalFrame());
+  }
+
+  auto results = base::MakeRefCounted<AllFramesScriptResults>(
+      std::move(promise), frames.size());
+  blink::WebScriptSource source(blink::WebString::FromUTF16(code));
+  for (auto* frame : frames) {
+    auto* callback = new FrameScriptExecutionCallback(
+        results, content::RenderFrame::FromWebFrame(frame)->GetRoutingID());
+    if (world_id == WorldIDs::MAIN_WORLD_ID) {
+      frame->RequestExecuteScriptAndReturnValue(source, has_user_gesture,
+                                                callback);
+    } else {
+      frame->RequestExecuteScriptInIsolatedWorld(
+          world_id, &source, 1, has_user_gesture,
+          blink::WebLocalFrame::kSynchronous, callback);
+    }
+  }
+
+  return handle;
+}
+
+// Runs |code| in the isolated world |world_id| synchronously, consuming the
+// V8 code cache of a previous run when there is one. Returns a new code cache
+// when there was none or it was rejected, undefined otherwise.
+v8::Local<v8::Value> RunScriptInIsolatedWorld(gin_helper::Arguments* args,
+                                              v8::Local<v8::Value> window,
+                                              int world_id,
+                                              v8::Local<v8::String> code,
+                                              const std::string& url) {
+  v8::Isolate* isolate = args->isolate();
+  blink::WebLocalFrame* frame = GetRenderFrame(window)->GetWebFrame();
+
+  // Blink only creates the context of a world when a script first runs in
+  // it, the global it returns gives the context.
+  v8::Local<v8::Value> global =
+      frame->ExecuteScriptInIsolatedWorldAndReturnValue(
+          world_id, blink::WebScriptSource("globalThis"));
+  if (global.IsEmpty() || !global->IsObject())
+    return v8::Undefined(isolate);
+
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  v8::Local<v8::Value> code_cache;
+  if (args->GetNext(&code_cache) && code_cache->IsArrayBufferView()) {
+    auto view = code_cache.As<v8::ArrayBufferView>();
+    size_t length = view->ByteLength();
+    auto* data = new uint8_t[length];
+    view->CopyContents(data, length);
+    cached_data = new v8::ScriptCompiler::CachedData(
+        data, length, v8::ScriptCompiler::CachedData::BufferOwned);
+  }
+
+  std::unique_ptr<v8::ScriptCompiler::CachedData> new_cache;
+  {
+    v8::Local<v8::Context> context = global.As<v8::Object>()->CreationContext();
+    v8::Context::Scope context_scope(context);
+    v8::TryCatch try_catch(isolate);
+
+    // The source takes ownership of |cached_data|.
+    v8::ScriptOrigin origin(gin::StringToV8(isolate, url));
+    v8::ScriptCompiler::Source source(code, origin, cached_data);
+    v8::Local<v8::Script> script;
+    if (v8::ScriptCompiler::Compile(context, &source,
+                                    cached_data
+                                        ? v8::ScriptCompiler::kConsumeCodeCache
+                                        : v8::ScriptCompiler::kNoCompileOptions)
+            .ToLocal(&script)) {
+      if (!cached_data || source.GetCachedData()->rejected) {
+        new_cache.reset(
+            v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+      }
+      ignore_result(script->Run(context));
+    }
+
+    // Errors of the script are reported like the ones of other scripts of
+    // the world, rather than handed over to the caller.
+    if (try_catch.HasCaught() && !try_catch.Message().IsEmpty()) {
+      frame->AddMessageToConsole(blink::WebConsoleMessage(
+          blink::mojom::ConsoleMessageLevel::kError,
+          blink::WebString::FromUTF8(
+              gin::V8ToString(isolate, try_catch.Message()->Get()))));
+    }
+  }
+
+  if (!new_cache)
+    return v8::Undefined(isolate);
+  auto buffer = v8::ArrayBuffer::New(isolate, new_cache->length);
+  memcpy(buffer->GetBackingStore()->Data(), new_cache->data,
+         new_cache->length);
+  return v8::Uint8Array::New(buffer, 0, new_cache->length);
+}
+
 void SetIsolatedWorldInfo(v8::Local<v8::Value> window,
                           int world_id,
                           const gin_helper::Dictionary& options,
@@ -507,6 +792,15 @@ blink::WebCacheResourceTypeStats GetResourceUsage(v8::Isolate* isolate) {
   return stats;
 }
 
+v8::Local<v8::Promise> GetWorldMemoryUsage(v8::Isolate* isolate) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  isolate->MeasureMemory(
+      std::make_unique<WorldMemoryMeasurement>(std::move(promise)),
+      v8::MeasureMemoryExecution::kEager);
+  return handle;
+}
+
 void ClearCache(v8::Isolate* isolate) {
   isolate->IdleNotificationDeadline(0.5);
   blink::WebCache::Clear();
@@ -634,6 +928,7 @@ void Initialize(v8::Local<v8::Object> exports,
                  &ExecuteJavaScriptInIsolatedWorld);
   dict.SetMethod("setIsolatedWorldInfo", &SetIsolatedWorldInfo);
   dict.SetMethod("getResourceUsage", &GetResourceUsage);
+  dict.SetMethod("getWorldMemoryUsage", &GetWorldMemoryUsage);
   dict.SetMethod("clearCache", &ClearCache);
   dict.SetMethod("_findFrameByRoutingId", &FindFrameByRoutingId);
   dict.SetMethod("_getFrameForSelector", &GetFrameForSelector);
@@ -644,6 +939,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("_getFirstChild", &GetFirstChild);
   dict.SetMethod("_getNextSibling", &GetNextSibling);
   dict.SetMethod("_getRoutingId", &GetRoutingId);
+  dict.SetMethod("_runScriptInIsolatedWorld", &RunScriptInIsolatedWorld);
+  dict.SetMethod("_executeJavaScriptInAllFrames",
+                 &ExecuteJavaScriptInAllFrames);
 }
 
 }  // namespace
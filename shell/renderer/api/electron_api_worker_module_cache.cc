@@ -0,0 +1,173 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "gin/converter.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+
+namespace {
+
+// Code caches past this total are not kept, the workers compile the modules
+// that do not fit like they would without the cache.
+constexpr size_t kMaxCodeCacheBytes = 32 * 1024 * 1024;
+
+// The code caches and resolved module paths of the Node environments of the
+// web workers of this renderer, so that each worker does not resolve and
+// compile again what another one already did. The workers run on their own
+// threads, hence the lock.
+class WorkerModuleCache {
+ public:
+  struct Stats {
+    uint32_t code_cache_hits = 0;
+    uint32_t resolved_path_hits = 0;
+  };
+
+  static WorkerModuleCache* GetInstance() {
+    static base::NoDestructor<WorkerModuleCache> instance;
+    return instance.get();
+  }
+
+  // The cache of |filename| is only used while its source is the one it was
+  // created from. Comparing the sources is cheaper than hashing them on each
+  // require.
+  bool GetCodeCache(const std::string& filename,
+                    const std::string& source,
+                    std::string* data) {
+    base::AutoLock auto_lock(lock_);
+    auto it = code_caches_.find(filename);
+    if (it == code_caches_.end() || it->second.source != source)
+      return false;
+    *data = it->second.data;
+    ++stats_.code_cache_hits;
+    return true;
+  }
+
+  void SetCodeCache(const std::string& filename,
+                    std::string source,
+                    std::string data) {
+    base::AutoLock auto_lock(lock_);
+    auto it = code_caches_.find(filename);
+    size_t old_size = it == code_caches_.end() ? 0 : it->second.size();
+    size_t new_size = source.size() + data.size();
+    if (code_cache_bytes_ - old_size + new_size > kMaxCodeCacheBytes)
+      return;
+    code_cache_bytes_ = code_cache_bytes_ - old_size + new_size;
+    code_caches_[filename] = {std::move(source), std::move(data)};
+  }
+
+  bool GetResolvedPath(const std::string& key, std::string* path) {
+    base::AutoLock auto_lock(lock_);
+    auto it = resolved_paths_.find(key);
+    if (it == resolved_paths_.end())
+      return false;
+    *path = it->second;
+    ++stats_.resolved_path_hits;
+    return true;
+  }
+
+  void SetResolvedPath(const std::string& key, const std::string& path) {
+    base::AutoLock auto_lock(lock_);
+    resolved_paths_[key] = path;
+  }
+
+  void DeleteResolvedPath(const std::string& key) {
+    base::AutoLock auto_lock(lock_);
+    resolved_paths_.erase(key);
+  }
+
+  Stats GetStats() {
+    base::AutoLock auto_lock(lock_);
+    return stats_;
+  }
+
+ private:
+  friend class base::NoDestructor<WorkerModuleCache>;
+
+  struct CodeCache {
+    size_t size() const { return source.size() + data.size(); }
+
+    std::string source;
+    std::string data;
+  };
+
+  WorkerModuleCache() = default;
+
+  base::Lock lock_;
+  // Filename of a module => its code cache.
+  std::map<std::string, CodeCache> code_caches_;
+  size_t code_cache_bytes_ = 0;
+  // Directory of the requiring module and request => filename.
+  std::map<std::string, std::string> resolved_paths_;
+  Stats stats_;
+};
+
+v8::Local<v8::Value> GetCodeCache(v8::Isolate* isolate,
+                                  const std::string& filename,
+                                  const std::string& source) {
+  std::string data;
+  if (!WorkerModuleCache::GetInstance()->GetCodeCache(filename, source,
+                                                      &data))
+    return v8::Undefined(isolate);
+  return node::Buffer::Copy(isolate, data.data(), data.size())
+      .ToLocalChecked();
+}
+
+void SetCodeCache(const std::string& filename,
+                  std::string source,
+                  v8::Local<v8::Value> buffer) {
+  if (!node::Buffer::HasInstance(buffer))
+    return;
+  WorkerModuleCache::GetInstance()->SetCodeCache(
+      filename, std::move(source),
+      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
+}
+
+v8::Local<v8::Value> GetResolvedPath(v8::Isolate* isolate,
+                                     const std::string& key) {
+  std::string path;
+  if (!WorkerModuleCache::GetInstance()->GetResolvedPath(key, &path))
+    return v8::Undefined(isolate);
+  return gin::StringToV8(isolate, path);
+}
+
+void SetResolvedPath(const std::string& key, const std::string& path) {
+  WorkerModuleCache::GetInstance()->SetResolvedPath(key, path);
+}
+
+void DeleteResolvedPath(const std::string& key) {
+  WorkerModuleCache::GetInstance()->DeleteResolvedPath(key);
+}
+
+v8::Local<v8::Value> GetStats(v8::Isolate* isolate) {
+  auto stats = WorkerModuleCache::GetInstance()->GetStats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("codeCacheHits", stats.code_cache_hits);
+  dict.Set("resolvedPathHits", stats.resolved_path_hits);
+  return dict.GetHandle();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("getCodeCache", &GetCodeCache);
+  dict.SetMethod("setCodeCache", &SetCodeCache);
+  dict.SetMethod("getResolvedPath", &GetResolvedPath);
+  dict.SetMethod("setResolvedPath", &SetResolvedPath);
+  dict.SetMethod("deleteResolvedPath", &DeleteResolvedPath);
+  dict.SetMethod("getStats", &GetStats);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_renderer_worker_module_cache,
+                                 Initialize)
@@ -10,18 +10,26 @@
 
 #include "base/environment.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
+#include "shell/common/ipc_metrics.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/shared_memory_buffer.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
+#include "third_party/blink/public/platform/web_cache.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
@@ -130,11 +138,15 @@ void ElectronApiServiceImpl::OnConnectionError() {
     receiver_.reset();
 }
 
-void ElectronApiServiceImpl::Message(bool internal,
-                                     bool send_to_all,
-                                     const std::string& channel,
-                                     blink::CloneableMessage arguments,
-                                     int32_t sender_id) {
+void ElectronApiServiceImpl::Message(
+    bool internal,
+    bool send_to_all,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
+    int32_t sender_id) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::Message", "channel",
+               channel);
   // Don't handle browser messages before document element is created.
   //
   // Note: It is probably better to save the message and then replay it after
@@ -164,7 +176,11 @@ void ElectronApiServiceImpl::Message(bool internal,
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, arguments);
+  IPCMetrics::ScopedDispatch dispatch(
+      channel, IPCMetrics::GetSize(arguments, array_buffers));
+  v8::Local<v8::Value> args = gin::ConvertToV8(
+      isolate,
+      SerializedValue(std::move(arguments), std::move(array_buffers)));
 
   EmitIPCEvent(context, internal, channel, {}, args, sender_id);
 
@@ -181,9 +197,26 @@ void ElectronApiServiceImpl::Message(bool internal,
   }
 }
 
+void ElectronApiServiceImpl::BindPeer(
+    int32_t sender_id,
+    mojo::PendingReceiver<mojom::ElectronRendererPeer> receiver) {
+  peer_receivers_.Add(this, std::move(receiver), sender_id);
+}
+
+void ElectronApiServiceImpl::PeerMessage(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<base::ReadOnlySharedMemoryRegion> array_buffers) {
+  Message(internal, false, channel, std::move(arguments),
+          std::move(array_buffers), peer_receivers_.current_context());
+}
+
 void ElectronApiServiceImpl::ReceivePostMessage(
     const std::string& channel,
     blink::TransferableMessage message) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::ReceivePostMessage",
+               "channel", channel);
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   if (!frame)
     return;
@@ -194,7 +227,11 @@ void ElectronApiServiceImpl::ReceivePostMessage(
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+  IPCMetrics::ScopedDispatch dispatch(channel, IPCMetrics::GetSize(message));
+  // Messages on this interface come from the browser process, so shared
+  // memory holding transferred ArrayBuffers can be used in place.
+  v8::Local<v8::Value> message_value =
+      DeserializeV8Value(isolate, &message, true);
 
   std::vector<v8::Local<v8::Value>> ports;
   for (auto& port : message.ports) {
@@ -209,10 +246,43 @@ void ElectronApiServiceImpl::ReceivePostMessage(
                0);
 }
 
+void ElectronApiServiceImpl::ReceiveSharedBuffer(
+    const std::string& channel,
+    base::UnsafeSharedMemoryRegion region,
+    blink::TransferableMessage message) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::ReceiveSharedBuffer",
+               "channel", channel);
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  std::vector<v8::Local<v8::Value>> ports;
+  for (auto& port : message.ports) {
+    ports.emplace_back(
+        blink::WebMessagePortConverter::EntangleAndInjectMessagePortChannel(
+            context, std::move(port)));
+  }
+
+  std::vector<v8::Local<v8::Value>> args = {
+      NewSharedArrayBufferForMapping(isolate, std::move(mapping))};
+
+  EmitIPCEvent(context, false, channel, ports, gin::ConvertToV8(isolate, args),
+               0);
+}
+
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-void ElectronApiServiceImpl::DereferenceRemoteJSCallback(
-    const std::string& context_id,
-    int32_t object_id) {
+void ElectronApiServiceImpl::DereferenceRemoteJSCallbacks(
+    std::vector<mojom::RemoteCallbackDereferencePtr> callbacks) {
   const auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
   if (!document_created_)
     return;
@@ -226,13 +296,15 @@ void ElectronApiServiceImpl::DereferenceRemoteJSCallback(
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  base::ListValue args;
-  args.AppendString(context_id);
-  args.AppendInteger(object_id);
+  for (const auto& callback : callbacks) {
+    base::ListValue args;
+    args.AppendString(callback->context_id);
+    args.AppendInteger(callback->object_id);
 
-  v8::Local<v8::Value> v8_args = gin::ConvertToV8(isolate, args);
-  EmitIPCEvent(context, true /* internal */, channel, {}, v8_args,
-               0 /* sender_id */);
+    v8::Local<v8::Value> v8_args = gin::ConvertToV8(isolate, args);
+    EmitIPCEvent(context, true /* internal */, channel, {}, v8_args,
+                 0 /* sender_id */);
+  }
 }
 #endif
 
@@ -246,6 +318,7 @@ void ElectronApiServiceImpl::UpdateCrashpadPipeName(
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
     TakeHeapSnapshotCallback callback) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
@@ -258,10 +331,62 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   }
   base::File base_file(platform_file);
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  bool success;
+  if (observer) {
+    // The progress is sent while the main thread is busy with the snapshot.
+    mojo::Remote<mojom::HeapSnapshotObserver> remote(std::move(observer));
+    success = electron::TakeHeapSnapshot(
+        blink::MainThreadIsolate(), &base_file,
+        base::BindRepeating(&mojom::HeapSnapshotObserver::OnProgress,
+                            base::Unretained(remote.get())));
+  } else {
+    success =
+        electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  }
 
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::StartSamplingHeapProfiler(
+    uint64_t sampling_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(electron::StartSamplingHeapProfiler(
+      blink::MainThreadIsolate(), sampling_interval, stack_depth));
+}
+
+void ElectronApiServiceImpl::StopSamplingHeapProfiler(
+    StopSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(
+      electron::StopSamplingHeapProfiler(blink::MainThreadIsolate()));
+}
+
+void ElectronApiServiceImpl::StartCPUProfiler(
+    base::TimeDelta sampling_interval,
+    StartCPUProfilerCallback callback) {
+  std::move(callback).Run(electron::StartCPUProfiler(blink::MainThreadIsolate(),
+                                                     sampling_interval));
+}
+
+void ElectronApiServiceImpl::StopCPUProfiler(
+    StopCPUProfilerCallback callback) {
+  std::move(callback).Run(
+      electron::StopCPUProfiler(blink::MainThreadIsolate()));
+}
+
+void ElectronApiServiceImpl::TrimMemory(bool critical,
+                                        TrimMemoryCallback callback) {
+  // Blink and V8 listen to memory pressure, they purge their caches and the
+  // compiled code of functions that did not run recently.
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      critical ? base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL
+               : base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  if (critical) {
+    blink::WebCache::Clear();
+    blink::MainThreadIsolate()->LowMemoryNotification();
+    asar::ClearArchives();
+  }
+  std::move(callback).Run();
+}
+
 }  // namespace electron
@@ -6,7 +6,9 @@
 #define SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
 #include <string>
+#include <vector>
 
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -14,12 +16,15 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 
 namespace electron {
 
 class RendererClientBase;
 
 class ElectronApiServiceImpl : public mojom::ElectronRenderer,
+                               public mojom::ElectronRendererPeer,
                                public content::RenderFrameObserver {
  public:
   ElectronApiServiceImpl(content::RenderFrame* render_frame,
@@ -32,16 +37,42 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                bool send_to_all,
                const std::string& channel,
                blink::CloneableMessage arguments,
+               std::vector<base::ReadOnlySharedMemoryRegion> array_buffers,
                int32_t sender_id) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
+  void ReceiveSharedBuffer(const std::string& channel,
+                           base::UnsafeSharedMemoryRegion region,
+                           blink::TransferableMessage message) override;
+  void BindPeer(
+      int32_t sender_id,
+      mojo::PendingReceiver<mojom::ElectronRendererPeer> receiver) override;
+
+  // mojom::ElectronRendererPeer
+  void PeerMessage(
+      bool internal,
+      const std::string& channel,
+      blink::CloneableMessage arguments,
+      std::vector<base::ReadOnlySharedMemoryRegion> array_buffers) override;
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-  void DereferenceRemoteJSCallback(const std::string& context_id,
-                                   int32_t object_id) override;
+  void DereferenceRemoteJSCallbacks(
+      std::vector<mojom::RemoteCallbackDereferencePtr> callbacks) override;
 #endif
   void UpdateCrashpadPipeName(const std::string& pipe_name) override;
-  void TakeHeapSnapshot(mojo::ScopedHandle file,
-                        TakeHeapSnapshotCallback callback) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
+      TakeHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sampling_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      StopSamplingHeapProfilerCallback callback) override;
+  void StartCPUProfiler(base::TimeDelta sampling_interval,
+                        StartCPUProfilerCallback callback) override;
+  void StopCPUProfiler(StopCPUProfilerCallback callback) override;
+  void TrimMemory(bool critical, TrimMemoryCallback callback) override;
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
@@ -60,6 +91,9 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   bool document_created_ = false;
 
   mojo::AssociatedReceiver<mojom::ElectronRenderer> receiver_{this};
+  // The pipes of the renderers sending messages to this frame, with the ID of
+  // their WebContents.
+  mojo::ReceiverSet<mojom::ElectronRendererPeer, int32_t> peer_receivers_;
 
   RendererClientBase* renderer_client_;
   base::WeakPtrFactory<ElectronApiServiceImpl> weak_factory_;
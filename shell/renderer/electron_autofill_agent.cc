@@ -4,6 +4,7 @@
 
 #include "shell/renderer/electron_autofill_agent.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -23,11 +24,17 @@ namespace electron {
 namespace {
 const size_t kMaxDataLength = 1024;
 const size_t kMaxListSize = 512;
+// The popup is shown with the first suggestions, the rest follow in chunks of
+// this size so that long lists do not hold up the popup.
+const size_t kSuggestionChunkSize = 64;
 
 void GetDataListSuggestions(const blink::WebInputElement& element,
                             std::vector<base::string16>* values,
                             std::vector<base::string16>* labels) {
   for (const auto& option : element.FilteredDataListOptions()) {
+    // The rest would be dropped before being sent anyway.
+    if (values->size() == kMaxListSize)
+      break;
     values->push_back(option.Value().Utf16());
     if (option.Value() != option.Label())
       labels->push_back(option.Label().Utf16());
@@ -178,6 +185,8 @@ bool AutofillAgent::IsUserGesture() const {
 }
 
 void AutofillAgent::HidePopup() {
+  pending_values_.clear();
+  pending_labels_.clear();
   GetAutofillDriver()->HideAutofillPopup();
 }
 
@@ -185,7 +194,41 @@ void AutofillAgent::ShowPopup(const blink::WebFormControlElement& element,
                               const std::vector<base::string16>& values,
                               const std::vector<base::string16>& labels) {
   gfx::RectF bounds = render_frame()->ElementBoundsInWindow(element);
-  GetAutofillDriver()->ShowAutofillPopup(bounds, values, labels);
+  size_t count = std::min(values.size(), kSuggestionChunkSize);
+  GetAutofillDriver()->ShowAutofillPopup(
+      bounds,
+      std::vector<base::string16>(values.begin(), values.begin() + count),
+      std::vector<base::string16>(labels.begin(), labels.begin() + count));
+
+  pending_values_.assign(values.begin() + count, values.end());
+  pending_labels_.assign(labels.begin() + count, labels.end());
+  if (!pending_values_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&AutofillAgent::SendPendingSuggestions,
+                                  weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void AutofillAgent::SendPendingSuggestions() {
+  if (pending_values_.empty())
+    return;
+
+  size_t count = std::min(pending_values_.size(), kSuggestionChunkSize);
+  GetAutofillDriver()->AppendAutofillSuggestions(
+      std::vector<base::string16>(pending_values_.begin(),
+                                  pending_values_.begin() + count),
+      std::vector<base::string16>(pending_labels_.begin(),
+                                  pending_labels_.begin() + count));
+  pending_values_.erase(pending_values_.begin(),
+                        pending_values_.begin() + count);
+  pending_labels_.erase(pending_labels_.begin(),
+                        pending_labels_.begin() + count);
+
+  if (!pending_values_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&AutofillAgent::SendPendingSuggestions,
+                                  weak_ptr_factory_.GetWeakPtr()));
+  }
 }
 
 void AutofillAgent::AcceptDataListSuggestion(const base::string16& suggestion) {
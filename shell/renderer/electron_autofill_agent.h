@@ -65,6 +65,8 @@ class AutofillAgent : public content::RenderFrameObserver,
   void ShowPopup(const blink::WebFormControlElement&,
                  const std::vector<base::string16>&,
                  const std::vector<base::string16>&);
+  // Sends the next chunk of |pending_values_| to the popup.
+  void SendPendingSuggestions();
   void ShowSuggestions(const blink::WebFormControlElement& element,
                        const ShowSuggestionsOptions& options);
 
@@ -82,6 +84,10 @@ class AutofillAgent : public content::RenderFrameObserver,
   // already focused, or if it caused the focus to change.
   bool was_focused_before_now_ = false;
 
+  // The suggestions of the shown popup that are yet to be sent.
+  std::vector<base::string16> pending_values_;
+  std::vector<base::string16> pending_labels_;
+
   mojo::AssociatedReceiver<mojom::ElectronAutofillAgent> receiver_{this};
 
   base::WeakPtrFactory<AutofillAgent> weak_ptr_factory_;
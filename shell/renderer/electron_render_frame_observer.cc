@@ -4,12 +4,16 @@
 
 #include "shell/renderer/electron_render_frame_observer.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
@@ -34,6 +38,39 @@ namespace electron {
 
 namespace {
 
+using ScriptContextWorlds =
+    std::vector<std::pair<v8::Global<v8::Context>, int>>;
+
+// The switches that decide which frames get Electron's scripts, they do not
+// change during the life of the process.
+struct FrameSwitches {
+  FrameSwitches() {
+    auto* command_line = base::CommandLine::ForCurrentProcess();
+    reuse_renderer_processes_enabled = command_line->HasSwitch(
+        switches::kDisableElectronSiteInstanceOverrides);
+    enable_node_leakage =
+        command_line->HasSwitch(switches::kEnableNodeLeakageInRenderers);
+    allow_node_in_sub_frames =
+        command_line->HasSwitch(switches::kNodeIntegrationInSubFrames);
+  }
+
+  bool reuse_renderer_processes_enabled;
+  bool enable_node_leakage;
+  bool allow_node_in_sub_frames;
+};
+
+const FrameSwitches& GetFrameSwitches() {
+  static base::NoDestructor<FrameSwitches> switches;
+  return *switches;
+}
+
+// The world of each script context of the frames of this process, they are
+// only ever touched on the main thread.
+ScriptContextWorlds& GetScriptContextWorlds() {
+  static base::NoDestructor<ScriptContextWorlds> worlds;
+  return *worlds;
+}
+
 scoped_refptr<base::RefCountedMemory> NetResourceProvider(int key) {
   if (key == IDR_DIR_HEADER_HTML) {
     return ui::ResourceBundle::GetSharedInstance().LoadDataResourceBytes(
@@ -61,28 +98,25 @@ void ElectronRenderFrameObserver::DidClearWindowObject() {
 void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
     v8::Handle<v8::Context> context,
     int world_id) {
+  GetScriptContextWorlds().emplace_back(
+      v8::Global<v8::Context>(context->GetIsolate(), context), world_id);
+
   if (ShouldNotifyClient(world_id))
     renderer_client_->DidCreateScriptContext(context, render_frame_);
 
-  auto* command_line = base::CommandLine::ForCurrentProcess();
+  const FrameSwitches& frame_switches = GetFrameSwitches();
 
-  bool use_context_isolation = renderer_client_->isolated_world();
   // This logic matches the EXPLAINED logic in electron_renderer_client.cc
   // to avoid explaining it twice go check that implementation in
-  // DidCreateScriptContext();
-  bool is_main_world = IsMainWorld(world_id);
-  bool is_main_frame = render_frame_->IsMainFrame();
-  bool reuse_renderer_processes_enabled =
-      command_line->HasSwitch(switches::kDisableElectronSiteInstanceOverrides);
-  bool is_not_opened =
-      !render_frame_->GetWebFrame()->Opener() ||
-      command_line->HasSwitch(switches::kEnableNodeLeakageInRenderers);
-  bool allow_node_in_sub_frames =
-      command_line->HasSwitch(switches::kNodeIntegrationInSubFrames);
+  // DidCreateScriptContext(). The cheap checks come first, most contexts are
+  // the ones of sub frames that get no isolated world.
   bool should_create_isolated_context =
-      use_context_isolation && is_main_world &&
-      (is_main_frame || allow_node_in_sub_frames) &&
-      (is_not_opened || reuse_renderer_processes_enabled);
+      renderer_client_->isolated_world() && IsMainWorld(world_id) &&
+      (render_frame_->IsMainFrame() ||
+       frame_switches.allow_node_in_sub_frames) &&
+      (frame_switches.reuse_renderer_processes_enabled ||
+       frame_switches.enable_node_leakage ||
+       !render_frame_->GetWebFrame()->Opener());
 
   if (should_create_isolated_context) {
     CreateIsolatedWorldContext();
@@ -100,6 +134,19 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
 }
 
 void ElectronRenderFrameObserver::DraggableRegionsChanged() {
+  // Blink notifies for every layout that touches a draggable element, which
+  // happens several times per frame during animations.
+  if (draggable_regions_pending_)
+    return;
+  draggable_regions_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&ElectronRenderFrameObserver::SendDraggableRegions,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ElectronRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_pending_ = false;
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<mojom::DraggableRegionPtr> regions;
@@ -111,19 +158,49 @@ void ElectronRenderFrameObserver::DraggableRegionsChanged() {
     regions.push_back(std::move(region));
   }
 
-  mojom::ElectronBrowserPtr browser_ptr;
-  render_frame_->GetRemoteInterfaces()->GetInterface(
-      mojo::MakeRequest(&browser_ptr));
-  browser_ptr->UpdateDraggableRegions(std::move(regions));
+  if (regions.size() == draggable_regions_.size() &&
+      std::equal(regions.begin(), regions.end(), draggable_regions_.begin(),
+                 [](const mojom::DraggableRegionPtr& a,
+                    const mojom::DraggableRegionPtr& b) {
+                   return a.Equals(b);
+                 })) {
+    return;
+  }
+  draggable_regions_.clear();
+  for (const auto& region : regions)
+    draggable_regions_.push_back(region.Clone());
+
+  if (!browser_ptr_ || browser_ptr_.encountered_error()) {
+    browser_ptr_.reset();
+    render_frame_->GetRemoteInterfaces()->GetInterface(
+        mojo::MakeRequest(&browser_ptr_));
+  }
+  browser_ptr_->UpdateDraggableRegions(std::move(regions));
 }
 
 void ElectronRenderFrameObserver::WillReleaseScriptContext(
     v8::Local<v8::Context> context,
     int world_id) {
+  auto& worlds = GetScriptContextWorlds();
+  worlds.erase(std::remove_if(worlds.begin(), worlds.end(),
+                              [&context](const auto& world) {
+                                return world.first == context;
+                              }),
+               worlds.end());
+
   if (ShouldNotifyClient(world_id))
     renderer_client_->WillReleaseScriptContext(context, render_frame_);
 }
 
+// static
+int ElectronRenderFrameObserver::GetWorldId(v8::Local<v8::Context> context) {
+  for (const auto& world : GetScriptContextWorlds()) {
+    if (world.first == context)
+      return world.second;
+  }
+  return -1;
+}
+
 void ElectronRenderFrameObserver::OnDestruct() {
   delete this;
 }
@@ -153,11 +230,9 @@ bool ElectronRenderFrameObserver::IsIsolatedWorld(int world_id) {
 }
 
 bool ElectronRenderFrameObserver::ShouldNotifyClient(int world_id) {
-  bool allow_node_in_sub_frames =
-      base::CommandLine::ForCurrentProcess()->HasSwitch(
-          switches::kNodeIntegrationInSubFrames);
   if (renderer_client_->isolated_world() &&
-      (render_frame_->IsMainFrame() || allow_node_in_sub_frames))
+      (render_frame_->IsMainFrame() ||
+       GetFrameSwitches().allow_node_in_sub_frames))
     return IsIsolatedWorld(world_id);
   else
     return IsMainWorld(world_id);
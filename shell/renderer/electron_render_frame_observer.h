@@ -6,9 +6,12 @@
 #define SHELL_RENDERER_ELECTRON_RENDER_FRAME_OBSERVER_H_
 
 #include <string>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string16.h"
 #include "content/public/renderer/render_frame_observer.h"
+#include "electron/shell/common/api/api.mojom.h"
 #include "ipc/ipc_platform_file.h"
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -34,6 +37,10 @@ class ElectronRenderFrameObserver : public content::RenderFrameObserver {
                                 int world_id) override;
   void OnDestruct() override;
 
+  // Returns the world |context| was created for, or -1 when it is not the
+  // context of a frame.
+  static int GetWorldId(v8::Local<v8::Context> context);
+
  private:
   bool ShouldNotifyClient(int world_id);
   void CreateIsolatedWorldContext();
@@ -41,10 +48,19 @@ class ElectronRenderFrameObserver : public content::RenderFrameObserver {
   bool IsIsolatedWorld(int world_id);
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
                           const std::string& channel);
+  void SendDraggableRegions();
 
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
 
+  // The regions last sent to the browser, which are only sent again when
+  // they change, at most once per task.
+  std::vector<mojom::DraggableRegionPtr> draggable_regions_;
+  bool draggable_regions_pending_ = false;
+  mojom::ElectronBrowserPtr browser_ptr_;
+
+  base::WeakPtrFactory<ElectronRenderFrameObserver> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(ElectronRenderFrameObserver);
 };
 
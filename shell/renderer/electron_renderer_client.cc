@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -74,7 +75,10 @@ void ElectronRendererClient::RunScriptsAtDocumentEnd(
 void ElectronRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> renderer_context,
     content::RenderFrame* render_frame) {
-  RendererClientBase::DidCreateScriptContext(renderer_context, render_frame);
+  // The Node environment is set up again for every context, there is no
+  // snapshot of it to start from: Blink creates the context from its own
+  // snapshot, and Node can't deserialize an environment into it.
+  TRACE_EVENT0("electron", "ElectronRendererClient::DidCreateScriptContext");
 
   // TODO(zcbenz): Do not create Node environment if node integration is not
   // enabled.
@@ -106,6 +110,8 @@ void ElectronRendererClient::DidCreateScriptContext(
     return;
   }
 
+  // Frames without node do not run any of Electron's scripts.
+  RendererClientBase::DidCreateScriptContext(renderer_context, render_frame);
   injected_frames_.insert(render_frame);
 
   // If this is the first environment we are creating, prepare the node
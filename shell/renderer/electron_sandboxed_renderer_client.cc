@@ -4,11 +4,14 @@
 
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 
+#include <memory>
+
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/process/process_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -83,10 +86,58 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
-v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> preloadSrc) {
-  return RendererClientBase::RunScript(isolate->GetCurrentContext(),
-                                       preloadSrc);
+// Compiles and runs the wrapper of a preload script, consuming |code_cache|
+// when one is passed. Returns {fn, codeCache}, where codeCache is only set
+// when there was no usable cache, and holds a new one for the next loads.
+v8::Local<v8::Value> CreatePreloadScript(gin_helper::Arguments* args) {
+  TRACE_EVENT0("electron", "CreatePreloadScript");
+  v8::Isolate* isolate = args->isolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::String> preload_src;
+  if (!args->GetNext(&preload_src)) {
+    args->ThrowError();
+    return v8::Local<v8::Value>();
+  }
+
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  v8::Local<v8::Value> code_cache;
+  if (args->GetNext(&code_cache) && code_cache->IsArrayBufferView()) {
+    auto view = code_cache.As<v8::ArrayBufferView>();
+    size_t length = view->ByteLength();
+    auto* data = new uint8_t[length];
+    view->CopyContents(data, length);
+    cached_data = new v8::ScriptCompiler::CachedData(
+        data, length, v8::ScriptCompiler::CachedData::BufferOwned);
+  }
+
+  // The source takes ownership of |cached_data|.
+  v8::ScriptCompiler::Source source(preload_src, cached_data);
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(context, &source,
+                                   cached_data
+                                       ? v8::ScriptCompiler::kConsumeCodeCache
+                                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script))
+    return v8::Local<v8::Value>();
+
+  v8::Local<v8::Value> fn;
+  if (!script->Run(context).ToLocal(&fn))
+    return v8::Local<v8::Value>();
+
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  result.Set("fn", fn);
+  if (!cached_data || source.GetCachedData()->rejected) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> new_cache(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (new_cache) {
+      auto buffer = v8::ArrayBuffer::New(isolate, new_cache->length);
+      memcpy(buffer->GetBackingStore()->Data(), new_cache->data,
+             new_cache->length);
+      result.Set("codeCache",
+                 v8::Uint8Array::New(buffer, 0, new_cache->length));
+    }
+  }
+  return result.GetHandle();
 }
 
 void InvokeHiddenCallback(v8::Handle<v8::Context> context,
@@ -189,7 +240,8 @@ void ElectronSandboxedRendererClient::RunScriptsAtDocumentEnd(
 void ElectronSandboxedRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
-  RendererClientBase::DidCreateScriptContext(context, render_frame);
+  TRACE_EVENT0("electron",
+               "ElectronSandboxedRendererClient::DidCreateScriptContext");
 
   // Only allow preload for the main frame or
   // For devtools we still want to run the preload_bundle script
@@ -206,6 +258,8 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   if (!should_load_preload)
     return;
 
+  // Frames without preload do not run any of Electron's scripts.
+  RendererClientBase::DidCreateScriptContext(context, render_frame);
   injected_frames_.insert(render_frame);
 
   // Wrap the bundle into a function that receives the binding object as
@@ -48,8 +48,12 @@
 #endif
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+#include "base/threading/thread_task_runner_handle.h"
 #include "components/spellcheck/renderer/spellcheck.h"
 #include "components/spellcheck/renderer/spellcheck_provider.h"
+#include "third_party/blink/public/web/web_document.h"
+#include "third_party/blink/public/web/web_element.h"
+#include "third_party/blink/public/web/web_local_frame.h"
 #endif
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
@@ -93,6 +97,15 @@ std::vector<std::string> ParseSchemesCLISwitch(base::CommandLine* command_line,
                            base::SPLIT_WANT_NONEMPTY);
 }
 
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+bool HasEditableContent(content::RenderFrame* render_frame) {
+  blink::WebDocument document = render_frame->GetWebFrame()->GetDocument();
+  return !document.IsNull() &&
+         !document.QuerySelector("input, textarea, [contenteditable]")
+              .IsNull();
+}
+#endif
+
 }  // namespace
 
 RendererClientBase::RendererClientBase() {
@@ -307,6 +320,14 @@ void RendererClientBase::GetInterface(
 }
 #endif
 
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+void RendererClientBase::WarmUpSpellCheck() {
+  // The dictionaries are memory-mapped read-only from the files the browser
+  // opened, so their pages are shared by all the renderers.
+  spellcheck_->InitializeIfNeeded();
+}
+#endif
+
 void RendererClientBase::DidClearWindowObject(
     content::RenderFrame* render_frame) {
   // Make sure every page will get a script context created.
@@ -419,6 +440,19 @@ void RendererClientBase::RunScriptsAtDocumentIdle(
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions_renderer_client_.get()->RunScriptsAtDocumentIdle(render_frame);
 #endif
+
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+  // Hunspell is otherwise set up from the dictionaries when the first word is
+  // checked, which blocks the first keystrokes in an editable field. Pages
+  // without editable content never check words so they don't pay for it.
+  if (spellcheck_ && !spellcheck_warm_up_scheduled_ &&
+      HasEditableContent(render_frame)) {
+    spellcheck_warm_up_scheduled_ = true;
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&RendererClientBase::WarmUpSpellCheck,
+                                  base::Unretained(this)));
+  }
+#endif
 }
 
 void RendererClientBase::RunScriptsAtDocumentEnd(
@@ -437,16 +471,6 @@ v8::Local<v8::Context> RendererClientBase::GetContext(
     return frame->MainWorldScriptContext();
 }
 
-v8::Local<v8::Value> RendererClientBase::RunScript(
-    v8::Local<v8::Context> context,
-    v8::Local<v8::String> source) {
-  auto maybe_script = v8::Script::Compile(context, source);
-  v8::Local<v8::Script> script;
-  if (!maybe_script.ToLocal(&script))
-    return v8::Local<v8::Value>();
-  return script->Run(context).ToLocalChecked();
-}
-
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 extensions::ExtensionsClient* RendererClientBase::CreateExtensionsClient() {
   return new ElectronExtensionsClient;
@@ -72,9 +72,6 @@ class RendererClientBase : public content::ContentRendererClient
   // Get the context that the Electron API is running in.
   v8::Local<v8::Context> GetContext(blink::WebLocalFrame* frame,
                                     v8::Isolate* isolate) const;
-  // Executes a given v8 Script
-  static v8::Local<v8::Value> RunScript(v8::Local<v8::Context> context,
-                                        v8::Local<v8::String> source);
 
   // v8Util.getHiddenValue(window.frameElement, 'internal')
   bool IsWebViewFrame(v8::Handle<v8::Context> context,
@@ -137,7 +134,10 @@ class RendererClientBase : public content::ContentRendererClient
   int64_t next_context_id_ = 0;
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+  void WarmUpSpellCheck();
+
   std::unique_ptr<SpellCheck> spellcheck_;
+  bool spellcheck_warm_up_scheduled_ = false;
 #endif
 };
 
@@ -8,6 +8,7 @@
 #include "base/threading/thread_local.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
@@ -72,6 +73,9 @@ void WebWorkerObserver::ContextWillDestroy(v8::Local<v8::Context> context) {
   if (env)
     gin_helper::EmitEvent(env->isolate(), env->process_object(), "exit");
 
+  // The isolate of the worker goes away with its context.
+  DisposeCPUProfiler(context->GetIsolate());
+
   delete this;
 }
 
@@ -0,0 +1,50 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "shell/browser/api/message_port.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "shell/utility/node_service.h"
+
+namespace {
+
+// The port entangled with the one of the utility process in the main process,
+// only handed out once.
+v8::Local<v8::Value> TakeParentPort(v8::Isolate* isolate) {
+  electron::NodeService* service = electron::NodeService::Get();
+  if (!service)
+    return v8::Null(isolate);
+  mojo::ScopedMessagePipeHandle handle = service->TakeParentPort();
+  if (!handle.is_valid())
+    return v8::Null(isolate);
+  gin::Handle<electron::MessagePort> port =
+      electron::MessagePort::Create(isolate);
+  port->Entangle(std::move(handle));
+  return port.ToV8();
+}
+
+v8::Local<v8::Value> TakeScriptSource(v8::Isolate* isolate) {
+  electron::NodeService* service = electron::NodeService::Get();
+  base::Optional<std::string> source;
+  if (service)
+    source = service->TakeScriptSource();
+  if (!source)
+    return v8::Null(isolate);
+  return gin::StringToV8(isolate, *source);
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("takeParentPort", &TakeParentPort);
+  dict.SetMethod("takeScriptSource", &TakeScriptSource);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_utility_parent_port, Initialize)
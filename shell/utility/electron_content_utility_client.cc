@@ -15,6 +15,7 @@
 #include "services/proxy_resolver/public/mojom/proxy_resolver.mojom.h"
 #include "services/service_manager/public/cpp/service.h"
 #include "services/service_manager/sandbox/switches.h"
+#include "shell/utility/node_service.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
 #include "components/services/print_compositor/print_compositor_impl.h"
@@ -49,6 +50,10 @@ auto RunPrintCompositor(
 }
 #endif
 
+auto RunNodeService(mojo::PendingReceiver<mojom::NodeService> receiver) {
+  return std::make_unique<NodeService>(std::move(receiver));
+}
+
 auto RunProxyResolver(
     mojo::PendingReceiver<proxy_resolver::mojom::ProxyResolverFactory>
         receiver) {
@@ -108,9 +113,10 @@ ElectronContentUtilityClient::GetMainThreadServiceFactory() {
 #if BUILDFLAG(ENABLE_PRINTING)
     RunPrintCompositor,
 #if defined(OS_WIN)
-        RunPrintingService
+        RunPrintingService,
 #endif
 #endif
+        RunNodeService
   };
   return factory.get();
 }
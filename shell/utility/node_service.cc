@@ -0,0 +1,107 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/utility/node_service.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/process/process_handle.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/api/electron_bindings.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_bindings.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+namespace {
+
+NodeService* g_node_service = nullptr;
+
+}  // namespace
+
+NodeService::NodeService(mojo::PendingReceiver<mojom::NodeService> receiver)
+    : receiver_(this, std::move(receiver)) {
+  DCHECK(!g_node_service);
+  g_node_service = this;
+}
+
+NodeService::~NodeService() {
+  g_node_service = nullptr;
+  if (!node_env_)
+    return;
+  node_bindings_->set_uv_env(nullptr);
+  js_env_->OnMessageLoopDestroying();
+}
+
+// static
+NodeService* NodeService::Get() {
+  return g_node_service;
+}
+
+mojo::ScopedMessagePipeHandle NodeService::TakeParentPort() {
+  return std::move(parent_port_);
+}
+
+base::Optional<std::string> NodeService::TakeScriptSource() {
+  return std::move(script_source_);
+}
+
+void NodeService::Initialize(mojom::NodeServiceParamsPtr params,
+                             InitializeCallback callback) {
+  // A process runs a single environment.
+  if (node_env_) {
+    std::move(callback).Run(base::GetCurrentProcId());
+    return;
+  }
+
+  parent_port_ = std::move(params->port);
+  script_source_ = std::move(params->source);
+
+  // Answer before the script runs, it may keep the process busy for long and
+  // the main process needs the pid to terminate it.
+  std::move(callback).Run(base::GetCurrentProcId());
+
+  node_bindings_.reset(
+      NodeBindings::Create(NodeBindings::BrowserEnvironment::UTILITY));
+  electron_bindings_ =
+      std::make_unique<ElectronBindings>(node_bindings_->uv_loop());
+  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+
+  v8::Isolate* isolate = js_env_->isolate();
+  v8::HandleScope scope(isolate);
+
+  node_bindings_->Initialize();
+  node::Environment* env = node_bindings_->CreateEnvironment(
+      js_env_->context(), js_env_->platform());
+  node_env_ = std::make_unique<NodeEnvironment>(env);
+  electron_bindings_->BindTo(isolate, env->process_object());
+
+  // The init script is followed by the script of the service and its
+  // arguments, instead of the switches of the utility process.
+  gin_helper::Dictionary process(isolate, env->process_object());
+  std::vector<v8::Local<v8::Value>> argv;
+  v8::Local<v8::Array> original_argv;
+  if (process.Get("argv", &original_argv) && original_argv->Length() >= 2) {
+    v8::Local<v8::Context> context = js_env_->context();
+    argv.push_back(original_argv->Get(context, 0).ToLocalChecked());
+    argv.push_back(original_argv->Get(context, 1).ToLocalChecked());
+  }
+  argv.push_back(gin::ConvertToV8(isolate, params->script));
+  for (const auto& arg : params->args)
+    argv.push_back(gin::StringToV8(isolate, arg));
+  process.Set("argv", argv);
+
+  node_bindings_->LoadEnvironment(env);
+  node_bindings_->set_uv_env(env);
+
+  js_env_->OnMessageLoopCreated();
+  node_bindings_->PrepareMessageLoop();
+  node_bindings_->RunMessageLoop();
+}
+
+}  // namespace electron
@@ -0,0 +1,61 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_UTILITY_NODE_SERVICE_H_
+#define SHELL_UTILITY_NODE_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/optional.h"
+#include "electron/shell/common/api/node_service.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/system/message_pipe.h"
+
+namespace electron {
+
+class ElectronBindings;
+class JavascriptEnvironment;
+class NodeBindings;
+class NodeEnvironment;
+
+// Hosts the Node.js environment of a utility process started by the
+// utilityProcess module. The environment runs on the main thread of the
+// process, with its libuv loop embedded in the message loop of the thread
+// like in the browser process.
+class NodeService : public mojom::NodeService {
+ public:
+  explicit NodeService(mojo::PendingReceiver<mojom::NodeService> receiver);
+  ~NodeService() override;
+
+  // The service of this process, if it was started.
+  static NodeService* Get();
+
+  // Called by the parent_port binding while the environment bootstraps.
+  mojo::ScopedMessagePipeHandle TakeParentPort();
+  base::Optional<std::string> TakeScriptSource();
+
+  // mojom::NodeService:
+  void Initialize(mojom::NodeServiceParamsPtr params,
+                  InitializeCallback callback) override;
+
+ private:
+  mojo::Receiver<mojom::NodeService> receiver_;
+
+  std::unique_ptr<NodeBindings> node_bindings_;
+  std::unique_ptr<ElectronBindings> electron_bindings_;
+  std::unique_ptr<JavascriptEnvironment> js_env_;
+  std::unique_ptr<NodeEnvironment> node_env_;
+
+  mojo::ScopedMessagePipeHandle parent_port_;
+  base::Optional<std::string> script_source_;
+
+  DISALLOW_COPY_AND_ASSIGN(NodeService);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_UTILITY_NODE_SERVICE_H_
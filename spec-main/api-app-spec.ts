@@ -5,7 +5,7 @@ import * as http from 'http';
 import * as net from 'net';
 import * as fs from 'fs';
 import * as path from 'path';
-import { app, BrowserWindow, Menu, session } from 'electron';
+import { app, BrowserWindow, ipcMain, Menu, session } from 'electron';
 import { emittedOnce } from './events-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
 import { ifdescribe } from './spec-helpers';
@@ -208,6 +208,41 @@ describe('app module', () => {
     });
   });
 
+  describe('v8CodeCache in package.json', () => {
+    const appPath = path.join(fixturesPath, 'api', 'main-code-cache');
+    const cachePath = path.join(app.getPath('appData'), 'electron-main-code-cache-spec', 'Main Code Cache');
+
+    const runApp = async () => {
+      const appProcess = cp.spawn(process.execPath, [appPath]);
+      let output = '';
+      appProcess.stdout.on('data', data => { output += data; });
+      const [code] = await emittedOnce(appProcess, 'exit');
+      expect(code).to.equal(0);
+      return JSON.parse(output.trim().split('\n').pop()!);
+    };
+
+    beforeEach(() => {
+      fs.rmdirSync(path.dirname(cachePath), { recursive: true });
+    });
+    after(() => {
+      fs.rmdirSync(path.dirname(cachePath), { recursive: true });
+    });
+
+    it('keeps the code caches of the modules of the app', async () => {
+      expect(await runApp()).to.have.property('value', 'from lib');
+      const caches = fs.readdirSync(path.join(cachePath, '1.0.0'));
+      expect(caches).to.not.be.empty();
+      expect(await runApp()).to.have.property('value', 'from lib');
+      expect(fs.readdirSync(path.join(cachePath, '1.0.0'))).to.deep.equal(caches);
+    });
+
+    it('leaves import() as it is without the cache', async () => {
+      // Compiled by Node here, as the spec process keeps no code caches.
+      const imported = await require(path.join(appPath, 'import-lib.js'));
+      expect(await runApp()).to.have.property('imported', imported);
+    });
+  });
+
   describe('app.requestSingleInstanceLock', () => {
     it('prevents the second launch of app', function (done) {
       this.timeout(120000);
@@ -1044,6 +1079,86 @@ describe('app module', () => {
     });
   });
 
+  describe('getStartupTimings() API', () => {
+    it('returns the milestones in the order they are reached', async () => {
+      await app.whenReady();
+      const timings = app.getStartupTimings();
+      const milestones = ['basicStartupComplete', 'resourceBundleLoaded', 'nodeInitialized', 'mainScriptEvaluated', 'preMainMessageLoopRun', 'ready'] as const;
+      for (const milestone of milestones) {
+        expect(timings[milestone]).to.be.a('number').that.is.at.least(0);
+      }
+      for (let i = 1; i < milestones.length; i++) {
+        expect(timings[milestones[i]]).to.be.at.least(timings[milestones[i - 1]]!);
+      }
+    });
+  });
+
+  describe('startEventLoopMonitor() API', () => {
+    afterEach(() => app.stopEventLoopMonitor());
+
+    it('emits main-thread-blocked when the main thread is blocked', async () => {
+      app.startEventLoopMonitor({ threshold: 50, sampleInterval: 10, captureStack: true });
+      const blocked = emittedOnce(app, 'main-thread-blocked');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 200;
+        while (Date.now() < end);
+      }, 20);
+      const [, details] = await blocked;
+      expect(details.duration).to.be.at.least(50);
+      expect(details.source).to.be.oneOf(['task-queue', 'uv-loop']);
+      const lag = app.getEventLoopLag();
+      expect(lag.taskQueueing.count).to.be.at.least(1);
+      expect(lag.taskQueueing.max).to.be.at.least(50);
+      expect(lag.uvLoop.buckets).to.have.lengthOf(14);
+    });
+
+    it('captures the JavaScript stack that blocked the main thread', async () => {
+      app.startEventLoopMonitor({ threshold: 50, sampleInterval: 10, captureStack: true });
+      const blocked = emittedOnce(app, 'main-thread-blocked');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 200;
+        while (Date.now() < end);
+      }, 20);
+      const [, details] = await blocked;
+      expect(details.stack).to.match(/at blockMainThread \(/);
+    });
+
+    it('does not capture the stack by default', async () => {
+      app.startEventLoopMonitor({ threshold: 50, sampleInterval: 10 });
+      const blocked = emittedOnce(app, 'main-thread-blocked');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 200;
+        while (Date.now() < end);
+      }, 20);
+      const [, details] = await blocked;
+      expect(details.stack).to.be.undefined();
+    });
+
+    it('throws for a non-positive threshold', () => {
+      expect(() => app.startEventLoopMonitor({ threshold: 0 })).to.throw(/must be positive/);
+    });
+  });
+
+  describe('requestIdleCallback() API', () => {
+    it('calls back with a deadline when idle', async () => {
+      const deadline = await new Promise<Electron.IdleDeadline>(resolve => app.requestIdleCallback(resolve));
+      expect(deadline.didTimeout).to.be.false('did time out');
+      expect(deadline.timeRemaining()).to.be.within(0, 50);
+    });
+
+    it('does not call cancelled callbacks', async () => {
+      let called = false;
+      const id = app.requestIdleCallback(() => { called = true; });
+      app.cancelIdleCallback(id);
+      await new Promise(resolve => app.requestIdleCallback(resolve));
+      expect(called).to.be.false('called');
+    });
+
+    it('validates its options', () => {
+      expect(() => app.requestIdleCallback(() => {}, { timeout: -1 })).to.throw(/timeout must be a non-negative number/);
+    });
+  });
+
   describe('getAppMetrics() API', () => {
     it('returns memory and cpu stats of all running electron processes', () => {
       const appMetrics = app.getAppMetrics();
@@ -1062,10 +1177,15 @@ describe('app module', () => {
         expect(entry.memory).to.have.property('workingSetSize').that.is.greaterThan(0);
         expect(entry.memory).to.have.property('peakWorkingSetSize').that.is.greaterThan(0);
 
-        if (process.platform === 'win32') {
+        if (process.platform === 'win32' || process.platform === 'linux') {
           expect(entry.memory).to.have.property('privateBytes').that.is.greaterThan(0);
         }
 
+        if (process.platform === 'linux') {
+          expect(entry.memory).to.have.property('sharedBytes').that.is.a('number');
+          expect(entry.memory).to.have.property('swapBytes').that.is.a('number');
+        }
+
         if (process.platform !== 'linux') {
           expect(entry.sandboxed).to.be.a('boolean');
         }
@@ -1083,6 +1203,61 @@ describe('app module', () => {
     });
   });
 
+  describe('getAppMemoryDetails() API', () => {
+    it('returns the memory breakdown of the processes', async () => {
+      const details = await app.getAppMemoryDetails();
+      const browser = details.find(entry => entry.pid === process.pid);
+      expect(browser).to.not.be.undefined();
+      expect(browser!.type).to.equal('Browser');
+      expect(browser!.private).to.be.a('number').that.is.greaterThan(0);
+      expect(browser!.shared).to.be.a('number');
+    });
+  });
+
+  describe('setAppMetricsSamplingInterval() API', () => {
+    afterEach(() => {
+      app.setAppMetricsSamplingInterval(0);
+    });
+
+    it('emits samples of the metrics', async () => {
+      app.setAppMetricsSamplingInterval(50);
+      expect(app.getAppMetricsSamplingInterval()).to.equal(50);
+      const [, first] = await emittedOnce(app, 'app-metrics-updated');
+      expect(first.metrics).to.be.an('array').that.is.not.empty();
+      expect(first.added).to.include(process.pid);
+      const [, second] = await emittedOnce(app, 'app-metrics-updated');
+      expect(second.added).to.not.include(process.pid);
+      expect(second.removed).to.be.an('array');
+      expect(second.memoryChanges).to.be.an('array');
+    });
+
+    it('throws for a negative interval', () => {
+      expect(() => app.setAppMetricsSamplingInterval(-1)).to.throw(/non-negative integer/);
+    });
+  });
+
+  describe('getIPCMetrics() API', () => {
+    afterEach(closeAllWindows);
+
+    it('counts the messages received and sent on each channel', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const received = emittedOnce(ipcMain, 'ipc-metrics-test');
+      w.webContents.executeJavaScript(`require('electron').ipcRenderer.send('ipc-metrics-test', 'hello')`);
+      await received;
+      w.webContents.send('ipc-metrics-test', 'world');
+
+      const metrics = app.getIPCMetrics().find(m => m.channel === 'ipc-metrics-test');
+      expect(metrics).to.not.be.undefined();
+      expect(metrics!.messagesReceived).to.equal(1);
+      expect(metrics!.bytesReceived).to.be.greaterThan(0);
+      expect(metrics!.handlerTime).to.be.a('number').that.is.at.least(0);
+      expect(metrics!.maxHandlerTime).to.be.at.most(metrics!.handlerTime);
+      expect(metrics!.messagesSent).to.equal(1);
+      expect(metrics!.bytesSent).to.be.greaterThan(0);
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
@@ -1256,6 +1431,14 @@ describe('app module', () => {
     });
   });
 
+  describe('enableParallelDownloads() API', () => {
+    it('throws when called after app is ready', () => {
+      expect(() => {
+        app.enableParallelDownloads({ requestCount: 4 });
+      }).to.throw(/before app is ready/);
+    });
+  });
+
   const dockDescribe = process.platform === 'darwin' ? describe : describe.skip;
   dockDescribe('dock APIs', () => {
     after(async () => {
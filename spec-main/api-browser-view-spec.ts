@@ -157,6 +157,39 @@ describe('BrowserView module', () => {
     });
   });
 
+  describe('BrowserWindow.setBrowserViewBounds()', () => {
+    it('sets the bounds of all the views', () => {
+      const view1 = new BrowserView();
+      const view2 = new BrowserView();
+      w.addBrowserView(view1);
+      w.addBrowserView(view2);
+      const bounds1 = { x: 0, y: 0, width: 100, height: 200 };
+      const bounds2 = { x: 100, y: 0, width: 300, height: 200 };
+      w.setBrowserViewBounds([{ view: view1, bounds: bounds1 }, { view: view2, bounds: bounds2 }]);
+      expect(view1.getBounds()).to.deep.equal(bounds1);
+      expect(view2.getBounds()).to.deep.equal(bounds2);
+      view1.destroy();
+      view2.destroy();
+    });
+
+    it('moves no view if one is not attached', () => {
+      const view1 = new BrowserView();
+      const view2 = new BrowserView();
+      w.addBrowserView(view1);
+      const bounds = { x: 10, y: 20, width: 30, height: 40 };
+      view1.setBounds(bounds);
+      expect(() => {
+        w.setBrowserViewBounds([
+          { view: view1, bounds: { x: 0, y: 0, width: 1, height: 1 } },
+          { view: view2, bounds: { x: 0, y: 0, width: 1, height: 1 } }
+        ]);
+      }).to.throw(/not attached/);
+      expect(view1.getBounds()).to.deep.equal(bounds);
+      view1.destroy();
+      view2.destroy();
+    });
+  });
+
   describe('BrowserWindow.getBrowserViews()', () => {
     it('returns same views as was added', () => {
       const view1 = new BrowserView();
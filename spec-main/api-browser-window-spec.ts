@@ -5,10 +5,10 @@ import * as os from 'os';
 import * as qs from 'querystring';
 import * as http from 'http';
 import { AddressInfo } from 'net';
-import { app, BrowserWindow, BrowserView, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents } from 'electron';
+import { app, BrowserWindow, BrowserView, ipcMain, nativeImage, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, Session, WebContents } from 'electron';
 
 import { emittedOnce } from './events-helpers';
-import { ifit, ifdescribe } from './spec-helpers';
+import { ifit, ifdescribe, delay } from './spec-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
 
 const fixtures = path.resolve(__dirname, '..', 'spec', 'fixtures');
@@ -814,6 +814,39 @@ describe('BrowserWindow module', () => {
 
         expectBoundsEqual(w.getSize(), size);
       });
+
+      it('emits a single resize with the bounds when coalesceBoundsEvents is set', async () => {
+        const coalesced = new BrowserWindow({ show: false, coalesceBoundsEvents: true });
+        try {
+          const resized = emittedOnce(coalesced, 'resize');
+          coalesced.setSize(300, 300);
+          await resized;
+          // Let the frame of the first event pass.
+          await delay(100);
+
+          const events: Electron.Rectangle[] = [];
+          coalesced.on('resize', (event: any, bounds: Electron.Rectangle) => { events.push(bounds); });
+          for (let i = 1; i <= 10; i++) {
+            coalesced.setSize(300 + i * 10, 300 + i * 10);
+          }
+          // Long enough for a frame even on a loaded machine.
+          await delay(500);
+          // The resizes are coalesced, and the last event has the bounds the
+          // window ended up with.
+          expect(events).to.have.length.within(1, 9);
+          expect(events[events.length - 1]).to.deep.equal(coalesced.getBounds());
+          expectBoundsEqual(coalesced.getSize(), [400, 400]);
+        } finally {
+          coalesced.destroy();
+        }
+      });
+
+      it('emits resize to the listeners added after removeAllListeners()', async () => {
+        w.removeAllListeners();
+        const resized = emittedOnce(w, 'resize');
+        w.setSize(320, 420);
+        await resized;
+      });
     });
 
     describe('BrowserWindow.setMinimum/MaximumSize(width, height)', () => {
@@ -1166,6 +1199,27 @@ describe('BrowserWindow module', () => {
       // Values can be 0,2,3,4, or 6. We want 6, which is RGB + Alpha
       expect(imgBuffer[25]).to.equal(6);
     });
+
+    it('scales and encodes the capture', async () => {
+      const w = new BrowserWindow({ show: false, width: 400, height: 400 });
+      w.loadURL('about:blank');
+      await emittedOnce(w, 'ready-to-show');
+      w.show();
+
+      const image = await w.capturePage(undefined, { size: { width: 100, height: 50 } });
+      expect(image.getSize()).to.deep.equal({ width: 100, height: 50 });
+
+      const png = await w.capturePageToBuffer(undefined, { size: { width: 100, height: 50 } });
+      expect(nativeImage.createFromBuffer(png).getSize()).to.deep.equal({ width: 100, height: 50 });
+
+      const jpeg = await w.capturePageToBuffer(undefined, { format: 'jpeg', quality: 50 });
+      expect(jpeg.slice(0, 2)).to.deep.equal(Buffer.from([0xff, 0xd8]));
+    });
+
+    it('rejects unsupported formats', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.capturePageToBuffer(undefined, { format: 'gif' })).to.eventually.be.rejectedWith('Unsupported format: gif');
+    });
   });
 
   describe('BrowserWindow.setProgressBar(progress)', () => {
@@ -1434,6 +1488,19 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.getWindowCount()', () => {
+    afterEach(closeAllWindows);
+    it('returns the number of opened windows', async () => {
+      expect(BrowserWindow.getWindowCount()).to.equal(0);
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      expect(BrowserWindow.getWindowCount()).to.equal(2);
+      await closeWindow(w1, { assertNotWindows: false });
+      expect(BrowserWindow.getWindowCount()).to.equal(1);
+      expect(BrowserWindow.getAllWindows()).to.deep.equal([w2]);
+    });
+  });
+
   describe('BrowserWindow.fromWebContents(webContents)', () => {
     afterEach(closeAllWindows);
 
@@ -1976,6 +2043,56 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload');
       });
 
+      describe('preload code cache', () => {
+        // The renderer only sends a code cache back when it had none it could
+        // use, so no new cache means the one it was given was consumed.
+        const loadAndCountNewCaches = async (ses: Session, load: (w: BrowserWindow) => Promise<void>) => {
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload,
+              session: ses
+            }
+          });
+          let newCaches = 0;
+          w.webContents.on('-ipc-message' as any, (event: any, internal: boolean, channel: string) => {
+            if (internal && channel === 'ELECTRON_BROWSER_PRELOAD_CODE_CACHE') newCaches++;
+          });
+          const answer = emittedOnce(ipcMain, 'answer');
+          await load(w);
+          await answer;
+          // The cache is sent after the preload script ran.
+          await delay(100);
+          w.destroy();
+          return newCaches;
+        };
+        const loadFile = (w: BrowserWindow) => w.loadFile(path.join(fixtures, 'api', 'preload.html'));
+
+        it('runs the preload script from its code cache on later loads', async () => {
+          const ses = session.fromPartition(`${Math.random()}`);
+          expect(await loadAndCountNewCaches(ses, loadFile)).to.equal(1);
+          expect(await loadAndCountNewCaches(ses, loadFile)).to.equal(0);
+        });
+
+        it('does not use the code cache of another origin', async () => {
+          const server = http.createServer((req, res) => {
+            fs.createReadStream(path.join(fixtures, 'api', 'preload.html')).pipe(res);
+          });
+          await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+          const { port } = server.address() as AddressInfo;
+          try {
+            const ses = session.fromPartition(`${Math.random()}`);
+            expect(await loadAndCountNewCaches(ses, loadFile)).to.equal(1);
+            const loadHttp = (w: BrowserWindow) => w.loadURL(`http://127.0.0.1:${port}/`);
+            expect(await loadAndCountNewCaches(ses, loadHttp)).to.equal(1);
+            expect(await loadAndCountNewCaches(ses, loadHttp)).to.equal(0);
+          } finally {
+            server.close();
+          }
+        });
+      });
+
       it('exposes ipcRenderer to preload script (path has special chars)', async () => {
         const preloadSpecialChars = path.join(fixtures, 'module', 'preload-sandboxæø åü.js');
         const w = new BrowserWindow({
@@ -2905,6 +3022,56 @@ describe('BrowserWindow module', () => {
       });
     });
 
+    it('subscribes to scaled frames next to full size ones', async () => {
+      const w = new BrowserWindow({ show: false, width: 400, height: 400 });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const full = new Promise<Electron.NativeImage>(resolve => {
+        w.webContents.beginFrameSubscription(resolve);
+      });
+      const thumbnail = new Promise<Electron.NativeImage>(resolve => {
+        w.webContents.beginFrameSubscription({ size: { width: 100, height: 100 }, frameRate: 10 }, resolve);
+      });
+      const [fullImage, thumbnailImage] = await Promise.all([full, thumbnail]);
+      w.webContents.endFrameSubscription();
+      expect(thumbnailImage.getSize().width).to.be.at.most(100);
+      expect(thumbnailImage.getSize().height).to.be.at.most(100);
+      expect(fullImage.getSize().width).to.be.above(100);
+    });
+
+    it('subscribes to i420 frames', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const [data, rect] = await new Promise<[Buffer, Electron.Rectangle]>(resolve => {
+        w.webContents.beginFrameSubscription({ format: 'i420' }, (data: Buffer, rect) => resolve([data, rect]));
+      });
+      w.webContents.endFrameSubscription();
+      const chroma = Math.ceil(rect.width / 2) * Math.ceil(rect.height / 2);
+      expect(data.length).to.equal(rect.width * rect.height + 2 * chroma);
+    });
+
+    it('subscribes to raw bgra and nv12 frames', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const capture = (format: string) => new Promise<[Buffer, Electron.Rectangle]>(resolve => {
+        const id = w.webContents.beginFrameSubscription({ format }, (data: Buffer, rect) => {
+          w.webContents.endFrameSubscription(id);
+          resolve([data, rect]);
+        });
+      });
+      const [bgra, bgraRect] = await capture('bgra');
+      expect(bgra.length).to.equal(bgraRect.width * bgraRect.height * 4);
+      const [nv12, nv12Rect] = await capture('nv12');
+      const chroma = Math.ceil(nv12Rect.width / 2) * Math.ceil(nv12Rect.height / 2);
+      expect(nv12.length).to.equal(nv12Rect.width * nv12Rect.height + 2 * chroma);
+    });
+
+    it('throws when asked to encode with an unknown codec', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.startVideoEncode({ codec: 'foo' as any }, () => {});
+      }).to.throw(/codec/);
+    });
+
     it('subscribes to frame updates (only dirty rectangle)', (done) => {
       const w = new BrowserWindow({ show: false });
       let called = false;
@@ -2980,6 +3147,35 @@ describe('BrowserWindow module', () => {
       expect(fs.existsSync(savePageJsPath)).to.be.true('js path');
       expect(fs.existsSync(savePageCssPath)).to.be.true('css path');
     });
+
+    it('limits how many pages are saved at once', async () => {
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      await w1.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+      await w2.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+
+      fs.mkdirSync(savePageDir, { recursive: true });
+      webContents.setMaxConcurrentSavePages(1);
+      try {
+        const order: number[] = [];
+        await Promise.all([
+          w1.webContents.savePage(path.join(savePageDir, 'first.mhtml'), 'MHTML').then(() => order.push(1)),
+          w2.webContents.savePage(path.join(savePageDir, 'second.mhtml'), 'MHTML').then(() => order.push(2))
+        ]);
+        expect(order).to.deep.equal([1, 2]);
+        expect(fs.existsSync(path.join(savePageDir, 'first.mhtml'))).to.be.true();
+        expect(fs.existsSync(path.join(savePageDir, 'second.mhtml'))).to.be.true();
+      } finally {
+        webContents.setMaxConcurrentSavePages(0);
+        for (const name of ['first.mhtml', 'second.mhtml']) {
+          try { fs.unlinkSync(path.join(savePageDir, name)); } catch {}
+        }
+      }
+    });
+
+    it('throws for an invalid limit', () => {
+      expect(() => webContents.setMaxConcurrentSavePages(-1)).to.throw(RangeError);
+    });
   });
 
   describe('BrowserWindow options argument is optional', () => {
@@ -3951,6 +4147,77 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
     });
 
+    it('tags frames with their timing', async () => {
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [event] = await emittedOnce(w.webContents, 'paint');
+      const { received, delivered } = event.frameTiming;
+      expect(received).to.be.a('number');
+      expect(delivered).to.be.at.least(received);
+    });
+
+    it('passes only the dirty area with offscreenOnlyDirty', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          offscreenOnlyDirty: true
+        }
+      });
+      c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [, rect, data] = await emittedOnce(c.webContents, 'paint');
+      expect(data.getSize()).to.deep.equal({ width: rect.width, height: rect.height });
+    });
+
+    it('paints when begin frames are issued with offscreenExternalBeginFrames', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          offscreenExternalBeginFrames: true
+        }
+      });
+      const timer = setInterval(() => c.webContents.beginFrame(), 16);
+      try {
+        c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const [, , data] = await emittedOnce(c.webContents, 'paint');
+        expect(data.isEmpty()).to.be.false('data is empty');
+      } finally {
+        clearInterval(timer);
+      }
+    });
+
+    it('paints with offscreenSharedBeginFrames', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          offscreenSharedBeginFrames: true
+        }
+      });
+      try {
+        c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const [, , data] = await emittedOnce(c.webContents, 'paint');
+        expect(data.isEmpty()).to.be.false('data is empty');
+
+        // The page is static, so only the invalidation produces a frame.
+        const painted = emittedOnce(c.webContents, 'paint');
+        c.webContents.invalidate();
+        const [, rect] = await painted;
+        expect(rect.width).to.be.greaterThan(0);
+      } finally {
+        c.destroy();
+      }
+    });
+
     it('does not crash after navigation', () => {
       w.webContents.loadURL('about:blank');
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
@@ -126,4 +126,26 @@ ifdescribe(!(process.platform === 'linux' && ['arm', 'arm64'].includes(process.a
       expect(resultFilePath).to.be.a('string').that.is.not.empty('result path');
     });
   });
+
+  describe('dumpRingBuffer', function () {
+    this.timeout(5e3);
+
+    it('rejects when there is no recording in progress', async () => {
+      await app.whenReady();
+      await expect(contentTracing.dumpRingBuffer(outputFilePath)).to.eventually.be.rejectedWith('There is no recording in progress');
+    });
+
+    it('writes the trace and keeps recording', async () => {
+      await app.whenReady();
+      await contentTracing.startRecording({ recording_mode: 'record-continuously', trace_buffer_size_in_kb: 1024 });
+      await timeout(10);
+      const resultFilePath = await contentTracing.dumpRingBuffer(outputFilePath);
+      expect(resultFilePath).to.equal(outputFilePath);
+      expect(fs.statSync(outputFilePath).size).to.be.above(0);
+
+      const secondFilePath = await contentTracing.stopRecording();
+      expect(secondFilePath).to.be.a('string').that.is.not.empty('result path');
+      expect(fs.statSync(secondFilePath).size).to.be.above(0);
+    });
+  });
 });
@@ -250,6 +250,26 @@ describe('contextBridge', () => {
         expect(result).to.equal(124);
       });
 
+      it('should reuse the proxy of a function passed more than once', async () => {
+        await makeBindingWindow(() => {
+          const listeners = new Set();
+          contextBridge.exposeInMainWorld('example', {
+            addListener: (fn: any) => listeners.add(fn),
+            removeListener: (fn: any) => listeners.delete(fn),
+            getListenerCount: () => listeners.size
+          });
+        });
+        const result = await callWithBindings(async (root: any) => {
+          const listener = () => {};
+          root.example.addListener(listener);
+          root.example.addListener(listener);
+          const added = root.example.getListenerCount();
+          root.example.removeListener(listener);
+          return [added, root.example.getListenerCount()];
+        });
+        expect(result).to.deep.equal([1, 0]);
+      });
+
       it('should proxy promises in the reverse direction', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', {
@@ -306,6 +326,66 @@ describe('contextBridge', () => {
         expect(result).to.deep.equal([true, true]);
       });
 
+      it('should materialize lazy APIs on first access', async () => {
+        await makeBindingWindow(() => {
+          const reads: string[] = [];
+          const api = {
+            get first () { reads.push('first'); return { nested: 1 }; },
+            get second () { reads.push('second'); return 2; },
+            getReads: () => reads
+          };
+          contextBridge.exposeInMainWorld('example', api, { lazy: true });
+        });
+        const result = await callWithBindings((root: any) => {
+          const before = [...root.example.getReads()];
+          const first = root.example.first;
+          const again = root.example.first;
+          return [
+            before,
+            root.example.getReads(),
+            first === again,
+            first.nested,
+            Object.isFrozen(root.example),
+            Object.isFrozen(first),
+            Object.keys(root.example)
+          ];
+        });
+        expect(result).to.deep.equal([
+          [],
+          ['first'],
+          true,
+          1,
+          true,
+          true,
+          ['first', 'second', 'getReads']
+        ]);
+      });
+
+      it('should share array buffers when asked to', async () => {
+        await makeBindingWindow(() => {
+          const buffer = new ArrayBuffer(16);
+          contextBridge.exposeInMainWorld('example', {
+            getView: () => new Float32Array(buffer, 4, 2),
+            readByte: (view: Uint8Array) => view[0],
+            readShared: () => new Float32Array(buffer)[1]
+          }, { shareArrayBuffers: true });
+        });
+        const result = await callWithBindings((root: any) => {
+          const view = root.example.getView();
+          view[0] = 42;
+          const bytes = new Uint8Array(8);
+          bytes[0] = 7;
+          return [
+            Object.getPrototypeOf(view) === Float32Array.prototype,
+            view.byteOffset,
+            view.length,
+            root.example.readShared(),
+            root.example.readByte(bytes)
+          ];
+        });
+        expect(result).to.deep.equal([true, 4, 2, 42, 7]);
+      });
+
       it('it should handle recursive objects', async () => {
         await makeBindingWindow(() => {
           const o: any = { value: 135 };
@@ -11,6 +11,7 @@ import { ipcMain, app, BrowserWindow, crashReporter, BrowserWindowConstructorOpt
 import { AddressInfo } from 'net';
 import { closeWindow, closeAllWindows } from './window-helpers';
 import { EventEmitter } from 'events';
+import { emittedOnce } from './events-helpers';
 
 temp.track();
 
@@ -156,6 +157,25 @@ ifdescribe(!process.mas && !process.env.DISABLE_CRASH_REPORTER_TESTS && process.
         });
       });
 
+      it('should send a report without crashing when the renderer hangs', async () => {
+        const { port, waitForCrash } = await startServer();
+        w.loadFile(path.join(fixtures, 'api', 'crash-hang.html'), { query: { port: port.toString() } });
+        const [crash] = await Promise.all([waitForCrash(), emittedOnce(ipcMain, 'hang-done')]);
+        checkCrash('renderer', crash);
+        expect(String((crash as any)['electron-hang-js-stack'])).to.contain('spin');
+        expect(w.webContents.isCrashed()).to.be.false('renderer crashed');
+      });
+
+      ifit(!browserWindowOpts.webPreferences!.sandbox)('should send a report without crashing when the main process hangs', async () => {
+        const { port, waitForCrash } = await startServer();
+        const appPath = path.join(fixtures, 'api', 'crash-hang-app');
+        const appProcess = childProcess.spawn(process.execPath, [appPath, port.toString(), app.getPath('temp'), app.name, app.getVersion()]);
+        const [crash, [code]] = await Promise.all([waitForCrash(), emittedOnce(appProcess, 'exit')]);
+        checkCrash('browser', crash);
+        expect(String((crash as any)['electron-hang-js-stack'])).to.contain('spin');
+        expect(code).to.equal(0, 'main process crashed');
+      });
+
       it('should send minidump with updated extra parameters', async function () {
         const { port, waitForCrash } = await startServer();
 
@@ -205,6 +225,15 @@ ifdescribe(!process.mas && !process.env.DISABLE_CRASH_REPORTER_TESTS && process.
         });
       }).to.not.throw();
     });
+    it('rejects an invalid hangTimeout', () => {
+      expect(() => {
+        crashReporter.start({
+          companyName: 'Umbrella Corporation',
+          submitURL: 'http://127.0.0.1/crashes',
+          hangTimeout: -1
+        });
+      }).to.throw('hangTimeout must be a positive number');
+    });
   });
 
   describe('getCrashesDirectory', () => {
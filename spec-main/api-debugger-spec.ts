@@ -204,6 +204,44 @@ describe('debugger module', () => {
       });
     });
 
+    it('only emits the events allowed by setEventOptions', async () => {
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setEventOptions({ methods: ['Runtime.*'], format: 'string' });
+      const methods: string[] = [];
+      w.webContents.debugger.on('message', (event, method, message) => {
+        expect(message).to.be.a('string');
+        expect(JSON.parse(message).method).to.equal(method);
+        methods.push(method);
+      });
+      await w.webContents.debugger.sendCommand('Page.enable');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      await w.loadURL('about:blank');
+      expect(methods).to.not.be.empty();
+      expect(methods.every(method => method.startsWith('Runtime.'))).to.be.true();
+    });
+
+    it('emits batches of events with a batchInterval', async () => {
+      w.webContents.debugger.attach();
+      // Long enough for both messages to land in the same batch.
+      w.webContents.debugger.setEventOptions({ methods: ['Runtime.consoleAPICalled'], batchInterval: 1000 });
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      const batch = emittedOnce(w.webContents.debugger, 'message-batch');
+      let messageCount = 0;
+      w.webContents.debugger.on('message', () => { messageCount++; });
+      await w.webContents.executeJavaScript('console.log("a"); console.log("b")');
+      const [, messages] = await batch;
+      expect(messageCount).to.equal(0);
+      expect(messages.map((m: any) => m.method)).to.deep.equal(['Runtime.consoleAPICalled', 'Runtime.consoleAPICalled']);
+      expect(messages.map((m: any) => m.params.args[0].value)).to.deep.equal(['a', 'b']);
+    });
+
+    it('throws for an invalid format', () => {
+      w.webContents.debugger.attach();
+      expect(() => {
+        w.webContents.debugger.setEventOptions({ format: 'xml' as any });
+      }).to.throw(/'format' must be/);
+    });
+
     it('does not crash for invalid unicode characters in message', (done) => {
       try {
         w.webContents.debugger.attach();
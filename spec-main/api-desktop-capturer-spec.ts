@@ -48,6 +48,47 @@ ifdescribe(features.isDesktopCapturerEnabled() && !process.arch.includes('arm')
     await expect(promise2).to.eventually.be.fulfilled();
   });
 
+  // Linux doesn't return any window sources.
+  ifit(process.platform !== 'linux')('reports the window sources before resolving with onSourceUpdated', async () => {
+    const w2 = new BrowserWindow({ width: 200, height: 200 });
+    const { updated, sources } = await w.webContents.executeJavaScript(`
+      new Promise((resolve, reject) => {
+        const updated = [];
+        require('electron').desktopCapturer.getSources({
+          types: ['window', 'screen'],
+          onSourceUpdated: source => updated.push(source.id)
+        }).then(sources => resolve({ updated, sources: sources.map(s => s.id) }), reject);
+      })
+    `);
+    w2.destroy();
+    expect(updated).to.be.an('array').that.is.not.empty();
+    for (const id of updated) {
+      expect(id).to.match(/^window:/);
+    }
+    expect(sources).to.include.members(updated);
+  });
+
+  // Linux doesn't return any window sources.
+  ifit(process.platform !== 'linux')('reports the sources of a watcher as they change', async () => {
+    const sources = await w.webContents.executeJavaScript(`
+      new Promise((resolve) => {
+        const watcher = require('electron').desktopCapturer.watchSources({ types: ['window', 'screen'] });
+        const added = [];
+        watcher.on('source-added', source => {
+          added.push(source.id);
+          if (added.length === 1) {
+            setTimeout(() => {
+              watcher.stop();
+              resolve({ added, current: watcher.getSources().map(s => s.id) });
+            }, 1000);
+          }
+        });
+      })
+    `);
+    expect(sources.added).to.be.an('array').that.is.not.empty();
+    expect(sources.current).to.include.members(sources.added);
+  });
+
   // Linux doesn't return any window sources.
   ifit(process.platform !== 'linux')('returns an empty display_id for window sources on Windows and Mac', async () => {
     const w = new BrowserWindow({ width: 200, height: 200 });
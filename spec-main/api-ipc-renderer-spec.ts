@@ -52,6 +52,23 @@ describe('ipcRenderer module', () => {
       expect(Buffer.from(data).equals(received)).to.be.true();
     });
 
+    it('can send large instances of ArrayBuffer and typed arrays', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const bytes = new Uint8Array(4 * 1024 * 1024).map((_, i) => i % 251)
+        ipcRenderer.send('message', bytes.buffer, bytes.subarray(16, 32), { nested: bytes })
+      }`);
+      const [, buffer, view, { nested }] = await emittedOnce(ipcMain, 'message');
+      expect(buffer).to.be.an.instanceOf(ArrayBuffer);
+      expect(buffer.byteLength).to.equal(4 * 1024 * 1024);
+      const bytes = new Uint8Array(buffer);
+      expect(bytes[1000]).to.equal(1000 % 251);
+      expect(bytes[bytes.length - 1]).to.equal((bytes.length - 1) % 251);
+      expect(Array.from(view)).to.deep.equal(Array.from(bytes.subarray(16, 32)));
+      expect(nested.length).to.equal(bytes.length);
+      expect(nested[1000]).to.equal(1000 % 251);
+    });
+
     it('throws when sending objects with DOM class prototypes', async () => {
       await expect(w.webContents.executeJavaScript(`{
         const { ipcRenderer } = require('electron')
@@ -115,6 +132,123 @@ describe('ipcRenderer module', () => {
     });
   });
 
+  describe('sendBatched()', () => {
+    it('delivers messages in order', async () => {
+      const received: number[] = [];
+      const done = new Promise<void>(resolve => {
+        ipcMain.on('batched-message', function listener (event, value) {
+          received.push(value);
+          if (received.length === 2000) {
+            ipcMain.removeListener('batched-message', listener);
+            resolve();
+          }
+        });
+      });
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        for (let i = 0; i < 2000; i++) ipcRenderer.sendBatched('batched-message', i)
+      }`);
+      await done;
+      expect(received).to.deep.equal([...Array(2000).keys()]);
+    });
+
+    it('delivers queued messages before other messages', async () => {
+      const received: string[] = [];
+      const done = new Promise<void>(resolve => {
+        ipcMain.on('batched-order', function listener (event, value) {
+          received.push(value);
+          if (received.length === 3) {
+            ipcMain.removeListener('batched-order', listener);
+            resolve();
+          }
+        });
+      });
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.sendBatched('batched-order', 'first')
+        ipcRenderer.send('batched-order', 'second')
+        ipcRenderer.sendBatched('batched-order', 'third')
+      }`);
+      await done;
+      expect(received).to.deep.equal(['first', 'second', 'third']);
+    });
+
+    it('serializes the arguments when called', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const obj = { value: 'before' }
+        ipcRenderer.sendBatched('message', obj)
+        obj.value = 'after'
+      }`);
+      const [, received] = await emittedOnce(ipcMain, 'message');
+      expect(received).to.deep.equal({ value: 'before' });
+    });
+
+    it('sends large ArrayBuffers intact', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const bytes = new Uint8Array(4 * 1024 * 1024)
+        bytes[bytes.length - 1] = 42
+        ipcRenderer.sendBatched('message', [bytes])
+      }`);
+      const [, [received]] = await emittedOnce(ipcMain, 'message');
+      expect(received).to.be.an.instanceOf(Uint8Array);
+      expect(received.length).to.equal(4 * 1024 * 1024);
+      expect(received[received.length - 1]).to.equal(42);
+    });
+
+    it('counts queued messages towards the high water mark', async () => {
+      const result = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setHighWaterMark(1024)
+        const small = ipcRenderer.sendBatched('backpressure', 'x')
+        const large = ipcRenderer.sendBatched('backpressure', 'x'.repeat(4096))
+        const pending = ipcRenderer.getQueueStats()
+        await ipcRenderer.whenDrained()
+        const drained = ipcRenderer.getQueueStats()
+        ipcRenderer.setHighWaterMark(0)
+        return { small, large, pending, drained }
+      })()`);
+      expect(result.small).to.be.true();
+      expect(result.large).to.be.false();
+      expect(result.pending.pendingMessages).to.equal(2);
+      expect(result.drained.pendingMessages).to.equal(0);
+      expect(result.drained.pendingBytes).to.equal(0);
+    });
+  });
+
+  describe('setHighWaterMark()', () => {
+    it('reports backpressure until the main process handles the messages', async () => {
+      const result = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setHighWaterMark(1024)
+        const small = ipcRenderer.send('backpressure', 'x')
+        const large = ipcRenderer.send('backpressure', 'x'.repeat(4096))
+        const pending = ipcRenderer.getQueueStats()
+        await ipcRenderer.whenDrained()
+        const drained = ipcRenderer.getQueueStats()
+        ipcRenderer.setHighWaterMark(0)
+        return { small, large, pending, drained }
+      })()`);
+      expect(result.small).to.be.true();
+      expect(result.large).to.be.false();
+      expect(result.pending.pendingMessages).to.equal(2);
+      expect(result.pending.pendingBytes).to.be.greaterThan(4096);
+      expect(result.pending.highWaterMark).to.equal(1024);
+      expect(result.drained.pendingBytes).to.be.lessThan(1024);
+    });
+
+    it('does not account messages without a high water mark', async () => {
+      const result = await w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron')
+        const sent = ipcRenderer.send('backpressure', 'x'.repeat(4096))
+        return { sent, stats: ipcRenderer.getQueueStats() }
+      })()`);
+      expect(result.sent).to.be.true();
+      expect(result.stats).to.deep.equal({ pendingMessages: 0, pendingBytes: 0, highWaterMark: 0 });
+    });
+  });
+
   describe('sendSync()', () => {
     it('can be replied to by setting event.returnValue', async () => {
       ipcMain.once('echo', (event, msg) => {
@@ -165,6 +299,33 @@ describe('ipcRenderer module', () => {
           })`);
           expect(data).to.equal(payload);
         });
+
+        it('keeps messages in order', async () => {
+          const data = await w.webContents.executeJavaScript(`new Promise(resolve => {
+            const { ipcRenderer } = require('electron')
+            const received = []
+            ipcRenderer.on('pong', function listener (event, data) {
+              received.push(data)
+              if (received.length === 100) {
+                ipcRenderer.removeListener('pong', listener)
+                resolve(received)
+              }
+            })
+            for (let i = 0; i < 100; i++) ipcRenderer.sendTo(${contents.id}, 'ping', i)
+          })`);
+          expect(data).to.deep.equal([...Array(100).keys()]);
+        });
+
+        it('sends messages to WebContents after it reloads', async () => {
+          const ping = () => w.webContents.executeJavaScript(`new Promise(resolve => {
+            const { ipcRenderer } = require('electron')
+            ipcRenderer.sendTo(${contents.id}, 'ping', ${JSON.stringify(payload)})
+            ipcRenderer.once('pong', (event, data) => resolve(data))
+          })`);
+          expect(await ping()).to.equal(payload);
+          await contents.loadURL('about:blank');
+          expect(await ping()).to.equal(payload);
+        });
       });
     };
 
@@ -1,5 +1,6 @@
 import { EventEmitter } from 'events';
 import { expect } from 'chai';
+import * as path from 'path';
 import { BrowserWindow, ipcMain, IpcMainInvokeEvent, MessageChannelMain } from 'electron';
 import { closeAllWindows } from './window-helpers';
 import { emittedOnce } from './events-helpers';
@@ -121,6 +122,48 @@ describe('ipc module', () => {
     });
   });
 
+  describe('worker pools', () => {
+    const script = path.join(__dirname, 'fixtures', 'api', 'ipc-worker-pool', 'handlers.js');
+    let w = (null as unknown as BrowserWindow);
+    let pool: Electron.IpcWorkerPool | null = null;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+    });
+    after(() => {
+      w.destroy();
+    });
+    afterEach(() => {
+      if (pool) pool.close();
+      pool = null;
+    });
+
+    it('handles invokes in a worker thread', async () => {
+      pool = ipcMain.createWorkerPool(script, { size: 2 });
+      pool.handle('add');
+      const result = await w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'add\', 1, 2)');
+      expect(result.sum).to.equal(3);
+      expect(result.threadId).to.be.above(0);
+      expect(result.senderId).to.equal(w.webContents.id);
+    });
+
+    it('rejects with the error of the handler', async () => {
+      pool = ipcMain.createWorkerPool(script, { size: 1 });
+      pool.handle('fail');
+      await expect(w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'fail\')'))
+        .to.eventually.be.rejectedWith(/failed in the worker/);
+    });
+
+    it('stops handling the channels once closed', async () => {
+      pool = ipcMain.createWorkerPool(script, { size: 1 });
+      pool.handle('add');
+      pool.close();
+      await expect(w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'add\', 1, 2)'))
+        .to.eventually.be.rejectedWith(/No handler registered/);
+    });
+  });
+
   describe('ordering', () => {
     let w = (null as unknown as BrowserWindow);
 
@@ -198,6 +241,181 @@ describe('ipc module', () => {
     });
   });
 
+  describe('serialization', () => {
+    afterEach(closeAllWindows);
+
+    it('keeps the structure of plain values', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const p = emittedOnce(ipcMain, 'values');
+      w.webContents.executeJavaScript(`(${function () {
+        const shared = { a: 1 };
+        const cyclic: any = { name: 'ü' };
+        cyclic.self = cyclic;
+        const bytes = new Uint8Array([1, 2, 3, 4]);
+        const holey = [1, , 3]; // eslint-disable-line no-sparse-arrays
+        require('electron').ipcRenderer.send('values', {
+          numbers: [0, -1, 2 ** 31, 1.5, -0, NaN],
+          strings: ['', 'ascii', '\u2603'],
+          shared: [shared, shared],
+          cyclic,
+          holey,
+          views: [bytes, bytes.subarray(1, 3)]
+        });
+      }})()`);
+      const [, value] = await p;
+      expect(value.numbers.slice(0, 4)).to.deep.equal([0, -1, 2 ** 31, 1.5]);
+      expect(Object.is(value.numbers[4], -0)).to.be.true();
+      expect(value.numbers[5]).to.be.NaN();
+      expect(value.strings).to.deep.equal(['', 'ascii', '\u2603']);
+      expect(value.shared[0]).to.equal(value.shared[1]);
+      expect(value.cyclic.self).to.equal(value.cyclic);
+      expect(value.cyclic.name).to.equal('ü');
+      expect(value.holey).to.have.lengthOf(3);
+      expect(1 in value.holey).to.be.false();
+      expect(value.views[0]).to.be.an.instanceOf(Uint8Array);
+      expect(value.views[0].buffer).to.equal(value.views[1].buffer);
+      expect(Array.from(value.views[1])).to.deep.equal([2, 3]);
+    });
+
+    it('falls back to the full serializer for other values', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const p = emittedOnce(ipcMain, 'values');
+      w.webContents.executeJavaScript(`(${function () {
+        require('electron').ipcRenderer.send('values', {
+          plain: { a: 1 },
+          date: new Date(0)
+        });
+      }})()`);
+      const [, value] = await p;
+      expect(value.plain).to.deep.equal({ a: 1 });
+      expect(value.date).to.be.an.instanceOf(Date);
+      expect(value.date.getTime()).to.equal(0);
+    });
+
+    it('keeps large ArrayBuffers nested in objects intact', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const p = emittedOnce(ipcMain, 'values');
+      w.webContents.executeJavaScript(`(${function () {
+        const bytes = new Uint8Array(4 * 1024 * 1024);
+        bytes[bytes.length - 1] = 42;
+        require('electron').ipcRenderer.send('values', { file: { bytes } });
+      }})()`);
+      const [, value] = await p;
+      expect(value.file.bytes).to.be.an.instanceOf(Uint8Array);
+      expect(value.file.bytes.length).to.equal(4 * 1024 * 1024);
+      expect(value.file.bytes[value.file.bytes.length - 1]).to.equal(42);
+    });
+
+    it('runs getters once when looking for large ArrayBuffers', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const p = emittedOnce(ipcMain, 'values');
+      const calls = await w.webContents.executeJavaScript(`(${function () {
+        let calls = 0;
+        const files: any[] = [new Uint8Array(2 * 1024 * 1024)];
+        Object.defineProperty(files, 1, { enumerable: true, get: () => { calls++; return 'b'; } });
+        files[1000000] = new Uint8Array(2 * 1024 * 1024);
+        require('electron').ipcRenderer.send('values', files);
+        return calls;
+      }})()`);
+      expect(calls).to.equal(1);
+      const [, value] = await p;
+      expect(value).to.have.lengthOf(1000001);
+      expect(value[0]).to.be.an.instanceOf(Uint8Array);
+      expect(value[1]).to.equal('b');
+      expect(2 in value).to.be.false();
+      expect(value[1000000]).to.be.an.instanceOf(Uint8Array);
+    });
+
+    it('throws for views of a SharedArrayBuffer', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const thrown = await w.webContents.executeJavaScript(`(${function () {
+        try {
+          require('electron').ipcRenderer.send('values', new Uint8Array(new SharedArrayBuffer(4)));
+          return false;
+        } catch {
+          return true;
+        }
+      }})()`);
+      expect(thrown).to.be.true();
+    });
+
+    it('runs getters once when the value needs the full serializer', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      ipcMain.handleOnce('values', (e, value) => value);
+      const p = emittedOnce(ipcMain, 'values');
+      const [calls, invoked] = await w.webContents.executeJavaScript(`(${async function () {
+        const { ipcRenderer } = require('electron');
+        let calls = 0;
+        const value = {
+          get counted () { calls++; return 'getter'; },
+          date: new Date(0)
+        };
+        ipcRenderer.send('values', value);
+        const sendCalls = calls;
+        const invoked = await ipcRenderer.invoke('values', value);
+        return [[sendCalls, calls - sendCalls], invoked.counted];
+      }})()`);
+      expect(calls).to.deep.equal([1, 1]);
+      expect(invoked).to.equal('getter');
+      const [, value] = await p;
+      expect(value.counted).to.equal('getter');
+      expect(value.date).to.be.an.instanceOf(Date);
+    });
+  });
+
+  describe('sync messages', () => {
+    afterEach(closeAllWindows);
+    afterEach(() => { ipcMain.removeAllListeners('test-sync'); });
+
+    it('records the time the renderer was blocked', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      ipcMain.on('test-sync', (e) => { setTimeout(() => { e.returnValue = 'ok'; }, 50); });
+      const result = await w.webContents.executeJavaScript(`(${function () {
+        const { ipcRenderer } = require('electron');
+        return [ipcRenderer.sendSync('test-sync'), ipcRenderer.sendSync('test-sync')];
+      }})()`);
+      expect(result).to.deep.equal(['ok', 'ok']);
+      const metrics = w.webContents.getSyncMessageMetrics()['test-sync'];
+      expect(metrics.count).to.equal(2);
+      expect(metrics.deadlineExceededCount).to.equal(0);
+      expect(metrics.maxTime).to.be.at.least(40);
+      expect(metrics.totalTime).to.be.at.least(metrics.maxTime);
+    });
+
+    it('fails sendSync once the deadline is exceeded', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      w.webContents.setSyncMessageDeadline(10, 'fail');
+      ipcMain.on('test-sync', (e) => { setTimeout(() => { e.returnValue = 'late'; }, 200); });
+      const exceeded = emittedOnce(w.webContents, 'sync-message-deadline-exceeded');
+      const error = await w.webContents.executeJavaScript(`(${function () {
+        try {
+          require('electron').ipcRenderer.sendSync('test-sync');
+        } catch (e) {
+          return e.message;
+        }
+      }})()`);
+      expect(error).to.match(/did not receive a reply before the deadline/);
+      const [, channel] = await exceeded;
+      expect(channel).to.equal('test-sync');
+      expect(w.webContents.getSyncMessageMetrics()['test-sync'].deadlineExceededCount).to.equal(1);
+    });
+
+    it('throws on an invalid deadline action', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setSyncMessageDeadline(10, 'explode' as any);
+      }).to.throw(/action must be 'log' or 'fail'/);
+    });
+  });
+
   describe('MessagePort', () => {
     afterEach(closeAllWindows);
 
@@ -216,6 +434,21 @@ describe('ipc module', () => {
       expect(port).to.be.an.instanceOf(EventEmitter);
     });
 
+    it('can transfer an ArrayBuffer to the main process', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      w.loadURL('about:blank');
+      const p = emittedOnce(ipcMain, 'buffer');
+      const byteLength = await w.webContents.executeJavaScript(`(${function () {
+        const buffer = new Uint8Array([1, 2, 3]).buffer;
+        require('electron').ipcRenderer.postMessage('buffer', { buffer }, [buffer]);
+        return buffer.byteLength;
+      }})()`);
+      expect(byteLength).to.equal(0);
+      const [ev, msg] = await p;
+      expect(ev.ports).to.have.length(0);
+      expect(Array.from(new Uint8Array(msg.buffer))).to.deep.equal([1, 2, 3]);
+    });
+
     it('can communicate between main and renderer', async () => {
       const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
       w.loadURL('about:blank');
@@ -464,6 +697,22 @@ describe('ipc module', () => {
         expect(msg).to.deep.equal({ some: 'message' });
       });
 
+      it('transfers ArrayBuffers', async () => {
+        const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+        w.loadURL('about:blank');
+        await w.webContents.executeJavaScript(`(${function () {
+          const { ipcRenderer } = require('electron');
+          ipcRenderer.on('foo', (e, msg) => {
+            ipcRenderer.send('bar', Array.from(new Uint8Array(msg)));
+          });
+        }})()`);
+        const buffer = new Uint8Array([1, 2, 3]).buffer;
+        w.webContents.postMessage('foo', buffer, [buffer]);
+        expect(buffer.byteLength).to.equal(0);
+        const [, msg] = await emittedOnce(ipcMain, 'bar');
+        expect(msg).to.deep.equal([1, 2, 3]);
+      });
+
       describe('error handling', () => {
         it('throws on missing channel', async () => {
           const w = new BrowserWindow({ show: false });
@@ -209,6 +209,50 @@ describe('MenuItems', () => {
     });
   });
 
+  describe('MenuItem label, sublabel and toolTip', () => {
+    it('are updated in the menu of the item', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'first' },
+        { label: 'parent', submenu: [{ label: 'child', sublabel: 'sub', toolTip: 'tip' }] }
+      ]);
+      menu.items[0].label = 'changed';
+      expect((menu as any).getLabelAt(0)).to.equal('changed');
+
+      const submenu = menu.items[1].submenu!;
+      submenu.items[0].label = 'changed child';
+      submenu.items[0].sublabel = 'changed sub';
+      submenu.items[0].toolTip = 'changed tip';
+      expect((submenu as any).getLabelAt(0)).to.equal('changed child');
+      expect((submenu as any).getSublabelAt(0)).to.equal('changed sub');
+      expect((submenu as any).getToolTipAt(0)).to.equal('changed tip');
+    });
+  });
+
+  describe('MenuItem with populateSubmenu', () => {
+    it('fills in the submenu each time it is shown', () => {
+      let count = 0;
+      const item = new MenuItem({
+        label: 'Open Recent',
+        populateSubmenu: (submenu) => {
+          count++;
+          for (let i = 0; i < count; i++) {
+            submenu.append(new MenuItem({ label: `file ${i}` }));
+          }
+        }
+      });
+      expect(item.type).to.equal('submenu');
+      const submenu = item.submenu!;
+      expect(submenu.items).to.have.lengthOf(0);
+
+      submenu.emit('menu-will-show');
+      expect(submenu.items).to.have.lengthOf(1);
+
+      submenu.emit('menu-will-show');
+      expect(submenu.items.map(item => item.label)).to.deep.equal(['file 0', 'file 1']);
+      expect((submenu as any).getItemCount()).to.equal(2);
+    });
+  });
+
   describe('MenuItem with invalid type', () => {
     it('throws an exception', () => {
       expect(() => {
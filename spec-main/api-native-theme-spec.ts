@@ -1,10 +1,11 @@
 import { expect } from 'chai';
-import { nativeTheme, systemPreferences } from 'electron';
+import { BrowserWindow, nativeTheme, systemPreferences } from 'electron';
 import * as os from 'os';
 import * as semver from 'semver';
 
 import { delay, ifdescribe } from './spec-helpers';
 import { emittedOnce } from './events-helpers';
+import { closeAllWindows } from './window-helpers';
 
 describe('nativeTheme module', () => {
   describe('nativeTheme.shouldUseDarkColors', () => {
@@ -75,4 +76,25 @@ describe('nativeTheme module', () => {
       expect(nativeTheme.shouldUseHighContrastColors).to.be.a('boolean');
     });
   });
+
+  describe('nativeTheme in renderers', () => {
+    afterEach(async () => {
+      await closeAllWindows();
+      nativeTheme.themeSource = 'system';
+      await delay(20);
+    });
+
+    it('reads the values of the main process', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const read = () => w.webContents.executeJavaScript(`(() => {
+        const { nativeTheme } = require('electron');
+        return [nativeTheme.themeSource, nativeTheme.shouldUseDarkColors];
+      })()`);
+      nativeTheme.themeSource = 'dark';
+      expect(await read()).to.deep.equal(['dark', true]);
+      nativeTheme.themeSource = 'light';
+      expect(await read()).to.deep.equal(['light', false]);
+    });
+  });
 });
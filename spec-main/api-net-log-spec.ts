@@ -86,6 +86,20 @@ describe('netLog module', () => {
     expect(() => testNetLog().startLogging('aoeu', { maxFileSize: null as any })).to.throw();
   });
 
+  it('should write a snapshot and keep logging when .snapshot() is called', async () => {
+    await testNetLog().startLogging(dumpFileDynamic, { maxFileSize: 1024 * 1024 });
+    await testNetLog().snapshot(dumpFile);
+    expect(fs.existsSync(dumpFile)).to.be.true('snapshot exists');
+    expect(() => JSON.parse(fs.readFileSync(dumpFile, 'utf8'))).to.not.throw();
+    expect(testNetLog().currentlyLogging).to.be.true('currently logging');
+
+    await expect(testNetLog().stopLogging()).to.eventually.be.fulfilled();
+  });
+
+  it('should throw an error when .snapshot() is called without calling .startLogging()', async () => {
+    await expect(testNetLog().snapshot(dumpFile)).to.be.rejectedWith('No net log in progress');
+  });
+
   it('should include cookies when requested', async () => {
     await testNetLog().startLogging(dumpFileDynamic, { captureMode: 'includeSensitive' });
     const unique = require('uuid').v4();
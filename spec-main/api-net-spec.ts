@@ -1,9 +1,13 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow } from 'electron';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
+import { delay } from './spec-helpers';
 
 const kOneKiloByte = 1024;
 const kOneMegaByte = kOneKiloByte * kOneKiloByte;
@@ -1368,6 +1372,95 @@ describe('net module', () => {
     });
   });
 
+  describe('response body options', () => {
+    it('emits the body in chunks of chunkSize', async () => {
+      const body = randomBuffer(kOneMegaByte + 1000);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        for (let i = 0; i < body.length; i += 3000) {
+          response.write(body.slice(i, i + 3000));
+        }
+        response.end();
+      });
+      const response = await getResponse(net.request({ url: serverUrl, chunkSize: 64 * kOneKiloByte }));
+      const chunks: Buffer[] = [];
+      response.on('data', chunk => chunks.push(chunk));
+      await emittedOnce(response, 'end');
+      expect(chunks.slice(0, -1).every(chunk => chunk.length === 64 * kOneKiloByte)).to.be.true('full chunks');
+      expect(chunks[chunks.length - 1].length).to.equal(body.length % (64 * kOneKiloByte));
+      expect(Buffer.concat(chunks).equals(body)).to.be.true('same body');
+    });
+
+    it('writes the body to savePath', async () => {
+      const body = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(body);
+      });
+      const savePath = path.join(os.tmpdir(), `electron-net-save-${Math.random()}`);
+      const response = await getResponse(net.request({ url: serverUrl, savePath }));
+      expect(response.statusCode).to.equal(200);
+      expect(await collectStreamBodyBuffer(response)).to.have.lengthOf(0);
+      try {
+        expect(fs.readFileSync(savePath).equals(body)).to.be.true('same body');
+      } finally {
+        fs.unlinkSync(savePath);
+      }
+    });
+  });
+
+  describe('net.createRequestPool()', () => {
+    it('limits how many requests run at once', async () => {
+      const held: http.ServerResponse[] = [];
+      const serverUrl = await respondNTimes.toSingleURL((request, response) => {
+        held.push(response);
+      }, 4);
+      const pool = net.createRequestPool({ maxConcurrentRequests: 2 });
+      const responses = [1, 2, 3, 4].map(() => getResponse(pool.request(serverUrl)));
+      while (held.length < 2) {
+        await delay(10);
+      }
+      expect(pool.activeRequestCount).to.equal(2);
+      expect(pool.pendingRequestCount).to.equal(2);
+      while (held.length < 4) {
+        held.filter(response => !response.finished).forEach(response => response.end());
+        await delay(10);
+      }
+      held.forEach(response => response.end());
+      for (const response of await Promise.all(responses)) {
+        expect(response.statusCode).to.equal(200);
+        expect(response.protocol).to.equal('http/1.1');
+        await collectStreamBody(response);
+      }
+    });
+
+    it('starts the pending requests by priority', async () => {
+      const order: string[] = [];
+      let finishFirst: (() => void) | null = null;
+      const serverUrl = await respondNTimes((request, response) => {
+        order.push(request.url!);
+        if (request.url === '/first') {
+          finishFirst = () => response.end();
+        } else {
+          response.end();
+        }
+      }, 3);
+      const pool = net.createRequestPool({ maxConcurrentRequests: 1 });
+      const first = getResponse(pool.request(`${serverUrl}/first`));
+      const low = getResponse(pool.request({ url: `${serverUrl}/low`, priority: 'low' }));
+      const highest = getResponse(pool.request({ url: `${serverUrl}/highest`, priority: 'highest' }));
+      while (!finishFirst) {
+        await delay(10);
+      }
+      finishFirst!();
+      await Promise.all([first, low, highest]);
+      expect(order).to.deep.equal(['/first', '/highest', '/low']);
+    });
+
+    it('validates its options', () => {
+      expect(() => net.createRequestPool({ maxConcurrentRequests: 0 })).to.throw(/maxConcurrentRequests/);
+      expect(() => net.createRequestPool({ priority: 'urgent' as any })).to.throw(/Invalid request priority/);
+    });
+  });
+
   describe('Stability and performance', () => {
     it('should free unreferenced, never-started request objects without crash', (done) => {
       net.request('https://test');
@@ -1,5 +1,7 @@
 import { expect } from 'chai';
 import { Notification } from 'electron';
+import { emittedOnce } from './events-helpers';
+import { ifit } from './spec-helpers';
 
 describe('Notification module', () => {
   it('inits, gets and sets basic string properties correctly', () => {
@@ -92,5 +94,65 @@ describe('Notification module', () => {
     expect(n.actions[1].text).to.equal('4');
   });
 
+  it('inits, gets and sets the group id correctly', () => {
+    const n = new Notification({ title: 'title', groupId: 'group' });
+    expect(n.groupId).to.equal('group');
+    n.groupId = 'group1';
+    expect(n.groupId).to.equal('group1');
+  });
+
+  ifit(process.platform === 'darwin')('closes the shown notification of its group when shown', async () => {
+    const first = new Notification({ title: '1', groupId: 'replaced', silent: true });
+    const second = new Notification({ title: '2', groupId: 'replaced', silent: true });
+    const other = new Notification({ title: '3', groupId: 'other', silent: true });
+    let otherClosed = false;
+    other.once('close', () => { otherClosed = true; });
+    try {
+      first.show();
+      other.show();
+      const closed = emittedOnce(first, 'close');
+      second.show();
+      await closed;
+      expect(otherClosed).to.be.false('other group closed');
+    } finally {
+      second.close();
+      other.close();
+    }
+  });
+
   // TODO(sethlu): Find way to test init with notification icon?
+
+  describe('Notification.createGroup', () => {
+    it('validates its arguments', () => {
+      expect(() => Notification.createGroup('')).to.throw(/groupId must be a non-empty string/);
+      expect(() => Notification.createGroup('group', { coalesceDelay: -1 })).to.throw(/coalesceDelay must be a non-negative number/);
+    });
+
+    it('summarizes the notifications added during coalesceDelay', async () => {
+      const group = Notification.createGroup('group', {
+        coalesceDelay: 100,
+        silent: true,
+        summary: (notifications) => ({ title: `${notifications.length} notifications` })
+      });
+      const shown: any[] = [];
+      group.on('show', (notifications) => shown.push(notifications));
+      try {
+        group.add({ title: '1' });
+        group.add({ title: '2' });
+        group.add({ title: '3' });
+        expect(group.pendingCount).to.equal(2);
+        expect(group.notification!.title).to.equal('1');
+        expect(group.notification!.groupId).to.equal('group');
+        expect(group.notification!.silent).to.be.true('silent');
+
+        await new Promise(resolve => setTimeout(resolve, 200));
+        expect(group.pendingCount).to.equal(0);
+        expect(shown.map(notifications => notifications.length)).to.deep.equal([1, 2]);
+        expect(group.notification!.title).to.equal('2 notifications');
+      } finally {
+        group.close();
+      }
+      expect(() => group.add({ title: '4' })).to.throw(/The notification group is closed/);
+    });
+  });
 });
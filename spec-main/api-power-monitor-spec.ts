@@ -8,7 +8,9 @@
 // python-dbusmock.
 import { expect } from 'chai';
 import * as dbus from 'dbus-native';
+import { BrowserWindow } from 'electron';
 import { ifdescribe } from './spec-helpers';
+import { closeAllWindows } from './window-helpers';
 import { promisify } from 'util';
 
 describe('powerMonitor', () => {
@@ -172,5 +174,108 @@ describe('powerMonitor', () => {
         expect(idleTime).to.be.at.least(0);
       });
     });
+
+    describe('powerMonitor.isOnBatteryPower', () => {
+      it('returns a boolean', () => {
+        expect(powerMonitor.isOnBatteryPower()).to.be.a('boolean');
+      });
+    });
+
+    describe('powerMonitor.setPowerPolicy', () => {
+      afterEach(() => {
+        powerMonitor.setPowerPolicy(null);
+      });
+
+      it('validates the policy', () => {
+        expect(() => {
+          powerMonitor.setPowerPolicy({ thermalState: 'warm' as any });
+        }).to.throw(/Invalid thermal state 'warm'/);
+        expect(() => {
+          powerMonitor.setPowerPolicy({ offscreenFrameRate: -1 });
+        }).to.throw(/offscreenFrameRate must be a non-negative integer/);
+      });
+
+      it('is not in low power mode without a policy', () => {
+        powerMonitor.setPowerPolicy(null);
+        expect(powerMonitor.isLowPowerMode()).to.be.false('low power mode');
+      });
+
+      it('runs the work of a class', async () => {
+        powerMonitor.registerWorkClass('spec', { deferInLowPowerMode: false });
+        const result = await powerMonitor.runWork('spec', () => 42);
+        expect(result).to.equal(42);
+      });
+
+      it('rejects the work of an unknown class', async () => {
+        await expect(powerMonitor.runWork('unknown', () => {})).to.eventually.be.rejectedWith(/Unknown work class 'unknown'/);
+      });
+
+      describe('in low power mode', () => {
+        // The system only reports thermal states on macOS, so the specs
+        // emit them.
+        const setThermalState = (state: string) => {
+          powerMonitor.emit('thermal-state-change', {}, state);
+        };
+
+        afterEach(closeAllWindows);
+
+        it('throttles pages and defers work until it is left', async () => {
+          const w = new BrowserWindow({ show: false, webPreferences: { backgroundThrottling: false } });
+          const changes: boolean[] = [];
+          const onChange = (lowPowerMode: boolean) => changes.push(lowPowerMode);
+          powerMonitor.on('low-power-mode-change', onChange);
+          try {
+            powerMonitor.setPowerPolicy({ onBattery: false, thermalState: 'serious' });
+            setThermalState('critical');
+            expect(powerMonitor.isLowPowerMode()).to.be.true('low power mode');
+            expect(w.webContents.getBackgroundThrottling()).to.be.true('background throttling');
+
+            powerMonitor.registerWorkClass('deferred', { deferInLowPowerMode: true });
+            let ran = false;
+            const work = powerMonitor.runWork('deferred', () => { ran = true; });
+            await new Promise(resolve => setTimeout(resolve, 50));
+            expect(ran).to.be.false('work ran');
+
+            setThermalState('nominal');
+            await work;
+            expect(ran).to.be.true('work ran');
+            expect(powerMonitor.isLowPowerMode()).to.be.false('low power mode');
+            expect(w.webContents.getBackgroundThrottling()).to.be.false('background throttling');
+            expect(changes).to.deep.equal([true, false]);
+          } finally {
+            powerMonitor.removeListener('low-power-mode-change', onChange);
+          }
+        });
+
+        it('keeps what the app changed when it is left', () => {
+          const w = new BrowserWindow({ show: false, webPreferences: { offscreen: true } });
+          w.webContents.setFrameRate(60);
+          powerMonitor.setPowerPolicy({ onBattery: false, thermalState: 'serious', offscreenFrameRate: 15 });
+          setThermalState('critical');
+          expect(w.webContents.getFrameRate()).to.equal(15);
+          w.webContents.setFrameRate(20);
+          setThermalState('nominal');
+          expect(w.webContents.getFrameRate()).to.equal(20);
+        });
+
+        it('does not leave it for a new policy that still applies', () => {
+          const w = new BrowserWindow({ show: false, webPreferences: { offscreen: true } });
+          w.webContents.setFrameRate(60);
+          powerMonitor.setPowerPolicy({ onBattery: false, thermalState: 'serious', offscreenFrameRate: 15 });
+          setThermalState('critical');
+          const changes: boolean[] = [];
+          const onChange = (lowPowerMode: boolean) => changes.push(lowPowerMode);
+          powerMonitor.on('low-power-mode-change', onChange);
+          try {
+            powerMonitor.setPowerPolicy({ onBattery: false, thermalState: 'fair', offscreenFrameRate: 10 });
+            expect(powerMonitor.isLowPowerMode()).to.be.true('low power mode');
+            expect(w.webContents.getFrameRate()).to.equal(10);
+            expect(changes).to.deep.equal([]);
+          } finally {
+            powerMonitor.removeListener('low-power-mode-change', onChange);
+          }
+        });
+      });
+    });
   });
 });
@@ -5,6 +5,7 @@ import { AddressInfo } from 'net';
 import * as path from 'path';
 import * as http from 'http';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as qs from 'querystring';
 import * as stream from 'stream';
 import { closeWindow } from './window-helpers';
@@ -188,6 +189,16 @@ describe('protocol module', () => {
       expect(r.data).to.equal(text);
     });
 
+    it('sends a list of Buffers as response', async () => {
+      const large = Buffer.alloc(1024 * 1024, 'a');
+      const chunks = [buffer.slice(0, 5), Buffer.alloc(0), large, buffer.slice(5)];
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        callback({ data: chunks, mimeType: 'text/plain' });
+      });
+      const r = await ajax(protocolName + '://fake-host');
+      expect(r.data).to.equal(Buffer.concat(chunks).toString());
+    });
+
     it('fails when sending string', async () => {
       await registerBufferProtocol(protocolName, (request, callback) => callback(text as any));
       await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejectedWith(Error, '404');
@@ -259,6 +270,66 @@ describe('protocol module', () => {
     });
   });
 
+  describe('protocol.registerDirectoryProtocol', () => {
+    it('serves files through its routes', async () => {
+      expect(protocol.registerDirectoryProtocol(protocolName, {
+        pages: path.join(fixturesPath, 'pages'),
+        'pages/asar': path.join(fixturesPath, 'test.asar', 'a.asar')
+      })).to.equal(true);
+      const r = await ajax(protocolName + '://pages/a.html');
+      expect(r.data).to.equal(fs.readFileSync(path.join(fixturesPath, 'pages', 'a.html'), 'utf8'));
+      const asar = await ajax(protocolName + '://pages/asar/file1');
+      expect(asar.data).to.equal(fs.readFileSync(path.join(fixturesPath, 'test.asar', 'a.asar', 'file1'), 'utf8'));
+    });
+
+    it('does not serve files outside of its routes', async () => {
+      protocol.registerDirectoryProtocol(protocolName, { pages: path.join(fixturesPath, 'pages') });
+      await expect(ajax(protocolName + '://pages/%2e%2e/api/blank.html')).to.be.eventually.rejectedWith(Error);
+      await expect(ajax(protocolName + '://other/a.html')).to.be.eventually.rejectedWith(Error);
+    });
+
+    it('validates responses with their etag', async () => {
+      protocol.registerDirectoryProtocol(protocolName, { pages: path.join(fixturesPath, 'pages') }, { cacheSize: 1024 * 1024 });
+      const url = protocolName + '://pages/a.html';
+      const r = await ajax(url);
+      expect(r.headers).to.include('last-modified: ');
+      const etag = r.headers.match(/etag: (.*)/)[1].trim();
+      const cached = await ajax(url);
+      expect(cached.data).to.equal(r.data);
+      const validated = await ajax(url, { headers: { 'If-None-Match': etag } });
+      expect(validated.status).to.equal(304);
+    });
+
+    it('serves cached files from memory until they change', async () => {
+      const directory = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-directory-protocol-'));
+      const file = path.join(directory, 'a.txt');
+      const time = new Date(2020, 0, 1);
+      try {
+        fs.writeFileSync(file, 'first');
+        fs.utimesSync(file, time, time);
+        protocol.registerDirectoryProtocol(protocolName, { files: directory }, { cacheSize: 1024 * 1024 });
+        const url = protocolName + '://files/a.txt';
+        expect((await ajax(url)).data).to.equal('first');
+
+        // The same size and modification time, so the cached entry still
+        // matches and the disk is not read again.
+        fs.writeFileSync(file, 'other');
+        fs.utimesSync(file, time, time);
+        expect((await ajax(url)).data).to.equal('first');
+
+        const later = new Date(2020, 0, 2);
+        fs.utimesSync(file, later, later);
+        expect((await ajax(url)).data).to.equal('other');
+      } finally {
+        fs.rmdirSync(directory, { recursive: true });
+      }
+    });
+
+    it('throws for relative directories', () => {
+      expect(() => protocol.registerDirectoryProtocol(protocolName, { pages: 'pages' })).to.throw(/absolute/);
+    });
+  });
+
   describe('protocol.registerHttpProtocol', () => {
     it('sends url as response', async () => {
       const server = http.createServer((req, res) => {
@@ -393,6 +464,42 @@ describe('protocol module', () => {
       expect(r.data).to.have.lengthOf(data.length);
     });
 
+    it('can handle large responses sent in small chunks', async () => {
+      const chunk = '0123456789';
+      await registerStreamProtocol(protocolName, (request, callback) => {
+        const body = new stream.PassThrough();
+        setTimeout(() => {
+          for (let i = 0; i < 50000; i++) body.push(chunk);
+          body.push(null);
+        });
+        callback(body);
+      });
+      const r = await ajax(protocolName + '://fake-host');
+      expect(r.data).to.equal(chunk.repeat(50000));
+    });
+
+    it('sends fs.ReadStream as response', async () => {
+      const filePath = path.join(fixturesPath, 'pages', 'a.html');
+      await registerStreamProtocol(protocolName, (request, callback) => {
+        callback({ data: fs.createReadStream(filePath), headers: { 'content-type': 'text/html' } });
+      });
+      const r = await ajax(protocolName + '://fake-host');
+      expect(r.data).to.equal(fs.readFileSync(filePath, 'utf8'));
+    });
+
+    it('runs a served fs.ReadStream to its end', async () => {
+      const filePath = path.join(fixturesPath, 'pages', 'a.html');
+      let ended: Promise<any> = Promise.resolve();
+      await registerStreamProtocol(protocolName, (request, callback) => {
+        const body = fs.createReadStream(filePath);
+        ended = Promise.all([emittedOnce(body, 'end'), emittedOnce(body, 'close')]);
+        callback(body);
+      });
+      const r = await ajax(protocolName + '://fake-host');
+      expect(r.data).to.equal(fs.readFileSync(filePath, 'utf8'));
+      await ended;
+    });
+
     it('can handle a stream completing while writing', async () => {
       function dumbPassthrough () {
         return new stream.Transform({
@@ -510,6 +510,36 @@ ifdescribe(features.isRemoteModuleEnabled())('remote module', () => {
     });
   });
 
+  describe('remote property snapshots', () => {
+    before(() => {
+      (global as any).snapshotTarget = Object.freeze({ str: 'a', num: 1, obj: {} });
+    });
+    after(() => {
+      delete (global as any).snapshotTarget;
+    });
+    afterEach(closeAllWindows);
+
+    const getDescriptors = async (enableRemotePropertySnapshots: boolean) => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, enableRemoteModule: true, enableRemotePropertySnapshots } });
+      await w.loadURL('about:blank');
+      return w.webContents.executeJavaScript(`(() => {
+        const target = require('electron').remote.getGlobal('snapshotTarget')
+        const hasValue = (name) => 'value' in Object.getOwnPropertyDescriptor(target, name)
+        return { str: hasValue('str'), num: hasValue('num'), obj: hasValue('obj'), values: [target.str, target.num] }
+      })()`);
+    };
+
+    it('serves immutable primitive properties locally', async () => {
+      const result = await getDescriptors(true);
+      expect(result).to.deep.equal({ str: true, num: true, obj: false, values: ['a', 1] });
+    });
+
+    it('reads every property from the main process by default', async () => {
+      const result = await getDescriptors(false);
+      expect(result).to.deep.equal({ str: false, num: false, obj: false, values: ['a', 1] });
+    });
+  });
+
   describe('remote value in browser', () => {
     const remotely = makeRemotely(makeWindow());
     const print = path.join(fixtures, 'module', 'print_name.js');
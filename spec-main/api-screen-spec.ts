@@ -10,6 +10,14 @@ describe('screen module', () => {
     });
   });
 
+  describe('screen.getDisplayNearestPoint()', () => {
+    it('returns one of the displays', () => {
+      const ids = screen.getAllDisplays().map(display => display.id);
+      const display = screen.getDisplayNearestPoint(screen.getCursorScreenPoint());
+      expect(ids).to.include(display.id);
+    });
+  });
+
   describe('screen.getPrimaryDisplay()', () => {
     it('returns a display object', () => {
       const display = screen.getPrimaryDisplay();
@@ -76,6 +76,32 @@ describe('session.serviceWorkers', () => {
     });
   });
 
+  describe('startWorkerForScope()', () => {
+    it('starts the registered worker of a scope', async () => {
+      await emittedOnce(ses.serviceWorkers, 'console-message', () => w.loadURL(`${baseUrl}/index.html`));
+      const scope = baseUrl + '/';
+      const { versionId } = await ses.serviceWorkers.startWorkerForScope(scope);
+      expect(ses.serviceWorkers.getFromVersionID(versionId)).to.have.property('scope', scope);
+    });
+
+    it('rejects for a scope without a worker', async () => {
+      await expect(ses.serviceWorkers.startWorkerForScope(`${baseUrl}/none/`)).to.eventually.be.rejectedWith(/Failed to start service worker/);
+    });
+  });
+
+  describe('startKeepAlive()', () => {
+    it('returns a token to release the worker with', async () => {
+      const eventInfo = await emittedOnce(ses.serviceWorkers, 'console-message', () => w.loadURL(`${baseUrl}/index.html`));
+      const token = ses.serviceWorkers.startKeepAlive(eventInfo[1].versionId);
+      expect(token).to.be.a('string').that.is.not.empty();
+      ses.serviceWorkers.stopKeepAlive(token);
+    });
+
+    it('throws for a worker that is not running', () => {
+      expect(() => ses.serviceWorkers.startKeepAlive(-1)).to.throw(/Could not find service worker/);
+    });
+  });
+
   describe('console-message event', () => {
     it('should correctly keep the source, message and level', async () => {
       const messages: Record<string, Electron.MessageDetails> = {};
@@ -4,11 +4,12 @@ import * as https from 'https';
 import * as path from 'path';
 import * as fs from 'fs';
 import * as ChildProcess from 'child_process';
-import { session, BrowserWindow, net, ipcMain, Session } from 'electron';
+import { app, session, BrowserWindow, net, ipcMain, Session } from 'electron';
 import * as send from 'send';
 import * as auth from 'basic-auth';
 import { closeAllWindows } from './window-helpers';
 import { emittedOnce } from './events-helpers';
+import { delay } from './spec-helpers';
 import { AddressInfo } from 'net';
 
 /* The whole session API doesn't use standard callbacks */
@@ -24,6 +25,35 @@ describe('session module', () => {
     });
   });
 
+  describe('session.clone(template, partition)', () => {
+    it('copies the configuration of the template', () => {
+      const template = session.fromPartition('clone-template');
+      template.setUserAgent('tenant-agent');
+      template.setPreloads([path.join(fixtures, 'module', 'preload.js')]);
+      template.setDownloadBandwidthLimit(1024);
+      const ses = session.clone(template, 'persist:clone-tenant');
+      expect(ses).to.not.equal(template);
+      expect(ses.getUserAgent()).to.equal('tenant-agent');
+      expect(ses.getPreloads()).to.deep.equal(template.getPreloads());
+      expect(ses.getDownloadBandwidthLimit()).to.equal(1024);
+      expect(ses.isPersistent()).to.be.true();
+    });
+
+    it('returns the existing session of the partition', () => {
+      const template = session.fromPartition('clone-template-2');
+      template.setUserAgent('other-agent');
+      const ses = session.fromPartition('clone-existing');
+      expect(session.clone(template, 'clone-existing')).to.equal(ses);
+      expect(ses.getUserAgent()).to.not.equal('other-agent');
+    });
+
+    it('does not clone into the default session', () => {
+      expect(() => {
+        session.clone(session.fromPartition('clone-template-3'), '');
+      }).to.throw(/default session/);
+    });
+  });
+
   describe('session.fromPartition(partition, options)', () => {
     it('returns existing session with same partition', () => {
       expect(session.fromPartition('test')).to.equal(session.fromPartition('test'));
@@ -169,6 +199,34 @@ describe('session module', () => {
       expect(list.some(cookie => cookie.name === name && cookie.value === value)).to.equal(false);
     });
 
+    it('sets and gets cookies in batches', async () => {
+      const { cookies } = session.defaultSession;
+      const expirationDate = (+new Date()) / 1000 + 120;
+
+      await cookies.setMany([
+        { url, name: 'batch1', value: '1', expirationDate },
+        { url, name: 'batch2', value: '2', expirationDate }
+      ]);
+      const [first, second, all] = await cookies.getMany([
+        { url, name: 'batch1' },
+        { url, name: 'batch2' },
+        { url }
+      ]);
+      expect(first).to.have.lengthOf(1);
+      expect(first[0]).to.have.property('value', '1');
+      expect(second).to.have.lengthOf(1);
+      expect(second[0]).to.have.property('value', '2');
+      expect(all.map(cookie => cookie.name)).to.include.members(['batch1', 'batch2']);
+    });
+
+    it('rejects a batch with the first error', async () => {
+      const { cookies } = session.defaultSession;
+
+      await expect(
+        cookies.setMany([{ url, name: 'batch3', value: '3' }, { url: 'asdf', name: 'batch4' }])
+      ).to.eventually.be.rejectedWith('Failed to get cookie domain');
+    });
+
     it.skip('should set cookie for standard scheme', async () => {
       const { cookies } = session.defaultSession;
       const domain = 'fake-host';
@@ -209,6 +267,30 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true);
     });
 
+    it('emits the changes in batches', async () => {
+      const { cookies } = session.fromPartition('cookies-changed-batch');
+      const expirationDate = (+new Date()) / 1000 + 120;
+
+      const changes: any[] = [];
+      const received = new Promise(resolve => {
+        cookies.on('changed-batch' as any, (event: any, batch: any[]) => {
+          changes.push(...batch);
+          const names = changes.map(change => change.cookie.name);
+          if (names.includes('batch1') && names.includes('batch2')) resolve();
+        });
+      });
+      await cookies.setMany([
+        { url, name: 'batch1', value: '1', expirationDate },
+        { url, name: 'batch2', value: '2', expirationDate }
+      ]);
+      await received;
+
+      const change = changes.find(change => change.cookie.name === 'batch2');
+      expect(change.cookie.value).to.equal('2');
+      expect(change.cause).to.equal('explicit');
+      expect(change.removed).to.equal(false);
+    });
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo';
@@ -245,6 +327,226 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getNetworkMetrics()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.end(req.url === '/' ? '<img src="/image.png">' : '');
+      });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => server.close());
+    afterEach(closeAllWindows);
+
+    it('records the loads of the pages of the session', async () => {
+      const ses = session.fromPartition('' + Math.random());
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      const host = serverUrl.replace('http://', '');
+      let metrics = ses.getNetworkMetrics();
+      while (!metrics.hosts[host] || metrics.hosts[host].requests < 2) {
+        await delay(50);
+        metrics = ses.getNetworkMetrics();
+      }
+      const { ttfb, newSockets, reusedSockets } = metrics.hosts[host];
+      expect(metrics.bucketBoundaries).to.be.an('array').that.is.not.empty();
+      expect(ttfb.count).to.equal(2);
+      expect(ttfb.buckets).to.have.lengthOf(metrics.bucketBoundaries.length + 1);
+      expect(newSockets + reusedSockets).to.equal(2);
+
+      ses.clearNetworkMetrics();
+      expect(ses.getNetworkMetrics().hosts).to.deep.equal({});
+    });
+
+    it('reports the cache limits and statistics of the session', async () => {
+      const ses = session.fromPartition('' + Math.random(), { cacheMaxSize: 1024 * 1024, cacheMaxAge: 3600 } as any);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      let stats = ses.getCacheStats();
+      while (stats.hits + stats.misses < 2) {
+        await delay(50);
+        stats = ses.getCacheStats();
+      }
+      expect(stats.maxSize).to.equal(1024 * 1024);
+      expect(stats.maxAge).to.equal(3600);
+      expect(stats.misses).to.be.at.least(1);
+    });
+  });
+
+  describe('ses.setSharedCacheURLs(urls)', () => {
+    afterEach(closeAllWindows);
+
+    it('throws for an invalid pattern', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(() => ses.setSharedCacheURLs(['not a pattern'])).to.throw(/Invalid url pattern/);
+    });
+
+    describe('when resources are served', () => {
+      let server: http.Server;
+      let port: number;
+      let requests = 0;
+      before(async () => {
+        server = http.createServer((req, res) => {
+          if (req.url!.startsWith('/asset-')) requests++;
+          // Makes the HTTP cache go to the server for each request.
+          res.setHeader('Cache-Control', 'no-cache');
+          res.end('shared');
+        });
+        await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+        port = (server.address() as AddressInfo).port;
+      });
+      after(() => { server.close(); });
+      beforeEach(() => { requests = 0; });
+
+      const newAssetUrl = () => `http://127.0.0.1:${port}/asset-${Math.random()}.txt`;
+      const newSession = (partition = `persist:${Math.random()}`) => {
+        const ses = session.fromPartition(partition);
+        ses.setSharedCacheURLs([`http://127.0.0.1:${port}/*`]);
+        return ses;
+      };
+      const load = async (ses: Session, url: string) => {
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+        await w.loadURL(url);
+        expect(await w.webContents.executeJavaScript('document.body.textContent')).to.equal('shared');
+        w.destroy();
+        // The first response is stored in the background.
+        await delay(100);
+      };
+
+      it('downloads a resource once for all the pages of the session', async () => {
+        const ses = newSession();
+        const assetUrl = newAssetUrl();
+        await load(ses, assetUrl);
+        await load(ses, assetUrl);
+        expect(requests).to.equal(1);
+      });
+
+      it('shares resources with the other sessions that opted in', async () => {
+        const assetUrl = newAssetUrl();
+        await load(newSession(), assetUrl);
+        await load(newSession(), assetUrl);
+        expect(requests).to.equal(1);
+      });
+
+      it('does not serve sessions that did not opt in', async () => {
+        const assetUrl = newAssetUrl();
+        await load(newSession(), assetUrl);
+        await load(session.fromPartition(`persist:${Math.random()}`), assetUrl);
+        expect(requests).to.equal(2);
+      });
+
+      it('serves in-memory sessions without storing their resources', async () => {
+        const assetUrl = newAssetUrl();
+        await load(newSession('' + Math.random()), assetUrl);
+        await load(newSession(), assetUrl);
+        expect(requests).to.equal(2);
+        await load(newSession('' + Math.random()), assetUrl);
+        expect(requests).to.equal(2);
+      });
+
+      it('downloads resources again after ses.clearSharedCache()', async () => {
+        const ses = newSession();
+        const assetUrl = newAssetUrl();
+        await load(ses, assetUrl);
+        await ses.clearSharedCache();
+        await load(ses, assetUrl);
+        expect(requests).to.equal(2);
+      });
+
+      it('checks CORS for cross-origin requests of stored resources', async () => {
+        const ses = newSession();
+        const assetUrl = newAssetUrl();
+        await load(ses, assetUrl);
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+        await w.loadURL(`http://localhost:${port}/page`);
+        const result = await w.webContents.executeJavaScript(
+          `fetch(${JSON.stringify(assetUrl)}).then(() => 'loaded', () => 'blocked')`);
+        expect(result).to.equal('blocked');
+        expect(requests).to.equal(1);
+      });
+    });
+  });
+
+  describe('preconnect prediction', () => {
+    let pageServer: http.Server;
+    let imageServer: http.Server;
+    let pageUrl: string;
+    let imageConnections = 0;
+    let respond: (() => void) | null = null;
+    before(async () => {
+      imageServer = http.createServer((req, res) => {
+        res.setHeader('Connection', 'close');
+        res.end();
+      });
+      imageServer.on('connection', () => { imageConnections++; });
+      await new Promise(resolve => imageServer.listen(0, '127.0.0.1', resolve));
+      const imageUrl = `http://127.0.0.1:${(imageServer.address() as AddressInfo).port}/image.png`;
+
+      pageServer = http.createServer((req, res) => {
+        const send = () => res.end(`<img src="${imageUrl}">`);
+        if (respond) {
+          respond = send;
+        } else {
+          send();
+        }
+      });
+      await new Promise(resolve => pageServer.listen(0, '127.0.0.1', resolve));
+      pageUrl = `http://127.0.0.1:${(pageServer.address() as AddressInfo).port}/`;
+    });
+    after(() => {
+      pageServer.close();
+      imageServer.close();
+    });
+    afterEach(closeAllWindows);
+
+    it('preconnects to the origins a page contacted before', async () => {
+      const ses = session.fromPartition('' + Math.random());
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(pageUrl);
+      while (imageConnections === 0) {
+        await delay(50);
+      }
+      await w.loadURL('about:blank');
+
+      // Hold the page response, the image server should get a connection
+      // before the page asks for the image.
+      imageConnections = 0;
+      respond = () => {};
+      const load = w.loadURL(pageUrl);
+      while (imageConnections === 0) {
+        await delay(50);
+      }
+      respond();
+      respond = null;
+      await load;
+
+      ses.clearPreconnectPredictions();
+    });
+
+    it('forgets the predictions when the storage data is cleared', async () => {
+      const ses = session.fromPartition('' + Math.random());
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      imageConnections = 0;
+      await w.loadURL(pageUrl);
+      while (imageConnections === 0) {
+        await delay(50);
+      }
+      await w.loadURL('about:blank');
+      await ses.clearStorageData({ storages: ['cookies'] });
+
+      imageConnections = 0;
+      respond = () => {};
+      const load = w.loadURL(pageUrl);
+      await delay(500);
+      expect(imageConnections).to.equal(0);
+      respond();
+      respond = null;
+      await load;
+    });
+  });
+
   describe('ses.clearStorageData(options)', () => {
     afterEach(closeAllWindows);
     it('clears localstorage data', async () => {
@@ -261,6 +563,23 @@ describe('session module', () => {
         // trying until it is.
       }
     });
+
+    it('clears incrementally and reports the progress', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadFile(path.join(fixtures, 'api', 'localstorage.html'));
+      const progress: number[][] = [];
+      await w.webContents.session.clearStorageData({
+        origins: ['file://'],
+        storages: ['localstorage', 'indexdb'],
+        incremental: true,
+        onProgress: (completed: number, total: number) => { progress.push([completed, total]); }
+      } as any);
+      expect(progress).to.deep.equal([[1, 2], [2, 2]]);
+      while (await w.webContents.executeJavaScript('localStorage.length') !== 0) {
+        // The storage clear isn't instantly visible to the renderer, so keep
+        // trying until it is.
+      }
+    });
   });
 
   describe('will-download event', () => {
@@ -394,6 +713,27 @@ describe('session module', () => {
       expect(proxy).to.equal('PROXY myproxy:8132');
     });
 
+    it('gives the path of http urls to pac scripts', async () => {
+      server = http.createServer((req, res) => {
+        const pac = `
+          function FindProxyForURL(url, host) {
+            return url.indexOf('/proxied') !== -1 ? "PROXY myproxy:8132" : "DIRECT";
+          }
+        `;
+        res.writeHead(200, {
+          'Content-Type': 'application/x-ns-proxy-autoconfig'
+        });
+        res.end(pac);
+      });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      const config = { pacScript: `http://127.0.0.1:${(server.address() as AddressInfo).port}` };
+      await customSession.setProxy(config);
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('DIRECT');
+      expect(await customSession.resolveProxy('http://example.com/proxied')).to.equal('PROXY myproxy:8132');
+      // Only the host of https urls is given to pac scripts.
+      expect(await customSession.resolveProxy('https://example.com/proxied')).to.equal('DIRECT');
+    });
+
     it('allows bypassing proxy settings', async () => {
       const config = {
         proxyRules: 'http=myproxy:80',
@@ -403,6 +743,23 @@ describe('session module', () => {
       const proxy = await customSession.resolveProxy('http://example/');
       expect(proxy).to.equal('DIRECT');
     });
+
+    it('resolves the proxies of several urls in parallel', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      const proxies = await Promise.all([
+        customSession.resolveProxy('http://example.com/a'),
+        customSession.resolveProxy('http://example.com/b'),
+        customSession.resolveProxy('https://example.com/')
+      ]);
+      expect(proxies).to.deep.equal(['PROXY myproxy:80', 'PROXY myproxy:80', 'DIRECT']);
+    });
+
+    it('does not use the cached proxies once the settings change', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY myproxy:80');
+      await customSession.setProxy({ proxyRules: 'http=otherproxy:81' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY otherproxy:81');
+    });
   });
 
   describe('ses.getBlobData()', () => {
@@ -615,6 +972,8 @@ describe('session module', () => {
       expect(item.getMimeType()).to.equal('application/pdf');
       expect(item.getReceivedBytes()).to.equal(mockPDF.length);
       expect(item.getTotalBytes()).to.equal(mockPDF.length);
+      expect(item.getAverageBytesPerSecond()).to.be.at.least(0);
+      expect(item.getCurrentBytesPerSecond()).to.be.at.least(0);
       expect(item.getContentDisposition()).to.equal(contentDisposition);
       expect(fs.existsSync(downloadFilePath)).to.equal(true);
       fs.unlinkSync(downloadFilePath);
@@ -632,6 +991,60 @@ describe('session module', () => {
       session.defaultSession.downloadURL(`${url}:${port}`);
     });
 
+    it('can limit the download speed of a session', async () => {
+      const ses = session.fromPartition('download-bandwidth-limit');
+      expect(ses.getDownloadBandwidthLimit()).to.equal(0);
+      ses.setDownloadBandwidthLimit(2 * 1024 * 1024);
+      expect(ses.getDownloadBandwidthLimit()).to.equal(2 * 1024 * 1024);
+      const startedAt = Date.now();
+      const [, item] = await new Promise<[Electron.Event, Electron.DownloadItem]>(resolve => {
+        ses.once('will-download', (e, item) => {
+          item.savePath = downloadFilePath;
+          expect(item.getBandwidthLimit()).to.equal(0);
+          item.setBandwidthLimit(4 * 1024 * 1024);
+          expect(item.getBandwidthLimit()).to.equal(4 * 1024 * 1024);
+          expect(item.getTimeRemaining()).to.be.a('number');
+          item.once('done', () => resolve([e, item]));
+        });
+        ses.downloadURL(`${url}:${address.port}`);
+      });
+      expect(item.getState()).to.equal('completed');
+      expect(item.getReceivedBytes()).to.equal(mockPDF.length);
+      // 5MB at 2MB per second.
+      expect(Date.now() - startedAt).to.be.at.least(1500);
+      ses.setDownloadBandwidthLimit(0);
+      fs.unlinkSync(downloadFilePath);
+    });
+
+    it('keeps the bandwidth limit of an item to its own download', async () => {
+      const ses = session.fromPartition('download-item-bandwidth-limit');
+      const limitedPath = path.join(__dirname, '..', 'fixtures', 'limited.pdf');
+      const unlimitedPath = path.join(__dirname, '..', 'fixtures', 'unlimited.pdf');
+      const items = new Map<string, Electron.DownloadItem>();
+      const done = new Promise<Electron.DownloadItem>(resolve => {
+        ses.on('will-download', (e, item) => {
+          const limited = item.getURL().endsWith('?limited');
+          item.savePath = limited ? limitedPath : unlimitedPath;
+          if (limited) item.setBandwidthLimit(512 * 1024);
+          items.set(limited ? 'limited' : 'unlimited', item);
+          if (!limited) item.once('done', () => resolve(item));
+        });
+      });
+      ses.downloadURL(`${url}:${address.port}/?limited`);
+      await emittedOnce(ses, 'will-download');
+      ses.downloadURL(`${url}:${address.port}/?unlimited`);
+      const unlimited = await done;
+      // The unlimited download did not take the limit of the other one, which
+      // can't have received the whole file yet.
+      expect(unlimited.getState()).to.equal('completed');
+      const limited = items.get('limited')!;
+      expect(limited.getBandwidthLimit()).to.equal(512 * 1024);
+      expect(limited.getReceivedBytes()).to.be.below(mockPDF.length);
+      limited.cancel();
+      ses.removeAllListeners('will-download');
+      fs.unlinkSync(unlimitedPath);
+    });
+
     it('can download using WebContents.downloadURL', (done) => {
       const port = address.port;
       const w = new BrowserWindow({ show: false });
@@ -948,4 +1361,116 @@ describe('session module', () => {
       expect(headers!['user-agent']).to.equal(userAgent);
     });
   });
+
+  describe('ses.setSpareRendererCount()', () => {
+    afterEach(closeAllWindows);
+
+    it('can be retrieved with getSpareRendererCount()', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(ses.getSpareRendererCount()).to.equal(0);
+      ses.setSpareRendererCount(1);
+      expect(ses.getSpareRendererCount()).to.equal(1);
+    });
+
+    it('throws for a negative count', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(() => ses.setSpareRendererCount(-1)).to.throw(/must not be negative/);
+    });
+
+    describe('when renderer processes are not reused', () => {
+      // Spare renderers are given to windows through the site instance
+      // overrides, which Chromium only asks for without process reuse.
+      before(() => {
+        app.allowRendererProcessReuse = false;
+      });
+      after(() => {
+        app.allowRendererProcessReuse = true;
+      });
+
+      it('gives a spare renderer to the next window with the same preferences', async () => {
+        const ses = session.fromPartition('' + Math.random());
+        ses.setSpareRendererCount(1);
+        const rendererPids = () => app.getAppMetrics().filter(metric => metric.type === 'Tab').map(metric => metric.pid);
+        const existingPids = rendererPids();
+
+        const webPreferences = { session: ses, nodeIntegration: true };
+        const w1 = new BrowserWindow({ show: false, webPreferences });
+        await w1.loadURL('about:blank');
+        const isSpare = (pid: number) => !existingPids.includes(pid) && pid !== w1.webContents.getOSProcessId();
+        for (let i = 0; i < 100 && !rendererPids().some(isSpare); i++) {
+          await delay(50);
+        }
+        const sparePids = rendererPids().filter(isSpare);
+        expect(sparePids).to.not.be.empty('no spare renderer was launched');
+
+        const w2 = new BrowserWindow({ show: false, webPreferences });
+        await w2.loadURL('about:blank');
+        expect(sparePids).to.include(w2.webContents.getOSProcessId());
+        expect(await w2.webContents.executeJavaScript('typeof require')).to.equal('function');
+      });
+    });
+  });
+
+  describe('ses.setRendererProcessPool()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.end('<title>pool</title>');
+      });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => {
+      server.close();
+    });
+    afterEach(closeAllWindows);
+
+    it('can be retrieved with getRendererProcessPool()', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(ses.getRendererProcessPool()).to.deep.equal({ maxProcessesPerSite: 0, maxProcesses: 0 });
+      ses.setRendererProcessPool({ maxProcessesPerSite: 2, maxProcesses: 8 });
+      expect(ses.getRendererProcessPool()).to.deep.equal({ maxProcessesPerSite: 2, maxProcesses: 8 });
+    });
+
+    it('throws for negative counts', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(() => ses.setRendererProcessPool({ maxProcessesPerSite: -1 })).to.throw(/must not be negative/);
+    });
+
+    describe('when renderer processes are not reused', () => {
+      // Like spare renderers, the pool hands out renderers through the site
+      // instance overrides, which Chromium only asks for without process
+      // reuse.
+      before(() => {
+        app.allowRendererProcessReuse = false;
+      });
+      after(() => {
+        app.allowRendererProcessReuse = true;
+      });
+
+      it('spreads the windows of a site over the renderers of the pool', async () => {
+        const ses = session.fromPartition('' + Math.random());
+        ses.setRendererProcessPool({ maxProcessesPerSite: 2 });
+        const pids = new Set<number>();
+        for (let i = 0; i < 4; i++) {
+          const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+          await w.loadURL(`${serverUrl}/${i}`);
+          pids.add(w.webContents.getOSProcessId());
+        }
+        expect(pids.size).to.equal(2);
+      });
+
+      it('does not share renderers between windows with other preferences', async () => {
+        const ses = session.fromPartition('' + Math.random());
+        ses.setRendererProcessPool({ maxProcessesPerSite: 1 });
+        const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+        await w1.loadURL(serverUrl);
+        const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, nodeIntegration: true } });
+        await w2.loadURL(serverUrl);
+        expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+        expect(await w2.webContents.executeJavaScript('typeof require')).to.equal('function');
+      });
+    });
+  });
 });
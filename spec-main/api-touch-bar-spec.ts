@@ -124,5 +124,18 @@ describe('TouchBar module', () => {
       window.setTouchBar(touchBar);
       window.emit('-touch-bar-interaction', {}, (button as any).id);
     });
+
+    it('refreshes an item once for all the changes of a tick', async () => {
+      const button = new TouchBarButton({ label: 'foo' });
+      window.setTouchBar(new TouchBar({ items: [button] }));
+      const refreshed: string[] = [];
+      (window as any)._refreshTouchBarItem = (id: string) => { refreshed.push(id); };
+      button.label = 'bar';
+      button.backgroundColor = '#0F0';
+      button.label = 'baz';
+      expect(refreshed).to.be.empty();
+      await new Promise(resolve => process.nextTick(resolve));
+      expect(refreshed).to.deep.equal([(button as any).id]);
+    });
   });
 });
@@ -109,6 +109,34 @@ describe('tray module', () => {
     });
   });
 
+  describe('tray.startAnimation(images[, interval])', () => {
+    it('throws when no image is given', () => {
+      expect(() => {
+        tray.startAnimation([]);
+      }).to.throw(/At least one image must be given/);
+    });
+
+    it('throws for an invalid interval', () => {
+      expect(() => {
+        tray.startAnimation([nativeImage.createEmpty()], 0);
+      }).to.throw(/'interval' must be a positive number/);
+    });
+
+    it('animates until stopped', () => {
+      const frames = [nativeImage.createEmpty(), nativeImage.createEmpty()];
+      tray.startAnimation(frames, 20);
+      expect(tray.isAnimating()).to.be.true();
+      tray.stopAnimation();
+      expect(tray.isAnimating()).to.be.false();
+    });
+
+    it('is stopped by tray.setImage()', () => {
+      tray.startAnimation([nativeImage.createEmpty(), nativeImage.createEmpty()]);
+      tray.setImage(nativeImage.createEmpty());
+      expect(tray.isAnimating()).to.be.false();
+    });
+  });
+
   describe('tray.setPressedImage(image)', () => {
     it('accepts empty image', () => {
       tray.setPressedImage(nativeImage.createEmpty());
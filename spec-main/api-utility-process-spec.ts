@@ -0,0 +1,64 @@
+import { expect } from 'chai';
+import * as path from 'path';
+import { utilityProcess } from 'electron';
+import { emittedOnce } from './events-helpers';
+
+const fixtures = path.resolve(__dirname, 'fixtures', 'api', 'utility-process');
+
+describe('utilityProcess module', () => {
+  describe('fork', () => {
+    for (const sandbox of [false, true]) {
+      it(`runs the script and exchanges messages with it${sandbox ? ' in a sandbox' : ''}`, async () => {
+        const child = utilityProcess.fork(path.join(fixtures, 'echo.js'), ['--foo'], { sandbox });
+        child.postMessage('hello');
+        const [message] = await emittedOnce(child, 'message');
+        expect(message).to.deep.equal({ data: 'hello', argv: ['--foo'], type: 'utility' });
+        expect(child.pid).to.be.a('number');
+        child.kill();
+      });
+    }
+
+    it('emits exit once killed', async () => {
+      const child = utilityProcess.fork(path.join(fixtures, 'echo.js'));
+      await emittedOnce(child, 'spawn');
+      const exited = emittedOnce(child, 'exit');
+      expect(child.kill()).to.equal(true);
+      await exited;
+      expect(child.pid).to.be.undefined();
+      expect(child.kill()).to.equal(false);
+    });
+
+    it('knows the pid before the script has run', async () => {
+      const child = utilityProcess.fork(path.join(fixtures, 'busy.js'));
+      await emittedOnce(child, 'spawn');
+      expect(child.pid).to.be.a('number');
+      child.kill();
+      await emittedOnce(child, 'exit');
+    });
+
+    it('terminates a busy process when killed', async () => {
+      const child = utilityProcess.fork(path.join(fixtures, 'busy.js'));
+      await emittedOnce(child, 'spawn');
+      const pid = child.pid!;
+      let exited = false;
+      child.once('exit', () => { exited = true; });
+      child.kill();
+      expect(exited).to.equal(false);
+      await emittedOnce(child, 'exit');
+      expect(() => process.kill(pid, 0)).to.throw();
+    });
+
+    it('emits the exit code of the script', async () => {
+      const child = utilityProcess.fork(path.join(fixtures, 'exit.js'), ['7']);
+      const [code] = await emittedOnce(child, 'exit');
+      expect(code).to.equal(7);
+      expect(child.pid).to.be.undefined();
+    });
+
+    it('emits error when the script of a sandboxed process can not be read', async () => {
+      const child = utilityProcess.fork(path.join(fixtures, 'does-not-exist.js'), [], { sandbox: true });
+      const [error] = await emittedOnce(child, 'error');
+      expect(error.code).to.equal('ENOENT');
+    });
+  });
+});
@@ -3,11 +3,12 @@ import { AddressInfo } from 'net';
 import * as path from 'path';
 import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
 import * as ChildProcess from 'child_process';
 import { BrowserWindow, ipcMain, webContents, session, WebContents, app, clipboard } from 'electron';
 import { emittedOnce } from './events-helpers';
 import { closeAllWindows } from './window-helpers';
-import { ifdescribe, ifit } from './spec-helpers';
+import { ifdescribe, ifit, delay } from './spec-helpers';
 
 const pdfjs = require('pdfjs-dist');
 const fixturesPath = path.resolve(__dirname, '..', 'spec', 'fixtures');
@@ -29,14 +30,24 @@ describe('webContents module', () => {
 
       await emittedOnce(w.webContents, 'devtools-opened');
 
-      const all = webContents.getAllWebContents().sort((a, b) => {
-        return a.id - b.id;
-      });
+      // The IDs of destroyed WebContents are reused with another generation,
+      // so they do not follow the creation order.
+      const all = webContents.getAllWebContents();
 
       expect(all).to.have.length(3);
-      expect(all[0].getType()).to.equal('window');
-      expect(all[all.length - 2].getType()).to.equal('webview');
-      expect(all[all.length - 1].getType()).to.equal('remote');
+      expect(all.map(contents => contents.getType()).sort()).to.deep.equal(['remote', 'webview', 'window']);
+    });
+
+    it('does not give the ID of a destroyed WebContents to another one', async () => {
+      const w = new BrowserWindow({ show: false });
+      const id = w.webContents.id;
+      const destroyed = emittedOnce(w.webContents, 'destroyed');
+      w.destroy();
+      await destroyed;
+      const other = new BrowserWindow({ show: false });
+      expect(other.webContents.id).to.not.equal(id);
+      expect(webContents.fromId(id)).to.not.be.ok();
+      expect(webContents.fromId(other.webContents.id)).to.equal(other.webContents);
     });
   });
 
@@ -151,6 +162,84 @@ describe('webContents module', () => {
     });
   });
 
+  describe('webContents.executeJavaScriptInAllFrames', () => {
+    afterEach(closeAllWindows);
+
+    it('runs the code in every frame', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(__dirname, 'fixtures', 'sub-frames', 'frame-with-frame-container.html'));
+      const results = await w.webContents.executeJavaScriptInAllFrames('location.pathname.split("/").pop()');
+      expect(results.map((entry: any) => entry.result).sort()).to.deep.equal([
+        'frame-with-frame-container.html',
+        'frame-with-frame.html',
+        'frame.html'
+      ]);
+      for (const entry of results) {
+        expect(entry.processId).to.be.a('number');
+        expect(entry.frameId).to.be.a('number');
+      }
+    });
+
+    it('reports the errors of each frame', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(__dirname, 'fixtures', 'sub-frames', 'frame-with-frame.html'));
+      const results = await w.webContents.executeJavaScriptInAllFrames('window.parent === window ? 1 : Promise.reject(new Error("child"))');
+      expect(results).to.have.lengthOf(2);
+      const [top] = results.filter((entry: any) => 'result' in entry);
+      const [child] = results.filter((entry: any) => 'error' in entry);
+      expect(top.result).to.equal(1);
+      expect(child.error.message).to.equal('child');
+    });
+
+    it('runs the code in the given world', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScriptInIsolatedWorld(1234, [{ code: 'window.worldMarker = 42' }]);
+      const results = await w.webContents.executeJavaScriptInAllFrames('window.worldMarker', { world: 1234 });
+      expect(results.map((entry: any) => entry.result)).to.deep.equal([42]);
+    });
+
+    describe('with cross-site frames', () => {
+      let server: http.Server;
+      let port: number;
+      before(async () => {
+        server = http.createServer((req, res) => {
+          if (req.url === '/frame') {
+            res.end('frame');
+          } else {
+            res.end(`<iframe src="http://localhost:${port}/frame"></iframe>`);
+          }
+        });
+        await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+        port = (server.address() as AddressInfo).port;
+      });
+      after(() => { server.close(); });
+
+      const run = async (nodeIntegrationInSubFrames: boolean) => {
+        const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegrationInSubFrames } });
+        await w.loadURL(`http://127.0.0.1:${port}/`);
+        const results = await w.webContents.executeJavaScriptInAllFrames('location.host');
+        return results.map((entry: any) => entry.result).sort();
+      };
+
+      it('leaves out the frames of processes without Electron bindings', async () => {
+        expect(await run(false)).to.deep.equal([`127.0.0.1:${port}`]);
+      });
+
+      it('runs the code in them with nodeIntegrationInSubFrames', async () => {
+        expect(await run(true)).to.deep.equal([`127.0.0.1:${port}`, `localhost:${port}`]);
+      });
+    });
+
+    it('rejects when the renderer process goes away', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      const promise = w.webContents.executeJavaScriptInAllFrames('new Promise(() => {})');
+      w.webContents.executeJavaScript('process.crash()');
+      await expect(promise).to.eventually.be.rejectedWith(/went away/);
+    });
+  });
+
   describe('webContents.executeJavaScript', () => {
     describe('in about:blank', () => {
       const expected = 'hello, world!';
@@ -179,6 +268,17 @@ describe('webContents module', () => {
         const result = await w.webContents.executeJavaScript(code);
         expect(result).to.equal(expected);
       });
+      it('resolves with large typed arrays nested in arrays intact', async () => {
+        const result = await w.webContents.executeJavaScript(`
+          [[new Uint8Array(4 * 1024 * 1024).fill(7), new Float64Array([0.5])]]
+        `);
+        const [[bytes, doubles]] = result;
+        expect(bytes).to.be.an.instanceOf(Uint8Array);
+        expect(bytes.length).to.equal(4 * 1024 * 1024);
+        expect(bytes.every((byte: number) => byte === 7)).to.be.true();
+        expect(doubles).to.be.an.instanceOf(Float64Array);
+        expect(Array.from(doubles)).to.deep.equal([0.5]);
+      });
       it('resolves the returned promise with the result if the code returns an asyncronous promise', async () => {
         const result = await w.webContents.executeJavaScript(asyncCode);
         expect(result).to.equal(expected);
@@ -409,6 +509,51 @@ describe('webContents module', () => {
     });
   });
 
+  describe('setKeepDevToolsLoaded() API', () => {
+    afterEach(closeAllWindows);
+    it('reuses the devtools when they are opened again', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.setKeepDevToolsLoaded(true);
+      await w.loadURL('about:blank');
+
+      let devToolsOpened = emittedOnce(w.webContents, 'devtools-opened');
+      w.webContents.openDevTools();
+      await devToolsOpened;
+      const { devToolsWebContents } = w.webContents;
+
+      const devToolsClosed = emittedOnce(w.webContents, 'devtools-closed');
+      w.webContents.closeDevTools();
+      await devToolsClosed;
+      expect(w.webContents.isDevToolsOpened()).to.be.false();
+      expect(devToolsWebContents.isDestroyed()).to.be.false();
+
+      devToolsOpened = emittedOnce(w.webContents, 'devtools-opened');
+      w.webContents.openDevTools();
+      await devToolsOpened;
+      expect(w.webContents.isDevToolsOpened()).to.be.true();
+      expect(w.webContents.devToolsWebContents.id).to.equal(devToolsWebContents.id);
+    });
+
+    it('unloads hidden devtools when turned off', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.setKeepDevToolsLoaded(true);
+      await w.loadURL('about:blank');
+
+      const devToolsOpened = emittedOnce(w.webContents, 'devtools-opened');
+      w.webContents.openDevTools();
+      await devToolsOpened;
+      const { devToolsWebContents } = w.webContents;
+
+      const devToolsClosed = emittedOnce(w.webContents, 'devtools-closed');
+      w.webContents.closeDevTools();
+      await devToolsClosed;
+
+      const destroyed = emittedOnce(devToolsWebContents, 'destroyed');
+      w.webContents.setKeepDevToolsLoaded(false);
+      await destroyed;
+    });
+  });
+
   describe('setDevToolsWebContents() API', () => {
     afterEach(closeAllWindows);
     it('sets arbitrary webContents as devtools', async () => {
@@ -692,6 +837,56 @@ describe('webContents module', () => {
     });
   });
 
+  describe('sendInputEvents(events)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'key-events.html'));
+    });
+    afterEach(closeAllWindows);
+
+    it('sends the events in order', (done) => {
+      ipcMain.once('keypress', (event, key) => {
+        expect(key).to.equal('a');
+        done();
+      });
+      w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 1, y: 1 },
+        { type: 'mouseMove', x: 2, y: 2 },
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'char', keyCode: 'A' }
+      ]);
+    });
+
+    it('coalesces consecutive mouse moves into the last one', async () => {
+      await w.webContents.executeJavaScript(`window.moves = new Promise(resolve => {
+        const moves = [];
+        document.addEventListener('mousemove', e => {
+          moves.push({ x: e.clientX, y: e.clientY, movementX: e.movementX, shiftKey: e.shiftKey });
+        });
+        document.addEventListener('mousedown', () => resolve(moves));
+      }); null`);
+      w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 10, y: 10, movementX: 1 },
+        { type: 'mouseMove', x: 11, y: 10, movementX: 1 },
+        { type: 'mouseMove', x: 12, y: 10, movementX: 1 },
+        { type: 'mouseMove', x: 13, y: 10, movementX: 1, modifiers: ['shift'] },
+        { type: 'mouseDown', x: 13, y: 10, button: 'left', clickCount: 1 }
+      ]);
+      const moves = await w.webContents.executeJavaScript('window.moves');
+      expect(moves).to.deep.equal([
+        { x: 12, y: 10, movementX: 3, shiftKey: false },
+        { x: 13, y: 10, movementX: 1, shiftKey: true }
+      ]);
+    });
+
+    it('throws for an invalid event', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([{ type: 'keyDown', keyCode: 'A' }, {} as any]);
+      }).to.throw(/index 1/);
+    });
+  });
+
   describe('insertCSS', () => {
     afterEach(closeAllWindows);
     it('supports inserting CSS', async () => {
@@ -1205,6 +1400,25 @@ describe('webContents module', () => {
     });
   });
 
+  describe('per-host zoom levels', () => {
+    it('are kept across restarts for persistent partitions', async () => {
+      const appPath = path.join(fixturesPath, 'api', 'zoom-level-app');
+      const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-zoom-levels-'));
+      const runApp = async (phase: string) => {
+        const appProcess = ChildProcess.spawn(process.execPath, [appPath], {
+          env: { ...process.env, PHASE: phase, USER_DATA: userData }
+        });
+        let output = '';
+        appProcess.stdout.on('data', (data) => { output += data; });
+        const [code] = await emittedOnce(appProcess, 'close');
+        expect(code).to.equal(0);
+        return output.trim();
+      };
+      expect(await runApp('set')).to.equal('set');
+      expect(await runApp('get')).to.equal('2');
+    });
+  });
+
   describe('create()', () => {
     it('does not crash on exit', async () => {
       const appPath = path.join(fixturesPath, 'api', 'leak-exit-webcontents.js');
@@ -1516,6 +1730,129 @@ describe('webContents module', () => {
     });
   });
 
+  describe('startSamplingHeapProfiler()', () => {
+    afterEach(closeAllWindows);
+
+    it('records the allocations of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startSamplingHeapProfiler({ samplingInterval: 1024 });
+      await w.webContents.executeJavaScript('window.data = new Array(1e5).fill({}); true');
+      const profile = JSON.parse(await w.webContents.stopSamplingHeapProfiler());
+      expect(profile.head).to.have.property('children');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('rejects stopping when it was not started', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopSamplingHeapProfiler()).to.eventually.be.rejectedWith(/was not started/);
+    });
+  });
+
+  describe('startCPUProfiler()', () => {
+    afterEach(closeAllWindows);
+
+    it('records the samples of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startCPUProfiler({ samplingInterval: 100 });
+      await w.webContents.executeJavaScript('const end = Date.now() + 50; while (Date.now() < end); true');
+      const profile = JSON.parse(await w.webContents.stopCPUProfiler());
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+    });
+
+    it('rejects stopping when it was not started', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopCPUProfiler()).to.eventually.be.rejectedWith(/was not started/);
+    });
+  });
+
+  describe('trimMemory()', () => {
+    afterEach(closeAllWindows);
+
+    it('trims the renderer and keeps the page working', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript('window.data = new Array(1e6).fill(1); true');
+      await w.webContents.trimMemory();
+      await w.webContents.trimMemory('critical');
+      expect(await w.webContents.executeJavaScript('window.data.length')).to.equal(1e6);
+    });
+
+    it('rejects with an invalid level', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.trimMemory('severe' as any)).to.eventually.be.rejectedWith(/level must be/);
+    });
+  });
+
+  describe('setMemoryPriority()', () => {
+    afterEach(closeAllWindows);
+
+    it('can be retrieved with getMemoryPriority()', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(w.webContents.getMemoryPriority()).to.equal('normal');
+      w.webContents.setMemoryPriority('high');
+      expect(w.webContents.getMemoryPriority()).to.equal('high');
+    });
+
+    it('throws for an invalid priority', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.webContents.setMemoryPriority('urgent' as any)).to.throw(/Invalid memory priority/);
+    });
+  });
+
+  describe('setLifecyclePolicy()', () => {
+    afterEach(closeAllWindows);
+
+    it('can be retrieved with getLifecyclePolicy()', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(w.webContents.getLifecyclePolicy()).to.deep.equal({ freezeAfter: 0, discardAfter: 0 });
+      w.webContents.setLifecyclePolicy({ freezeAfter: 1000 });
+      expect(w.webContents.getLifecyclePolicy()).to.deep.equal({ freezeAfter: 1000, discardAfter: 0 });
+    });
+
+    it('throws for negative delays', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.webContents.setLifecyclePolicy({ discardAfter: -1 })).to.throw(/must be non-negative/);
+    });
+
+    it('freezes the hidden page', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const frozen = emittedOnce(w.webContents, 'frozen');
+      w.webContents.setLifecyclePolicy({ freezeAfter: 100 });
+      await frozen;
+      expect(w.webContents.isFrozen()).to.be.true();
+    });
+  });
+
+  describe('discard()', () => {
+    afterEach(closeAllWindows);
+
+    it('discards the renderer of a hidden page without emitting crashed', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      let crashed = false;
+      w.webContents.on('crashed', () => { crashed = true; });
+      expect(w.webContents.discard()).to.be.true();
+      expect(w.webContents.isDiscarded()).to.be.true();
+      await w.loadURL('about:blank');
+      expect(crashed).to.be.false();
+    });
+
+    it('keeps the page when will-discard is prevented', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.once('will-discard', (event) => event.preventDefault());
+      expect(w.webContents.discard()).to.be.false();
+      expect(w.webContents.isDiscarded()).to.be.false();
+    });
+  });
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows);
     it('does not crash when allowing', () => {
@@ -1536,6 +1873,219 @@ describe('webContents module', () => {
     });
   });
 
+  describe('setRendererPriority()', () => {
+    afterEach(closeAllWindows);
+    it('defaults to auto', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(w.webContents.getRendererPriority()).to.equal('auto');
+    });
+
+    it('keeps the priority across navigations', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.setRendererPriority('foreground');
+      await w.loadURL('about:blank');
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      expect(w.webContents.getRendererPriority()).to.equal('foreground');
+      w.setRendererPriority('auto');
+      expect(w.webContents.getRendererPriority()).to.equal('auto');
+    });
+
+    // Chromium backgrounds renderers on Linux by raising the nice value of
+    // their autogroup, when the kernel has autogroups.
+    const getAutogroupNice = (pid: number) => {
+      const autogroup = fs.readFileSync(`/proc/${pid}/autogroup`, 'utf8');
+      return Number(/nice\s+(-?\d+)/.exec(autogroup)![1]);
+    };
+    const waitForNice = async (pid: number, test: (nice: number) => boolean) => {
+      for (let i = 0; i < 20; i++) {
+        if (test(getAutogroupNice(pid))) return true;
+        await delay(100);
+      }
+      return false;
+    };
+
+    ifit(process.platform === 'linux' && fs.existsSync('/proc/self/autogroup'))('keeps the renderer of a hidden page at foreground priority', async function () {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      const pid = w.webContents.getOSProcessId();
+      if (!await waitForNice(pid, nice => nice > 0)) {
+        // The renderers can't be backgrounded here.
+        this.skip();
+      }
+      w.webContents.setRendererPriority('foreground');
+      expect(await waitForNice(pid, nice => nice === 0)).to.be.true('foreground priority');
+      w.webContents.setRendererPriority('auto');
+      expect(await waitForNice(pid, nice => nice > 0)).to.be.true('background priority');
+    });
+
+    it('throws for an invalid priority', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setRendererPriority('high' as any);
+      }).to.throw(/priority must be/);
+    });
+  });
+
+  describe('createSharedBuffer()', () => {
+    afterEach(closeAllWindows);
+    it('shares the memory of the buffer with the renderer', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.once('shared', (e, buffer) => {
+        const view = new Int32Array(buffer);
+        Atomics.store(view, 1, Atomics.load(view, 0) + 1);
+        e.ports[0].postMessage(buffer.byteLength);
+      }) && null`);
+      const { buffer, port } = w.webContents.createSharedBuffer('shared', 13, { doorbell: true });
+      const view = new Int32Array(buffer);
+      Atomics.store(view, 0, 41);
+      port!.start();
+      const [{ data }] = await emittedOnce(port!, 'message');
+      expect(data).to.equal(16);
+      expect(Atomics.load(view, 1)).to.equal(42);
+    });
+
+    it('throws for an invalid length', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.webContents.createSharedBuffer('shared', 0)).to.throw(/byteLength/);
+      expect(() => w.webContents.createSharedBuffer('shared', 2 ** 31)).to.throw(/byteLength/);
+    });
+  });
+
+  describe('prefetch() and prerender()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    const requests: string[] = [];
+    before(async () => {
+      server = http.createServer((req, res) => {
+        requests.push(`${req.url} ${req.headers.purpose || ''}`.trim());
+        res.setHeader('Cache-Control', 'no-cache');
+        if (req.url === '/script.js') {
+          res.end('document.title = "ran"');
+        } else if (req.url === '/popup') {
+          res.end('<script>window.open("about:blank")</script>');
+        } else {
+          res.end('<title>page</title><script src="/script.js"></script>');
+        }
+      });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    beforeEach(() => { requests.length = 0; });
+    after(() => { server.close(); });
+    afterEach(closeAllWindows);
+
+    it('prefetches a resource with the prefetch purpose', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.webContents.prefetch(`${serverUrl}/prefetched`);
+      expect(requests).to.deep.equal(['/prefetched prefetch']);
+    });
+
+    it('rejects for other schemes', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.webContents.prefetch('file:///')).to.eventually.be.rejectedWith(/Only http and https/);
+    });
+
+    it('goes through the webRequest listeners of the session', async () => {
+      const ses = session.fromPartition('prefetch-web-request');
+      const seen: string[] = [];
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        seen.push(details.url);
+        callback({});
+      });
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.webContents.prefetch(`${serverUrl}/prefetched`);
+      expect(seen).to.deep.equal([`${serverUrl}/prefetched`]);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('loads the page and its subresources', async () => {
+      const w = new BrowserWindow({ show: false });
+      const countBefore = webContents.getAllWebContents().length;
+      await w.webContents.prerender(`${serverUrl}/prerendered`);
+      expect(requests).to.include('/prerendered');
+      expect(requests).to.include('/script.js');
+      expect(webContents.getAllWebContents().length).to.equal(countBefore + 1);
+      await w.loadURL(`${serverUrl}/prerendered`);
+      expect(webContents.getAllWebContents().length).to.equal(countBefore);
+    });
+
+    it('drops the page when navigating to it with a fragment', async () => {
+      const w = new BrowserWindow({ show: false });
+      const countBefore = webContents.getAllWebContents().length;
+      await w.webContents.prerender(`${serverUrl}/prerendered`);
+      await w.loadURL(`${serverUrl}/prerendered#top`);
+      expect(webContents.getAllWebContents().length).to.equal(countBefore);
+    });
+
+    it('does not emit web-contents-created nor open windows', async () => {
+      const w = new BrowserWindow({ show: false });
+      const created: Electron.WebContents[] = [];
+      const onCreated = (event: Electron.Event, contents: Electron.WebContents) => { created.push(contents); };
+      app.on('web-contents-created', onCreated);
+      try {
+        const countBefore = webContents.getAllWebContents().length;
+        await w.webContents.prerender(`${serverUrl}/popup`);
+        await delay(500);
+        expect(created).to.be.empty();
+        expect(webContents.getAllWebContents().length).to.equal(countBefore + 1);
+      } finally {
+        app.removeListener('web-contents-created', onCreated);
+      }
+    });
+  });
+
+  describe('setNetworkConditions()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => { res.end('<title>ok</title>'); });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => { server.close(); });
+    afterEach(closeAllWindows);
+
+    it('emulates network outage', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.setNetworkConditions({ offline: true });
+      await expect(w.loadURL(serverUrl)).to.eventually.be.rejectedWith(/ERR_INTERNET_DISCONNECTED/);
+      w.webContents.setNetworkConditions(null);
+      await w.loadURL(serverUrl);
+      expect(w.webContents.getTitle()).to.equal('ok');
+    });
+
+    it('only affects its own WebContents', async () => {
+      const w = new BrowserWindow({ show: false });
+      const other = new BrowserWindow({ show: false });
+      w.webContents.setNetworkConditions({ offline: true });
+      await other.loadURL(serverUrl);
+      expect(other.webContents.getTitle()).to.equal('ok');
+    });
+
+    it('keeps throttling the frame after a cross-site navigation', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL(serverUrl);
+      const processId = w.webContents.getProcessId();
+      w.webContents.setNetworkConditions({ latency: 500 });
+      await w.loadURL(serverUrl.replace('127.0.0.1', 'localhost'));
+      expect(w.webContents.getProcessId()).to.not.equal(processId);
+      const elapsed = await w.webContents.executeJavaScript(`(async () => {
+        const start = performance.now();
+        await fetch('/throttled');
+        return performance.now() - start;
+      })()`);
+      expect(elapsed).to.be.at.least(400);
+    });
+
+    it('throws for invalid arguments', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setNetworkConditions('offline' as any);
+      }).to.throw(/Must pass null or an Object/);
+    });
+  });
+
   ifdescribe(features.isPrintingEnabled())('getPrinters()', () => {
     afterEach(closeAllWindows);
     it('can get printer list', async () => {
@@ -1546,6 +2096,63 @@ describe('webContents module', () => {
     });
   });
 
+  ifdescribe(features.isPrintingEnabled())('createPDFQueue()', () => {
+    afterEach(closeAllWindows);
+
+    it('generates PDFs by priority and reuses its windows', async () => {
+      const queue = webContents.createPDFQueue({ maxConcurrentJobs: 1 });
+      const started: string[] = [];
+      queue.on('job-started', ({ url }) => started.push(url));
+      const jobs = [
+        queue.render({ html: '<h1>first</h1>' }),
+        queue.render('data:text/html,<h1>low</h1>', { priority: 'low' }),
+        queue.render('data:text/html,<h1>high</h1>', { priority: 'high' })
+      ];
+      expect(queue.activeJobCount).to.equal(1);
+      expect(queue.pendingJobCount).to.equal(2);
+
+      const results = await Promise.all(jobs);
+      queue.close();
+      expect(started.slice(1)).to.deep.equal(['data:text/html,<h1>high</h1>', 'data:text/html,<h1>low</h1>']);
+      for (const { data, stats } of results) {
+        expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+        expect(stats.size).to.equal(data!.length);
+      }
+      expect(results.map(({ stats }) => stats.reusedWebContents)).to.deep.equal([false, true, true]);
+    });
+
+    it('writes PDFs to a file', async () => {
+      const queue = webContents.createPDFQueue();
+      const pdfPath = path.join(app.getPath('temp'), `pdf-queue-${Date.now()}.pdf`);
+      try {
+        const result = await queue.render({ html: '<h1>file</h1>' }, { path: pdfPath });
+        expect(result.data).to.be.undefined();
+        expect(fs.statSync(pdfPath).size).to.equal(result.stats.size);
+      } finally {
+        queue.close();
+        fs.unlinkSync(pdfPath);
+      }
+    });
+
+    it('rejects the pending jobs when closed', async () => {
+      const queue = webContents.createPDFQueue({ maxConcurrentJobs: 1 });
+      const running = queue.render({ html: '<h1>running</h1>' });
+      const pending = queue.render({ html: '<h1>pending</h1>' });
+      queue.close();
+      await expect(pending).to.eventually.be.rejectedWith('The PDF queue is closed');
+      await expect(running).to.eventually.be.fulfilled();
+    });
+
+    it('rejects html too large for a data: URL', async () => {
+      const queue = webContents.createPDFQueue();
+      try {
+        const html = `<p>${'a'.repeat(2 * 1024 * 1024)}</p>`;
+        await expect(queue.render({ html })).to.eventually.be.rejectedWith(/too large/);
+      } finally {
+        queue.close();
+      }
+    });
+
   ifdescribe(features.isPrintingEnabled())('printToPDF()', () => {
     let w: BrowserWindow;
 
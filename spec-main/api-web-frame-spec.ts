@@ -21,11 +21,14 @@ describe('webFrame module', () => {
 
     const spellCheckerFeedback =
       new Promise<[string[], boolean]>(resolve => {
+        const checkedWords: string[] = [];
         ipcMain.on('spec-spell-check', (e, words, callbackDefined) => {
-          if (words.length === 5) {
-            // The API calls the provider after every completed word.
-            // The promise is resolved only after this event is received with all words.
-            resolve([words, callbackDefined]);
+          // The API calls the provider after every completed word, with the
+          // words that were not checked before.
+          checkedWords.push(...words);
+          if (checkedWords.length >= 5) {
+            // The promise is resolved only after all words were received.
+            resolve([checkedWords, callbackDefined]);
           }
         });
       });
@@ -37,4 +40,34 @@ describe('webFrame module', () => {
     expect(words.sort()).to.deep.equal(['spleling', 'test', 'you\'re', 'you', 're'].sort());
     expect(callbackDefined).to.be.true();
   });
+
+  describe('webFrame.getWorldMemoryUsage()', () => {
+    it('reports the main and isolated worlds of the page', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: true
+        }
+      });
+      await w.loadURL('about:blank');
+      const usage = await new Promise<any>(resolve => {
+        ipcMain.once('world-memory-usage', (e, usage) => resolve(usage));
+        w.webContents.executeJavaScriptInIsolatedWorld(999, [{
+          code: `
+            const { webFrame, ipcRenderer } = require('electron');
+            webFrame.getWorldMemoryUsage().then(usage => ipcRenderer.send('world-memory-usage', usage));
+          `
+        }]);
+      });
+      const types = usage.worlds.map((world: any) => world.type);
+      expect(types).to.include('main');
+      expect(types).to.include('isolated');
+      for (const world of usage.worlds) {
+        expect(world.frameRoutingId).to.be.a('number');
+        expect(world.contextCount).to.be.at.least(1);
+        expect(world.size).to.be.above(0);
+      }
+    });
+  });
 });
@@ -16,6 +16,10 @@ describe('webRequest module', () => {
       res.statusCode = 301;
       res.setHeader('Location', 'http://' + req.rawHeaders[1]);
       res.end();
+    } else if (req.url === '/redirectToFilter') {
+      res.statusCode = 302;
+      res.setHeader('Location', '/filter/redirected');
+      res.end();
     } else {
       res.setHeader('Custom', ['Header']);
       let content = req.url;
@@ -80,6 +84,30 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404');
     });
 
+    it('sees requests redirected to filtered URLs', async () => {
+      const filter = { urls: [defaultURL + 'filter/*'] };
+      const urls: string[] = [];
+      ses.webRequest.onBeforeRequest(filter, (details, callback) => {
+        urls.push(details.url);
+        callback({ cancel: true });
+      });
+      await expect(ajax(`${defaultURL}redirectToFilter`)).to.eventually.be.rejectedWith('404');
+      expect(urls).to.deep.equal([`${defaultURL}filter/redirected`]);
+    });
+
+    it('can filter URLs with many patterns', async () => {
+      const urls = [defaultURL + 'filter/*'];
+      for (let i = 0; i < 1000; i++) {
+        urls.push(`*://*.host${i}.com/*`, `http://host${i}.org/path/*`);
+      }
+      ses.webRequest.onBeforeRequest({ urls }, (details, callback) => {
+        callback({ cancel: true });
+      });
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404');
+    });
+
     it('receives details object', async () => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         expect(details.id).to.be.a('number');
@@ -373,6 +401,60 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules([]);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('blocks requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'blocked/*'], action: 'block' }]);
+      const { data } = await ajax(`${defaultURL}allowed`);
+      expect(data).to.equal('/allowed');
+      await expect(ajax(`${defaultURL}blocked/test`)).to.eventually.be.rejectedWith('404');
+    });
+
+    it('does not block requests matching an allow rule', async () => {
+      ses.webRequest.setRules([
+        { urls: [defaultURL + 'blocked/*'], action: 'block' },
+        { urls: [defaultURL + 'blocked/allowed'], action: 'allow' }
+      ]);
+      const { data } = await ajax(`${defaultURL}blocked/allowed`);
+      expect(data).to.equal('/blocked/allowed');
+    });
+
+    it('redirects requests without calling the listener', async () => {
+      let called = false;
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        called = called || details.url.endsWith('/redirect');
+        callback({});
+      });
+      ses.webRequest.setRules([{ urls: [defaultURL + 'redirect'], action: 'redirect', redirectURL: defaultURL + 'redirected' }]);
+      const { data } = await ajax(`${defaultURL}redirect`);
+      expect(data).to.equal('/redirected');
+      expect(called).to.be.false('listener called');
+    });
+
+    it('modifies headers', async () => {
+      ses.webRequest.setRules([{
+        urls: [defaultURL + '*'],
+        action: 'modifyHeaders',
+        requestHeaders: { Accept: '*/*;test/header' },
+        responseHeaders: { Custom: null, 'X-Rule': 'applied' }
+      }]);
+      const { data, headers } = await ajax(defaultURL);
+      expect(data).to.equal('/header/received');
+      expect(headers).to.include('x-rule: applied');
+      expect(headers).to.not.include('custom: ');
+    });
+
+    it('throws for invalid rules', () => {
+      expect(() => ses.webRequest.setRules([{ action: 'unknown' } as any])).to.throw(/action/);
+      expect(() => ses.webRequest.setRules([{ action: 'redirect' } as any])).to.throw(/redirectURL/);
+      expect(() => ses.webRequest.setRules([{ urls: ['bad'], action: 'block' }])).to.throw(/Invalid url pattern/);
+    });
+  });
+
   describe('WebSocket connections', () => {
     it('can be proxyed', async () => {
       // Setup server.
@@ -1,7 +1,11 @@
 import { expect } from 'chai';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import { BrowserWindow, ipcMain } from 'electron';
 import { closeAllWindows } from './window-helpers';
+import { ifit } from './spec-helpers';
 
 describe('asar package', () => {
   const fixtures = path.join(__dirname, '..', 'spec', 'fixtures');
@@ -79,4 +83,137 @@ describe('asar package', () => {
       });
     });
   });
+
+  describe('precompiled index', () => {
+    let tempDir: string;
+
+    const pack = async (name: string, files: Record<string, string>) => {
+      const appDir = path.join(tempDir, `${name}-app`);
+      fs.mkdirSync(appDir);
+      for (const [file, contents] of Object.entries(files)) {
+        fs.writeFileSync(path.join(appDir, file), contents);
+      }
+      const asarPath = path.join(tempDir, `${name}.asar`);
+      await require('asar').createPackage(appDir, asarPath);
+      return asarPath;
+    };
+
+    before(() => {
+      tempDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-index-'));
+    });
+    after(() => {
+      fs.rmdirSync(tempDir, { recursive: true });
+    });
+
+    it('is used when it was built from the same header', async () => {
+      const asarPath = await pack('indexed', { 'a.txt': 'a', 'b.txt': 'bb' });
+      const copyPath = path.join(tempDir, 'indexed-copy.asar');
+      fs.copyFileSync(asarPath, copyPath);
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      expect(archive.writeIndex(`${copyPath}.idx`)).to.be.true();
+
+      const copy = process.electronBinding('asar').createArchive(copyPath);
+      expect(copy.readdir('')).to.have.members(['a.txt', 'b.txt']);
+      expect(copy.readFile('b.txt', true)).to.equal('bb');
+    });
+
+    it('is read instead of the header', async () => {
+      const indexedPath = await pack('listed', { 'from-index.txt': 'i' });
+      const asarPath = await pack('unlisted', { 'from-header.txt': 'h' });
+      const indexed = process.electronBinding('asar').createArchive(indexedPath);
+      const indexPath = `${asarPath}.idx`;
+      expect(indexed.writeIndex(indexPath)).to.be.true();
+
+      // Makes the index claim it was built from the header of |asarPath|, the
+      // listing then tells which of the two was read. The JSON string follows
+      // the header size pickle and the pickle and string lengths.
+      const asar = fs.readFileSync(asarPath);
+      const header = asar.slice(16, 16 + asar.readUInt32LE(12));
+      const index = fs.readFileSync(indexPath);
+      crypto.createHash('sha256').update(header).digest().copy(index, 8);
+      fs.writeFileSync(indexPath, index);
+
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      expect(archive.readdir('')).to.deep.equal(['from-index.txt']);
+    });
+
+    it('is ignored when it was built from another header', async () => {
+      const otherPath = await pack('other', { 'c.txt': 'c' });
+      const asarPath = await pack('stale', { 'd.txt': 'ddd' });
+      const other = process.electronBinding('asar').createArchive(otherPath);
+      expect(other.writeIndex(`${asarPath}.idx`)).to.be.true();
+
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      expect(archive.readdir('')).to.deep.equal(['d.txt']);
+      expect(archive.readFile('d.txt', true)).to.equal('ddd');
+    });
+  });
+
+  describe('native modules', () => {
+    const addon = Buffer.from('not really an addon');
+    const otherAddon = Buffer.from('an addon of another platform');
+    let tempDir: string;
+    let asarPath: string;
+
+    before(async () => {
+      tempDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-native-'));
+      const appDir = path.join(tempDir, 'app');
+      fs.mkdirSync(appDir);
+      fs.writeFileSync(path.join(appDir, 'addon.node'), addon);
+      fs.writeFileSync(path.join(appDir, 'other.node'), otherAddon);
+      asarPath = path.join(tempDir, 'app.asar');
+      await require('asar').createPackage(appDir, asarPath);
+    });
+    after(() => {
+      fs.rmdirSync(tempDir, { recursive: true });
+    });
+
+    // Copies are named after the archive rather than their contents, so look
+    // them up by their contents.
+    const cacheDir = path.join(os.tmpdir(), process.platform === 'win32' ? 'electron-asar-cache' : `electron-asar-cache-${process.getuid()}`);
+    const hasCachedCopy = (contents: Buffer) => {
+      if (!fs.existsSync(cacheDir)) return false;
+      return fs.readdirSync(cacheDir).some(name => {
+        try {
+          return fs.readFileSync(path.join(cacheDir, name)).equals(contents);
+        } catch {
+          return false;
+        }
+      });
+    };
+
+    it('only extracts the modules that are used', () => {
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      const extracted = archive.copyFileOut('addon.node');
+      expect(fs.readFileSync(extracted)).to.deep.equal(addon);
+      expect(hasCachedCopy(otherAddon)).to.be.false();
+    });
+
+    it('extracts native modules to a shared path', () => {
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      const extracted = archive.copyFileOut('addon.node');
+      expect(path.basename(path.dirname(extracted))).to.equal(path.basename(cacheDir));
+      expect(hasCachedCopy(addon)).to.be.true();
+    });
+
+    ifit(process.platform !== 'win32')('makes extracted copies read-only', () => {
+      const archive = process.electronBinding('asar').createArchive(asarPath);
+      const extracted = archive.copyFileOut('addon.node');
+      expect(fs.statSync(extracted).mode & 0o222).to.equal(0);
+    });
+
+    it('does not reuse a damaged copy of a file with integrity information', () => {
+      const integrityPath = path.join(asarDir, 'integrity.asar');
+      const contents = 'abcdefghijklmnop'.repeat(4);
+      const extracted = process.electronBinding('asar').createArchive(integrityPath).copyFileOut('file.txt');
+      expect(fs.readFileSync(extracted, 'utf8')).to.equal(contents);
+
+      // Same name and size, other contents.
+      fs.chmodSync(extracted, 0o600);
+      fs.writeFileSync(extracted, 'X'.repeat(contents.length));
+
+      const copy = process.electronBinding('asar').createArchive(integrityPath).copyFileOut('file.txt');
+      expect(fs.readFileSync(copy, 'utf8')).to.equal(contents);
+    });
+  });
 });
@@ -0,0 +1,82 @@
+// Serves the main process side of the IPC benchmarks: every transport echoes
+// what the renderer sends, and the renderer times the round trips.
+
+const { app, BrowserWindow, ipcMain } = require('electron');
+const fs = require('fs');
+const path = require('path');
+
+const defaults = {
+  transports: ['send', 'invoke', 'sendSync', 'postMessage', 'messagePort'],
+  types: ['string', 'object', 'buffer'],
+  sizes: [16, 1024, 64 * 1024, 1024 * 1024],
+  iterations: 1000,
+  batch: 200,
+  json: null
+};
+
+const options = Object.assign({}, defaults, JSON.parse(process.argv[2] || '{}'));
+
+ipcMain.on('bench-send', (event, value) => {
+  event.sender.send('bench-send-reply', value);
+});
+
+ipcMain.handle('bench-invoke', (event, value) => value);
+
+ipcMain.on('bench-send-sync', (event, value) => {
+  event.returnValue = value;
+});
+
+ipcMain.on('bench-post', (event, value) => {
+  event.sender.postMessage('bench-post-reply', value);
+});
+
+ipcMain.on('bench-port', (event) => {
+  const [port] = event.ports;
+  port.on('message', ({ data }) => port.postMessage(data));
+  port.start();
+});
+
+function formatSize (size) {
+  if (size >= 1024 * 1024) return `${size / (1024 * 1024)}MB`;
+  if (size >= 1024) return `${size / 1024}KB`;
+  return `${size}B`;
+}
+
+function printResults (results) {
+  const header = ['transport', 'type', 'size', 'p50', 'p90', 'p99', 'max',
+    'msg/s', 'MB/s'];
+  const rows = results.map(r => [
+    r.transport, r.type, formatSize(r.size),
+    ...[r.latency.p50, r.latency.p90, r.latency.p99, r.latency.max]
+      .map(ms => `${ms.toFixed(3)}ms`),
+    Math.round(r.throughput.messagesPerSecond).toString(),
+    r.throughput.megabytesPerSecond.toFixed(1)
+  ]);
+  const widths = header.map((h, i) =>
+    Math.max(h.length, ...rows.map(row => row[i].length)));
+  for (const row of [header, ...rows]) {
+    console.log(row.map((cell, i) => cell.padStart(widths[i])).join('  '));
+  }
+}
+
+app.whenReady().then(async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true }
+  });
+  await w.loadFile(path.join(__dirname, 'index.html'));
+  const results = await w.webContents.executeJavaScript(
+    `runBenchmarks(${JSON.stringify(options)})`);
+  printResults(results);
+  if (options.json) {
+    fs.writeFileSync(options.json, JSON.stringify({
+      versions: process.versions,
+      options,
+      results
+    }, null, 2));
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
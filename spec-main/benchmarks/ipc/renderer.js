@@ -0,0 +1,146 @@
+// Times the IPC round trips against the echo handlers of main.js.
+
+const { ipcRenderer } = require('electron');
+
+// Resolved from index.html.
+const { summarize } = require('../stats');
+
+// Replies on a channel come back in the order the requests were sent, so
+// they can be matched with a queue.
+function createReplyQueue () {
+  const pending = [];
+  return {
+    wait () {
+      return new Promise(resolve => pending.push(resolve));
+    },
+    resolve (value) {
+      pending.shift()(value);
+    }
+  };
+}
+
+function createChannelTransport (channel, replyChannel, send) {
+  const queue = createReplyQueue();
+  const listener = (event, value) => queue.resolve(value);
+  ipcRenderer.on(replyChannel, listener);
+  return {
+    roundTrip (payload) {
+      const reply = queue.wait();
+      send(channel, payload);
+      return reply;
+    },
+    close () {
+      ipcRenderer.removeListener(replyChannel, listener);
+    }
+  };
+}
+
+const transports = {
+  send () {
+    return createChannelTransport('bench-send', 'bench-send-reply',
+      (channel, payload) => ipcRenderer.send(channel, payload));
+  },
+  invoke () {
+    return {
+      roundTrip: payload => ipcRenderer.invoke('bench-invoke', payload),
+      close () {}
+    };
+  },
+  sendSync () {
+    return {
+      roundTrip: payload =>
+        Promise.resolve(ipcRenderer.sendSync('bench-send-sync', payload)),
+      close () {}
+    };
+  },
+  postMessage () {
+    return createChannelTransport('bench-post', 'bench-post-reply',
+      (channel, payload) => ipcRenderer.postMessage(channel, payload));
+  },
+  messagePort () {
+    const { port1, port2 } = new MessageChannel();
+    ipcRenderer.postMessage('bench-port', null, [port2]);
+    const queue = createReplyQueue();
+    port1.onmessage = ({ data }) => queue.resolve(data);
+    return {
+      roundTrip (payload) {
+        const reply = queue.wait();
+        port1.postMessage(payload);
+        return reply;
+      },
+      close () {
+        port1.close();
+      }
+    };
+  }
+};
+
+// Builds a payload of about |size| bytes once serialized.
+function createPayload (type, size) {
+  switch (type) {
+    case 'string':
+      return 'x'.repeat(size);
+    case 'buffer':
+      return new Uint8Array(size);
+    case 'object': {
+      // Each record is about 32 bytes.
+      const count = Math.max(1, Math.round(size / 32));
+      return Array.from({ length: count },
+        (_, i) => ({ id: i, name: `item${i}`, done: i % 2 === 0 }));
+    }
+    default:
+      throw new Error(`Unknown payload type: ${type}`);
+  }
+}
+
+async function measureLatency (transport, payload, iterations) {
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = performance.now();
+    await transport.roundTrip(payload);
+    samples.push(performance.now() - start);
+  }
+  return summarize(samples, [50, 90, 99]);
+}
+
+// Keeps |batch| round trips in flight, except for sendSync which can only
+// have one.
+async function measureThroughput (transport, payload, size, batch) {
+  const start = performance.now();
+  await Promise.all(Array.from({ length: batch },
+    () => transport.roundTrip(payload)));
+  const seconds = (performance.now() - start) / 1000;
+  return {
+    messagesPerSecond: batch / seconds,
+    megabytesPerSecond: batch * size / (1024 * 1024) / seconds
+  };
+}
+
+window.runBenchmarks = async function (options) {
+  const results = [];
+  for (const name of options.transports) {
+    if (!transports[name]) throw new Error(`Unknown transport: ${name}`);
+    const transport = transports[name]();
+    for (const type of options.types) {
+      for (const size of options.sizes) {
+        const payload = createPayload(type, size);
+        // Cap the bytes moved by a single case so that large payloads do not
+        // dominate the run.
+        const limit = Math.max(10, Math.floor(256 * 1024 * 1024 / size));
+        const iterations = Math.min(options.iterations, limit);
+        const batch = Math.min(options.batch, limit);
+        await measureLatency(transport, payload, Math.ceil(iterations / 10));
+        results.push({
+          transport: name,
+          type,
+          size,
+          iterations,
+          latency: await measureLatency(transport, payload, iterations),
+          throughput: await measureThroughput(transport, payload, size, batch)
+        });
+      }
+    }
+    transport.close();
+  }
+  return results;
+};
@@ -0,0 +1,98 @@
+// The Electron side of script/osr-benchmark.js: renders animated pages
+// offscreen at several sizes and frame rates, and writes what each case
+// achieved to a file. Software and GPU modes need a launch each.
+
+const { app, BrowserWindow } = require('electron');
+const fs = require('fs');
+const path = require('path');
+
+const { summarize } = require('../stats');
+
+const options = JSON.parse(process.argv[2] || '{}');
+
+if (options.mode === 'software') {
+  app.disableHardwareAcceleration();
+}
+
+function sleep (ms) {
+  return new Promise(resolve => setTimeout(resolve, ms));
+}
+
+// CPU time of all the processes of the app since the previous call, in
+// milliseconds.
+function takeCPUTime (elapsed) {
+  return app.getAppMetrics().reduce((total, metric) =>
+    total + metric.cpu.percentCPUUsage / 100 * elapsed, 0);
+}
+
+async function measure (page, width, height, frameRate) {
+  const w = new BrowserWindow({
+    show: false,
+    width,
+    height,
+    useContentSize: true,
+    webPreferences: { offscreen: true }
+  });
+  w.webContents.setFrameRate(frameRate);
+
+  let measuring = false;
+  let frames = 0;
+  let bytes = 0;
+  const latencies = [];
+  const captureTimes = [];
+  w.webContents.on('paint', (event, dirty, image) => {
+    if (!measuring) return;
+    frames++;
+    // getBitmap() does not copy, the length is what the paint path copied
+    // out of the compositor frame.
+    bytes += image.getBitmap().length;
+    const timing = event.frameTiming || {};
+    const begin = timing.beginFrame !== undefined ? timing.beginFrame : timing.frameTime;
+    if (begin !== undefined) latencies.push(timing.delivered - begin);
+    if (timing.captureBegin !== undefined && timing.captureEnd !== undefined) {
+      captureTimes.push(timing.captureEnd - timing.captureBegin);
+    }
+  });
+
+  await w.loadFile(path.join(__dirname, 'pages', `${page}.html`));
+  await sleep(options.warmup);
+
+  takeCPUTime(0);
+  const start = Date.now();
+  measuring = true;
+  await sleep(options.duration);
+  measuring = false;
+  const elapsed = Date.now() - start;
+  const cpuTime = takeCPUTime(elapsed);
+  w.destroy();
+
+  return {
+    mode: options.mode,
+    page,
+    width,
+    height,
+    frameRate,
+    fps: frames / (elapsed / 1000),
+    latency: summarize(latencies),
+    captureTime: summarize(captureTimes),
+    cpuTimePerFrame: frames ? cpuTime / frames : null,
+    bytesPerFrame: frames ? bytes / frames : 0,
+    megabytesPerSecond: bytes / (1024 * 1024) / (elapsed / 1000)
+  };
+}
+
+app.whenReady().then(async () => {
+  const results = [];
+  for (const page of options.pages) {
+    for (const [width, height] of options.sizes) {
+      for (const frameRate of options.frameRates) {
+        results.push(await measure(page, width, height, frameRate));
+      }
+    }
+  }
+  fs.writeFileSync(options.output, JSON.stringify(results));
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
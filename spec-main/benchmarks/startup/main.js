@@ -0,0 +1,129 @@
+// The Electron side of the startup benchmarks of script/startup-benchmark.js.
+// In the "ready" mode it only reports when the app is ready, the launches are
+// timed by the script. In the "suite" mode it times the window, preload, asar
+// and protocol cases in this process and writes the results to a file.
+
+const { app, BrowserWindow, ipcMain, protocol } = require('electron');
+const fs = require('fs');
+const path = require('path');
+
+const { summarize } = require('../stats');
+
+const options = JSON.parse(process.argv[2] || '{}');
+
+if (options.userData) {
+  app.setPath('userData', options.userData);
+}
+
+protocol.registerSchemesAsPrivileged([
+  { scheme: 'bench', privileges: { standard: true, supportFetchAPI: true } }
+]);
+
+function now () {
+  return Number(process.hrtime.bigint()) / 1e6;
+}
+
+async function measureWindows (iterations) {
+  const readyToShow = [];
+  const preloadStart = [];
+  const preloadDuration = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = now();
+    const w = new BrowserWindow({
+      show: false,
+      webPreferences: {
+        contextIsolation: true,
+        preload: path.join(__dirname, 'preload.js')
+      }
+    });
+    const preload = new Promise(resolve => {
+      ipcMain.once('bench-preload', (event, times) => resolve(times));
+    });
+    const shown = new Promise(resolve => w.once('ready-to-show', resolve));
+    w.loadFile(path.join(__dirname, 'index.html'));
+    await shown;
+    readyToShow.push(now() - start);
+    const times = await preload;
+    preloadStart.push(times.start);
+    preloadDuration.push(times.duration);
+    w.destroy();
+  }
+  return {
+    readyToShow: summarize(readyToShow),
+    preloadStart: summarize(preloadStart),
+    preloadDuration: summarize(preloadDuration)
+  };
+}
+
+// |archives| are copies of the same archive, each one is opened once since
+// the archives are cached once opened.
+function measureAsar (archives) {
+  const open = [];
+  const read = [];
+  let bytes = 0;
+  for (const archive of archives) {
+    let start = now();
+    const names = fs.readdirSync(archive);
+    open.push(now() - start);
+
+    start = now();
+    for (const name of names) {
+      bytes += fs.readFileSync(path.join(archive, name)).length;
+    }
+    read.push(now() - start);
+  }
+  const seconds = read.reduce((a, b) => a + b, 0) / 1000;
+  return {
+    open: summarize(open),
+    read: summarize(read),
+    megabytesPerSecond: bytes / (1024 * 1024) / seconds
+  };
+}
+
+async function measureProtocol (requests, concurrency) {
+  const body = Buffer.alloc(1024, 'a');
+  protocol.registerBufferProtocol('bench', (request, callback) => {
+    if (new URL(request.url).pathname === '/') {
+      callback({ mimeType: 'text/html', data: Buffer.from('<html></html>') });
+    } else {
+      callback({ mimeType: 'text/plain', data: body });
+    }
+  });
+  const w = new BrowserWindow({ show: false });
+  await w.loadURL('bench://app/');
+  const elapsed = await w.webContents.executeJavaScript(`(async () => {
+    let next = 0;
+    const worker = async () => {
+      while (next < ${requests}) {
+        await (await fetch('bench://app/' + next++)).text();
+      }
+    };
+    const start = performance.now();
+    await Promise.all(Array.from({ length: ${concurrency} }, worker));
+    return performance.now() - start;
+  })()`);
+  w.destroy();
+  protocol.unregisterProtocol('bench');
+  return { requests, concurrency, requestsPerSecond: requests / (elapsed / 1000) };
+}
+
+async function runSuite () {
+  const results = {
+    window: await measureWindows(options.iterations),
+    asar: measureAsar(options.archives),
+    protocol: await measureProtocol(options.requests, options.concurrency)
+  };
+  fs.writeFileSync(options.output, JSON.stringify(results));
+}
+
+app.whenReady().then(async () => {
+  if (options.mode === 'ready') {
+    process.stdout.write('ready\n');
+  } else {
+    await runSuite();
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
@@ -0,0 +1,20 @@
+// Reports when the preload ran, relative to the start of the navigation, and
+// how long it took to load what a typical preload uses and expose an API to
+// the page.
+
+const start = performance.now();
+const { contextBridge, ipcRenderer } = require('electron');
+const crypto = require('crypto');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const api = {
+  platform: os.platform(),
+  hash: (data) => crypto.createHash('sha256').update(data).digest('hex'),
+  exists: (file) => fs.existsSync(path.resolve(file)),
+  send: (channel, ...args) => ipcRenderer.send(channel, ...args)
+};
+contextBridge.exposeInMainWorld('bench', api);
+
+ipcRenderer.send('bench-preload', { start, duration: performance.now() - start });
@@ -0,0 +1,26 @@
+// Statistics shared by the benchmarks of spec-main/benchmarks and their
+// scripts in script/.
+
+// Nearest-rank percentile of sorted |samples|.
+function percentile (samples, p) {
+  const rank = Math.ceil(p / 100 * samples.length);
+  return samples[Math.min(samples.length, Math.max(1, rank)) - 1];
+}
+
+// The minimum, mean, maximum and |percentiles| of |samples|, or null when
+// there are none.
+function summarize (samples, percentiles = [50, 90]) {
+  if (samples.length === 0) return null;
+  samples = samples.slice().sort((a, b) => a - b);
+  const summary = {
+    min: samples[0],
+    mean: samples.reduce((a, b) => a + b, 0) / samples.length
+  };
+  for (const p of percentiles) {
+    summary[`p${p}`] = percentile(samples, p);
+  }
+  summary.max = samples[samples.length - 1];
+  return summary;
+}
+
+module.exports = { percentile, summarize };
@@ -502,7 +502,7 @@ describe('chromium features', () => {
 
   describe('window.open', () => {
     for (const show of [true, false]) {
-      it(`inherits parent visibility over parent {show=${show}} option`, (done) => {
+      it(`inherits the parent {show=${show}} option rather than its visibility`, (done) => {
         const w = new BrowserWindow({ show });
 
         // toggle visibility
@@ -513,7 +513,7 @@ describe('chromium features', () => {
         }
 
         w.webContents.once('new-window', (e, url, frameName, disposition, options) => {
-          expect(options.show).to.equal(w.isVisible());
+          expect(options.show).to.equal(show);
           w.close();
           done();
         });
@@ -521,6 +521,20 @@ describe('chromium features', () => {
       });
     }
 
+    it('does not inherit the bounds of the parent window', (done) => {
+      const w = new BrowserWindow({ show: false, width: 300, height: 200 });
+      w.setPosition(123, 45);
+      w.webContents.once('new-window', (e, url, frameName, disposition, options) => {
+        expect(options).to.not.have.property('x');
+        expect(options).to.not.have.property('y');
+        expect(options.width).to.equal(300);
+        expect(options.height).to.equal(200);
+        w.close();
+        done();
+      });
+      w.loadFile(path.join(fixturesPath, 'pages', 'window-open.html'));
+    });
+
     it('disables node integration when it is disabled on the parent window for chrome devtools URLs', async () => {
       const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
       w.loadURL('about:blank');
@@ -584,6 +598,26 @@ describe('chromium features', () => {
       });
     });
 
+    it('does not add a listener to the opener for each window it opens', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.loadURL('about:blank');
+      const created = new Promise<void>((resolve) => {
+        let count = 0;
+        app.on('browser-window-created', function listener () {
+          if (++count === 12) {
+            app.removeListener('browser-window-created', listener);
+            resolve();
+          }
+        });
+      });
+      w.webContents.executeJavaScript(`
+        for (let i = 0; i < 12; i++) window.open('about:blank', '', 'show=no');
+        null
+      `);
+      await created;
+      expect(w.webContents.listenerCount('current-render-view-deleted')).to.equal(1);
+    });
+
     it('defines a window.location getter', async () => {
       let targetURL: string;
       if (process.platform === 'win32') {
@@ -677,6 +711,15 @@ describe('chromium features', () => {
       session.defaultSession.setPermissionCheckHandler(null);
     });
 
+    it('grants the devices to the first getUserMedia of the app', async () => {
+      const appPath = path.join(fixturesPath, 'api', 'first-get-user-media');
+      const appProcess = ChildProcess.spawn(process.execPath, [appPath]);
+      let output = '';
+      appProcess.stdout.on('data', (data) => { output += data; });
+      await emittedOnce(appProcess.stdout, 'end');
+      expect(output.trim()).to.equal('audio,video');
+    });
+
     it('can return labels of enumerated devices', async () => {
       const w = new BrowserWindow({ show: false });
       w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
@@ -692,6 +735,23 @@ describe('chromium features', () => {
       expect(labels.some((l: any) => l)).to.be.false();
     });
 
+    it('reuses the results of the permission check handler with a cacheTimeout', async () => {
+      let checks = 0;
+      session.defaultSession.setPermissionCheckHandler(() => {
+        checks++;
+        return false;
+      }, { cacheTimeout: 60 * 1000 });
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
+      const enumerate = 'navigator.mediaDevices.enumerateDevices().then(ds => ds.map(d => d.label))';
+      await w.webContents.executeJavaScript(enumerate);
+      const firstChecks = checks;
+      expect(firstChecks).to.be.greaterThan(0);
+      const labels = await w.webContents.executeJavaScript(enumerate);
+      expect(labels.some((l: any) => l)).to.be.false();
+      expect(checks).to.equal(firstChecks);
+    });
+
     it('returns the same device ids across reloads', async () => {
       const ses = session.fromPartition('persist:media-device-id');
       const w = new BrowserWindow({
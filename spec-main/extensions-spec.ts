@@ -3,6 +3,7 @@ import { app, session, BrowserWindow, ipcMain, WebContents, Extension } from 'el
 import { closeAllWindows, closeWindow } from './window-helpers';
 import * as http from 'http';
 import { AddressInfo } from 'net';
+import * as os from 'os';
 import * as path from 'path';
 import * as fs from 'fs';
 import { ifdescribe } from './spec-helpers';
@@ -57,6 +58,49 @@ ifdescribe(process.electronBinding('features').isExtensionsEnabled())('chrome ex
     expect(extension.manifest).to.deep.equal(manifest);
   });
 
+  it('loads several extensions at once', async () => {
+    const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
+    const names = ['red-bg', 'chrome-i18n', 'chrome-storage'];
+    const extensions = await Promise.all(names.map(name => customSession.loadExtension(path.join(fixtures, 'extensions', name))));
+    expect(extensions.map(extension => path.basename(extension.path))).to.deep.equal(names);
+    expect(customSession.getAllExtensions()).to.have.lengthOf(names.length);
+  });
+
+  it('loads an unchanged extension again', async () => {
+    const extensionPath = path.join(fixtures, 'extensions', 'red-bg');
+    const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
+    const { id } = await customSession.loadExtension(extensionPath);
+    customSession.removeExtension(id);
+    const extension = await customSession.loadExtension(extensionPath);
+    expect(extension.id).to.equal(id);
+  });
+
+  it('checks an extension again when any of its files changed', async () => {
+    const extensionPath = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-extension-spec-'));
+    const scriptsPath = path.join(extensionPath, 'scripts');
+    try {
+      fs.mkdirSync(scriptsPath);
+      fs.copyFileSync(path.join(fixtures, 'extensions', 'red-bg', 'main.js'), path.join(scriptsPath, 'main.js'));
+      fs.writeFileSync(path.join(extensionPath, 'manifest.json'), JSON.stringify({
+        name: 'red-bg',
+        version: '1.0',
+        content_scripts: [{ matches: ['<all_urls>'], js: ['scripts/main.js'] }],
+        manifest_version: 2
+      }));
+      const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
+      const { id } = await customSession.loadExtension(extensionPath);
+      customSession.removeExtension(id);
+
+      // Neither the extension directory nor the manifest looks modified.
+      const { atime, mtime } = fs.statSync(extensionPath);
+      fs.unlinkSync(path.join(scriptsPath, 'main.js'));
+      fs.utimesSync(extensionPath, atime, mtime);
+      await expect(customSession.loadExtension(extensionPath)).to.eventually.be.rejectedWith(/main\.js/);
+    } finally {
+      fs.rmdirSync(extensionPath, { recursive: true });
+    }
+  });
+
   it('removes an extension', async () => {
     const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
     const { id } = await customSession.loadExtension(path.join(fixtures, 'extensions', 'red-bg'));
@@ -262,6 +306,18 @@ ifdescribe(process.electronBinding('features').isExtensionsEnabled())('chrome ex
       const receivedMessage = await w.webContents.executeJavaScript('window.completionPromise');
       expect(receivedMessage).to.deep.equal({ some: 'message' });
     });
+
+    it('loads a persistent background page as an event page with lazyBackground', async () => {
+      const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
+      const extension = await customSession.loadExtension(path.join(fixtures, 'extensions', 'persistent-background-page'), { lazyBackground: true });
+      expect(extension.manifest.background.persistent).to.be.false();
+    });
+
+    it('keeps persistent background pages persistent by default', async () => {
+      const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
+      const extension = await customSession.loadExtension(path.join(fixtures, 'extensions', 'persistent-background-page'));
+      expect(extension.manifest.background.persistent).to.be.true();
+    });
   });
 
   describe('devtools extensions', () => {
@@ -580,6 +636,49 @@ ifdescribe(!process.electronBinding('features').isExtensionsEnabled())('chrome e
     expect(response).to.equal(3);
   });
 
+  describe('content script code cache', () => {
+    let server: http.Server;
+    let port: number;
+    before(async () => {
+      server = http.createServer((req, res) => res.end());
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      port = (server.address() as AddressInfo).port;
+    });
+    after(() => { server.close(); });
+
+    // The renderer only sends a code cache back when it had none it could
+    // use, so no new cache means the one it was given was consumed.
+    const loadAndCountNewCaches = async (ses: Electron.Session, url: string) => {
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      let newCaches = 0;
+      w.webContents.on('-ipc-message' as any, (event: any, internal: boolean, channel: string) => {
+        if (internal && channel === 'ELECTRON_BROWSER_CONTENT_SCRIPT_CODE_CACHE') newCaches++;
+      });
+      await w.loadURL(url);
+
+      const promise = emittedOnce(w.webContents, 'console-message');
+      const message = { method: 'sendMessage', args: ['Hello World!'] };
+      w.webContents.executeJavaScript(`window.postMessage('${JSON.stringify(message)}', '*')`);
+      const [,, responseString] = await promise;
+      expect(JSON.parse(responseString).message).to.equal('Hello World!');
+      w.destroy();
+      return newCaches;
+    };
+
+    it('runs content scripts from their code cache on later loads', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      const url = `http://127.0.0.1:${port}/`;
+      expect(await loadAndCountNewCaches(ses, url)).to.be.greaterThan(0);
+      expect(await loadAndCountNewCaches(ses, url)).to.equal(0);
+    });
+
+    it('does not use the code cache of another origin', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(await loadAndCountNewCaches(ses, `http://127.0.0.1:${port}/`)).to.be.greaterThan(0);
+      expect(await loadAndCountNewCaches(ses, `http://localhost:${port}/`)).to.be.greaterThan(0);
+    });
+  });
+
   describe('extensions and dev tools extensions', () => {
     let showPanelTimeoutId: NodeJS.Timeout | null = null;
 
@@ -0,0 +1,9 @@
+const { threadId } = require('worker_threads');
+
+exports.add = (event, a, b) => {
+  return { sum: a + b, threadId, senderId: event.senderId };
+};
+
+exports.fail = async () => {
+  throw new Error('failed in the worker');
+};
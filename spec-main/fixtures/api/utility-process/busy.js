@@ -0,0 +1,2 @@
+// Never returns to the message loop.
+while (true) {}
@@ -0,0 +1,3 @@
+process.parentPort.on('message', ({ data }) => {
+  process.parentPort.postMessage({ data, argv: process.argv.slice(2), type: process.type });
+});
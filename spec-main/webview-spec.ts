@@ -151,6 +151,40 @@ describe('<webview> tag', function () {
     });
   });
 
+  describe('events', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          webviewTag: true,
+          nodeIntegration: true
+        }
+      });
+      await w.loadURL('about:blank');
+    });
+
+    it('only forwards the events that have listeners', async () => {
+      const didAttachWebview = emittedOnce(w.webContents, 'did-attach-webview');
+      await loadWebView(w.webContents, { src: 'about:blank' });
+      const [, guest] = await didAttachWebview;
+      expect(guest.listenerCount('did-finish-load')).to.be.at.least(1);
+      expect(guest.listenerCount('console-message')).to.equal(0);
+    });
+
+    it('dispatches the events listened to after the guest is attached', async () => {
+      await loadWebView(w.webContents, { src: 'about:blank' });
+      const message = await w.webContents.executeJavaScript(`
+        new Promise((resolve) => {
+          const webview = document.querySelector('webview')
+          webview.addEventListener('console-message', (e) => resolve(e.message))
+          webview.executeJavaScript('console.log("hello")')
+        })
+      `);
+      expect(message).to.equal('hello');
+    });
+  });
+
   it('loads devtools extensions registered on the parent window', async () => {
     const w = new BrowserWindow({
       show: false,
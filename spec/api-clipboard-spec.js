@@ -23,6 +23,24 @@ describe('clipboard module', () => {
     });
   });
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with a NativeImage instance', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.writeImage(p);
+      const image = await clipboard.readImageAsync();
+      expect(image.toDataURL()).to.equal(i.toDataURL());
+    });
+  });
+
+  describe('clipboard.readTextAsync()', () => {
+    it('resolves with the text', async () => {
+      const text = '千江有水千江月，万里无云万里天';
+      clipboard.writeText(text);
+      expect(await clipboard.readTextAsync()).to.equal(text);
+    });
+  });
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天';
@@ -130,6 +148,18 @@ describe('clipboard module', () => {
     });
   });
 
+  describe('clipboard.readMany(formats)', () => {
+    it('returns the content of the formats on the clipboard', () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.write({ text: 'test', image: p });
+      const result = clipboard.readMany(['text', 'image', 'html']);
+      expect(result.text).to.equal('test');
+      expect(result.image.toDataURL()).to.equal(i.toDataURL());
+      expect(result).to.not.have.property('html');
+    });
+  });
+
   describe('clipboard.readBuffer(format)', () => {
     before(function () {
       if (process.platform !== 'darwin') {
@@ -3,6 +3,8 @@
 const { expect } = require('chai');
 const { nativeImage } = require('electron');
 const { ifdescribe, ifit } = require('./spec-helpers');
+const fs = require('fs');
+const os = require('os');
 const path = require('path');
 
 describe('nativeImage module', () => {
@@ -162,6 +164,18 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('getBitmap()', () => {
+    it('copies the pixels of images that are shared', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      const imageA = nativeImage.createFromPath(imagePath);
+      const imageB = nativeImage.createFromPath(imagePath);
+      const original = imageA.toBitmap();
+      imageA.getBitmap().fill(0);
+      expect(imageA.toBitmap().equals(original)).to.be.true();
+      expect(imageB.toBitmap().equals(original)).to.be.true();
+    });
+  });
+
   describe('createFromBitmap(buffer, options)', () => {
     it('returns an empty image when the buffer is empty', () => {
       expect(nativeImage.createFromBitmap(Buffer.from([]), { width: 0, height: 0 }).isEmpty()).to.be.true();
@@ -177,9 +191,19 @@ describe('nativeImage module', () => {
       expect(imageC.getSize()).to.deep.equal({ width: 269, height: 95 });
     });
 
+    it('shares the pixels of the buffer when copy is false', () => {
+      const imageA = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const bitmap = imageA.toBitmap();
+      const original = Buffer.from(bitmap);
+      const imageB = nativeImage.createFromBitmap(bitmap, { ...imageA.getSize(), copy: false });
+      expect(imageB.getSize()).to.deep.equal(imageA.getSize());
+      expect(bitmap).to.have.lengthOf(0);
+      expect(imageB.toBitmap().equals(original)).to.be.true();
+    });
+
     it('throws on invalid arguments', () => {
-      expect(() => nativeImage.createFromBitmap(null, {})).to.throw('buffer must be a node Buffer');
-      expect(() => nativeImage.createFromBitmap([12, 14, 124, 12], {})).to.throw('buffer must be a node Buffer');
+      expect(() => nativeImage.createFromBitmap(null, {})).to.throw('buffer must be a Buffer or an ArrayBuffer');
+      expect(() => nativeImage.createFromBitmap([12, 14, 124, 12], {})).to.throw('buffer must be a Buffer or an ArrayBuffer');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), {})).to.throw('width is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1 })).to.throw('height is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1, height: 1 })).to.throw('invalid buffer size');
@@ -339,7 +363,69 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('toPNGAsync()', () => {
+    it('resolves with the same data as toPNG()', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const buffer = await image.toPNGAsync({ scaleFactor: 2.0 });
+      expect(buffer.equals(image.toPNG({ scaleFactor: 2.0 }))).to.be.true();
+    });
+  });
+
+  describe('toJPEGAsync(quality)', () => {
+    it('resolves with the same data as toJPEG()', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const buffer = await image.toJPEGAsync(90);
+      expect(buffer.equals(image.toJPEG(90))).to.be.true();
+    });
+  });
+
+  describe('toWebP(quality)', () => {
+    it('returns WebP encoded data', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const buffer = image.toWebP(80);
+      expect(buffer.slice(0, 4).toString()).to.equal('RIFF');
+      expect(buffer.slice(8, 12).toString()).to.equal('WEBP');
+      expect((await image.toWebPAsync(80)).equals(buffer)).to.be.true();
+    });
+  });
+
+  describe('createFromPathAsync(path)', () => {
+    it('resolves with an empty image for invalid paths', async () => {
+      const image = await nativeImage.createFromPathAsync('does-not-exist.png');
+      expect(image.isEmpty()).to.be.true();
+    });
+
+    it('loads the same image as createFromPath()', async () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      const image = await nativeImage.createFromPathAsync(imagePath);
+      expect(image.isEmpty()).to.be.false();
+      expect(image.toDataURL()).to.equal(nativeImage.createFromPath(imagePath).toDataURL());
+    });
+  });
+
   describe('createFromPath(path)', () => {
+    it('does not decode the same file again', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      nativeImage.createFromPath(imagePath);
+      const hits = nativeImage._getDecodedImageCacheHits();
+      const image = nativeImage.createFromPath(imagePath);
+      expect(nativeImage._getDecodedImageCacheHits()).to.equal(hits + 1);
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 });
+    });
+
+    it('loads the new content of a file that changed', () => {
+      const imagePath = path.join(os.tmpdir(), `electron-spec-image-${Date.now()}.png`);
+      try {
+        fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', 'logo.png'), imagePath);
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+        fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', '1x1.png'), imagePath);
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 1, height: 1 });
+      } finally {
+        fs.unlinkSync(imagePath);
+      }
+    });
+
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty()).to.be.true();
       expect(nativeImage.createFromPath('does-not-exist.png').isEmpty()).to.be.true();
@@ -474,6 +560,36 @@ describe('nativeImage module', () => {
       expect(good.toPNG()).to.have.lengthOf.at.most(better.toPNG().length);
       expect(better.toPNG()).to.have.lengthOf.below(best.toPNG().length);
     });
+
+    it('supports explicit filters', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      for (const quality of ['box', 'bilinear', 'lanczos']) {
+        const resized = image.resize({ width: 100, quality });
+        expect(resized.getSize()).to.deep.equal({ width: 100, height: 35 });
+      }
+    });
+  });
+
+  describe('resizeAsync(options)', () => {
+    it('resolves with a resized image', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const resized = await image.resizeAsync({ width: 269, quality: 'bilinear' });
+      expect(resized.getSize()).to.deep.equal({ width: 269, height: 95 });
+      expect(resized.toDataURL()).to.equal(image.resize({ width: 269, quality: 'bilinear' }).toDataURL());
+    });
+
+    it('resizes with the same quality as resize()', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      for (const quality of [undefined, 'good', 'better', 'best', 'box', 'lanczos']) {
+        const resized = await image.resizeAsync({ width: 100, height: 100, quality });
+        expect(resized.toDataURL()).to.equal(image.resize({ width: 100, height: 100, quality }).toDataURL());
+      }
+    });
+
+    it('resolves with an empty image when called on an empty image', async () => {
+      const resized = await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 });
+      expect(resized.isEmpty()).to.be.true();
+    });
   });
 
   describe('crop(bounds)', () => {
@@ -115,4 +115,36 @@ describe('process module', () => {
       expect(success).to.be.false();
     });
   });
+
+  describe('process.startSamplingHeapProfiler()', () => {
+    it('records the allocations in the format of DevTools', () => {
+      expect(process.startSamplingHeapProfiler({ samplingInterval: 1024 })).to.be.true();
+      window.heapProfilerData = new Array(1e5).fill({});
+      const profile = JSON.parse(process.stopSamplingHeapProfiler());
+      delete window.heapProfilerData;
+      expect(profile.head.callFrame).to.have.property('functionName');
+      expect(profile.samples).to.be.an('array');
+    });
+
+    it('returns null when the profiler was not started', () => {
+      expect(process.stopSamplingHeapProfiler()).to.be.null();
+    });
+  });
+
+  describe('process.startCPUProfiler()', () => {
+    it('records the samples in the format of DevTools', () => {
+      expect(process.startCPUProfiler({ samplingInterval: 100 })).to.be.true();
+      expect(process.startCPUProfiler()).to.be.false();
+      const end = Date.now() + 50;
+      while (Date.now() < end) { /* busy */ }
+      const profile = JSON.parse(process.stopCPUProfiler());
+      expect(profile.nodes[0].callFrame).to.have.property('functionName');
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+      expect(profile.endTime).to.be.at.least(profile.startTime);
+    });
+
+    it('returns null when the profiler was not started', () => {
+      expect(process.stopCPUProfiler()).to.be.null();
+    });
+  });
 });
@@ -804,6 +804,22 @@ describe('asar package', function () {
           fs.readdirSync(p);
         }).to.throw(/ENOENT/);
       });
+
+      it('returns a new array for repeated reads', function () {
+        const p = path.join(asarDir, 'a.asar', 'dir1');
+        const dirs = fs.readdirSync(p);
+        dirs.pop();
+        expect(fs.readdirSync(p)).to.deep.equal(['file1', 'file2', 'file3', 'link1', 'link2']);
+      });
+
+      it('keeps throwing ENOENT for repeated reads of a missing dir', function () {
+        const p = path.join(asarDir, 'a.asar', 'not-exist');
+        for (let i = 0; i < 2; i++) {
+          expect(() => {
+            fs.readdirSync(p);
+          }).to.throw(/ENOENT/);
+        }
+      });
     });
 
     describe('fs.readdir', function () {
@@ -1188,6 +1204,100 @@ describe('asar package', function () {
       });
     });
 
+    describe('compressed files', function () {
+      const compressedAsar = path.join(asarDir, 'compressed.asar');
+      const singleContents = "module.exports = 'compressed without a seek table';\n";
+      const blocksContents = `module.exports = '${'abcdefghijklmnopqrstuvwxyz'.repeat(4)}';\n`;
+
+      it('reads files without a seek table with fs.readFileSync', function () {
+        expect(fs.readFileSync(path.join(compressedAsar, 'single.js'), 'utf8')).to.equal(singleContents);
+        expect(fs.readFileSync(path.join(compressedAsar, 'single.js'))).to.deep.equal(Buffer.from(singleContents));
+      });
+
+      it('reads files with a seek table with fs.readFileSync', function () {
+        expect(fs.readFileSync(path.join(compressedAsar, 'blocks.js'), 'utf8')).to.equal(blocksContents);
+        expect(fs.readFileSync(path.join(compressedAsar, 'blocks.js'))).to.deep.equal(Buffer.from(blocksContents));
+      });
+
+      it('reads files with and without a seek table with fs.readFile', async function () {
+        const readFile = util.promisify(fs.readFile);
+        expect(await readFile(path.join(compressedAsar, 'single.js'), 'utf8')).to.equal(singleContents);
+        expect(await readFile(path.join(compressedAsar, 'blocks.js'), 'utf8')).to.equal(blocksContents);
+      });
+
+      it('stats files with their uncompressed size', function () {
+        expect(fs.statSync(path.join(compressedAsar, 'blocks.js')).size).to.equal(Buffer.byteLength(blocksContents));
+      });
+
+      it('requires modules with and without a seek table', function () {
+        expect(require(path.join(compressedAsar, 'single.js'))).to.equal('compressed without a seek table');
+        expect(require(path.join(compressedAsar, 'blocks.js'))).to.equal('abcdefghijklmnopqrstuvwxyz'.repeat(4));
+      });
+
+      it('fails to read a corrupt stream with fs.readFileSync', function () {
+        expect(() => {
+          fs.readFileSync(path.join(compressedAsar, 'corrupt.txt'));
+        }).to.throw(/Invalid package/);
+      });
+
+      it('fails to read a corrupt stream with fs.readFile', function (done) {
+        fs.readFile(path.join(compressedAsar, 'corrupt.txt'), function (error) {
+          expect(error).to.be.an('Error');
+          expect(error.message).to.match(/Invalid package/);
+          done();
+        });
+      });
+    });
+
+    describe('integrity', function () {
+      const cleanAsar = path.join(asarDir, 'integrity.asar');
+      const tamperedAsar = path.join(asarDir, 'integrity-tampered.asar');
+      const contents = 'abcdefghijklmnop'.repeat(4);
+
+      it('reads files whose blocks match with fs.readFileSync', function () {
+        expect(fs.readFileSync(path.join(cleanAsar, 'file.txt'), 'utf8')).to.equal(contents);
+        expect(fs.readFileSync(path.join(cleanAsar, 'file.txt'))).to.deep.equal(Buffer.from(contents));
+      });
+
+      it('reads files whose blocks match with fs.readFile', async function () {
+        const readFile = util.promisify(fs.readFile);
+        expect(await readFile(path.join(cleanAsar, 'file.txt'), 'utf8')).to.equal(contents);
+      });
+
+      it('copies out files whose blocks match', function () {
+        const archive = process.electronBinding('asar').createArchive(cleanAsar);
+        const copy = archive.copyFileOut('file.txt');
+        expect(copy).to.be.a('string');
+        expect(fs.readFileSync(copy, 'utf8')).to.equal(contents);
+      });
+
+      it('fails to read a tampered block with fs.readFileSync', function () {
+        expect(() => {
+          fs.readFileSync(path.join(tamperedAsar, 'file.txt'), 'utf8');
+        }).to.throw(/Invalid package/);
+        expect(() => {
+          fs.readFileSync(path.join(tamperedAsar, 'file.txt'));
+        }).to.throw(/Invalid package/);
+      });
+
+      it('fails to read a tampered block with fs.readFile', function (done) {
+        fs.readFile(path.join(tamperedAsar, 'file.txt'), function (error) {
+          expect(error).to.be.an('Error');
+          expect(error.message).to.match(/Invalid package/);
+          done();
+        });
+      });
+
+      it('fails to copy out a tampered block', function () {
+        const archive = process.electronBinding('asar').createArchive(tamperedAsar);
+        expect(archive.copyFileOut('file.txt')).to.be.false();
+      });
+
+      it('still reads the files of a tampered archive whose blocks match', function () {
+        expect(fs.readFileSync(path.join(tamperedAsar, 'untouched.txt'), 'utf8')).to.equal('this file is not tampered with\n');
+      });
+    });
+
     describe('internalModuleReadJSON', function () {
       const internalModuleReadJSON = process.binding('fs').internalModuleReadJSON;
 
@@ -1376,6 +1486,84 @@ describe('asar package', function () {
       });
     });
 
+    it('can request a compressed file', function (done) {
+      const p = path.resolve(asarDir, 'compressed.asar', 'single.js');
+      $.get('file://' + p, function (data) {
+        expect(data).to.equal("module.exports = 'compressed without a seek table';\n");
+        done();
+      }, 'text');
+    });
+
+    it('can request a range of a compressed file', function (done) {
+      const p = path.resolve(asarDir, 'compressed.asar', 'blocks.js');
+      const contents = `module.exports = '${'abcdefghijklmnopqrstuvwxyz'.repeat(4)}';\n`;
+      // The range spans several blocks of the seek table.
+      $.ajax({
+        url: 'file://' + p,
+        dataType: 'text',
+        headers: { Range: 'bytes=20-69' },
+        success: function (data) {
+          expect(data).to.equal(contents.slice(20, 70));
+          done();
+        },
+        error: function (xhr, status, error) {
+          done(error || new Error(status));
+        }
+      });
+    });
+
+    it('can request a range of a compressed file without a seek table', function (done) {
+      const p = path.resolve(asarDir, 'compressed.asar', 'single.js');
+      $.ajax({
+        url: 'file://' + p,
+        dataType: 'text',
+        headers: { Range: 'bytes=17-49' },
+        success: function (data) {
+          expect(data).to.equal("'compressed without a seek table'");
+          done();
+        },
+        error: function (xhr, status, error) {
+          done(error || new Error(status));
+        }
+      });
+    });
+
+    it('fails to request a corrupt compressed file', function (done) {
+      const p = path.resolve(asarDir, 'compressed.asar', 'corrupt.txt');
+      $.ajax({
+        url: 'file://' + p,
+        dataType: 'text',
+        success: function () {
+          done(new Error('Unexpected success'));
+        },
+        error: function () {
+          done();
+        }
+      });
+    });
+
+    it('can request a file whose blocks match', function (done) {
+      const p = path.resolve(asarDir, 'integrity.asar', 'file.txt');
+      $.get('file://' + p, function (data) {
+        expect(data).to.equal('abcdefghijklmnop'.repeat(4));
+        done();
+      }, 'text');
+    });
+
+    it('fails to request a file with a tampered block', function (done) {
+      const p = path.resolve(asarDir, 'integrity-tampered.asar', 'file.txt');
+      $.ajax({
+        url: 'file://' + p,
+        dataType: 'text',
+        success: function () {
+          done(new Error('Unexpected success'));
+        },
+        error: function () {
+          done();
+        }
+      });
+    });
+
     it('gets 404 when file is not found', function (done) {
       const p = path.resolve(asarDir, 'a.asar', 'no-exist');
       $.ajax({
@@ -312,6 +312,35 @@ describe('chromium feature', () => {
       document.body.appendChild(webview);
     });
 
+    it('Workers share the modules they require with nodeIntegrationInWorker', (done) => {
+      const webview = new WebView();
+      webview.addEventListener('ipc-message', (e) => {
+        const [first, second] = e.args;
+        expect(first.result).to.equal(3);
+        expect(second.result).to.equal(3);
+        // The second worker uses what the first one resolved and compiled.
+        expect(second.codeCacheHits).to.be.above(first.codeCacheHits);
+        expect(second.resolvedPathHits).to.be.above(first.resolvedPathHits);
+        webview.remove();
+        done();
+      });
+      webview.src = `file://${fixtures}/pages/worker-require.html`;
+      webview.setAttribute('webpreferences', 'nodeIntegration, nodeIntegrationInWorker');
+      document.body.appendChild(webview);
+    });
+
+    it('Workers can require modules that use import() with nodeIntegrationInWorker', (done) => {
+      const webview = new WebView();
+      webview.addEventListener('ipc-message', (e) => {
+        expect(e.args[0]).to.equal(3);
+        webview.remove();
+        done();
+      });
+      webview.src = `file://${fixtures}/pages/worker-dynamic-import.html`;
+      webview.setAttribute('webpreferences', 'nodeIntegration, nodeIntegrationInWorker');
+      document.body.appendChild(webview);
+    });
+
     // FIXME: disabled during chromium update due to crash in content::WorkerScriptFetchInitiator::CreateScriptLoaderOnIO
     xdescribe('SharedWorker', () => {
       it('can work', (done) => {
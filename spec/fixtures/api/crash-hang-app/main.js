@@ -0,0 +1,36 @@
+const { app, crashReporter } = require('electron');
+const path = require('path');
+
+const [port, tempDir, name, version] = process.argv.slice(2);
+
+// Shares the crash database of the spec runner, which checks the report.
+app.name = name;
+app.setPath('temp', tempDir);
+app.setPath('userData', path.join(tempDir, 'crash-hang-app'));
+
+crashReporter.start({
+  productName: 'Zombies',
+  companyName: 'Umbrella Corporation',
+  submitURL: `http://127.0.0.1:${port}`,
+  ignoreSystemCrashHandler: true,
+  hangTimeout: 500,
+  extra: {
+    extra1: 'extra1',
+    extra2: 'extra2',
+    _version: version
+  }
+});
+
+function spin () {
+  const end = Date.now() + 3000;
+  while (Date.now() < end) {}
+}
+
+app.whenReady().then(() => {
+  // Hangs in a libuv timer callback rather than in a task of the main loop.
+  setTimeout(() => {
+    spin();
+    // Gives the report time to be written before quitting.
+    setTimeout(() => app.quit(), 1000);
+  });
+});
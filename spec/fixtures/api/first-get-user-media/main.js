@@ -0,0 +1,20 @@
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+app.commandLine.appendSwitch('use-fake-device-for-media-stream');
+
+// The first getUserMedia of the app is made right away, before the capture
+// devices were ever enumerated.
+app.whenReady().then(async () => {
+  const w = new BrowserWindow({ show: false });
+  await w.loadFile(path.join(__dirname, 'index.html'));
+  const result = await w.webContents.executeJavaScript(`
+    navigator.mediaDevices.getUserMedia({ audio: true, video: true })
+      .then(stream => stream.getTracks().map(track => track.kind).sort().join(),
+        error => error.name)
+  `);
+  process.stdout.write(result);
+  process.stdout.end();
+
+  app.quit();
+});
@@ -0,0 +1 @@
+module.exports = import('./lib.js').then(() => 'imported', (error) => error.message);
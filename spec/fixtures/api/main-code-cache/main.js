@@ -0,0 +1,13 @@
+const { app } = require('electron');
+const { value } = require('./lib');
+
+const dynamicImport = require('./import-lib');
+
+app.whenReady().then(async () => {
+  const imported = await dynamicImport;
+  // Leave the time for the caches to be written.
+  setTimeout(() => {
+    console.log(JSON.stringify({ value, imported }));
+    app.quit();
+  }, 2000);
+});
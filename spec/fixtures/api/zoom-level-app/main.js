@@ -0,0 +1,42 @@
+const { app, protocol, session, BrowserWindow } = require('electron');
+const fs = require('fs');
+const path = require('path');
+
+// With PHASE=set, zooms a host of a persistent partition and quits once the
+// level is written. With PHASE=get, prints the level of that host.
+app.setPath('userData', process.env.USER_DATA);
+
+protocol.registerSchemesAsPrivileged([
+  { scheme: 'zoom-app', privileges: { standard: true } }
+]);
+
+const waitForLog = async (file, host) => {
+  for (let i = 0; i < 50; i++) {
+    if (fs.existsSync(file) && fs.readFileSync(file, 'utf8').includes(host)) return;
+    await new Promise(resolve => setTimeout(resolve, 100));
+  }
+  throw new Error(`${host} was not written to ${file}`);
+};
+
+app.whenReady().then(async () => {
+  const ses = session.fromPartition('persist:zoom-level-app');
+  ses.protocol.registerStringProtocol('zoom-app', (request, callback) => {
+    callback({ data: '<html></html>', mimeType: 'text/html' });
+  });
+  const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+  await w.loadURL('zoom-app://zoomed-host/');
+
+  if (process.env.PHASE === 'set') {
+    w.webContents.setZoomLevel(2);
+    const log = path.join(app.getPath('userData'), 'Partitions', 'zoom-level-app', 'Zoom Levels');
+    await waitForLog(log, 'zoomed-host');
+    process.stdout.write('set');
+  } else {
+    process.stdout.write(String(w.webContents.getZoomLevel()));
+  }
+  process.stdout.end();
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
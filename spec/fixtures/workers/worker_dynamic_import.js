@@ -0,0 +1,6 @@
+const { load } = require('./worker_dynamic_import_module');
+load().then(({ add }) => {
+  self.postMessage(add(1, 2));
+}, (error) => {
+  self.postMessage(error.message);
+});
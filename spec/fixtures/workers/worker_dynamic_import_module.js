@@ -0,0 +1,3 @@
+const path = require('path');
+const { pathToFileURL } = require('url');
+exports.load = () => import(pathToFileURL(path.join(__dirname, 'worker_required_module.js')).href);
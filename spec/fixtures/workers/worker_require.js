@@ -0,0 +1,3 @@
+const { add } = require('./worker_required_module');
+const { codeCacheHits, resolvedPathHits } = process._linkedBinding('electron_renderer_worker_module_cache').getStats();
+self.postMessage({ result: add(1, 2), codeCacheHits, resolvedPathHits });
@@ -18,12 +18,16 @@ declare namespace NodeJS {
   }
 
   interface IpcRendererBinding {
-    send(internal: boolean, channel: string, args: any[]): void;
+    send(internal: boolean, channel: string, args: any[]): boolean;
+    sendBatched(internal: boolean, channel: string, args: any[]): boolean;
     sendSync(internal: boolean, channel: string, args: any[]): any;
     sendToHost(channel: string, args: any[]): void;
     sendTo(internal: boolean, sendToAll: boolean, webContentsId: number, channel: string, args: any[]): void;
     invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
-    postMessage(channel: string, message: any, transferables: MessagePort[]): void;
+    postMessage(channel: string, message: any, transferables: (MessagePort | ArrayBuffer)[]): void;
+    setHighWaterMark(bytes: number): void;
+    getQueueStats(): Electron.IPCQueueStats;
+    whenDrained(): Promise<void>;
   }
 
   interface V8UtilBinding {
@@ -9,18 +9,25 @@ declare namespace Electron {
   enum ProcessType {
     browser = 'browser',
     renderer = 'renderer',
-    worker = 'worker'
+    worker = 'worker',
+    utility = 'utility'
   }
 
   interface App {
     _setDefaultAppPaths(packagePath: string | null): void;
+    _postIdleTask(callback: () => void): void;
     setVersion(version: string): void;
     setDesktopName(name: string): void;
     setAppPath(path: string | null): void;
   }
 
+  interface Session {
+    _getStoragePath(): string | null;
+  }
+
   interface WebContents {
     _getURL(): string;
+    _canProcessAccessURL(processId: number, url: string): boolean;
     getOwnerBrowserWindow(): Electron.BrowserWindow;
   }
 
@@ -43,8 +50,13 @@ declare namespace Electron {
     code: string
   }
 
+  interface ContentScriptSource extends InjectionBase {
+    hash: string;
+    codeCache: Uint8Array | null;
+  }
+
   interface ContentScript {
-    js: Array<InjectionBase>;
+    js: Array<ContentScriptSource>;
     css: Array<InjectionBase>;
     runAt: string;
     matches: {
@@ -70,6 +82,7 @@ declare namespace Electron {
   interface WebContentsInternal extends Electron.WebContents {
     _sendInternal(channel: string, ...args: any[]): void;
     _sendInternalToAll(channel: string, ...args: any[]): void;
+    _sendInternalToProcesses(channel: string, ...args: any[]): Array<{ processId: number, frameId: number }>;
   }
 
   const deprecate: ElectronInternal.DeprecationUtil;
@@ -93,16 +106,45 @@ declare namespace ElectronInternal {
   }
 
   interface DesktopCapturer {
-    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, incremental: boolean): void;
     _onerror: (error: string) => void;
+    _onsource?: (source: Electron.DesktopCapturerSource) => void;
     _onfinished: (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => void;
+    startWatching(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    stopWatching(): void;
+    _onsourceadded?: (type: DesktopSourceType, index: number, source: Electron.DesktopCapturerSource) => void;
+    _onsourceremoved?: (type: DesktopSourceType, index: number) => void;
+    _onsourcemoved?: (type: DesktopSourceType, oldIndex: number, newIndex: number) => void;
+    _onsourcenamechanged?: (type: DesktopSourceType, index: number, source: Electron.DesktopCapturerSource) => void;
+    _onsourcethumbnailchanged?: (type: DesktopSourceType, index: number, source: Electron.DesktopCapturerSource) => void;
   }
 
+  type DesktopSourceType = 'window' | 'screen';
+
+  // The changes of the sources of a watcher, sent to its renderer.
+  type DesktopSourceChange =
+    ['added', DesktopSourceType, number, GetSourcesResult] |
+    ['removed', DesktopSourceType, number] |
+    ['moved', DesktopSourceType, number, number] |
+    ['name-changed', DesktopSourceType, number, GetSourcesResult] |
+    ['thumbnail-changed', DesktopSourceType, number, GetSourcesResult];
+
   interface GetSourcesOptions {
     captureWindow: boolean;
     captureScreen: boolean;
     thumbnailSize: Electron.Size;
     fetchWindowIcons: boolean;
+    // The channel the sources are sent on as they are ready, if any.
+    updateChannel?: string;
+  }
+
+  interface WatchSourcesOptions {
+    captureWindow: boolean;
+    captureScreen: boolean;
+    thumbnailSize: Electron.Size;
+    fetchWindowIcons: boolean;
+    // The channel the changes are sent on, it identifies the watcher.
+    channel: string;
   }
 
   interface GetSourcesResult {